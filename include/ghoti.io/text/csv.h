@@ -18,6 +18,10 @@
 #include <ghoti.io/text/csv/csv_core.h>
 
 // CSV module headers
+#include <ghoti.io/text/csv/csv_extsort.h>
+#include <ghoti.io/text/csv/csv_index.h>
+#include <ghoti.io/text/csv/csv_json.h>
+#include <ghoti.io/text/csv/csv_sniff.h>
 #include <ghoti.io/text/csv/csv_stream.h>
 #include <ghoti.io/text/csv/csv_table.h>
 #include <ghoti.io/text/csv/csv_writer.h>
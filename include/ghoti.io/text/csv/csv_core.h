@@ -95,6 +95,57 @@ typedef enum {
   GTEXT_CSV_DUPCOL_COLLECT     ///< Store all indices for duplicate columns
 } GTEXT_CSV_Dupcol_Mode;
 
+/**
+ * @brief Storage layout of a CSV table
+ */
+typedef enum {
+  GTEXT_CSV_LAYOUT_ROWS,   ///< Row-major: one field array per row (default)
+  GTEXT_CSV_LAYOUT_COLUMNS ///< Column-major: per-column offset/length arrays
+                           ///< over one contiguous byte heap
+} GTEXT_CSV_Layout;
+
+/**
+ * @brief Comparison made by a row filter condition
+ */
+typedef enum {
+  GTEXT_CSV_FILTER_EQUALS, ///< Field equals value exactly
+  GTEXT_CSV_FILTER_PREFIX, ///< Field starts with value
+  GTEXT_CSV_FILTER_RANGE   ///< Field is a decimal number within [min, max]
+} GTEXT_CSV_Filter_Op;
+
+/**
+ * @brief One condition of a row filter
+ *
+ * A row meets the condition when its field in the given column compares as
+ * requested. A row too short to have the column never meets it, and neither
+ * does a RANGE field that is not a plain decimal number.
+ */
+typedef struct {
+  const char * column;    ///< Header name of the column (NULL = use
+                          ///< column_index)
+  size_t column_index;    ///< Column index in the parsed table (after
+                          ///< projection)
+  GTEXT_CSV_Filter_Op op; ///< Comparison to make
+  const char * value;     ///< EQUALS/PREFIX operand (NUL-terminated)
+  double min;             ///< RANGE lower bound (inclusive)
+  double max;             ///< RANGE upper bound (inclusive)
+} GTEXT_CSV_Row_Condition;
+
+/**
+ * @brief Row filter callback
+ *
+ * Called once per data row while a table is parsed, after the row
+ * conditions have passed. The arrays are only valid during the call.
+ *
+ * @param fields Field data of the row (not NUL-terminated)
+ * @param lengths Field lengths in bytes
+ * @param field_count Number of fields in the row
+ * @param user_data row_filter_data from the parse options
+ * @return true to keep the row, false to drop it
+ */
+typedef bool (*GTEXT_CSV_Row_Filter_cb)(const char * const * fields,
+    const size_t * lengths, size_t field_count, void * user_data);
+
 /**
  * @brief CSV dialect structure
  *
@@ -128,6 +179,20 @@ typedef struct {
  * @brief CSV parse options structure
  *
  * Controls parsing behavior including dialect, limits, and error reporting.
+ *
+ * When select_columns or select_names is non-empty, only the selected columns
+ * are kept, in input order (the order and duplicates of the selection do not
+ * matter). Other fields are still scanned for quotes and delimiters, but are
+ * never unescaped, copied, or reported: streams emit no FIELD event for them
+ * and kept fields keep their input col_index. Names are looked up in the
+ * header row by gtext_csv_parse_table(); a name missing from the header fails
+ * the parse with GTEXT_CSV_E_INVALID.
+ *
+ * gtext_csv_parse_table() drops data rows that fail a row condition or that
+ * row_filter rejects, as soon as each row ends. A dropped row's memory is
+ * reclaimed before the next row is parsed, so peak memory follows the kept
+ * rows rather than the input. Conditions and the callback see the row after
+ * projection.
  */
 typedef struct {
   GTEXT_CSV_Dialect dialect; ///< CSV dialect configuration
@@ -151,6 +216,29 @@ typedef struct {
                                ///< true)
   size_t context_radius_bytes; ///< Bytes before/after error in snippet (default
                                ///< 40)
+
+  // Table parsing
+  size_t parse_threads; ///< Worker threads for gtext_csv_parse_table() (0 or 1
+                        ///< = serial, default 0)
+  GTEXT_CSV_Layout layout; ///< Storage layout of the parsed table (default
+                           ///< GTEXT_CSV_LAYOUT_ROWS)
+
+  // Column projection (both empty = keep every column)
+  const size_t * select_columns; ///< Indices of the columns to keep (default
+                                 ///< NULL)
+  size_t select_column_count;    ///< Number of entries in select_columns
+  const char * const * select_names; ///< Header names of the columns to keep
+                                     ///< (table parsing with a header row
+                                     ///< only, default NULL)
+  size_t select_name_count;          ///< Number of entries in select_names
+
+  // Row filtering (table parsing only, the header row is always kept)
+  const GTEXT_CSV_Row_Condition *
+      row_conditions; ///< Conditions every kept row meets (default NULL)
+  size_t row_condition_count;         ///< Number of entries in row_conditions
+  GTEXT_CSV_Row_Filter_cb row_filter; ///< Callback deciding which rows to keep
+                                      ///< (default NULL)
+  void * row_filter_data;             ///< User data passed to row_filter
 } GTEXT_CSV_Parse_Options;
 
 /**
@@ -172,6 +260,8 @@ typedef struct {
   bool trailing_newline;     ///< Add trailing newline at end (default false)
   bool trim_trailing_empty_fields; ///< Trim trailing empty fields from rows
                                    ///< (default false)
+  size_t write_threads; ///< Worker threads for gtext_csv_write_table() (0 or 1
+                        ///< = serial, default 0)
 } GTEXT_CSV_Write_Options;
 
 /**
@@ -0,0 +1,128 @@
+/**
+ * @file
+ *
+ * External-memory sorting of CSV files larger than RAM.
+ *
+ * The input file is read in batches that fit a memory budget. Each batch is
+ * sorted with gtext_csv_table_sort() and spilled to a temporary run file, and
+ * the runs are then merged k ways into the output file, optionally dropping
+ * rows whose keys repeat an earlier row.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#ifndef GHOTI_IO_GTEXT_CSV_EXTSORT_H
+#define GHOTI_IO_GTEXT_CSV_EXTSORT_H
+
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_table.h>
+#include <ghoti.io/text/macros.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Stage an external sort has reached
+ */
+typedef enum {
+  GTEXT_CSV_EXTSORT_RUNS,  ///< Reading the input and writing sorted runs
+  GTEXT_CSV_EXTSORT_MERGE, ///< Merging runs into larger runs
+  GTEXT_CSV_EXTSORT_OUTPUT ///< Merging the last runs into the output file
+} GTEXT_CSV_Extsort_Phase;
+
+/**
+ * @brief Progress of an external sort
+ */
+typedef struct {
+  GTEXT_CSV_Extsort_Phase phase; ///< Current stage
+  uint64_t bytes_read;           ///< Input bytes read so far
+  uint64_t bytes_total;          ///< Size of the input file
+  size_t rows_read;   ///< Input records read so far (including a header)
+  size_t runs_written; ///< Run files written so far, in every pass
+  size_t rows_written; ///< Records written to the output so far
+} GTEXT_CSV_Extsort_Progress;
+
+/**
+ * @brief Progress callback
+ *
+ * @param progress Current progress
+ * @param user_data progress_data from the sort options
+ */
+typedef void (*GTEXT_CSV_Extsort_Progress_cb)(
+    const GTEXT_CSV_Extsort_Progress * progress, void * user_data);
+
+/**
+ * @brief External sort options structure
+ */
+typedef struct {
+  const GTEXT_CSV_Sort_Key * keys; ///< Sort keys (default NULL, required)
+  size_t key_count;                ///< Number of entries in keys
+  bool unique; ///< Keep only the first row of each distinct key (default
+               ///< false)
+  size_t memory_limit_bytes; ///< Budget for rows held in memory (0 = default,
+                             ///< 256 MiB)
+  size_t sort_threads;       ///< Worker threads for sorting each run (0 or 1
+                             ///< = serial, default 0)
+  const char * temp_dir; ///< Directory for run files (default NULL = TMPDIR,
+                         ///< or /tmp)
+  GTEXT_CSV_Extsort_Progress_cb progress; ///< Progress callback (default NULL)
+  void * progress_data; ///< User data passed to progress
+} GTEXT_CSV_Extsort_Options;
+
+/**
+ * @brief Initialize external sort options with defaults
+ *
+ * @return Options with no keys, no deduplication, the default memory budget,
+ *         serial run sorting and the default temporary directory
+ */
+GTEXT_API GTEXT_CSV_Extsort_Options gtext_csv_extsort_options_default(void);
+
+/**
+ * @brief Sort a CSV file that may not fit in memory
+ *
+ * Orders the records of @p input_path by the sort keys, with the same
+ * comparators and stability as gtext_csv_table_sort(), and writes them to
+ * @p output_path with @p write_opts. When the parse dialect treats the first
+ * row as a header, that row is written first and is not sorted. With
+ * @p sort_opts->unique, a record whose keys compare equal to the previous
+ * output record's is dropped, so the first record of each key in input order
+ * is kept.
+ *
+ * Records are gathered until their estimated size reaches the memory budget,
+ * sorted, and written to a run file in the temporary directory. Run files
+ * use the default dialect with every field quoted, so they read back exactly
+ * whatever the input dialect. Up to 64 runs are merged at a time; more runs
+ * take extra merge passes. Input that fits in one run is sorted in memory and
+ * never spilled. Run files are removed before this function returns, on
+ * failure as well as on success.
+ *
+ * Zero max_total_bytes and max_rows limits in @p parse_opts mean no limit
+ * here rather than the library defaults. Row filters and select_names are
+ * not applied. @p output_path must not name the input file.
+ *
+ * The progress callback, if any, is called after each run file is written
+ * and periodically while merging.
+ *
+ * @param input_path Path of the CSV file to sort (must not be NULL)
+ * @param output_path Path of the file to write (must not be NULL)
+ * @param sort_opts Sort options (must not be NULL, with at least one key)
+ * @param parse_opts Parse options for the input (can be NULL for defaults)
+ * @param write_opts Write options for the output (can be NULL for defaults)
+ * @param err Error output structure (can be NULL)
+ * @return GTEXT_CSV_OK on success, or error code (the output file may be
+ *         partially written on failure)
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_extsort(const char * input_path,
+    const char * output_path, const GTEXT_CSV_Extsort_Options * sort_opts,
+    const GTEXT_CSV_Parse_Options * parse_opts,
+    const GTEXT_CSV_Write_Options * write_opts, GTEXT_CSV_Error * err);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GHOTI_IO_GTEXT_CSV_EXTSORT_H
@@ -0,0 +1,113 @@
+/**
+ * @file
+ *
+ * Sparse row-offset index for random access into large CSV files.
+ *
+ * An index records the byte offset of every Kth record of a file in a small
+ * sidecar file. Seeking to a row then parses at most K records instead of
+ * every record before it.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#ifndef GHOTI_IO_GTEXT_CSV_INDEX_H
+#define GHOTI_IO_GTEXT_CSV_INDEX_H
+
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_stream.h>
+#include <ghoti.io/text/macros.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque handle on an indexed CSV file
+ */
+typedef struct GTEXT_CSV_Index GTEXT_CSV_Index;
+
+/**
+ * @brief Build a sparse row-offset index for a CSV file
+ *
+ * Scans @p csv_path once with the streaming parser, so quoted newlines do not
+ * start records, and writes the byte offset of every @p stride th record to
+ * @p index_path. The index also records the file's size and modification
+ * time, to the nanosecond where the platform provides it, so a changed file
+ * is detected when the index is opened.
+ *
+ * Rows are counted from the first record of the file, including a header
+ * record. Zero max_total_bytes and max_rows limits in @p opts mean no limit
+ * here rather than the library defaults, since indexes exist for files too
+ * large to parse in one piece.
+ *
+ * @param csv_path Path of the CSV file (must not be NULL)
+ * @param index_path Path of the index file to write (must not be NULL)
+ * @param stride Records between indexed offsets (must be > 0)
+ * @param opts Parse options (can be NULL for defaults)
+ * @param err Error output structure (can be NULL)
+ * @return GTEXT_CSV_OK on success, or error code
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_index_build(const char * csv_path,
+    const char * index_path, size_t stride,
+    const GTEXT_CSV_Parse_Options * opts, GTEXT_CSV_Error * err);
+
+/**
+ * @brief Open an indexed CSV file
+ *
+ * Loads the index and maps the CSV file into memory. Fails with
+ * GTEXT_CSV_E_STATE if the file's size or modification time no longer match
+ * the index, in which case the index must be rebuilt.
+ *
+ * @p opts must describe the same dialect the index was built with. It is
+ * copied, but strings and arrays it points to must outlive the handle.
+ *
+ * @param csv_path Path of the CSV file (must not be NULL)
+ * @param index_path Path of the index file (must not be NULL)
+ * @param opts Parse options (can be NULL for defaults)
+ * @param err Error output structure (can be NULL)
+ * @return New index handle, or NULL on failure
+ */
+GTEXT_API GTEXT_CSV_Index * gtext_csv_index_open(const char * csv_path,
+    const char * index_path, const GTEXT_CSV_Parse_Options * opts,
+    GTEXT_CSV_Error * err);
+
+/**
+ * @brief Get the number of records in an indexed file
+ *
+ * @param index Index handle (must not be NULL)
+ * @return Number of records, including a header record
+ */
+GTEXT_API size_t gtext_csv_index_row_count(const GTEXT_CSV_Index * index);
+
+/**
+ * @brief Read rows starting at a record number
+ *
+ * Jumps to the nearest indexed offset at or before @p row and parses forward
+ * from there, filling @p batch with up to @p count rows. Unquoted fields
+ * point into the mapped file and stay valid until the index is closed;
+ * other fields live in the batch as for gtext_csv_reader_next_batch().
+ *
+ * @param index Index handle (must not be NULL)
+ * @param row Record number of the first row to read (0-based)
+ * @param count Maximum number of rows to read (must be > 0)
+ * @param batch Batch to fill (must not be NULL)
+ * @param err Error output structure (can be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID if @p row is past the
+ *         last record, or another error code
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_seek_row(GTEXT_CSV_Index * index,
+    size_t row, size_t count, GTEXT_CSV_Batch * batch, GTEXT_CSV_Error * err);
+
+/**
+ * @brief Close an indexed file and unmap it
+ *
+ * @param index Index handle to close (can be NULL)
+ */
+GTEXT_API void gtext_csv_index_close(GTEXT_CSV_Index * index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GHOTI_IO_GTEXT_CSV_INDEX_H
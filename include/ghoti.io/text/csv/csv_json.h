@@ -0,0 +1,219 @@
+/**
+ * @file
+ *
+ * Streaming conversion between CSV and JSON.
+ *
+ * The converters connect the CSV and JSON event parsers to the opposite
+ * module's streaming writer, so neither side builds a table or a DOM. CSV
+ * records become JSON objects keyed by the header row, and a JSON array of
+ * flat objects becomes CSV records whose columns are discovered from the
+ * first records.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#ifndef GHOTI_IO_GTEXT_CSV_JSON_H
+#define GHOTI_IO_GTEXT_CSV_JSON_H
+
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_writer.h>
+#include <ghoti.io/text/json/json_core.h>
+#include <ghoti.io/text/json/json_writer.h>
+#include <ghoti.io/text/macros.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Layout of the JSON written by a CSV-to-JSON converter
+ */
+typedef enum {
+  GTEXT_CSV_JSON_ARRAY, ///< One array holding an object per record (default)
+  GTEXT_CSV_JSON_LINES  ///< One object per line (NDJSON)
+} GTEXT_CSV_JSON_Format;
+
+/**
+ * @brief CSV-to-JSON conversion options
+ */
+typedef struct {
+  GTEXT_CSV_JSON_Format format; ///< Output layout (default ARRAY)
+  bool infer_numbers; ///< Write fields that are valid JSON numbers as numbers
+                      ///< instead of strings (default false)
+  bool empty_as_null; ///< Write empty fields as null (default false)
+} GTEXT_CSV_To_JSON_Options;
+
+/**
+ * @brief Opaque CSV-to-JSON converter
+ */
+typedef struct GTEXT_CSV_To_JSON GTEXT_CSV_To_JSON;
+
+/**
+ * @brief Initialize CSV-to-JSON options with defaults
+ *
+ * @return Options producing one JSON array of objects with every field
+ *         written as a string
+ */
+GTEXT_API GTEXT_CSV_To_JSON_Options gtext_csv_to_json_options_default(void);
+
+/**
+ * @brief Create a streaming CSV-to-JSON converter
+ *
+ * CSV fed to the converter is parsed with a CSV stream. The first record is
+ * always the header and supplies the object keys; each later record is
+ * written to @p sink as one JSON object as soon as it is parsed, so memory
+ * use is bounded by the header and the parser's own buffers.
+ *
+ * Fields past the end of the header are keyed by their 0-based column number
+ * ("3"), and fields missing from a short record are left out of its object.
+ * A header name that repeats is written once: the dialect's header_dup_mode
+ * picks the column (LAST_WINS keeps the last one, ERROR fails with
+ * GTEXT_CSV_E_INVALID, and the other modes keep the first).
+ *
+ * With infer_numbers, a field is written as a number when it matches the
+ * JSON number grammar exactly ("12", "-0.5", "1e9"; not "012", "+1", ".5" or
+ * " 1"), and its text is kept as the number's lexeme.
+ *
+ * For GTEXT_CSV_JSON_LINES, each object is followed by the write options'
+ * newline, pretty printing is turned off and trailing_newline is ignored.
+ *
+ * @param parse_opts CSV parse options (can be NULL for defaults)
+ * @param opts Conversion options (can be NULL for defaults)
+ * @param sink JSON output sink (its write function must not be NULL)
+ * @param write_opts JSON write options (can be NULL for defaults)
+ * @return New converter, or NULL on failure
+ */
+GTEXT_API GTEXT_CSV_To_JSON * gtext_csv_to_json_new(
+    const GTEXT_CSV_Parse_Options * parse_opts,
+    const GTEXT_CSV_To_JSON_Options * opts, GTEXT_JSON_Sink sink,
+    const GTEXT_JSON_Write_Options * write_opts);
+
+/**
+ * @brief Feed CSV input to a converter
+ *
+ * @param conv Converter (must not be NULL)
+ * @param data Input bytes (can be NULL if @p len is 0)
+ * @param len Number of input bytes
+ * @param err Error output structure (can be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_WRITE if the sink failed, or
+ *         another error code (the converter cannot be used after an error)
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_to_json_feed(GTEXT_CSV_To_JSON * conv,
+    const void * data, size_t len, GTEXT_CSV_Error * err);
+
+/**
+ * @brief Finish a CSV-to-JSON conversion
+ *
+ * Parses any buffered input and completes the JSON output. Input with no
+ * data records produces "[]" in ARRAY format and nothing in LINES format.
+ *
+ * @param conv Converter (must not be NULL)
+ * @param err Error output structure (can be NULL)
+ * @return GTEXT_CSV_OK on success, or error code
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_to_json_finish(
+    GTEXT_CSV_To_JSON * conv, GTEXT_CSV_Error * err);
+
+/**
+ * @brief Free a CSV-to-JSON converter
+ *
+ * @param conv Converter to free (can be NULL)
+ */
+GTEXT_API void gtext_csv_to_json_free(GTEXT_CSV_To_JSON * conv);
+
+/**
+ * @brief JSON-to-CSV conversion options
+ */
+typedef struct {
+  size_t discovery_records; ///< Records read before the columns are fixed
+                            ///< (0 = default, 100)
+  bool ignore_unknown_keys; ///< Drop keys first seen after discovery instead
+                            ///< of failing (default false)
+  bool write_header; ///< Write the column names as the first record (default
+                     ///< true)
+} GTEXT_CSV_From_JSON_Options;
+
+/**
+ * @brief Opaque JSON-to-CSV converter
+ */
+typedef struct GTEXT_CSV_From_JSON GTEXT_CSV_From_JSON;
+
+/**
+ * @brief Initialize JSON-to-CSV options with defaults
+ *
+ * @return Options discovering columns from the first 100 records, failing on
+ *         later unknown keys and writing a header
+ */
+GTEXT_API GTEXT_CSV_From_JSON_Options gtext_csv_from_json_options_default(
+    void);
+
+/**
+ * @brief Create a streaming JSON-to-CSV converter
+ *
+ * JSON fed to the converter is parsed with a JSON stream and must be an
+ * array of objects whose values are strings, numbers, booleans or null.
+ * The first discovery_records objects are buffered while their keys are
+ * collected; the columns are the keys in order of first appearance. After
+ * that each object is written to @p sink as soon as it ends, so memory use
+ * is bounded by the discovery records and one record.
+ *
+ * Strings are written as their decoded text, numbers as their lexeme, and
+ * booleans as "true" or "false". null and missing keys become empty fields.
+ * A key repeated within one object keeps its last value. Nested arrays and
+ * objects fail the conversion with GTEXT_JSON_E_INVALID, as does a key first
+ * seen after discovery unless ignore_unknown_keys is set.
+ *
+ * @param parse_opts JSON parse options (can be NULL for defaults)
+ * @param opts Conversion options (can be NULL for defaults)
+ * @param sink CSV output sink (must not be NULL, copied)
+ * @param write_opts CSV write options (can be NULL for defaults)
+ * @return New converter, or NULL on failure
+ */
+GTEXT_API GTEXT_CSV_From_JSON * gtext_csv_from_json_new(
+    const GTEXT_JSON_Parse_Options * parse_opts,
+    const GTEXT_CSV_From_JSON_Options * opts, const GTEXT_CSV_Sink * sink,
+    const GTEXT_CSV_Write_Options * write_opts);
+
+/**
+ * @brief Feed JSON input to a converter
+ *
+ * @param conv Converter (must not be NULL)
+ * @param data Input bytes (can be NULL if @p len is 0)
+ * @param len Number of input bytes
+ * @param err Error output structure (can be NULL)
+ * @return GTEXT_JSON_OK on success, GTEXT_JSON_E_WRITE if the sink failed,
+ *         or another error code (the converter cannot be used after an
+ *         error)
+ */
+GTEXT_API GTEXT_JSON_Status gtext_csv_from_json_feed(
+    GTEXT_CSV_From_JSON * conv, const void * data, size_t len,
+    GTEXT_JSON_Error * err);
+
+/**
+ * @brief Finish a JSON-to-CSV conversion
+ *
+ * Checks that the input was complete, fixes the columns if discovery is
+ * still running, and writes the remaining records. An empty array produces
+ * no output.
+ *
+ * @param conv Converter (must not be NULL)
+ * @param err Error output structure (can be NULL)
+ * @return GTEXT_JSON_OK on success, or error code
+ */
+GTEXT_API GTEXT_JSON_Status gtext_csv_from_json_finish(
+    GTEXT_CSV_From_JSON * conv, GTEXT_JSON_Error * err);
+
+/**
+ * @brief Free a JSON-to-CSV converter
+ *
+ * @param conv Converter to free (can be NULL)
+ */
+GTEXT_API void gtext_csv_from_json_free(GTEXT_CSV_From_JSON * conv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GHOTI_IO_GTEXT_CSV_JSON_H
@@ -0,0 +1,78 @@
+/**
+ * @file
+ *
+ * CSV dialect detection.
+ *
+ * The sniffer examines a sample from the start of an input and guesses the
+ * dialect it was written in: delimiter, quote character, escape mode, newline
+ * convention, comment lines and header row. The guess comes with a
+ * confidence score, so callers can fall back to asking for the dialect when
+ * the input is ambiguous.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#ifndef GHOTI_IO_GTEXT_CSV_SNIFF_H
+#define GHOTI_IO_GTEXT_CSV_SNIFF_H
+
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/macros.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Details of a sniffed dialect
+ */
+typedef struct {
+  double confidence;    ///< 0 (no evidence) to 1 (every sampled record agrees
+                        ///< with the dialect and no other delimiter fits)
+  size_t column_count;  ///< Fields in most sampled records
+  size_t record_count;  ///< Records examined (comment and blank lines are not
+                        ///< counted)
+  const char * newline; ///< Newline the sample uses ("\n", "\r\n" or "\r"),
+                        ///< suitable for GTEXT_CSV_Write_Options.newline
+} GTEXT_CSV_Sniff_Info;
+
+/**
+ * @brief Guess the dialect of CSV input
+ *
+ * Scans at most the first 64 KiB of @p input (after a UTF-8 BOM) once,
+ * jumping between the bytes that can be delimiters, quotes or newlines. Every
+ * combination of delimiter (',', ';', '\\t', '|') and quote character ('"',
+ * '\'') is tracked side by side, and the one whose records most consistently
+ * have the same number of fields, with the fewest quotes out of place, wins.
+ * When the sample ends part way through a record, that record is ignored.
+ *
+ * The rest of @p dialect is filled in from the same pass:
+ * - escape is GTEXT_CSV_ESCAPE_BACKSLASH when quotes inside quoted fields are
+ *   escaped as \\" rather than doubled;
+ * - accept_cr is set when records end with a bare CR;
+ * - allow_comments is set, with comment_prefix "#", when lines starting with
+ *   '#' do not have the same field count as the records around them;
+ * - treat_first_row_as_header is set when the first record looks like column
+ *   names: for columns whose other sampled values are all numbers, or all
+ *   the same length, the first record's value breaks the pattern. Only the
+ *   first 20 records are parsed for this check.
+ *
+ * Everything else keeps the gtext_csv_dialect_default() values. Input with no
+ * complete record gives the default dialect with confidence 0.
+ *
+ * @param input Input bytes (can be NULL if @p input_len is 0)
+ * @param input_len Number of input bytes
+ * @param dialect Detected dialect (must not be NULL)
+ * @param info Confidence and details of the guess (can be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID on bad arguments, or
+ *         GTEXT_CSV_E_OOM
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_sniff(const char * input,
+    size_t input_len, GTEXT_CSV_Dialect * dialect,
+    GTEXT_CSV_Sniff_Info * info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GHOTI_IO_GTEXT_CSV_SNIFF_H
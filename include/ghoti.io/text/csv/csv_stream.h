@@ -14,6 +14,7 @@
 
 #include <ghoti.io/text/csv/csv_core.h>
 #include <ghoti.io/text/macros.h>
+#include <stdbool.h>
 #include <stddef.h>
 
 #ifdef __cplusplus
@@ -30,6 +31,25 @@ typedef enum {
   GTEXT_CSV_EVENT_END           ///< End of input (parsing complete)
 } GTEXT_CSV_Event_Type;
 
+/**
+ * @brief Raw bytes of one field, as found in the input
+ *
+ * The field is the concatenation of @p prefix and @p data. A field that
+ * started in an earlier chunk has its bytes from those chunks in @p prefix,
+ * held by the stream; otherwise @p prefix_len is 0 and @p data is the whole
+ * field, usually pointing straight into the chunk being fed. Quotes around a
+ * quoted field are not included, but escape sequences are: when
+ * @p needs_unescape is set, gtext_csv_field_view_decode() gives the field's
+ * value. Both pointers are only valid during the callback.
+ */
+typedef struct {
+  const char * prefix; ///< Bytes from earlier chunks (NULL if prefix_len is 0)
+  size_t prefix_len;   ///< Length of prefix in bytes
+  const char * data;   ///< Remaining bytes of the field (not NULL)
+  size_t data_len;     ///< Length of data in bytes
+  bool needs_unescape; ///< The bytes still contain escape sequences
+} GTEXT_CSV_Field_View;
+
 /**
  * @brief CSV event structure
  *
@@ -41,6 +61,9 @@ typedef struct {
   size_t data_len;  ///< Field data length (for FIELD events, 0 otherwise)
   size_t row_index; ///< Row index (0-based, for FIELD/RECORD events)
   size_t col_index; ///< Column index (0-based, for FIELD events)
+  const GTEXT_CSV_Field_View * view; ///< Raw field bytes (for FIELD events
+                                     ///< with field views enabled, NULL
+                                     ///< otherwise)
 } GTEXT_CSV_Event;
 
 /**
@@ -107,6 +130,192 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_stream_finish(
  */
 GTEXT_API void gtext_csv_stream_free(GTEXT_CSV_Stream * stream);
 
+/**
+ * @brief Report FIELD events as raw views instead of copied values
+ *
+ * By default each field is copied into the stream's own buffer and
+ * unescaped before it is reported, so that event->data is always the
+ * complete value. With field views enabled, each
+ * FIELD event carries a GTEXT_CSV_Field_View of the raw bytes instead: a
+ * field inside one chunk is reported in place, a field spanning chunks keeps
+ * only its bytes from earlier chunks, and nothing is unescaped. Consumers
+ * that only hash, compare or skip fields can then avoid both copies.
+ *
+ * event->data and event->data_len are still set when the view is a single
+ * piece with nothing to unescape; otherwise event->data is NULL and
+ * event->data_len is 0, and the value is read from event->view.
+ *
+ * @param stream Stream parser (must not be NULL)
+ * @param enabled Whether to report field views
+ * @return GTEXT_CSV_OK on success, or GTEXT_CSV_E_INVALID if input has
+ *         already been fed
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_stream_set_field_views(
+    GTEXT_CSV_Stream * stream, bool enabled);
+
+/**
+ * @brief Decode a field view into its value
+ *
+ * Joins the two pieces of @p view and, if it needs unescaping, resolves its
+ * escape sequences with the dialect's escape mode. The result is the same
+ * value a stream without field views reports in event->data.
+ *
+ * @param view Field view from a FIELD event (must not be NULL)
+ * @param dialect Dialect the stream was created with (must not be NULL)
+ * @param out Destination with room for prefix_len + data_len bytes
+ * @return Length of the decoded value in bytes
+ */
+GTEXT_API size_t gtext_csv_field_view_decode(const GTEXT_CSV_Field_View * view,
+    const GTEXT_CSV_Dialect * dialect, char * out);
+
+/**
+ * @brief Read callback function type
+ *
+ * Called by a batch reader when it needs more input. The callback should copy
+ * up to @p cap bytes into @p buf and store the number copied in @p len_out;
+ * storing 0 signals the end of input.
+ *
+ * @param user User-provided context pointer
+ * @param buf Destination buffer
+ * @param cap Capacity of @p buf in bytes (always > 0)
+ * @param len_out Number of bytes copied (0 at end of input)
+ * @return GTEXT_CSV_OK on success, error code on failure
+ */
+typedef GTEXT_CSV_Status (*GTEXT_CSV_Read_Function)(
+    void * user, char * buf, size_t cap, size_t * len_out);
+
+/**
+ * @brief One field of a batch row
+ *
+ * The bytes are not null-terminated. Empty fields have a non-NULL data
+ * pointer and a length of 0.
+ */
+typedef struct {
+  const char * data; ///< Field bytes
+  size_t length;     ///< Field length in bytes
+} GTEXT_CSV_Field_Span;
+
+/**
+ * @brief Opaque batch row reader structure
+ */
+typedef struct GTEXT_CSV_Reader GTEXT_CSV_Reader;
+
+/**
+ * @brief Opaque, reusable batch of parsed rows
+ */
+typedef struct GTEXT_CSV_Batch GTEXT_CSV_Batch;
+
+/**
+ * @brief Create a batch reader over an in-memory buffer
+ *
+ * The reader parses @p data a slice at a time, so the work per call follows
+ * the batch size rather than the input size. Unquoted fields point straight
+ * into @p data, which must stay valid until the reader is freed. Options are
+ * applied as for gtext_csv_stream_new() (row filters and select_names are
+ * table-only and are ignored).
+ *
+ * @param opts Parse options (can be NULL for defaults)
+ * @param data Input data
+ * @param len Length of input data
+ * @return New reader, or NULL on failure
+ */
+GTEXT_API GTEXT_CSV_Reader * gtext_csv_reader_new(
+    const GTEXT_CSV_Parse_Options * opts, const void * data, size_t len);
+
+/**
+ * @brief Create a batch reader that pulls input from a callback
+ *
+ * Input is read into a window owned by the reader. The window only holds the
+ * rows of the batch being filled, so memory stays bounded by the batch size
+ * (and the longest record) however long the input is.
+ *
+ * @param opts Parse options (can be NULL for defaults)
+ * @param read Read callback (must not be NULL)
+ * @param user User context passed to @p read
+ * @return New reader, or NULL on failure
+ */
+GTEXT_API GTEXT_CSV_Reader * gtext_csv_reader_new_source(
+    const GTEXT_CSV_Parse_Options * opts, GTEXT_CSV_Read_Function read,
+    void * user);
+
+/**
+ * @brief Fill a batch with the next rows of the input
+ *
+ * Replaces the contents of @p batch with up to @p max_rows rows, reusing its
+ * memory. Quoted fields and fields split across the reader's input slices
+ * are copied into the batch; every other field points into the input.
+ *
+ * Field pointers stay valid until the next call to this function on the same
+ * reader, or until the batch or reader is freed. Rows completed before a
+ * parse error are still returned; once they are used up, this and every later
+ * call report the error.
+ *
+ * @param reader Reader (must not be NULL)
+ * @param batch Batch to fill (must not be NULL)
+ * @param max_rows Maximum number of rows to return (must be > 0)
+ * @param err Error output structure (can be NULL)
+ * @return GTEXT_CSV_OK on success (a batch with no rows means the input is
+ *         exhausted), or error code
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_reader_next_batch(
+    GTEXT_CSV_Reader * reader, GTEXT_CSV_Batch * batch, size_t max_rows,
+    GTEXT_CSV_Error * err);
+
+/**
+ * @brief Free a batch reader
+ *
+ * @param reader Reader to free (can be NULL)
+ */
+GTEXT_API void gtext_csv_reader_free(GTEXT_CSV_Reader * reader);
+
+/**
+ * @brief Create an empty batch
+ *
+ * @return New batch, or NULL on failure
+ */
+GTEXT_API GTEXT_CSV_Batch * gtext_csv_batch_new(void);
+
+/**
+ * @brief Free a batch
+ *
+ * @param batch Batch to free (can be NULL)
+ */
+GTEXT_API void gtext_csv_batch_free(GTEXT_CSV_Batch * batch);
+
+/**
+ * @brief Get the number of rows in a batch
+ *
+ * @param batch Batch (must not be NULL)
+ * @return Number of rows
+ */
+GTEXT_API size_t gtext_csv_batch_row_count(const GTEXT_CSV_Batch * batch);
+
+/**
+ * @brief Get the fields of one batch row
+ *
+ * The fields of consecutive rows are stored back to back, so a whole batch
+ * can be walked from the first row's array.
+ *
+ * @param batch Batch (must not be NULL)
+ * @param row Row index within the batch
+ * @param field_count_out Number of fields in the row (can be NULL)
+ * @return Array of the row's fields, or NULL if @p row is out of bounds
+ */
+GTEXT_API const GTEXT_CSV_Field_Span * gtext_csv_batch_row(
+    const GTEXT_CSV_Batch * batch, size_t row, size_t * field_count_out);
+
+/**
+ * @brief Get one field of a batch row
+ *
+ * @param batch Batch (must not be NULL)
+ * @param row Row index within the batch
+ * @param col Column index
+ * @param len Output parameter for the field length (can be NULL)
+ * @return Field bytes (not null-terminated), or NULL if out of bounds
+ */
+GTEXT_API const char * gtext_csv_batch_field(const GTEXT_CSV_Batch * batch,
+    size_t row, size_t col, size_t * len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,6 +15,7 @@
 #include <ghoti.io/text/csv/csv_core.h>
 #include <ghoti.io/text/macros.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -267,8 +268,10 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_insert(GTEXT_CSV_Table * table,
  *
  * **Atomic Operation**: This function is atomic - either the entire operation
  * succeeds and the table remains in a consistent state, or it fails and the
- * table remains unchanged. This is a simple operation with no memory
- * allocations that can fail, ensuring atomicity.
+ * table remains unchanged. All memory allocations (converting a column-layout
+ * table to rows, copying a row block still shared with a clone) are performed
+ * before any state changes (including row shifting), so a failed allocation
+ * returns GTEXT_CSV_E_OOM with no partial state modifications.
  *
  * @param table Table (must not be NULL)
  * @param row_idx Row index to remove (0-based, data rows only)
@@ -399,11 +402,97 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_table_clear(GTEXT_CSV_Table * table);
  * allocations and copies succeed. If any step fails, the new context is freed
  * and the old context remains unchanged.
  *
+ * The whole table is copied in one call, so the old and new arenas are both
+ * held until it returns. gtext_csv_table_compact_step() spreads the same work
+ * over several calls.
+ *
  * @param table Table (must not be NULL)
  * @return GTEXT_CSV_OK on success, error code on failure
  */
 GTEXT_API GTEXT_CSV_Status gtext_csv_table_compact(GTEXT_CSV_Table * table);
 
+/**
+ * @brief Compact the table a few rows at a time
+ *
+ * The first call retires the table's arena and gives the table a fresh one
+ * that all later allocations use. Each call then copies the field arrays and
+ * field data of at most @p max_rows rows out of the retired arena. Once every
+ * row has been visited, the header map is copied and the retired arena is
+ * freed, which completes the compaction and sets @p done.
+ *
+ * The table stays fully usable between calls. Rows may be inserted, removed,
+ * replaced or sorted, and the compaction keeps track of which rows it has
+ * not visited yet. Data written between calls already lives in the new arena
+ * and is not copied again. In-situ fields keep pointing to the input buffer.
+ *
+ * Each call does work proportional to @p max_rows (plus the header map in the
+ * last call), so long-running programs can reclaim memory without the pause
+ * of a full gtext_csv_table_compact(). Calling gtext_csv_table_compact(),
+ * gtext_csv_table_clear() or gtext_csv_table_set_layout() while a compaction
+ * is running abandons it; the retired arena is kept until the next
+ * compaction.
+ *
+ * A table in the column layout has nothing to copy row by row, so the call
+ * compacts it fully, like gtext_csv_table_compact(), and sets @p done.
+ *
+ * Pointers returned by gtext_csv_field() may be invalidated by any call.
+ *
+ * @param table Table (must not be NULL)
+ * @param max_rows Maximum number of rows to copy (must be greater than 0)
+ * @param done Set to true when the compaction has completed (can be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID on bad arguments, or
+ *         GTEXT_CSV_E_OOM (the rows copied so far stay copied, and the next
+ *         call resumes the compaction)
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_table_compact_step(
+    GTEXT_CSV_Table * table, size_t max_rows, bool * done);
+
+/**
+ * @brief Memory held by a table, in bytes
+ *
+ * Rows are kept in fixed-size row blocks reached through a block directory,
+ * so the row index grows one block at a time and never leaves discarded
+ * copies behind. Each parsed row's field array holds exactly its fields.
+ */
+typedef struct {
+  size_t arena_bytes;       ///< Bytes reserved by the table's arena
+  size_t arena_used_bytes;  ///< Bytes handed out from the arena
+  size_t row_index_bytes;   ///< Row blocks and their directory
+  size_t row_slack_bytes;   ///< Part of row_index_bytes past the last row
+  size_t field_array_bytes; ///< Field arrays of the current rows
+  size_t column_bytes;      ///< Offset, length and width arrays of column-major
+                            ///< storage (0 in the row layout; the cell heap
+                            ///< is in the arena)
+  size_t live_bytes; ///< Part of arena_used_bytes reachable from the table
+  size_t dead_bytes; ///< Part of arena_used_bytes that compaction would free
+  size_t compacting_bytes; ///< Part of arena_bytes held by a retired arena
+                           ///< until gtext_csv_table_compact_step() completes
+  size_t shared_bytes; ///< Used bytes of arenas shared with copy-on-write
+                       ///< clones (not part of arena_bytes)
+} GTEXT_CSV_Memory_Stats;
+
+/**
+ * @brief Report the memory held by a table
+ *
+ * Field data, field arrays, header names, and the column-major cell heap live
+ * in the arena. Bytes that are used but no longer reachable (e.g. replaced by
+ * gtext_csv_field_set()) stay in arena_used_bytes until
+ * gtext_csv_table_compact() is called.
+ *
+ * live_bytes counts the field arrays, field data, column-major cells, and
+ * header map entries the table can still reach, and dead_bytes is the rest of
+ * arena_used_bytes (alignment padding included). Both are computed by walking
+ * the rows, so the call costs time proportional to the number of fields.
+ * Comparing dead_bytes with arena_used_bytes tells when a compaction is
+ * worthwhile.
+ *
+ * @param table Table (must not be NULL)
+ * @param stats Output statistics (must not be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID on bad arguments
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_table_memory_stats(
+    const GTEXT_CSV_Table * table, GTEXT_CSV_Memory_Stats * stats);
+
 /**
  * @brief Append a new column to all rows in the table
  *
@@ -614,10 +703,11 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert_with_values(
  *
  * **Atomic Operation**: This function is atomic - either the entire operation
  * succeeds and the table remains in a consistent state, or it fails and the
- * table remains unchanged. This operation involves shifting fields in all rows
- * and updating the header map, but no memory allocations that can fail,
- * ensuring atomicity. Header map entry removal and reindexing occur before the
- * final atomic state update.
+ * table remains unchanged. All memory allocations (copying rows still shared
+ * with a clone) are performed before any fields are shifted or header map
+ * entries are removed, so a failed allocation returns GTEXT_CSV_E_OOM with no
+ * partial state modifications. Header map entry removal and reindexing occur
+ * before the final atomic state update.
  *
  * @param table Table (must not be NULL)
  * @param col_idx Column index to remove (0-based, must be < column count)
@@ -869,6 +959,362 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_set_header_row(
  */
 GTEXT_API GTEXT_CSV_Table * gtext_csv_clone(const GTEXT_CSV_Table * source);
 
+/**
+ * @brief Create a copy-on-write clone of a CSV table
+ *
+ * The clone shares the source's row blocks, field arrays and field data
+ * instead of copying them, so cloning costs time proportional to the number
+ * of row blocks and columns rather than to the number of fields. The two
+ * tables stay independent: modifications to one do not affect the other.
+ *
+ * Shared storage is never written. gtext_csv_field_set() and
+ * gtext_csv_row_set() copy only the row they change, and row inserts,
+ * appends and removals copy only the row blocks they touch. Operations that
+ * rewrite every row (column changes, gtext_csv_normalize_rows(),
+ * gtext_csv_set_header_row() and gtext_csv_table_sort()) first copy all of
+ * the table's shared rows, but not their field data. gtext_csv_table_compact()
+ * copies everything the table still shares and drops its reference, and the
+ * shared memory is freed with the last table using it (see shared_bytes in
+ * GTEXT_CSV_Memory_Stats).
+ *
+ * The first clone of a table moves the table's arena into the shared storage,
+ * so it modifies @p source and must not run concurrently with other use of
+ * it. Cloning a table again before it is modified only reads it and can run
+ * from several threads at once.
+ *
+ * In-situ fields keep referencing the input buffer, which must stay valid
+ * for as long as the clone uses it. A table in the
+ * GTEXT_CSV_LAYOUT_COLUMNS layout is deep-copied as by gtext_csv_clone().
+ *
+ * The cloned table must be freed separately with gtext_csv_free_table(); the
+ * tables can be freed in any order.
+ *
+ * @param source Source table to clone (must not be NULL)
+ * @return New cloned table, or NULL on allocation failure
+ */
+GTEXT_API GTEXT_CSV_Table * gtext_csv_clone_cow(GTEXT_CSV_Table * source);
+
+/**
+ * @brief Read-only view of one column of a column-major table
+ *
+ * Cell i of the column (data row i, header excluded) is the @c lengths[i]
+ * bytes at @c heap + @c offsets[i], followed by a NUL byte. A row that is
+ * shorter than the column reads as an empty cell.
+ */
+typedef struct {
+  const char * heap;      ///< Byte heap holding the cells
+  const size_t * offsets; ///< Heap offset of each cell
+  const size_t * lengths; ///< Length of each cell
+  size_t count;           ///< Number of cells (data rows)
+} GTEXT_CSV_Column_View;
+
+/**
+ * @brief Switch a table between row-major and column-major storage
+ *
+ * In GTEXT_CSV_LAYOUT_COLUMNS, cell bytes live in one contiguous heap and
+ * each column keeps an offset and a length per row. Reading a column
+ * (gtext_csv_column_view()) and appending, inserting, removing, or renaming
+ * columns then cost O(rows) with sequential memory access instead of
+ * touching every row's field array. gtext_csv_field() and the other read
+ * functions work unchanged in both layouts.
+ *
+ * Column operations on a table with irregular rows, and row-oriented
+ * mutations (row append/insert/remove/set, normalization, header toggling),
+ * switch the table back to GTEXT_CSV_LAYOUT_ROWS before they run.
+ *
+ * The heap is allocated from the table's arena. When it grows, the cells are
+ * copied to a larger allocation and the old one stays in the arena, so
+ * pointers returned by gtext_csv_field() stay valid in either layout, and
+ * across layout switches, until gtext_csv_table_compact() or the table is
+ * freed. Cells replaced by gtext_csv_field_set(), outgrown heaps, and field
+ * arrays left behind by a layout switch are reported as dead_bytes by
+ * gtext_csv_table_memory_stats() and freed by gtext_csv_table_compact().
+ *
+ * @param table Table (must not be NULL)
+ * @param layout Target layout
+ * @return GTEXT_CSV_OK on success, error code on failure (the table is
+ * unchanged on failure)
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_table_set_layout(
+    GTEXT_CSV_Table * table, GTEXT_CSV_Layout layout);
+
+/**
+ * @brief Get the current storage layout of a table
+ *
+ * @param table Table (must not be NULL)
+ * @return Current layout (GTEXT_CSV_LAYOUT_ROWS for a NULL table)
+ */
+GTEXT_API GTEXT_CSV_Layout gtext_csv_table_layout(
+    const GTEXT_CSV_Table * table);
+
+/**
+ * @brief Get a read-only view of a column
+ *
+ * Only available in GTEXT_CSV_LAYOUT_COLUMNS. The view is valid until the
+ * table is next modified.
+ *
+ * @param table Table (must not be NULL)
+ * @param col Column index (0-based)
+ * @param view Output view (must not be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID if the table is not
+ * column-major or col is out of range
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_view(const GTEXT_CSV_Table * table,
+    size_t col, GTEXT_CSV_Column_View * view);
+
+/**
+ * @brief Value type of a converted column
+ */
+typedef enum {
+  GTEXT_CSV_TYPE_STRING,   ///< No conversion applies (text)
+  GTEXT_CSV_TYPE_I64,      ///< Signed 64-bit integer
+  GTEXT_CSV_TYPE_F64,      ///< Double-precision float
+  GTEXT_CSV_TYPE_BOOL,     ///< Boolean
+  GTEXT_CSV_TYPE_TIMESTAMP ///< ISO 8601 date or date-time
+} GTEXT_CSV_Value_Type;
+
+/**
+ * @brief Convert a column to 64-bit integers
+ *
+ * Converts every data row (header excluded) of column @p col in one pass.
+ * Cells are optional sign followed by decimal digits, with no surrounding
+ * whitespace; digits are consumed eight at a time where possible.
+ *
+ * Empty cells, and rows too short to have the column, are nulls: their bit in
+ * @p validity is cleared and their value is 0. Bit i of the bitmap is
+ * `validity[i / 8] >> (i % 8) & 1`, set for valid cells. When @p validity is
+ * NULL, nulls are reported as bad cells instead.
+ *
+ * On a bad cell the conversion stops and @p err (if not NULL) receives
+ * GTEXT_CSV_E_INVALID with the data row in @c row_index and @p col in
+ * @c col_index. Use gtext_csv_header_index() to find @p col by name.
+ *
+ * @param table Table (must not be NULL)
+ * @param col Column index (0-based, must be < the table's column count)
+ * @param out Output values, one per data row (must not be NULL if there are
+ * data rows)
+ * @param validity Output bitmap of (rows + 7) / 8 bytes, or NULL
+ * @param err Error output (may be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID on a bad cell or bad
+ * arguments
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_as_i64(
+    const GTEXT_CSV_Table * table, size_t col, int64_t * out,
+    uint8_t * validity, GTEXT_CSV_Error * err);
+
+/**
+ * @brief Convert a column to doubles
+ *
+ * Accepts decimal numbers with an optional sign, fraction, and exponent
+ * (`-12.5e3`); `inf`, `nan`, hex floats, and values that overflow are bad
+ * cells. When the significant digits form an integer of at most 2^53 and the
+ * decimal exponent is within [-22, 22], the value is converted exactly without
+ * calling strtod(); everything else falls back to strtod(). Nulls and errors
+ * are handled as in gtext_csv_column_as_i64().
+ *
+ * @param table Table (must not be NULL)
+ * @param col Column index (0-based)
+ * @param out Output values, one per data row
+ * @param validity Output bitmap of (rows + 7) / 8 bytes, or NULL
+ * @param err Error output (may be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID on a bad cell or bad
+ * arguments
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_as_f64(
+    const GTEXT_CSV_Table * table, size_t col, double * out, uint8_t * validity,
+    GTEXT_CSV_Error * err);
+
+/**
+ * @brief Convert a column to booleans
+ *
+ * Accepts `true`/`false` (any letter case) and `1`/`0`. Nulls and errors are
+ * handled as in gtext_csv_column_as_i64().
+ *
+ * @param table Table (must not be NULL)
+ * @param col Column index (0-based)
+ * @param out Output values, one per data row
+ * @param validity Output bitmap of (rows + 7) / 8 bytes, or NULL
+ * @param err Error output (may be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID on a bad cell or bad
+ * arguments
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_as_bool(
+    const GTEXT_CSV_Table * table, size_t col, bool * out, uint8_t * validity,
+    GTEXT_CSV_Error * err);
+
+/**
+ * @brief Convert a column of ISO 8601 timestamps to Unix microseconds
+ *
+ * Accepts `YYYY-MM-DD`, optionally followed by `T` or a space and
+ * `HH:MM[:SS[.fraction]]` and a zone of `Z` or `+HH:MM`/`-HH:MM` (the colon
+ * is optional). Times without a zone are taken as UTC. Fractions beyond
+ * microseconds are truncated. Nulls and errors are handled as in
+ * gtext_csv_column_as_i64().
+ *
+ * @param table Table (must not be NULL)
+ * @param col Column index (0-based)
+ * @param out Output microseconds since 1970-01-01T00:00:00Z, one per data row
+ * @param validity Output bitmap of (rows + 7) / 8 bytes, or NULL
+ * @param err Error output (may be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID on a bad cell or bad
+ * arguments
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_as_timestamp(
+    const GTEXT_CSV_Table * table, size_t col, int64_t * out,
+    uint8_t * validity, GTEXT_CSV_Error * err);
+
+/**
+ * @brief Infer the value type of a column from a sample of its cells
+ *
+ * Checks the non-empty cells of the first @p sample_rows data rows against
+ * each conversion in the order I64, F64, BOOL, TIMESTAMP and reports the
+ * first one that accepts them all, or GTEXT_CSV_TYPE_STRING if none does (or
+ * every sampled cell is empty). A sample can be fooled by later rows, so the
+ * conversion itself may still report a bad cell.
+ *
+ * @param table Table (must not be NULL)
+ * @param col Column index (0-based)
+ * @param sample_rows Number of data rows to inspect (0 = all rows)
+ * @param type_out Inferred type (must not be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID on bad arguments
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_infer_type(
+    const GTEXT_CSV_Table * table, size_t col, size_t sample_rows,
+    GTEXT_CSV_Value_Type * type_out);
+
+/**
+ * @brief Build a hash index on a column
+ *
+ * Maps each distinct value of column @p col to the data rows (header
+ * excluded) holding it, so gtext_csv_lookup() finds them without scanning the
+ * table. Rows too short to have the column are not indexed. The index is
+ * owned by the table and freed with it; building an index on a column that
+ * already has one rebuilds it.
+ *
+ * The index follows later changes to the table. Appended, inserted, removed,
+ * and replaced rows are patched into the index in place; an insert or remove
+ * renumbers the indexed rows after it, which touches every key but hashes
+ * nothing. gtext_csv_field_set() on the indexed column, sorting, clearing,
+ * and other changes to row contents mark the index stale, and the next lookup
+ * rebuilds it. Inserting or removing columns renumbers the index along with
+ * its column; removing the indexed column drops the index.
+ *
+ * @param table Table (must not be NULL)
+ * @param col Column index (0-based)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID on bad arguments, or
+ * GTEXT_CSV_E_OOM
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_build_index(
+    GTEXT_CSV_Table * table, size_t col);
+
+/**
+ * @brief Drop the hash index on a column
+ *
+ * @param table Table (must not be NULL)
+ * @param col Column index (0-based)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID if the column has no
+ * index
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_drop_index(
+    GTEXT_CSV_Table * table, size_t col);
+
+/**
+ * @brief Find the data rows whose indexed column equals a value
+ *
+ * Values are compared byte for byte. @p rows receives the matching data rows
+ * in ascending order, valid until the table or its indexes next change. When
+ * no row matches, @p count is 0 and @p rows is NULL. A stale index is rebuilt
+ * first.
+ *
+ * @param table Table (must not be NULL)
+ * @param col Indexed column (0-based)
+ * @param value Value to find (may be NULL if @p value_len is 0)
+ * @param value_len Value length in bytes
+ * @param rows Output array of matching data rows (must not be NULL)
+ * @param count Output number of matching rows (must not be NULL)
+ * @return GTEXT_CSV_OK on success (including no match), GTEXT_CSV_E_INVALID
+ * if @p col has no index or on bad arguments, or GTEXT_CSV_E_OOM
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_lookup(GTEXT_CSV_Table * table,
+    size_t col, const char * value, size_t value_len, const size_t ** rows,
+    size_t * count);
+
+/**
+ * @brief Inner-join two tables on equal key columns
+ *
+ * Returns a new table with one row for every pair of a @p left data row and
+ * a @p right data row whose key cells are equal byte for byte. Each row holds
+ * the left row's fields followed by the right row's fields, each side padded
+ * with empty fields to that table's widest row, so the result is
+ * rectangular. Rows come in left row order, then right row order. When both
+ * tables have a header row, the result's header is the left names followed
+ * by the right names; otherwise it has none. Names may repeat (both key
+ * columns are often named alike); as with a parsed header, a lookup by name
+ * finds the first column of that name. Rows too short to have the key column
+ * never match.
+ *
+ * The right table is probed through its index on @p right_col when it has
+ * one; otherwise a temporary index is built and freed.
+ *
+ * @param left Left table (must not be NULL)
+ * @param left_col Key column of the left table (0-based)
+ * @param right Right table (must not be NULL)
+ * @param right_col Key column of the right table (0-based)
+ * @param err Error output (may be NULL)
+ * @return New table (free with gtext_csv_free_table()), or NULL on failure
+ */
+GTEXT_API GTEXT_CSV_Table * gtext_csv_hash_join(GTEXT_CSV_Table * left,
+    size_t left_col, GTEXT_CSV_Table * right, size_t right_col,
+    GTEXT_CSV_Error * err);
+
+/**
+ * @brief How a sort key compares cells
+ */
+typedef enum {
+  GTEXT_CSV_COMPARE_LEXICOGRAPHIC, ///< Byte order (a prefix sorts first)
+  GTEXT_CSV_COMPARE_NUMERIC,       ///< Decimal value; non-numbers sort last
+  GTEXT_CSV_COMPARE_NATURAL        ///< Digit runs by value (`a2` < `a10`)
+} GTEXT_CSV_Compare;
+
+/**
+ * @brief One key of a table sort
+ */
+typedef struct {
+  size_t column;             ///< Column to compare (0-based)
+  GTEXT_CSV_Compare compare; ///< How cells of the column compare
+  bool descending;           ///< Sort this key from largest to smallest
+} GTEXT_CSV_Sort_Key;
+
+/**
+ * @brief Sort the data rows of a table
+ *
+ * Orders data rows by @p keys in turn: rows equal on the first key are
+ * ordered by the second, and so on. The sort is stable, so rows equal on
+ * every key keep their relative order, and the header row stays first. Cells
+ * missing from short rows compare as empty.
+ *
+ * Numeric keys accept the same text as gtext_csv_column_as_f64(); empty and
+ * non-numeric cells sort after every number in either direction, and
+ * compare by bytes among themselves. Natural keys compare runs of ASCII digits
+ * by value, ignoring leading zeros, and other bytes in byte order.
+ *
+ * Only the row order changes: field bytes are not moved or copied. Each
+ * row's first key is reduced to an order-preserving 64-bit prefix, so most
+ * comparisons never touch cell bytes. With @p threads above 1, tables with at
+ * least 16384 data rows per thread are split into runs that are sorted on
+ * separate threads and then merged. Column indexes are rebuilt on their next
+ * lookup.
+ *
+ * @param table Table (must not be NULL)
+ * @param keys Sort keys (must not be NULL)
+ * @param key_count Number of keys (must be > 0)
+ * @param threads Worker threads to use (0 or 1 = sort on the calling thread)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID on bad arguments, or
+ * GTEXT_CSV_E_OOM (the table is unchanged on failure)
+ */
+GTEXT_API GTEXT_CSV_Status gtext_csv_table_sort(GTEXT_CSV_Table * table,
+    const GTEXT_CSV_Sort_Key * keys, size_t key_count, size_t threads);
+
 #ifdef __cplusplus
 }
 #endif
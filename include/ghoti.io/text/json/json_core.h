@@ -150,6 +150,9 @@ typedef struct {
   bool parse_uint64;          ///< Detect and parse exact uint64 representation
   bool parse_double;      ///< Derive double representation when representable
   bool allow_big_decimal; ///< Store decimal as string-backed big-decimal
+  bool lazy_numbers; ///< Keep only the lexeme while parsing and derive the
+                     ///< representations enabled above on first access
+                     ///< (implies preserve_number_lexeme, default: off)
 } GTEXT_JSON_Parse_Options;
 
 /**
@@ -531,11 +531,26 @@ GTEXT_API bool gtext_json_equal(const GTEXT_JSON_Value * a,
     const GTEXT_JSON_Value * b, GTEXT_JSON_Equal_Mode mode);
 
 /**
- * @brief Deep clone a JSON value into a new arena
- *
- * Creates a deep copy of a JSON value, allocating all memory from a new
- * arena. The cloned value is independent of the original and must be freed
- * separately using gtext_json_free().
+ * @brief Clone a JSON value
+ *
+ * The clone behaves as an independent deep copy and must be freed separately
+ * using gtext_json_free(); the source and the clone may be freed in either
+ * order. Cloning a container is O(1): the clone shares the source's nodes,
+ * and a node is copied into the clone's own arena only when a mutation of
+ * the clone reaches it (copy-on-write), so modifying a clone copies just the
+ * path from its root to the modified node.
+ *
+ * The source is always modified in place, so values previously obtained from
+ * it stay valid and keep referring to it. The first modification of the
+ * source (through any of its values) while clones still share its nodes
+ * makes those clones copy everything they share, which costs O(size of the
+ * clone) once.
+ *
+ * Nested values of a clone must be modified through values returned by
+ * gtext_json_pointer_get_mut(); values returned by the const getters may be
+ * shared and must not be cast and modified. Shared nodes are not
+ * synchronized, so a clone and its source must not be used concurrently from
+ * different threads.
  *
  * @param src Source value to clone (must not be NULL)
  * @return Cloned value, or NULL on allocation failure
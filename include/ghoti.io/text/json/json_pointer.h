@@ -64,6 +64,11 @@ GTEXT_API const GTEXT_JSON_Value * gtext_json_pointer_get(
  * allows modification of the referenced value. The returned pointer is
  * valid for the lifetime of the DOM tree.
  *
+ * If @p root is a clone (see gtext_json_clone()), the nodes it still shares
+ * along the path are copied first; if it is the source of clones, they stop
+ * sharing its nodes first. Either way the result can be modified without
+ * affecting the other tree. NULL is also returned if that copy fails.
+ *
  * @param root Root JSON value to evaluate pointer against (must not be NULL)
  * @param ptr JSON Pointer string (must not be NULL)
  * @param len Length of pointer string in bytes
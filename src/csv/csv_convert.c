@@ -0,0 +1,549 @@
+/**
+ * @file
+ *
+ * Typed column conversion for CSV tables.
+ *
+ * Converts a whole table column to integers, doubles, booleans, or
+ * timestamps in one pass, with a validity bitmap for empty cells. Digit runs
+ * are consumed eight bytes at a time with the SWAR helpers in text_simd.h.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../text_simd.h"
+#include "csv_internal.h"
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_table.h>
+
+// Signature shared by the per-cell converters
+// Returns GTEXT_CSV_OK, GTEXT_CSV_E_INVALID for a bad cell, or GTEXT_CSV_E_OOM
+typedef GTEXT_CSV_Status (*csv_convert_fn)(
+    const unsigned char * s, size_t len, void * out);
+
+// Maximum number of decimal digits that always fit in a uint64_t
+#define CSV_CONVERT_MAX_DIGITS 19
+
+// Cells up to this length are handed to strtod() from a stack copy
+#define CSV_CONVERT_STACK_CELL 64
+
+// Powers of ten that are exact as doubles
+static const double csv_convert_pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+    1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+    1e19, 1e20, 1e21, 1e22};
+
+// Index of the first data row and the number of data rows
+static size_t csv_convert_data_rows(
+    const GTEXT_CSV_Table * table, size_t * start_out) {
+  size_t start = (table->has_header && table->row_count > 0) ? 1 : 0;
+  *start_out = start;
+  return table->row_count - start;
+}
+
+// Accumulate a run of decimal digits into value, eight at a time where
+// possible; at most max_digits digits are consumed
+// Returns the number of digits consumed
+static size_t csv_convert_digits(const unsigned char * s, size_t len,
+    size_t max_digits, uint64_t * value) {
+  size_t i = 0;
+  uint64_t v = *value;
+  while (len - i >= 8 && max_digits - i >= 8 && text_simd_is_8digits(s + i)) {
+    v = v * 100000000u + text_simd_parse_8digits(s + i);
+    i += 8;
+  }
+  while (i < len && i < max_digits && (unsigned)(s[i] - '0') <= 9) {
+    v = v * 10 + (unsigned)(s[i] - '0');
+    i++;
+  }
+  *value = v;
+  return i;
+}
+
+// [+-]digits, no whitespace
+static GTEXT_CSV_Status csv_convert_i64(
+    const unsigned char * s, size_t len, void * out) {
+  size_t i = 0;
+  bool negative = false;
+  if (s[0] == '-' || s[0] == '+') {
+    negative = (s[0] == '-');
+    i = 1;
+  }
+  if (i == len) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  // Leading zeros do not count toward the digit limit
+  while (i < len - 1 && s[i] == '0') {
+    i++;
+  }
+  if (len - i > CSV_CONVERT_MAX_DIGITS) {
+    return GTEXT_CSV_E_INVALID; // Too long to fit, or not a number at all
+  }
+
+  uint64_t value = 0;
+  if (csv_convert_digits(s + i, len - i, len - i, &value) != len - i) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  int64_t result;
+  if (negative) {
+    if (value > (uint64_t)INT64_MAX + 1) {
+      return GTEXT_CSV_E_INVALID;
+    }
+    result = value == (uint64_t)INT64_MAX + 1 ? INT64_MIN : -(int64_t)value;
+  }
+  else {
+    if (value > (uint64_t)INT64_MAX) {
+      return GTEXT_CSV_E_INVALID;
+    }
+    result = (int64_t)value;
+  }
+
+  *(int64_t *)out = result;
+  return GTEXT_CSV_OK;
+}
+
+// Exact conversion through strtod() for values outside the fast path
+static GTEXT_CSV_Status csv_convert_f64_slow(
+    const unsigned char * s, size_t len, double * out) {
+  char stack_buf[CSV_CONVERT_STACK_CELL];
+  char * input = stack_buf;
+  if (len >= sizeof(stack_buf)) {
+    if (len > SIZE_MAX - 1) {
+      return GTEXT_CSV_E_OOM;
+    }
+    input = (char *)malloc(len + 1);
+    if (!input) {
+      return GTEXT_CSV_E_OOM;
+    }
+  }
+  memcpy(input, s, len);
+  input[len] = '\0';
+
+  char * endptr;
+  errno = 0;
+  double value = strtod(input, &endptr);
+  bool consumed = (endptr == input + len);
+  if (input != stack_buf) {
+    free(input);
+  }
+
+  // Underflow to zero or a denormal is fine; overflow is a bad cell
+  if (!consumed || isinf(value)) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  *out = value;
+  return GTEXT_CSV_OK;
+}
+
+// [+-]digits[.digits][(e|E)[+-]digits], at least one mantissa digit
+static GTEXT_CSV_Status csv_convert_f64(
+    const unsigned char * s, size_t len, void * out) {
+  size_t i = 0;
+  bool negative = false;
+  if (s[0] == '-' || s[0] == '+') {
+    negative = (s[0] == '-');
+    i = 1;
+  }
+
+  uint64_t mantissa = 0;
+  size_t digits = 0;      // Significant digits held in mantissa
+  int64_t exp10 = 0;      // Decimal exponent applied to mantissa
+  bool truncated = false; // Non-zero digits beyond the mantissa
+  bool any_digit = false;
+
+  // Integer part
+  while (i < len && s[i] == '0') {
+    any_digit = true;
+    i++;
+  }
+  size_t n = csv_convert_digits(
+      s + i, len - i, CSV_CONVERT_MAX_DIGITS, &mantissa);
+  digits += n;
+  any_digit |= (n > 0);
+  i += n;
+  for (; i < len && (unsigned)(s[i] - '0') <= 9; i++) {
+    truncated |= (s[i] != '0');
+    exp10++;
+  }
+
+  // Fraction
+  if (i < len && s[i] == '.') {
+    i++;
+    if (digits == 0) {
+      for (; i < len && s[i] == '0'; i++) {
+        any_digit = true;
+        exp10--;
+      }
+    }
+    n = csv_convert_digits(
+        s + i, len - i, CSV_CONVERT_MAX_DIGITS - digits, &mantissa);
+    digits += n;
+    exp10 -= (int64_t)n;
+    any_digit |= (n > 0);
+    i += n;
+    for (; i < len && (unsigned)(s[i] - '0') <= 9; i++) {
+      truncated |= (s[i] != '0');
+      any_digit = true;
+    }
+  }
+  if (!any_digit) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  // Exponent
+  if (i < len && (s[i] | 0x20) == 'e') {
+    i++;
+    bool exp_negative = false;
+    if (i < len && (s[i] == '-' || s[i] == '+')) {
+      exp_negative = (s[i] == '-');
+      i++;
+    }
+    if (i == len || (unsigned)(s[i] - '0') > 9) {
+      return GTEXT_CSV_E_INVALID;
+    }
+    int64_t e = 0;
+    for (; i < len && (unsigned)(s[i] - '0') <= 9; i++) {
+      if (e < 100000) {
+        e = e * 10 + (s[i] - '0');
+      }
+    }
+    exp10 += exp_negative ? -e : e;
+  }
+  if (i != len) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  // Fast path: mantissa and power of ten are both exact doubles, so one
+  // correctly rounded multiply or divide gives the correctly rounded result
+  double value;
+  if (mantissa == 0 && !truncated) {
+    value = 0.0;
+  }
+  else if (!truncated && mantissa <= (UINT64_C(1) << 53) && exp10 >= -22 &&
+      exp10 <= 22) {
+    value = (double)mantissa;
+    value = exp10 < 0 ? value / csv_convert_pow10[-exp10]
+                      : value * csv_convert_pow10[exp10];
+  }
+  else {
+    GTEXT_CSV_Status status = csv_convert_f64_slow(s, len, &value);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+    *(double *)out = value;
+    return GTEXT_CSV_OK;
+  }
+
+  *(double *)out = negative ? -value : value;
+  return GTEXT_CSV_OK;
+}
+
+// Case-insensitive comparison against a lowercase ASCII word
+static bool csv_convert_word_eq(
+    const unsigned char * s, size_t len, const char * word, size_t word_len) {
+  if (len != word_len) {
+    return false;
+  }
+  for (size_t i = 0; i < len; i++) {
+    if ((s[i] | 0x20) != (unsigned char)word[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// true/false (any case) or 1/0
+static GTEXT_CSV_Status csv_convert_bool(
+    const unsigned char * s, size_t len, void * out) {
+  bool value;
+  if ((len == 1 && s[0] == '1') || csv_convert_word_eq(s, len, "true", 4)) {
+    value = true;
+  }
+  else if ((len == 1 && s[0] == '0') ||
+      csv_convert_word_eq(s, len, "false", 5)) {
+    value = false;
+  }
+  else {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  *(bool *)out = value;
+  return GTEXT_CSV_OK;
+}
+
+// Fixed-width run of decimal digits
+static bool csv_convert_fixed(const unsigned char * s, size_t n, int * out) {
+  int v = 0;
+  for (size_t i = 0; i < n; i++) {
+    unsigned d = (unsigned)(s[i] - '0');
+    if (d > 9) {
+      return false;
+    }
+    v = v * 10 + (int)d;
+  }
+  *out = v;
+  return true;
+}
+
+// Days from 1970-01-01 to a proleptic Gregorian date
+static int64_t csv_convert_days_from_civil(int64_t y, int m, int d) {
+  y -= (m <= 2);
+  int64_t era = (y >= 0 ? y : y - 399) / 400;
+  int64_t yoe = y - era * 400;
+  int64_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+// Number of days in a month of a year
+static int csv_convert_days_in_month(int year, int month) {
+  static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  if (month == 2 &&
+      ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0)) {
+    return 29;
+  }
+  return days[month - 1];
+}
+
+// YYYY-MM-DD[(T| )HH:MM[:SS[.fraction]][Z|(+|-)HH[:]MM]]
+static GTEXT_CSV_Status csv_convert_timestamp(
+    const unsigned char * s, size_t len, void * out) {
+  int year, month, day;
+  if (len < 10 || s[4] != '-' || s[7] != '-' ||
+      !csv_convert_fixed(s, 4, &year) || !csv_convert_fixed(s + 5, 2, &month) ||
+      !csv_convert_fixed(s + 8, 2, &day)) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  if (month < 1 || month > 12 || day < 1 ||
+      day > csv_convert_days_in_month(year, month)) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  int hour = 0, minute = 0, second = 0;
+  int64_t micros = 0;
+  int64_t offset_seconds = 0;
+  size_t i = 10;
+  if (i < len) {
+    if ((s[i] != 'T' && s[i] != 't' && s[i] != ' ') || len - i < 6 ||
+        s[i + 3] != ':' || !csv_convert_fixed(s + i + 1, 2, &hour) ||
+        !csv_convert_fixed(s + i + 4, 2, &minute)) {
+      return GTEXT_CSV_E_INVALID;
+    }
+    i += 6;
+
+    if (i < len && s[i] == ':') {
+      if (len - i < 3 || !csv_convert_fixed(s + i + 1, 2, &second)) {
+        return GTEXT_CSV_E_INVALID;
+      }
+      i += 3;
+
+      if (i < len && s[i] == '.') {
+        i++;
+        size_t frac_digits = 0;
+        for (; i < len && (unsigned)(s[i] - '0') <= 9; i++, frac_digits++) {
+          if (frac_digits < 6) {
+            micros = micros * 10 + (s[i] - '0');
+          }
+        }
+        if (frac_digits == 0) {
+          return GTEXT_CSV_E_INVALID;
+        }
+        for (; frac_digits < 6; frac_digits++) {
+          micros *= 10;
+        }
+      }
+    }
+    if (hour > 23 || minute > 59 || second > 59) {
+      return GTEXT_CSV_E_INVALID;
+    }
+
+    // Zone
+    if (i < len && (s[i] == 'Z' || s[i] == 'z')) {
+      i++;
+    }
+    else if (i < len && (s[i] == '+' || s[i] == '-')) {
+      int sign = (s[i] == '-') ? -1 : 1;
+      int off_hour, off_minute;
+      i++;
+      if (len - i < 4 || !csv_convert_fixed(s + i, 2, &off_hour)) {
+        return GTEXT_CSV_E_INVALID;
+      }
+      i += 2;
+      if (s[i] == ':') {
+        i++;
+      }
+      if (len - i < 2 || !csv_convert_fixed(s + i, 2, &off_minute) ||
+          off_hour > 23 || off_minute > 59) {
+        return GTEXT_CSV_E_INVALID;
+      }
+      i += 2;
+      offset_seconds = sign * (off_hour * 3600 + off_minute * 60);
+    }
+  }
+  if (i != len) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  int64_t days = csv_convert_days_from_civil(year, month, day);
+  int64_t seconds =
+      days * 86400 + hour * 3600 + minute * 60 + second - offset_seconds;
+  *(int64_t *)out = seconds * 1000000 + micros;
+  return GTEXT_CSV_OK;
+}
+
+// Convert every data cell of a column with one converter
+static GTEXT_CSV_Status csv_convert_column(const GTEXT_CSV_Table * table,
+    size_t col, csv_convert_fn convert, void * out, size_t out_size,
+    uint8_t * validity, GTEXT_CSV_Error * err, const char * message) {
+  if (!table || col >= table->column_count) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Invalid table or column index");
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  size_t start;
+  size_t count = csv_convert_data_rows(table, &start);
+  if (count > 0 && !out) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Output buffer must not be NULL");
+    return GTEXT_CSV_E_INVALID;
+  }
+  if (validity) {
+    memset(validity, 0, count / 8 + (count % 8 != 0));
+  }
+
+  unsigned char * dst = (unsigned char *)out;
+  for (size_t i = 0; i < count; i++, dst += out_size) {
+    size_t len;
+    const char * data = csv_table_cell_at(table, start + i, col, &len);
+
+    GTEXT_CSV_Status status;
+    if (len == 0) {
+      if (validity) {
+        memset(dst, 0, out_size);
+        continue;
+      }
+      status = GTEXT_CSV_E_INVALID;
+    }
+    else {
+      status = convert((const unsigned char *)data, len, dst);
+    }
+
+    if (status != GTEXT_CSV_OK) {
+      CSV_SET_ERROR(err, status,
+          status == GTEXT_CSV_E_OOM ? "Out of memory converting cell"
+                                    : message);
+      if (err) {
+        err->row_index = i;
+        err->col_index = col;
+      }
+      return status;
+    }
+    if (validity) {
+      validity[i / 8] |= (uint8_t)(1u << (i % 8));
+    }
+  }
+
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_as_i64(
+    const GTEXT_CSV_Table * table, size_t col, int64_t * out,
+    uint8_t * validity, GTEXT_CSV_Error * err) {
+  return csv_convert_column(table, col, csv_convert_i64, out, sizeof(*out),
+      validity, err, "Cell is not a valid 64-bit integer");
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_as_f64(
+    const GTEXT_CSV_Table * table, size_t col, double * out, uint8_t * validity,
+    GTEXT_CSV_Error * err) {
+  return csv_convert_column(table, col, csv_convert_f64, out, sizeof(*out),
+      validity, err, "Cell is not a valid number");
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_as_bool(
+    const GTEXT_CSV_Table * table, size_t col, bool * out, uint8_t * validity,
+    GTEXT_CSV_Error * err) {
+  return csv_convert_column(table, col, csv_convert_bool, out, sizeof(*out),
+      validity, err, "Cell is not a valid boolean");
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_as_timestamp(
+    const GTEXT_CSV_Table * table, size_t col, int64_t * out,
+    uint8_t * validity, GTEXT_CSV_Error * err) {
+  return csv_convert_column(table, col, csv_convert_timestamp, out,
+      sizeof(*out), validity, err, "Cell is not a valid ISO 8601 timestamp");
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_infer_type(
+    const GTEXT_CSV_Table * table, size_t col, size_t sample_rows,
+    GTEXT_CSV_Value_Type * type_out) {
+  if (!table || !type_out || col >= table->column_count) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  // Candidates in order of preference
+  static const struct {
+    GTEXT_CSV_Value_Type type;
+    csv_convert_fn convert;
+  } candidates[] = {
+      {GTEXT_CSV_TYPE_I64, csv_convert_i64},
+      {GTEXT_CSV_TYPE_F64, csv_convert_f64},
+      {GTEXT_CSV_TYPE_BOOL, csv_convert_bool},
+      {GTEXT_CSV_TYPE_TIMESTAMP, csv_convert_timestamp},
+  };
+  const size_t candidate_count = sizeof(candidates) / sizeof(candidates[0]);
+  unsigned remaining = (1u << candidate_count) - 1;
+  bool any_cell = false;
+
+  size_t start;
+  size_t count = csv_convert_data_rows(table, &start);
+  if (sample_rows > 0 && sample_rows < count) {
+    count = sample_rows;
+  }
+
+  for (size_t i = 0; i < count && remaining != 0; i++) {
+    size_t len;
+    const char * data = csv_table_cell_at(table, start + i, col, &len);
+    if (len == 0) {
+      continue;
+    }
+    any_cell = true;
+
+    for (size_t k = 0; k < candidate_count; k++) {
+      union {
+        int64_t i64;
+        double f64;
+        bool b;
+      } scratch;
+      if ((remaining & (1u << k)) &&
+          candidates[k].convert((const unsigned char *)data, len, &scratch) !=
+              GTEXT_CSV_OK) {
+        remaining &= ~(1u << k);
+      }
+    }
+  }
+
+  *type_out = GTEXT_CSV_TYPE_STRING;
+  if (any_cell) {
+    for (size_t k = 0; k < candidate_count; k++) {
+      if (remaining & (1u << k)) {
+        *type_out = candidates[k].type;
+        break;
+      }
+    }
+  }
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_INTERNAL_API GTEXT_CSV_Status csv_convert_parse_f64(
+    const char * data, size_t len, double * out) {
+  if (len == 0) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  return csv_convert_f64((const unsigned char *)data, len, out);
+}
@@ -44,6 +44,16 @@ GTEXT_API GTEXT_CSV_Parse_Options gtext_csv_parse_options_default(void) {
   opts.max_total_bytes = 0;  // Library default
   opts.enable_context_snippet = true;
   opts.context_radius_bytes = CSV_DEFAULT_CONTEXT_RADIUS_BYTES;
+  opts.parse_threads = 0; // Serial
+  opts.layout = GTEXT_CSV_LAYOUT_ROWS;
+  opts.select_columns = NULL; // Every column
+  opts.select_column_count = 0;
+  opts.select_names = NULL;
+  opts.select_name_count = 0;
+  opts.row_conditions = NULL; // Keep every row
+  opts.row_condition_count = 0;
+  opts.row_filter = NULL;
+  opts.row_filter_data = NULL;
   return opts;
 }
 
@@ -57,5 +67,6 @@ GTEXT_API GTEXT_CSV_Write_Options gtext_csv_write_options_default(void) {
   opts.always_escape_quotes = true; // Default behavior depends on escape mode
   opts.trailing_newline = false;
   opts.trim_trailing_empty_fields = false;
+  opts.write_threads = 0;
   return opts;
 }
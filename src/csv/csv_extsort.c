@@ -0,0 +1,912 @@
+/**
+ * @file
+ *
+ * External-memory CSV sort implementation.
+ *
+ * A batch reader pulls records from the input into a table until the
+ * estimated size of the buffered records reaches the memory budget. The
+ * table is then sorted and written to a run file. Runs are merged through a
+ * binary heap of cursors, each holding one small batch of its run, with ties
+ * going to the earlier run so the sort stays stable. Too many runs for one
+ * merge are merged in consecutive groups first.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#ifndef _MSC_VER
+#define _XOPEN_SOURCE 600
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _MSC_VER
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "csv_internal.h"
+
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_extsort.h>
+#include <ghoti.io/text/csv/csv_stream.h>
+#include <ghoti.io/text/csv/csv_table.h>
+#include <ghoti.io/text/csv/csv_writer.h>
+
+// Memory budget used when the options leave it at 0
+#define CSV_EXTSORT_DEFAULT_MEMORY ((size_t)256 * 1024 * 1024)
+
+// Most runs merged at once (each holds an open file and a batch)
+#define CSV_EXTSORT_MAX_FAN_IN 64
+
+// Records read from the input per batch
+#define CSV_EXTSORT_INPUT_BATCH_ROWS 4096
+
+// Records each merge cursor reads from its run per batch
+#define CSV_EXTSORT_RUN_BATCH_ROWS 256
+
+// Records merged between progress reports
+#define CSV_EXTSORT_PROGRESS_ROWS 65536
+
+// Bytes a buffered record is charged on top of its field bytes, for its row
+// slot and the items sorting it allocates
+#define CSV_EXTSORT_ROW_OVERHEAD 64
+
+#ifdef _MSC_VER
+typedef struct __stat64 csv_extsort_stat_t;
+#define csv_extsort_stat _stat64
+#else
+typedef struct stat csv_extsort_stat_t;
+#define csv_extsort_stat stat
+#endif
+
+// A file read by a batch reader
+typedef struct {
+  FILE * file;
+  uint64_t * bytes_read; // Counter to advance (can be NULL)
+} csv_extsort_source;
+
+// A file written by a CSV writer
+typedef struct {
+  FILE * file;
+  GTEXT_CSV_Sink sink;
+  GTEXT_CSV_Writer * writer;
+  size_t * rows_written; // Counter to advance (can be NULL)
+} csv_extsort_output;
+
+// State of one external sort
+typedef struct {
+  const GTEXT_CSV_Extsort_Options * opts;
+  const char * temp_dir;
+  GTEXT_CSV_Parse_Options run_parse; // Options run files are read with
+  GTEXT_CSV_Write_Options run_write; // Options run files are written with
+  char ** runs;         // Run files not yet merged, in input order
+  size_t run_count;
+  char ** merged;       // Run files written by the current merge pass
+  size_t merged_count;
+  const char ** fields; // Scratch field pointers of one record
+  size_t * lengths;     // Scratch field lengths of one record
+  size_t field_capacity;
+  GTEXT_CSV_Field_Span * keys; // Scratch key cells of one record
+  double * numbers;            // Scratch key values of one record
+  // Key of the last record written, for unique sorts
+  GTEXT_CSV_Field_Span * last_keys;
+  double * last_numbers;
+  char * last_data;
+  size_t last_capacity;
+  bool has_last;
+  GTEXT_CSV_Extsort_Progress progress;
+  GTEXT_CSV_Error * err;
+} csv_extsort;
+
+// A run being merged
+typedef struct {
+  csv_extsort_source source;
+  GTEXT_CSV_Reader * reader;
+  GTEXT_CSV_Batch * batch;
+  size_t next;                         // Next record of the batch
+  const GTEXT_CSV_Field_Span * fields; // Current record
+  size_t field_count;
+  GTEXT_CSV_Field_Span * keys; // Key cells of the current record
+  double * numbers;            // Key values of the current record
+  size_t order;                // Position of the run in input order
+} csv_extsort_cursor;
+
+// Read callback over a file
+static GTEXT_CSV_Status csv_extsort_read(
+    void * user, char * buf, size_t cap, size_t * len_out) {
+  csv_extsort_source * source = (csv_extsort_source *)user;
+  *len_out = fread(buf, 1, cap, source->file);
+  if (*len_out == 0 && ferror(source->file)) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  if (source->bytes_read) {
+    *source->bytes_read += *len_out;
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Write callback over a file
+static GTEXT_CSV_Status csv_extsort_write(
+    void * user, const char * bytes, size_t len) {
+  FILE * file = (FILE *)user;
+  return fwrite(bytes, 1, len, file) == len ? GTEXT_CSV_OK : GTEXT_CSV_E_WRITE;
+}
+
+// Report progress to the caller, if asked
+static void csv_extsort_report(const csv_extsort * sorter) {
+  if (sorter->opts->progress) {
+    sorter->opts->progress(&sorter->progress, sorter->opts->progress_data);
+  }
+}
+
+// Start writing CSV to an open file (the output owns the file from here on)
+static GTEXT_CSV_Status csv_extsort_output_open(csv_extsort * sorter,
+    csv_extsort_output * out, FILE * file,
+    const GTEXT_CSV_Write_Options * opts) {
+  out->file = file;
+  out->sink.write = csv_extsort_write;
+  out->sink.user = file;
+  out->writer = gtext_csv_writer_new(&out->sink, opts);
+  if (!out->writer) {
+    CSV_SET_ERROR(sorter->err, GTEXT_CSV_E_OOM, "Failed to create CSV writer");
+    return GTEXT_CSV_E_OOM;
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Finish an output and close its file; only a successful write is flushed
+// and checked
+static GTEXT_CSV_Status csv_extsort_output_close(
+    csv_extsort * sorter, csv_extsort_output * out, GTEXT_CSV_Status status) {
+  if (status == GTEXT_CSV_OK && out->writer) {
+    status = gtext_csv_writer_finish(out->writer);
+  }
+  gtext_csv_writer_free(out->writer);
+  out->writer = NULL;
+  if (out->file) {
+    if (fclose(out->file) != 0 && status == GTEXT_CSV_OK) {
+      status = GTEXT_CSV_E_WRITE;
+    }
+    out->file = NULL;
+  }
+  if (status == GTEXT_CSV_E_WRITE) {
+    CSV_SET_ERROR(sorter->err, GTEXT_CSV_E_WRITE, "Failed to write CSV file");
+  }
+  return status;
+}
+
+// Create an empty run file in the temporary directory
+static GTEXT_CSV_Status csv_extsort_temp_file(
+    csv_extsort * sorter, char ** path_out, FILE ** file_out) {
+  const char * name = "gtext-csv-run-XXXXXX";
+  size_t size = strlen(sorter->temp_dir) + 1 + strlen(name) + 1;
+  char * path = (char *)malloc(size);
+  if (!path) {
+    CSV_SET_ERROR(sorter->err, GTEXT_CSV_E_OOM, "Out of memory while sorting");
+    return GTEXT_CSV_E_OOM;
+  }
+  snprintf(path, size, "%s/%s", sorter->temp_dir, name);
+
+  FILE * file = NULL;
+#ifdef _MSC_VER
+  if (_mktemp_s(path, size) == 0) {
+    int fd = _open(path, _O_CREAT | _O_EXCL | _O_BINARY | _O_WRONLY,
+        _S_IREAD | _S_IWRITE);
+    if (fd >= 0) {
+      file = _fdopen(fd, "wb");
+      if (!file) {
+        _close(fd);
+        remove(path);
+      }
+    }
+  }
+#else
+  int fd = mkstemp(path);
+  if (fd >= 0) {
+    file = fdopen(fd, "wb");
+    if (!file) {
+      close(fd);
+      remove(path);
+    }
+  }
+#endif
+
+  if (!file) {
+    free(path);
+    CSV_SET_ERROR(
+        sorter->err, GTEXT_CSV_E_WRITE, "Failed to create temporary run file");
+    return GTEXT_CSV_E_WRITE;
+  }
+  *path_out = path;
+  *file_out = file;
+  return GTEXT_CSV_OK;
+}
+
+// Delete run files and free their paths
+static void csv_extsort_remove_runs(char ** runs, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    if (runs[i]) {
+      remove(runs[i]);
+      free(runs[i]);
+      runs[i] = NULL;
+    }
+  }
+}
+
+// Make the scratch record arrays hold at least count fields
+static GTEXT_CSV_Status csv_extsort_reserve_fields(
+    csv_extsort * sorter, size_t count) {
+  if (count <= sorter->field_capacity) {
+    return GTEXT_CSV_OK;
+  }
+  size_t capacity = sorter->field_capacity ? sorter->field_capacity : 16;
+  while (capacity < count) {
+    capacity *= 2;
+  }
+  const char ** fields =
+      (const char **)realloc(sorter->fields, capacity * sizeof(char *));
+  if (fields) {
+    sorter->fields = fields;
+  }
+  size_t * lengths =
+      (size_t *)realloc(sorter->lengths, capacity * sizeof(size_t));
+  if (lengths) {
+    sorter->lengths = lengths;
+  }
+  if (!fields || !lengths) {
+    CSV_SET_ERROR(sorter->err, GTEXT_CSV_E_OOM, "Out of memory while sorting");
+    return GTEXT_CSV_E_OOM;
+  }
+  sorter->field_capacity = capacity;
+  return GTEXT_CSV_OK;
+}
+
+// Pick out a record's key cells and the values of its numeric keys
+static GTEXT_CSV_Status csv_extsort_keys(csv_extsort * sorter,
+    const GTEXT_CSV_Field_Span * fields, size_t field_count,
+    GTEXT_CSV_Field_Span * keys, double * numbers) {
+  for (size_t k = 0; k < sorter->opts->key_count; k++) {
+    const GTEXT_CSV_Sort_Key * key = &sorter->opts->keys[k];
+    if (key->column < field_count) {
+      keys[k] = fields[key->column];
+    }
+    else {
+      keys[k].data = "";
+      keys[k].length = 0;
+    }
+    if (key->compare == GTEXT_CSV_COMPARE_NUMERIC &&
+        csv_sort_number(keys[k].data, keys[k].length, &numbers[k]) !=
+            GTEXT_CSV_OK) {
+      CSV_SET_ERROR(
+          sorter->err, GTEXT_CSV_E_OOM, "Out of memory while sorting");
+      return GTEXT_CSV_E_OOM;
+    }
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Compare two records' key cells on every key
+static int csv_extsort_compare(const csv_extsort * sorter,
+    const GTEXT_CSV_Field_Span * a_keys, const double * a_numbers,
+    const GTEXT_CSV_Field_Span * b_keys, const double * b_numbers) {
+  for (size_t k = 0; k < sorter->opts->key_count; k++) {
+    int c = csv_sort_compare_cells(&sorter->opts->keys[k], a_keys[k].data,
+        a_keys[k].length, a_numbers[k], b_keys[k].data, b_keys[k].length,
+        b_numbers[k]);
+    if (c != 0) {
+      return c;
+    }
+  }
+  return 0;
+}
+
+// Keep a copy of the key of the record just written
+static GTEXT_CSV_Status csv_extsort_remember(csv_extsort * sorter,
+    const GTEXT_CSV_Field_Span * keys, const double * numbers) {
+  size_t key_count = sorter->opts->key_count;
+  size_t total = 0;
+  for (size_t k = 0; k < key_count; k++) {
+    total += keys[k].length;
+  }
+  if (total > sorter->last_capacity) {
+    char * data = (char *)realloc(sorter->last_data, total);
+    if (!data) {
+      CSV_SET_ERROR(
+          sorter->err, GTEXT_CSV_E_OOM, "Out of memory while sorting");
+      return GTEXT_CSV_E_OOM;
+    }
+    sorter->last_data = data;
+    sorter->last_capacity = total;
+  }
+
+  size_t offset = 0;
+  for (size_t k = 0; k < key_count; k++) {
+    if (keys[k].length > 0) {
+      memcpy(sorter->last_data + offset, keys[k].data, keys[k].length);
+    }
+    sorter->last_keys[k].data =
+        sorter->last_data ? sorter->last_data + offset : "";
+    sorter->last_keys[k].length = keys[k].length;
+    sorter->last_numbers[k] = numbers[k];
+    offset += keys[k].length;
+  }
+  sorter->has_last = true;
+  return GTEXT_CSV_OK;
+}
+
+// Write one record
+static GTEXT_CSV_Status csv_extsort_write_record(csv_extsort_output * out,
+    const GTEXT_CSV_Field_Span * fields, size_t field_count) {
+  GTEXT_CSV_Status status = gtext_csv_writer_record_begin(out->writer);
+  for (size_t i = 0; status == GTEXT_CSV_OK && i < field_count; i++) {
+    status =
+        gtext_csv_writer_field(out->writer, fields[i].data, fields[i].length);
+  }
+  if (status == GTEXT_CSV_OK) {
+    status = gtext_csv_writer_record_end(out->writer);
+  }
+  if (status == GTEXT_CSV_OK && out->rows_written) {
+    (*out->rows_written)++;
+  }
+  return status;
+}
+
+// Write a record in sorted order, unless it repeats the last key of a unique
+// sort
+static GTEXT_CSV_Status csv_extsort_emit(csv_extsort * sorter,
+    csv_extsort_output * out, const GTEXT_CSV_Field_Span * fields,
+    size_t field_count, const GTEXT_CSV_Field_Span * keys,
+    const double * numbers) {
+  if (sorter->opts->unique) {
+    if (sorter->has_last &&
+        csv_extsort_compare(sorter, keys, numbers, sorter->last_keys,
+            sorter->last_numbers) == 0) {
+      return GTEXT_CSV_OK;
+    }
+    GTEXT_CSV_Status status = csv_extsort_remember(sorter, keys, numbers);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+  }
+  return csv_extsort_write_record(out, fields, field_count);
+}
+
+// Sort the buffered records and write them to an output
+static GTEXT_CSV_Status csv_extsort_write_table(
+    csv_extsort * sorter, GTEXT_CSV_Table * table, csv_extsort_output * out) {
+  GTEXT_CSV_Status status = gtext_csv_table_sort(table, sorter->opts->keys,
+      sorter->opts->key_count, sorter->opts->sort_threads);
+  if (status != GTEXT_CSV_OK) {
+    CSV_SET_ERROR(sorter->err, status, "Failed to sort run");
+    return status;
+  }
+
+  GTEXT_CSV_Field_Span * spans = NULL;
+  size_t span_capacity = 0;
+  sorter->has_last = false;
+  size_t row_count = gtext_csv_row_count(table);
+  for (size_t row = 0; status == GTEXT_CSV_OK && row < row_count; row++) {
+    size_t field_count = gtext_csv_col_count(table, row);
+    if (field_count > span_capacity) {
+      GTEXT_CSV_Field_Span * grown = (GTEXT_CSV_Field_Span *)realloc(
+          spans, field_count * sizeof(GTEXT_CSV_Field_Span));
+      if (!grown) {
+        CSV_SET_ERROR(
+            sorter->err, GTEXT_CSV_E_OOM, "Out of memory while sorting");
+        status = GTEXT_CSV_E_OOM;
+        break;
+      }
+      spans = grown;
+      span_capacity = field_count;
+    }
+    for (size_t col = 0; col < field_count; col++) {
+      spans[col].data = gtext_csv_field(table, row, col, &spans[col].length);
+    }
+    status = csv_extsort_keys(
+        sorter, spans, field_count, sorter->keys, sorter->numbers);
+    if (status == GTEXT_CSV_OK) {
+      status = csv_extsort_emit(sorter, out, spans, field_count, sorter->keys,
+          sorter->numbers);
+    }
+  }
+  free(spans);
+  return status;
+}
+
+// Sort the buffered records into a new run file
+static GTEXT_CSV_Status csv_extsort_spill(
+    csv_extsort * sorter, GTEXT_CSV_Table * table, size_t * run_capacity) {
+  if (sorter->run_count == *run_capacity) {
+    size_t capacity = *run_capacity ? *run_capacity * 2 : 16;
+    char ** runs = (char **)realloc(sorter->runs, capacity * sizeof(char *));
+    if (!runs) {
+      CSV_SET_ERROR(
+          sorter->err, GTEXT_CSV_E_OOM, "Out of memory while sorting");
+      return GTEXT_CSV_E_OOM;
+    }
+    sorter->runs = runs;
+    *run_capacity = capacity;
+  }
+
+  FILE * file;
+  char * path;
+  GTEXT_CSV_Status status = csv_extsort_temp_file(sorter, &path, &file);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+  sorter->runs[sorter->run_count++] = path;
+
+  csv_extsort_output out = {0};
+  status = csv_extsort_output_open(sorter, &out, file, &sorter->run_write);
+  if (status == GTEXT_CSV_OK) {
+    status = csv_extsort_write_table(sorter, table, &out);
+  }
+  status = csv_extsort_output_close(sorter, &out, status);
+  if (status == GTEXT_CSV_OK) {
+    sorter->progress.runs_written++;
+    csv_extsort_report(sorter);
+  }
+  return status;
+}
+
+// Move a cursor to the next record of its run; *done is set at the end
+static GTEXT_CSV_Status csv_extsort_cursor_next(
+    csv_extsort * sorter, csv_extsort_cursor * cursor, bool * done) {
+  if (cursor->next == gtext_csv_batch_row_count(cursor->batch)) {
+    GTEXT_CSV_Status status = gtext_csv_reader_next_batch(
+        cursor->reader, cursor->batch, CSV_EXTSORT_RUN_BATCH_ROWS, sorter->err);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+    cursor->next = 0;
+    if (gtext_csv_batch_row_count(cursor->batch) == 0) {
+      *done = true;
+      return GTEXT_CSV_OK;
+    }
+  }
+  cursor->fields =
+      gtext_csv_batch_row(cursor->batch, cursor->next++, &cursor->field_count);
+  *done = false;
+  return csv_extsort_keys(sorter, cursor->fields, cursor->field_count,
+      cursor->keys, cursor->numbers);
+}
+
+// Open a run file for merging
+static GTEXT_CSV_Status csv_extsort_cursor_open(csv_extsort * sorter,
+    csv_extsort_cursor * cursor, const char * path, size_t order) {
+  size_t key_count = sorter->opts->key_count;
+  cursor->order = order;
+  cursor->source.file = fopen(path, "rb");
+  if (!cursor->source.file) {
+    CSV_SET_ERROR(
+        sorter->err, GTEXT_CSV_E_INVALID, "Failed to open temporary run file");
+    return GTEXT_CSV_E_INVALID;
+  }
+  cursor->reader = gtext_csv_reader_new_source(
+      &sorter->run_parse, csv_extsort_read, &cursor->source);
+  cursor->batch = gtext_csv_batch_new();
+  cursor->keys =
+      (GTEXT_CSV_Field_Span *)malloc(key_count * sizeof(GTEXT_CSV_Field_Span));
+  cursor->numbers = (double *)malloc(key_count * sizeof(double));
+  if (!cursor->reader || !cursor->batch || !cursor->keys || !cursor->numbers) {
+    CSV_SET_ERROR(sorter->err, GTEXT_CSV_E_OOM, "Out of memory while merging");
+    return GTEXT_CSV_E_OOM;
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Close a run opened for merging
+static void csv_extsort_cursor_close(csv_extsort_cursor * cursor) {
+  gtext_csv_reader_free(cursor->reader);
+  gtext_csv_batch_free(cursor->batch);
+  free(cursor->keys);
+  free(cursor->numbers);
+  if (cursor->source.file) {
+    fclose(cursor->source.file);
+  }
+}
+
+// Whether cursor a's record comes out of the merge before cursor b's
+static bool csv_extsort_cursor_before(const csv_extsort * sorter,
+    const csv_extsort_cursor * a, const csv_extsort_cursor * b) {
+  int c = csv_extsort_compare(sorter, a->keys, a->numbers, b->keys, b->numbers);
+  return c < 0 || (c == 0 && a->order < b->order);
+}
+
+// Restore the heap order below position i
+static void csv_extsort_sift_down(const csv_extsort * sorter,
+    csv_extsort_cursor ** heap, size_t size, size_t i) {
+  for (;;) {
+    size_t first = i;
+    size_t left = 2 * i + 1;
+    size_t right = left + 1;
+    if (left < size &&
+        csv_extsort_cursor_before(sorter, heap[left], heap[first])) {
+      first = left;
+    }
+    if (right < size &&
+        csv_extsort_cursor_before(sorter, heap[right], heap[first])) {
+      first = right;
+    }
+    if (first == i) {
+      return;
+    }
+    csv_extsort_cursor * swap = heap[i];
+    heap[i] = heap[first];
+    heap[first] = swap;
+    i = first;
+  }
+}
+
+// Merge count consecutive runs into an output
+static GTEXT_CSV_Status csv_extsort_merge(csv_extsort * sorter,
+    char * const * runs, size_t count, csv_extsort_output * out) {
+  csv_extsort_cursor * cursors =
+      (csv_extsort_cursor *)calloc(count, sizeof(csv_extsort_cursor));
+  csv_extsort_cursor ** heap =
+      (csv_extsort_cursor **)malloc(count * sizeof(csv_extsort_cursor *));
+  if (!cursors || !heap) {
+    free(cursors);
+    free(heap);
+    CSV_SET_ERROR(sorter->err, GTEXT_CSV_E_OOM, "Out of memory while merging");
+    return GTEXT_CSV_E_OOM;
+  }
+
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  size_t size = 0;
+  size_t opened = 0;
+  sorter->has_last = false;
+  for (; status == GTEXT_CSV_OK && opened < count; opened++) {
+    status = csv_extsort_cursor_open(
+        sorter, &cursors[opened], runs[opened], opened);
+    bool done = true;
+    if (status == GTEXT_CSV_OK) {
+      status = csv_extsort_cursor_next(sorter, &cursors[opened], &done);
+    }
+    if (status == GTEXT_CSV_OK && !done) {
+      heap[size++] = &cursors[opened];
+    }
+  }
+  for (size_t i = size / 2; status == GTEXT_CSV_OK && i-- > 0;) {
+    csv_extsort_sift_down(sorter, heap, size, i);
+  }
+
+  size_t merged_rows = 0;
+  while (status == GTEXT_CSV_OK && size > 0) {
+    csv_extsort_cursor * top = heap[0];
+    status = csv_extsort_emit(sorter, out, top->fields, top->field_count,
+        top->keys, top->numbers);
+    if (++merged_rows % CSV_EXTSORT_PROGRESS_ROWS == 0) {
+      csv_extsort_report(sorter);
+    }
+
+    bool done = false;
+    if (status == GTEXT_CSV_OK) {
+      status = csv_extsort_cursor_next(sorter, top, &done);
+    }
+    if (status != GTEXT_CSV_OK) {
+      break;
+    }
+    if (done) {
+      heap[0] = heap[--size];
+    }
+    csv_extsort_sift_down(sorter, heap, size, 0);
+  }
+
+  for (size_t i = 0; i < opened; i++) {
+    csv_extsort_cursor_close(&cursors[i]);
+  }
+  free(cursors);
+  free(heap);
+  return status;
+}
+
+// Merge runs in groups until one merge can take them all
+static GTEXT_CSV_Status csv_extsort_merge_passes(csv_extsort * sorter) {
+  while (sorter->run_count > CSV_EXTSORT_MAX_FAN_IN) {
+    sorter->progress.phase = GTEXT_CSV_EXTSORT_MERGE;
+    size_t groups = (sorter->run_count + CSV_EXTSORT_MAX_FAN_IN - 1) /
+        CSV_EXTSORT_MAX_FAN_IN;
+    sorter->merged = (char **)calloc(groups, sizeof(char *));
+    if (!sorter->merged) {
+      CSV_SET_ERROR(
+          sorter->err, GTEXT_CSV_E_OOM, "Out of memory while merging");
+      return GTEXT_CSV_E_OOM;
+    }
+    sorter->merged_count = 0;
+
+    for (size_t first = 0; first < sorter->run_count;
+        first += CSV_EXTSORT_MAX_FAN_IN) {
+      size_t count = sorter->run_count - first;
+      if (count > CSV_EXTSORT_MAX_FAN_IN) {
+        count = CSV_EXTSORT_MAX_FAN_IN;
+      }
+      if (count == 1) {
+        sorter->merged[sorter->merged_count++] = sorter->runs[first];
+        sorter->runs[first] = NULL;
+        continue;
+      }
+
+      FILE * file;
+      char * path;
+      GTEXT_CSV_Status status = csv_extsort_temp_file(sorter, &path, &file);
+      if (status != GTEXT_CSV_OK) {
+        return status;
+      }
+      sorter->merged[sorter->merged_count++] = path;
+      csv_extsort_output out = {0};
+      status = csv_extsort_output_open(sorter, &out, file, &sorter->run_write);
+      if (status == GTEXT_CSV_OK) {
+        status = csv_extsort_merge(
+            sorter, sorter->runs + first, count, &out);
+      }
+      status = csv_extsort_output_close(sorter, &out, status);
+      if (status != GTEXT_CSV_OK) {
+        return status;
+      }
+      csv_extsort_remove_runs(sorter->runs + first, count);
+      sorter->progress.runs_written++;
+      csv_extsort_report(sorter);
+    }
+
+    free(sorter->runs);
+    sorter->runs = sorter->merged;
+    sorter->run_count = sorter->merged_count;
+    sorter->merged = NULL;
+    sorter->merged_count = 0;
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Read the whole input, sorting what fits in memory into runs, and write the
+// header and, when no run was needed, the sorted records to the output
+static GTEXT_CSV_Status csv_extsort_read_input(csv_extsort * sorter,
+    GTEXT_CSV_Reader * reader, bool header, csv_extsort_output * out) {
+  size_t budget = sorter->opts->memory_limit_bytes
+      ? sorter->opts->memory_limit_bytes
+      : CSV_EXTSORT_DEFAULT_MEMORY;
+  GTEXT_CSV_Batch * batch = gtext_csv_batch_new();
+  if (!batch) {
+    CSV_SET_ERROR(sorter->err, GTEXT_CSV_E_OOM, "Out of memory while sorting");
+    return GTEXT_CSV_E_OOM;
+  }
+
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  GTEXT_CSV_Table * table = NULL;
+  size_t buffered = 0;
+  size_t run_capacity = 0;
+  for (;;) {
+    status = gtext_csv_reader_next_batch(
+        reader, batch, CSV_EXTSORT_INPUT_BATCH_ROWS, sorter->err);
+    size_t rows = gtext_csv_batch_row_count(batch);
+    if (status != GTEXT_CSV_OK || rows == 0) {
+      break;
+    }
+
+    for (size_t r = 0; status == GTEXT_CSV_OK && r < rows; r++) {
+      size_t field_count;
+      const GTEXT_CSV_Field_Span * fields =
+          gtext_csv_batch_row(batch, r, &field_count);
+      sorter->progress.rows_read++;
+      if (header) {
+        header = false;
+        status = csv_extsort_write_record(out, fields, field_count);
+        continue;
+      }
+
+      if (!table) {
+        table = gtext_csv_new_table();
+        if (!table) {
+          CSV_SET_ERROR(
+              sorter->err, GTEXT_CSV_E_OOM, "Out of memory while sorting");
+          status = GTEXT_CSV_E_OOM;
+          break;
+        }
+        gtext_csv_set_allow_irregular_rows(table, true);
+      }
+      status = csv_extsort_reserve_fields(sorter, field_count + 1);
+      if (status != GTEXT_CSV_OK) {
+        break;
+      }
+      size_t cost = CSV_EXTSORT_ROW_OVERHEAD;
+      for (size_t i = 0; i < field_count; i++) {
+        sorter->fields[i] = fields[i].data;
+        sorter->lengths[i] = fields[i].length;
+        cost += fields[i].length + 8 + sizeof(csv_table_field);
+      }
+      if (field_count == 0) {
+        // Tables have no empty rows; an empty field writes the same line
+        sorter->fields[0] = "";
+        sorter->lengths[0] = 0;
+        field_count = 1;
+      }
+      status = gtext_csv_row_append(
+          table, sorter->fields, sorter->lengths, field_count, sorter->err);
+      buffered += cost;
+
+      if (status == GTEXT_CSV_OK && buffered >= budget) {
+        status = csv_extsort_spill(sorter, table, &run_capacity);
+        gtext_csv_free_table(table);
+        table = NULL;
+        buffered = 0;
+      }
+    }
+    if (status != GTEXT_CSV_OK) {
+      break;
+    }
+  }
+
+  if (status == GTEXT_CSV_OK && table) {
+    if (sorter->run_count == 0) {
+      // Everything fit in memory
+      sorter->progress.phase = GTEXT_CSV_EXTSORT_OUTPUT;
+      status = csv_extsort_write_table(sorter, table, out);
+    }
+    else {
+      status = csv_extsort_spill(sorter, table, &run_capacity);
+    }
+  }
+  gtext_csv_free_table(table);
+  gtext_csv_batch_free(batch);
+  return status;
+}
+
+GTEXT_API GTEXT_CSV_Extsort_Options gtext_csv_extsort_options_default(void) {
+  GTEXT_CSV_Extsort_Options opts = {0};
+  return opts;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_extsort(const char * input_path,
+    const char * output_path, const GTEXT_CSV_Extsort_Options * sort_opts,
+    const GTEXT_CSV_Parse_Options * parse_opts,
+    const GTEXT_CSV_Write_Options * write_opts, GTEXT_CSV_Error * err) {
+  if (!input_path || !output_path || !sort_opts || !sort_opts->keys ||
+      sort_opts->key_count == 0) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID,
+        "Paths and sort keys must not be NULL and key_count must be > 0");
+    return GTEXT_CSV_E_INVALID;
+  }
+  for (size_t k = 0; k < sort_opts->key_count; k++) {
+    GTEXT_CSV_Compare compare = sort_opts->keys[k].compare;
+    if (compare != GTEXT_CSV_COMPARE_LEXICOGRAPHIC &&
+        compare != GTEXT_CSV_COMPARE_NUMERIC &&
+        compare != GTEXT_CSV_COMPARE_NATURAL) {
+      CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Unknown sort comparator");
+      return GTEXT_CSV_E_INVALID;
+    }
+  }
+
+  csv_extsort sorter = {.opts = sort_opts, .err = err};
+  sorter.progress.phase = GTEXT_CSV_EXTSORT_RUNS;
+  sorter.temp_dir = sort_opts->temp_dir;
+  if (!sorter.temp_dir) {
+#ifdef _MSC_VER
+    sorter.temp_dir = getenv("TEMP");
+#else
+    sorter.temp_dir = getenv("TMPDIR");
+#endif
+  }
+  if (!sorter.temp_dir || !*sorter.temp_dir) {
+#ifdef _MSC_VER
+    sorter.temp_dir = ".";
+#else
+    sorter.temp_dir = "/tmp";
+#endif
+  }
+
+  // Limits meant to protect whole-input parses do not apply
+  GTEXT_CSV_Parse_Options input_opts =
+      parse_opts ? *parse_opts : gtext_csv_parse_options_default();
+  if (input_opts.max_total_bytes == 0) {
+    input_opts.max_total_bytes = SIZE_MAX;
+  }
+  if (input_opts.max_rows == 0) {
+    input_opts.max_rows = SIZE_MAX;
+  }
+  bool header = input_opts.dialect.treat_first_row_as_header;
+
+  // Run files were validated on the way in and hold every field quoted
+  sorter.run_parse = gtext_csv_parse_options_default();
+  sorter.run_parse.validate_utf8 = false;
+  sorter.run_parse.max_total_bytes = SIZE_MAX;
+  sorter.run_parse.max_rows = SIZE_MAX;
+  sorter.run_parse.max_cols = input_opts.max_cols;
+  sorter.run_parse.max_field_bytes = input_opts.max_field_bytes;
+  sorter.run_parse.max_record_bytes = input_opts.max_record_bytes;
+  sorter.run_write = gtext_csv_write_options_default();
+  sorter.run_write.quote_all_fields = true;
+
+  GTEXT_CSV_Write_Options output_opts =
+      write_opts ? *write_opts : gtext_csv_write_options_default();
+
+  size_t key_count = sort_opts->key_count;
+  sorter.keys =
+      (GTEXT_CSV_Field_Span *)malloc(key_count * sizeof(GTEXT_CSV_Field_Span));
+  sorter.numbers = (double *)malloc(key_count * sizeof(double));
+  sorter.last_keys =
+      (GTEXT_CSV_Field_Span *)malloc(key_count * sizeof(GTEXT_CSV_Field_Span));
+  sorter.last_numbers = (double *)malloc(key_count * sizeof(double));
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  if (!sorter.keys || !sorter.numbers || !sorter.last_keys ||
+      !sorter.last_numbers) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Out of memory while sorting");
+    status = GTEXT_CSV_E_OOM;
+  }
+
+  csv_extsort_source input = {.bytes_read = &sorter.progress.bytes_read};
+  if (status == GTEXT_CSV_OK) {
+    csv_extsort_stat_t st;
+    input.file = fopen(input_path, "rb");
+    if (!input.file || csv_extsort_stat(input_path, &st) != 0) {
+      CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to open CSV file");
+      status = GTEXT_CSV_E_INVALID;
+    }
+    else {
+      sorter.progress.bytes_total = (uint64_t)st.st_size;
+    }
+  }
+
+  csv_extsort_output out = {0};
+  if (status == GTEXT_CSV_OK) {
+    FILE * file = fopen(output_path, "wb");
+    if (!file) {
+      CSV_SET_ERROR(err, GTEXT_CSV_E_WRITE, "Failed to create output file");
+      status = GTEXT_CSV_E_WRITE;
+    }
+    else {
+      status = csv_extsort_output_open(&sorter, &out, file, &output_opts);
+      out.rows_written = &sorter.progress.rows_written;
+    }
+  }
+
+  GTEXT_CSV_Reader * reader = NULL;
+  if (status == GTEXT_CSV_OK) {
+    reader =
+        gtext_csv_reader_new_source(&input_opts, csv_extsort_read, &input);
+    if (!reader) {
+      CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to create CSV reader");
+      status = GTEXT_CSV_E_OOM;
+    }
+  }
+  if (status == GTEXT_CSV_OK) {
+    status = csv_extsort_read_input(&sorter, reader, header, &out);
+  }
+  gtext_csv_reader_free(reader);
+  if (input.file) {
+    fclose(input.file);
+  }
+
+  if (status == GTEXT_CSV_OK && sorter.run_count > 0) {
+    status = csv_extsort_merge_passes(&sorter);
+    if (status == GTEXT_CSV_OK) {
+      sorter.progress.phase = GTEXT_CSV_EXTSORT_OUTPUT;
+      status =
+          csv_extsort_merge(&sorter, sorter.runs, sorter.run_count, &out);
+    }
+  }
+  status = csv_extsort_output_close(&sorter, &out, status);
+  if (status == GTEXT_CSV_OK) {
+    csv_extsort_report(&sorter);
+  }
+
+  csv_extsort_remove_runs(sorter.runs, sorter.run_count);
+  csv_extsort_remove_runs(sorter.merged, sorter.merged_count);
+  free(sorter.runs);
+  free(sorter.merged);
+  free(sorter.fields);
+  free(sorter.lengths);
+  free(sorter.keys);
+  free(sorter.numbers);
+  free(sorter.last_keys);
+  free(sorter.last_numbers);
+  free(sorter.last_data);
+  return status;
+}
@@ -0,0 +1,524 @@
+/**
+ * @file
+ *
+ * Sparse row-offset index implementation.
+ *
+ * The builder runs the streaming parser over the file and notes where every
+ * Kth record begins. Seeking maps the file, starts a batch reader at the
+ * nearest noted offset and skips forward to the requested row.
+ *
+ * Index file layout (all integers unsigned 64-bit little-endian):
+ * magic, source size, source modification time (seconds, then nanoseconds),
+ * stride, record count, entry count, then one offset per entry.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#ifndef _MSC_VER
+#define _XOPEN_SOURCE 700
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "csv_internal.h"
+
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_index.h>
+#include <ghoti.io/text/csv/csv_stream.h>
+
+/**
+ * @brief Identifies (and versions) an index file
+ */
+static const unsigned char csv_index_magic[8] = {
+    'G', 'T', 'C', 'S', 'V', 'I', 'X', '2'};
+
+/**
+ * @brief Number of 64-bit header fields following the magic
+ */
+#define CSV_INDEX_HEADER_FIELDS 6
+
+/**
+ * @brief Bytes read from the CSV file at a time while building
+ */
+#define CSV_INDEX_READ_BYTES 65536
+
+struct GTEXT_CSV_Index {
+  GTEXT_CSV_Parse_Options opts; ///< Options seeks parse with
+  const char * data;            ///< Mapped file contents
+  size_t size;                  ///< File size in bytes
+  size_t stride;                ///< Records between entries
+  size_t row_count;             ///< Records in the file
+  uint64_t * offsets;           ///< Offset of record i * stride
+  size_t offset_count;
+#ifdef _MSC_VER
+  void * view; ///< Mapped view (NULL for an empty file)
+#else
+  void * map; ///< Mapping (NULL for an empty file)
+#endif
+};
+
+/**
+ * @brief Builder state shared with the stream callback
+ */
+typedef struct {
+  GTEXT_CSV_Stream * stream;
+  size_t stride;
+  size_t row_count;
+  uint64_t * offsets;
+  size_t offset_count;
+  size_t offset_capacity;
+} csv_index_builder;
+
+#ifdef _MSC_VER
+typedef struct __stat64 csv_index_stat_t;
+#define csv_index_stat _stat64
+#else
+typedef struct stat csv_index_stat_t;
+#define csv_index_stat stat
+#endif
+
+/**
+ * @brief A file's size and modification time, as stored in the index
+ */
+typedef struct {
+  uint64_t size;       ///< Size in bytes
+  uint64_t mtime;      ///< Modification time, whole seconds
+  uint64_t mtime_nsec; ///< Nanoseconds within the second (0 where the
+                       ///< platform only has whole seconds)
+} csv_index_identity;
+
+// Encode a value as 8 little-endian bytes
+static void csv_index_put_u64(unsigned char * out, uint64_t value) {
+  for (size_t i = 0; i < 8; i++) {
+    out[i] = (unsigned char)(value >> (8 * i));
+  }
+}
+
+// Decode 8 little-endian bytes
+static uint64_t csv_index_get_u64(const unsigned char * in) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < 8; i++) {
+    value |= (uint64_t)in[i] << (8 * i);
+  }
+  return value;
+}
+
+// Size and modification time of a file, as stored in the index
+static bool csv_index_file_identity(
+    const char * path, csv_index_identity * identity) {
+  csv_index_stat_t st;
+  if (csv_index_stat(path, &st) != 0) {
+    return false;
+  }
+  identity->size = (uint64_t)st.st_size;
+  identity->mtime = (uint64_t)(int64_t)st.st_mtime;
+#if defined(_MSC_VER)
+  identity->mtime_nsec = 0;
+#elif defined(__APPLE__)
+  identity->mtime_nsec = (uint64_t)st.st_mtimespec.tv_nsec;
+#else
+  identity->mtime_nsec = (uint64_t)st.st_mtim.tv_nsec;
+#endif
+  return true;
+}
+
+// Parse options for scanning from a record offset: limits meant to protect
+// whole-input parses do not apply, and a BOM can only begin the file
+static GTEXT_CSV_Parse_Options csv_index_scan_options(
+    const GTEXT_CSV_Parse_Options * opts, bool at_start) {
+  GTEXT_CSV_Parse_Options scan =
+      opts ? *opts : gtext_csv_parse_options_default();
+  if (scan.max_total_bytes == 0) {
+    scan.max_total_bytes = SIZE_MAX;
+  }
+  if (scan.max_rows == 0) {
+    scan.max_rows = SIZE_MAX;
+  }
+  if (!at_start) {
+    scan.keep_bom = true;
+  }
+  return scan;
+}
+
+// Stream callback: note the offset of every stride-th record
+static GTEXT_CSV_Status csv_index_event_callback(
+    const GTEXT_CSV_Event * event, void * user_data) {
+  csv_index_builder * builder = (csv_index_builder *)user_data;
+  if (event->type != GTEXT_CSV_EVENT_RECORD_BEGIN) {
+    return GTEXT_CSV_OK;
+  }
+
+  if (builder->row_count % builder->stride == 0) {
+    if (builder->offset_count == builder->offset_capacity) {
+      size_t capacity =
+          builder->offset_capacity ? builder->offset_capacity * 2 : 64;
+      if (capacity > SIZE_MAX / sizeof(uint64_t)) {
+        return GTEXT_CSV_E_OOM;
+      }
+      uint64_t * grown = (uint64_t *)realloc(
+          builder->offsets, capacity * sizeof(uint64_t));
+      if (!grown) {
+        return GTEXT_CSV_E_OOM;
+      }
+      builder->offsets = grown;
+      builder->offset_capacity = capacity;
+    }
+    builder->offsets[builder->offset_count++] =
+        (uint64_t)csv_stream_input_offset(builder->stream);
+  }
+  builder->row_count++;
+  return GTEXT_CSV_OK;
+}
+
+// Feed a whole file through the builder's stream, checking it is still the
+// size it was when indexing started
+static GTEXT_CSV_Status csv_index_scan_file(csv_index_builder * builder,
+    const char * csv_path, uint64_t expected_size, GTEXT_CSV_Error * err) {
+  FILE * file = fopen(csv_path, "rb");
+  if (!file) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to open CSV file");
+    return GTEXT_CSV_E_INVALID;
+  }
+  char * buffer = (char *)malloc(CSV_INDEX_READ_BYTES);
+  if (!buffer) {
+    fclose(file);
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Out of memory while building index");
+    return GTEXT_CSV_E_OOM;
+  }
+
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  uint64_t total = 0;
+  size_t got;
+  while ((got = fread(buffer, 1, CSV_INDEX_READ_BYTES, file)) > 0) {
+    total += got;
+    // Fields are never looked at, so let the stream skip copying them
+    csv_stream_set_emit_window(builder->stream, buffer, got);
+    status = gtext_csv_stream_feed(builder->stream, buffer, got, err);
+    if (status != GTEXT_CSV_OK) {
+      break;
+    }
+  }
+  if (status == GTEXT_CSV_OK && ferror(file)) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to read CSV file");
+    status = GTEXT_CSV_E_INVALID;
+  }
+  if (status == GTEXT_CSV_OK) {
+    csv_stream_set_emit_window(builder->stream, NULL, 0);
+    status = gtext_csv_stream_finish(builder->stream, err);
+  }
+  if (status == GTEXT_CSV_OK && total != expected_size) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_STATE, "CSV file changed while indexing");
+    status = GTEXT_CSV_E_STATE;
+  }
+
+  free(buffer);
+  fclose(file);
+  return status;
+}
+
+// Write the index file
+static GTEXT_CSV_Status csv_index_write(const char * index_path,
+    const csv_index_builder * builder, const csv_index_identity * identity,
+    GTEXT_CSV_Error * err) {
+  FILE * file = fopen(index_path, "wb");
+  if (!file) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_WRITE, "Failed to create index file");
+    return GTEXT_CSV_E_WRITE;
+  }
+
+  unsigned char header[sizeof(csv_index_magic) + CSV_INDEX_HEADER_FIELDS * 8];
+  memcpy(header, csv_index_magic, sizeof(csv_index_magic));
+  unsigned char * field = header + sizeof(csv_index_magic);
+  csv_index_put_u64(field, identity->size);
+  csv_index_put_u64(field + 8, identity->mtime);
+  csv_index_put_u64(field + 16, identity->mtime_nsec);
+  csv_index_put_u64(field + 24, builder->stride);
+  csv_index_put_u64(field + 32, builder->row_count);
+  csv_index_put_u64(field + 40, builder->offset_count);
+  bool ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+  unsigned char entry[8];
+  for (size_t i = 0; ok && i < builder->offset_count; i++) {
+    csv_index_put_u64(entry, builder->offsets[i]);
+    ok = fwrite(entry, 1, sizeof(entry), file) == sizeof(entry);
+  }
+
+  if (fclose(file) != 0) {
+    ok = false;
+  }
+  if (!ok) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_WRITE, "Failed to write index file");
+    return GTEXT_CSV_E_WRITE;
+  }
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_index_build(const char * csv_path,
+    const char * index_path, size_t stride,
+    const GTEXT_CSV_Parse_Options * opts, GTEXT_CSV_Error * err) {
+  if (!csv_path || !index_path || stride == 0) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID,
+        "Paths must not be NULL and stride must be > 0");
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  csv_index_identity identity;
+  if (!csv_index_file_identity(csv_path, &identity)) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to stat CSV file");
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  csv_index_builder builder = {0};
+  builder.stride = stride;
+  GTEXT_CSV_Parse_Options scan = csv_index_scan_options(opts, true);
+  builder.stream =
+      gtext_csv_stream_new(&scan, csv_index_event_callback, &builder);
+  if (!builder.stream) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to create stream parser");
+    return GTEXT_CSV_E_OOM;
+  }
+
+  GTEXT_CSV_Status status =
+      csv_index_scan_file(&builder, csv_path, identity.size, err);
+  if (status == GTEXT_CSV_OK) {
+    status = csv_index_write(index_path, &builder, &identity, err);
+  }
+
+  gtext_csv_stream_free(builder.stream);
+  free(builder.offsets);
+  return status;
+}
+
+// Read and check an index file
+static GTEXT_CSV_Status csv_index_load(GTEXT_CSV_Index * index,
+    const char * index_path, csv_index_identity * identity,
+    GTEXT_CSV_Error * err) {
+  FILE * file = fopen(index_path, "rb");
+  if (!file) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to open index file");
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  unsigned char header[sizeof(csv_index_magic) + CSV_INDEX_HEADER_FIELDS * 8];
+  if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+      memcmp(header, csv_index_magic, sizeof(csv_index_magic)) != 0) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Not a CSV index file");
+    status = GTEXT_CSV_E_INVALID;
+  }
+
+  if (status == GTEXT_CSV_OK) {
+    const unsigned char * field = header + sizeof(csv_index_magic);
+    identity->size = csv_index_get_u64(field);
+    identity->mtime = csv_index_get_u64(field + 8);
+    identity->mtime_nsec = csv_index_get_u64(field + 16);
+    uint64_t stride = csv_index_get_u64(field + 24);
+    uint64_t row_count = csv_index_get_u64(field + 32);
+    uint64_t entry_count = csv_index_get_u64(field + 40);
+    if (stride == 0 || stride > SIZE_MAX || row_count > SIZE_MAX ||
+        entry_count != (row_count + stride - 1) / stride ||
+        entry_count > SIZE_MAX / sizeof(uint64_t)) {
+      CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Corrupt CSV index file");
+      status = GTEXT_CSV_E_INVALID;
+    }
+    else {
+      index->stride = (size_t)stride;
+      index->row_count = (size_t)row_count;
+      index->offset_count = (size_t)entry_count;
+    }
+  }
+
+  if (status == GTEXT_CSV_OK && index->offset_count > 0) {
+    index->offsets =
+        (uint64_t *)malloc(index->offset_count * sizeof(uint64_t));
+    if (!index->offsets) {
+      CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Out of memory while loading index");
+      status = GTEXT_CSV_E_OOM;
+    }
+  }
+
+  unsigned char entry[8];
+  for (size_t i = 0; status == GTEXT_CSV_OK && i < index->offset_count; i++) {
+    if (fread(entry, 1, sizeof(entry), file) != sizeof(entry)) {
+      CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Truncated CSV index file");
+      status = GTEXT_CSV_E_INVALID;
+      break;
+    }
+    index->offsets[i] = csv_index_get_u64(entry);
+    if (index->offsets[i] >= identity->size ||
+        (i > 0 && index->offsets[i] <= index->offsets[i - 1])) {
+      CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Corrupt CSV index file");
+      status = GTEXT_CSV_E_INVALID;
+    }
+  }
+
+  fclose(file);
+  return status;
+}
+
+// Map the CSV file read-only
+static GTEXT_CSV_Status csv_index_map(
+    GTEXT_CSV_Index * index, const char * csv_path, GTEXT_CSV_Error * err) {
+  if (index->size == 0) {
+    index->data = "";
+    return GTEXT_CSV_OK;
+  }
+
+#ifdef _MSC_VER
+  HANDLE file = CreateFileA(csv_path, GENERIC_READ, FILE_SHARE_READ, NULL,
+      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to open CSV file");
+    return GTEXT_CSV_E_INVALID;
+  }
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+  if (!mapping) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to map CSV file");
+    return GTEXT_CSV_E_INVALID;
+  }
+  // The view keeps the mapping alive once both handles are closed
+  index->view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!index->view) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to map CSV file");
+    return GTEXT_CSV_E_INVALID;
+  }
+  index->data = (const char *)index->view;
+#else
+  int fd = open(csv_path, O_RDONLY);
+  if (fd < 0) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to open CSV file");
+    return GTEXT_CSV_E_INVALID;
+  }
+  void * map = mmap(NULL, index->size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to map CSV file");
+    return GTEXT_CSV_E_INVALID;
+  }
+  index->map = map;
+  index->data = (const char *)map;
+#endif
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_API GTEXT_CSV_Index * gtext_csv_index_open(const char * csv_path,
+    const char * index_path, const GTEXT_CSV_Parse_Options * opts,
+    GTEXT_CSV_Error * err) {
+  if (!csv_path || !index_path) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Paths must not be NULL");
+    return NULL;
+  }
+
+  GTEXT_CSV_Index * index =
+      (GTEXT_CSV_Index *)calloc(1, sizeof(GTEXT_CSV_Index));
+  if (!index) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Out of memory while opening index");
+    return NULL;
+  }
+  index->opts = opts ? *opts : gtext_csv_parse_options_default();
+
+  csv_index_identity indexed;
+  GTEXT_CSV_Status status = csv_index_load(index, index_path, &indexed, err);
+
+  csv_index_identity current;
+  if (status == GTEXT_CSV_OK &&
+      !csv_index_file_identity(csv_path, &current)) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Failed to stat CSV file");
+    status = GTEXT_CSV_E_INVALID;
+  }
+  if (status == GTEXT_CSV_OK &&
+      (current.size != indexed.size || current.mtime != indexed.mtime ||
+          current.mtime_nsec != indexed.mtime_nsec)) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_STATE,
+        "CSV file changed since the index was built");
+    status = GTEXT_CSV_E_STATE;
+  }
+  if (status == GTEXT_CSV_OK && current.size > SIZE_MAX) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_LIMIT, "CSV file too large to map");
+    status = GTEXT_CSV_E_LIMIT;
+  }
+  if (status == GTEXT_CSV_OK) {
+    index->size = (size_t)current.size;
+    status = csv_index_map(index, csv_path, err);
+  }
+
+  if (status != GTEXT_CSV_OK) {
+    gtext_csv_index_close(index);
+    return NULL;
+  }
+  return index;
+}
+
+GTEXT_API size_t gtext_csv_index_row_count(const GTEXT_CSV_Index * index) {
+  return index->row_count;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_seek_row(GTEXT_CSV_Index * index,
+    size_t row, size_t count, GTEXT_CSV_Batch * batch, GTEXT_CSV_Error * err) {
+  if (!index || !batch || count == 0) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID,
+        "Index and batch must not be NULL and count must be > 0");
+    return GTEXT_CSV_E_INVALID;
+  }
+  if (row >= index->row_count) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Row is past the last record");
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  size_t entry = row / index->stride;
+  size_t offset = (size_t)index->offsets[entry];
+  GTEXT_CSV_Parse_Options scan =
+      csv_index_scan_options(&index->opts, offset == 0);
+  GTEXT_CSV_Reader * reader = gtext_csv_reader_new(
+      &scan, index->data + offset, index->size - offset);
+  if (!reader) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to create batch reader");
+    return GTEXT_CSV_E_OOM;
+  }
+
+  // Skip to the row through the batch, which is refilled right after
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  size_t skip = row - entry * index->stride;
+  if (skip > 0) {
+    status = gtext_csv_reader_next_batch(reader, batch, skip, err);
+  }
+  if (status == GTEXT_CSV_OK) {
+    status = gtext_csv_reader_next_batch(reader, batch, count, err);
+  }
+
+  gtext_csv_reader_free(reader);
+  return status;
+}
+
+GTEXT_API void gtext_csv_index_close(GTEXT_CSV_Index * index) {
+  if (!index) {
+    return;
+  }
+#ifdef _MSC_VER
+  if (index->view) {
+    UnmapViewOfFile(index->view);
+  }
+#else
+  if (index->map) {
+    munmap(index->map, index->size);
+  }
+#endif
+  free(index->offsets);
+  free(index);
+}
@@ -148,6 +148,14 @@ struct csv_arena {
  */
 typedef struct csv_arena csv_arena;
 
+/**
+ * @brief Position in an arena that later allocations can be rolled back to
+ */
+typedef struct {
+  csv_arena_block * block; ///< Block that was current (NULL if none)
+  size_t used;             ///< Bytes used in that block
+} csv_arena_mark;
+
 /**
  * @brief Set error structure with common defaults
  *
@@ -262,6 +270,48 @@ GTEXT_INTERNAL_API void csv_stream_set_original_input_buffer(
     GTEXT_CSV_Stream * stream, const char * input_buffer,
     size_t input_buffer_len);
 
+/**
+ * @brief Let a stream report fields inside a caller buffer in place
+ *
+ * Internal function used by the batch reader. A field that needs no
+ * unescaping and lies entirely in the window is emitted as a pointer into it
+ * instead of a copy. Fields crossing a chunk boundary are still buffered, so
+ * the window may be moved or refilled between feeds.
+ *
+ * @param stream Stream parser (must not be NULL)
+ * @param window Buffer holding the chunks being fed (NULL to always copy)
+ * @param window_len Length of window
+ */
+GTEXT_INTERNAL_API void csv_stream_set_emit_window(
+    GTEXT_CSV_Stream * stream, const char * window, size_t window_len);
+
+/**
+ * @brief Get the input offset of the byte a stream is processing
+ *
+ * Internal function used by the row-offset index. Inside a RECORD_BEGIN
+ * callback this is the offset of the record's first byte, counted from the
+ * start of the input (including a stripped BOM).
+ *
+ * @param stream Stream parser (must not be NULL)
+ * @return Byte offset
+ */
+GTEXT_INTERNAL_API size_t csv_stream_input_offset(
+    const GTEXT_CSV_Stream * stream);
+
+/**
+ * @brief Select the columns a stream reports
+ *
+ * Replaces the projection taken from opts.select_columns. Indices at or past
+ * the column limit are ignored. Must be called between records.
+ *
+ * @param stream Stream parser (must not be NULL)
+ * @param indices Column indices to keep (NULL with count 0 keeps every column)
+ * @param count Number of entries in indices
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_OOM on allocation failure
+ */
+GTEXT_INTERNAL_API GTEXT_CSV_Status csv_stream_select_fields(
+    GTEXT_CSV_Stream * stream, const size_t * indices, size_t count);
+
 /**
  * @brief Generate a context snippet around an error position
  *
@@ -310,7 +360,6 @@ GTEXT_INTERNAL_API GTEXT_CSV_Status csv_error_copy(
  *
  * **Arena Allocation (csv_arena_alloc_for_context):**
  * - Used for all permanent table data structures
- * - Row structures (csv_table_row)
  * - Field arrays (csv_table_field *)
  * - Field data (string content)
  * - Header map entries
@@ -318,6 +367,8 @@ GTEXT_INTERNAL_API GTEXT_CSV_Status csv_error_copy(
  * - Freed in bulk when the table is destroyed
  *
  * **Malloc Allocation (malloc/free):**
+ * - Used for the row index (row blocks and their directory), which grows
+ *   block by block and is freed with the table
  * - Used for temporary organizational arrays during mutation operations
  * - Temporary pointer arrays (e.g., csv_column_op_temp_arrays)
  * - Arrays used to organize/prepare data before committing to the table
@@ -352,13 +403,100 @@ typedef struct {
 } csv_table_field;
 
 /**
- * @brief Row structure (stored in arena)
+ * @brief Row structure (stored in a row block)
  */
 typedef struct {
   csv_table_field * fields; ///< Array of fields
   size_t field_count;       ///< Number of fields
 } csv_table_row;
 
+/**
+ * @brief log2 of the number of rows in one row block
+ */
+#define CSV_ROW_BLOCK_SHIFT 8
+
+/**
+ * @brief Number of rows in one row block
+ *
+ * Rows are stored in fixed-size blocks reached through a block directory, so
+ * growing the table adds a block instead of copying every row into a larger
+ * array. While the blocks are packed, row i lives at slot
+ * (i % CSV_ROW_BLOCK_ROWS) of block (i / CSV_ROW_BLOCK_ROWS).
+ *
+ * Inserting or removing a row before the last one switches the table to
+ * indexed blocks: each block then holds up to CSV_ROW_BLOCK_ROWS rows, a
+ * full block splits in two, and a Fenwick tree over the per-block row counts
+ * finds a row's block in O(log blocks). A split or merge moves the directory
+ * and rebuilds the tree, which is O(blocks). Compaction packs the blocks
+ * again.
+ */
+#define CSV_ROW_BLOCK_ROWS ((size_t)1 << CSV_ROW_BLOCK_SHIFT)
+
+/**
+ * @brief One column of column-major storage
+ */
+typedef struct {
+  size_t * offsets; ///< Heap offset of each row's cell
+  size_t * lengths; ///< Length of each row's cell
+} csv_table_column;
+
+/**
+ * @brief Column-major cell storage (GTEXT_CSV_LAYOUT_COLUMNS)
+ *
+ * Replaces the row array while a table is column-major. Cell bytes live in
+ * one heap, each followed by a NUL byte; offset 0 holds a shared empty
+ * cell. The header row, when present, is row 0 like in the row layout.
+ * Slots past a row's width always hold the empty cell.
+ *
+ * The heap is allocated from the table's arena and never moves: growing it
+ * copies the cells to a larger arena allocation and leaves the old one in
+ * place, so cell pointers stay valid until the arena is compacted. The other
+ * arrays are allocated with malloc() and owned by the table.
+ */
+typedef struct {
+  char * heap;                ///< Cell bytes (in the table's arena)
+  size_t heap_len;            ///< Bytes used in heap
+  size_t heap_capacity;       ///< Allocated heap size
+  csv_table_column * columns; ///< Stored columns
+  size_t column_count;        ///< Number of stored columns (widest row)
+  size_t column_capacity;     ///< Allocated entries in columns
+  size_t * widths;            ///< Field count of each row
+  size_t row_capacity;        ///< Allocated entries per row-indexed array
+} csv_table_columns;
+
+/**
+ * @brief One distinct value of a hash-indexed column
+ */
+typedef struct csv_index_key {
+  const char * data;           ///< Value bytes (in the index arena)
+  size_t length;               ///< Value length
+  size_t hash;                 ///< Full hash of the value
+  size_t * rows;               ///< Data rows holding the value, ascending
+  size_t row_count;            ///< Number of entries in rows
+  size_t row_capacity;         ///< Allocated entries in rows
+  struct csv_index_key * next; ///< Next key in the same bucket
+} csv_index_key;
+
+/**
+ * @brief Hash index on one column of a table
+ *
+ * Built by gtext_csv_build_index() and owned by the table. Keys and row lists
+ * live in the index's own arena, so rebuilding or dropping an index never
+ * touches the table's arena; the bucket array is allocated with malloc().
+ * Appended, inserted, removed and replaced rows are patched in place. Other
+ * changes mark the index stale, which releases its storage until the next
+ * lookup rebuilds it.
+ */
+typedef struct csv_column_index {
+  size_t column;                  ///< Indexed column
+  bool stale;                     ///< Rows changed since the index was built
+  csv_context * ctx;              ///< Arena for keys and row lists
+  csv_index_key ** buckets;       ///< Hash buckets (power-of-two count)
+  size_t bucket_count;            ///< Number of buckets
+  size_t key_count;               ///< Number of distinct values
+  struct csv_column_index * next; ///< Next index of the same table
+} csv_column_index;
+
 /**
  * @brief Header map entry (for column name lookup)
  */
@@ -394,11 +532,33 @@ typedef struct {
  */
 typedef struct {
   csv_context * new_ctx;               ///< New context with arena
-  csv_table_row * new_rows;            ///< New rows array
+  csv_table_row * new_rows;            ///< Staged rows (malloc'd)
   csv_table_field ** new_field_arrays; ///< Array of field arrays
   char *** new_field_data_ptrs;        ///< Array of field data pointer arrays
 } csv_compact_structures;
 
+/**
+ * @brief State of an incremental compaction (gtext_csv_table_compact_step())
+ *
+ * The table's arena at the start of the compaction is retired into @p from
+ * and the table gets a fresh arena. Rows before @p next_row no longer point
+ * into @p from; the row slot functions and sorting keep it on the same row
+ * when rows move.
+ */
+typedef struct csv_table_compaction {
+  csv_arena * from;          ///< Retired arena, freed when the compaction ends
+  csv_arena_block ** blocks; ///< Blocks of @p from sorted by address
+  size_t block_count;        ///< Number of entries in @p blocks
+  size_t next_row;           ///< First row that may still point into @p from
+} csv_table_compaction;
+
+/**
+ * @brief Storage shared by copy-on-write clones (gtext_csv_clone_cow())
+ *
+ * Reference counted; defined in csv_table.c.
+ */
+typedef struct csv_table_share csv_table_share;
+
 /**
  * @brief Table structure (internal)
  *
@@ -407,10 +567,15 @@ typedef struct {
  * This structure definition must match the one in csv_table.c.
  */
 struct GTEXT_CSV_Table {
-  csv_context * ctx;    ///< Context with arena
-  csv_table_row * rows; ///< Array of rows
-  size_t row_count;     ///< Number of rows
-  size_t row_capacity;  ///< Allocated row capacity
+  csv_context * ctx;           ///< Context with arena
+  csv_table_row ** row_blocks; ///< Block directory (malloc'd)
+  size_t row_block_count;      ///< Number of allocated row blocks
+  size_t row_block_capacity;   ///< Allocated entries in row_blocks
+  size_t * row_block_counts;   ///< Rows in each block (NULL while packed)
+  size_t * row_block_tree; ///< Fenwick tree over row_block_counts, 1-based
+                           ///< (NULL while packed)
+  size_t row_count;            ///< Number of rows
+  size_t row_capacity; ///< Row slots in allocated blocks (blocks * block rows)
   size_t column_count; ///< Expected column count (set by first row, 0 if empty)
 
   // Header map (optional, only if header processing enabled)
@@ -427,8 +592,257 @@ struct GTEXT_CSV_Table {
   csv_header_entry ** index_to_entry; ///< Array mapping column index to header
                                       ///< entry (NULL if no header)
   size_t index_to_entry_capacity;     ///< Capacity of index_to_entry array
+
+  // Column-major storage (NULL in row layout, in which case the row blocks
+  // are used)
+  csv_table_columns * columns; ///< Cell storage in GTEXT_CSV_LAYOUT_COLUMNS
+
+  // Hash indexes built with gtext_csv_build_index() (NULL if none)
+  csv_column_index * column_indexes; ///< Linked list of column indexes
+
+  // Running gtext_csv_table_compact_step() (NULL if none)
+  csv_table_compaction * compaction; ///< Incremental compaction state
+
+  // Row blocks and arena memory shared with copy-on-write clones (NULL if
+  // none)
+  csv_table_share * share; ///< Newest share the table reads from
 };
 
+/**
+ * @brief Copy the row blocks and field arrays a table shares with its clones
+ *
+ * Called before an operation rewrites rows in place. Field data is never
+ * written in place, so it stays shared. Does nothing for a table that shares
+ * nothing or uses the column layout.
+ *
+ * @param table Table (must not be NULL)
+ * @return GTEXT_CSV_OK on success, or GTEXT_CSV_E_OOM (the table's contents
+ *         are unchanged either way)
+ */
+GTEXT_INTERNAL_API GTEXT_CSV_Status csv_table_unshare(GTEXT_CSV_Table * table);
+
+/**
+ * @brief Tell a running incremental compaction that rows were reordered
+ *
+ * Rows from @p first_row on must be visited again. Does nothing if no
+ * compaction is running.
+ *
+ * @param table Table (must not be NULL)
+ * @param first_row First row whose position may have changed
+ */
+GTEXT_INTERNAL_API void csv_table_compaction_rows_moved(
+    GTEXT_CSV_Table * table, size_t first_row);
+
+/**
+ * @brief Add the last data row of a table to its column indexes
+ *
+ * Called after a row is appended. An index that cannot grow is marked stale.
+ *
+ * @param table Table (must not be NULL)
+ */
+GTEXT_INTERNAL_API void csv_table_indexes_row_appended(GTEXT_CSV_Table * table);
+
+/**
+ * @brief Add a data row that was inserted to its column indexes
+ *
+ * Called after the row is in place: indexed rows at or after @p row move down
+ * by one, then the row's values are added. An index that cannot grow is
+ * marked stale.
+ *
+ * @param table Table (must not be NULL)
+ * @param row Data row index (0-based, header excluded)
+ */
+GTEXT_INTERNAL_API void csv_table_indexes_row_inserted(
+    GTEXT_CSV_Table * table, size_t row);
+
+/**
+ * @brief Take a data row that is about to be removed out of its indexes
+ *
+ * Called while the row is still in the table: the row's values are removed
+ * and indexed rows after it move up by one.
+ *
+ * @param table Table (must not be NULL)
+ * @param row Data row index (0-based, header excluded)
+ */
+GTEXT_INTERNAL_API void csv_table_indexes_row_removing(
+    GTEXT_CSV_Table * table, size_t row);
+
+/**
+ * @brief Remove a data row's current values from its column indexes
+ *
+ * Called before the row's values are replaced, and paired with
+ * csv_table_indexes_row_link() once the new values are in place.
+ *
+ * @param table Table (must not be NULL)
+ * @param row Data row index (0-based, header excluded)
+ */
+GTEXT_INTERNAL_API void csv_table_indexes_row_unlink(
+    GTEXT_CSV_Table * table, size_t row);
+
+/**
+ * @brief Add a data row's current values to its column indexes
+ *
+ * An index that cannot grow is marked stale.
+ *
+ * @param table Table (must not be NULL)
+ * @param row Data row index (0-based, header excluded)
+ */
+GTEXT_INTERNAL_API void csv_table_indexes_row_link(
+    GTEXT_CSV_Table * table, size_t row);
+
+/**
+ * @brief Mark column indexes stale after their values changed
+ *
+ * @param table Table (must not be NULL)
+ * @param col Column whose values changed, or SIZE_MAX for every column
+ */
+GTEXT_INTERNAL_API void csv_table_indexes_invalidate(
+    GTEXT_CSV_Table * table, size_t col);
+
+/**
+ * @brief Renumber column indexes after a column was inserted
+ *
+ * Indexes on @p col and later columns move right by one. In a table with
+ * irregular rows the insert may pad short rows, so every index is marked
+ * stale as well.
+ *
+ * @param table Table (must not be NULL)
+ * @param col Index of the inserted column
+ */
+GTEXT_INTERNAL_API void csv_table_indexes_column_inserted(
+    GTEXT_CSV_Table * table, size_t col);
+
+/**
+ * @brief Renumber column indexes after a column was removed
+ *
+ * The index on @p col is dropped and indexes on later columns move left by
+ * one.
+ *
+ * @param table Table (must not be NULL)
+ * @param col Index of the removed column
+ */
+GTEXT_INTERNAL_API void csv_table_indexes_column_removed(
+    GTEXT_CSV_Table * table, size_t col);
+
+/**
+ * @brief Free every column index of a table
+ *
+ * @param table Table (must not be NULL)
+ */
+GTEXT_INTERNAL_API void csv_table_indexes_free(GTEXT_CSV_Table * table);
+
+/**
+ * @brief Find a row of a table with indexed row blocks
+ *
+ * @param table Table (must not be NULL, row_block_tree not NULL)
+ * @param row_idx Row index (below row_count)
+ * @return Row slot for row_idx
+ */
+GTEXT_INTERNAL_API csv_table_row * csv_table_locate_row(
+    const GTEXT_CSV_Table * table, size_t row_idx);
+
+/**
+ * @brief Get a row of a row-major table
+ *
+ * @param table Table (must not be NULL, row layout)
+ * @param row_idx Row index (0-based, header row included). Below row_capacity
+ * while the blocks are packed, below row_count once they are indexed
+ * @return Row slot for row_idx
+ */
+static inline csv_table_row * csv_table_row_at(
+    const GTEXT_CSV_Table * table, size_t row_idx) {
+  if (table->row_block_tree) {
+    return csv_table_locate_row(table, row_idx);
+  }
+  return &table->row_blocks[row_idx >> CSV_ROW_BLOCK_SHIFT]
+                           [row_idx & (CSV_ROW_BLOCK_ROWS - 1)];
+}
+
+/**
+ * @brief Get a cell of a table in either storage layout
+ *
+ * @param table Table (must not be NULL)
+ * @param row_idx Row index (0-based, header row included, below row_count)
+ * @param col Column index (0-based)
+ * @param len Output cell length (0 when the cell does not exist)
+ * @return Cell bytes, or NULL if the row is too short to have the column
+ */
+static inline const char * csv_table_cell_at(const GTEXT_CSV_Table * table,
+    size_t row_idx, size_t col, size_t * len) {
+  const csv_table_columns * cols = table->columns;
+  if (cols) {
+    if (col >= cols->widths[row_idx]) {
+      *len = 0;
+      return NULL;
+    }
+    *len = cols->columns[col].lengths[row_idx];
+    return cols->heap + cols->columns[col].offsets[row_idx];
+  }
+
+  const csv_table_row * row = csv_table_row_at(table, row_idx);
+  if (col >= row->field_count) {
+    *len = 0;
+    return NULL;
+  }
+  *len = row->fields[col].length;
+  return row->fields[col].data;
+}
+
+/**
+ * @brief Resolve a table row in either storage layout
+ *
+ * In the row layout this returns the stored row. In the column layout the
+ * row's cells are gathered into @p scratch_fields, which must have room for
+ * table->columns->column_count fields, and @p scratch_row is returned.
+ *
+ * @param table Table (must not be NULL)
+ * @param row_idx Row index (0-based, header row included)
+ * @param scratch_row Row structure to fill in the column layout
+ * @param scratch_fields Field array to fill in the column layout
+ * @return Row for row_idx (valid until the table or scratch is modified)
+ */
+GTEXT_INTERNAL_API const csv_table_row * csv_table_resolve_row(
+    const GTEXT_CSV_Table * table, size_t row_idx, csv_table_row * scratch_row,
+    csv_table_field * scratch_fields);
+
+/**
+ * @brief Parse a decimal number cell
+ *
+ * Accepts the same text as gtext_csv_column_as_f64().
+ *
+ * @param data Cell bytes (not NUL-terminated)
+ * @param len Cell length in bytes
+ * @param out Parsed value
+ * @return GTEXT_CSV_OK, GTEXT_CSV_E_INVALID if the cell is not a number, or
+ *         GTEXT_CSV_E_OOM
+ */
+GTEXT_INTERNAL_API GTEXT_CSV_Status csv_convert_parse_f64(
+    const char * data, size_t len, double * out);
+
+/**
+ * @brief Parse the value of a cell under a numeric sort key
+ *
+ * @param data Cell bytes (not NUL-terminated)
+ * @param len Cell length in bytes
+ * @param out Parsed value, or NaN if the cell is not a number
+ * @return GTEXT_CSV_OK or GTEXT_CSV_E_OOM
+ */
+GTEXT_INTERNAL_API GTEXT_CSV_Status csv_sort_number(
+    const char * data, size_t len, double * out);
+
+/**
+ * @brief Compare two cells on one sort key, in the key's direction
+ *
+ * @p a_number and @p b_number are the cells' csv_sort_number() values under
+ * a numeric key and are ignored otherwise.
+ *
+ * @return Negative, zero, or positive as @p a sorts before, with, or after
+ *         @p b
+ */
+GTEXT_INTERNAL_API int csv_sort_compare_cells(const GTEXT_CSV_Sort_Key * key,
+    const char * a, size_t a_len, double a_number, const char * b,
+    size_t b_len, double b_number);
+
 /**
  * @brief CSV parser state machine states
  */
@@ -530,9 +944,19 @@ typedef struct {
   csv_table_row * current_row;
   size_t current_field_index;
   size_t current_field_capacity;
+  csv_table_field * record_fields;
   const GTEXT_CSV_Parse_Options * opts;
   GTEXT_CSV_Error * err;
   GTEXT_CSV_Status status;
+  GTEXT_CSV_Stream * stream;
+  const char * error_message;
+  csv_arena_mark record_mark;
+  size_t record_heap_len;
+  size_t record_column_count;
+  size_t * filter_columns;
+  const char ** filter_fields;
+  size_t * filter_lengths;
+  size_t filter_capacity;
 } csv_table_parse_context;
 
 /**
@@ -551,7 +975,7 @@ typedef struct {
 typedef struct {
   csv_context * new_ctx;               ///< New context with arena
   GTEXT_CSV_Table * new_table;         ///< New table structure
-  csv_table_row * new_rows;            ///< New rows array
+  csv_table_row * new_rows;            ///< Staged rows (malloc'd)
   csv_table_field ** new_field_arrays; ///< Array of field array pointers
   char *** new_field_data_ptrs;        ///< Array of field data pointer arrays
 } csv_clone_structures;
@@ -0,0 +1,946 @@
+/**
+ * @file
+ *
+ * Streaming CSV/JSON conversion implementation.
+ *
+ * CSV-to-JSON drives a JSON writer from CSV stream events: the header record
+ * is kept, and every later field is written under its header name as it
+ * arrives. JSON-to-CSV collects scalar values from JSON stream events into a
+ * cell buffer; records are buffered only until the columns are discovered,
+ * and after that each record is written through a CSV writer when its object
+ * ends.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csv_internal.h"
+
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_json.h>
+#include <ghoti.io/text/csv/csv_stream.h>
+#include <ghoti.io/text/csv/csv_writer.h>
+#include <ghoti.io/text/json/json_core.h>
+#include <ghoti.io/text/json/json_stream.h>
+#include <ghoti.io/text/json/json_writer.h>
+
+// Records buffered for column discovery when the options leave it at 0
+#define CSV_JSON_DEFAULT_DISCOVERY 100
+
+// Smallest slot table of a column map (a power of two)
+#define CSV_JSON_MIN_SLOTS 16
+
+// Column of a pending JSON key whose value is dropped
+#define CSV_JSON_SKIP_COLUMN SIZE_MAX
+
+// Column name, stored in a shared name buffer
+typedef struct {
+  size_t offset; // Name offset in the name buffer
+  size_t length; // Name length in bytes
+  size_t hash;   // Hash of the name
+  bool written;  // False for a repeated CSV header name that is skipped
+} csv_json_column;
+
+// Column names with a hash lookup
+// slots holds column index + 1 for each used slot, 0 for an empty one
+typedef struct {
+  char * names;
+  size_t names_used;
+  size_t names_capacity;
+  csv_json_column * columns;
+  size_t column_count;
+  size_t column_capacity;
+  size_t * slots;
+  size_t slot_count;
+} csv_json_columns;
+
+// One value of a buffered JSON record
+typedef struct {
+  size_t column; // Column the value belongs to
+  size_t offset; // Value offset in the value buffer
+  size_t length; // Value length in bytes
+} csv_json_cell;
+
+struct GTEXT_CSV_To_JSON {
+  GTEXT_CSV_Stream * stream;
+  GTEXT_JSON_Writer * writer;
+  GTEXT_JSON_Sink sink;
+  GTEXT_CSV_To_JSON_Options opts;
+  GTEXT_CSV_Dupcol_Mode dup_mode;
+  const char * newline;   // Separator written after each LINES object
+  size_t newline_length;
+  csv_json_columns header;
+  bool header_done;       // The header record has been read
+  bool array_open;        // The ARRAY output's '[' has been written
+  bool finished;          // gtext_csv_to_json_finish() has run
+  GTEXT_CSV_Status status; // First failure (sticky)
+  const char * message;   // Message of a failure raised by the converter
+};
+
+struct GTEXT_CSV_From_JSON {
+  GTEXT_JSON_Stream * stream;
+  GTEXT_CSV_Writer * writer;
+  GTEXT_CSV_From_JSON_Options opts;
+  csv_json_columns columns;
+  csv_json_cell * cells; // Values of the buffered records
+  size_t cell_count;
+  size_t cell_capacity;
+  char * values; // Bytes of the buffered values
+  size_t values_used;
+  size_t values_capacity;
+  size_t * record_ends; // cell_count after each record buffered in discovery
+  size_t record_count;
+  size_t record_capacity;
+  size_t * row_cells; // Cell index + 1 per column of the record being written
+  bool discovering;   // Columns are still being collected
+  int depth;          // 0 outside the array, 1 in it, 2 in a record
+  bool array_done;    // The top-level array has ended
+  size_t pending_column; // Column of the last key, awaiting its value
+  size_t next_column;    // Column the next key is predicted to name
+  bool finished;         // gtext_csv_from_json_finish() has run
+  GTEXT_JSON_Status status; // First failure (sticky)
+  const char * message;     // Message of a failure raised by the converter
+};
+
+// Grow an array so it holds at least need elements
+static bool csv_json_reserve(
+    void ** data, size_t * capacity, size_t need, size_t elem_size) {
+  if (need <= *capacity) {
+    return true;
+  }
+  size_t new_capacity = *capacity ? *capacity : 16;
+  while (new_capacity < need) {
+    if (new_capacity > SIZE_MAX / 2) {
+      return false;
+    }
+    new_capacity *= 2;
+  }
+  if (new_capacity > SIZE_MAX / elem_size) {
+    return false;
+  }
+  void * grown = realloc(*data, new_capacity * elem_size);
+  if (!grown) {
+    return false;
+  }
+  *data = grown;
+  *capacity = new_capacity;
+  return true;
+}
+
+// FNV-1a hash of a column name
+static size_t csv_json_hash(const char * data, size_t len) {
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= (unsigned char)data[i];
+    hash *= 1099511628211ull;
+  }
+  return (size_t)(hash ^ (hash >> 32));
+}
+
+// Check whether a column holds a name
+static bool csv_json_column_is(const csv_json_columns * map, size_t col,
+    const char * name, size_t len, size_t hash) {
+  const csv_json_column * column = &map->columns[col];
+  return column->hash == hash && column->length == len &&
+      (len == 0 || memcmp(map->names + column->offset, name, len) == 0);
+}
+
+// Find a column by name, or return SIZE_MAX
+static size_t csv_json_columns_find(
+    const csv_json_columns * map, const char * name, size_t len, size_t hash) {
+  if (map->slot_count == 0) {
+    return SIZE_MAX;
+  }
+  size_t mask = map->slot_count - 1;
+  for (size_t slot = hash & mask; map->slots[slot] != 0;
+       slot = (slot + 1) & mask) {
+    size_t col = map->slots[slot] - 1;
+    if (csv_json_column_is(map, col, name, len, hash)) {
+      return col;
+    }
+  }
+  return SIZE_MAX;
+}
+
+// Put a column into the slot table
+static void csv_json_columns_link(csv_json_columns * map, size_t col) {
+  size_t mask = map->slot_count - 1;
+  size_t slot = map->columns[col].hash & mask;
+  while (map->slots[slot] != 0) {
+    slot = (slot + 1) & mask;
+  }
+  map->slots[slot] = col + 1;
+}
+
+// Keep the slot table at most half full
+static bool csv_json_columns_grow_slots(csv_json_columns * map) {
+  if (map->column_count <= map->slot_count / 2) {
+    return true;
+  }
+  size_t new_count = map->slot_count ? map->slot_count * 2 : CSV_JSON_MIN_SLOTS;
+  if (new_count > SIZE_MAX / sizeof(size_t)) {
+    return false;
+  }
+  size_t * slots = (size_t *)calloc(new_count, sizeof(size_t));
+  if (!slots) {
+    return false;
+  }
+  free(map->slots);
+  map->slots = slots;
+  map->slot_count = new_count;
+  for (size_t col = 0; col < map->column_count; col++) {
+    csv_json_columns_link(map, col);
+  }
+  return true;
+}
+
+// Append a column name
+// The slot table is only updated when link is set, so CSV headers can add
+// every name first and link them once the duplicate mode is known
+static bool csv_json_columns_add(
+    csv_json_columns * map, const char * name, size_t len, bool link) {
+  if (len > SIZE_MAX - map->names_used ||
+      !csv_json_reserve((void **)&map->names, &map->names_capacity,
+          map->names_used + len, 1) ||
+      !csv_json_reserve((void **)&map->columns, &map->column_capacity,
+          map->column_count + 1, sizeof(csv_json_column))) {
+    return false;
+  }
+
+  csv_json_column * column = &map->columns[map->column_count];
+  column->offset = map->names_used;
+  column->length = len;
+  column->hash = csv_json_hash(name, len);
+  column->written = true;
+  if (len > 0) {
+    memcpy(map->names + map->names_used, name, len);
+  }
+  map->names_used += len;
+  map->column_count++;
+
+  if (link) {
+    if (!csv_json_columns_grow_slots(map)) {
+      map->column_count--;
+      map->names_used -= len;
+      return false;
+    }
+    csv_json_columns_link(map, map->column_count - 1);
+  }
+  return true;
+}
+
+// Free column names and their lookup
+static void csv_json_columns_free(csv_json_columns * map) {
+  free(map->names);
+  free(map->columns);
+  free(map->slots);
+}
+
+// Check a field against the JSON number grammar
+static bool csv_json_is_number(const char * s, size_t len) {
+  size_t i = 0;
+  if (i < len && s[i] == '-') {
+    i++;
+  }
+  if (i >= len) {
+    return false;
+  }
+  if (s[i] == '0') {
+    i++;
+  }
+  else if (s[i] >= '1' && s[i] <= '9') {
+    while (i < len && s[i] >= '0' && s[i] <= '9') {
+      i++;
+    }
+  }
+  else {
+    return false;
+  }
+
+  if (i < len && s[i] == '.') {
+    i++;
+    size_t start = i;
+    while (i < len && s[i] >= '0' && s[i] <= '9') {
+      i++;
+    }
+    if (i == start) {
+      return false;
+    }
+  }
+
+  if (i < len && (s[i] == 'e' || s[i] == 'E')) {
+    i++;
+    if (i < len && (s[i] == '+' || s[i] == '-')) {
+      i++;
+    }
+    size_t start = i;
+    while (i < len && s[i] >= '0' && s[i] <= '9') {
+      i++;
+    }
+    if (i == start) {
+      return false;
+    }
+  }
+
+  return i == len;
+}
+
+// ============================================================================
+// CSV to JSON
+// ============================================================================
+
+// Record a failure raised by the converter and return its status
+static GTEXT_CSV_Status csv_to_json_fail(
+    GTEXT_CSV_To_JSON * conv, GTEXT_CSV_Status status, const char * message) {
+  conv->status = status;
+  conv->message = message;
+  return status;
+}
+
+// Record a JSON writer failure
+static GTEXT_CSV_Status csv_to_json_write_failed(GTEXT_CSV_To_JSON * conv) {
+  return csv_to_json_fail(conv, GTEXT_CSV_E_WRITE, "JSON output failed");
+}
+
+// Pick the columns a repeated header name is written from
+// FIRST_WINS and COLLECT keep the first column of a name, LAST_WINS the last
+static GTEXT_CSV_Status csv_to_json_finish_header(GTEXT_CSV_To_JSON * conv) {
+  csv_json_columns * header = &conv->header;
+  conv->header_done = true;
+  if (header->column_count == 0) {
+    return GTEXT_CSV_OK;
+  }
+
+  size_t slot_count = CSV_JSON_MIN_SLOTS;
+  while (slot_count / 2 < header->column_count &&
+      slot_count <= SIZE_MAX / 2 / sizeof(size_t)) {
+    slot_count *= 2;
+  }
+  header->slots = (size_t *)calloc(slot_count, sizeof(size_t));
+  if (!header->slots || slot_count / 2 < header->column_count) {
+    return csv_to_json_fail(
+        conv, GTEXT_CSV_E_OOM, "Out of memory indexing the header");
+  }
+  header->slot_count = slot_count;
+
+  bool last_wins = conv->dup_mode == GTEXT_CSV_DUPCOL_LAST_WINS;
+  for (size_t i = 0; i < header->column_count; i++) {
+    size_t col = last_wins ? header->column_count - 1 - i : i;
+    csv_json_column * column = &header->columns[col];
+    if (csv_json_columns_find(header, header->names + column->offset,
+            column->length, column->hash) != SIZE_MAX) {
+      if (conv->dup_mode == GTEXT_CSV_DUPCOL_ERROR) {
+        return csv_to_json_fail(
+            conv, GTEXT_CSV_E_INVALID, "Duplicate column name in header");
+      }
+      column->written = false;
+      continue;
+    }
+    csv_json_columns_link(header, col);
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Write one data field under its key
+static GTEXT_CSV_Status csv_to_json_field(
+    GTEXT_CSV_To_JSON * conv, const GTEXT_CSV_Event * event) {
+  const csv_json_columns * header = &conv->header;
+  GTEXT_JSON_Status status;
+  if (event->col_index < header->column_count) {
+    const csv_json_column * column = &header->columns[event->col_index];
+    if (!column->written) {
+      return GTEXT_CSV_OK;
+    }
+    status = gtext_json_writer_key(
+        conv->writer, header->names + column->offset, column->length);
+  }
+  else {
+    char key[32];
+    int key_len = snprintf(key, sizeof(key), "%zu", event->col_index);
+    status = gtext_json_writer_key(conv->writer, key, (size_t)key_len);
+  }
+  if (status != GTEXT_JSON_OK) {
+    return csv_to_json_write_failed(conv);
+  }
+
+  const char * data = event->data ? event->data : "";
+  if (event->data_len == 0 && conv->opts.empty_as_null) {
+    status = gtext_json_writer_null(conv->writer);
+  }
+  else if (conv->opts.infer_numbers &&
+      csv_json_is_number(data, event->data_len)) {
+    status =
+        gtext_json_writer_number_lexeme(conv->writer, data, event->data_len);
+  }
+  else {
+    status = gtext_json_writer_string(conv->writer, data, event->data_len);
+  }
+  return status == GTEXT_JSON_OK ? GTEXT_CSV_OK
+                                : csv_to_json_write_failed(conv);
+}
+
+// Write the ARRAY output's '[' before the first record
+static GTEXT_CSV_Status csv_to_json_open_array(GTEXT_CSV_To_JSON * conv) {
+  if (conv->opts.format != GTEXT_CSV_JSON_ARRAY || conv->array_open) {
+    return GTEXT_CSV_OK;
+  }
+  conv->array_open = true;
+  if (gtext_json_writer_array_begin(conv->writer) != GTEXT_JSON_OK) {
+    return csv_to_json_write_failed(conv);
+  }
+  return GTEXT_CSV_OK;
+}
+
+// CSV stream callback
+static GTEXT_CSV_Status csv_to_json_event(
+    const GTEXT_CSV_Event * event, void * user_data) {
+  GTEXT_CSV_To_JSON * conv = (GTEXT_CSV_To_JSON *)user_data;
+
+  if (!conv->header_done) {
+    if (event->type == GTEXT_CSV_EVENT_FIELD) {
+      if (!csv_json_columns_add(&conv->header,
+              event->data ? event->data : "", event->data_len, false)) {
+        return csv_to_json_fail(
+            conv, GTEXT_CSV_E_OOM, "Out of memory storing the header");
+      }
+    }
+    else if (event->type == GTEXT_CSV_EVENT_RECORD_END) {
+      return csv_to_json_finish_header(conv);
+    }
+    return GTEXT_CSV_OK;
+  }
+
+  switch (event->type) {
+  case GTEXT_CSV_EVENT_RECORD_BEGIN: {
+    GTEXT_CSV_Status status = csv_to_json_open_array(conv);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+    if (gtext_json_writer_object_begin(conv->writer) != GTEXT_JSON_OK) {
+      return csv_to_json_write_failed(conv);
+    }
+    return GTEXT_CSV_OK;
+  }
+  case GTEXT_CSV_EVENT_FIELD:
+    return csv_to_json_field(conv, event);
+  case GTEXT_CSV_EVENT_RECORD_END:
+    if (gtext_json_writer_object_end(conv->writer) != GTEXT_JSON_OK) {
+      return csv_to_json_write_failed(conv);
+    }
+    if (conv->opts.format == GTEXT_CSV_JSON_LINES &&
+        conv->sink.write(conv->sink.user, conv->newline,
+            conv->newline_length) != 0) {
+      return csv_to_json_write_failed(conv);
+    }
+    return GTEXT_CSV_OK;
+  default:
+    return GTEXT_CSV_OK;
+  }
+}
+
+// Report the result of a stream call, preferring the converter's own error
+static GTEXT_CSV_Status csv_to_json_result(
+    GTEXT_CSV_To_JSON * conv, GTEXT_CSV_Status status, GTEXT_CSV_Error * err) {
+  if (status == GTEXT_CSV_OK) {
+    return GTEXT_CSV_OK;
+  }
+  if (conv->message) {
+    gtext_csv_error_free(err);
+    CSV_SET_ERROR(err, conv->status, conv->message);
+    return conv->status;
+  }
+  conv->status = status;
+  return status;
+}
+
+GTEXT_API GTEXT_CSV_To_JSON_Options gtext_csv_to_json_options_default(void) {
+  GTEXT_CSV_To_JSON_Options opts;
+  opts.format = GTEXT_CSV_JSON_ARRAY;
+  opts.infer_numbers = false;
+  opts.empty_as_null = false;
+  return opts;
+}
+
+GTEXT_API GTEXT_CSV_To_JSON * gtext_csv_to_json_new(
+    const GTEXT_CSV_Parse_Options * parse_opts,
+    const GTEXT_CSV_To_JSON_Options * opts, GTEXT_JSON_Sink sink,
+    const GTEXT_JSON_Write_Options * write_opts) {
+  if (!sink.write) {
+    return NULL;
+  }
+
+  GTEXT_CSV_To_JSON * conv =
+      (GTEXT_CSV_To_JSON *)calloc(1, sizeof(GTEXT_CSV_To_JSON));
+  if (!conv) {
+    return NULL;
+  }
+  conv->sink = sink;
+  conv->opts = opts ? *opts : gtext_csv_to_json_options_default();
+  conv->dup_mode = parse_opts ? parse_opts->dialect.header_dup_mode
+                              : GTEXT_CSV_DUPCOL_FIRST_WINS;
+
+  GTEXT_JSON_Write_Options json_opts =
+      write_opts ? *write_opts : gtext_json_write_options_default();
+  conv->newline = json_opts.newline ? json_opts.newline : "\n";
+  conv->newline_length = strlen(conv->newline);
+  if (conv->opts.format == GTEXT_CSV_JSON_LINES) {
+    json_opts.pretty = false;
+    json_opts.trailing_newline = false;
+  }
+
+  conv->writer = gtext_json_writer_new(sink, &json_opts);
+  conv->stream = gtext_csv_stream_new(parse_opts, csv_to_json_event, conv);
+  if (!conv->writer || !conv->stream) {
+    gtext_csv_to_json_free(conv);
+    return NULL;
+  }
+  return conv;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_to_json_feed(GTEXT_CSV_To_JSON * conv,
+    const void * data, size_t len, GTEXT_CSV_Error * err) {
+  if (!conv) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Converter must not be NULL");
+    return GTEXT_CSV_E_INVALID;
+  }
+  if (conv->status != GTEXT_CSV_OK || conv->finished) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_STATE, "Converter has failed or finished");
+    return GTEXT_CSV_E_STATE;
+  }
+
+  return csv_to_json_result(
+      conv, gtext_csv_stream_feed(conv->stream, data, len, err), err);
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_to_json_finish(
+    GTEXT_CSV_To_JSON * conv, GTEXT_CSV_Error * err) {
+  if (!conv) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Converter must not be NULL");
+    return GTEXT_CSV_E_INVALID;
+  }
+  if (conv->status != GTEXT_CSV_OK || conv->finished) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_STATE, "Converter has failed or finished");
+    return GTEXT_CSV_E_STATE;
+  }
+  conv->finished = true;
+
+  GTEXT_CSV_Status status = csv_to_json_result(
+      conv, gtext_csv_stream_finish(conv->stream, err), err);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+
+  if (conv->opts.format == GTEXT_CSV_JSON_ARRAY) {
+    status = csv_to_json_open_array(conv);
+    if (status == GTEXT_CSV_OK &&
+        gtext_json_writer_array_end(conv->writer) != GTEXT_JSON_OK) {
+      status = csv_to_json_write_failed(conv);
+    }
+  }
+  if (status == GTEXT_CSV_OK) {
+    GTEXT_JSON_Error json_err = {0};
+    if (gtext_json_writer_finish(conv->writer, &json_err) != GTEXT_JSON_OK) {
+      status = csv_to_json_write_failed(conv);
+    }
+    gtext_json_error_free(&json_err);
+  }
+
+  if (status != GTEXT_CSV_OK) {
+    CSV_SET_ERROR(err, conv->status, conv->message);
+  }
+  return status;
+}
+
+GTEXT_API void gtext_csv_to_json_free(GTEXT_CSV_To_JSON * conv) {
+  if (!conv) {
+    return;
+  }
+  gtext_csv_stream_free(conv->stream);
+  gtext_json_writer_free(conv->writer);
+  csv_json_columns_free(&conv->header);
+  free(conv);
+}
+
+// ============================================================================
+// JSON to CSV
+// ============================================================================
+
+// Record a failure raised by the converter and return its status
+static GTEXT_JSON_Status csv_from_json_fail(GTEXT_CSV_From_JSON * conv,
+    GTEXT_JSON_Status status, const char * message) {
+  conv->status = status;
+  conv->message = message;
+  return status;
+}
+
+// Record a CSV writer failure
+static GTEXT_JSON_Status csv_from_json_write_failed(
+    GTEXT_CSV_From_JSON * conv, GTEXT_CSV_Status status) {
+  if (status == GTEXT_CSV_E_OOM) {
+    return csv_from_json_fail(
+        conv, GTEXT_JSON_E_OOM, "Out of memory writing CSV output");
+  }
+  return csv_from_json_fail(conv, GTEXT_JSON_E_WRITE, "CSV output failed");
+}
+
+// Write the records whose cells are [begin, end) of the cell buffer
+// Records hold cell ranges [record_ends[i - 1], record_ends[i])
+static GTEXT_JSON_Status csv_from_json_write_record(
+    GTEXT_CSV_From_JSON * conv, size_t begin, size_t end) {
+  const csv_json_columns * columns = &conv->columns;
+  if (columns->column_count == 0) {
+    return GTEXT_JSON_OK;
+  }
+
+  memset(conv->row_cells, 0, columns->column_count * sizeof(size_t));
+  for (size_t i = begin; i < end; i++) {
+    conv->row_cells[conv->cells[i].column] = i + 1;
+  }
+
+  GTEXT_CSV_Status status = gtext_csv_writer_record_begin(conv->writer);
+  for (size_t col = 0; status == GTEXT_CSV_OK && col < columns->column_count;
+       col++) {
+    size_t cell = conv->row_cells[col];
+    if (cell == 0) {
+      status = gtext_csv_writer_field(conv->writer, "", 0);
+    }
+    else {
+      const csv_json_cell * value = &conv->cells[cell - 1];
+      status = gtext_csv_writer_field(
+          conv->writer, conv->values + value->offset, value->length);
+    }
+  }
+  if (status == GTEXT_CSV_OK) {
+    status = gtext_csv_writer_record_end(conv->writer);
+  }
+  return status == GTEXT_CSV_OK ? GTEXT_JSON_OK
+                                : csv_from_json_write_failed(conv, status);
+}
+
+// Fix the columns, then write the header and the buffered records
+static GTEXT_JSON_Status csv_from_json_end_discovery(
+    GTEXT_CSV_From_JSON * conv) {
+  const csv_json_columns * columns = &conv->columns;
+  conv->discovering = false;
+
+  if (columns->column_count > 0) {
+    conv->row_cells = (size_t *)malloc(columns->column_count * sizeof(size_t));
+    if (!conv->row_cells) {
+      return csv_from_json_fail(
+          conv, GTEXT_JSON_E_OOM, "Out of memory fixing the columns");
+    }
+  }
+
+  if (conv->opts.write_header && columns->column_count > 0) {
+    GTEXT_CSV_Status status = gtext_csv_writer_record_begin(conv->writer);
+    for (size_t col = 0;
+         status == GTEXT_CSV_OK && col < columns->column_count; col++) {
+      const csv_json_column * column = &columns->columns[col];
+      status = gtext_csv_writer_field(
+          conv->writer, columns->names + column->offset, column->length);
+    }
+    if (status == GTEXT_CSV_OK) {
+      status = gtext_csv_writer_record_end(conv->writer);
+    }
+    if (status != GTEXT_CSV_OK) {
+      return csv_from_json_write_failed(conv, status);
+    }
+  }
+
+  size_t begin = 0;
+  for (size_t r = 0; r < conv->record_count; r++) {
+    GTEXT_JSON_Status status =
+        csv_from_json_write_record(conv, begin, conv->record_ends[r]);
+    if (status != GTEXT_JSON_OK) {
+      return status;
+    }
+    begin = conv->record_ends[r];
+  }
+
+  // From here on the buffers hold one record at a time
+  free(conv->record_ends);
+  conv->record_ends = NULL;
+  conv->record_count = 0;
+  conv->record_capacity = 0;
+  conv->cell_count = 0;
+  conv->values_used = 0;
+  return GTEXT_JSON_OK;
+}
+
+// Resolve the column a key names
+static GTEXT_JSON_Status csv_from_json_key(
+    GTEXT_CSV_From_JSON * conv, const char * name, size_t len) {
+  csv_json_columns * columns = &conv->columns;
+  size_t hash = csv_json_hash(name, len);
+
+  // Records usually list their keys in column order
+  size_t col = conv->next_column;
+  if (col >= columns->column_count ||
+      !csv_json_column_is(columns, col, name, len, hash)) {
+    col = csv_json_columns_find(columns, name, len, hash);
+  }
+
+  if (col == SIZE_MAX) {
+    if (!conv->discovering) {
+      if (!conv->opts.ignore_unknown_keys) {
+        return csv_from_json_fail(
+            conv, GTEXT_JSON_E_INVALID, "Key not in the discovered columns");
+      }
+      conv->pending_column = CSV_JSON_SKIP_COLUMN;
+      return GTEXT_JSON_OK;
+    }
+    if (!csv_json_columns_add(columns, name, len, true)) {
+      return csv_from_json_fail(
+          conv, GTEXT_JSON_E_OOM, "Out of memory adding a column");
+    }
+    col = columns->column_count - 1;
+  }
+
+  conv->pending_column = col;
+  conv->next_column = col + 1;
+  return GTEXT_JSON_OK;
+}
+
+// Buffer the value of the pending key
+static GTEXT_JSON_Status csv_from_json_value(
+    GTEXT_CSV_From_JSON * conv, const char * data, size_t len) {
+  if (conv->pending_column == CSV_JSON_SKIP_COLUMN) {
+    return GTEXT_JSON_OK;
+  }
+  if (len > SIZE_MAX - conv->values_used ||
+      !csv_json_reserve((void **)&conv->values, &conv->values_capacity,
+          conv->values_used + len, 1) ||
+      !csv_json_reserve((void **)&conv->cells, &conv->cell_capacity,
+          conv->cell_count + 1, sizeof(csv_json_cell))) {
+    return csv_from_json_fail(
+        conv, GTEXT_JSON_E_OOM, "Out of memory buffering a value");
+  }
+
+  csv_json_cell * cell = &conv->cells[conv->cell_count++];
+  cell->column = conv->pending_column;
+  cell->offset = conv->values_used;
+  cell->length = len;
+  if (len > 0) {
+    memcpy(conv->values + conv->values_used, data, len);
+  }
+  conv->values_used += len;
+  return GTEXT_JSON_OK;
+}
+
+// Finish the record whose object just ended
+static GTEXT_JSON_Status csv_from_json_end_record(GTEXT_CSV_From_JSON * conv) {
+  if (!conv->discovering) {
+    GTEXT_JSON_Status status =
+        csv_from_json_write_record(conv, 0, conv->cell_count);
+    conv->cell_count = 0;
+    conv->values_used = 0;
+    return status;
+  }
+
+  if (!csv_json_reserve((void **)&conv->record_ends, &conv->record_capacity,
+          conv->record_count + 1, sizeof(size_t))) {
+    return csv_from_json_fail(
+        conv, GTEXT_JSON_E_OOM, "Out of memory buffering a record");
+  }
+  conv->record_ends[conv->record_count++] = conv->cell_count;
+  if (conv->record_count >= conv->opts.discovery_records) {
+    return csv_from_json_end_discovery(conv);
+  }
+  return GTEXT_JSON_OK;
+}
+
+// JSON stream callback
+static GTEXT_JSON_Status csv_from_json_event(
+    void * user, const GTEXT_JSON_Event * evt, GTEXT_JSON_Error * err) {
+  GTEXT_CSV_From_JSON * conv = (GTEXT_CSV_From_JSON *)user;
+  (void)err;
+
+  if (conv->depth == 0) {
+    if (evt->type != GTEXT_JSON_EVT_ARRAY_BEGIN) {
+      return csv_from_json_fail(
+          conv, GTEXT_JSON_E_INVALID, "Top-level value must be an array");
+    }
+    conv->depth = 1;
+    return GTEXT_JSON_OK;
+  }
+
+  if (conv->depth == 1) {
+    if (evt->type == GTEXT_JSON_EVT_OBJECT_BEGIN) {
+      conv->depth = 2;
+      conv->next_column = 0;
+      return GTEXT_JSON_OK;
+    }
+    if (evt->type == GTEXT_JSON_EVT_ARRAY_END) {
+      conv->depth = 0;
+      conv->array_done = true;
+      return GTEXT_JSON_OK;
+    }
+    return csv_from_json_fail(
+        conv, GTEXT_JSON_E_INVALID, "Array elements must be objects");
+  }
+
+  switch (evt->type) {
+  case GTEXT_JSON_EVT_KEY:
+    return csv_from_json_key(conv, evt->as.str.s, evt->as.str.len);
+  case GTEXT_JSON_EVT_STRING:
+    return csv_from_json_value(conv, evt->as.str.s, evt->as.str.len);
+  case GTEXT_JSON_EVT_NUMBER:
+    return csv_from_json_value(conv, evt->as.number.s, evt->as.number.len);
+  case GTEXT_JSON_EVT_BOOL:
+    return evt->as.boolean ? csv_from_json_value(conv, "true", 4)
+                           : csv_from_json_value(conv, "false", 5);
+  case GTEXT_JSON_EVT_NULL:
+    return csv_from_json_value(conv, "", 0);
+  case GTEXT_JSON_EVT_OBJECT_END:
+    conv->depth = 1;
+    return csv_from_json_end_record(conv);
+  default:
+    return csv_from_json_fail(
+        conv, GTEXT_JSON_E_INVALID, "Nested values cannot be written to CSV");
+  }
+}
+
+// Report the result of a stream call, preferring the converter's own error
+static GTEXT_JSON_Status csv_from_json_result(GTEXT_CSV_From_JSON * conv,
+    GTEXT_JSON_Status status, GTEXT_JSON_Error * err) {
+  if (status == GTEXT_JSON_OK) {
+    return GTEXT_JSON_OK;
+  }
+  if (conv->message) {
+    if (err) {
+      gtext_json_error_free(err);
+      *err = (GTEXT_JSON_Error){.code = conv->status,
+          .message = conv->message,
+          .line = 1,
+          .col = 1};
+    }
+    return conv->status;
+  }
+  conv->status = status;
+  return status;
+}
+
+// Check that a converter can still be used
+static GTEXT_JSON_Status csv_from_json_check(
+    const GTEXT_CSV_From_JSON * conv, GTEXT_JSON_Error * err) {
+  if (!conv) {
+    if (err) {
+      *err = (GTEXT_JSON_Error){.code = GTEXT_JSON_E_INVALID,
+          .message = "Converter must not be NULL",
+          .line = 1,
+          .col = 1};
+    }
+    return GTEXT_JSON_E_INVALID;
+  }
+  if (conv->status != GTEXT_JSON_OK || conv->finished) {
+    if (err) {
+      *err = (GTEXT_JSON_Error){.code = GTEXT_JSON_E_STATE,
+          .message = "Converter has failed or finished",
+          .line = 1,
+          .col = 1};
+    }
+    return GTEXT_JSON_E_STATE;
+  }
+  return GTEXT_JSON_OK;
+}
+
+GTEXT_API GTEXT_CSV_From_JSON_Options gtext_csv_from_json_options_default(
+    void) {
+  GTEXT_CSV_From_JSON_Options opts;
+  opts.discovery_records = CSV_JSON_DEFAULT_DISCOVERY;
+  opts.ignore_unknown_keys = false;
+  opts.write_header = true;
+  return opts;
+}
+
+GTEXT_API GTEXT_CSV_From_JSON * gtext_csv_from_json_new(
+    const GTEXT_JSON_Parse_Options * parse_opts,
+    const GTEXT_CSV_From_JSON_Options * opts, const GTEXT_CSV_Sink * sink,
+    const GTEXT_CSV_Write_Options * write_opts) {
+  if (!sink || !sink->write) {
+    return NULL;
+  }
+
+  GTEXT_CSV_From_JSON * conv =
+      (GTEXT_CSV_From_JSON *)calloc(1, sizeof(GTEXT_CSV_From_JSON));
+  if (!conv) {
+    return NULL;
+  }
+  conv->opts = opts ? *opts : gtext_csv_from_json_options_default();
+  if (conv->opts.discovery_records == 0) {
+    conv->opts.discovery_records = CSV_JSON_DEFAULT_DISCOVERY;
+  }
+  conv->discovering = true;
+
+  GTEXT_CSV_Write_Options csv_opts =
+      write_opts ? *write_opts : gtext_csv_write_options_default();
+  conv->writer = gtext_csv_writer_new(sink, &csv_opts);
+  conv->stream = gtext_json_stream_new(parse_opts, csv_from_json_event, conv);
+  if (!conv->writer || !conv->stream) {
+    gtext_csv_from_json_free(conv);
+    return NULL;
+  }
+  return conv;
+}
+
+GTEXT_API GTEXT_JSON_Status gtext_csv_from_json_feed(
+    GTEXT_CSV_From_JSON * conv, const void * data, size_t len,
+    GTEXT_JSON_Error * err) {
+  GTEXT_JSON_Status status = csv_from_json_check(conv, err);
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
+  return csv_from_json_result(conv,
+      gtext_json_stream_feed(conv->stream, (const char *)data, len, err), err);
+}
+
+GTEXT_API GTEXT_JSON_Status gtext_csv_from_json_finish(
+    GTEXT_CSV_From_JSON * conv, GTEXT_JSON_Error * err) {
+  GTEXT_JSON_Status status = csv_from_json_check(conv, err);
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
+  conv->finished = true;
+
+  status = csv_from_json_result(
+      conv, gtext_json_stream_finish(conv->stream, err), err);
+  if (status == GTEXT_JSON_OK && !conv->array_done) {
+    status = csv_from_json_fail(
+        conv, GTEXT_JSON_E_INCOMPLETE, "Input ended inside the array");
+  }
+  if (status == GTEXT_JSON_OK && conv->discovering) {
+    status = csv_from_json_end_discovery(conv);
+  }
+  if (status == GTEXT_JSON_OK) {
+    GTEXT_CSV_Status csv_status = gtext_csv_writer_finish(conv->writer);
+    if (csv_status != GTEXT_CSV_OK) {
+      status = csv_from_json_write_failed(conv, csv_status);
+    }
+  }
+
+  if (status != GTEXT_JSON_OK && conv->message && err) {
+    gtext_json_error_free(err);
+    *err = (GTEXT_JSON_Error){
+        .code = conv->status, .message = conv->message, .line = 1, .col = 1};
+  }
+  return status;
+}
+
+GTEXT_API void gtext_csv_from_json_free(GTEXT_CSV_From_JSON * conv) {
+  if (!conv) {
+    return;
+  }
+  gtext_json_stream_free(conv->stream);
+  gtext_csv_writer_free(conv->writer);
+  csv_json_columns_free(&conv->columns);
+  free(conv->cells);
+  free(conv->values);
+  free(conv->record_ends);
+  free(conv->row_cells);
+  free(conv);
+}
@@ -0,0 +1,602 @@
+/**
+ * @file
+ *
+ * Hash indexes on CSV table columns.
+ *
+ * An index maps each distinct value of one column to the data rows holding
+ * it, so finding rows by value, and joining two tables on a key column, take
+ * one hash probe per value instead of a scan of the table.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csv_internal.h"
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_table.h>
+
+// Bucket count of a new index (a power of two)
+#define CSV_INDEX_MIN_BUCKETS 64
+
+// Key bytes shared by every empty value
+static const char csv_index_empty_key[] = "";
+
+// Index of the first data row
+static size_t csv_lookup_data_start(const GTEXT_CSV_Table * table) {
+  return (table->has_header && table->row_count > 0) ? 1 : 0;
+}
+
+// FNV-1a hash of a value
+static size_t csv_index_hash(const char * data, size_t len) {
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= (unsigned char)data[i];
+    hash *= 1099511628211ull;
+  }
+  return (size_t)(hash ^ (hash >> 32));
+}
+
+// Find the key for a value, or NULL if no row holds it
+static csv_index_key * csv_index_find(const csv_column_index * index,
+    const char * data, size_t len, size_t hash) {
+  csv_index_key * key = index->buckets[hash & (index->bucket_count - 1)];
+  while (key) {
+    if (key->hash == hash && key->length == len &&
+        (len == 0 || memcmp(key->data, data, len) == 0)) {
+      return key;
+    }
+    key = key->next;
+  }
+  return NULL;
+}
+
+// Double the bucket count once there are more keys than buckets
+// A failed allocation keeps the current buckets (chains just get longer)
+static void csv_index_grow_buckets(csv_column_index * index) {
+  if (index->key_count <= index->bucket_count ||
+      index->bucket_count > SIZE_MAX / 2 / sizeof(csv_index_key *)) {
+    return;
+  }
+
+  size_t new_count = index->bucket_count * 2;
+  csv_index_key ** buckets =
+      (csv_index_key **)calloc(new_count, sizeof(csv_index_key *));
+  if (!buckets) {
+    return;
+  }
+
+  for (size_t b = 0; b < index->bucket_count; b++) {
+    csv_index_key * key = index->buckets[b];
+    while (key) {
+      csv_index_key * next = key->next;
+      size_t slot = key->hash & (new_count - 1);
+      key->next = buckets[slot];
+      buckets[slot] = key;
+      key = next;
+    }
+  }
+  free(index->buckets);
+  index->buckets = buckets;
+  index->bucket_count = new_count;
+}
+
+// Record that a data row holds a value
+// Rows must be added in ascending order
+static GTEXT_CSV_Status csv_index_add(csv_column_index * index,
+    const char * data, size_t len, size_t row) {
+  size_t hash = csv_index_hash(data, len);
+  csv_index_key * key = csv_index_find(index, data, len, hash);
+
+  if (!key) {
+    key = (csv_index_key *)csv_arena_alloc_for_context(
+        index->ctx, sizeof(csv_index_key), 8);
+    if (!key) {
+      return GTEXT_CSV_E_OOM;
+    }
+    key->data = csv_index_empty_key;
+    if (len > 0) {
+      char * copy = (char *)csv_arena_alloc_for_context(index->ctx, len, 1);
+      if (!copy) {
+        return GTEXT_CSV_E_OOM;
+      }
+      memcpy(copy, data, len);
+      key->data = copy;
+    }
+    key->length = len;
+    key->hash = hash;
+    key->rows = NULL;
+    key->row_count = 0;
+    key->row_capacity = 0;
+
+    size_t slot = hash & (index->bucket_count - 1);
+    key->next = index->buckets[slot];
+    index->buckets[slot] = key;
+    index->key_count++;
+    csv_index_grow_buckets(index);
+  }
+
+  // Row lists double in the arena; the abandoned copies add up to less than
+  // the final list
+  if (key->row_count == key->row_capacity) {
+    if (key->row_capacity > SIZE_MAX / 2 / sizeof(size_t)) {
+      return GTEXT_CSV_E_OOM;
+    }
+    size_t new_capacity = key->row_capacity ? key->row_capacity * 2 : 1;
+    size_t * rows = (size_t *)csv_arena_alloc_for_context(
+        index->ctx, new_capacity * sizeof(size_t), 8);
+    if (!rows) {
+      return GTEXT_CSV_E_OOM;
+    }
+    if (key->row_count > 0) {
+      memcpy(rows, key->rows, key->row_count * sizeof(size_t));
+    }
+    key->rows = rows;
+    key->row_capacity = new_capacity;
+  }
+  key->rows[key->row_count++] = row;
+  return GTEXT_CSV_OK;
+}
+
+// Position of the first entry of a key's row list that is at least row
+static size_t csv_index_lower_bound(const csv_index_key * key, size_t row) {
+  size_t lo = 0;
+  size_t hi = key->row_count;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (key->rows[mid] < row) {
+      lo = mid + 1;
+    }
+    else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Add a data row to the key of its value, keeping the row list ascending
+static GTEXT_CSV_Status csv_index_insert(csv_column_index * index,
+    const char * data, size_t len, size_t row) {
+  csv_index_key * key =
+      csv_index_find(index, data, len, csv_index_hash(data, len));
+  if (!key || key->row_count == 0 || key->rows[key->row_count - 1] < row) {
+    return csv_index_add(index, data, len, row);
+  }
+
+  // The list grows through csv_index_add() by appending its last entry
+  // again, then the tail moves up one to open the row's slot
+  size_t last = key->rows[key->row_count - 1];
+  GTEXT_CSV_Status status = csv_index_add(index, data, len, last);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+  size_t pos = csv_index_lower_bound(key, row);
+  memmove(&key->rows[pos + 1], &key->rows[pos],
+      (key->row_count - 1 - pos) * sizeof(size_t));
+  key->rows[pos] = row;
+  return GTEXT_CSV_OK;
+}
+
+// Remove a data row from the key of its value
+static void csv_index_unlink(
+    csv_column_index * index, const char * data, size_t len, size_t row) {
+  csv_index_key * key =
+      csv_index_find(index, data, len, csv_index_hash(data, len));
+  if (!key) {
+    return;
+  }
+  size_t pos = csv_index_lower_bound(key, row);
+  if (pos < key->row_count && key->rows[pos] == row) {
+    memmove(&key->rows[pos], &key->rows[pos + 1],
+        (key->row_count - pos - 1) * sizeof(size_t));
+    key->row_count--;
+  }
+}
+
+// Add delta to every indexed row number at or after first
+static void csv_index_shift(
+    csv_column_index * index, size_t first, ptrdiff_t delta) {
+  for (size_t b = 0; b < index->bucket_count; b++) {
+    for (csv_index_key * key = index->buckets[b]; key; key = key->next) {
+      for (size_t i = csv_index_lower_bound(key, first); i < key->row_count;
+           i++) {
+        key->rows[i] = (size_t)((ptrdiff_t)key->rows[i] + delta);
+      }
+    }
+  }
+}
+
+// Free an index's keys and buckets, leaving it stale
+static void csv_index_release(csv_column_index * index) {
+  csv_context_free(index->ctx);
+  free(index->buckets);
+  index->ctx = NULL;
+  index->buckets = NULL;
+  index->bucket_count = 0;
+  index->key_count = 0;
+  index->stale = true;
+}
+
+// (Re)build an index from every data row of a table
+// On failure the index is left stale
+static GTEXT_CSV_Status csv_index_build(
+    const GTEXT_CSV_Table * table, csv_column_index * index) {
+  csv_index_release(index);
+
+  index->ctx = csv_context_new();
+  index->buckets = (csv_index_key **)calloc(
+      CSV_INDEX_MIN_BUCKETS, sizeof(csv_index_key *));
+  if (!index->ctx || !index->buckets) {
+    csv_index_release(index);
+    return GTEXT_CSV_E_OOM;
+  }
+  index->bucket_count = CSV_INDEX_MIN_BUCKETS;
+
+  size_t start = csv_lookup_data_start(table);
+  for (size_t row_idx = start; row_idx < table->row_count; row_idx++) {
+    size_t len;
+    const char * data = csv_table_cell_at(table, row_idx, index->column, &len);
+    if (!data) {
+      continue;
+    }
+    GTEXT_CSV_Status status = csv_index_add(index, data, len, row_idx - start);
+    if (status != GTEXT_CSV_OK) {
+      csv_index_release(index);
+      return status;
+    }
+  }
+
+  index->stale = false;
+  return GTEXT_CSV_OK;
+}
+
+// The table's index on a column, or NULL
+static csv_column_index * csv_table_find_index(
+    const GTEXT_CSV_Table * table, size_t col) {
+  for (csv_column_index * index = table->column_indexes; index;
+       index = index->next) {
+    if (index->column == col) {
+      return index;
+    }
+  }
+  return NULL;
+}
+
+GTEXT_INTERNAL_API void csv_table_indexes_row_appended(
+    GTEXT_CSV_Table * table) {
+  size_t start = csv_lookup_data_start(table);
+  for (csv_column_index * index = table->column_indexes; index;
+       index = index->next) {
+    if (index->stale) {
+      continue;
+    }
+    // The first row of a table with a header is the header itself
+    if (table->row_count <= start) {
+      csv_index_release(index);
+      continue;
+    }
+    size_t row_idx = table->row_count - 1;
+    size_t len;
+    const char * data = csv_table_cell_at(table, row_idx, index->column, &len);
+    if (data &&
+        csv_index_add(index, data, len, row_idx - start) != GTEXT_CSV_OK) {
+      csv_index_release(index);
+    }
+  }
+}
+
+GTEXT_INTERNAL_API void csv_table_indexes_row_unlink(
+    GTEXT_CSV_Table * table, size_t row) {
+  size_t row_idx = row + csv_lookup_data_start(table);
+  for (csv_column_index * index = table->column_indexes; index;
+       index = index->next) {
+    if (index->stale) {
+      continue;
+    }
+    size_t len;
+    const char * data = csv_table_cell_at(table, row_idx, index->column, &len);
+    if (data) {
+      csv_index_unlink(index, data, len, row);
+    }
+  }
+}
+
+GTEXT_INTERNAL_API void csv_table_indexes_row_link(
+    GTEXT_CSV_Table * table, size_t row) {
+  size_t start = csv_lookup_data_start(table);
+  for (csv_column_index * index = table->column_indexes; index;
+       index = index->next) {
+    if (index->stale) {
+      continue;
+    }
+    size_t len;
+    const char * data =
+        csv_table_cell_at(table, row + start, index->column, &len);
+    if (data && csv_index_insert(index, data, len, row) != GTEXT_CSV_OK) {
+      csv_index_release(index);
+    }
+  }
+}
+
+GTEXT_INTERNAL_API void csv_table_indexes_row_inserted(
+    GTEXT_CSV_Table * table, size_t row) {
+  // The first row of a table with a header is the header itself
+  if (table->row_count <= csv_lookup_data_start(table)) {
+    csv_table_indexes_invalidate(table, SIZE_MAX);
+    return;
+  }
+  for (csv_column_index * index = table->column_indexes; index;
+       index = index->next) {
+    if (!index->stale) {
+      csv_index_shift(index, row, 1);
+    }
+  }
+  csv_table_indexes_row_link(table, row);
+}
+
+GTEXT_INTERNAL_API void csv_table_indexes_row_removing(
+    GTEXT_CSV_Table * table, size_t row) {
+  csv_table_indexes_row_unlink(table, row);
+  for (csv_column_index * index = table->column_indexes; index;
+       index = index->next) {
+    if (!index->stale) {
+      csv_index_shift(index, row + 1, -1);
+    }
+  }
+}
+
+GTEXT_INTERNAL_API void csv_table_indexes_invalidate(
+    GTEXT_CSV_Table * table, size_t col) {
+  for (csv_column_index * index = table->column_indexes; index;
+       index = index->next) {
+    if (col == SIZE_MAX || index->column == col) {
+      csv_index_release(index);
+    }
+  }
+}
+
+GTEXT_INTERNAL_API void csv_table_indexes_column_inserted(
+    GTEXT_CSV_Table * table, size_t col) {
+  for (csv_column_index * index = table->column_indexes; index;
+       index = index->next) {
+    if (index->column >= col) {
+      index->column++;
+    }
+    if (table->allow_irregular_rows) {
+      csv_index_release(index);
+    }
+  }
+}
+
+GTEXT_INTERNAL_API void csv_table_indexes_column_removed(
+    GTEXT_CSV_Table * table, size_t col) {
+  csv_column_index ** link = &table->column_indexes;
+  while (*link) {
+    csv_column_index * index = *link;
+    if (index->column == col) {
+      *link = index->next;
+      csv_index_release(index);
+      free(index);
+      continue;
+    }
+    if (index->column > col) {
+      index->column--;
+    }
+    link = &index->next;
+  }
+}
+
+GTEXT_INTERNAL_API void csv_table_indexes_free(GTEXT_CSV_Table * table) {
+  csv_column_index * index = table->column_indexes;
+  while (index) {
+    csv_column_index * next = index->next;
+    csv_index_release(index);
+    free(index);
+    index = next;
+  }
+  table->column_indexes = NULL;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_build_index(
+    GTEXT_CSV_Table * table, size_t col) {
+  if (!table) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  csv_column_index * index = csv_table_find_index(table, col);
+  if (index) {
+    return csv_index_build(table, index);
+  }
+
+  index = (csv_column_index *)calloc(1, sizeof(csv_column_index));
+  if (!index) {
+    return GTEXT_CSV_E_OOM;
+  }
+  index->column = col;
+  GTEXT_CSV_Status status = csv_index_build(table, index);
+  if (status != GTEXT_CSV_OK) {
+    free(index);
+    return status;
+  }
+  index->next = table->column_indexes;
+  table->column_indexes = index;
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_drop_index(
+    GTEXT_CSV_Table * table, size_t col) {
+  if (!table) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  for (csv_column_index ** link = &table->column_indexes; *link;
+       link = &(*link)->next) {
+    csv_column_index * index = *link;
+    if (index->column == col) {
+      *link = index->next;
+      csv_index_release(index);
+      free(index);
+      return GTEXT_CSV_OK;
+    }
+  }
+  return GTEXT_CSV_E_INVALID;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_lookup(GTEXT_CSV_Table * table,
+    size_t col, const char * value, size_t value_len, const size_t ** rows,
+    size_t * count) {
+  if (!table || !rows || !count || (!value && value_len > 0)) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  csv_column_index * index = csv_table_find_index(table, col);
+  if (!index) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  if (index->stale) {
+    GTEXT_CSV_Status status = csv_index_build(table, index);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+  }
+
+  csv_index_key * key = csv_index_find(
+      index, value, value_len, csv_index_hash(value, value_len));
+  *rows = key ? key->rows : NULL;
+  *count = key ? key->row_count : 0;
+  return GTEXT_CSV_OK;
+}
+
+// Create the result table of a join, with a header row when both inputs
+// have one. The header may repeat names (a key column named alike on both
+// sides, or padding columns), so it is built as a first row and promoted the
+// way a parsed header is: a name lookup finds its first column.
+static GTEXT_CSV_Table * csv_join_new_table(const GTEXT_CSV_Table * left,
+    size_t left_width, const GTEXT_CSV_Table * right, size_t right_width,
+    GTEXT_CSV_Error * err) {
+  size_t width = left_width + right_width;
+  GTEXT_CSV_Table * result = gtext_csv_new_table();
+  if (!result) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to allocate join result");
+    return NULL;
+  }
+  if (!left->has_header || !right->has_header || left->row_count == 0 ||
+      right->row_count == 0 || width == 0) {
+    return result;
+  }
+
+  const char ** names = (const char **)malloc(sizeof(const char *) * width);
+  size_t * lengths = (size_t *)malloc(sizeof(size_t) * width);
+  GTEXT_CSV_Status status = GTEXT_CSV_E_OOM;
+  if (!names || !lengths) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to allocate join header");
+  }
+  else {
+    for (size_t i = 0; i < width; i++) {
+      const GTEXT_CSV_Table * side = i < left_width ? left : right;
+      size_t col = i < left_width ? i : i - left_width;
+      names[i] = csv_table_cell_at(side, 0, col, &lengths[i]);
+      if (!names[i]) {
+        names[i] = csv_index_empty_key;
+      }
+    }
+    status = gtext_csv_row_append(result, names, lengths, width, err);
+    if (status == GTEXT_CSV_OK) {
+      status = gtext_csv_set_header_row(result, true);
+      if (status != GTEXT_CSV_OK) {
+        CSV_SET_ERROR(err, status, "Failed to set join header");
+      }
+    }
+  }
+  free(names);
+  free(lengths);
+  if (status != GTEXT_CSV_OK) {
+    gtext_csv_free_table(result);
+    result = NULL;
+  }
+  return result;
+}
+
+// Copy a row's fields into a join row, padding with empty fields to width
+static void csv_join_fill(const GTEXT_CSV_Table * table, size_t row_idx,
+    size_t width, const char ** fields, size_t * lengths) {
+  for (size_t col = 0; col < width; col++) {
+    fields[col] = csv_table_cell_at(table, row_idx, col, &lengths[col]);
+    if (!fields[col]) {
+      fields[col] = csv_index_empty_key;
+    }
+  }
+}
+
+GTEXT_API GTEXT_CSV_Table * gtext_csv_hash_join(GTEXT_CSV_Table * left,
+    size_t left_col, GTEXT_CSV_Table * right, size_t right_col,
+    GTEXT_CSV_Error * err) {
+  if (!left || !right) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Tables must not be NULL");
+    return NULL;
+  }
+
+  // Probe the right table's own index, or a temporary one
+  csv_column_index temp_index = {0};
+  csv_column_index * index = csv_table_find_index(right, right_col);
+  if (!index) {
+    temp_index.column = right_col;
+    temp_index.stale = true;
+    index = &temp_index;
+  }
+  if (index->stale && csv_index_build(right, index) != GTEXT_CSV_OK) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to build join index");
+    return NULL;
+  }
+
+  size_t left_width = gtext_csv_max_col_count(left);
+  size_t right_width = gtext_csv_max_col_count(right);
+  size_t width = left_width + right_width;
+  GTEXT_CSV_Table * result =
+      csv_join_new_table(left, left_width, right, right_width, err);
+  const char ** fields =
+      (const char **)malloc(sizeof(const char *) * (width ? width : 1));
+  size_t * lengths = (size_t *)malloc(sizeof(size_t) * (width ? width : 1));
+  if (result && (!fields || !lengths)) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to allocate join result");
+    gtext_csv_free_table(result);
+    result = NULL;
+  }
+
+  size_t left_start = csv_lookup_data_start(left);
+  size_t right_start = csv_lookup_data_start(right);
+  for (size_t row_idx = left_start; result && row_idx < left->row_count;
+       row_idx++) {
+    size_t key_len;
+    const char * key = csv_table_cell_at(left, row_idx, left_col, &key_len);
+    csv_index_key * match =
+        key ? csv_index_find(index, key, key_len, csv_index_hash(key, key_len))
+            : NULL;
+    if (!match) {
+      continue;
+    }
+
+    csv_join_fill(left, row_idx, left_width, fields, lengths);
+    for (size_t m = 0; m < match->row_count; m++) {
+      csv_join_fill(right, right_start + match->rows[m], right_width,
+          fields + left_width, lengths + left_width);
+      GTEXT_CSV_Status status =
+          gtext_csv_row_append(result, fields, lengths, width, err);
+      if (status != GTEXT_CSV_OK) {
+        gtext_csv_free_table(result);
+        result = NULL;
+        break;
+      }
+    }
+  }
+
+  free(fields);
+  free(lengths);
+  if (index == &temp_index) {
+    csv_index_release(&temp_index);
+  }
+  return result;
+}
@@ -0,0 +1,489 @@
+/**
+ * @file
+ *
+ * Batch row reader implementation.
+ *
+ * Runs the streaming parser over the input a slice at a time and queues the
+ * resulting fields as spans, then hands complete rows out in caller-sized
+ * batches. The parser emits fields inside the input window in place; the
+ * queue keeps those as input offsets and copies only fields the parser had to
+ * buffer.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csv_internal.h"
+
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_stream.h>
+
+/**
+ * @brief Bytes fed to the stream parser at a time
+ *
+ * Rows completed past the requested batch size wait in the reader's queue,
+ * so this also bounds how far a reader parses ahead of its caller.
+ */
+#define CSV_READER_SLICE_BYTES 16384
+
+/**
+ * @brief Initial size of the input window of a callback reader
+ */
+#define CSV_READER_WINDOW_INITIAL_SIZE 65536
+
+/**
+ * @brief A queued field
+ *
+ * Offsets are absolute input offsets for fields in the input, or offsets
+ * into the queue heap for copied fields.
+ */
+typedef struct {
+  size_t offset;
+  size_t length;
+  bool in_heap;
+} csv_reader_span;
+
+struct GTEXT_CSV_Reader {
+  GTEXT_CSV_Stream * stream; ///< Parser producing the queued rows
+
+  // Input
+  GTEXT_CSV_Read_Function read; ///< Read callback (NULL for memory input)
+  void * read_user;             ///< User context passed to read
+  const char * window;          ///< Input bytes (caller buffer or window_buf)
+  char * window_buf;            ///< Owned window of a callback reader
+  size_t window_size;           ///< Allocated size of window_buf
+  size_t window_len;            ///< Bytes of input in the window
+  size_t window_base;           ///< Input offset of window[0]
+  size_t fed;                   ///< Window bytes already fed to the parser
+  bool eof;                     ///< No more input beyond the window
+  bool finished;                ///< Parser has seen the end of input
+
+  // Queue of parsed fields (the last row may still be in progress)
+  csv_reader_span * fields;
+  size_t field_count;
+  size_t field_capacity;
+  size_t * row_ends; ///< Field count after each complete row
+  size_t row_count;
+  size_t row_capacity;
+  char * heap; ///< Copied field bytes
+  size_t heap_used;
+  size_t heap_size;
+
+  // Sticky error
+  GTEXT_CSV_Status status;
+  GTEXT_CSV_Error error;
+};
+
+struct GTEXT_CSV_Batch {
+  GTEXT_CSV_Field_Span * fields;
+  size_t field_capacity;
+  size_t * row_starts; ///< row_count + 1 entries into fields
+  size_t row_capacity;
+  size_t row_count;
+  char * heap; ///< Copied field bytes
+  size_t heap_size;
+};
+
+// Target of empty fields, so every span has a non-NULL data pointer
+static const char csv_reader_empty_field[] = "";
+
+// Grow an array to hold at least needed elements of elem_size bytes
+static GTEXT_CSV_Status csv_reader_reserve(
+    void ** array, size_t * capacity, size_t needed, size_t elem_size) {
+  if (needed <= *capacity) {
+    return GTEXT_CSV_OK;
+  }
+  size_t new_capacity = *capacity ? *capacity : 16;
+  while (new_capacity < needed) {
+    if (new_capacity > SIZE_MAX / 2 / elem_size) {
+      return GTEXT_CSV_E_OOM;
+    }
+    new_capacity *= 2;
+  }
+  void * grown = realloc(*array, new_capacity * elem_size);
+  if (!grown) {
+    return GTEXT_CSV_E_OOM;
+  }
+  *array = grown;
+  *capacity = new_capacity;
+  return GTEXT_CSV_OK;
+}
+
+// Queue one field, copying it unless it lies in the input window
+static GTEXT_CSV_Status csv_reader_queue_field(
+    GTEXT_CSV_Reader * reader, const char * data, size_t len) {
+  if (csv_reader_reserve((void **)&reader->fields, &reader->field_capacity,
+          reader->field_count + 1, sizeof(csv_reader_span)) != GTEXT_CSV_OK) {
+    return GTEXT_CSV_E_OOM;
+  }
+  csv_reader_span * span = &reader->fields[reader->field_count];
+  span->length = len;
+  span->in_heap = false;
+  span->offset = 0;
+
+  if (len > 0 && data >= reader->window) {
+    size_t offset = (size_t)(data - reader->window);
+    if (offset <= reader->window_len && len <= reader->window_len - offset) {
+      span->offset = reader->window_base + offset;
+      reader->field_count++;
+      return GTEXT_CSV_OK;
+    }
+  }
+
+  if (len > 0) {
+    if (len > SIZE_MAX - reader->heap_used ||
+        csv_reader_reserve((void **)&reader->heap, &reader->heap_size,
+            reader->heap_used + len, 1) != GTEXT_CSV_OK) {
+      return GTEXT_CSV_E_OOM;
+    }
+    memcpy(reader->heap + reader->heap_used, data, len);
+    span->offset = reader->heap_used;
+    span->in_heap = true;
+    reader->heap_used += len;
+  }
+  reader->field_count++;
+  return GTEXT_CSV_OK;
+}
+
+// Stream callback: queue fields and mark where each row ends
+static GTEXT_CSV_Status csv_reader_event_callback(
+    const GTEXT_CSV_Event * event, void * user_data) {
+  GTEXT_CSV_Reader * reader = (GTEXT_CSV_Reader *)user_data;
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+
+  switch (event->type) {
+  case GTEXT_CSV_EVENT_FIELD:
+    status = csv_reader_queue_field(reader, event->data, event->data_len);
+    break;
+  case GTEXT_CSV_EVENT_RECORD_END:
+    status = csv_reader_reserve((void **)&reader->row_ends,
+        &reader->row_capacity, reader->row_count + 1, sizeof(size_t));
+    if (status == GTEXT_CSV_OK) {
+      reader->row_ends[reader->row_count++] = reader->field_count;
+    }
+    break;
+  case GTEXT_CSV_EVENT_RECORD_BEGIN:
+  case GTEXT_CSV_EVENT_END:
+    break;
+  }
+
+  if (status != GTEXT_CSV_OK) {
+    reader->status = status;
+  }
+  return status;
+}
+
+// Record a failure so every later call reports it
+static void csv_reader_fail(
+    GTEXT_CSV_Reader * reader, GTEXT_CSV_Status status) {
+  // The stream reports its own errors; a callback failure only has a status
+  if (reader->status != GTEXT_CSV_OK || reader->error.code == GTEXT_CSV_OK) {
+    gtext_csv_error_free(&reader->error);
+    CSV_SET_ERROR(&reader->error, status,
+        status == GTEXT_CSV_E_OOM ? "Out of memory while reading batch"
+                                  : "Read callback failed");
+  }
+  reader->status = status;
+}
+
+// Make room for more input and read it, keeping every window byte a queued
+// field still points at
+static GTEXT_CSV_Status csv_reader_fill_window(GTEXT_CSV_Reader * reader) {
+  size_t keep = reader->window_len;
+  for (size_t i = 0; i < reader->field_count; i++) {
+    if (!reader->fields[i].in_heap && reader->fields[i].length > 0) {
+      keep = reader->fields[i].offset - reader->window_base;
+      break;
+    }
+  }
+  memmove(reader->window_buf, reader->window_buf + keep,
+      reader->window_len - keep);
+  reader->window_len -= keep;
+  reader->fed -= keep;
+  reader->window_base += keep;
+
+  if (reader->window_size - reader->window_len < CSV_READER_SLICE_BYTES) {
+    size_t size = reader->window_size * 2;
+    if (reader->window_size > SIZE_MAX / 2) {
+      return GTEXT_CSV_E_OOM;
+    }
+    char * grown = (char *)realloc(reader->window_buf, size);
+    if (!grown) {
+      return GTEXT_CSV_E_OOM;
+    }
+    reader->window_buf = grown;
+    reader->window_size = size;
+  }
+  reader->window = reader->window_buf;
+
+  size_t got = 0;
+  GTEXT_CSV_Status status = reader->read(reader->read_user,
+      reader->window_buf + reader->window_len,
+      reader->window_size - reader->window_len, &got);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+  if (got == 0) {
+    reader->eof = true;
+  }
+  reader->window_len += got;
+  csv_stream_set_emit_window(
+      reader->stream, reader->window, reader->window_len);
+  return GTEXT_CSV_OK;
+}
+
+// Feed the next slice of input, reading more or finishing the parse when the
+// window is used up
+static GTEXT_CSV_Status csv_reader_advance(GTEXT_CSV_Reader * reader) {
+  if (reader->fed == reader->window_len) {
+    if (reader->eof) {
+      reader->finished = true;
+      return gtext_csv_stream_finish(reader->stream, &reader->error);
+    }
+    return csv_reader_fill_window(reader);
+  }
+
+  size_t len = reader->window_len - reader->fed;
+  if (len > CSV_READER_SLICE_BYTES) {
+    len = CSV_READER_SLICE_BYTES;
+  }
+  const char * slice = reader->window + reader->fed;
+  reader->fed += len;
+  return gtext_csv_stream_feed(reader->stream, slice, len, &reader->error);
+}
+
+// Create a reader with its parser; the caller sets up the input
+static GTEXT_CSV_Reader * csv_reader_create(
+    const GTEXT_CSV_Parse_Options * opts) {
+  GTEXT_CSV_Reader * reader =
+      (GTEXT_CSV_Reader *)calloc(1, sizeof(GTEXT_CSV_Reader));
+  if (!reader) {
+    return NULL;
+  }
+  reader->stream =
+      gtext_csv_stream_new(opts, csv_reader_event_callback, reader);
+  if (!reader->stream) {
+    free(reader);
+    return NULL;
+  }
+  return reader;
+}
+
+GTEXT_API GTEXT_CSV_Reader * gtext_csv_reader_new(
+    const GTEXT_CSV_Parse_Options * opts, const void * data, size_t len) {
+  if (!data && len > 0) {
+    return NULL;
+  }
+  GTEXT_CSV_Reader * reader = csv_reader_create(opts);
+  if (!reader) {
+    return NULL;
+  }
+  reader->window = data ? (const char *)data : csv_reader_empty_field;
+  reader->window_len = len;
+  reader->eof = true;
+  csv_stream_set_emit_window(reader->stream, reader->window, len);
+  return reader;
+}
+
+GTEXT_API GTEXT_CSV_Reader * gtext_csv_reader_new_source(
+    const GTEXT_CSV_Parse_Options * opts, GTEXT_CSV_Read_Function read,
+    void * user) {
+  if (!read) {
+    return NULL;
+  }
+  GTEXT_CSV_Reader * reader = csv_reader_create(opts);
+  if (!reader) {
+    return NULL;
+  }
+  reader->window_buf = (char *)malloc(CSV_READER_WINDOW_INITIAL_SIZE);
+  if (!reader->window_buf) {
+    gtext_csv_reader_free(reader);
+    return NULL;
+  }
+  reader->window = reader->window_buf;
+  reader->window_size = CSV_READER_WINDOW_INITIAL_SIZE;
+  reader->read = read;
+  reader->read_user = user;
+  return reader;
+}
+
+// Move the first row_count queued rows into the batch and drop them from the
+// queue
+static GTEXT_CSV_Status csv_reader_take_rows(
+    GTEXT_CSV_Reader * reader, GTEXT_CSV_Batch * batch, size_t row_count) {
+  size_t field_count = row_count > 0 ? reader->row_ends[row_count - 1] : 0;
+
+  // Size everything first so the batch heap does not move while spans are
+  // pointed into it
+  size_t heap_len = 0;
+  for (size_t i = 0; i < field_count; i++) {
+    if (reader->fields[i].in_heap) {
+      heap_len += reader->fields[i].length;
+    }
+  }
+  if (csv_reader_reserve((void **)&batch->fields, &batch->field_capacity,
+          field_count, sizeof(GTEXT_CSV_Field_Span)) != GTEXT_CSV_OK ||
+      csv_reader_reserve((void **)&batch->row_starts, &batch->row_capacity,
+          row_count + 1, sizeof(size_t)) != GTEXT_CSV_OK ||
+      csv_reader_reserve((void **)&batch->heap, &batch->heap_size, heap_len,
+          1) != GTEXT_CSV_OK) {
+    return GTEXT_CSV_E_OOM;
+  }
+
+  size_t heap_used = 0;
+  for (size_t i = 0; i < field_count; i++) {
+    const csv_reader_span * span = &reader->fields[i];
+    GTEXT_CSV_Field_Span * out = &batch->fields[i];
+    out->length = span->length;
+    if (span->length == 0) {
+      out->data = csv_reader_empty_field;
+    }
+    else if (span->in_heap) {
+      memcpy(batch->heap + heap_used, reader->heap + span->offset,
+          span->length);
+      out->data = batch->heap + heap_used;
+      heap_used += span->length;
+    }
+    else {
+      out->data = reader->window + (span->offset - reader->window_base);
+    }
+  }
+  batch->row_starts[0] = 0;
+  for (size_t r = 0; r < row_count; r++) {
+    batch->row_starts[r + 1] = reader->row_ends[r];
+  }
+  batch->row_count = row_count;
+
+  // Drop the taken rows; the queued heap bytes after them move to the front
+  size_t heap_keep = reader->heap_used;
+  for (size_t i = field_count; i < reader->field_count; i++) {
+    if (reader->fields[i].in_heap) {
+      heap_keep = reader->fields[i].offset;
+      break;
+    }
+  }
+  if (heap_keep < reader->heap_used) {
+    memmove(reader->heap, reader->heap + heap_keep,
+        reader->heap_used - heap_keep);
+  }
+  reader->heap_used -= heap_keep;
+
+  if (field_count < reader->field_count) {
+    memmove(reader->fields, reader->fields + field_count,
+        sizeof(csv_reader_span) * (reader->field_count - field_count));
+  }
+  reader->field_count -= field_count;
+  for (size_t i = 0; i < reader->field_count; i++) {
+    if (reader->fields[i].in_heap) {
+      reader->fields[i].offset -= heap_keep;
+    }
+  }
+  if (row_count < reader->row_count) {
+    memmove(reader->row_ends, reader->row_ends + row_count,
+        sizeof(size_t) * (reader->row_count - row_count));
+  }
+  reader->row_count -= row_count;
+  for (size_t r = 0; r < reader->row_count; r++) {
+    reader->row_ends[r] -= field_count;
+  }
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_reader_next_batch(
+    GTEXT_CSV_Reader * reader, GTEXT_CSV_Batch * batch, size_t max_rows,
+    GTEXT_CSV_Error * err) {
+  if (!reader || !batch || max_rows == 0) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID,
+        "Reader and batch must not be NULL and max_rows must be > 0");
+    return GTEXT_CSV_E_INVALID;
+  }
+  batch->row_count = 0;
+
+  while (reader->status == GTEXT_CSV_OK && reader->row_count < max_rows &&
+      !reader->finished) {
+    GTEXT_CSV_Status status = csv_reader_advance(reader);
+    if (status != GTEXT_CSV_OK) {
+      csv_reader_fail(reader, status);
+    }
+  }
+
+  // Rows completed before an error are handed out first
+  if (reader->status != GTEXT_CSV_OK && reader->row_count == 0) {
+    if (err) {
+      csv_error_copy(err, &reader->error);
+    }
+    return reader->status;
+  }
+
+  size_t take = reader->row_count < max_rows ? reader->row_count : max_rows;
+  if (csv_reader_take_rows(reader, batch, take) != GTEXT_CSV_OK) {
+    // The queue is untouched, so a later call can retry
+    batch->row_count = 0;
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Out of memory while filling batch");
+    return GTEXT_CSV_E_OOM;
+  }
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_API void gtext_csv_reader_free(GTEXT_CSV_Reader * reader) {
+  if (!reader) {
+    return;
+  }
+  gtext_csv_stream_free(reader->stream);
+  free(reader->window_buf);
+  free(reader->fields);
+  free(reader->row_ends);
+  free(reader->heap);
+  gtext_csv_error_free(&reader->error);
+  free(reader);
+}
+
+GTEXT_API GTEXT_CSV_Batch * gtext_csv_batch_new(void) {
+  return (GTEXT_CSV_Batch *)calloc(1, sizeof(GTEXT_CSV_Batch));
+}
+
+GTEXT_API void gtext_csv_batch_free(GTEXT_CSV_Batch * batch) {
+  if (!batch) {
+    return;
+  }
+  free(batch->fields);
+  free(batch->row_starts);
+  free(batch->heap);
+  free(batch);
+}
+
+GTEXT_API size_t gtext_csv_batch_row_count(const GTEXT_CSV_Batch * batch) {
+  return batch ? batch->row_count : 0;
+}
+
+GTEXT_API const GTEXT_CSV_Field_Span * gtext_csv_batch_row(
+    const GTEXT_CSV_Batch * batch, size_t row, size_t * field_count_out) {
+  if (!batch || row >= batch->row_count) {
+    if (field_count_out) {
+      *field_count_out = 0;
+    }
+    return NULL;
+  }
+  if (field_count_out) {
+    *field_count_out = batch->row_starts[row + 1] - batch->row_starts[row];
+  }
+  return batch->fields + batch->row_starts[row];
+}
+
+GTEXT_API const char * gtext_csv_batch_field(const GTEXT_CSV_Batch * batch,
+    size_t row, size_t col, size_t * len) {
+  size_t field_count = 0;
+  const GTEXT_CSV_Field_Span * fields =
+      gtext_csv_batch_row(batch, row, &field_count);
+  if (!fields || col >= field_count) {
+    return NULL;
+  }
+  if (len) {
+    *len = fields[col].length;
+  }
+  return fields[col].data;
+}
@@ -0,0 +1,485 @@
+/**
+ * @file
+ *
+ * CSV dialect detection implementation.
+ *
+ * One pass over the sample drives a small record splitter for every
+ * delimiter/quote pair at once, jumping between the bytes any of them cares
+ * about. Each splitter notes how many fields its records have and how often
+ * a quote turns up where it can neither open nor close a field; the pair
+ * whose records agree best wins. The header check then parses the first few
+ * records with the winning dialect.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../text_simd.h"
+#include "csv_internal.h"
+
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_sniff.h>
+#include <ghoti.io/text/csv/csv_table.h>
+
+/**
+ * @brief Bytes of input examined
+ */
+#define CSV_SNIFF_SAMPLE_BYTES 65536
+
+/**
+ * @brief Records kept per candidate (the scan stops when all are full)
+ */
+#define CSV_SNIFF_MAX_RECORDS 1024
+
+/**
+ * @brief Records parsed by the header check
+ */
+#define CSV_SNIFF_HEAD_RECORDS 20
+
+/**
+ * @brief Records needed before a consistent sample gets full confidence
+ */
+#define CSV_SNIFF_CONFIDENT_RECORDS 10
+
+/**
+ * @brief Marks a record count whose line starts with the comment character
+ */
+#define CSV_SNIFF_COMMENT_BIT UINT32_C(0x80000000)
+
+#define CSV_SNIFF_DELIMITERS 4
+#define CSV_SNIFF_QUOTES 2
+#define CSV_SNIFF_CANDIDATES (CSV_SNIFF_DELIMITERS * CSV_SNIFF_QUOTES)
+
+static const unsigned char csv_sniff_delimiters[CSV_SNIFF_DELIMITERS] = {
+    ',', ';', '\t', '|'};
+static const unsigned char csv_sniff_quotes[CSV_SNIFF_QUOTES] = {'"', '\''};
+
+// Every byte a candidate reacts to
+static const unsigned char csv_sniff_specials[] = {
+    ',', ';', '\t', '|', '"', '\'', '\n', '\r'};
+
+// Record splitter for one delimiter/quote pair
+typedef struct {
+  unsigned char delimiter; // Candidate delimiter
+  unsigned char quote;     // Candidate quote character
+  bool in_quote;           // Inside a quoted field
+  bool comment;            // Current record starts with '#'
+  size_t skip;             // Offset of the second quote of a doubled pair
+  size_t record_start;     // Offset where the current record began
+  size_t fields;           // Fields seen so far in the current record
+  uint32_t * counts;       // Field count of each record (+ COMMENT_BIT)
+  size_t record_count;     // Entries in counts
+  size_t quoted;           // Quoted fields opened
+  size_t doubled;          // Doubled quotes inside quoted fields
+  size_t backslashed;      // Backslash-escaped quotes inside quoted fields
+  size_t misplaced;        // Quotes that can neither open nor close a field
+  size_t head_end;         // Offset just past the first HEAD_RECORDS records
+} csv_sniff_candidate;
+
+// How well a candidate's records agree
+typedef struct {
+  double score;   // 0 to 1, higher is better
+  size_t columns; // Most common field count
+  size_t records; // Records the field counts were taken from
+  bool comments;  // Lines starting with '#' are comments
+} csv_sniff_score;
+
+// End the current record of a candidate at offset end; the next record
+// starts at next
+// Blank lines are not records
+static void csv_sniff_end_record(csv_sniff_candidate * cand,
+    const unsigned char * s, size_t end, size_t next, size_t len) {
+  if ((end > cand->record_start || cand->fields > 1) &&
+      cand->record_count < CSV_SNIFF_MAX_RECORDS) {
+    uint32_t count = cand->fields < CSV_SNIFF_COMMENT_BIT
+        ? (uint32_t)cand->fields
+        : CSV_SNIFF_COMMENT_BIT - 1;
+    if (cand->comment) {
+      count |= CSV_SNIFF_COMMENT_BIT;
+    }
+    cand->counts[cand->record_count++] = count;
+    if (cand->record_count <= CSV_SNIFF_HEAD_RECORDS) {
+      cand->head_end = next;
+    }
+  }
+  cand->record_start = next;
+  cand->fields = 1;
+  cand->comment = next < len && s[next] == '#';
+}
+
+// Feed a delimiter or quote byte at offset i to a candidate
+static void csv_sniff_scan_byte(
+    csv_sniff_candidate * cand, const unsigned char * s, size_t i, size_t len) {
+  unsigned char c = s[i];
+  if (c == cand->delimiter) {
+    if (!cand->in_quote) {
+      cand->fields++;
+    }
+    return;
+  }
+  if (c != cand->quote || cand->comment || i == cand->skip) {
+    return;
+  }
+
+  if (cand->in_quote) {
+    if (s[i - 1] == '\\') {
+      cand->backslashed++;
+    }
+    else if (i + 1 < len && s[i + 1] == c) {
+      cand->doubled++;
+      cand->skip = i + 1;
+    }
+    else {
+      // A closing quote is followed by a delimiter or the end of the record
+      cand->in_quote = false;
+      if (i + 1 < len && s[i + 1] != cand->delimiter && s[i + 1] != '\n' &&
+          s[i + 1] != '\r') {
+        cand->misplaced++;
+      }
+    }
+  }
+  else if (i == cand->record_start || s[i - 1] == cand->delimiter) {
+    cand->in_quote = true;
+    cand->quoted++;
+  }
+  else {
+    cand->misplaced++;
+  }
+}
+
+static int csv_sniff_compare_counts(const void * a, const void * b) {
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+// Most common value of sorted counts (the larger one on a tie)
+static uint32_t csv_sniff_mode(
+    const uint32_t * counts, size_t count, size_t * frequency) {
+  uint32_t mode = 0;
+  size_t best = 0;
+  for (size_t i = 0; i < count;) {
+    size_t run = 1;
+    while (i + run < count && counts[i + run] == counts[i]) {
+      run++;
+    }
+    if (run >= best) {
+      mode = counts[i];
+      best = run;
+    }
+    i += run;
+  }
+  *frequency = best;
+  return mode;
+}
+
+// Score a candidate by how consistent its field counts are and how well its
+// quotes fit
+// Lines starting with '#' are treated as data when they have the usual
+// field count, and as comments otherwise
+static csv_sniff_score csv_sniff_score_candidate(
+    const csv_sniff_candidate * cand, uint32_t * scratch) {
+  csv_sniff_score result = {0.0, 0, 0, false};
+  size_t data = 0;
+  for (size_t r = 0; r < cand->record_count; r++) {
+    if (!(cand->counts[r] & CSV_SNIFF_COMMENT_BIT)) {
+      scratch[data++] = cand->counts[r];
+    }
+  }
+
+  size_t matches = 0;
+  uint32_t mode = 0;
+  if (data > 0) {
+    qsort(scratch, data, sizeof(uint32_t), csv_sniff_compare_counts);
+    mode = csv_sniff_mode(scratch, data, &matches);
+    for (size_t r = 0; r < cand->record_count; r++) {
+      uint32_t count = cand->counts[r];
+      if ((count & CSV_SNIFF_COMMENT_BIT) &&
+          (count & ~CSV_SNIFF_COMMENT_BIT) != mode) {
+        result.comments = true;
+      }
+    }
+  }
+  if (!result.comments) {
+    // Every record counts, with the comment marks dropped
+    for (size_t r = 0; r < cand->record_count; r++) {
+      scratch[r] = cand->counts[r] & ~CSV_SNIFF_COMMENT_BIT;
+    }
+    data = cand->record_count;
+    qsort(scratch, data, sizeof(uint32_t), csv_sniff_compare_counts);
+    mode = csv_sniff_mode(scratch, data, &matches);
+  }
+  if (data == 0) {
+    return result;
+  }
+
+  double consistency = (double)matches / (double)data;
+  double quoting =
+      (double)(cand->quoted + 1) / (double)(cand->quoted + cand->misplaced + 1);
+  result.score = consistency * quoting * (mode > 1 ? 1.0 : 0.25);
+  result.columns = mode;
+  result.records = data;
+  return result;
+}
+
+// Whether the first parsed record looks like a row of column names
+// Columns whose other values are all numbers, or all one length, vote for a
+// header when the first value breaks the pattern and against it otherwise
+static bool csv_sniff_header_votes(const GTEXT_CSV_Table * table) {
+  size_t rows = gtext_csv_row_count(table);
+  size_t cols = gtext_csv_col_count(table, 0);
+  long votes = 0;
+  for (size_t col = 0; col < cols; col++) {
+    bool numeric = true;
+    bool same_length = true;
+    size_t length = 0;
+    size_t values = 0;
+    double number = 0.0;
+    for (size_t row = 1; row < rows; row++) {
+      if (col >= gtext_csv_col_count(table, row)) {
+        continue;
+      }
+      size_t len = 0;
+      const char * value = gtext_csv_field(table, row, col, &len);
+      if (len == 0 ||
+          csv_convert_parse_f64(value, len, &number) != GTEXT_CSV_OK) {
+        numeric = false;
+      }
+      if (values > 0 && len != length) {
+        same_length = false;
+      }
+      length = len;
+      values++;
+    }
+    if (values == 0) {
+      continue;
+    }
+
+    size_t head_len = 0;
+    const char * head = gtext_csv_field(table, 0, col, &head_len);
+    if (numeric) {
+      bool head_numeric = head_len > 0 &&
+          csv_convert_parse_f64(head, head_len, &number) == GTEXT_CSV_OK;
+      votes += head_numeric ? -1 : 1;
+    }
+    else if (same_length) {
+      votes += head_len != length ? 1 : -1;
+    }
+  }
+  return votes > 0;
+}
+
+// Run the header check on the first records of the sample
+// *parsed is false when the records do not parse with the dialect
+static GTEXT_CSV_Status csv_sniff_header(const char * input, size_t len,
+    const GTEXT_CSV_Dialect * dialect, bool * has_header, bool * parsed) {
+  *has_header = false;
+  *parsed = true;
+
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect = *dialect;
+  opts.dialect.treat_first_row_as_header = false;
+  opts.validate_utf8 = false;
+  opts.enable_context_snippet = false;
+
+  GTEXT_CSV_Error err;
+  memset(&err, 0, sizeof(err));
+  GTEXT_CSV_Table * table = gtext_csv_parse_table(input, len, &opts, &err);
+  if (!table) {
+    GTEXT_CSV_Status status = err.code;
+    gtext_csv_error_free(&err);
+    if (status == GTEXT_CSV_E_OOM) {
+      return status;
+    }
+    *parsed = false;
+    return GTEXT_CSV_OK;
+  }
+
+  if (gtext_csv_row_count(table) >= 2) {
+    *has_header = csv_sniff_header_votes(table);
+  }
+  gtext_csv_free_table(table);
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_sniff(const char * input,
+    size_t input_len, GTEXT_CSV_Dialect * dialect,
+    GTEXT_CSV_Sniff_Info * info) {
+  if (!dialect || (!input && input_len > 0)) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  *dialect = gtext_csv_dialect_default();
+  GTEXT_CSV_Sniff_Info result = {0.0, 0, 0, "\n"};
+  if (info) {
+    *info = result;
+  }
+  csv_strip_bom(&input, &input_len, NULL, true, NULL);
+  if (input_len == 0) {
+    return GTEXT_CSV_OK;
+  }
+  const unsigned char * s = (const unsigned char *)input;
+  size_t len =
+      input_len < CSV_SNIFF_SAMPLE_BYTES ? input_len : CSV_SNIFF_SAMPLE_BYTES;
+
+  // One block holds every candidate's counts plus scratch for scoring
+  uint32_t * counts = (uint32_t *)malloc(
+      sizeof(uint32_t) * CSV_SNIFF_MAX_RECORDS * (CSV_SNIFF_CANDIDATES + 1));
+  if (!counts) {
+    return GTEXT_CSV_E_OOM;
+  }
+  csv_sniff_candidate cands[CSV_SNIFF_CANDIDATES];
+  memset(cands, 0, sizeof(cands));
+  for (size_t c = 0; c < CSV_SNIFF_CANDIDATES; c++) {
+    cands[c].delimiter = csv_sniff_delimiters[c / CSV_SNIFF_QUOTES];
+    cands[c].quote = csv_sniff_quotes[c % CSV_SNIFF_QUOTES];
+    cands[c].skip = SIZE_MAX;
+    cands[c].fields = 1;
+    cands[c].comment = s[0] == '#';
+    cands[c].counts = counts + CSV_SNIFF_MAX_RECORDS * c;
+  }
+
+  // Newlines are classified with every convention accepted
+  GTEXT_CSV_Dialect any_newline = gtext_csv_dialect_default();
+  any_newline.accept_cr = true;
+  size_t newline_counts[CSV_NEWLINE_CR + 1] = {0};
+
+  size_t i = text_simd_span_excluding(
+      s, len, csv_sniff_specials, sizeof(csv_sniff_specials));
+  bool complete = len == input_len;
+  while (i < len) {
+    if (s[i] != '\n' && s[i] != '\r') {
+      for (size_t c = 0; c < CSV_SNIFF_CANDIDATES; c++) {
+        csv_sniff_scan_byte(&cands[c], s, i, len);
+      }
+      i++;
+    }
+    else {
+      csv_position pos = {i, 1, 1};
+      csv_newline_type newline =
+          csv_detect_newline(input, len, &pos, &any_newline, NULL);
+      newline_counts[newline]++;
+      bool full = true;
+      for (size_t c = 0; c < CSV_SNIFF_CANDIDATES; c++) {
+        if (!cands[c].in_quote) {
+          csv_sniff_end_record(&cands[c], s, i, pos.offset, len);
+        }
+        full = full && cands[c].record_count == CSV_SNIFF_MAX_RECORDS;
+      }
+      i = pos.offset;
+      if (full) {
+        complete = false;
+        break;
+      }
+    }
+    i += text_simd_span_excluding(
+        s + i, len - i, csv_sniff_specials, sizeof(csv_sniff_specials));
+  }
+
+  // The last record only counts when the whole input was seen
+  if (complete) {
+    for (size_t c = 0; c < CSV_SNIFF_CANDIDATES; c++) {
+      if (cands[c].in_quote) {
+        cands[c].misplaced++; // Unterminated quoted field
+      }
+      else {
+        csv_sniff_end_record(&cands[c], s, len, len, len);
+      }
+    }
+  }
+
+  // A candidate that swallowed the sample in one quoted field sees fewer
+  // records than the rest, so scores are weighed by coverage
+  csv_sniff_score scores[CSV_SNIFF_CANDIDATES];
+  size_t most_records = 0;
+  for (size_t c = 0; c < CSV_SNIFF_CANDIDATES; c++) {
+    scores[c] = csv_sniff_score_candidate(
+        &cands[c], counts + CSV_SNIFF_MAX_RECORDS * CSV_SNIFF_CANDIDATES);
+    if (scores[c].records > most_records) {
+      most_records = scores[c].records;
+    }
+  }
+  if (most_records == 0) {
+    free(counts);
+    return GTEXT_CSV_OK;
+  }
+
+  size_t best = 0;
+  for (size_t c = 0; c < CSV_SNIFF_CANDIDATES; c++) {
+    scores[c].score *= (double)scores[c].records / (double)most_records;
+    double diff = scores[c].score - scores[best].score;
+    if (diff > 1e-9 ||
+        (diff > -1e-9 &&
+            (scores[c].columns > scores[best].columns ||
+                (scores[c].columns == scores[best].columns &&
+                    cands[c].quoted > cands[best].quoted)))) {
+      best = c;
+    }
+  }
+
+  // Another delimiter that splits the records almost as well lowers the
+  // confidence
+  double rival = 0.0;
+  for (size_t c = 0; c < CSV_SNIFF_CANDIDATES; c++) {
+    if (cands[c].delimiter != cands[best].delimiter &&
+        scores[c].columns > 1 && scores[c].score > rival) {
+      rival = scores[c].score;
+    }
+  }
+
+  const csv_sniff_candidate * cand = &cands[best];
+  dialect->delimiter = (char)cand->delimiter;
+  dialect->quote = (char)cand->quote;
+  if (cand->backslashed > cand->doubled) {
+    dialect->escape = GTEXT_CSV_ESCAPE_BACKSLASH;
+  }
+  if (scores[best].comments) {
+    dialect->allow_comments = true;
+    dialect->comment_prefix = "#";
+  }
+
+  if (newline_counts[CSV_NEWLINE_CRLF] >= newline_counts[CSV_NEWLINE_LF] &&
+      newline_counts[CSV_NEWLINE_CRLF] >= newline_counts[CSV_NEWLINE_CR] &&
+      newline_counts[CSV_NEWLINE_CRLF] > 0) {
+    result.newline = "\r\n";
+  }
+  else if (newline_counts[CSV_NEWLINE_CR] > newline_counts[CSV_NEWLINE_LF]) {
+    result.newline = "\r";
+    dialect->accept_cr = true;
+  }
+
+  bool has_header = false;
+  bool parsed = true;
+  GTEXT_CSV_Status status =
+      csv_sniff_header(input, cand->head_end, dialect, &has_header, &parsed);
+  free(counts);
+  if (status != GTEXT_CSV_OK) {
+    *dialect = gtext_csv_dialect_default();
+    return status;
+  }
+  dialect->treat_first_row_as_header = has_header;
+
+  double confidence = scores[best].score;
+  if (scores[best].records < CSV_SNIFF_CONFIDENT_RECORDS) {
+    confidence *=
+        (double)scores[best].records / (double)CSV_SNIFF_CONFIDENT_RECORDS;
+  }
+  if (rival > 0.0) {
+    confidence *= 1.0 - 0.5 * rival / scores[best].score;
+  }
+  if (!parsed) {
+    confidence *= 0.5;
+  }
+
+  result.confidence = confidence;
+  result.column_count = scores[best].columns;
+  result.record_count = scores[best].records;
+  if (info) {
+    *info = result;
+  }
+  return GTEXT_CSV_OK;
+}
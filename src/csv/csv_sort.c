@@ -0,0 +1,548 @@
+/**
+ * @file
+ *
+ * Multi-key sorting of CSV table rows.
+ *
+ * Rows are sorted as (key prefix, row number) items with a stable merge
+ * sort, and the table's row slots (or column-major offset arrays) are then
+ * permuted into the sorted order. Field bytes never move. Large tables are
+ * split into runs that are sorted, and then merged pairwise, on separate
+ * threads.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csv_internal.h"
+#include <ghoti.io/text/csv/csv_core.h>
+#include <ghoti.io/text/csv/csv_table.h>
+
+// Runs up to this many rows are sorted by insertion sort before merging
+#define CSV_SORT_INSERTION_ROWS 24
+
+// Rows each thread must have before a sort is split across threads
+#define CSV_SORT_MIN_CHUNK_ROWS 16384
+
+// Maximum number of runs sorted on separate threads
+#define CSV_SORT_MAX_CHUNKS 64
+
+// One row being sorted
+typedef struct {
+  uint64_t prefix; // Order-preserving summary of the row's first key
+  size_t length;   // Cell length of a lexicographic first key
+  size_t row;      // Data row number before the sort
+} csv_sort_item;
+
+// What every comparison needs
+typedef struct {
+  const GTEXT_CSV_Table * table;
+  const GTEXT_CSV_Sort_Key * keys;
+  size_t key_count;
+  size_t start;      // Index of the first data row
+  double ** numbers; // Per key: cell values of a numeric key (NaN for cells
+                     // that are not numbers), or NULL
+} csv_sort_context;
+
+// A run of items handled by one thread
+typedef struct {
+  const csv_sort_context * ctx;
+  csv_sort_item * items;   // Items being sorted (whole array)
+  csv_sort_item * scratch; // Merge space (whole array)
+  const csv_sort_item * src; // Merge input (whole array)
+  csv_sort_item * dst;       // Merge output (whole array)
+  size_t begin;
+  size_t middle; // End of the first of two runs being merged
+  size_t end;
+  GTEXT_CSV_Status status;
+} csv_sort_chunk;
+
+// Whether a byte is an ASCII digit
+static bool csv_sort_is_digit(unsigned char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Compare two byte strings; a proper prefix sorts first
+static int csv_sort_compare_bytes(
+    const char * a, size_t a_len, const char * b, size_t b_len) {
+  size_t len = a_len < b_len ? a_len : b_len;
+  int c = len > 0 ? memcmp(a, b, len) : 0;
+  if (c != 0) {
+    return c < 0 ? -1 : 1;
+  }
+  return (a_len > b_len) - (a_len < b_len);
+}
+
+// Compare two strings with digit runs ordered by value
+// Strings equal apart from leading zeros fall back to byte order
+static int csv_sort_compare_natural(
+    const char * a, size_t a_len, const char * b, size_t b_len) {
+  const unsigned char * x = (const unsigned char *)a;
+  const unsigned char * y = (const unsigned char *)b;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < a_len && j < b_len) {
+    if (!csv_sort_is_digit(x[i]) || !csv_sort_is_digit(y[j])) {
+      if (x[i] != y[j]) {
+        return x[i] < y[j] ? -1 : 1;
+      }
+      i++;
+      j++;
+      continue;
+    }
+
+    // Longer runs of significant digits are larger numbers
+    while (i < a_len && x[i] == '0') {
+      i++;
+    }
+    while (j < b_len && y[j] == '0') {
+      j++;
+    }
+    size_t x_digits = i;
+    size_t y_digits = j;
+    while (i < a_len && csv_sort_is_digit(x[i])) {
+      i++;
+    }
+    while (j < b_len && csv_sort_is_digit(y[j])) {
+      j++;
+    }
+    if (i - x_digits != j - y_digits) {
+      return i - x_digits < j - y_digits ? -1 : 1;
+    }
+    int c = memcmp(x + x_digits, y + y_digits, i - x_digits);
+    if (c != 0) {
+      return c < 0 ? -1 : 1;
+    }
+  }
+
+  if (a_len - i != b_len - j) {
+    return a_len - i < b_len - j ? -1 : 1;
+  }
+  return csv_sort_compare_bytes(a, a_len, b, b_len);
+}
+
+// A data row's cell, empty for cells missing from short rows
+static const char * csv_sort_cell(
+    const csv_sort_context * ctx, size_t row, size_t col, size_t * len) {
+  const char * data =
+      csv_table_cell_at(ctx->table, ctx->start + row, col, len);
+  return data ? data : "";
+}
+
+GTEXT_INTERNAL_API GTEXT_CSV_Status csv_sort_number(
+    const char * data, size_t len, double * out) {
+  GTEXT_CSV_Status status = csv_convert_parse_f64(data, len, out);
+  if (status == GTEXT_CSV_E_INVALID) {
+    *out = NAN;
+    return GTEXT_CSV_OK;
+  }
+  return status;
+}
+
+GTEXT_INTERNAL_API int csv_sort_compare_cells(const GTEXT_CSV_Sort_Key * key,
+    const char * a, size_t a_len, double a_number, const char * b,
+    size_t b_len, double b_number) {
+  int c;
+  if (key->compare == GTEXT_CSV_COMPARE_NUMERIC) {
+    // Cells that are not numbers come last in either direction
+    if (isnan(a_number) != isnan(b_number)) {
+      return isnan(a_number) ? 1 : -1;
+    }
+    if (!isnan(a_number)) {
+      c = (a_number > b_number) - (a_number < b_number);
+      return key->descending ? -c : c;
+    }
+  }
+
+  if (key->compare == GTEXT_CSV_COMPARE_NATURAL) {
+    c = csv_sort_compare_natural(a, a_len, b, b_len);
+  }
+  else {
+    c = csv_sort_compare_bytes(a, a_len, b, b_len);
+  }
+  return key->descending ? -c : c;
+}
+
+// Compare two data rows on one key, in the key's direction
+static int csv_sort_compare_key(
+    const csv_sort_context * ctx, size_t k, size_t a, size_t b) {
+  const GTEXT_CSV_Sort_Key * key = &ctx->keys[k];
+  double a_number = NAN;
+  double b_number = NAN;
+  if (key->compare == GTEXT_CSV_COMPARE_NUMERIC) {
+    a_number = ctx->numbers[k][a];
+    b_number = ctx->numbers[k][b];
+    // Two numbers are settled without reading the cells
+    if (!isnan(a_number) && !isnan(b_number)) {
+      int c = (a_number > b_number) - (a_number < b_number);
+      return key->descending ? -c : c;
+    }
+  }
+
+  size_t a_len;
+  size_t b_len;
+  const char * a_data = csv_sort_cell(ctx, a, key->column, &a_len);
+  const char * b_data = csv_sort_cell(ctx, b, key->column, &b_len);
+  return csv_sort_compare_cells(
+      key, a_data, a_len, a_number, b_data, b_len, b_number);
+}
+
+// Compare two items on every key, then on their original position
+static int csv_sort_compare(const csv_sort_context * ctx,
+    const csv_sort_item * a, const csv_sort_item * b) {
+  if (a->prefix != b->prefix) {
+    return a->prefix < b->prefix ? -1 : 1;
+  }
+
+  // Equal prefixes settle the first key without reading cells when they hold
+  // whole lexicographic cells or two numbers
+  size_t first_key = 0;
+  const GTEXT_CSV_Sort_Key * key = &ctx->keys[0];
+  if (key->compare == GTEXT_CSV_COMPARE_LEXICOGRAPHIC && a->length <= 8 &&
+      b->length <= 8) {
+    if (a->length != b->length) {
+      // The longer cell only adds NUL bytes
+      int c = a->length < b->length ? -1 : 1;
+      return key->descending ? -c : c;
+    }
+    first_key = 1;
+  }
+  else if (key->compare == GTEXT_CSV_COMPARE_NUMERIC &&
+      a->prefix != UINT64_MAX) {
+    first_key = 1;
+  }
+
+  for (size_t k = first_key; k < ctx->key_count; k++) {
+    int c = csv_sort_compare_key(ctx, k, a->row, b->row);
+    if (c != 0) {
+      return c;
+    }
+  }
+  return (a->row > b->row) - (a->row < b->row);
+}
+
+// Order-preserving 64-bit summary of a row's first key
+// Rows with different prefixes compare the same way as their full keys
+// Sets *length to the cell length of a lexicographic key
+static uint64_t csv_sort_prefix(
+    const csv_sort_context * ctx, size_t row, size_t * length) {
+  const GTEXT_CSV_Sort_Key * key = &ctx->keys[0];
+  uint64_t prefix = 0;
+  *length = 0;
+
+  if (key->compare == GTEXT_CSV_COMPARE_NUMERIC) {
+    double value = ctx->numbers[0][row];
+    if (isnan(value)) {
+      return UINT64_MAX;
+    }
+    if (value == 0) {
+      value = 0; // -0 and +0 are equal
+    }
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    prefix = (bits >> 63) ? ~bits : bits | ((uint64_t)1 << 63);
+    // Never UINT64_MAX, which is kept for cells that are not numbers
+    return key->descending ? ~prefix : prefix;
+  }
+  if (key->compare == GTEXT_CSV_COMPARE_NATURAL) {
+    return 0;
+  }
+
+  size_t len;
+  const char * data = csv_sort_cell(ctx, row, key->column, &len);
+  *length = len;
+  for (size_t i = 0; i < 8; i++) {
+    prefix = (prefix << 8) | (i < len ? (unsigned char)data[i] : 0);
+  }
+  return key->descending ? ~prefix : prefix;
+}
+
+// Merge the sorted runs src[lo, mid) and src[mid, hi) into dst[lo, hi)
+static void csv_sort_merge(const csv_sort_context * ctx,
+    const csv_sort_item * src, csv_sort_item * dst, size_t lo, size_t mid,
+    size_t hi) {
+  size_t i = lo;
+  size_t j = mid;
+  size_t k = lo;
+  while (i < mid && j < hi) {
+    // Ties take the left run first, which keeps the sort stable
+    if (csv_sort_compare(ctx, &src[j], &src[i]) < 0) {
+      dst[k++] = src[j++];
+    }
+    else {
+      dst[k++] = src[i++];
+    }
+  }
+  memcpy(dst + k, src + i, (mid - i) * sizeof(csv_sort_item));
+  k += mid - i;
+  memcpy(dst + k, src + j, (hi - j) * sizeof(csv_sort_item));
+}
+
+// Sort items[begin, end), using scratch[begin, end) as merge space
+static void csv_sort_range(const csv_sort_context * ctx, csv_sort_item * items,
+    csv_sort_item * scratch, size_t begin, size_t end) {
+  for (size_t run = begin; run < end; run += CSV_SORT_INSERTION_ROWS) {
+    size_t run_end = end - run > CSV_SORT_INSERTION_ROWS
+        ? run + CSV_SORT_INSERTION_ROWS
+        : end;
+    for (size_t i = run + 1; i < run_end; i++) {
+      csv_sort_item item = items[i];
+      size_t j = i;
+      while (j > run && csv_sort_compare(ctx, &item, &items[j - 1]) < 0) {
+        items[j] = items[j - 1];
+        j--;
+      }
+      items[j] = item;
+    }
+  }
+
+  csv_sort_item * src = items;
+  csv_sort_item * dst = scratch;
+  for (size_t width = CSV_SORT_INSERTION_ROWS; width < end - begin;
+       width *= 2) {
+    for (size_t lo = begin; lo < end; lo += 2 * width) {
+      size_t mid = end - lo > width ? lo + width : end;
+      size_t hi = end - mid > width ? mid + width : end;
+      csv_sort_merge(ctx, src, dst, lo, mid, hi);
+    }
+    csv_sort_item * swap = src;
+    src = dst;
+    dst = swap;
+  }
+  if (src != items) {
+    memcpy(items + begin, src + begin, (end - begin) * sizeof(csv_sort_item));
+  }
+}
+
+// Worker: extract the keys of a run of rows and sort the run
+static void * csv_sort_chunk_worker(void * arg) {
+  csv_sort_chunk * chunk = (csv_sort_chunk *)arg;
+  const csv_sort_context * ctx = chunk->ctx;
+
+  for (size_t row = chunk->begin; row < chunk->end; row++) {
+    for (size_t k = 0; k < ctx->key_count; k++) {
+      if (!ctx->numbers[k]) {
+        continue;
+      }
+      size_t len;
+      const char * data = csv_sort_cell(ctx, row, ctx->keys[k].column, &len);
+      GTEXT_CSV_Status status =
+          csv_sort_number(data, len, &ctx->numbers[k][row]);
+      if (status != GTEXT_CSV_OK) {
+        chunk->status = status;
+        return NULL;
+      }
+    }
+    chunk->items[row].row = row;
+    chunk->items[row].prefix =
+        csv_sort_prefix(ctx, row, &chunk->items[row].length);
+  }
+
+  csv_sort_range(ctx, chunk->items, chunk->scratch, chunk->begin, chunk->end);
+  chunk->status = GTEXT_CSV_OK;
+  return NULL;
+}
+
+// Worker: merge two adjacent sorted runs
+static void * csv_sort_merge_worker(void * arg) {
+  csv_sort_chunk * chunk = (csv_sort_chunk *)arg;
+  csv_sort_merge(chunk->ctx, chunk->src, chunk->dst, chunk->begin,
+      chunk->middle, chunk->end);
+  return NULL;
+}
+
+// Run a worker over every chunk
+// Chunk 0 runs on the calling thread, as does any chunk whose thread could
+// not be started
+static void csv_sort_run(
+    csv_sort_chunk * chunks, size_t count, void * (*worker)(void *)) {
+  pthread_t threads[CSV_SORT_MAX_CHUNKS];
+  bool started[CSV_SORT_MAX_CHUNKS];
+
+  for (size_t i = 1; i < count; i++) {
+    started[i] = pthread_create(&threads[i], NULL, worker, &chunks[i]) == 0;
+  }
+  worker(&chunks[0]);
+  for (size_t i = 1; i < count; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], NULL);
+    }
+    else {
+      worker(&chunks[i]);
+    }
+  }
+}
+
+// Sort rows [0, row_count) of the context into items
+// Runs are sorted on up to chunk_count threads, then merged pairwise
+static GTEXT_CSV_Status csv_sort_items(const csv_sort_context * ctx,
+    csv_sort_item * items, csv_sort_item * scratch, size_t row_count,
+    size_t chunk_count) {
+  csv_sort_chunk chunks[CSV_SORT_MAX_CHUNKS];
+  size_t bounds[CSV_SORT_MAX_CHUNKS + 1];
+  for (size_t c = 0; c <= chunk_count; c++) {
+    bounds[c] = row_count / chunk_count * c +
+        (c < row_count % chunk_count ? c : row_count % chunk_count);
+  }
+  for (size_t c = 0; c < chunk_count; c++) {
+    chunks[c] = (csv_sort_chunk){.ctx = ctx,
+        .items = items,
+        .scratch = scratch,
+        .begin = bounds[c],
+        .end = bounds[c + 1],
+        .status = GTEXT_CSV_E_OOM};
+  }
+  csv_sort_run(chunks, chunk_count, csv_sort_chunk_worker);
+  for (size_t c = 0; c < chunk_count; c++) {
+    if (chunks[c].status != GTEXT_CSV_OK) {
+      return chunks[c].status;
+    }
+  }
+
+  // Merge adjacent runs until one is left; an unpaired last run is copied
+  csv_sort_item * src = items;
+  csv_sort_item * dst = scratch;
+  size_t runs = chunk_count;
+  while (runs > 1) {
+    size_t merges = 0;
+    for (size_t r = 0; r < runs; r += 2) {
+      size_t lo = bounds[r];
+      size_t mid = bounds[r + 1];
+      size_t hi = r + 2 <= runs ? bounds[r + 2] : mid;
+      chunks[merges] = (csv_sort_chunk){.ctx = ctx,
+          .src = src,
+          .dst = dst,
+          .begin = lo,
+          .middle = mid,
+          .end = hi};
+      // Only bounds already read are overwritten
+      bounds[merges] = lo;
+      merges++;
+    }
+    bounds[merges] = row_count;
+    csv_sort_run(chunks, merges, csv_sort_merge_worker);
+    runs = merges;
+    csv_sort_item * swap = src;
+    src = dst;
+    dst = swap;
+  }
+  if (src != items) {
+    memcpy(items, src, row_count * sizeof(csv_sort_item));
+  }
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_table_sort(GTEXT_CSV_Table * table,
+    const GTEXT_CSV_Sort_Key * keys, size_t key_count, size_t threads) {
+  if (!table || !keys || key_count == 0) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  for (size_t k = 0; k < key_count; k++) {
+    if (keys[k].compare != GTEXT_CSV_COMPARE_LEXICOGRAPHIC &&
+        keys[k].compare != GTEXT_CSV_COMPARE_NUMERIC &&
+        keys[k].compare != GTEXT_CSV_COMPARE_NATURAL) {
+      return GTEXT_CSV_E_INVALID;
+    }
+  }
+
+  size_t start = (table->has_header && table->row_count > 0) ? 1 : 0;
+  size_t row_count = table->row_count - start;
+  if (row_count < 2) {
+    return GTEXT_CSV_OK;
+  }
+
+  // Row slots are permuted in place, so rows shared with a clone are copied
+  GTEXT_CSV_Status share_status = csv_table_unshare(table);
+  if (share_status != GTEXT_CSV_OK) {
+    return share_status;
+  }
+
+  size_t chunk_count = threads > 1 ? row_count / CSV_SORT_MIN_CHUNK_ROWS : 1;
+  if (chunk_count > threads) {
+    chunk_count = threads;
+  }
+  if (chunk_count > CSV_SORT_MAX_CHUNKS) {
+    chunk_count = CSV_SORT_MAX_CHUNKS;
+  }
+  if (chunk_count < 1) {
+    chunk_count = 1;
+  }
+
+  // Everything that can fail is allocated before the table changes
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  csv_sort_context ctx = {
+      .table = table, .keys = keys, .key_count = key_count, .start = start};
+  csv_sort_item * items = NULL;
+  csv_sort_item * scratch = NULL;
+  void * permute = NULL;
+  if (row_count > SIZE_MAX / sizeof(csv_sort_item)) {
+    return GTEXT_CSV_E_OOM;
+  }
+  ctx.numbers = (double **)calloc(key_count, sizeof(double *));
+  items = (csv_sort_item *)malloc(row_count * sizeof(csv_sort_item));
+  scratch = (csv_sort_item *)malloc(row_count * sizeof(csv_sort_item));
+  permute = table->columns ? malloc(row_count * sizeof(size_t))
+                           : malloc(row_count * sizeof(csv_table_row));
+  if (!ctx.numbers || !items || !scratch || !permute) {
+    status = GTEXT_CSV_E_OOM;
+  }
+  for (size_t k = 0; status == GTEXT_CSV_OK && k < key_count; k++) {
+    if (keys[k].compare == GTEXT_CSV_COMPARE_NUMERIC) {
+      ctx.numbers[k] = (double *)malloc(row_count * sizeof(double));
+      if (!ctx.numbers[k]) {
+        status = GTEXT_CSV_E_OOM;
+      }
+    }
+  }
+
+  if (status == GTEXT_CSV_OK) {
+    status = csv_sort_items(&ctx, items, scratch, row_count, chunk_count);
+  }
+
+  // Permute row slots, or each column's offsets and lengths
+  if (status == GTEXT_CSV_OK && table->columns) {
+    csv_table_columns * cols = table->columns;
+    size_t * moved = (size_t *)permute;
+    for (size_t c = 0; c <= cols->column_count; c++) {
+      size_t * arrays[2] = {cols->widths, NULL};
+      if (c < cols->column_count) {
+        arrays[0] = cols->columns[c].offsets;
+        arrays[1] = cols->columns[c].lengths;
+      }
+      for (size_t a = 0; a < 2 && arrays[a]; a++) {
+        for (size_t i = 0; i < row_count; i++) {
+          moved[i] = arrays[a][start + items[i].row];
+        }
+        memcpy(arrays[a] + start, moved, row_count * sizeof(size_t));
+      }
+    }
+  }
+  else if (status == GTEXT_CSV_OK) {
+    csv_table_row * rows = (csv_table_row *)permute;
+    for (size_t i = 0; i < row_count; i++) {
+      rows[i] = *csv_table_row_at(table, start + i);
+    }
+    for (size_t i = 0; i < row_count; i++) {
+      *csv_table_row_at(table, start + i) = rows[items[i].row];
+    }
+    csv_table_compaction_rows_moved(table, start);
+  }
+  if (status == GTEXT_CSV_OK) {
+    csv_table_indexes_invalidate(table, SIZE_MAX);
+  }
+
+  if (ctx.numbers) {
+    for (size_t k = 0; k < key_count; k++) {
+      free(ctx.numbers[k]);
+    }
+  }
+  free(ctx.numbers);
+  free(items);
+  free(scratch);
+  free(permute);
+  return status;
+}
@@ -26,12 +26,38 @@ GTEXT_CSV_Status csv_stream_emit_event(GTEXT_CSV_Stream * stream,
     return GTEXT_CSV_OK;
   }
 
+  // A field reported directly (such as an empty one) is a view of itself
+  if (type == GTEXT_CSV_EVENT_FIELD && stream->field_views) {
+    GTEXT_CSV_Field_View view = {NULL, 0, data, data_len, false};
+    return csv_stream_emit_field_view(stream, &view);
+  }
+
   GTEXT_CSV_Event event;
   event.type = type;
   event.data = data;
   event.data_len = data_len;
   event.row_index = stream->row_count;
   event.col_index = stream->field_count;
+  event.view = NULL;
+
+  return stream->callback(&event, stream->user_data);
+}
+
+// Emit a FIELD event carrying a field view
+GTEXT_CSV_Status csv_stream_emit_field_view(
+    GTEXT_CSV_Stream * stream, const GTEXT_CSV_Field_View * view) {
+  if (!stream->callback) {
+    return GTEXT_CSV_OK;
+  }
+
+  bool whole = view->prefix_len == 0 && !view->needs_unescape;
+  GTEXT_CSV_Event event;
+  event.type = GTEXT_CSV_EVENT_FIELD;
+  event.data = whole ? view->data : NULL;
+  event.data_len = whole ? view->data_len : 0;
+  event.row_index = stream->row_count;
+  event.col_index = stream->field_count;
+  event.view = view;
 
   return stream->callback(&event, stream->user_data);
 }
@@ -131,6 +157,7 @@ GTEXT_API GTEXT_CSV_Stream * gtext_csv_stream_new(
   stream->pos.line = 1;
   stream->pos.column = 1;
   stream->total_bytes_consumed = 0;
+  text_utf8_stream_init(&stream->utf8);
   stream->original_input_buffer = NULL;
   csv_field_buffer_init(&stream->field);
   stream->original_input_buffer_len = 0;
@@ -157,45 +184,20 @@ GTEXT_API GTEXT_CSV_Stream * gtext_csv_stream_new(
   // Initialize error
   memset(&stream->error, 0, sizeof(stream->error));
 
-  return stream;
-}
-
-GTEXT_API GTEXT_CSV_Status gtext_csv_stream_feed(GTEXT_CSV_Stream * stream,
-    const void * data, size_t len, GTEXT_CSV_Error * err) {
-  if (!stream) {
-    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Stream must not be NULL");
-    return GTEXT_CSV_E_INVALID;
-  }
-
-  if (stream->state == CSV_STREAM_STATE_END) {
-    if (err) {
-      csv_error_copy(err, &stream->error);
-    }
-    return stream->error.code != GTEXT_CSV_OK ? stream->error.code
-                                              : GTEXT_CSV_E_INVALID;
-  }
-
-  if (!data || len == 0) {
-    return GTEXT_CSV_OK;
+  // Column projection
+  if (stream->opts.select_column_count > 0 &&
+      csv_stream_select_fields(stream, stream->opts.select_columns,
+          stream->opts.select_column_count) != GTEXT_CSV_OK) {
+    free(stream);
+    return NULL;
   }
 
-  // Handle BOM on first feed
-  if (stream->total_bytes_consumed == 0 && !stream->opts.keep_bom) {
-    const char * input = (const char *)data;
-    size_t input_len = len;
-    bool was_stripped = false;
-    GTEXT_CSV_Status status =
-        csv_strip_bom(&input, &input_len, &stream->pos, true, &was_stripped);
-    if (status != GTEXT_CSV_OK) {
-      return csv_stream_set_error(stream, status, "Overflow in BOM stripping");
-    }
-    if (was_stripped) {
-      // BOM was stripped, adjust data pointer
-      data = input;
-      len = input_len;
-    }
-  }
+  return stream;
+}
 
+// Run the state machine over one (already BOM-stripped) chunk
+static GTEXT_CSV_Status csv_stream_feed_chunk(
+    GTEXT_CSV_Stream * stream, const char * data, size_t len) {
   // If we have a field in progress, we need to continue it
   // CRITICAL: If we're in QUOTE_IN_QUOTED state and the field is not buffered,
   // this should not happen - the field should have been buffered at the end of
@@ -212,9 +214,6 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_stream_feed(GTEXT_CSV_Stream * stream,
       GTEXT_CSV_Status status =
           csv_field_buffer_grow(&stream->field, CSV_FIELD_BUFFER_INITIAL_SIZE);
       if (status != GTEXT_CSV_OK) {
-        if (err) {
-          csv_error_copy(err, &stream->error);
-        }
         return status;
       }
     }
@@ -231,7 +230,8 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_stream_feed(GTEXT_CSV_Stream * stream,
   if (stream->field.is_buffered &&
       (stream->state == CSV_STREAM_STATE_UNQUOTED_FIELD ||
           stream->state == CSV_STREAM_STATE_QUOTED_FIELD ||
-          stream->state == CSV_STREAM_STATE_QUOTE_IN_QUOTED)) {
+          stream->state == CSV_STREAM_STATE_QUOTE_IN_QUOTED ||
+          stream->state == CSV_STREAM_STATE_ESCAPE_IN_QUOTED)) {
     // The field buffer already contains the partial field from previous chunks.
     // We need to process the new chunk data, appending field content to the
     // buffer as we encounter it, until the field completes.
@@ -243,26 +243,133 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_stream_feed(GTEXT_CSV_Stream * stream,
       stream->field.length = stream->field.buffer_used;
     }
 
+    // With field views, the bytes from earlier chunks stay in the buffer as
+    // the view's prefix, and the rest of the field is tracked as a span of
+    // this chunk (it is only copied if the field outlasts the chunk too)
+    if (stream->field_views && !stream->field.discard) {
+      stream->field.prefix_len = stream->field.buffer_used;
+      stream->field.is_buffered = false;
+      stream->field.data = data;
+      stream->field.length = 0;
+      stream->field.start_offset = 0;
+    }
+
     // Process the new chunk - it will append to field.buffer as needed
-    GTEXT_CSV_Status status =
-        csv_stream_process_chunk(stream, (const char *)data, len);
+    GTEXT_CSV_Status status = csv_stream_process_chunk(stream, data, len);
 
     // Reset field buffering state after processing if field completed
     if (stream->state != CSV_STREAM_STATE_UNQUOTED_FIELD &&
         stream->state != CSV_STREAM_STATE_QUOTED_FIELD &&
-        stream->state != CSV_STREAM_STATE_QUOTE_IN_QUOTED) {
+        stream->state != CSV_STREAM_STATE_QUOTE_IN_QUOTED &&
+        stream->state != CSV_STREAM_STATE_ESCAPE_IN_QUOTED) {
       // Field completed, clear buffer
       csv_field_buffer_clear(&stream->field);
     }
 
-    if (status != GTEXT_CSV_OK && err) {
+    return status;
+  }
+
+  return csv_stream_process_chunk(stream, data, len);
+}
+
+// Report invalid UTF-8 at `error_offset` (counted from the start of the
+// validated stream). The state machine has already consumed every byte before
+// the offending sequence in the current chunk, so the position is exact unless
+// the sequence began in the previous chunk; those leading bytes are on the
+// same line, so step back over them.
+static GTEXT_CSV_Status csv_stream_set_utf8_error(
+    GTEXT_CSV_Stream * stream, size_t error_offset, size_t chunk_base) {
+  GTEXT_CSV_Status status = csv_stream_set_error(
+      stream, GTEXT_CSV_E_INVALID_UTF8, "Invalid UTF-8 sequence");
+  if (error_offset < chunk_base) {
+    size_t back = chunk_base - error_offset;
+    if (stream->error.byte_offset >= back) {
+      stream->error.byte_offset -= back;
+    }
+    if ((size_t)stream->error.column > back) {
+      stream->error.column -= (int)back;
+    }
+  }
+  return status;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_stream_feed(GTEXT_CSV_Stream * stream,
+    const void * data, size_t len, GTEXT_CSV_Error * err) {
+  if (!stream) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Stream must not be NULL");
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  if (stream->state == CSV_STREAM_STATE_END) {
+    if (err) {
       csv_error_copy(err, &stream->error);
     }
-    return status;
+    return stream->error.code != GTEXT_CSV_OK ? stream->error.code
+                                              : GTEXT_CSV_E_INVALID;
   }
 
-  GTEXT_CSV_Status status =
-      csv_stream_process_chunk(stream, (const char *)data, len);
+  if (!data || len == 0) {
+    return GTEXT_CSV_OK;
+  }
+
+  // Handle BOM on first feed
+  if (stream->total_bytes_consumed == 0 && !stream->pending_cr &&
+      !stream->opts.keep_bom) {
+    const char * input = (const char *)data;
+    size_t input_len = len;
+    bool was_stripped = false;
+    GTEXT_CSV_Status status =
+        csv_strip_bom(&input, &input_len, &stream->pos, true, &was_stripped);
+    if (status != GTEXT_CSV_OK) {
+      return csv_stream_set_error(stream, status, "Overflow in BOM stripping");
+    }
+    if (was_stripped) {
+      // BOM was stripped, adjust data pointer
+      data = input;
+      len = input_len;
+    }
+  }
+
+  // Validate UTF-8 before running the state machine. On failure, the valid
+  // prefix of the chunk is still parsed so the error position is exact.
+  size_t process_len = len;
+  bool utf8_invalid = false;
+  size_t utf8_error_offset = 0;
+  size_t chunk_base = stream->utf8.consumed;
+  if (stream->opts.validate_utf8) {
+    if (text_utf8_stream_feed(&stream->utf8, (const char *)data, len,
+            &utf8_error_offset) == TEXT_UTF8_INVALID) {
+      utf8_invalid = true;
+      process_len =
+          utf8_error_offset > chunk_base ? utf8_error_offset - chunk_base : 0;
+    }
+  }
+
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  const char * input = (const char *)data;
+  if (stream->pending_cr && process_len > 0) {
+    stream->pending_cr = false;
+    bool crlf = input[0] == '\n';
+    status = csv_stream_feed_chunk(stream, crlf ? "\r\n" : "\r", crlf ? 2 : 1);
+    if (crlf) {
+      input++;
+      process_len--;
+    }
+  }
+
+  // A CR ending the chunk may be the first half of a CRLF split across
+  // feeds, so it waits for the next byte
+  if (status == GTEXT_CSV_OK && !utf8_invalid && process_len > 0 &&
+      stream->opts.dialect.accept_crlf && input[process_len - 1] == '\r') {
+    process_len--;
+    stream->pending_cr = true;
+  }
+  if (status == GTEXT_CSV_OK && process_len > 0) {
+    status = csv_stream_feed_chunk(stream, input, process_len);
+  }
+  if (status == GTEXT_CSV_OK && utf8_invalid) {
+    status = csv_stream_set_utf8_error(stream, utf8_error_offset, chunk_base);
+  }
 
   if (status != GTEXT_CSV_OK && err) {
     csv_error_copy(err, &stream->error);
@@ -278,6 +385,31 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_stream_finish(
     return GTEXT_CSV_E_INVALID;
   }
 
+  // Check for a UTF-8 sequence cut off by the end of input
+  size_t utf8_error_offset = 0;
+  if (stream->opts.validate_utf8 &&
+      text_utf8_stream_finish(&stream->utf8, &utf8_error_offset) !=
+          TEXT_UTF8_VALID) {
+    GTEXT_CSV_Status status = csv_stream_set_utf8_error(
+        stream, utf8_error_offset, stream->utf8.consumed);
+    if (err) {
+      csv_error_copy(err, &stream->error);
+    }
+    return status;
+  }
+
+  // A held-back CR is the last byte of the input
+  if (stream->pending_cr) {
+    stream->pending_cr = false;
+    GTEXT_CSV_Status status = csv_stream_feed_chunk(stream, "\r", 1);
+    if (status != GTEXT_CSV_OK) {
+      if (err) {
+        csv_error_copy(err, &stream->error);
+      }
+      return status;
+    }
+  }
+
   // Check for unterminated quote
   if (stream->state == CSV_STREAM_STATE_QUOTED_FIELD ||
       stream->state == CSV_STREAM_STATE_QUOTE_IN_QUOTED ||
@@ -294,30 +426,15 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_stream_finish(
   if (stream->in_record) {
     // Emit current field if any (only if we're actually in a field, not just at
     // start)
-    if (stream->state == CSV_STREAM_STATE_UNQUOTED_FIELD ||
-        stream->state == CSV_STREAM_STATE_QUOTED_FIELD) {
+    if ((stream->state == CSV_STREAM_STATE_UNQUOTED_FIELD ||
+            stream->state == CSV_STREAM_STATE_QUOTED_FIELD) &&
+        !stream->field.discard) {
       // Ensure field.data is correct for buffered fields
       if (stream->field.is_buffered) {
         stream->field.data = stream->field.buffer;
         stream->field.length = stream->field.buffer_used;
       }
-      const char * field_data = stream->field.data;
-      // For buffered fields, use buffer_used as the source of truth
-      size_t actual_field_len = stream->field.is_buffered
-          ? stream->field.buffer_used
-          : stream->field.length;
-      const char * unescaped_data;
-      size_t unescaped_len;
-      GTEXT_CSV_Status status = csv_stream_unescape_field(stream, field_data,
-          actual_field_len, &unescaped_data, &unescaped_len);
-      if (status != GTEXT_CSV_OK) {
-        if (err) {
-          csv_error_copy(err, &stream->error);
-        }
-        return status;
-      }
-      status = csv_stream_emit_event(
-          stream, GTEXT_CSV_EVENT_FIELD, unescaped_data, unescaped_len);
+      GTEXT_CSV_Status status = csv_stream_emit_field_event(stream);
       if (status != GTEXT_CSV_OK) {
         if (err) {
           csv_error_copy(err, &stream->error);
@@ -348,6 +465,31 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_stream_finish(
   return status;
 }
 
+GTEXT_API GTEXT_CSV_Status gtext_csv_stream_set_field_views(
+    GTEXT_CSV_Stream * stream, bool enabled) {
+  if (!stream || stream->total_bytes_consumed > 0 || stream->pending_cr) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  stream->field_views = enabled;
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_API size_t gtext_csv_field_view_decode(const GTEXT_CSV_Field_View * view,
+    const GTEXT_CSV_Dialect * dialect, char * out) {
+  // An escape sequence may straddle the two pieces, so they are joined first
+  if (view->prefix_len > 0) {
+    memcpy(out, view->prefix, view->prefix_len);
+  }
+  if (view->data_len > 0) {
+    memcpy(out + view->prefix_len, view->data, view->data_len);
+  }
+  size_t len = view->prefix_len + view->data_len;
+  if (!view->needs_unescape) {
+    return len;
+  }
+  return csv_stream_decode_escapes(dialect, out, len, out);
+}
+
 GTEXT_API void gtext_csv_stream_free(GTEXT_CSV_Stream * stream) {
   if (!stream) {
     return;
@@ -355,6 +497,7 @@ GTEXT_API void gtext_csv_stream_free(GTEXT_CSV_Stream * stream) {
 
   free(stream->input_buffer);
   free(stream->field.buffer);
+  free(stream->field_mask);
   gtext_csv_error_free(&stream->error);
   free(stream);
 }
@@ -370,3 +513,45 @@ GTEXT_INTERNAL_API void csv_stream_set_original_input_buffer(
   csv_field_buffer_set_original_input(
       &stream->field, input_buffer, input_buffer_len);
 }
+
+GTEXT_INTERNAL_API void csv_stream_set_emit_window(
+    GTEXT_CSV_Stream * stream, const char * window, size_t window_len) {
+  stream->emit_window = window;
+  stream->emit_window_len = window_len;
+}
+
+GTEXT_INTERNAL_API size_t csv_stream_input_offset(
+    const GTEXT_CSV_Stream * stream) {
+  return stream->pos.offset;
+}
+
+GTEXT_INTERNAL_API GTEXT_CSV_Status csv_stream_select_fields(
+    GTEXT_CSV_Stream * stream, const size_t * indices, size_t count) {
+  free(stream->field_mask);
+  stream->field_mask = NULL;
+  stream->field_mask_len = 0;
+  if (!indices || count == 0) {
+    return GTEXT_CSV_OK;
+  }
+
+  // Columns past the limit can never be reached
+  size_t mask_len = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (indices[i] < stream->max_cols && indices[i] >= mask_len) {
+      mask_len = indices[i] + 1;
+    }
+  }
+
+  unsigned char * mask = (unsigned char *)calloc(mask_len ? mask_len : 1, 1);
+  if (!mask) {
+    return GTEXT_CSV_E_OOM;
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (indices[i] < mask_len) {
+      mask[indices[i]] = 1;
+    }
+  }
+  stream->field_mask = mask;
+  stream->field_mask_len = mask_len;
+  return GTEXT_CSV_OK;
+}
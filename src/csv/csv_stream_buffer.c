@@ -26,6 +26,7 @@ void csv_field_buffer_clear(csv_field_buffer * fb) {
   fb->needs_unescape = false;
   fb->start_offset = SIZE_MAX;
   fb->buffer_used = 0; // Reset buffer usage for reuse
+  fb->prefix_len = 0;
   // Note: Don't free buffer here - reuse it
 }
 
@@ -108,6 +109,16 @@ GTEXT_CSV_Status csv_field_buffer_append(
     return GTEXT_CSV_E_OOM;
   }
 
+  // A skipped field only needs its length for the limit checks
+  if (fb->discard) {
+    fb->buffer_used += len;
+    fb->data = fb->buffer;
+    fb->length = fb->buffer_used;
+    fb->is_buffered = true;
+    fb->start_offset = SIZE_MAX;
+    return GTEXT_CSV_OK;
+  }
+
   // Grow buffer if needed
   if (fb->buffer_used + len > fb->buffer_size) {
     GTEXT_CSV_Status status = csv_field_buffer_grow(fb, fb->buffer_used + len);
@@ -123,6 +134,7 @@ GTEXT_CSV_Status csv_field_buffer_append(
   fb->length = fb->buffer_used;
   fb->is_buffered = true;
   fb->start_offset = SIZE_MAX; // No longer tracking offset when buffered
+  fb->prefix_len = 0;          // A view's prefix is now part of the buffer
   return GTEXT_CSV_OK;
 }
 
@@ -166,10 +178,12 @@ GTEXT_CSV_Status csv_field_buffer_ensure_buffered(csv_field_buffer * fb) {
   if (status != GTEXT_CSV_OK) {
     return status;
   }
-  fb->buffer_used = 0;
+  // A field view's prefix is kept as the start of the buffered field
+  fb->buffer_used = fb->prefix_len;
+  fb->prefix_len = 0;
   fb->is_buffered = true;
   fb->data = fb->buffer;
-  fb->length = 0;
+  fb->length = fb->buffer_used;
   fb->start_offset = SIZE_MAX;
   return GTEXT_CSV_OK;
 }
@@ -223,10 +237,11 @@ GTEXT_CSV_Status csv_stream_buffer_field_at_chunk_boundary(
     if (status != GTEXT_CSV_OK) {
       return status;
     }
-    stream->field.buffer_used = 0;
+    stream->field.buffer_used = stream->field.prefix_len;
+    stream->field.prefix_len = 0;
     stream->field.is_buffered = true;
     stream->field.data = stream->field.buffer;
-    stream->field.length = 0;
+    stream->field.length = stream->field.buffer_used;
     return GTEXT_CSV_OK;
   }
 
@@ -250,20 +265,14 @@ GTEXT_CSV_Status csv_stream_buffer_field_at_chunk_boundary(
   if (status != GTEXT_CSV_OK) {
     return status;
   }
-  stream->field.buffer_used = 0;
+  stream->field.buffer_used = stream->field.prefix_len;
+  stream->field.prefix_len = 0;
   stream->field.is_buffered = true;
   stream->field.data = stream->field.buffer;
-  stream->field.length = 0;
+  stream->field.length = stream->field.buffer_used;
   return GTEXT_CSV_OK;
 }
 
-// Buffer unquoted field if in-situ mode cannot be used
-// This reduces nesting in the newline handling code
-GTEXT_CSV_Status csv_stream_buffer_unquoted_field_if_needed(
-    GTEXT_CSV_Stream * stream) {
-  return csv_field_buffer_ensure_buffered(&stream->field);
-}
-
 // Ensure field is buffered at chunk boundary (helper to reduce duplication)
 // This function handles the common pattern of checking if field is buffered,
 // calculating field_start_off, and calling
@@ -12,7 +12,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../text_simd.h"
 #include "csv_stream_internal.h"
+
 // Clear field state
 void csv_stream_clear_field_state(GTEXT_CSV_Stream * stream) {
   csv_field_buffer_clear(&stream->field);
@@ -89,9 +91,37 @@ GTEXT_CSV_Status csv_stream_handle_chunk_boundary(GTEXT_CSV_Stream * stream) {
   return GTEXT_CSV_OK;
 }
 
-// Emit a field (unescape and emit, optionally emit record end)
-GTEXT_CSV_Status csv_stream_emit_field(
-    GTEXT_CSV_Stream * stream, bool emit_record_end) {
+// Report the current field's raw bytes where they are: a buffered field is
+// one piece, and an unbuffered one is a span of the current chunk after the
+// prefix kept from earlier chunks
+static GTEXT_CSV_Status csv_stream_emit_raw_field(GTEXT_CSV_Stream * stream) {
+  GTEXT_CSV_Field_View view;
+  if (stream->field.is_buffered) {
+    view.prefix = NULL;
+    view.prefix_len = 0;
+    view.data = stream->field.buffer;
+    view.data_len = stream->field.buffer_used;
+  }
+  else {
+    view.prefix = stream->field.prefix_len > 0 ? stream->field.buffer : NULL;
+    view.prefix_len = stream->field.prefix_len;
+    view.data = stream->field.data;
+    view.data_len = stream->field.length;
+  }
+  if (!view.data) {
+    view.data = "";
+    view.data_len = 0;
+  }
+  view.needs_unescape = stream->field.needs_unescape;
+  return csv_stream_emit_field_view(stream, &view);
+}
+
+// Emit the FIELD event for the current field
+GTEXT_CSV_Status csv_stream_emit_field_event(GTEXT_CSV_Stream * stream) {
+  if (stream->field_views) {
+    return csv_stream_emit_raw_field(stream);
+  }
+
   // Get field data
   const char * field_data = stream->field.data;
   size_t actual_field_len = stream->field.is_buffered
@@ -107,11 +137,21 @@ GTEXT_CSV_Status csv_stream_emit_field(
     return status;
   }
 
-  // Emit field
-  status = csv_stream_emit_event(
+  return csv_stream_emit_event(
       stream, GTEXT_CSV_EVENT_FIELD, unescaped_data, unescaped_len);
-  if (status != GTEXT_CSV_OK) {
-    return status;
+}
+
+// Emit a field (unescape and emit, optionally emit record end)
+GTEXT_CSV_Status csv_stream_emit_field(
+    GTEXT_CSV_Stream * stream, bool emit_record_end) {
+  GTEXT_CSV_Status status;
+
+  // Fields outside the projection are counted but never unescaped or emitted
+  if (!stream->field.discard) {
+    status = csv_stream_emit_field_event(stream);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
   }
 
   if (stream->field_count >= SIZE_MAX) {
@@ -180,79 +220,65 @@ bool csv_stream_can_use_in_situ(
 size_t csv_stream_scan_unquoted_field_ahead(GTEXT_CSV_Stream * stream,
     const char * process_input, size_t process_len, size_t start_offset,
     bool * found_special, char * special_char, size_t * special_pos) {
-  const char delimiter = stream->opts.dialect.delimiter;
-  const char quote = stream->opts.dialect.quote;
-  bool allow_unquoted_quotes = stream->opts.dialect.allow_unquoted_quotes;
-  bool allow_unquoted_newlines = stream->opts.dialect.allow_unquoted_newlines;
+  // Build the set of bytes that end the run for this dialect. A quote or
+  // newline the dialect allows in unquoted fields is plain content (a newline
+  // sequence is skipped whole either way), so it is left out of the set.
+  unsigned char set[4];
+  size_t set_len = 0;
+  set[set_len++] = (unsigned char)stream->opts.dialect.delimiter;
+  if (!stream->opts.dialect.allow_unquoted_quotes) {
+    set[set_len++] = (unsigned char)stream->opts.dialect.quote;
+  }
+  if (!stream->opts.dialect.allow_unquoted_newlines) {
+    set[set_len++] = '\n';
+    set[set_len++] = '\r';
+  }
 
   size_t pos = start_offset;
-  *found_special = false;
-
-  while (pos < process_len) {
-    char c = process_input[pos];
-
-    // Check for delimiter (always ends field)
-    if (c == delimiter) {
-      *found_special = true;
-      *special_char = c;
-      *special_pos = pos;
-      return pos - start_offset;
-    }
+  if (pos < process_len) {
+    pos += text_simd_span_excluding(
+        (const unsigned char *)process_input + pos, process_len - pos, set,
+        set_len);
+  }
 
-    // Check for newline
-    if (c == '\n' || c == '\r') {
-      // Check if it's a complete newline sequence
-      csv_position pos_before = stream->pos;
-      pos_before.offset = pos;
-      GTEXT_CSV_Status detect_error = GTEXT_CSV_OK;
-      csv_newline_type nl = csv_detect_newline(process_input, process_len,
-          &pos_before, &stream->opts.dialect, &detect_error);
-      // Note: We ignore overflow errors here since this is just scanning ahead
-      // The actual newline handling will check for overflow
-      if (nl != CSV_NEWLINE_NONE) {
-        // Found a complete newline sequence
-        if (!allow_unquoted_newlines) {
-          // Newlines not allowed - this ends the field
-          *found_special = true;
-          *special_char = c;
-          *special_pos = pos;
-          return pos - start_offset;
-        }
-        // Newlines allowed - this is just part of the field content
-        // Advance past the newline sequence and continue scanning
-        pos += (nl == CSV_NEWLINE_CRLF ? 2 : 1);
-        continue;
-      }
-      // Not a complete newline sequence (e.g., standalone CR when dialect
-      // expects CRLF) If newlines not allowed, this is an error
-      if (!allow_unquoted_newlines) {
-        *found_special = true;
-        *special_char = c;
-        *special_pos = pos;
-        return pos - start_offset;
-      }
-      // Newlines allowed - single newline character is just field content
-      // Continue scanning
-    }
+  if (pos < process_len) {
+    *found_special = true;
+    *special_char = process_input[pos];
+    *special_pos = pos;
+  }
+  else {
+    // Reached end of chunk without finding special character
+    *found_special = false;
+  }
+  return pos - start_offset;
+}
 
-    // Check for quote
-    if (c == quote) {
-      if (!allow_unquoted_quotes) {
-        // Quote not allowed - this is an error
-        *found_special = true;
-        *special_char = c;
-        *special_pos = pos;
-        return pos - start_offset;
-      }
-      // Quote allowed, continue scanning (it's just part of the field)
-    }
+// Scan ahead in quoted field for the next byte that needs the state machine
+// Returns the length of the run starting at start_offset that is plain field
+// content: it stops at the quote, at a backslash when backslash escapes are
+// enabled, and (while a doubled quote was just processed) at a delimiter or
+// newline. Returns process_len - start_offset if the run reaches the end.
+size_t csv_stream_scan_quoted_field_ahead(GTEXT_CSV_Stream * stream,
+    const char * process_input, size_t process_len, size_t start_offset) {
+  if (start_offset >= process_len) {
+    return 0;
+  }
 
-    pos++;
+  unsigned char set[5];
+  size_t set_len = 0;
+  set[set_len++] = (unsigned char)stream->opts.dialect.quote;
+  if (stream->opts.dialect.escape == GTEXT_CSV_ESCAPE_BACKSLASH) {
+    set[set_len++] = '\\';
+  }
+  if (stream->just_processed_doubled_quote) {
+    set[set_len++] = (unsigned char)stream->opts.dialect.delimiter;
+    set[set_len++] = '\n';
+    set[set_len++] = '\r';
   }
 
-  // Reached end of chunk without finding special character
-  *found_special = false;
-  return pos - start_offset;
+  return text_simd_span_excluding(
+      (const unsigned char *)process_input + start_offset,
+      process_len - start_offset, set, set_len);
 }
 
 // Check if unescaping is needed
@@ -320,6 +346,18 @@ GTEXT_CSV_Status csv_stream_unescape_field_no_unescape(
     }
   }
 
+  // Check if input_data points into the emit window (batch reader)
+  if (stream->emit_window && input_data &&
+      input_data >= stream->emit_window) {
+    size_t offset_from_start = (size_t)(input_data - stream->emit_window);
+    if (offset_from_start <= stream->emit_window_len &&
+        input_len <= stream->emit_window_len - offset_from_start) {
+      *output_data = input_data;
+      *output_len = input_len;
+      return GTEXT_CSV_OK;
+    }
+  }
+
   // Input is not in field buffer and not in original input - copy it to ensure
   // stability Safety check: ensure input_data is valid (not NULL)
   if (!input_data) {
@@ -431,28 +469,12 @@ GTEXT_CSV_Status csv_stream_unescape_field_with_unescape(
     actual_input_len = stream->field.buffer_used;
   }
 
-  // Unescape doubled quotes (in-place if input is field buffer, otherwise copy)
-  size_t out_idx = 0;
-  for (size_t in_idx = 0; in_idx < actual_input_len; in_idx++) {
-    if (stream->opts.dialect.escape == GTEXT_CSV_ESCAPE_DOUBLED_QUOTE &&
-        in_idx + 1 < actual_input_len &&
-        actual_input[in_idx] == stream->opts.dialect.quote &&
-        actual_input[in_idx + 1] == stream->opts.dialect.quote) {
-      // Doubled quote - output single quote
-      if (out_idx >= stream->field.buffer_size) {
-        return GTEXT_CSV_E_OOM;
-      }
-      stream->field.buffer[out_idx++] = stream->opts.dialect.quote;
-      in_idx++; // Skip second quote
-    }
-    else {
-      // Regular character
-      if (out_idx >= stream->field.buffer_size) {
-        return GTEXT_CSV_E_OOM;
-      }
-      stream->field.buffer[out_idx++] = actual_input[in_idx];
-    }
+  // Unescape (in-place if input is field buffer, otherwise copy)
+  if (actual_input_len > stream->field.buffer_size) {
+    return GTEXT_CSV_E_OOM;
   }
+  size_t out_idx = csv_stream_decode_escapes(&stream->opts.dialect,
+      actual_input, actual_input_len, stream->field.buffer);
 
   // Safety check: ensure output length doesn't exceed buffer size
   // This should never happen due to bounds checking in the loop above, but be
@@ -480,8 +502,40 @@ GTEXT_CSV_Status csv_stream_unescape_field_with_unescape(
   return GTEXT_CSV_OK;
 }
 
-// Unescape doubled quotes in field data
-// Converts doubled quotes ("") to single quotes (") in the field data.
+// Resolve escape sequences in raw field bytes
+// Doubled quotes become one quote; backslash sequences become the character
+// they stand for. Reads stay ahead of writes, so out may equal input.
+size_t csv_stream_decode_escapes(const GTEXT_CSV_Dialect * dialect,
+    const char * input, size_t input_len, char * out) {
+  size_t out_idx = 0;
+  for (size_t in_idx = 0; in_idx < input_len; in_idx++) {
+    char c = input[in_idx];
+    if (in_idx + 1 < input_len) {
+      if (dialect->escape == GTEXT_CSV_ESCAPE_DOUBLED_QUOTE &&
+          c == dialect->quote && input[in_idx + 1] == dialect->quote) {
+        in_idx++; // Skip second quote
+      }
+      else if (dialect->escape == GTEXT_CSV_ESCAPE_BACKSLASH && c == '\\') {
+        c = input[++in_idx];
+        if (c == 'n') {
+          c = '\n';
+        }
+        else if (c == 'r') {
+          c = '\r';
+        }
+        else if (c == 't') {
+          c = '\t';
+        }
+        // '\\' and '"' stand for themselves
+      }
+    }
+    out[out_idx++] = c;
+  }
+  return out_idx;
+}
+
+// Unescape field data
+// Resolves doubled quotes ("") or backslash sequences in the field data.
 // The result is written to the field_buffer, which must be large enough.
 GTEXT_CSV_Status csv_stream_unescape_field(GTEXT_CSV_Stream * stream,
     const char * input_data, size_t input_len, const char ** output_data,
@@ -17,6 +17,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "../text_utf8.h"
 #include "csv_internal.h"
 #include <ghoti.io/text/csv/csv_core.h>
 #include <ghoti.io/text/csv/csv_stream.h>
@@ -98,6 +99,13 @@ typedef struct csv_field_buffer {
   // Field start tracking (for chunk boundary handling)
   size_t start_offset; ///< Offset in current chunk where field started
                        ///< (SIZE_MAX if field already buffered)
+
+  // Column projection
+  bool discard; ///< Field is not selected: appends only count its length
+
+  // Field views
+  size_t prefix_len; ///< Bytes of buffer from earlier chunks while data is a
+                     ///< span of the current chunk (field views only)
 } csv_field_buffer;
 
 /**
@@ -130,6 +138,9 @@ struct GTEXT_CSV_Stream {
   csv_position pos; ///< Current parsing position (line, column, offset)
   size_t total_bytes_consumed; ///< Total bytes consumed across all chunks
 
+  // UTF-8 validation (when opts.validate_utf8 is set)
+  text_utf8_stream utf8; ///< Incremental validator state across chunks
+
   // Field accumulation (unified buffer management)
   csv_field_buffer field;            ///< Unified field buffer structure
   bool just_processed_doubled_quote; ///< Whether we just processed a doubled
@@ -137,6 +148,8 @@ struct GTEXT_CSV_Stream {
   bool quote_in_quoted_at_chunk_boundary; ///< Whether we transitioned to
                                           ///< QUOTE_IN_QUOTED at end of
                                           ///< previous chunk
+  bool pending_cr; ///< The last chunk ended in a CR held back until the next
+                   ///< byte shows whether it starts a CRLF
 
   // Limits
   size_t max_rows;             ///< Maximum number of rows allowed
@@ -155,6 +168,19 @@ struct GTEXT_CSV_Stream {
                                       ///< for in-situ mode)
   size_t original_input_buffer_len;   ///< Length of original input buffer
 
+  // Zero-copy emission (for the batch reader)
+  const char * emit_window; ///< Unescaped fields inside it are emitted in
+                            ///< place (NULL = always copy)
+  size_t emit_window_len;   ///< Length of emit_window
+  bool field_views;         ///< FIELD events carry raw views and are never
+                            ///< copied or unescaped
+
+  // Column projection
+  unsigned char * field_mask; ///< Non-zero for each selected column index
+                              ///< (NULL = every column is selected)
+  size_t field_mask_len;      ///< Entries in field_mask; later columns are
+                              ///< not selected
+
   // Error state
   GTEXT_CSV_Error error; ///< Current error state (if any)
 };
@@ -173,6 +199,28 @@ static inline size_t csv_get_limit(size_t configured, size_t default_val) {
   return configured > 0 ? configured : default_val;
 }
 
+/**
+ * @brief Whether the field about to start is selected by the projection
+ *
+ * @param stream Stream parser (must not be NULL)
+ * @return true if the field at index field_count is kept
+ */
+static inline bool csv_stream_field_selected(const GTEXT_CSV_Stream * stream) {
+  return !stream->field_mask ||
+      (stream->field_count < stream->field_mask_len &&
+          stream->field_mask[stream->field_count]);
+}
+
+/**
+ * @brief Bytes of the current field seen so far, across chunks
+ *
+ * @param stream Stream parser (must not be NULL)
+ * @return Field length, including a field view's prefix
+ */
+static inline size_t csv_stream_field_length(const GTEXT_CSV_Stream * stream) {
+  return stream->field.length + stream->field.prefix_len;
+}
+
 // Field buffer functions (in csv_stream_buffer.c)
 
 /**
@@ -295,18 +343,6 @@ GTEXT_CSV_Status csv_stream_buffer_field_at_chunk_boundary(
     GTEXT_CSV_Stream * stream, const char * process_input, size_t process_len,
     size_t field_start_offset, size_t current_offset);
 
-/**
- * @brief Buffer unquoted field if it needs buffering
- *
- * Checks if an unquoted field needs to be buffered (e.g., for unescaping)
- * and buffers it if necessary.
- *
- * @param stream Stream parser (must not be NULL)
- * @return GTEXT_CSV_OK on success, error code on failure
- */
-GTEXT_CSV_Status csv_stream_buffer_unquoted_field_if_needed(
-    GTEXT_CSV_Stream * stream);
-
 /**
  * @brief Ensure field is buffered for chunk boundary handling
  *
@@ -424,6 +460,33 @@ GTEXT_CSV_Status csv_stream_handle_chunk_boundary(GTEXT_CSV_Stream * stream);
 GTEXT_CSV_Status csv_stream_emit_field(
     GTEXT_CSV_Stream * stream, bool emit_record_end);
 
+/**
+ * @brief Emit the FIELD event for the current field
+ *
+ * Reports the field as a raw view when field views are enabled, and as its
+ * unescaped value otherwise. Does not update the field count.
+ *
+ * @param stream Stream parser (must not be NULL)
+ * @return GTEXT_CSV_OK on success, error code on failure
+ */
+GTEXT_CSV_Status csv_stream_emit_field_event(GTEXT_CSV_Stream * stream);
+
+/**
+ * @brief Resolve the escape sequences of raw field bytes
+ *
+ * Turns doubled quotes into one quote, or backslash sequences into the
+ * characters they stand for, according to the dialect's escape mode. The
+ * output is never longer than the input, so @p out may equal @p input.
+ *
+ * @param dialect Dialect (must not be NULL)
+ * @param input Raw field bytes
+ * @param input_len Length of input
+ * @param out Destination with room for input_len bytes
+ * @return Length of the unescaped bytes
+ */
+size_t csv_stream_decode_escapes(const GTEXT_CSV_Dialect * dialect,
+    const char * input, size_t input_len, char * out);
+
 /**
  * @brief Unescape field data
  *
@@ -510,6 +573,36 @@ size_t csv_stream_scan_unquoted_field_ahead(GTEXT_CSV_Stream * stream,
     const char * process_input, size_t process_len, size_t start_offset,
     bool * found_special, char * special_char, size_t * special_pos);
 
+/**
+ * @brief Scan ahead in quoted field for the next byte needing the state machine
+ *
+ * Finds the end of the run of plain content starting at @p start_offset: the
+ * next quote, backslash (with backslash escapes), or, right after a doubled
+ * quote, delimiter or newline. Used for bulk processing of quoted fields.
+ *
+ * @param stream Stream parser (must not be NULL)
+ * @param process_input Input data to scan (must not be NULL)
+ * @param process_len Length of input data
+ * @param start_offset Offset to start scanning from
+ * @return Number of bytes of plain content before the special byte or end
+ */
+size_t csv_stream_scan_quoted_field_ahead(GTEXT_CSV_Stream * stream,
+    const char * process_input, size_t process_len, size_t start_offset);
+
+/**
+ * @brief Clamp a run of field content consumed in one step to the limits
+ *
+ * The main loop enforces the field, record, and total size limits once per
+ * dispatched character. A bulk run is shortened so that the first byte over
+ * a limit is still dispatched (and reported) on its own, and the record size
+ * is charged for the rest of the run.
+ *
+ * @param stream Stream parser (must not be NULL)
+ * @param run Length of the run, including the byte already dispatched
+ * @return Number of bytes to consume (at least 1)
+ */
+size_t csv_stream_limit_bulk_run(GTEXT_CSV_Stream * stream, size_t run);
+
 /**
  * @brief Validate field input data
  *
@@ -826,6 +919,19 @@ bool csv_stream_is_comment_start(GTEXT_CSV_Stream * stream, const char * input,
 GTEXT_CSV_Status csv_stream_emit_event(GTEXT_CSV_Stream * stream,
     GTEXT_CSV_Event_Type type, const char * data, size_t data_len);
 
+/**
+ * @brief Emit a FIELD event for a field view
+ *
+ * The event's data is the view itself when it is one piece with nothing to
+ * unescape, and NULL otherwise.
+ *
+ * @param stream Stream parser (must not be NULL)
+ * @param view Raw field bytes (must not be NULL)
+ * @return GTEXT_CSV_OK on success, error code if callback returns error
+ */
+GTEXT_CSV_Status csv_stream_emit_field_view(
+    GTEXT_CSV_Stream * stream, const GTEXT_CSV_Field_View * view);
+
 /**
  * @brief Set error state in stream
  *
@@ -65,6 +65,12 @@ GTEXT_CSV_Status csv_stream_handle_newline(GTEXT_CSV_Stream * stream,
 
   size_t newline_bytes = (nl == CSV_NEWLINE_CRLF ? 2 : 1);
 
+  // A caller that already consumed this newline only needs its type
+  if (*offset == pos_before.offset) {
+    *nl_out = nl;
+    return GTEXT_CSV_OK;
+  }
+
   // Check all overflow conditions upfront before performing any operations
   size_t offset_delta = pos_before.offset - byte_pos;
   if (stream->pos.offset > SIZE_MAX - offset_delta) {
@@ -77,7 +83,7 @@ GTEXT_CSV_Status csv_stream_handle_newline(GTEXT_CSV_Stream * stream,
   }
 
   // All checks passed, perform all updates
-  stream->pos.offset = pos_before.offset;
+  stream->pos.offset += offset_delta;
   stream->pos.line = pos_before.line;
   stream->pos.column = pos_before.column;
   stream->total_bytes_consumed += newline_bytes;
@@ -159,6 +165,7 @@ GTEXT_CSV_Status csv_stream_process_start_of_field(GTEXT_CSV_Stream * stream,
 
   // Clear any previous field buffering
   csv_field_buffer_clear(&stream->field);
+  stream->field.discard = !csv_stream_field_selected(stream);
   stream->just_processed_doubled_quote = false;
   stream->quote_in_quoted_at_chunk_boundary = false;
   // Validate input parameters (consolidated safety checks)
@@ -202,10 +209,12 @@ GTEXT_CSV_Status csv_stream_process_start_of_field(GTEXT_CSV_Stream * stream,
 
   if (c == stream->opts.dialect.delimiter) {
     // Empty field
-    GTEXT_CSV_Status status =
-        csv_stream_emit_event(stream, GTEXT_CSV_EVENT_FIELD, "", 0);
-    if (status != GTEXT_CSV_OK) {
-      return status;
+    if (!stream->field.discard) {
+      GTEXT_CSV_Status status =
+          csv_stream_emit_event(stream, GTEXT_CSV_EVENT_FIELD, "", 0);
+      if (status != GTEXT_CSV_OK) {
+        return status;
+      }
     }
     if (stream->field_count >= SIZE_MAX) {
       return csv_stream_set_error(
@@ -225,9 +234,11 @@ GTEXT_CSV_Status csv_stream_process_start_of_field(GTEXT_CSV_Stream * stream,
   }
   if (nl != CSV_NEWLINE_NONE) {
     // Empty field, end of record
-    status = csv_stream_emit_event(stream, GTEXT_CSV_EVENT_FIELD, "", 0);
-    if (status != GTEXT_CSV_OK) {
-      return status;
+    if (!stream->field.discard) {
+      status = csv_stream_emit_event(stream, GTEXT_CSV_EVENT_FIELD, "", 0);
+      if (status != GTEXT_CSV_OK) {
+        return status;
+      }
     }
     status = csv_stream_emit_event(stream, GTEXT_CSV_EVENT_RECORD_END, NULL, 0);
     if (status != GTEXT_CSV_OK) {
@@ -260,7 +271,17 @@ GTEXT_CSV_Status csv_stream_process_start_of_field(GTEXT_CSV_Stream * stream,
   // 3. When in-situ mode is disabled
   csv_field_buffer_set_from_input(
       &stream->field, process_input + byte_pos, 1, false, byte_pos);
-  return csv_stream_advance_position(stream, offset, 1);
+  status = csv_stream_advance_position(stream, offset, 1);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+
+  // A field starting on the last byte of the chunk continues in the next one,
+  // so its first byte must be buffered like any other chunk boundary
+  if (*offset >= process_len) {
+    return csv_stream_handle_chunk_boundary(stream);
+  }
+  return GTEXT_CSV_OK;
 }
 
 // Helper: Handle delimiter in unquoted field
@@ -284,11 +305,8 @@ GTEXT_CSV_Status csv_stream_unquoted_handle_newline(GTEXT_CSV_Stream * stream,
   }
 
   // Field complete, end of record
-  // Buffer field if needed
-  status = csv_stream_buffer_unquoted_field_if_needed(stream);
-  if (status != GTEXT_CSV_OK) {
-    return status;
-  }
+  // An unbuffered field lies in this chunk, so it is emitted like a field
+  // ending at a delimiter (copied only if it cannot be reported in place)
 
   // Position already updated by csv_stream_handle_newline
   status = csv_stream_emit_field(stream, true);
@@ -348,14 +366,9 @@ GTEXT_CSV_Status csv_stream_unquoted_handle_special_char(
       return status;
     }
     if (nl != CSV_NEWLINE_NONE) {
-      // Field complete, end of record
-      GTEXT_CSV_Status buffer_status =
-          csv_stream_buffer_unquoted_field_if_needed(stream);
-      if (buffer_status != GTEXT_CSV_OK) {
-        return buffer_status;
-      }
+      // Field complete, end of record (emitted as at a delimiter)
       // Position already updated by csv_stream_handle_newline
-      buffer_status = csv_stream_emit_field(stream, true);
+      GTEXT_CSV_Status buffer_status = csv_stream_emit_field(stream, true);
       if (buffer_status != GTEXT_CSV_OK) {
         return buffer_status;
       }
@@ -418,11 +431,13 @@ GTEXT_CSV_Status csv_stream_unquoted_process_bulk(GTEXT_CSV_Stream * stream,
       csv_stream_scan_unquoted_field_ahead(stream, process_input, process_len,
           byte_pos, &found_special, &special_char, &special_pos);
 
-  // Respect field length limit
-  size_t remaining_capacity = stream->max_field_bytes - stream->field.length;
-  if (safe_chars > remaining_capacity) {
-    safe_chars = remaining_capacity;
-    found_special = false; // We'll hit the limit instead
+  // Respect field, record, and total length limits
+  if (safe_chars > 0) {
+    size_t limited = csv_stream_limit_bulk_run(stream, safe_chars);
+    if (limited < safe_chars) {
+      safe_chars = limited;
+      found_special = false; // We'll hit the limit instead
+    }
   }
 
   // Process safe characters in bulk
@@ -461,7 +476,7 @@ GTEXT_CSV_Status csv_stream_process_unquoted_field(GTEXT_CSV_Stream * stream,
     const char * process_input, size_t process_len, size_t * offset,
     size_t byte_pos, char c) {
   // Check field length limit
-  if (stream->field.length >= stream->max_field_bytes) {
+  if (csv_stream_field_length(stream) >= stream->max_field_bytes) {
     return csv_stream_set_error(
         stream, GTEXT_CSV_E_LIMIT, "Maximum field bytes exceeded");
   }
@@ -505,6 +520,45 @@ GTEXT_CSV_Status csv_stream_process_unquoted_field(GTEXT_CSV_Stream * stream,
   return GTEXT_CSV_OK;
 }
 
+// Clamp a run of field content about to be consumed in one step
+// The main loop checks the field, record, and total size limits once per
+// character it dispatches. The run is clamped so that the first byte over a
+// limit is still dispatched on its own and reported exactly as before, and
+// the record size is charged for the bytes the loop did not see.
+size_t csv_stream_limit_bulk_run(GTEXT_CSV_Stream * stream, size_t run) {
+  size_t field_room = stream->max_field_bytes - csv_stream_field_length(stream);
+  if (run > field_room) {
+    run = field_room;
+  }
+  if (stream->total_bytes_consumed < stream->max_total_bytes &&
+      run > stream->max_total_bytes - stream->total_bytes_consumed) {
+    run = stream->max_total_bytes - stream->total_bytes_consumed;
+  }
+  if (stream->in_record) {
+    // The first byte of the run was already counted by the main loop
+    size_t record_room = stream->max_record_bytes > stream->current_record_bytes
+        ? stream->max_record_bytes - stream->current_record_bytes
+        : 0;
+    if (run - 1 > record_room) {
+      run = record_room + 1;
+    }
+    stream->current_record_bytes += run - 1;
+  }
+  return run ? run : 1;
+}
+
+// Make a quoted field that ends at `end` ready to emit
+// Without field views the bytes are buffered; a field view reports a field
+// that has not been buffered in place, so it is left as it is.
+static GTEXT_CSV_Status csv_stream_settle_field(GTEXT_CSV_Stream * stream,
+    const char * process_input, size_t process_len, size_t end) {
+  if (stream->field_views && !stream->field.is_buffered) {
+    return GTEXT_CSV_OK;
+  }
+  return csv_stream_ensure_field_buffered(
+      stream, process_input, process_len, end);
+}
+
 // Process QUOTED_FIELD state
 GTEXT_CSV_Status csv_stream_process_quoted_field(GTEXT_CSV_Stream * stream,
     const char * process_input, size_t process_len, size_t * offset,
@@ -515,7 +569,7 @@ GTEXT_CSV_Status csv_stream_process_quoted_field(GTEXT_CSV_Stream * stream,
     stream->field.length = stream->field.buffer_used;
   }
 
-  if (stream->field.length >= stream->max_field_bytes) {
+  if (csv_stream_field_length(stream) >= stream->max_field_bytes) {
     return csv_stream_set_error(
         stream, GTEXT_CSV_E_LIMIT, "Maximum field bytes exceeded");
   }
@@ -527,7 +581,7 @@ GTEXT_CSV_Status csv_stream_process_quoted_field(GTEXT_CSV_Stream * stream,
       c == stream->opts.dialect.delimiter) {
     // End of quoted field - emit field
     // Ensure field is buffered if needed
-    GTEXT_CSV_Status buffer_status = csv_stream_ensure_field_buffered(
+    GTEXT_CSV_Status buffer_status = csv_stream_settle_field(
         stream, process_input, process_len, *offset);
     if (buffer_status != GTEXT_CSV_OK) {
       return buffer_status;
@@ -552,7 +606,7 @@ GTEXT_CSV_Status csv_stream_process_quoted_field(GTEXT_CSV_Stream * stream,
     else {
       // End of quoted field, end of record
       // Ensure field is buffered if needed
-      GTEXT_CSV_Status ensure_status = csv_stream_ensure_field_buffered(
+      GTEXT_CSV_Status ensure_status = csv_stream_settle_field(
           stream, process_input, process_len, *offset);
       if (ensure_status != GTEXT_CSV_OK) {
         return ensure_status;
@@ -578,12 +632,37 @@ GTEXT_CSV_Status csv_stream_process_quoted_field(GTEXT_CSV_Stream * stream,
   }
 
   if (stream->opts.dialect.escape == GTEXT_CSV_ESCAPE_BACKSLASH && c == '\\') {
+    // The backslash is kept with the field and resolved when it is unescaped
+    if (stream->field.is_buffered) {
+      GTEXT_CSV_Status append_status = csv_stream_append_to_field_buffer(
+          stream, process_input + *offset, 1);
+      if (append_status != GTEXT_CSV_OK) {
+        return append_status;
+      }
+      stream->field.data = stream->field.buffer;
+      stream->field.length = stream->field.buffer_used;
+    }
+    else {
+      if (!stream->field.data) {
+        stream->field.data = process_input + *offset;
+        stream->field.start_offset = *offset;
+        stream->field.length = 0;
+      }
+      stream->field.length++;
+    }
     stream->state = CSV_STREAM_STATE_ESCAPE_IN_QUOTED;
     GTEXT_CSV_Status advance_status =
         csv_stream_advance_position(stream, offset, 1);
     if (advance_status != GTEXT_CSV_OK) {
       return advance_status;
     }
+
+    // A backslash ending the chunk is buffered with the field, since the
+    // chunk may not outlive this call
+    if (*offset >= process_len) {
+      return csv_stream_ensure_field_buffered(
+          stream, process_input, process_len, *offset);
+    }
     return GTEXT_CSV_OK;
   }
 
@@ -628,11 +707,16 @@ GTEXT_CSV_Status csv_stream_process_quoted_field(GTEXT_CSV_Stream * stream,
   // This case is handled by checking if we're at the start of a new chunk with
   // a buffered field. For now, treat delimiter/newline as field content
   // (they're valid inside quoted fields). Regular character in quoted field -
-  // accumulate it
+  // accumulate it together with the run of plain content that follows it
+  size_t run = 1 +
+      csv_stream_scan_quoted_field_ahead(
+          stream, process_input, process_len, *offset + 1);
+  run = csv_stream_limit_bulk_run(stream, run);
+
   if (stream->field.is_buffered) {
     // Append to field buffer
-    GTEXT_CSV_Status append_status =
-        csv_stream_append_to_field_buffer(stream, &c, 1);
+    GTEXT_CSV_Status append_status = csv_stream_append_to_field_buffer(
+        stream, process_input + *offset, run);
     if (append_status != GTEXT_CSV_OK) {
       return append_status;
     }
@@ -646,14 +730,14 @@ GTEXT_CSV_Status csv_stream_process_quoted_field(GTEXT_CSV_Stream * stream,
       stream->field.start_offset = *offset;
       stream->field.length = 0;
     }
-    if (stream->field.length >= SIZE_MAX) {
+    if (stream->field.length > SIZE_MAX - run) {
       return csv_stream_set_error(
           stream, GTEXT_CSV_E_LIMIT, "Field length overflow");
     }
-    stream->field.length++;
+    stream->field.length += run;
   }
   GTEXT_CSV_Status advance_status =
-      csv_stream_advance_position(stream, offset, 1);
+      csv_stream_advance_position(stream, offset, run);
   if (advance_status != GTEXT_CSV_OK) {
     return advance_status;
   }
@@ -679,27 +763,48 @@ GTEXT_CSV_Status csv_stream_process_quote_in_quoted(GTEXT_CSV_Stream * stream,
 
   if (stream->opts.dialect.escape == GTEXT_CSV_ESCAPE_DOUBLED_QUOTE &&
       c == stream->opts.dialect.quote) {
-    // Doubled quote escape - append both quotes to field data
-    // Ensure field is buffered
-    // Buffer up to offset - 1 (before the second quote)
-    GTEXT_CSV_Status status = csv_stream_ensure_field_buffered(
-        stream, process_input, process_len, *offset - 1);
-    if (status != GTEXT_CSV_OK) {
-      return status;
-    }
-
-    // Append both quotes (the one that put us in QUOTE_IN_QUOTED + this one)
     char quote_char = stream->opts.dialect.quote;
-    status = csv_stream_append_to_field_buffer(stream, &quote_char, 1);
-    if (status != GTEXT_CSV_OK) {
-      return status;
+    GTEXT_CSV_Status status;
+    if (stream->field_views && !stream->field.is_buffered) {
+      // A field view keeps both quotes where they are. If the first one
+      // ended the previous chunk, it joins the view's prefix.
+      if (*offset == 0) {
+        size_t used = stream->field.buffer_used;
+        status = csv_field_buffer_grow(&stream->field, used + 1);
+        if (status != GTEXT_CSV_OK) {
+          return status;
+        }
+        stream->field.buffer[used] = quote_char;
+        stream->field.buffer_used = used + 1;
+        stream->field.prefix_len = used + 1;
+        stream->field.length++;
+      }
+      else {
+        stream->field.length += 2;
+      }
     }
-    status = csv_stream_append_to_field_buffer(stream, &quote_char, 1);
-    if (status != GTEXT_CSV_OK) {
-      return status;
+    else {
+      // Doubled quote escape - append both quotes to field data
+      // Ensure field is buffered
+      // Buffer up to offset - 1 (before the second quote)
+      status = csv_stream_ensure_field_buffered(
+          stream, process_input, process_len, *offset - 1);
+      if (status != GTEXT_CSV_OK) {
+        return status;
+      }
+
+      // Append both quotes (the one that put us in QUOTE_IN_QUOTED + this one)
+      status = csv_stream_append_to_field_buffer(stream, &quote_char, 1);
+      if (status != GTEXT_CSV_OK) {
+        return status;
+      }
+      status = csv_stream_append_to_field_buffer(stream, &quote_char, 1);
+      if (status != GTEXT_CSV_OK) {
+        return status;
+      }
+      stream->field.data = stream->field.buffer;
+      stream->field.length = stream->field.buffer_used;
     }
-    stream->field.data = stream->field.buffer;
-    stream->field.length = stream->field.buffer_used;
     // Mark that field needs unescaping (doubled quotes need to be converted to
     // single quotes)
     stream->field.needs_unescape = true;
@@ -709,9 +814,18 @@ GTEXT_CSV_Status csv_stream_process_quote_in_quoted(GTEXT_CSV_Stream * stream,
     stream->just_processed_doubled_quote =
         true; // Mark that we just processed a doubled quote
     stream->quote_in_quoted_at_chunk_boundary = false; // Clear flag
-    // Field is already buffered, so we're good (whether at chunk boundary or
-    // not)
-    return csv_stream_advance_position(stream, offset, 1);
+    status = csv_stream_advance_position(stream, offset, 1);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+
+    // A field view that reaches the end of the chunk is buffered now; any
+    // other field is already buffered
+    if (*offset >= process_len) {
+      return csv_stream_ensure_field_buffered(
+          stream, process_input, process_len, *offset);
+    }
+    return GTEXT_CSV_OK;
   }
 
   if (c == stream->opts.dialect.delimiter) {
@@ -727,7 +841,7 @@ GTEXT_CSV_Status csv_stream_process_quote_in_quoted(GTEXT_CSV_Stream * stream,
         stream->opts.dialect.escape == GTEXT_CSV_ESCAPE_DOUBLED_QUOTE) {
       bool is_empty = stream->field.is_buffered
           ? (stream->field.buffer_used == 0)
-          : (stream->field.length == 0);
+          : (csv_stream_field_length(stream) == 0);
       if (is_empty) {
         // Treat as doubled quote - ensure buffer is ready
         if (!stream->field.is_buffered) {
@@ -759,7 +873,7 @@ GTEXT_CSV_Status csv_stream_process_quote_in_quoted(GTEXT_CSV_Stream * stream,
 
     // Ensure field is buffered if needed
     // Buffer up to (but not including) the quote position
-    GTEXT_CSV_Status status = csv_stream_ensure_field_buffered(
+    GTEXT_CSV_Status status = csv_stream_settle_field(
         stream, process_input, process_len, quote_pos);
     if (status != GTEXT_CSV_OK) {
       return status;
@@ -786,7 +900,7 @@ GTEXT_CSV_Status csv_stream_process_quote_in_quoted(GTEXT_CSV_Stream * stream,
     // End of quoted field, end of record
     // Ensure field is buffered if needed
     // Buffer up to (but not including) the quote position
-    status = csv_stream_ensure_field_buffered(
+    status = csv_stream_settle_field(
         stream, process_input, process_len, quote_pos);
     if (status != GTEXT_CSV_OK) {
       return status;
@@ -841,18 +955,11 @@ GTEXT_CSV_Status csv_stream_process_escape_in_quoted(GTEXT_CSV_Stream * stream,
   stream->field.needs_unescape = true;
   stream->state = CSV_STREAM_STATE_QUOTED_FIELD;
 
-  // Append escaped character to field buffer
+  // Keep the escaped character after its backslash; the pair is resolved
+  // when the field is unescaped
   if (stream->field.is_buffered) {
-    char escaped_char = c;
-    if (c == 'n')
-      escaped_char = '\n';
-    else if (c == 'r')
-      escaped_char = '\r';
-    else if (c == 't')
-      escaped_char = '\t';
-    // '\\' and '"' stay as-is
-    GTEXT_CSV_Status status =
-        csv_stream_append_to_field_buffer(stream, &escaped_char, 1);
+    GTEXT_CSV_Status status = csv_stream_append_to_field_buffer(
+        stream, process_input + *offset, 1);
     if (status != GTEXT_CSV_OK) {
       return status;
     }
@@ -860,13 +967,7 @@ GTEXT_CSV_Status csv_stream_process_escape_in_quoted(GTEXT_CSV_Stream * stream,
     stream->field.length = stream->field.buffer_used;
   }
   else {
-    // If not buffered, we need to buffer when we see escape sequences
-    // since we need to transform them
-    if (!stream->field.data) {
-      csv_field_buffer_set_from_input(
-          &stream->field, process_input + *offset - 1, 0, true, *offset - 1);
-    }
-    stream->field.length += 2; // Backslash + escaped char
+    stream->field.length++;
   }
 
   GTEXT_CSV_Status status = csv_stream_advance_position(stream, offset, 1);
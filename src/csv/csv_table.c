@@ -11,11 +11,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../text_simd.h"
 #include "csv_internal.h"
 #include <ghoti.io/text/csv/csv_core.h>
 #include <ghoti.io/text/csv/csv_stream.h>
 #include <ghoti.io/text/csv/csv_table.h>
 #include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 // Global empty string constant for all empty fields
 // This avoids allocating 1 byte per empty field in the arena
@@ -132,6 +135,54 @@ static void csv_arena_free(csv_arena * arena) {
   free(arena);
 }
 
+// Move every block of src into dst and free the src arena structure
+// Blocks are linked in front of dst's chain so dst->current stays the tail
+// that later allocations extend
+static void csv_arena_absorb(csv_arena * dst, csv_arena * src) {
+  if (src->first) {
+    csv_arena_block * last = src->first;
+    while (last->next) {
+      last = last->next;
+    }
+    last->next = dst->first;
+    dst->first = src->first;
+    if (!dst->current) {
+      dst->current = last;
+    }
+  }
+  free(src);
+}
+
+// Current allocation position of an arena
+static csv_arena_mark csv_arena_get_mark(const csv_arena * arena) {
+  csv_arena_mark mark = {arena->current, 0};
+  if (arena->current) {
+    mark.used = arena->current->used;
+  }
+  return mark;
+}
+
+// Release everything allocated since mark was taken
+// Blocks started after the mark are freed; the arena must not have absorbed
+// other arenas in between
+static void csv_arena_reset(csv_arena * arena, csv_arena_mark mark) {
+  csv_arena_block * block = mark.block ? mark.block->next : arena->first;
+  while (block) {
+    csv_arena_block * next = block->next;
+    free(block);
+    block = next;
+  }
+
+  if (mark.block) {
+    mark.block->next = NULL;
+    mark.block->used = mark.used;
+  }
+  else {
+    arena->first = NULL;
+  }
+  arena->current = mark.block;
+}
+
 // Create a new CSV context with arena
 GTEXT_INTERNAL_API csv_context * csv_context_new(void) {
   csv_context * ctx = malloc(sizeof(csv_context));
@@ -200,6 +251,659 @@ GTEXT_INTERNAL_API void * csv_arena_alloc_for_context(
   return csv_arena_alloc(ctx->arena, size, align);
 }
 
+// Order pointers by address (qsort() and bsearch() comparator)
+static int csv_pointer_cmp(const void * a, const void * b) {
+  uintptr_t pa = (uintptr_t)*(const void * const *)a;
+  uintptr_t pb = (uintptr_t)*(const void * const *)b;
+  return (pa > pb) - (pa < pb);
+}
+
+// Collect the blocks of an arena sorted by address
+// *blocks_out is NULL for an arena without blocks
+static GTEXT_CSV_Status csv_arena_sorted_blocks(const csv_arena * arena,
+    csv_arena_block *** blocks_out, size_t * count_out) {
+  size_t count = 0;
+  for (const csv_arena_block * block = arena->first; block;
+      block = block->next) {
+    count++;
+  }
+
+  csv_arena_block ** blocks = NULL;
+  if (count > 0) {
+    blocks = (csv_arena_block **)malloc(sizeof(csv_arena_block *) * count);
+    if (!blocks) {
+      return GTEXT_CSV_E_OOM;
+    }
+    size_t i = 0;
+    for (csv_arena_block * block = arena->first; block; block = block->next) {
+      blocks[i++] = block;
+    }
+    qsort(blocks, count, sizeof(csv_arena_block *), csv_pointer_cmp);
+  }
+
+  *blocks_out = blocks;
+  *count_out = count;
+  return GTEXT_CSV_OK;
+}
+
+// Whether ptr points into the used part of one of blocks (sorted by
+// address)
+static bool csv_arena_blocks_contain(
+    csv_arena_block * const * blocks, size_t count, const void * ptr) {
+  uintptr_t p = (uintptr_t)ptr;
+  size_t lo = 0;
+  size_t hi = count;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if ((uintptr_t)blocks[mid]->data <= p) {
+      lo = mid + 1;
+    }
+    else {
+      hi = mid;
+    }
+  }
+  if (lo == 0) {
+    return false;
+  }
+  const csv_arena_block * block = blocks[lo - 1];
+  return p < (uintptr_t)(block->data + block->used);
+}
+
+// ============================================================================
+// Copy-on-write sharing
+// ============================================================================
+
+// Storage shared by gtext_csv_clone_cow() clones
+// Cloning retires the source's arena into a share together with the row
+// blocks the source owned, and the source and the clone both read from it.
+// Nothing is allocated from a share or written to it; a table copies a row
+// block or field array out of its shares before writing it. Cloning a table
+// that already reads from a share makes a new share whose parent is the old
+// one.
+struct csv_table_share {
+  atomic_size_t refs;               // Tables and newer shares using it
+  csv_arena * arena;                // Retired arena
+  csv_arena_block ** arena_blocks;  // Blocks of arena sorted by address
+  size_t arena_block_count;         // Entries in arena_blocks
+  csv_table_row ** row_blocks;      // Owned row blocks sorted by address
+  size_t row_block_count;           // Entries in row_blocks
+  struct csv_table_share * parent;  // Older share (NULL if none)
+};
+
+// Whether ptr points into an arena of share or its parents
+static bool csv_table_share_owns(
+    const csv_table_share * share, const void * ptr) {
+  for (; share; share = share->parent) {
+    if (csv_arena_blocks_contain(
+            share->arena_blocks, share->arena_block_count, ptr)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Whether a row block belongs to share or its parents
+static bool csv_table_share_has_block(
+    const csv_table_share * share, const csv_table_row * block) {
+  for (; share; share = share->parent) {
+    if (share->row_block_count > 0 &&
+        bsearch(&block, share->row_blocks, share->row_block_count,
+            sizeof(csv_table_row *), csv_pointer_cmp)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Drop one reference to a share, freeing it (and then its parent) when it
+// was the last
+static void csv_table_share_release(csv_table_share * share) {
+  while (share && atomic_fetch_sub(&share->refs, 1) == 1) {
+    csv_table_share * parent = share->parent;
+    for (size_t i = 0; i < share->row_block_count; i++) {
+      free(share->row_blocks[i]);
+    }
+    free(share->row_blocks);
+    free(share->arena_blocks);
+    csv_arena_free(share->arena);
+    free(share);
+    share = parent;
+  }
+}
+
+// Free a row block the table no longer uses, unless a share owns it
+static void csv_table_free_row_block(
+    GTEXT_CSV_Table * table, csv_table_row * block) {
+  if (!csv_table_share_has_block(table->share, block)) {
+    free(block);
+  }
+}
+
+// Give up a running incremental compaction
+// Rows past the cursor may still point into the retired arena, so its blocks
+// are handed back to the table's arena
+static void csv_table_compaction_abandon(GTEXT_CSV_Table * table) {
+  csv_table_compaction * comp = table->compaction;
+  if (!comp) {
+    return;
+  }
+  csv_arena_absorb(table->ctx->arena, comp->from);
+  free(comp->blocks);
+  free(comp);
+  table->compaction = NULL;
+}
+
+// Move the compaction cursor back to a row whose position changed
+GTEXT_INTERNAL_API void csv_table_compaction_rows_moved(
+    GTEXT_CSV_Table * table, size_t first_row) {
+  if (table->compaction && first_row < table->compaction->next_row) {
+    table->compaction->next_row = first_row;
+  }
+}
+
+// ============================================================================
+// Row block storage
+// ============================================================================
+
+// Grow the block directory (and the block counts and tree of an indexed
+// table) to hold at least block_count blocks
+static GTEXT_CSV_Status csv_table_reserve_row_directory(
+    GTEXT_CSV_Table * table, size_t block_count) {
+  if (block_count <= table->row_block_capacity) {
+    return GTEXT_CSV_OK;
+  }
+
+  size_t capacity = table->row_block_capacity ? table->row_block_capacity : 4;
+  while (capacity < block_count) {
+    if (capacity > SIZE_MAX / 2 / sizeof(csv_table_row *) - 1) {
+      return GTEXT_CSV_E_OOM;
+    }
+    capacity *= 2;
+  }
+  csv_table_row ** blocks = (csv_table_row **)realloc(
+      table->row_blocks, sizeof(csv_table_row *) * capacity);
+  if (!blocks) {
+    return GTEXT_CSV_E_OOM;
+  }
+  table->row_blocks = blocks;
+
+  if (table->row_block_tree) {
+    size_t * counts = (size_t *)realloc(
+        table->row_block_counts, sizeof(size_t) * capacity);
+    if (!counts) {
+      return GTEXT_CSV_E_OOM;
+    }
+    table->row_block_counts = counts;
+    size_t * tree = (size_t *)realloc(
+        table->row_block_tree, sizeof(size_t) * (capacity + 1));
+    if (!tree) {
+      return GTEXT_CSV_E_OOM;
+    }
+    table->row_block_tree = tree;
+  }
+
+  // Only raised once every array has the new size
+  table->row_block_capacity = capacity;
+  return GTEXT_CSV_OK;
+}
+
+// Add an empty block at the end of the directory
+static GTEXT_CSV_Status csv_table_add_row_block(GTEXT_CSV_Table * table) {
+  if (table->row_block_count == SIZE_MAX ||
+      csv_table_reserve_row_directory(table, table->row_block_count + 1) !=
+          GTEXT_CSV_OK) {
+    return GTEXT_CSV_E_OOM;
+  }
+  csv_table_row * block =
+      (csv_table_row *)malloc(sizeof(csv_table_row) * CSV_ROW_BLOCK_ROWS);
+  if (!block) {
+    return GTEXT_CSV_E_OOM;
+  }
+  if (table->row_block_tree) {
+    table->row_block_counts[table->row_block_count] = 0;
+  }
+  table->row_blocks[table->row_block_count++] = block;
+  table->row_capacity += CSV_ROW_BLOCK_ROWS;
+  return GTEXT_CSV_OK;
+}
+
+// Make room for at least row_count rows in a packed table
+// Adds whole blocks; rows already stored never move. A failure part way
+// leaves the blocks added so far in place, which is harmless
+static GTEXT_CSV_Status csv_table_reserve_rows(
+    GTEXT_CSV_Table * table, size_t row_count) {
+  while (table->row_capacity < row_count) {
+    if (table->row_capacity > SIZE_MAX - CSV_ROW_BLOCK_ROWS ||
+        csv_table_add_row_block(table) != GTEXT_CSV_OK) {
+      return GTEXT_CSV_E_OOM;
+    }
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Rebuild the Fenwick tree of an indexed table from its block counts
+static void csv_table_rebuild_row_tree(GTEXT_CSV_Table * table) {
+  size_t n = table->row_block_count;
+  size_t * tree = table->row_block_tree;
+  for (size_t i = 1; i <= n; i++) {
+    tree[i] = table->row_block_counts[i - 1];
+  }
+  for (size_t i = 1; i <= n; i++) {
+    size_t parent = i + (i & (~i + 1));
+    if (parent <= n) {
+      tree[parent] += tree[i];
+    }
+  }
+}
+
+// Add one row to (grow) or remove one row from a block's count
+static void csv_table_update_row_tree(
+    GTEXT_CSV_Table * table, size_t block, bool grow) {
+  size_t n = table->row_block_count;
+  if (grow) {
+    table->row_block_counts[block]++;
+    for (size_t i = block + 1; i <= n; i += i & (~i + 1)) {
+      table->row_block_tree[i]++;
+    }
+  }
+  else {
+    table->row_block_counts[block]--;
+    for (size_t i = block + 1; i <= n; i += i & (~i + 1)) {
+      table->row_block_tree[i]--;
+    }
+  }
+}
+
+// Block and slot holding row row_idx of an indexed table
+// Descends the Fenwick tree to the last block whose preceding blocks hold at
+// most row_idx rows; empty blocks are skipped over
+static void csv_table_find_row(const GTEXT_CSV_Table * table, size_t row_idx,
+    size_t * block_out, size_t * slot_out) {
+  size_t n = table->row_block_count;
+  size_t step = 1;
+  while (step <= n / 2) {
+    step *= 2;
+  }
+
+  size_t pos = 0;
+  for (; step > 0; step /= 2) {
+    if (pos + step <= n && table->row_block_tree[pos + step] <= row_idx) {
+      pos += step;
+      row_idx -= table->row_block_tree[pos];
+    }
+  }
+  *block_out = pos;
+  *slot_out = row_idx;
+}
+
+GTEXT_INTERNAL_API csv_table_row * csv_table_locate_row(
+    const GTEXT_CSV_Table * table, size_t row_idx) {
+  size_t block;
+  size_t slot;
+  csv_table_find_row(table, row_idx, &block, &slot);
+  return &table->row_blocks[block][slot];
+}
+
+// Switch a packed table to indexed blocks
+// Leaves the table packed on failure
+static GTEXT_CSV_Status csv_table_index_rows(GTEXT_CSV_Table * table) {
+  if (table->row_block_tree) {
+    return GTEXT_CSV_OK;
+  }
+
+  // One extra entry keeps the allocation non-empty for a table without blocks
+  size_t capacity = table->row_block_capacity;
+  size_t * counts = (size_t *)malloc(sizeof(size_t) * (capacity + 1));
+  size_t * tree = (size_t *)malloc(sizeof(size_t) * (capacity + 1));
+  if (!counts || !tree) {
+    free(counts);
+    free(tree);
+    return GTEXT_CSV_E_OOM;
+  }
+
+  size_t remaining = table->row_count;
+  for (size_t b = 0; b < table->row_block_count; b++) {
+    counts[b] = remaining < CSV_ROW_BLOCK_ROWS ? remaining : CSV_ROW_BLOCK_ROWS;
+    remaining -= counts[b];
+  }
+  table->row_block_counts = counts;
+  table->row_block_tree = tree;
+  csv_table_rebuild_row_tree(table);
+  return GTEXT_CSV_OK;
+}
+
+// Switch an indexed table back to packed addressing
+// The caller must rewrite the rows in packed order (see csv_table_store_rows)
+static void csv_table_unindex_rows(GTEXT_CSV_Table * table) {
+  free(table->row_block_counts);
+  free(table->row_block_tree);
+  table->row_block_counts = NULL;
+  table->row_block_tree = NULL;
+}
+
+// Move the empty block at from to the end of the directory
+static void csv_table_retire_row_block(GTEXT_CSV_Table * table, size_t from) {
+  size_t last = table->row_block_count - 1;
+  csv_table_row * block = table->row_blocks[from];
+  memmove(&table->row_blocks[from], &table->row_blocks[from + 1],
+      sizeof(csv_table_row *) * (last - from));
+  memmove(&table->row_block_counts[from], &table->row_block_counts[from + 1],
+      sizeof(size_t) * (last - from));
+  table->row_blocks[last] = block;
+  table->row_block_counts[last] = 0;
+}
+
+// Give the table its own copy of row block b if a share owns it
+static GTEXT_CSV_Status csv_table_own_row_block(
+    GTEXT_CSV_Table * table, size_t b) {
+  const csv_table_row * block = table->row_blocks[b];
+  if (!csv_table_share_has_block(table->share, block)) {
+    return GTEXT_CSV_OK;
+  }
+  csv_table_row * copy =
+      (csv_table_row *)malloc(sizeof(csv_table_row) * CSV_ROW_BLOCK_ROWS);
+  if (!copy) {
+    return GTEXT_CSV_E_OOM;
+  }
+  memcpy(copy, block, sizeof(csv_table_row) * CSV_ROW_BLOCK_ROWS);
+  table->row_blocks[b] = copy;
+  return GTEXT_CSV_OK;
+}
+
+// Copy the row block and field array of row row_idx out of the table's shares
+// so the row can be written in place
+static GTEXT_CSV_Status csv_table_own_row(
+    GTEXT_CSV_Table * table, size_t row_idx) {
+  if (!table->share || table->columns) {
+    return GTEXT_CSV_OK;
+  }
+
+  size_t block = row_idx >> CSV_ROW_BLOCK_SHIFT;
+  size_t slot = row_idx & (CSV_ROW_BLOCK_ROWS - 1);
+  if (table->row_block_tree) {
+    csv_table_find_row(table, row_idx, &block, &slot);
+  }
+  GTEXT_CSV_Status status = csv_table_own_row_block(table, block);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+
+  csv_table_row * row = &table->row_blocks[block][slot];
+  if (row->field_count > 0 && csv_table_share_owns(table->share, row->fields)) {
+    csv_table_field * fields = (csv_table_field *)csv_arena_alloc_for_context(
+        table->ctx, sizeof(csv_table_field) * row->field_count, 8);
+    if (!fields) {
+      return GTEXT_CSV_E_OOM;
+    }
+    memcpy(fields, row->fields, sizeof(csv_table_field) * row->field_count);
+    row->fields = fields;
+  }
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_INTERNAL_API GTEXT_CSV_Status csv_table_unshare(GTEXT_CSV_Table * table) {
+  if (!table->share || table->columns) {
+    return GTEXT_CSV_OK;
+  }
+  for (size_t b = 0; b < table->row_block_count; b++) {
+    GTEXT_CSV_Status status = csv_table_own_row_block(table, b);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+  }
+  for (size_t i = 0; i < table->row_count; i++) {
+    GTEXT_CSV_Status status = csv_table_own_row(table, i);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Copy the row blocks a row insert at row_idx writes (the block the row goes
+// into and the spare block a split fills) out of the table's shares
+// Mirrors the block choice of csv_table_insert_row_slot()
+static GTEXT_CSV_Status csv_table_own_insert_blocks(
+    GTEXT_CSV_Table * table, size_t row_idx) {
+  if (!table->share) {
+    return GTEXT_CSV_OK;
+  }
+  if (!table->row_block_tree) {
+    return csv_table_own_row_block(table, row_idx >> CSV_ROW_BLOCK_SHIFT);
+  }
+
+  size_t block = 0;
+  size_t slot = 0;
+  if (row_idx < table->row_count) {
+    csv_table_find_row(table, row_idx, &block, &slot);
+  }
+  else if (table->row_count > 0) {
+    csv_table_find_row(table, row_idx - 1, &block, &slot);
+  }
+  GTEXT_CSV_Status status = csv_table_own_row_block(table, block);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+  return csv_table_own_row_block(table, table->row_block_count - 1);
+}
+
+// Copy the row block a removal of row row_idx writes out of the table's
+// shares
+// The table is indexed first, so csv_table_remove_row_slot() only shifts
+// rows within that block
+static GTEXT_CSV_Status csv_table_own_remove_block(
+    GTEXT_CSV_Table * table, size_t row_idx) {
+  if (!table->share ||
+      (!table->row_block_tree && row_idx + 1 == table->row_count)) {
+    return GTEXT_CSV_OK;
+  }
+  GTEXT_CSV_Status status = csv_table_index_rows(table);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+  size_t block;
+  size_t slot;
+  csv_table_find_row(table, row_idx, &block, &slot);
+  return csv_table_own_row_block(table, block);
+}
+
+// Allocate what inserting a row at row_idx needs, so the insert itself
+// cannot fail
+// Appending to a packed table only reserves a slot; any other position
+// indexes the table and makes sure an empty block is spare at the end of the
+// directory for a split
+static GTEXT_CSV_Status csv_table_prepare_row_insert(
+    GTEXT_CSV_Table * table, size_t row_idx) {
+  if (table->row_count == SIZE_MAX) {
+    return GTEXT_CSV_E_OOM;
+  }
+  if (!table->row_block_tree && row_idx == table->row_count) {
+    GTEXT_CSV_Status status =
+        csv_table_reserve_rows(table, table->row_count + 1);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+    return csv_table_own_insert_blocks(table, row_idx);
+  }
+
+  GTEXT_CSV_Status status = csv_table_index_rows(table);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+  size_t n = table->row_block_count;
+  if (n == 0 || table->row_block_counts[n - 1] != 0) {
+    status = csv_table_add_row_block(table);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+    csv_table_rebuild_row_tree(table);
+  }
+  return csv_table_own_insert_blocks(table, row_idx);
+}
+
+// Open a slot for a new row at row_idx (row_count is not changed)
+// Requires a successful csv_table_prepare_row_insert() for row_idx
+static csv_table_row * csv_table_insert_row_slot(
+    GTEXT_CSV_Table * table, size_t row_idx) {
+  // The new row is allocated in the new arena, so a running compaction skips
+  // it and stays on the row it was about to visit
+  if (table->compaction && row_idx < table->compaction->next_row) {
+    table->compaction->next_row++;
+  }
+
+  if (!table->row_block_tree) {
+    return csv_table_row_at(table, row_idx);
+  }
+
+  // Find the block to insert into; an append goes after the last row
+  size_t block = 0;
+  size_t slot = 0;
+  if (row_idx < table->row_count) {
+    csv_table_find_row(table, row_idx, &block, &slot);
+  }
+  else if (table->row_count > 0) {
+    csv_table_find_row(table, row_idx - 1, &block, &slot);
+    slot++;
+  }
+
+  size_t count = table->row_block_counts[block];
+  if (count == CSV_ROW_BLOCK_ROWS) {
+    // Split: the spare block at the end moves in after the full block and
+    // takes its upper half, or nothing when the new row goes at its end
+    size_t last = table->row_block_count - 1;
+    csv_table_row * spare = table->row_blocks[last];
+    memmove(&table->row_blocks[block + 2], &table->row_blocks[block + 1],
+        sizeof(csv_table_row *) * (last - block - 1));
+    memmove(&table->row_block_counts[block + 2],
+        &table->row_block_counts[block + 1],
+        sizeof(size_t) * (last - block - 1));
+    table->row_blocks[block + 1] = spare;
+
+    size_t keep = slot == CSV_ROW_BLOCK_ROWS ? CSV_ROW_BLOCK_ROWS
+                                             : CSV_ROW_BLOCK_ROWS / 2;
+    memcpy(spare, &table->row_blocks[block][keep],
+        sizeof(csv_table_row) * (CSV_ROW_BLOCK_ROWS - keep));
+    table->row_block_counts[block] = keep;
+    table->row_block_counts[block + 1] = CSV_ROW_BLOCK_ROWS - keep;
+    csv_table_rebuild_row_tree(table);
+    if (slot >= keep) {
+      block++;
+      slot -= keep;
+    }
+    count = table->row_block_counts[block];
+  }
+
+  csv_table_row * rows = table->row_blocks[block];
+  memmove(&rows[slot + 1], &rows[slot], sizeof(csv_table_row) * (count - slot));
+  csv_table_update_row_tree(table, block, true);
+  return &rows[slot];
+}
+
+// Move rows (row_idx, row_count) one slot left over row_idx in a packed table
+static void csv_table_close_row_gap(GTEXT_CSV_Table * table, size_t row_idx) {
+  size_t end = table->row_count - 1;
+  size_t first = row_idx >> CSV_ROW_BLOCK_SHIFT;
+  size_t last = end >> CSV_ROW_BLOCK_SHIFT;
+
+  for (size_t b = first;; b++) {
+    csv_table_row * block = table->row_blocks[b];
+    size_t lo = b == first ? row_idx & (CSV_ROW_BLOCK_ROWS - 1) : 0;
+    size_t hi = b == last ? end & (CSV_ROW_BLOCK_ROWS - 1)
+                          : CSV_ROW_BLOCK_ROWS - 1;
+    memmove(&block[lo], &block[lo + 1], sizeof(csv_table_row) * (hi - lo));
+    if (b == last) {
+      break;
+    }
+    block[CSV_ROW_BLOCK_ROWS - 1] = table->row_blocks[b + 1][0];
+  }
+}
+
+// Remove the slot of row row_idx (row_count is not changed)
+// Removing any row but the last indexes the table; if that allocation fails
+// the rows are shifted in packed order instead, so removal never fails
+static void csv_table_remove_row_slot(GTEXT_CSV_Table * table, size_t row_idx) {
+  if (table->compaction && row_idx < table->compaction->next_row) {
+    table->compaction->next_row--;
+  }
+
+  if (!table->row_block_tree) {
+    if (row_idx + 1 == table->row_count) {
+      return;
+    }
+    if (csv_table_index_rows(table) != GTEXT_CSV_OK) {
+      csv_table_close_row_gap(table, row_idx);
+      return;
+    }
+  }
+
+  size_t block;
+  size_t slot;
+  csv_table_find_row(table, row_idx, &block, &slot);
+  csv_table_row * rows = table->row_blocks[block];
+  size_t count = table->row_block_counts[block];
+  memmove(&rows[slot], &rows[slot + 1],
+      sizeof(csv_table_row) * (count - slot - 1));
+  csv_table_update_row_tree(table, block, false);
+
+  // Retire an emptied block, or fold the next block into this one when both
+  // fit in half a block, so blocks stay reasonably full
+  size_t n = table->row_block_count;
+  count--;
+  if (count == 0 && n > 1) {
+    csv_table_retire_row_block(table, block);
+    csv_table_rebuild_row_tree(table);
+  }
+  else if (block + 1 < n && table->row_block_counts[block + 1] > 0 &&
+      count + table->row_block_counts[block + 1] <= CSV_ROW_BLOCK_ROWS / 2) {
+    size_t next = table->row_block_counts[block + 1];
+    memcpy(&rows[count], table->row_blocks[block + 1],
+        sizeof(csv_table_row) * next);
+    table->row_block_counts[block] += next;
+    table->row_block_counts[block + 1] = 0;
+    csv_table_retire_row_block(table, block + 1);
+    csv_table_rebuild_row_tree(table);
+  }
+}
+
+// Free the blocks that hold no rows in a packed table, keeping one block of
+// spare slots
+static void csv_table_trim_rows(GTEXT_CSV_Table * table) {
+  size_t keep = (table->row_count >> CSV_ROW_BLOCK_SHIFT) + 1;
+  while (table->row_block_count > keep) {
+    csv_table_free_row_block(
+        table, table->row_blocks[--table->row_block_count]);
+    table->row_capacity -= CSV_ROW_BLOCK_ROWS;
+  }
+}
+
+// Free all row blocks and the block directory
+static void csv_table_free_rows(GTEXT_CSV_Table * table) {
+  for (size_t i = 0; i < table->row_block_count; i++) {
+    csv_table_free_row_block(table, table->row_blocks[i]);
+  }
+  free(table->row_blocks);
+  csv_table_unindex_rows(table);
+  table->row_blocks = NULL;
+  table->row_block_count = 0;
+  table->row_block_capacity = 0;
+  table->row_capacity = 0;
+}
+
+// Copy count staged rows into the table starting at row 0, packing the
+// blocks
+// Requires row_capacity >= count, which always holds for the table's own
+// row_count
+static void csv_table_store_rows(
+    GTEXT_CSV_Table * table, const csv_table_row * rows, size_t count) {
+  csv_table_unindex_rows(table);
+  for (size_t done = 0; done < count; done += CSV_ROW_BLOCK_ROWS) {
+    size_t n = count - done < CSV_ROW_BLOCK_ROWS ? count - done
+                                                 : CSV_ROW_BLOCK_ROWS;
+    memcpy(table->row_blocks[done >> CSV_ROW_BLOCK_SHIFT], rows + done,
+        sizeof(csv_table_row) * n);
+  }
+}
+
 // ============================================================================
 // Helper functions for field operations
 // ============================================================================
@@ -297,6 +1001,11 @@ static GTEXT_CSV_Status csv_column_op_alloc_temp_arrays(
 static void csv_column_op_cleanup_temp_arrays(
     csv_column_op_temp_arrays * temp_arrays);
 
+// Forward declarations for column-major storage helpers
+static GTEXT_CSV_Table * csv_create_empty_table(GTEXT_CSV_Error * err);
+static void csv_header_map_reindex_increment(
+    GTEXT_CSV_Table * table, size_t start_index);
+
 static GTEXT_CSV_Status csv_allocate_and_copy_field(csv_context * ctx,
     const char * field_data, size_t field_len, csv_table_field * field_out) {
   // Check for overflow in field_len + 1
@@ -539,68 +1248,1165 @@ static GTEXT_CSV_Status csv_rebuild_index_to_entry(GTEXT_CSV_Table * table) {
   return GTEXT_CSV_OK;
 }
 
-// Event callback for building table from stream
-static GTEXT_CSV_Status csv_table_event_callback(
-    const GTEXT_CSV_Event * event, void * user_data) {
-  csv_table_parse_context * ctx = (csv_table_parse_context *)user_data;
-  GTEXT_CSV_Table * table = ctx->table;
+// ============================================================================
+// Column-major storage
+// ============================================================================
 
-  switch (event->type) {
-  case GTEXT_CSV_EVENT_RECORD_BEGIN: {
-    // Allocate new row
-    if (table->row_count >= table->row_capacity) {
-      size_t new_capacity = table->row_capacity * 2;
-      if (new_capacity < table->row_capacity) {
-        ctx->status = GTEXT_CSV_E_OOM;
-        return GTEXT_CSV_E_OOM;
-      }
-      csv_table_row * new_rows = (csv_table_row *)csv_arena_alloc_for_context(
-          table->ctx, sizeof(csv_table_row) * new_capacity, 8);
-      if (!new_rows) {
-        ctx->status = GTEXT_CSV_E_OOM;
-        return GTEXT_CSV_E_OOM;
-      }
-      memcpy(new_rows, table->rows, sizeof(csv_table_row) * table->row_count);
-      table->rows = new_rows;
-      table->row_capacity = new_capacity;
-    }
+// Initial heap size and row capacity of new column-major storage
+#define CSV_COLUMNS_INITIAL_HEAP 4096
+#define CSV_COLUMNS_INITIAL_ROWS 16
 
-    ctx->current_row = &table->rows[table->row_count];
-    ctx->current_row->fields = NULL;
-    ctx->current_row->field_count = 0;
-    ctx->current_field_index = 0;
-    ctx->current_field_capacity = 0;
-    return GTEXT_CSV_OK;
+// Create empty column-major storage with its heap in ctx's arena
+// The heap starts with the shared empty cell at offset 0
+static csv_table_columns * csv_columns_new(csv_context * ctx) {
+  csv_table_columns * cols =
+      (csv_table_columns *)calloc(1, sizeof(csv_table_columns));
+  if (!cols) {
+    return NULL;
   }
 
-  case GTEXT_CSV_EVENT_FIELD: {
-    if (!ctx->current_row) {
-      ctx->status = GTEXT_CSV_E_INVALID;
-      return GTEXT_CSV_E_INVALID;
-    }
+  cols->heap =
+      (char *)csv_arena_alloc_for_context(ctx, CSV_COLUMNS_INITIAL_HEAP, 1);
+  cols->widths = (size_t *)calloc(CSV_COLUMNS_INITIAL_ROWS, sizeof(size_t));
+  if (!cols->heap || !cols->widths) {
+    free(cols->widths);
+    free(cols);
+    return NULL;
+  }
+  cols->heap[0] = '\0';
+  cols->heap_len = 1;
+  cols->heap_capacity = CSV_COLUMNS_INITIAL_HEAP;
+  cols->row_capacity = CSV_COLUMNS_INITIAL_ROWS;
+
+  return cols;
+}
+
+// Free column-major storage
+static void csv_columns_free(csv_table_columns * cols) {
+  if (!cols) {
+    return;
+  }
+
+  for (size_t i = 0; i < cols->column_capacity; i++) {
+    free(cols->columns[i].offsets);
+    free(cols->columns[i].lengths);
+  }
+  free(cols->columns);
+  free(cols->widths);
+  free(cols);
+}
+
+// Allocate the offset and length arrays of one column (all empty cells)
+static GTEXT_CSV_Status csv_columns_alloc_column(
+    const csv_table_columns * cols, csv_table_column * column) {
+  column->offsets = (size_t *)calloc(cols->row_capacity, sizeof(size_t));
+  column->lengths = (size_t *)calloc(cols->row_capacity, sizeof(size_t));
+  if (!column->offsets || !column->lengths) {
+    free(column->offsets);
+    free(column->lengths);
+    column->offsets = NULL;
+    column->lengths = NULL;
+    return GTEXT_CSV_E_OOM;
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Grow the columns array to hold at least column_count entries
+static GTEXT_CSV_Status csv_columns_reserve_columns(
+    csv_table_columns * cols, size_t column_count) {
+  if (column_count <= cols->column_capacity) {
+    return GTEXT_CSV_OK;
+  }
+
+  size_t new_capacity = cols->column_capacity ? cols->column_capacity : 16;
+  while (new_capacity < column_count) {
+    if (new_capacity > SIZE_MAX / 2 / sizeof(csv_table_column)) {
+      return GTEXT_CSV_E_OOM;
+    }
+    new_capacity *= 2;
+  }
+
+  csv_table_column * columns = (csv_table_column *)realloc(
+      cols->columns, sizeof(csv_table_column) * new_capacity);
+  if (!columns) {
+    return GTEXT_CSV_E_OOM;
+  }
+  memset(columns + cols->column_capacity, 0,
+      sizeof(csv_table_column) * (new_capacity - cols->column_capacity));
+  cols->columns = columns;
+  cols->column_capacity = new_capacity;
+  return GTEXT_CSV_OK;
+}
+
+// Append empty columns until column_count columns are stored
+static GTEXT_CSV_Status csv_columns_add_columns(
+    csv_table_columns * cols, size_t column_count) {
+  GTEXT_CSV_Status status = csv_columns_reserve_columns(cols, column_count);
+  while (status == GTEXT_CSV_OK && cols->column_count < column_count) {
+    status = csv_columns_alloc_column(cols, &cols->columns[cols->column_count]);
+    if (status == GTEXT_CSV_OK) {
+      cols->column_count++;
+    }
+  }
+  return status;
+}
+
+// Grow every row-indexed array to hold at least row_count rows
+// New slots hold the empty cell and a width of 0
+static GTEXT_CSV_Status csv_columns_reserve_rows(
+    csv_table_columns * cols, size_t row_count) {
+  if (row_count <= cols->row_capacity) {
+    return GTEXT_CSV_OK;
+  }
+
+  size_t old_capacity = cols->row_capacity;
+  size_t new_capacity = old_capacity;
+  while (new_capacity < row_count) {
+    if (new_capacity > SIZE_MAX / 2 / sizeof(size_t)) {
+      return GTEXT_CSV_E_OOM;
+    }
+    new_capacity *= 2;
+  }
+  size_t new_size = sizeof(size_t) * new_capacity;
+  size_t tail_size = sizeof(size_t) * (new_capacity - old_capacity);
+
+  // A failure part way leaves some arrays larger than row_capacity, which is
+  // harmless: the next call grows them again from row_capacity
+  size_t * widths = (size_t *)realloc(cols->widths, new_size);
+  if (!widths) {
+    return GTEXT_CSV_E_OOM;
+  }
+  memset(widths + old_capacity, 0, tail_size);
+  cols->widths = widths;
+
+  for (size_t i = 0; i < cols->column_count; i++) {
+    csv_table_column * column = &cols->columns[i];
+    size_t * offsets = (size_t *)realloc(column->offsets, new_size);
+    if (!offsets) {
+      return GTEXT_CSV_E_OOM;
+    }
+    column->offsets = offsets;
+    size_t * lengths = (size_t *)realloc(column->lengths, new_size);
+    if (!lengths) {
+      return GTEXT_CSV_E_OOM;
+    }
+    column->lengths = lengths;
+    memset(offsets + old_capacity, 0, tail_size);
+    memset(lengths + old_capacity, 0, tail_size);
+  }
+
+  cols->row_capacity = new_capacity;
+  return GTEXT_CSV_OK;
+}
+
+// Make room for extra bytes at the end of the heap
+// A larger heap is taken from ctx's arena and the old one is left there, so
+// cell pointers handed out earlier stay valid until the arena is compacted
+static GTEXT_CSV_Status csv_columns_reserve_heap(
+    csv_context * ctx, csv_table_columns * cols, size_t extra) {
+  if (extra <= cols->heap_capacity - cols->heap_len) {
+    return GTEXT_CSV_OK;
+  }
+  if (cols->heap_len > SIZE_MAX - extra) {
+    return GTEXT_CSV_E_OOM;
+  }
+
+  size_t needed = cols->heap_len + extra;
+  size_t new_capacity = cols->heap_capacity;
+  while (new_capacity < needed) {
+    new_capacity = new_capacity > SIZE_MAX / 2 ? needed : new_capacity * 2;
+  }
+
+  char * heap = (char *)csv_arena_alloc_for_context(ctx, new_capacity, 1);
+  if (!heap) {
+    return GTEXT_CSV_E_OOM;
+  }
+  memcpy(heap, cols->heap, cols->heap_len);
+  cols->heap = heap;
+  cols->heap_capacity = new_capacity;
+  return GTEXT_CSV_OK;
+}
+
+// Heap bytes taken by a cell of the given length (its bytes and a NUL)
+static size_t csv_columns_cell_size(size_t len) {
+  return len == 0 ? 0 : len + 1;
+}
+
+// Copy a cell into heap space reserved by the caller and return its offset
+static size_t csv_columns_push_cell(
+    csv_table_columns * cols, const char * data, size_t len) {
+  if (len == 0) {
+    return 0; // Shared empty cell
+  }
+  size_t offset = cols->heap_len;
+  memcpy(cols->heap + offset, data, len);
+  cols->heap[offset + len] = '\0';
+  cols->heap_len += len + 1;
+  return offset;
+}
+
+// Store a cell at (row_idx, col), growing the heap as needed
+// The previous bytes of the cell stay in the heap until the next compaction
+static GTEXT_CSV_Status csv_columns_set_cell(csv_context * ctx,
+    csv_table_columns * cols, size_t row_idx, size_t col, const char * data,
+    size_t len) {
+  if (len == SIZE_MAX) {
+    return GTEXT_CSV_E_OOM;
+  }
+  GTEXT_CSV_Status status =
+      csv_columns_reserve_heap(ctx, cols, csv_columns_cell_size(len));
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+
+  csv_table_column * column = &cols->columns[col];
+  column->offsets[row_idx] = csv_columns_push_cell(cols, data, len);
+  column->lengths[row_idx] = len;
+  return GTEXT_CSV_OK;
+}
+
+// Number of fields in a row, in either layout
+static size_t csv_table_row_width(
+    const GTEXT_CSV_Table * table, size_t row_idx) {
+  if (table->columns) {
+    return table->columns->widths[row_idx];
+  }
+  return csv_table_row_at(table, row_idx)->field_count;
+}
+
+// Data and length of a field, in either layout
+// col must be below the row's width
+static const char * csv_table_cell(const GTEXT_CSV_Table * table,
+    size_t row_idx, size_t col, size_t * len) {
+  if (table->columns) {
+    const csv_table_column * column = &table->columns->columns[col];
+    *len = column->lengths[row_idx];
+    return table->columns->heap + column->offsets[row_idx];
+  }
+
+  const csv_table_field * field =
+      &csv_table_row_at(table, row_idx)->fields[col];
+  *len = field->length;
+  return field->data;
+}
+
+GTEXT_INTERNAL_API const csv_table_row * csv_table_resolve_row(
+    const GTEXT_CSV_Table * table, size_t row_idx, csv_table_row * scratch_row,
+    csv_table_field * scratch_fields) {
+  if (!table->columns) {
+    return csv_table_row_at(table, row_idx);
+  }
+
+  size_t width = table->columns->widths[row_idx];
+  for (size_t col = 0; col < width; col++) {
+    scratch_fields[col].data =
+        csv_table_cell(table, row_idx, col, &scratch_fields[col].length);
+    scratch_fields[col].is_in_situ = false;
+  }
+  scratch_row->fields = scratch_fields;
+  scratch_row->field_count = width;
+  return scratch_row;
+}
+
+// Whether every row of a column-major table has exactly column_count fields
+static bool csv_columns_is_rectangular(const GTEXT_CSV_Table * table) {
+  for (size_t i = 0; i < table->row_count; i++) {
+    if (table->columns->widths[i] != table->column_count) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Copy one row of a column-major table into arena-owned fields
+// Used where a row is needed as field structures (e.g. header map names)
+static GTEXT_CSV_Status csv_columns_copy_row(
+    GTEXT_CSV_Table * table, size_t row_idx, csv_table_row * row_out) {
+  size_t width = table->columns->widths[row_idx];
+  row_out->fields = NULL;
+  row_out->field_count = width;
+  if (width == 0) {
+    return GTEXT_CSV_OK;
+  }
+
+  csv_table_field * fields = (csv_table_field *)csv_arena_alloc_for_context(
+      table->ctx, sizeof(csv_table_field) * width, 8);
+  if (!fields) {
+    return GTEXT_CSV_E_OOM;
+  }
+  for (size_t col = 0; col < width; col++) {
+    size_t len;
+    const char * data = csv_table_cell(table, row_idx, col, &len);
+    if (len == 0) {
+      csv_setup_empty_field(&fields[col]);
+      continue;
+    }
+    GTEXT_CSV_Status status =
+        csv_allocate_and_copy_field(table->ctx, data, len, &fields[col]);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+  }
+  row_out->fields = fields;
+  return GTEXT_CSV_OK;
+}
+
+// Switch a column-major table to the row layout
+// The heap is already in the arena, so every field points into it and row
+// operations see ordinary arena fields
+static GTEXT_CSV_Status csv_table_columns_to_rows(GTEXT_CSV_Table * table) {
+  csv_table_columns * cols = table->columns;
+
+  // The table holds no row blocks while it is column-major
+  if (csv_table_reserve_rows(table, table->row_count) != GTEXT_CSV_OK) {
+    csv_table_free_rows(table);
+    return GTEXT_CSV_E_OOM;
+  }
+  const char * heap = cols->heap;
+
+  for (size_t i = 0; i < table->row_count; i++) {
+    size_t width = cols->widths[i];
+    csv_table_row * row = csv_table_row_at(table, i);
+    row->fields = NULL;
+    row->field_count = width;
+    if (width == 0) {
+      continue;
+    }
+
+    csv_table_field * fields = (csv_table_field *)csv_arena_alloc_for_context(
+        table->ctx, sizeof(csv_table_field) * width, 8);
+    if (!fields) {
+      csv_table_free_rows(table);
+      return GTEXT_CSV_E_OOM;
+    }
+    for (size_t col = 0; col < width; col++) {
+      const csv_table_column * column = &cols->columns[col];
+      if (column->lengths[i] == 0) {
+        csv_setup_empty_field(&fields[col]);
+        continue;
+      }
+      fields[col].data = heap + column->offsets[i];
+      fields[col].length = column->lengths[i];
+      fields[col].is_in_situ = false;
+    }
+    row->fields = fields;
+  }
+
+  table->columns = NULL;
+  csv_columns_free(cols);
+  return GTEXT_CSV_OK;
+}
+
+// Switch a row-major table to the column layout
+static GTEXT_CSV_Status csv_table_rows_to_columns(GTEXT_CSV_Table * table) {
+  // The arena is not used for cells in the column layout
+  csv_table_compaction_abandon(table);
+
+  size_t column_count = 0;
+  size_t heap_size = 0;
+  for (size_t i = 0; i < table->row_count; i++) {
+    const csv_table_row * row = csv_table_row_at(table, i);
+    if (row->field_count > column_count) {
+      column_count = row->field_count;
+    }
+    for (size_t col = 0; col < row->field_count; col++) {
+      size_t len = row->fields[col].length;
+      if (len == SIZE_MAX || heap_size > SIZE_MAX - (len + 1)) {
+        return GTEXT_CSV_E_OOM;
+      }
+      heap_size += csv_columns_cell_size(len);
+    }
+  }
+
+  csv_table_columns * cols = csv_columns_new(table->ctx);
+  if (!cols) {
+    return GTEXT_CSV_E_OOM;
+  }
+  GTEXT_CSV_Status status = csv_columns_reserve_rows(cols, table->row_count);
+  if (status == GTEXT_CSV_OK) {
+    status = csv_columns_add_columns(cols, column_count);
+  }
+  if (status == GTEXT_CSV_OK) {
+    status = csv_columns_reserve_heap(table->ctx, cols, heap_size);
+  }
+  if (status != GTEXT_CSV_OK) {
+    csv_columns_free(cols);
+    return status;
+  }
+
+  // Fill one column at a time so each offset/length array is written
+  // sequentially
+  for (size_t col = 0; col < column_count; col++) {
+    csv_table_column * column = &cols->columns[col];
+    for (size_t i = 0; i < table->row_count; i++) {
+      const csv_table_row * row = csv_table_row_at(table, i);
+      if (col >= row->field_count) {
+        continue;
+      }
+      const csv_table_field * field = &row->fields[col];
+      column->offsets[i] =
+          csv_columns_push_cell(cols, field->data, field->length);
+      column->lengths[i] = field->length;
+    }
+  }
+  for (size_t i = 0; i < table->row_count; i++) {
+    cols->widths[i] = csv_table_row_at(table, i)->field_count;
+  }
+
+  // Field arrays and data stay in the arena until the next compaction
+  table->columns = cols;
+  csv_table_free_rows(table);
+  return GTEXT_CSV_OK;
+}
+
+// Switch a table to the row layout before a row-oriented operation
+static GTEXT_CSV_Status csv_table_require_rows(GTEXT_CSV_Table * table) {
+  if (!table->columns) {
+    return GTEXT_CSV_OK;
+  }
+  return csv_table_columns_to_rows(table);
+}
+
+// Insert a column into a rectangular column-major table
+// Follows the row layout's conventions: values (if not NULL) has one entry
+// per row including the header, otherwise the column is empty and
+// header_name names it
+static GTEXT_CSV_Status csv_columns_insert_column(GTEXT_CSV_Table * table,
+    size_t col_idx, const char * header_name, size_t header_name_len,
+    const char * const * values, const size_t * value_lengths) {
+  csv_table_columns * cols = table->columns;
+  bool is_empty_column = (values == NULL);
+
+  if (table->column_count == SIZE_MAX) {
+    return GTEXT_CSV_E_OOM;
+  }
+
+  // Empty table: only the column count changes
+  if (table->row_count == 0) {
+    table->column_count++;
+    csv_table_indexes_column_inserted(table, col_idx);
+    return GTEXT_CSV_OK;
+  }
+
+  if (!is_empty_column) {
+    GTEXT_CSV_Status validation_status =
+        csv_validate_column_values(table, values);
+    if (validation_status != GTEXT_CSV_OK) {
+      return validation_status;
+    }
+  }
+
+  const char * header_value = NULL;
+  size_t header_value_len = 0;
+  const char * header_map_name = NULL;
+  size_t header_map_name_len = 0;
+  size_t name_len = 0;
+  GTEXT_CSV_Status status =
+      csv_determine_header_value(table, is_empty_column, header_name,
+          header_name_len, values, value_lengths, &header_value,
+          &header_value_len, &header_map_name, &header_map_name_len, &name_len);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+  bool has_header_entry = table->has_header && table->header_map;
+
+  // Pre-allocate everything before any state changes
+  size_t heap_size = 0;
+  for (size_t i = 0; i < table->row_count; i++) {
+    size_t len = 0;
+    if (!is_empty_column) {
+      len = csv_calculate_field_length(values[i], value_lengths, i);
+    }
+    else if (i == 0 && has_header_entry) {
+      len = header_value_len;
+    }
+    if (len == SIZE_MAX || heap_size > SIZE_MAX - (len + 1)) {
+      return GTEXT_CSV_E_OOM;
+    }
+    heap_size += csv_columns_cell_size(len);
+  }
+  status = csv_columns_reserve_heap(table->ctx, cols, heap_size);
+  if (status == GTEXT_CSV_OK) {
+    status = csv_columns_reserve_columns(cols, cols->column_count + 1);
+  }
+  csv_table_column column = {NULL, NULL};
+  if (status == GTEXT_CSV_OK) {
+    status = csv_columns_alloc_column(cols, &column);
+  }
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+
+  // Header map names must outlive heap growth, so they live in the arena
+  csv_header_entry * new_entry = NULL;
+  csv_table_field name_field;
+  csv_setup_empty_field(&name_field);
+  if (has_header_entry) {
+    new_entry = (csv_header_entry *)csv_arena_alloc_for_context(
+        table->ctx, sizeof(csv_header_entry), 8);
+    if (new_entry && header_map_name_len > 0) {
+      status = csv_allocate_and_copy_field(
+          table->ctx, header_map_name, header_map_name_len, &name_field);
+    }
+    if (!new_entry || status != GTEXT_CSV_OK) {
+      free(column.offsets);
+      free(column.lengths);
+      return GTEXT_CSV_E_OOM;
+    }
+  }
+
+  // Fill the new column
+  for (size_t i = 0; i < table->row_count; i++) {
+    if (!is_empty_column) {
+      size_t len = csv_calculate_field_length(values[i], value_lengths, i);
+      column.offsets[i] = csv_columns_push_cell(cols, values[i], len);
+      column.lengths[i] = len;
+    }
+    else if (i == 0 && has_header_entry) {
+      column.offsets[i] =
+          csv_columns_push_cell(cols, header_value, header_value_len);
+      column.lengths[i] = header_value_len;
+    }
+  }
+
+  // Atomic state update
+  memmove(cols->columns + col_idx + 1, cols->columns + col_idx,
+      sizeof(csv_table_column) * (cols->column_count - col_idx));
+  cols->columns[col_idx] = column;
+  cols->column_count++;
+  for (size_t i = 0; i < table->row_count; i++) {
+    cols->widths[i]++;
+  }
+  table->column_count++;
+
+  if (has_header_entry) {
+    size_t hash = csv_header_hash(
+        header_map_name, header_map_name_len, table->header_map_size);
+    csv_header_map_reindex_increment(table, col_idx);
+    new_entry->name = name_field.data;
+    new_entry->name_len = name_field.length;
+    new_entry->index = col_idx;
+    new_entry->next = table->header_map[hash];
+    table->header_map[hash] = new_entry;
+    csv_set_index_to_entry(table, col_idx, new_entry);
+  }
+
+  csv_table_indexes_column_inserted(table, col_idx);
+  return GTEXT_CSV_OK;
+}
+
+// Column layout entry point of the column append/insert functions
+// Rectangular tables are modified in place; anything else is switched to the
+// row layout first. Returns true when the operation is finished (status in
+// *status_out) and false when the caller should continue on the row layout
+static bool csv_columns_dispatch_insert(GTEXT_CSV_Table * table,
+    size_t col_idx, const char * header_name, size_t header_name_len,
+    const char * const * values, const size_t * value_lengths,
+    GTEXT_CSV_Status * status_out) {
+  if (!table->columns) {
+    return false;
+  }
+
+  if (col_idx <= table->column_count && csv_columns_is_rectangular(table)) {
+    *status_out = csv_columns_insert_column(table, col_idx, header_name,
+        header_name_len, values, value_lengths);
+    return true;
+  }
+
+  *status_out = csv_table_require_rows(table);
+  return *status_out != GTEXT_CSV_OK;
+}
+
+// Remove a column from column-major storage (header map is left to the
+// caller)
+static void csv_columns_remove_column(GTEXT_CSV_Table * table, size_t col_idx) {
+  csv_table_columns * cols = table->columns;
+  if (col_idx >= cols->column_count) {
+    return;
+  }
+
+  free(cols->columns[col_idx].offsets);
+  free(cols->columns[col_idx].lengths);
+  memmove(cols->columns + col_idx, cols->columns + col_idx + 1,
+      sizeof(csv_table_column) * (cols->column_count - col_idx - 1));
+  cols->column_count--;
+  cols->columns[cols->column_count].offsets = NULL;
+  cols->columns[cols->column_count].lengths = NULL;
+
+  for (size_t i = 0; i < table->row_count; i++) {
+    if (cols->widths[i] > col_idx) {
+      cols->widths[i]--;
+    }
+  }
+}
+
+// Rebuild the heap of a column-major table with only the live cells, in the
+// arena of ctx
+static GTEXT_CSV_Status csv_columns_compact(
+    GTEXT_CSV_Table * table, csv_context * ctx) {
+  csv_table_columns * cols = table->columns;
+
+  size_t heap_size = 1;
+  for (size_t col = 0; col < cols->column_count; col++) {
+    const csv_table_column * column = &cols->columns[col];
+    for (size_t i = 0; i < table->row_count; i++) {
+      if (col < cols->widths[i]) {
+        heap_size += csv_columns_cell_size(column->lengths[i]);
+      }
+    }
+  }
+
+  char * heap = (char *)csv_arena_alloc_for_context(ctx, heap_size, 1);
+  if (!heap) {
+    return GTEXT_CSV_E_OOM;
+  }
+  heap[0] = '\0';
+  size_t heap_len = 1;
+  for (size_t col = 0; col < cols->column_count; col++) {
+    csv_table_column * column = &cols->columns[col];
+    for (size_t i = 0; i < table->row_count; i++) {
+      size_t len = column->lengths[i];
+      if (col >= cols->widths[i] || len == 0) {
+        continue;
+      }
+      memcpy(heap + heap_len, cols->heap + column->offsets[i], len + 1);
+      column->offsets[i] = heap_len;
+      heap_len += len + 1;
+    }
+  }
+
+  cols->heap = heap;
+  cols->heap_len = heap_len;
+  cols->heap_capacity = heap_size;
+  return GTEXT_CSV_OK;
+}
+
+// Deep copy of column-major storage (live rows only), with its heap in ctx's
+// arena
+static csv_table_columns * csv_columns_clone(
+    const csv_table_columns * source, size_t row_count, csv_context * ctx) {
+  csv_table_columns * cols = csv_columns_new(ctx);
+  if (!cols) {
+    return NULL;
+  }
+  if (csv_columns_reserve_rows(cols, row_count) != GTEXT_CSV_OK ||
+      csv_columns_add_columns(cols, source->column_count) != GTEXT_CSV_OK ||
+      csv_columns_reserve_heap(ctx, cols, source->heap_len) != GTEXT_CSV_OK) {
+    csv_columns_free(cols);
+    return NULL;
+  }
+
+  memcpy(cols->heap, source->heap, source->heap_len);
+  cols->heap_len = source->heap_len;
+  memcpy(cols->widths, source->widths, sizeof(size_t) * row_count);
+  for (size_t col = 0; col < source->column_count; col++) {
+    memcpy(cols->columns[col].offsets, source->columns[col].offsets,
+        sizeof(size_t) * row_count);
+    memcpy(cols->columns[col].lengths, source->columns[col].lengths,
+        sizeof(size_t) * row_count);
+  }
+  return cols;
+}
+
+// Copy the header map of a column-major table into ctx
+// Entries and names are allocated in ctx; the new bucket array is malloc'd
+static GTEXT_CSV_Status csv_columns_copy_header_map(
+    const GTEXT_CSV_Table * source, csv_context * ctx,
+    csv_header_entry *** map_out) {
+  csv_header_entry ** map = (csv_header_entry **)calloc(
+      source->header_map_size, sizeof(csv_header_entry *));
+  if (!map) {
+    return GTEXT_CSV_E_OOM;
+  }
+
+  for (size_t i = 0; i < source->header_map_size; i++) {
+    csv_header_entry ** tail = &map[i];
+    for (const csv_header_entry * entry = source->header_map[i]; entry;
+         entry = entry->next) {
+      csv_header_entry * copy = (csv_header_entry *)csv_arena_alloc_for_context(
+          ctx, sizeof(csv_header_entry), 8);
+      csv_table_field name;
+      csv_setup_empty_field(&name);
+      if (!copy ||
+          (entry->name_len > 0 &&
+              csv_allocate_and_copy_field(ctx, entry->name, entry->name_len,
+                  &name) != GTEXT_CSV_OK)) {
+        free(map);
+        return GTEXT_CSV_E_OOM;
+      }
+      copy->name = name.data;
+      copy->name_len = name.length;
+      copy->index = entry->index;
+      copy->next = NULL;
+      *tail = copy;
+      tail = &copy->next;
+    }
+  }
+
+  *map_out = map;
+  return GTEXT_CSV_OK;
+}
+
+// Compact a column-major table
+// The arena is replaced by one holding just the header map and a heap of the
+// live cells, which drops replaced cells, heaps outgrown by growth and any row
+// storage left over from earlier layout switches
+static GTEXT_CSV_Status csv_columns_compact_table(GTEXT_CSV_Table * table) {
+  csv_context * new_ctx = csv_context_new();
+  if (!new_ctx) {
+    return GTEXT_CSV_E_OOM;
+  }
+
+  csv_header_entry ** new_map = NULL;
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  if (table->header_map) {
+    status = csv_columns_copy_header_map(table, new_ctx, &new_map);
+  }
+  if (status == GTEXT_CSV_OK) {
+    status = csv_columns_compact(table, new_ctx);
+  }
+  if (status != GTEXT_CSV_OK) {
+    free(new_map);
+    csv_context_free(new_ctx);
+    return status;
+  }
+
+  // Preserve input buffer reference (caller-owned)
+  new_ctx->input_buffer = table->ctx->input_buffer;
+  new_ctx->input_buffer_len = table->ctx->input_buffer_len;
+  csv_context_free(table->ctx);
+  table->ctx = new_ctx;
+  csv_table_share_release(table->share); // Only left-over rows read from it
+  table->share = NULL;
+  table->index_to_entry = NULL; // Lived in the old arena
+  table->index_to_entry_capacity = 0;
+  if (new_map) {
+    free(table->header_map);
+    table->header_map = new_map;
+    csv_rebuild_index_to_entry(table);
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Clone a column-major table
+static GTEXT_CSV_Table * csv_table_clone_columns(
+    const GTEXT_CSV_Table * source) {
+  GTEXT_CSV_Table * table = csv_create_empty_table(NULL);
+  if (!table) {
+    return NULL;
+  }
+
+  table->columns =
+      csv_columns_clone(source->columns, source->row_count, table->ctx);
+  if (!table->columns) {
+    gtext_csv_free_table(table);
+    return NULL;
+  }
+  table->row_count = source->row_count;
+  table->column_count = source->column_count;
+  table->has_header = source->has_header;
+  table->require_unique_headers = source->require_unique_headers;
+  table->allow_irregular_rows = source->allow_irregular_rows;
+
+  if (source->header_map) {
+    table->header_map_size = source->header_map_size;
+    if (csv_columns_copy_header_map(source, table->ctx, &table->header_map) !=
+            GTEXT_CSV_OK ||
+        csv_rebuild_index_to_entry(table) != GTEXT_CSV_OK) {
+      gtext_csv_free_table(table);
+      return NULL;
+    }
+  }
+
+  return table;
+}
+
+// Whether the parse keeps only some columns
+static bool csv_table_is_projected(const GTEXT_CSV_Parse_Options * opts) {
+  return opts->select_column_count > 0 || opts->select_name_count > 0;
+}
+
+// Data and length of field col of the record being parsed
+// col must be below the record's field count
+static const char * csv_table_record_cell(
+    const csv_table_parse_context * ctx, size_t col, size_t * len) {
+  const csv_table_columns * cols = ctx->table->columns;
+  if (cols) {
+    size_t row = ctx->table->row_count;
+    *len = cols->columns[col].lengths[row];
+    return cols->heap + cols->columns[col].offsets[row];
+  }
+  *len = ctx->current_row->fields[col].length;
+  return ctx->current_row->fields[col].data;
+}
+
+// Resolve opts.select_names against the header row that just ended
+// The header row is cut down to the selected columns, and the stream is told
+// to skip every other column from the next record on. Explicit indices past
+// the header width stay selected for wider data rows.
+static GTEXT_CSV_Status csv_table_select_header_columns(
+    csv_table_parse_context * ctx) {
+  const GTEXT_CSV_Parse_Options * opts = ctx->opts;
+  csv_table_columns * cols = ctx->table->columns;
+  size_t width = ctx->current_field_index;
+
+  size_t * indices = (size_t *)malloc(
+      sizeof(size_t) * (width + opts->select_column_count + 1));
+  bool * keep = (bool *)calloc(width + 1, sizeof(bool));
+  if (!indices || !keep) {
+    free(indices);
+    free(keep);
+    return GTEXT_CSV_E_OOM;
+  }
+
+  size_t count = 0;
+  for (size_t i = 0; i < opts->select_column_count; i++) {
+    if (opts->select_columns[i] < width) {
+      keep[opts->select_columns[i]] = true;
+    }
+    else {
+      indices[count++] = opts->select_columns[i];
+    }
+  }
+  for (size_t i = 0; i < opts->select_name_count; i++) {
+    const char * name = opts->select_names[i];
+    size_t name_len = name ? strlen(name) : 0;
+    size_t col = 0;
+    for (; col < width; col++) {
+      size_t len;
+      const char * data = csv_table_record_cell(ctx, col, &len);
+      if (len == name_len && memcmp(data, name, len) == 0) {
+        break;
+      }
+    }
+    if (col == width) {
+      free(indices);
+      free(keep);
+      ctx->error_message = "Selected column name not found in header";
+      return GTEXT_CSV_E_INVALID;
+    }
+    keep[col] = true;
+  }
+
+  // Move the kept header cells to the front
+  size_t kept = 0;
+  for (size_t col = 0; col < width; col++) {
+    if (!keep[col]) {
+      continue;
+    }
+    indices[count++] = col;
+    if (cols) {
+      csv_table_column column = cols->columns[kept];
+      cols->columns[kept] = cols->columns[col];
+      cols->columns[col] = column;
+    }
+    else {
+      ctx->current_row->fields[kept] = ctx->current_row->fields[col];
+    }
+    kept++;
+  }
+  if (cols) {
+    // Dropped columns only held header cells
+    for (size_t col = kept; col < cols->column_count; col++) {
+      free(cols->columns[col].offsets);
+      free(cols->columns[col].lengths);
+      cols->columns[col].offsets = NULL;
+      cols->columns[col].lengths = NULL;
+    }
+    cols->column_count = kept;
+  }
+  else {
+    ctx->current_row->field_count = kept;
+  }
+  ctx->current_field_index = kept;
+
+  GTEXT_CSV_Status status =
+      csv_stream_select_fields(ctx->stream, indices, count);
+  free(indices);
+  free(keep);
+  return status;
+}
+
+// Whether the parse drops rows
+static bool csv_table_is_filtered(const GTEXT_CSV_Parse_Options * opts) {
+  return opts->row_condition_count > 0 || opts->row_filter;
+}
+
+// Whether any row condition names its column
+static bool csv_table_filter_has_names(const GTEXT_CSV_Parse_Options * opts) {
+  for (size_t i = 0; i < opts->row_condition_count; i++) {
+    if (opts->row_conditions[i].column) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Resolve the columns of named row conditions against the header row that
+// just ended (after projection)
+static GTEXT_CSV_Status csv_table_resolve_filter_columns(
+    csv_table_parse_context * ctx) {
+  const GTEXT_CSV_Parse_Options * opts = ctx->opts;
+  size_t width = ctx->current_field_index;
+
+  for (size_t i = 0; i < opts->row_condition_count; i++) {
+    const char * name = opts->row_conditions[i].column;
+    if (!name) {
+      continue;
+    }
+    size_t name_len = strlen(name);
+    size_t col = 0;
+    for (; col < width; col++) {
+      size_t len;
+      const char * data = csv_table_record_cell(ctx, col, &len);
+      if (len == name_len && memcmp(data, name, len) == 0) {
+        break;
+      }
+    }
+    if (col == width) {
+      ctx->error_message = "Filter column name not found in header";
+      return GTEXT_CSV_E_INVALID;
+    }
+    ctx->filter_columns[i] = col;
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Whether a field meets one row condition
+static bool csv_table_condition_holds(const GTEXT_CSV_Row_Condition * cond,
+    const char * data, size_t len) {
+  const char * value = cond->value ? cond->value : "";
+  size_t value_len;
+  double number;
+
+  switch (cond->op) {
+  case GTEXT_CSV_FILTER_EQUALS:
+    value_len = strlen(value);
+    return len == value_len && memcmp(data, value, len) == 0;
+  case GTEXT_CSV_FILTER_PREFIX:
+    value_len = strlen(value);
+    return len >= value_len && memcmp(data, value, value_len) == 0;
+  case GTEXT_CSV_FILTER_RANGE:
+    return csv_convert_parse_f64(data, len, &number) == GTEXT_CSV_OK &&
+        number >= cond->min && number <= cond->max;
+  }
+  return false;
+}
+
+// Decide whether the record that just ended is kept
+static GTEXT_CSV_Status csv_table_filter_record(
+    csv_table_parse_context * ctx, bool * keep) {
+  const GTEXT_CSV_Parse_Options * opts = ctx->opts;
+  size_t width = ctx->current_field_index;
+  *keep = false;
+
+  for (size_t i = 0; i < opts->row_condition_count; i++) {
+    size_t col = ctx->filter_columns[i];
+    if (col >= width) {
+      return GTEXT_CSV_OK;
+    }
+    size_t len;
+    const char * data = csv_table_record_cell(ctx, col, &len);
+    if (!csv_table_condition_holds(&opts->row_conditions[i], data, len)) {
+      return GTEXT_CSV_OK;
+    }
+  }
+
+  if (opts->row_filter) {
+    if (width > ctx->filter_capacity) {
+      size_t capacity = ctx->filter_capacity ? ctx->filter_capacity : 16;
+      while (capacity < width) {
+        if (capacity > SIZE_MAX / 2 / sizeof(size_t)) {
+          return GTEXT_CSV_E_OOM;
+        }
+        capacity *= 2;
+      }
+      const char ** fields = (const char **)realloc(
+          (void *)ctx->filter_fields, sizeof(const char *) * capacity);
+      if (!fields) {
+        return GTEXT_CSV_E_OOM;
+      }
+      ctx->filter_fields = fields;
+      size_t * lengths =
+          (size_t *)realloc(ctx->filter_lengths, sizeof(size_t) * capacity);
+      if (!lengths) {
+        return GTEXT_CSV_E_OOM;
+      }
+      ctx->filter_lengths = lengths;
+      ctx->filter_capacity = capacity;
+    }
+    for (size_t col = 0; col < width; col++) {
+      ctx->filter_fields[col] =
+          csv_table_record_cell(ctx, col, &ctx->filter_lengths[col]);
+    }
+    if (!opts->row_filter(ctx->filter_fields, ctx->filter_lengths, width,
+            opts->row_filter_data)) {
+      return GTEXT_CSV_OK;
+    }
+  }
+
+  *keep = true;
+  return GTEXT_CSV_OK;
+}
+
+// Run the header and filter bookkeeping for the record that just ended
+// Sets *keep to whether the record becomes a table row; dropped records must
+// be rolled back by the caller
+static GTEXT_CSV_Status csv_table_end_record(
+    csv_table_parse_context * ctx, bool * keep) {
+  const GTEXT_CSV_Parse_Options * opts = ctx->opts;
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+
+  // Only count records that have at least one field
+  // This prevents counting empty records (e.g., from trailing newlines)
+  // A projected record may keep none of its fields and still counts
+  *keep = ctx->current_field_index > 0 || csv_table_is_projected(opts);
+
+  if (ctx->table->row_count == 0 && opts->dialect.treat_first_row_as_header) {
+    if (opts->select_name_count > 0) {
+      status = csv_table_select_header_columns(ctx);
+    }
+    if (status == GTEXT_CSV_OK && csv_table_filter_has_names(opts)) {
+      status = csv_table_resolve_filter_columns(ctx);
+    }
+    return status;
+  }
+
+  if (*keep && csv_table_is_filtered(opts)) {
+    status = csv_table_filter_record(ctx, keep);
+  }
+  return status;
+}
+
+// Event callback for building a column-major table from stream
+static GTEXT_CSV_Status csv_table_columns_event(
+    csv_table_parse_context * ctx, const GTEXT_CSV_Event * event) {
+  GTEXT_CSV_Table * table = ctx->table;
+  csv_table_columns * cols = table->columns;
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+
+  switch (event->type) {
+  case GTEXT_CSV_EVENT_RECORD_BEGIN:
+    if (table->row_count == SIZE_MAX) {
+      status = GTEXT_CSV_E_OOM;
+      break;
+    }
+    status = csv_columns_reserve_rows(cols, table->row_count + 1);
+    ctx->current_field_index = 0;
+    ctx->record_heap_len = cols->heap_len;
+    ctx->record_column_count = cols->column_count;
+    break;
+
+  case GTEXT_CSV_EVENT_FIELD: {
+    size_t col = ctx->current_field_index;
+    if (col >= cols->column_count) {
+      status = csv_columns_add_columns(cols, col + 1);
+    }
+    if (status == GTEXT_CSV_OK) {
+      status = csv_columns_set_cell(table->ctx, cols, table->row_count, col,
+          event->data, event->data_len);
+    }
+    if (status == GTEXT_CSV_OK) {
+      ctx->current_field_index++;
+    }
+    break;
+  }
+
+  case GTEXT_CSV_EVENT_RECORD_END: {
+    bool keep = false;
+    status = csv_table_end_record(ctx, &keep);
+    if (status != GTEXT_CSV_OK) {
+      break;
+    }
+    if (keep) {
+      cols->widths[table->row_count] = ctx->current_field_index;
+      table->row_count++;
+    }
+    else {
+      // Drop the record's cells, heap bytes, and any columns it added
+      for (size_t col = 0; col < cols->column_count; col++) {
+        cols->columns[col].offsets[table->row_count] = 0;
+        cols->columns[col].lengths[table->row_count] = 0;
+      }
+      for (size_t col = ctx->record_column_count; col < cols->column_count;
+          col++) {
+        free(cols->columns[col].offsets);
+        free(cols->columns[col].lengths);
+        cols->columns[col].offsets = NULL;
+        cols->columns[col].lengths = NULL;
+      }
+      cols->column_count = ctx->record_column_count;
+      cols->heap_len = ctx->record_heap_len;
+      cols->widths[table->row_count] = 0;
+    }
+    ctx->current_field_index = 0;
+    break;
+  }
+
+  case GTEXT_CSV_EVENT_END:
+    break;
+  }
 
-    // Grow field array if needed
+  if (status != GTEXT_CSV_OK) {
+    ctx->status = status;
+  }
+  return status;
+}
+
+// Event callback for building table from stream
+static GTEXT_CSV_Status csv_table_event_callback(
+    const GTEXT_CSV_Event * event, void * user_data) {
+  csv_table_parse_context * ctx = (csv_table_parse_context *)user_data;
+  GTEXT_CSV_Table * table = ctx->table;
+
+  if (table->columns) {
+    return csv_table_columns_event(ctx, event);
+  }
+
+  switch (event->type) {
+  case GTEXT_CSV_EVENT_RECORD_BEGIN: {
+    // Claim the next row slot (adds a row block when the last one is full)
+    if (table->row_count == SIZE_MAX ||
+        csv_table_reserve_rows(table, table->row_count + 1) != GTEXT_CSV_OK) {
+      ctx->status = GTEXT_CSV_E_OOM;
+      return GTEXT_CSV_E_OOM;
+    }
+
+    // Fields collect in the reusable record array until the record ends
+    ctx->current_row = csv_table_row_at(table, table->row_count);
+    ctx->current_row->fields = ctx->record_fields;
+    ctx->current_row->field_count = 0;
+    ctx->current_field_index = 0;
+    if (csv_table_is_filtered(ctx->opts)) {
+      ctx->record_mark = csv_arena_get_mark(table->ctx->arena);
+    }
+    return GTEXT_CSV_OK;
+  }
+
+  case GTEXT_CSV_EVENT_FIELD: {
+    if (!ctx->current_row) {
+      ctx->status = GTEXT_CSV_E_INVALID;
+      return GTEXT_CSV_E_INVALID;
+    }
+
+    // Grow the record array if needed (it is reused by every record, so
+    // it only grows to the widest record)
     if (ctx->current_field_index >= ctx->current_field_capacity) {
       size_t new_capacity = ctx->current_field_capacity == 0
           ? 16
           : ctx->current_field_capacity * 2;
       // Check for overflow in multiplication
-      if (new_capacity < ctx->current_field_capacity &&
-          ctx->current_field_capacity > 0) {
+      if (new_capacity > SIZE_MAX / sizeof(csv_table_field)) {
         ctx->status = GTEXT_CSV_E_OOM;
         return GTEXT_CSV_E_OOM;
       }
-      csv_table_field * new_fields =
-          (csv_table_field *)csv_arena_alloc_for_context(
-              table->ctx, sizeof(csv_table_field) * new_capacity, 8);
+      csv_table_field * new_fields = (csv_table_field *)realloc(
+          ctx->record_fields, sizeof(csv_table_field) * new_capacity);
       if (!new_fields) {
         ctx->status = GTEXT_CSV_E_OOM;
         return GTEXT_CSV_E_OOM;
       }
-      if (ctx->current_row->fields) {
-        memcpy(new_fields, ctx->current_row->fields,
-            sizeof(csv_table_field) * ctx->current_field_index);
-      }
+      ctx->record_fields = new_fields;
       ctx->current_row->fields = new_fields;
       ctx->current_field_capacity = new_capacity;
     }
@@ -684,15 +2490,40 @@ static GTEXT_CSV_Status csv_table_event_callback(
 
   case GTEXT_CSV_EVENT_RECORD_END: {
     if (ctx->current_row) {
-      // Only count records that have at least one field
-      // This prevents counting empty records (e.g., from trailing newlines)
-      if (ctx->current_row->field_count > 0) {
+      bool keep = false;
+      GTEXT_CSV_Status status = csv_table_end_record(ctx, &keep);
+      if (status != GTEXT_CSV_OK) {
+        ctx->status = status;
+        return status;
+      }
+      if (keep) {
+        // Move the fields into an arena array of exactly the record's width
+        csv_table_row * row = ctx->current_row;
+        row->fields = NULL;
+        if (row->field_count > 0) {
+          row->fields = (csv_table_field *)csv_arena_alloc_for_context(
+              table->ctx, sizeof(csv_table_field) * row->field_count, 8);
+          if (!row->fields) {
+            ctx->status = GTEXT_CSV_E_OOM;
+            return GTEXT_CSV_E_OOM;
+          }
+          memcpy(row->fields, ctx->record_fields,
+              sizeof(csv_table_field) * row->field_count);
+        }
         table->row_count++;
       }
+      else {
+        // Reclaim the record's field data before the next record reuses its
+        // slot
+        if (csv_table_is_filtered(ctx->opts)) {
+          csv_arena_reset(table->ctx->arena, ctx->record_mark);
+        }
+        ctx->current_row->fields = NULL;
+        ctx->current_row->field_count = 0;
+      }
     }
     ctx->current_row = NULL;
     ctx->current_field_index = 0;
-    ctx->current_field_capacity = 0;
     return GTEXT_CSV_OK;
   }
 
@@ -718,18 +2549,9 @@ static GTEXT_CSV_Table * csv_create_empty_table(GTEXT_CSV_Error * err) {
     return NULL;
   }
 
+  // Row blocks are added as rows arrive
   memset(table, 0, sizeof(GTEXT_CSV_Table));
   table->ctx = ctx;
-  table->row_capacity = 16;
-  table->rows = (csv_table_row *)csv_arena_alloc_for_context(
-      ctx, sizeof(csv_table_row) * table->row_capacity, 8);
-  if (!table->rows) {
-    free(table);
-    csv_context_free(ctx);
-    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to allocate rows");
-    return NULL;
-  }
-
   return table;
 }
 
@@ -742,37 +2564,340 @@ static GTEXT_CSV_Status csv_table_parse_internal(GTEXT_CSV_Table * table,
       .current_row = NULL,
       .current_field_index = 0,
       .current_field_capacity = 0,
+      .record_fields = NULL,
       .opts = opts,
       .err = err,
-      .status = GTEXT_CSV_OK};
+      .status = GTEXT_CSV_OK,
+      .stream = NULL,
+      .error_message = NULL,
+      .filter_columns = NULL,
+      .filter_fields = NULL,
+      .filter_lengths = NULL,
+      .filter_capacity = 0};
+
+  // Condition columns given by name are filled in from the header row
+  if (opts->row_condition_count > 0) {
+    parse_ctx.filter_columns =
+        (size_t *)malloc(sizeof(size_t) * opts->row_condition_count);
+    if (!parse_ctx.filter_columns) {
+      CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to allocate row filter");
+      return GTEXT_CSV_E_OOM;
+    }
+    for (size_t i = 0; i < opts->row_condition_count; i++) {
+      parse_ctx.filter_columns[i] = opts->row_conditions[i].column_index;
+    }
+  }
+
+  // Create streaming parser
+  GTEXT_CSV_Stream * stream =
+      gtext_csv_stream_new(opts, csv_table_event_callback, &parse_ctx);
+  if (!stream) {
+    free(parse_ctx.filter_columns);
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to create stream parser");
+    return GTEXT_CSV_E_OOM;
+  }
+  parse_ctx.stream = stream;
+
+  // Selected names are resolved once the header row is in, so the header row
+  // itself is parsed in full
+  if (opts->select_name_count > 0) {
+    csv_stream_select_fields(stream, NULL, 0);
+  }
+
+  // Set original input buffer for in-situ mode and error context snippets
+  // Always set it for table parsing so we can generate context snippets on
+  // errors Use the input parameter directly (which may have been adjusted for
+  // BOM)
+  csv_stream_set_original_input_buffer(stream, input, input_len);
+
+  // Feed input
+  GTEXT_CSV_Status status =
+      gtext_csv_stream_feed(stream, input, input_len, err);
+  if (status == GTEXT_CSV_OK) {
+    status = gtext_csv_stream_finish(stream, err);
+  }
+
+  if (status == GTEXT_CSV_OK && parse_ctx.status != GTEXT_CSV_OK) {
+    status = parse_ctx.status;
+  }
+  if (status != GTEXT_CSV_OK && parse_ctx.error_message) {
+    gtext_csv_error_free(err);
+    CSV_SET_ERROR(err, status, parse_ctx.error_message);
+  }
+
+  gtext_csv_stream_free(stream);
+  free(parse_ctx.record_fields);
+  free(parse_ctx.filter_columns);
+  free((void *)parse_ctx.filter_fields);
+  free(parse_ctx.filter_lengths);
+  return status;
+}
+
+// ============================================================================
+// Parallel table parsing
+// ============================================================================
+
+// Smallest slice of input worth handing to its own worker thread
+#define CSV_PARALLEL_MIN_CHUNK_BYTES (64 * 1024)
+
+// Upper bound on the number of workers used by one parse
+#define CSV_PARALLEL_MAX_CHUNKS 64
+
+// One contiguous slice of the input and the work done on it
+typedef struct {
+  const char * input;           // Start of the whole input
+  size_t begin;                 // Offset of the first byte of the slice
+  size_t end;                   // Offset one past the last byte of the slice
+  char quote;                   // Dialect quote character
+  size_t quote_count;           // Quote pass: quote characters in the slice
+  GTEXT_CSV_Parse_Options opts; // Parse pass: options for this slice
+  GTEXT_CSV_Table * table;      // Parse pass: rows parsed from the slice
+  GTEXT_CSV_Status status;      // Parse pass: result
+} csv_parallel_chunk;
+
+// Number of chunks to split the input into (1 means parse serially)
+static size_t csv_parallel_chunk_count(
+    size_t input_len, const GTEXT_CSV_Parse_Options * opts) {
+  const GTEXT_CSV_Dialect * dialect = &opts->dialect;
+  if (opts->parse_threads < 2) {
+    return 1;
+  }
+
+  // Quote parity only tells record boundaries apart when every quote opens,
+  // closes, or doubles inside a quoted field and an unquoted LF always ends
+  // the record
+  if (dialect->escape != GTEXT_CSV_ESCAPE_DOUBLED_QUOTE ||
+      dialect->allow_unquoted_quotes || dialect->allow_unquoted_newlines ||
+      dialect->allow_comments || !dialect->accept_lf ||
+      dialect->quote == '\n' || dialect->delimiter == '\n') {
+    return 1;
+  }
+
+  // Names are resolved from the header row, which only the first chunk sees,
+  // and a row filter callback may not be safe to call from several threads
+  if (opts->select_name_count > 0 || csv_table_filter_has_names(opts) ||
+      opts->row_filter) {
+    return 1;
+  }
+
+  // Each chunk's stream only sees its own bytes, so the total input limit
+  // must be enforced by a serial parse
+  size_t max_total_bytes = opts->max_total_bytes > 0
+      ? opts->max_total_bytes
+      : (size_t)CSV_DEFAULT_MAX_TOTAL_BYTES;
+  if (input_len > max_total_bytes) {
+    return 1;
+  }
+
+  size_t count = input_len / CSV_PARALLEL_MIN_CHUNK_BYTES;
+  if (count > opts->parse_threads) {
+    count = opts->parse_threads;
+  }
+  if (count > CSV_PARALLEL_MAX_CHUNKS) {
+    count = CSV_PARALLEL_MAX_CHUNKS;
+  }
+  return count < 2 ? 1 : count;
+}
+
+// Worker: count quote characters in a slice
+static void * csv_parallel_count_quotes(void * arg) {
+  csv_parallel_chunk * chunk = (csv_parallel_chunk *)arg;
+  const char * p = chunk->input + chunk->begin;
+  const char * end = chunk->input + chunk->end;
+  size_t count = 0;
+
+  while (p < end &&
+      (p = (const char *)memchr(p, chunk->quote, (size_t)(end - p))) != NULL) {
+    count++;
+    p++;
+  }
+
+  chunk->quote_count = count;
+  return NULL;
+}
+
+// Worker: parse a slice into its own table
+static void * csv_parallel_parse_chunk(void * arg) {
+  csv_parallel_chunk * chunk = (csv_parallel_chunk *)arg;
+  const char * data = chunk->input + chunk->begin;
+  size_t len = chunk->end - chunk->begin;
+
+  chunk->table = csv_create_empty_table(NULL);
+  if (!chunk->table) {
+    chunk->status = GTEXT_CSV_E_OOM;
+    return NULL;
+  }
+  if (chunk->opts.in_situ_mode) {
+    csv_context_set_input_buffer(chunk->table->ctx, data, len);
+  }
+
+  GTEXT_CSV_Error err = {0};
+  chunk->status =
+      csv_table_parse_internal(chunk->table, data, len, &chunk->opts, &err);
+  gtext_csv_error_free(&err);
+  return NULL;
+}
+
+// Run a worker over every chunk
+// Chunk 0 runs on the calling thread, as does any chunk whose thread could
+// not be started
+static void csv_parallel_run(
+    csv_parallel_chunk * chunks, size_t count, void * (*worker)(void *)) {
+  pthread_t threads[CSV_PARALLEL_MAX_CHUNKS];
+  bool started[CSV_PARALLEL_MAX_CHUNKS];
+
+  for (size_t i = 1; i < count; i++) {
+    started[i] = pthread_create(&threads[i], NULL, worker, &chunks[i]) == 0;
+  }
+  worker(&chunks[0]);
+  for (size_t i = 1; i < count; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], NULL);
+    }
+    else {
+      worker(&chunks[i]);
+    }
+  }
+}
+
+// Find the first record boundary in [pos, limit)
+// in_quotes is the quote parity at pos; the boundary is the offset just past
+// the first LF that parity places outside a quoted field
+static bool csv_parallel_find_boundary(const char * input, size_t pos,
+    size_t limit, char quote, bool in_quotes, size_t * boundary) {
+  const unsigned char set[2] = {(unsigned char)quote, '\n'};
+
+  while (pos < limit) {
+    pos += text_simd_span_excluding(
+        (const unsigned char *)input + pos, limit - pos, set, 2);
+    if (pos >= limit) {
+      break;
+    }
+    if (input[pos] == quote) {
+      in_quotes = !in_quotes;
+    }
+    else if (!in_quotes) {
+      *boundary = pos + 1;
+      return true;
+    }
+    pos++;
+  }
+  return false;
+}
 
-  // Create streaming parser
-  GTEXT_CSV_Stream * stream =
-      gtext_csv_stream_new(opts, csv_table_event_callback, &parse_ctx);
-  if (!stream) {
-    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to create stream parser");
-    return GTEXT_CSV_E_OOM;
+// Free the per-chunk tables of a parallel parse
+static void csv_parallel_free_chunks(
+    csv_parallel_chunk * chunks, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    gtext_csv_free_table(chunks[i].table);
+    chunks[i].table = NULL;
   }
+}
 
-  // Set original input buffer for in-situ mode and error context snippets
-  // Always set it for table parsing so we can generate context snippets on
-  // errors Use the input parameter directly (which may have been adjusted for
-  // BOM)
-  csv_stream_set_original_input_buffer(stream, input, input_len);
+// Parse the input on several threads and append the rows to table
+//
+// The input is cut into equal slices and the quote characters in each slice
+// are counted in parallel. The parity of the quotes before a slice tells
+// whether it starts inside a quoted field, which moves each cut forward to
+// the next record boundary. Every chunk is then parsed by its own stream into
+// its own table, and the rows and arenas are merged in input order.
+//
+// Parity can only misplace a cut in malformed input, and then the chunk
+// before the cut ends inside a quoted field and fails. Any chunk failure
+// returns false so the caller re-parses serially and reports the exact
+// error; the table is left untouched in that case.
+static bool csv_table_parse_parallel(GTEXT_CSV_Table * table,
+    const char * input, size_t input_len, const GTEXT_CSV_Parse_Options * opts,
+    size_t count) {
+  csv_parallel_chunk chunks[CSV_PARALLEL_MAX_CHUNKS];
+  memset(chunks, 0, sizeof(csv_parallel_chunk) * count);
+
+  // Quote pass
+  size_t slice_len = input_len / count;
+  for (size_t i = 0; i < count; i++) {
+    chunks[i].input = input;
+    chunks[i].begin = slice_len * i;
+    chunks[i].end = i + 1 == count ? input_len : slice_len * (i + 1);
+    chunks[i].quote = opts->dialect.quote;
+  }
+  csv_parallel_run(chunks, count, csv_parallel_count_quotes);
+
+  // Move each cut forward to a record boundary; a slice without one is
+  // merged into the chunk before it
+  size_t quotes_before = chunks[0].quote_count;
+  size_t chunk_count = 1;
+  for (size_t i = 1; i < count; i++) {
+    size_t slice_begin = chunks[i].begin;
+    size_t slice_end = chunks[i].end;
+    bool in_quotes = (quotes_before & 1) != 0;
+    quotes_before += chunks[i].quote_count;
+
+    size_t boundary;
+    if (!csv_parallel_find_boundary(input, slice_begin, slice_end,
+            opts->dialect.quote, in_quotes, &boundary) ||
+        boundary >= input_len) {
+      continue;
+    }
+    chunks[chunk_count - 1].end = boundary;
+    chunks[chunk_count].begin = boundary;
+    chunk_count++;
+  }
+  chunks[chunk_count - 1].end = input_len;
+  if (chunk_count < 2) {
+    return false;
+  }
 
-  // Feed input
-  GTEXT_CSV_Status status =
-      gtext_csv_stream_feed(stream, input, input_len, err);
-  if (status == GTEXT_CSV_OK) {
-    status = gtext_csv_stream_finish(stream, err);
+  // Parse pass
+  for (size_t i = 0; i < chunk_count; i++) {
+    chunks[i].opts = *opts;
+    chunks[i].opts.enable_context_snippet = false;
+    if (i > 0) {
+      // The BOM, if any, was handled before the input was split, and only
+      // the first chunk holds the header row
+      chunks[i].opts.keep_bom = true;
+      chunks[i].opts.dialect.treat_first_row_as_header = false;
+    }
   }
+  csv_parallel_run(chunks, chunk_count, csv_parallel_parse_chunk);
 
-  if (status == GTEXT_CSV_OK && parse_ctx.status != GTEXT_CSV_OK) {
-    status = parse_ctx.status;
+  size_t total_rows = 0;
+  for (size_t i = 0; i < chunk_count; i++) {
+    if (chunks[i].status != GTEXT_CSV_OK) {
+      csv_parallel_free_chunks(chunks, chunk_count);
+      return false;
+    }
+    total_rows += chunks[i].table->row_count;
   }
 
-  gtext_csv_stream_free(stream);
-  return status;
+  // Merge
+  if (csv_table_reserve_rows(table, total_rows) != GTEXT_CSV_OK) {
+    csv_parallel_free_chunks(chunks, chunk_count);
+    return false;
+  }
+  for (size_t i = 0; i < chunk_count; i++) {
+    GTEXT_CSV_Table * part = chunks[i].table;
+    for (size_t row = 0; row < part->row_count; row++) {
+      *csv_table_row_at(table, table->row_count + row) =
+          *csv_table_row_at(part, row);
+    }
+    table->row_count += part->row_count;
+    csv_arena_absorb(table->ctx->arena, part->ctx->arena);
+    part->ctx->arena = NULL;
+  }
+  csv_parallel_free_chunks(chunks, chunk_count);
+  return true;
+}
+
+// Parse the input into table, on several threads when the options allow it
+static GTEXT_CSV_Status csv_table_parse_dispatch(GTEXT_CSV_Table * table,
+    const char * input, size_t input_len, const GTEXT_CSV_Parse_Options * opts,
+    GTEXT_CSV_Error * err) {
+  size_t count = csv_parallel_chunk_count(input_len, opts);
+  if (count > 1 &&
+      csv_table_parse_parallel(table, input, input_len, opts, count)) {
+    return GTEXT_CSV_OK;
+  }
+  return csv_table_parse_internal(table, input, input_len, opts, err);
 }
 
 GTEXT_API GTEXT_CSV_Table * gtext_csv_parse_table(const void * data, size_t len,
@@ -782,41 +2907,58 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_parse_table(const void * data, size_t len,
     return NULL;
   }
 
-  // Empty input is valid - return empty table
-  if (len == 0) {
-    return csv_create_empty_table(err);
-  }
-
   GTEXT_CSV_Parse_Options default_opts;
   if (!opts) {
     default_opts = gtext_csv_parse_options_default();
     opts = &default_opts;
   }
 
-  // Create context and allocate table structure
-  csv_context * ctx = csv_context_new();
-  if (!ctx) {
-    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to create context");
+  if (opts->select_name_count > 0 &&
+      (!opts->select_names || !opts->dialect.treat_first_row_as_header)) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID,
+        "Selecting columns by name requires a header row");
+    return NULL;
+  }
+  if (opts->select_column_count > 0 && !opts->select_columns) {
+    CSV_SET_ERROR(
+        err, GTEXT_CSV_E_INVALID, "Selected column indices must not be NULL");
+    return NULL;
+  }
+  if ((opts->row_condition_count > 0 && !opts->row_conditions) ||
+      (csv_table_filter_has_names(opts) &&
+          !opts->dialect.treat_first_row_as_header)) {
+    CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID,
+        "Row conditions must be given, with names only for a header row");
     return NULL;
   }
 
-  GTEXT_CSV_Table * table = (GTEXT_CSV_Table *)malloc(sizeof(GTEXT_CSV_Table));
+  // Empty input is valid - return empty table
+  if (len == 0) {
+    GTEXT_CSV_Table * empty = csv_create_empty_table(err);
+    if (empty && opts->layout == GTEXT_CSV_LAYOUT_COLUMNS &&
+        csv_table_rows_to_columns(empty) != GTEXT_CSV_OK) {
+      gtext_csv_free_table(empty);
+      CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to allocate columns");
+      return NULL;
+    }
+    return empty;
+  }
+
+  // Create context and allocate table structure
+  GTEXT_CSV_Table * table = csv_create_empty_table(err);
   if (!table) {
-    csv_context_free(ctx);
-    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to allocate table");
     return NULL;
   }
+  csv_context * ctx = table->ctx;
 
-  memset(table, 0, sizeof(GTEXT_CSV_Table));
-  table->ctx = ctx;
-  table->row_capacity = 16;
-  table->rows = (csv_table_row *)csv_arena_alloc_for_context(
-      ctx, sizeof(csv_table_row) * table->row_capacity, 8);
-  if (!table->rows) {
-    free(table);
-    csv_context_free(ctx);
-    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to allocate rows");
-    return NULL;
+  // Column-major tables are filled straight into column storage
+  if (opts->layout == GTEXT_CSV_LAYOUT_COLUMNS) {
+    table->columns = csv_columns_new(ctx);
+    if (!table->columns) {
+      gtext_csv_free_table(table);
+      CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to allocate columns");
+      return NULL;
+    }
   }
 
   // Handle BOM (must be done before setting input buffer for in-situ mode)
@@ -829,8 +2971,7 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_parse_table(const void * data, size_t len,
         csv_strip_bom(&input, &input_len, &pos, true, &was_stripped);
     if (status != GTEXT_CSV_OK) {
       CSV_SET_ERROR(err, status, "Overflow in BOM stripping");
-      free(table);
-      csv_context_free(ctx);
+      gtext_csv_free_table(table);
       return NULL;
     }
   }
@@ -840,9 +2981,10 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_parse_table(const void * data, size_t len,
     csv_context_set_input_buffer(ctx, input, input_len);
   }
 
-  // Parse
-  GTEXT_CSV_Status status =
-      csv_table_parse_internal(table, input, input_len, opts, err);
+  // Parse (column-major tables are always parsed on the calling thread)
+  GTEXT_CSV_Status status = table->columns
+      ? csv_table_parse_internal(table, input, input_len, opts, err)
+      : csv_table_parse_dispatch(table, input, input_len, opts, err);
   if (status != GTEXT_CSV_OK) {
     gtext_csv_free_table(table);
     return NULL;
@@ -852,8 +2994,7 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_parse_table(const void * data, size_t len,
   // This is needed for tables without headers, and will be overridden for
   // tables with headers
   if (table->row_count > 0) {
-    csv_table_row * first_row = &table->rows[0];
-    table->column_count = first_row->field_count;
+    table->column_count = csv_table_row_width(table, 0);
   }
 
   // Process header if enabled
@@ -870,7 +3011,18 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_parse_table(const void * data, size_t len,
     return NULL;
   }
 
-  csv_table_row * header_row = &table->rows[0];
+  // In column layout the header map is built from a copy of the header row
+  // as field structures, which column storage does not keep
+  csv_table_row header_row_copy;
+  csv_table_row * header_row = &header_row_copy;
+  if (!table->columns) {
+    header_row = csv_table_row_at(table, 0);
+  }
+  else if (csv_columns_copy_row(table, 0, &header_row_copy) != GTEXT_CSV_OK) {
+    gtext_csv_free_table(table);
+    CSV_SET_ERROR(err, GTEXT_CSV_E_OOM, "Failed to allocate header row");
+    return NULL;
+  }
   // Column count already set above, but ensure it's correct
   table->column_count = header_row->field_count;
   for (size_t i = 0; i < header_row->field_count; i++) {
@@ -944,7 +3096,12 @@ GTEXT_API void gtext_csv_free_table(GTEXT_CSV_Table * table) {
     free(table->header_map);
   }
 
+  csv_table_indexes_free(table);
+  csv_table_free_rows(table);
+  csv_columns_free(table->columns);
+  csv_table_compaction_abandon(table);
   csv_context_free(table->ctx);
+  csv_table_share_release(table->share);
   free(table);
 }
 
@@ -976,7 +3133,7 @@ GTEXT_API size_t gtext_csv_col_count(
     return 0;
   }
 
-  return table->rows[adjusted_row].field_count;
+  return csv_table_row_width(table, adjusted_row);
 }
 
 GTEXT_API const char * gtext_csv_field(
@@ -1001,19 +3158,20 @@ GTEXT_API const char * gtext_csv_field(
     return NULL;
   }
 
-  csv_table_row * table_row = &table->rows[adjusted_row];
-  if (col >= table_row->field_count) {
+  if (col >= csv_table_row_width(table, adjusted_row)) {
     if (len) {
       *len = 0;
     }
     return NULL;
   }
 
-  csv_table_field * field = &table_row->fields[col];
+  size_t field_len;
+  const char * field_data =
+      csv_table_cell(table, adjusted_row, col, &field_len);
   if (len) {
-    *len = field->length;
+    *len = field_len;
   }
-  return field->data;
+  return field_data;
 }
 
 static GTEXT_CSV_Status csv_row_prepare_fields(GTEXT_CSV_Table * table,
@@ -1097,8 +3255,7 @@ static GTEXT_CSV_Status csv_row_prepare_fields(GTEXT_CSV_Table * table,
 }
 
 static GTEXT_CSV_Status csv_row_allocate_structures(GTEXT_CSV_Table * table,
-    size_t field_count, csv_table_field ** new_fields_out,
-    csv_table_row ** new_rows_out, size_t * new_capacity_out) {
+    size_t row_idx, size_t field_count, csv_table_field ** new_fields_out) {
   // Phase 4: Field Array Allocation
   csv_table_field * new_fields = (csv_table_field *)csv_arena_alloc_for_context(
       table->ctx, sizeof(csv_table_field) * field_count, 8);
@@ -1109,28 +3266,12 @@ static GTEXT_CSV_Status csv_row_allocate_structures(GTEXT_CSV_Table * table,
   }
 
   // Phase 5: Row Capacity Growth (if needed)
-  // Pre-allocate row capacity but don't update table->rows yet
-  csv_table_row * new_rows = table->rows;
-  size_t new_capacity = table->row_capacity;
-  if (table->row_count >= table->row_capacity) {
-    new_capacity = table->row_capacity * 2;
-    // Check for overflow
-    if (new_capacity < table->row_capacity) {
-      return GTEXT_CSV_E_OOM;
-    }
-    new_rows = (csv_table_row *)csv_arena_alloc_for_context(
-        table->ctx, sizeof(csv_table_row) * new_capacity, 8);
-    if (!new_rows) {
-      // Allocation failed - previous allocations remain in arena
-      return GTEXT_CSV_E_OOM;
-    }
-    // Copy existing rows (but don't update table->rows yet)
-    memcpy(new_rows, table->rows, sizeof(csv_table_row) * table->row_count);
+  // Only allocates (row blocks, block index), so existing rows are untouched
+  if (csv_table_prepare_row_insert(table, row_idx) != GTEXT_CSV_OK) {
+    return GTEXT_CSV_E_OOM;
   }
 
   *new_fields_out = new_fields;
-  *new_rows_out = new_rows;
-  *new_capacity_out = new_capacity;
   return GTEXT_CSV_OK;
 }
 
@@ -1144,6 +3285,16 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_append(GTEXT_CSV_Table * table,
     }
     return GTEXT_CSV_E_INVALID;
   }
+
+  // Row operations work on the row layout
+  GTEXT_CSV_Status layout_status = csv_table_require_rows(table);
+  if (layout_status != GTEXT_CSV_OK) {
+    if (err) {
+      CSV_SET_ERROR(err, layout_status, "Failed to convert table to rows");
+    }
+    return layout_status;
+  }
+
   if (!fields) {
     if (err) {
       CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Fields array must not be NULL");
@@ -1173,7 +3324,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_append(GTEXT_CSV_Table * table,
         size_t expected_count = table->column_count;
         if (table->has_header && table->row_count > 0) {
           // Use header row field count if column_count is 0
-          expected_count = table->rows[0].field_count;
+          expected_count = csv_table_row_at(table, 0)->field_count;
         }
         csv_set_field_count_error(err, expected_count, field_count, SIZE_MAX);
         return GTEXT_CSV_E_INVALID;
@@ -1197,25 +3348,16 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_append(GTEXT_CSV_Table * table,
 
   // Phase 4-5: Allocate structures (field array, row capacity growth if needed)
   csv_table_field * new_fields;
-  csv_table_row * new_rows;
-  size_t new_capacity;
   status = csv_row_allocate_structures(
-      table, field_count, &new_fields, &new_rows, &new_capacity);
+      table, table->row_count, field_count, &new_fields);
   if (status != GTEXT_CSV_OK) {
     return status;
   }
 
   // Phase 6: Atomic State Update
   // Only after all allocations succeed:
-  // 1. Update row capacity if it was grown
-  if (new_rows != table->rows) {
-    table->rows = new_rows;
-    table->row_capacity = new_capacity;
-  }
-
-  // 2. Get pointer to new row (now safe since row capacity is updated if
-  // needed)
-  csv_table_row * new_row = &table->rows[table->row_count];
+  // 1-2. Get pointer to new row (row capacity was reserved above)
+  csv_table_row * new_row = csv_table_insert_row_slot(table, table->row_count);
 
   // 3. Set up field structures
   for (size_t i = 0; i < field_count; i++) {
@@ -1246,6 +3388,9 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_append(GTEXT_CSV_Table * table,
   // 6. Increment row count
   table->row_count++;
 
+  // 7. Add the row to column indexes
+  csv_table_indexes_row_appended(table);
+
   return GTEXT_CSV_OK;
 }
 
@@ -1259,6 +3404,16 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_insert(GTEXT_CSV_Table * table,
     }
     return GTEXT_CSV_E_INVALID;
   }
+
+  // Row operations work on the row layout
+  GTEXT_CSV_Status layout_status = csv_table_require_rows(table);
+  if (layout_status != GTEXT_CSV_OK) {
+    if (err) {
+      CSV_SET_ERROR(err, layout_status, "Failed to convert table to rows");
+    }
+    return layout_status;
+  }
+
   if (!fields) {
     if (err) {
       CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Fields array must not be NULL");
@@ -1303,7 +3458,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_insert(GTEXT_CSV_Table * table,
         size_t expected_count = table->column_count;
         if (table->has_header && table->row_count > 0) {
           // Use header row field count if column_count is 0
-          expected_count = table->rows[0].field_count;
+          expected_count = csv_table_row_at(table, 0)->field_count;
         }
         csv_set_field_count_error(err, expected_count, field_count, row_idx);
         return GTEXT_CSV_E_INVALID;
@@ -1329,44 +3484,18 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_insert(GTEXT_CSV_Table * table,
   }
 
   // Phase 4-5: Allocate structures (field array, row capacity growth if needed)
+  size_t slot_idx = is_append ? table->row_count : adjusted_row_idx;
   csv_table_field * new_fields;
-  csv_table_row * new_rows;
-  size_t new_capacity;
   status = csv_row_allocate_structures(
-      table, field_count, &new_fields, &new_rows, &new_capacity);
+      table, slot_idx, field_count, &new_fields);
   if (status != GTEXT_CSV_OK) {
     return status;
   }
 
-  // Phase 6: Row Shifting (if not appending)
-  // Critical: Only shift rows AFTER all allocations succeed
-  // This creates the gap for the new row
-  if (!is_append) {
-    // Shift rows from adjusted_row_idx to row_count-1 one position right
-    // Use new_rows array (which may be the same as table->rows if capacity
-    // didn't grow) Shift in reverse order to avoid overwriting
-    for (size_t i = table->row_count; i > adjusted_row_idx; i--) {
-      new_rows[i] = new_rows[i - 1];
-    }
-  }
-
-  // Phase 7: Atomic State Update
-  // Only after all allocations and shifting succeed:
-  // 1. Update row capacity if it was grown
-  if (new_rows != table->rows) {
-    table->rows = new_rows;
-    table->row_capacity = new_capacity;
-  }
-
-  // 2. Get pointer to new row (now safe since row capacity is updated if
-  // needed)
-  csv_table_row * new_row;
-  if (is_append) {
-    new_row = &table->rows[table->row_count];
-  }
-  else {
-    new_row = &table->rows[adjusted_row_idx];
-  }
+  // Phase 6-7: Row Slot and Atomic State Update
+  // Critical: Only open the slot AFTER all allocations succeed
+  // Rows after the slot move within their row block only
+  csv_table_row * new_row = csv_table_insert_row_slot(table, slot_idx);
 
   // 3. Set up field structures
   for (size_t i = 0; i < field_count; i++) {
@@ -1397,6 +3526,9 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_insert(GTEXT_CSV_Table * table,
   // 6. Increment row count
   table->row_count++;
 
+  // Later rows move down, so indexed row numbers shift by one
+  csv_table_indexes_row_inserted(table, row_idx);
+
   return GTEXT_CSV_OK;
 }
 
@@ -1407,8 +3539,8 @@ static size_t csv_recalculate_max_column_count(const GTEXT_CSV_Table * table) {
 
   size_t max_count = 0;
   for (size_t i = 0; i < table->row_count; i++) {
-    if (table->rows[i].field_count > max_count) {
-      max_count = table->rows[i].field_count;
+    if (csv_table_row_at(table, i)->field_count > max_count) {
+      max_count = csv_table_row_at(table, i)->field_count;
     }
   }
 
@@ -1422,6 +3554,12 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_remove(
     return GTEXT_CSV_E_INVALID;
   }
 
+  // Row operations work on the row layout
+  GTEXT_CSV_Status layout_status = csv_table_require_rows(table);
+  if (layout_status != GTEXT_CSV_OK) {
+    return layout_status;
+  }
+
   // Calculate data row count (excluding header if present)
   size_t data_row_count = csv_get_data_row_count(table);
 
@@ -1445,14 +3583,22 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_remove(
 
   // Store the removed row's field_count before shifting (needed for column_count
   // recalculation in irregular mode)
-  size_t removed_row_field_count = table->rows[adjusted_row_idx].field_count;
+  size_t removed_row_field_count =
+      csv_table_row_at(table, adjusted_row_idx)->field_count;
 
-  // Shift rows from adjusted_row_idx+1 to row_count-1 one position left
-  // Shift in forward order (left shift)
-  for (size_t i = adjusted_row_idx; i < table->row_count - 1; i++) {
-    table->rows[i] = table->rows[i + 1];
+  // A row block shared with a clone is copied before rows move within it
+  GTEXT_CSV_Status own_status =
+      csv_table_own_remove_block(table, adjusted_row_idx);
+  if (own_status != GTEXT_CSV_OK) {
+    return own_status;
   }
 
+  // The row leaves its indexes, and later indexed rows move up by one
+  csv_table_indexes_row_removing(table, row_idx);
+
+  // Close the row's slot (rows after it move within their row block only)
+  csv_table_remove_row_slot(table, adjusted_row_idx);
+
   // Decrement row count
   table->row_count--;
 
@@ -1479,6 +3625,16 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_set(GTEXT_CSV_Table * table,
     }
     return GTEXT_CSV_E_INVALID;
   }
+
+  // Row operations work on the row layout
+  GTEXT_CSV_Status layout_status = csv_table_require_rows(table);
+  if (layout_status != GTEXT_CSV_OK) {
+    if (err) {
+      CSV_SET_ERROR(err, layout_status, "Failed to convert table to rows");
+    }
+    return layout_status;
+  }
+
   if (!fields) {
     if (err) {
       CSV_SET_ERROR(err, GTEXT_CSV_E_INVALID, "Fields array must not be NULL");
@@ -1517,7 +3673,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_set(GTEXT_CSV_Table * table,
     size_t expected_column_count = table->column_count;
     if (expected_column_count == 0 && table->has_header &&
         table->row_count > 0) {
-      expected_column_count = table->rows[0].field_count;
+      expected_column_count = csv_table_row_at(table, 0)->field_count;
     }
     if (field_count != expected_column_count) {
       csv_set_field_count_error(err, expected_column_count, field_count, row_idx);
@@ -1527,8 +3683,14 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_set(GTEXT_CSV_Table * table,
   // Irregular mode: accept any field count, will update row's field_count and
   // column_count to max if needed
 
+  // A row shared with a clone is copied before it is rewritten
+  GTEXT_CSV_Status own_status = csv_table_own_row(table, adjusted_row_idx);
+  if (own_status != GTEXT_CSV_OK) {
+    return own_status;
+  }
+
   // Get existing row
-  csv_table_row * existing_row = &table->rows[adjusted_row_idx];
+  csv_table_row * existing_row = csv_table_row_at(table, adjusted_row_idx);
 
   // Phase 1: Validate fields and calculate total size needed in one pass
   // This ensures atomic operation - if validation or allocation fails, row
@@ -1618,6 +3780,9 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_set(GTEXT_CSV_Table * table,
       return GTEXT_CSV_E_OOM;
     }
 
+    // The row's old values leave its indexes
+    csv_table_indexes_row_unlink(table, row_idx);
+
     // Copy existing fields (up to min(old_count, new_count))
     size_t fields_to_copy =
         (old_field_count < field_count) ? old_field_count : field_count;
@@ -1643,6 +3808,9 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_set(GTEXT_CSV_Table * table,
     existing_row->field_count = field_count;
   }
   else {
+    // The row's old values leave its indexes
+    csv_table_indexes_row_unlink(table, row_idx);
+
     // Field count unchanged: update fields in place
     for (size_t i = 0; i < field_count; i++) {
       csv_table_field * field = &existing_row->fields[i];
@@ -1663,6 +3831,9 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_row_set(GTEXT_CSV_Table * table,
     table->column_count = field_count;
   }
 
+  // The row's new values join its indexes
+  csv_table_indexes_row_link(table, row_idx);
+
   return GTEXT_CSV_OK;
 }
 
@@ -1690,16 +3861,13 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_field_set(GTEXT_CSV_Table * table,
     return GTEXT_CSV_E_INVALID;
   }
 
-  // Get the row
-  csv_table_row * table_row = &table->rows[adjusted_row];
-
   // Validate column index
-  if (col >= table_row->field_count) {
+  if (col >= csv_table_row_width(table, adjusted_row)) {
     return GTEXT_CSV_E_INVALID;
   }
 
-  // Get existing field
-  csv_table_field * field = &table_row->fields[col];
+  // An index on the column no longer matches the table
+  csv_table_indexes_invalidate(table, col);
 
   // Determine field length
   // Note: gtext_csv_field_set uses field_length parameter directly (not an
@@ -1712,6 +3880,21 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_field_set(GTEXT_CSV_Table * table,
     field_len = field_length;
   }
 
+  // Column layout: the new value is appended to the column heap
+  if (table->columns) {
+    return csv_columns_set_cell(
+        table->ctx, table->columns, adjusted_row, col, field_data, field_len);
+  }
+
+  // A row shared with a clone is copied before it is rewritten
+  GTEXT_CSV_Status status = csv_table_own_row(table, adjusted_row);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+
+  // Get existing field
+  csv_table_field * field = &csv_table_row_at(table, adjusted_row)->fields[col];
+
   // Use global empty string constant for empty fields (saves arena allocation)
   if (field_len == 0) {
     csv_setup_empty_field(field);
@@ -1719,7 +3902,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_field_set(GTEXT_CSV_Table * table,
   }
 
   // Allocate and copy field data to arena
-  GTEXT_CSV_Status status =
+  status =
       csv_allocate_and_copy_field(table->ctx, field_data, field_len, field);
   if (status != GTEXT_CSV_OK) {
     return status;
@@ -1740,16 +3923,12 @@ static GTEXT_CSV_Status csv_calculate_compact_size(
     return GTEXT_CSV_E_INVALID;
   }
 
+  // Row blocks live outside the arena and are kept as they are
   size_t total_size = 0;
 
-  // Rows array (aligned to 8 bytes)
-  size_t rows_array_size = sizeof(csv_table_row) * table->row_capacity;
-  size_t rows_array_aligned = (rows_array_size + 7) & ~7; // Align to 8
-  total_size = rows_array_aligned;
-
   // Calculate size for all rows and fields
   for (size_t row_idx = 0; row_idx < table->row_count; row_idx++) {
-    csv_table_row * old_row = &table->rows[row_idx];
+    csv_table_row * old_row = csv_table_row_at(table, row_idx);
 
     if (old_row->field_count == 0) {
       continue;
@@ -1853,22 +4032,19 @@ static GTEXT_CSV_Status csv_preallocate_compact_structures(
   structures_out->new_field_arrays = NULL;
   structures_out->new_field_data_ptrs = NULL;
 
-  // Allocate new rows array in new arena
-  csv_table_row * new_rows = (csv_table_row *)csv_arena_alloc_for_context(
-      new_ctx, sizeof(csv_table_row) * table->row_capacity, 8);
-  if (!new_rows) {
-    return GTEXT_CSV_E_OOM;
-  }
-
-  // Initialize new rows array (zero out unused entries)
-  memset(new_rows, 0, sizeof(csv_table_row) * table->row_capacity);
-  structures_out->new_rows = new_rows;
-
-  // Pre-allocate all field arrays and field data
-  // Store pointers in temporary arrays
+  // Stage the compacted rows; they are copied into the row blocks only once
+  // everything else has succeeded (the caller frees this array)
   csv_table_field ** new_field_arrays = NULL;
   char *** new_field_data_ptrs = NULL; // Array of arrays of char * pointers
   if (table->row_count > 0) {
+    structures_out->new_rows =
+        (csv_table_row *)calloc(table->row_count, sizeof(csv_table_row));
+    if (!structures_out->new_rows) {
+      return GTEXT_CSV_E_OOM;
+    }
+
+    // Pre-allocate all field arrays and field data
+    // Store pointers in temporary arrays
     new_field_arrays = (csv_table_field **)malloc(
         sizeof(csv_table_field *) * table->row_count);
     new_field_data_ptrs = (char ***)malloc(sizeof(char **) * table->row_count);
@@ -1883,7 +4059,7 @@ static GTEXT_CSV_Status csv_preallocate_compact_structures(
 
   // Pre-allocate all field arrays and field data blocks
   for (size_t row_idx = 0; row_idx < table->row_count; row_idx++) {
-    csv_table_row * old_row = &table->rows[row_idx];
+    csv_table_row * old_row = csv_table_row_at(table, row_idx);
     new_field_arrays[row_idx] = NULL;
     new_field_data_ptrs[row_idx] = NULL;
 
@@ -1977,7 +4153,7 @@ static GTEXT_CSV_Status csv_copy_data_to_new_arena(
 
   // Copy all row and field data
   for (size_t row_idx = 0; row_idx < table->row_count; row_idx++) {
-    csv_table_row * old_row = &table->rows[row_idx];
+    csv_table_row * old_row = csv_table_row_at(table, row_idx);
     csv_table_row * new_row = &structures->new_rows[row_idx];
 
     // Skip empty rows
@@ -2211,93 +4387,391 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_table_compact(GTEXT_CSV_Table * table) {
     return GTEXT_CSV_E_INVALID;
   }
 
-  // Calculate total size needed for compaction
-  size_t total_size = 0;
-  GTEXT_CSV_Status status = csv_calculate_compact_size(table, &total_size);
+  if (table->columns) {
+    return csv_columns_compact_table(table);
+  }
+
+  // A running incremental compaction is superseded by this one
+  csv_table_compaction_abandon(table);
+
+  // Rows are stored back into the row blocks, so shared blocks are copied
+  // first
+  GTEXT_CSV_Status status = csv_table_unshare(table);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+
+  // Calculate total size needed for compaction
+  size_t total_size = 0;
+  status = csv_calculate_compact_size(table, &total_size);
+  if (status != GTEXT_CSV_OK) {
+    return status;
+  }
+
+  // Create new context/arena with calculated block size
+  csv_context * new_ctx = csv_context_new_with_block_size(total_size);
+  if (!new_ctx) {
+    return GTEXT_CSV_E_OOM;
+  }
+
+  // Pre-allocate all structures in new arena
+  csv_compact_structures structures = {0};
+  status = csv_preallocate_compact_structures(table, new_ctx, &structures);
+  if (status != GTEXT_CSV_OK) {
+    free(structures.new_rows);
+    csv_context_free(new_ctx);
+    return status;
+  }
+
+  // Copy all data to pre-allocated structures
+  status = csv_copy_data_to_new_arena(table, &structures);
+  if (status != GTEXT_CSV_OK) {
+    // Free temporary arrays
+    if (structures.new_field_data_ptrs) {
+      for (size_t row_idx = 0; row_idx < table->row_count; row_idx++) {
+        free(structures.new_field_data_ptrs[row_idx]);
+      }
+    }
+    free(structures.new_field_arrays);
+    free(structures.new_field_data_ptrs);
+    free(structures.new_rows);
+    csv_context_free(new_ctx);
+    return status;
+  }
+
+  // Free temporary arrays (field data pointers)
+  if (structures.new_field_data_ptrs) {
+    for (size_t row_idx = 0; row_idx < table->row_count; row_idx++) {
+      free(structures.new_field_data_ptrs[row_idx]);
+    }
+  }
+  free(structures.new_field_arrays);
+  free(structures.new_field_data_ptrs);
+
+  // Save old context for header map copying (need input_buffer reference)
+  csv_context * old_ctx = table->ctx;
+
+  // Rebuild header map in new arena
+  csv_compact_header_map header_map;
+  status = csv_rebuild_header_map(table, old_ctx, new_ctx, &header_map);
+  if (status != GTEXT_CSV_OK) {
+    free(structures.new_rows);
+    csv_context_free(new_ctx);
+    return status;
+  }
+
+  // Phase 5: Atomic Context Switch
+  // Only after all allocations and copies succeed:
+  // 1. Preserve input buffer reference (for in-situ mode, caller-owned)
+  new_ctx->input_buffer = old_ctx->input_buffer;
+  new_ctx->input_buffer_len = old_ctx->input_buffer_len;
+
+  // 2. Atomically update table structure (the row blocks already hold
+  // row_count slots, so storing the staged rows cannot fail), and free row
+  // blocks left empty by removed rows
+  table->ctx = new_ctx;
+  csv_table_store_rows(table, structures.new_rows, table->row_count);
+  free(structures.new_rows);
+  csv_table_trim_rows(table);
+  table->index_to_entry = NULL; // Lived in the old arena
+  table->index_to_entry_capacity = 0;
+  if (header_map.new_header_map) {
+    // Free old header map array before updating pointer
+    free(table->header_map);
+    table->header_map = header_map.new_header_map;
+
+    // Rebuild reverse mapping
+    csv_rebuild_index_to_entry(table);
+  }
+
+  // 3. Free old context (which frees old arena)
+  // Note: This frees all old structures in the old arena:
+  // - Old field arrays (including those of rows replaced by row_set)
+  // - Old field data (non-in-situ fields)
+  // - Old header map entries
+  // The arena tracks blocks, not individual allocations, so overwriting
+  // pointers doesn't cause leaks - all blocks in the arena's linked list are
+  // freed.
+  // Note: input_buffer is caller-owned, so we don't free it
+  csv_context_free(old_ctx);
+
+  // Every field now lives in the new arena, so shares are no longer read
+  csv_table_share_release(table->share);
+  table->share = NULL;
+
+  return GTEXT_CSV_OK;
+}
+
+// Whether ptr points into the arena retired by a running compaction
+static bool csv_table_compaction_owns(
+    const csv_table_compaction * comp, const void * ptr) {
+  return csv_arena_blocks_contain(comp->blocks, comp->block_count, ptr);
+}
+
+// Retire the table's arena and give the table a new one
+static GTEXT_CSV_Status csv_table_compaction_start(GTEXT_CSV_Table * table) {
+  csv_table_compaction * comp =
+      (csv_table_compaction *)calloc(1, sizeof(csv_table_compaction));
+  csv_arena * to = csv_arena_new(0);
+  if (!comp || !to ||
+      csv_arena_sorted_blocks(table->ctx->arena, &comp->blocks,
+          &comp->block_count) != GTEXT_CSV_OK) {
+    free(comp);
+    csv_arena_free(to);
+    return GTEXT_CSV_E_OOM;
+  }
+
+  comp->from = table->ctx->arena;
+  comp->next_row = 0;
+  table->ctx->arena = to;
+  table->compaction = comp;
+  return GTEXT_CSV_OK;
+}
+
+// Copy the field array and field data of row row_idx that still live in the
+// retired arena
+// On failure the row stays valid: fields copied so far point to their
+// copies, the others into the retired arena
+static GTEXT_CSV_Status csv_table_relocate_row(
+    GTEXT_CSV_Table * table, size_t row_idx) {
+  const csv_table_compaction * comp = table->compaction;
+  csv_table_row * row = csv_table_row_at(table, row_idx);
+  if (row->field_count == 0 || !row->fields) {
+    return GTEXT_CSV_OK;
+  }
+
+  csv_table_field * fields = row->fields;
+  if (csv_table_compaction_owns(comp, fields)) {
+    fields = (csv_table_field *)csv_arena_alloc_for_context(
+        table->ctx, sizeof(csv_table_field) * row->field_count, 8);
+    if (!fields) {
+      return GTEXT_CSV_E_OOM;
+    }
+    memcpy(fields, row->fields, sizeof(csv_table_field) * row->field_count);
+  }
+
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  for (size_t i = 0; i < row->field_count; i++) {
+    csv_table_field * field = &fields[i];
+    if (field->is_in_situ || !csv_table_compaction_owns(comp, field->data)) {
+      continue;
+    }
+    if (field->length == 0) {
+      csv_setup_empty_field(field);
+      continue;
+    }
+    status = csv_allocate_and_copy_field(
+        table->ctx, field->data, field->length, field);
+    if (status != GTEXT_CSV_OK) {
+      break;
+    }
+  }
+  // A row block shared with a clone is only read, never written
+  if (fields != row->fields) {
+    row->fields = fields;
+  }
+  return status;
+}
+
+// Copy the header map and its reverse mapping into the table's arena
+// The table is unchanged on failure
+static GTEXT_CSV_Status csv_table_relocate_header_map(
+    GTEXT_CSV_Table * table) {
+  csv_compact_header_map header_map;
+  GTEXT_CSV_Status status =
+      csv_rebuild_header_map(table, table->ctx, table->ctx, &header_map);
   if (status != GTEXT_CSV_OK) {
     return status;
   }
-
-  // Create new context/arena with calculated block size
-  csv_context * new_ctx = csv_context_new_with_block_size(total_size);
-  if (!new_ctx) {
-    return GTEXT_CSV_E_OOM;
+  if (!header_map.new_header_map) {
+    // Headers were turned off; drop the reverse mapping left behind
+    table->index_to_entry = NULL;
+    table->index_to_entry_capacity = 0;
+    return GTEXT_CSV_OK;
   }
 
-  // Pre-allocate all structures in new arena
-  csv_compact_structures structures;
-  status = csv_preallocate_compact_structures(table, new_ctx, &structures);
+  csv_header_entry ** old_map = table->header_map;
+  csv_header_entry ** old_index = table->index_to_entry;
+  size_t old_capacity = table->index_to_entry_capacity;
+  table->header_map = header_map.new_header_map;
+  table->index_to_entry = NULL;
+  table->index_to_entry_capacity = 0;
+  status = csv_rebuild_index_to_entry(table);
   if (status != GTEXT_CSV_OK) {
-    csv_context_free(new_ctx);
+    free(table->header_map);
+    table->header_map = old_map;
+    table->index_to_entry = old_index;
+    table->index_to_entry_capacity = old_capacity;
     return status;
   }
+  free(old_map);
+  return GTEXT_CSV_OK;
+}
 
-  // Copy all data to pre-allocated structures
-  status = csv_copy_data_to_new_arena(table, &structures);
-  if (status != GTEXT_CSV_OK) {
-    // Free temporary arrays
-    if (structures.new_field_data_ptrs) {
-      for (size_t row_idx = 0; row_idx < table->row_count; row_idx++) {
-        free(structures.new_field_data_ptrs[row_idx]);
-      }
+GTEXT_API GTEXT_CSV_Status gtext_csv_table_compact_step(
+    GTEXT_CSV_Table * table, size_t max_rows, bool * done) {
+  if (done) {
+    *done = false;
+  }
+  if (!table || max_rows == 0) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  // Column-major cells are not in the arena; compact them in one go
+  GTEXT_CSV_Status status;
+  if (table->columns) {
+    status = csv_columns_compact_table(table);
+    if (status == GTEXT_CSV_OK && done) {
+      *done = true;
     }
-    free(structures.new_field_arrays);
-    free(structures.new_field_data_ptrs);
-    csv_context_free(new_ctx);
     return status;
   }
 
-  // Free temporary arrays (field data pointers)
-  if (structures.new_field_data_ptrs) {
-    for (size_t row_idx = 0; row_idx < table->row_count; row_idx++) {
-      free(structures.new_field_data_ptrs[row_idx]);
+  if (!table->compaction) {
+    status = csv_table_compaction_start(table);
+    if (status != GTEXT_CSV_OK) {
+      return status;
     }
   }
-  free(structures.new_field_arrays);
-  free(structures.new_field_data_ptrs);
 
-  // Save old context for header map copying (need input_buffer reference)
-  csv_context * old_ctx = table->ctx;
+  csv_table_compaction * comp = table->compaction;
+  for (size_t moved = 0; moved < max_rows && comp->next_row < table->row_count;
+      moved++) {
+    status = csv_table_relocate_row(table, comp->next_row);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+    comp->next_row++;
+  }
+  if (comp->next_row < table->row_count) {
+    return GTEXT_CSV_OK;
+  }
 
-  // Rebuild header map in new arena
-  csv_compact_header_map header_map;
-  status = csv_rebuild_header_map(table, old_ctx, new_ctx, &header_map);
+  // Every row is out of the retired arena; the header map is the last thing
+  // pointing into it
+  status = csv_table_relocate_header_map(table);
   if (status != GTEXT_CSV_OK) {
-    csv_context_free(new_ctx);
     return status;
   }
+  csv_arena_free(comp->from);
+  free(comp->blocks);
+  free(comp);
+  table->compaction = NULL;
+  if (done) {
+    *done = true;
+  }
+  return GTEXT_CSV_OK;
+}
 
-  // Phase 5: Atomic Context Switch
-  // Only after all allocations and copies succeed:
-  // 1. Preserve input buffer reference (for in-situ mode, caller-owned)
-  new_ctx->input_buffer = old_ctx->input_buffer;
-  new_ctx->input_buffer_len = old_ctx->input_buffer_len;
+// Arena bytes of the header map: entries, copied names, and the reverse
+// mapping
+static size_t csv_table_header_map_bytes(const GTEXT_CSV_Table * table) {
+  if (!table->header_map) {
+    return 0;
+  }
 
-  // 2. Atomically update table structure
-  table->ctx = new_ctx;
-  table->rows = structures.new_rows;
-  if (header_map.new_header_map) {
-    // Free old header map array before updating pointer
-    free(table->header_map);
-    table->header_map = header_map.new_header_map;
+  // Entries a clone left in a shared arena are not in the table's arena
+  size_t bytes = 0;
+  if (!csv_table_share_owns(table->share, table->index_to_entry)) {
+    bytes += sizeof(csv_header_entry *) * table->index_to_entry_capacity;
+  }
 
-    // Rebuild reverse mapping
-    csv_rebuild_index_to_entry(table);
+  const char * input_start = table->ctx->input_buffer;
+  const char * input_end = input_start + table->ctx->input_buffer_len;
+  for (size_t i = 0; i < table->header_map_size; i++) {
+    for (const csv_header_entry * entry = table->header_map[i]; entry;
+        entry = entry->next) {
+      if (!csv_table_share_owns(table->share, entry)) {
+        bytes += sizeof(csv_header_entry);
+      }
+      bool name_is_in_situ = input_start && entry->name >= input_start &&
+          entry->name < input_end;
+      if (entry->name_len > 0 && !name_is_in_situ &&
+          !csv_table_share_owns(table->share, entry->name)) {
+        bytes += entry->name_len + 1;
+      }
+    }
   }
+  return bytes;
+}
 
-  // 3. Free old context (which frees old arena)
-  // Note: This frees all old structures in the old arena:
-  // - Old rows array (even if it was reallocated/grown, all old versions
-  //   are in arena blocks that are tracked and freed)
-  // - Old field arrays
-  // - Old field data (non-in-situ fields)
-  // - Old header map entries
-  // The arena tracks blocks, not individual allocations, so overwriting
-  // pointers (like when rows array grows) doesn't cause leaks - all blocks
-  // in the arena's linked list are freed.
-  // Note: input_buffer is caller-owned, so we don't free it
-  csv_context_free(old_ctx);
+GTEXT_API GTEXT_CSV_Status gtext_csv_table_memory_stats(
+    const GTEXT_CSV_Table * table, GTEXT_CSV_Memory_Stats * stats) {
+  if (!table || !stats) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  memset(stats, 0, sizeof(*stats));
+
+  if (table->ctx && table->ctx->arena) {
+    for (const csv_arena_block * block = table->ctx->arena->first; block;
+        block = block->next) {
+      stats->arena_bytes += block->size;
+      stats->arena_used_bytes += block->used;
+    }
+  }
+  if (table->compaction) {
+    for (const csv_arena_block * block = table->compaction->from->first;
+        block; block = block->next) {
+      stats->arena_bytes += block->size;
+      stats->arena_used_bytes += block->used;
+      stats->compacting_bytes += block->size;
+    }
+  }
+  for (const csv_table_share * share = table->share; share;
+      share = share->parent) {
+    for (size_t i = 0; i < share->arena_block_count; i++) {
+      stats->shared_bytes += share->arena_blocks[i]->used;
+    }
+  }
+  stats->live_bytes = csv_table_header_map_bytes(table);
+
+  stats->row_index_bytes = sizeof(csv_table_row) * table->row_capacity +
+      sizeof(csv_table_row *) * table->row_block_capacity;
+  if (!table->columns) {
+    stats->row_slack_bytes =
+        sizeof(csv_table_row) * (table->row_capacity - table->row_count);
+    for (size_t i = 0; i < table->row_count; i++) {
+      const csv_table_row * row = csv_table_row_at(table, i);
+      size_t array_bytes = sizeof(csv_table_field) * row->field_count;
+      stats->field_array_bytes += array_bytes;
+      // A field array still shared with a clone only holds shared data
+      if (row->field_count == 0 ||
+          csv_table_share_owns(table->share, row->fields)) {
+        continue;
+      }
+      stats->live_bytes += array_bytes;
+      for (size_t col = 0; col < row->field_count; col++) {
+        const csv_table_field * field = &row->fields[col];
+        if (field->length > 0 && !field->is_in_situ &&
+            !csv_table_share_owns(table->share, field->data)) {
+          stats->live_bytes += field->length + 1;
+        }
+      }
+    }
+  }
+  else {
+    // Only the live cells of the heap count; replaced cells and heaps left
+    // behind by growth are dead
+    const csv_table_columns * cols = table->columns;
+    stats->column_bytes = sizeof(csv_table_column) * cols->column_capacity +
+        sizeof(size_t) * cols->row_capacity * (2 * cols->column_count + 1);
+    stats->live_bytes += 1; // Shared empty cell
+    for (size_t col = 0; col < cols->column_count; col++) {
+      const csv_table_column * column = &cols->columns[col];
+      for (size_t i = 0; i < table->row_count; i++) {
+        if (col < cols->widths[i]) {
+          stats->live_bytes += csv_columns_cell_size(column->lengths[i]);
+        }
+      }
+    }
+  }
 
+  // Data shared between fields (e.g. after a layout switch) can make the
+  // estimate exceed what is used
+  if (stats->live_bytes > stats->arena_used_bytes) {
+    stats->live_bytes = stats->arena_used_bytes;
+  }
+  stats->dead_bytes = stats->arena_used_bytes - stats->live_bytes;
   return GTEXT_CSV_OK;
 }
 
@@ -2321,8 +4795,8 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_table_clear(GTEXT_CSV_Table * table) {
   else {
     table->row_count = 0; // Clear all rows
   }
+  csv_table_indexes_invalidate(table, SIZE_MAX);
 
-  // Keep row_capacity (for efficiency)
   // Keep column_count (table structure preserved)
   // Keep header_map (if present, table structure preserved)
 
@@ -2359,17 +4833,11 @@ static GTEXT_CSV_Status csv_clone_calculate_size(
   size_t table_aligned = (table_size + 7) & ~7; // Align to 8
   total_size = table_aligned;
 
-  // Rows array (aligned to 8 bytes)
-  size_t rows_array_size = sizeof(csv_table_row) * source->row_capacity;
-  size_t rows_array_aligned = (rows_array_size + 7) & ~7; // Align to 8
-  if (total_size > SIZE_MAX - rows_array_aligned) {
-    return GTEXT_CSV_E_OOM;
-  }
-  total_size += rows_array_aligned;
+  // Row blocks live outside the arena
 
   // Calculate size for all rows and fields
   for (size_t row_idx = 0; row_idx < source->row_count; row_idx++) {
-    csv_table_row * old_row = &source->rows[row_idx];
+    csv_table_row * old_row = csv_table_row_at(source, row_idx);
 
     if (old_row->field_count == 0) {
       continue;
@@ -2475,35 +4943,26 @@ static GTEXT_CSV_Status csv_clone_preallocate_structures(
   // Initialize table structure
   new_table->ctx = new_ctx;
   new_table->row_count = source->row_count;
-  new_table->row_capacity = source->row_capacity;
   new_table->column_count = source->column_count;
   new_table->has_header = source->has_header;
   new_table->header_map = NULL;
   new_table->header_map_size = source->header_map_size;
   structures_out->new_table = new_table;
 
-  // Allocate new rows array in new arena
-  csv_table_row * new_rows = (csv_table_row *)csv_arena_alloc_for_context(
-      new_ctx, sizeof(csv_table_row) * source->row_capacity, 8);
-  if (!new_rows) {
-    free(new_table);
-    return GTEXT_CSV_E_OOM;
-  }
-
-  // Initialize new rows array (zero out unused entries)
-  memset(new_rows, 0, sizeof(csv_table_row) * source->row_capacity);
-  new_table->rows = new_rows;
-  structures_out->new_rows = new_rows;
-
   // Pre-allocate all field arrays and field data
   // Store pointers in temporary arrays
+  // Rows are staged in a temporary array and moved into the new table's row
+  // blocks once the copy is done (the caller frees it)
   csv_table_field ** new_field_arrays = NULL;
   char *** new_field_data_ptrs = NULL; // Array of arrays of char * pointers
   if (source->row_count > 0) {
+    structures_out->new_rows =
+        (csv_table_row *)calloc(source->row_count, sizeof(csv_table_row));
     new_field_arrays = (csv_table_field **)calloc(
         source->row_count, sizeof(csv_table_field *));
     new_field_data_ptrs = (char ***)calloc(source->row_count, sizeof(char **));
-    if (!new_field_arrays || !new_field_data_ptrs) {
+    if (!structures_out->new_rows || !new_field_arrays ||
+        !new_field_data_ptrs) {
       free(new_field_arrays);
       free(new_field_data_ptrs);
       free(new_table);
@@ -2515,7 +4974,7 @@ static GTEXT_CSV_Status csv_clone_preallocate_structures(
 
   // Pre-allocate all field arrays and field data blocks
   for (size_t row_idx = 0; row_idx < source->row_count; row_idx++) {
-    csv_table_row * old_row = &source->rows[row_idx];
+    csv_table_row * old_row = csv_table_row_at(source, row_idx);
     new_field_arrays[row_idx] = NULL;
     new_field_data_ptrs[row_idx] = NULL;
 
@@ -2736,7 +5195,7 @@ static GTEXT_CSV_Status csv_clone_copy_data(const GTEXT_CSV_Table * source,
 
   // Copy All Data (no allocations, just memory operations)
   for (size_t row_idx = 0; row_idx < source->row_count; row_idx++) {
-    csv_table_row * old_row = &source->rows[row_idx];
+    csv_table_row * old_row = csv_table_row_at(source, row_idx);
     csv_table_row * new_row = &new_rows[row_idx];
 
     // Skip empty rows
@@ -2864,6 +5323,10 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_clone(const GTEXT_CSV_Table * source) {
     return NULL;
   }
 
+  if (source->columns) {
+    return csv_table_clone_columns(source);
+  }
+
   // Calculate total size needed for clone
   size_t total_size = 0;
   GTEXT_CSV_Status status = csv_clone_calculate_size(source, &total_size);
@@ -2878,30 +5341,160 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_clone(const GTEXT_CSV_Table * source) {
   }
 
   // Pre-allocate all structures
-  csv_clone_structures structures;
+  // The preallocation frees the table structure itself when it fails
+  csv_clone_structures structures = {0};
   csv_clone_header_map header_map;
   status = csv_clone_preallocate_structures(
       source, new_ctx, &structures, &header_map);
   if (status != GTEXT_CSV_OK) {
-    // Cleanup: free table if allocated, then free context
-    if (structures.new_table) {
-      free(structures.new_table);
-    }
+    free(structures.new_rows);
     csv_context_free(new_ctx);
     return NULL;
   }
 
   // Copy all data to pre-allocated structures
+  GTEXT_CSV_Table * new_table = structures.new_table;
   status = csv_clone_copy_data(source, &structures, &header_map);
+  if (status == GTEXT_CSV_OK) {
+    status = csv_table_reserve_rows(new_table, source->row_count);
+  }
   if (status != GTEXT_CSV_OK) {
     // Cleanup: free table and context
-    free(structures.new_table);
+    free(structures.new_rows);
+    csv_table_free_rows(new_table);
+    free(new_table->header_map);
+    free(new_table);
     csv_context_free(new_ctx);
     return NULL;
   }
+  csv_table_store_rows(new_table, structures.new_rows, source->row_count);
+  free(structures.new_rows);
 
   // Return the cloned table
-  return structures.new_table;
+  return new_table;
+}
+
+// Retire the arena of a row-layout table into a new share together with the
+// row blocks the table owns, so clones can read them
+// A table whose arena is empty and whose row blocks all belong to a share
+// already has nothing to retire and is left unchanged
+static GTEXT_CSV_Status csv_table_share_rows(GTEXT_CSV_Table * table) {
+  size_t owned = 0;
+  for (size_t b = 0; b < table->row_block_count; b++) {
+    if (!csv_table_share_has_block(table->share, table->row_blocks[b])) {
+      owned++;
+    }
+  }
+  if (owned == 0 && !table->ctx->arena->first && !table->compaction) {
+    return GTEXT_CSV_OK;
+  }
+
+  // Rows past a compaction cursor still point into its from-space
+  csv_table_compaction_abandon(table);
+
+  csv_table_share * share = (csv_table_share *)calloc(1, sizeof(*share));
+  csv_arena * arena = csv_arena_new(0);
+  csv_table_row ** blocks =
+      (csv_table_row **)malloc(sizeof(csv_table_row *) * (owned + 1));
+  if (!share || !arena || !blocks ||
+      csv_arena_sorted_blocks(table->ctx->arena, &share->arena_blocks,
+          &share->arena_block_count) != GTEXT_CSV_OK) {
+    free(share);
+    csv_arena_free(arena);
+    free(blocks);
+    return GTEXT_CSV_E_OOM;
+  }
+
+  size_t count = 0;
+  for (size_t b = 0; b < table->row_block_count; b++) {
+    if (!csv_table_share_has_block(table->share, table->row_blocks[b])) {
+      blocks[count++] = table->row_blocks[b];
+    }
+  }
+  qsort(blocks, count, sizeof(csv_table_row *), csv_pointer_cmp);
+
+  // The table's reference to its old share passes to the new one
+  atomic_init(&share->refs, 1);
+  share->arena = table->ctx->arena;
+  share->row_blocks = blocks;
+  share->row_block_count = count;
+  share->parent = table->share;
+  table->ctx->arena = arena;
+  table->share = share;
+  return GTEXT_CSV_OK;
+}
+
+GTEXT_API GTEXT_CSV_Table * gtext_csv_clone_cow(GTEXT_CSV_Table * source) {
+  // Validate inputs
+  if (!source) {
+    return NULL;
+  }
+
+  if (source->columns) {
+    return csv_table_clone_columns(source);
+  }
+
+  if (csv_table_share_rows(source) != GTEXT_CSV_OK) {
+    return NULL;
+  }
+
+  GTEXT_CSV_Table * table = csv_create_empty_table(NULL);
+  if (!table) {
+    return NULL;
+  }
+  if (source->share) {
+    atomic_fetch_add(&source->share->refs, 1);
+    table->share = source->share;
+  }
+
+  // The clone gets its own directory over the same row blocks
+  size_t block_count = source->row_block_count;
+  table->row_blocks =
+      (csv_table_row **)malloc(sizeof(csv_table_row *) * (block_count + 1));
+  if (!table->row_blocks) {
+    gtext_csv_free_table(table);
+    return NULL;
+  }
+  memcpy(table->row_blocks, source->row_blocks,
+      sizeof(csv_table_row *) * block_count);
+  table->row_block_count = block_count;
+  table->row_block_capacity = block_count;
+  if (source->row_block_tree) {
+    table->row_block_counts =
+        (size_t *)malloc(sizeof(size_t) * (block_count + 1));
+    table->row_block_tree =
+        (size_t *)malloc(sizeof(size_t) * (block_count + 1));
+    if (!table->row_block_counts || !table->row_block_tree) {
+      gtext_csv_free_table(table);
+      return NULL;
+    }
+    memcpy(table->row_block_counts, source->row_block_counts,
+        sizeof(size_t) * block_count);
+    memcpy(table->row_block_tree, source->row_block_tree,
+        sizeof(size_t) * (block_count + 1));
+  }
+  table->row_count = source->row_count;
+  table->row_capacity = source->row_capacity;
+  table->column_count = source->column_count;
+  table->has_header = source->has_header;
+  table->require_unique_headers = source->require_unique_headers;
+  table->allow_irregular_rows = source->allow_irregular_rows;
+
+  // In-situ fields keep pointing into the caller's buffer
+  table->ctx->input_buffer = source->ctx->input_buffer;
+  table->ctx->input_buffer_len = source->ctx->input_buffer_len;
+
+  if (source->header_map) {
+    table->header_map_size = source->header_map_size;
+    if (csv_columns_copy_header_map(source, table->ctx, &table->header_map) !=
+            GTEXT_CSV_OK ||
+        csv_rebuild_index_to_entry(table) != GTEXT_CSV_OK) {
+      gtext_csv_free_table(table);
+      return NULL;
+    }
+  }
+
+  return table;
 }
 
 static void csv_header_map_reindex_increment(
@@ -3298,7 +5891,7 @@ static GTEXT_CSV_Status csv_column_operation_internal(GTEXT_CSV_Table * table,
   // Pre-allocate field arrays for data rows
   size_t array_idx = 0;
   for (size_t row_idx = start_row_idx; row_idx < table->row_count; row_idx++) {
-    csv_table_row * row = &table->rows[row_idx];
+    csv_table_row * row = csv_table_row_at(table, row_idx);
     size_t old_field_count = row->field_count;
 
     // Calculate new field count: if inserting beyond row length, need col_idx +
@@ -3367,7 +5960,7 @@ static GTEXT_CSV_Status csv_column_operation_internal(GTEXT_CSV_Table * table,
     // When allow_irregular_rows is true, allow insertion beyond header row
     // length (padding will happen in Task 2.2)
     if (!is_append) {
-      csv_table_row * header_row = &table->rows[0];
+      csv_table_row * header_row = csv_table_row_at(table, 0);
       if (col_idx > header_row->field_count) {
         if (!table->allow_irregular_rows) {
           // Strict mode: require header row to be long enough
@@ -3427,7 +6020,7 @@ static GTEXT_CSV_Status csv_column_operation_internal(GTEXT_CSV_Table * table,
   // Copy data rows
   array_idx = 0;
   for (size_t row_idx = start_row_idx; row_idx < table->row_count; row_idx++) {
-    csv_table_row * row = &table->rows[row_idx];
+    csv_table_row * row = csv_table_row_at(table, row_idx);
     size_t old_field_count = old_field_counts[array_idx];
     csv_table_field * new_fields = new_field_arrays[array_idx];
 
@@ -3527,7 +6120,7 @@ static GTEXT_CSV_Status csv_column_operation_internal(GTEXT_CSV_Table * table,
   csv_table_field * new_header_fields = NULL;
   size_t old_header_field_count = 0;
   if (table->has_header && table->header_map && table->row_count > 0) {
-    csv_table_row * header_row = &table->rows[0];
+    csv_table_row * header_row = csv_table_row_at(table, 0);
     old_header_field_count = header_row->field_count;
 
     // Calculate new header field count: if inserting beyond header row length,
@@ -3650,6 +6243,18 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_append(
     return GTEXT_CSV_E_INVALID;
   }
 
+  GTEXT_CSV_Status layout_status;
+  if (csv_columns_dispatch_insert(table, table->column_count, header_name,
+          header_name_len, NULL, NULL, &layout_status)) {
+    return layout_status;
+  }
+
+  // Shared rows are copied before they are rewritten
+  GTEXT_CSV_Status share_status = csv_table_unshare(table);
+  if (share_status != GTEXT_CSV_OK) {
+    return share_status;
+  }
+
   // Use helper function for common column operation logic (SIZE_MAX = append)
   csv_table_field ** new_field_arrays = NULL;
   size_t * old_field_counts = NULL;
@@ -3692,7 +6297,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_append(
   size_t start_row_idx = csv_get_start_row_idx(table);
   size_t array_idx = 0;
   for (size_t row_idx = start_row_idx; row_idx < table->row_count; row_idx++) {
-    csv_table_row * row = &table->rows[row_idx];
+    csv_table_row * row = csv_table_row_at(table, row_idx);
     size_t old_field_count = old_field_counts[array_idx];
     csv_table_field * new_fields = new_field_arrays[array_idx];
 
@@ -3704,7 +6309,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_append(
 
   // 3. Update header row structure (if present)
   if (table->has_header && table->header_map && table->row_count > 0) {
-    csv_table_row * header_row = &table->rows[0];
+    csv_table_row * header_row = csv_table_row_at(table, 0);
     header_row->fields = new_header_fields;
     header_row->field_count = old_header_field_count + 1;
 
@@ -3723,6 +6328,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_append(
   csv_column_op_cleanup_individual(
       new_field_arrays, old_field_counts, field_data_array, field_data_lengths);
 
+  csv_table_indexes_column_inserted(table, table->column_count - 1);
   return GTEXT_CSV_OK;
 }
 
@@ -3739,6 +6345,18 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_append_with_values(
     return GTEXT_CSV_E_INVALID;
   }
 
+  GTEXT_CSV_Status layout_status;
+  if (csv_columns_dispatch_insert(table, table->column_count, header_name,
+          header_name_len, values, value_lengths, &layout_status)) {
+    return layout_status;
+  }
+
+  // Shared rows are copied before they are rewritten
+  GTEXT_CSV_Status share_status = csv_table_unshare(table);
+  if (share_status != GTEXT_CSV_OK) {
+    return share_status;
+  }
+
   // Use helper function for common column operation logic (SIZE_MAX = append)
   csv_table_field ** new_field_arrays = NULL;
   size_t * old_field_counts = NULL;
@@ -3781,7 +6399,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_append_with_values(
   size_t start_row_idx = csv_get_start_row_idx(table);
   size_t array_idx = 0;
   for (size_t row_idx = start_row_idx; row_idx < table->row_count; row_idx++) {
-    csv_table_row * row = &table->rows[row_idx];
+    csv_table_row * row = csv_table_row_at(table, row_idx);
     size_t old_field_count = old_field_counts[array_idx];
     csv_table_field * new_fields = new_field_arrays[array_idx];
 
@@ -3793,7 +6411,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_append_with_values(
 
   // 3. Update header row structure (if present)
   if (table->has_header && table->header_map && table->row_count > 0) {
-    csv_table_row * header_row = &table->rows[0];
+    csv_table_row * header_row = csv_table_row_at(table, 0);
     header_row->fields = new_header_fields;
     header_row->field_count = old_header_field_count + 1;
 
@@ -3812,6 +6430,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_append_with_values(
   csv_column_op_cleanup_individual(
       new_field_arrays, old_field_counts, field_data_array, field_data_lengths);
 
+  csv_table_indexes_column_inserted(table, table->column_count - 1);
   return GTEXT_CSV_OK;
 }
 
@@ -3824,6 +6443,20 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert_with_values(
     return GTEXT_CSV_E_INVALID;
   }
 
+  // Empty tables are rejected below, in either layout
+  GTEXT_CSV_Status layout_status;
+  if (table->row_count > 0 &&
+      csv_columns_dispatch_insert(table, col_idx, header_name, header_name_len,
+          values, value_lengths, &layout_status)) {
+    return layout_status;
+  }
+
+  // Shared rows are copied before they are rewritten
+  GTEXT_CSV_Status share_status = csv_table_unshare(table);
+  if (share_status != GTEXT_CSV_OK) {
+    return share_status;
+  }
+
   // Validate col_idx (must be <= column count, unless irregular rows allowed)
   if (col_idx > table->column_count) {
     if (!table->allow_irregular_rows) {
@@ -3842,7 +6475,8 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert_with_values(
       size_t start_row_idx = csv_get_start_row_idx(table);
       for (size_t row_idx = start_row_idx; row_idx < table->row_count;
            row_idx++) {
-        if (table->rows[row_idx].field_count < table->column_count) {
+        if (csv_table_row_at(table, row_idx)->field_count <
+            table->column_count) {
           all_rows_at_column_count = false;
           break;
         }
@@ -3923,7 +6557,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert_with_values(
   size_t start_row_idx = csv_get_start_row_idx(table);
   size_t array_idx = 0;
   for (size_t row_idx = start_row_idx; row_idx < table->row_count; row_idx++) {
-    csv_table_row * row = &table->rows[row_idx];
+    csv_table_row * row = csv_table_row_at(table, row_idx);
     size_t old_field_count = old_field_counts[array_idx];
     csv_table_field * new_fields = new_field_arrays[array_idx];
 
@@ -3942,7 +6576,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert_with_values(
 
   // 3. Update header row structure (if present)
   if (table->has_header && table->header_map && table->row_count > 0) {
-    csv_table_row * header_row = &table->rows[0];
+    csv_table_row * header_row = csv_table_row_at(table, 0);
     header_row->fields = new_header_fields;
     // When padding occurred (col_idx > old_header_field_count), new field_count
     // is col_idx + 1 Otherwise, it's old_header_field_count + 1
@@ -3968,6 +6602,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert_with_values(
   csv_column_op_cleanup_individual(
       new_field_arrays, old_field_counts, field_data_array, field_data_lengths);
 
+  csv_table_indexes_column_inserted(table, col_idx);
   return GTEXT_CSV_OK;
 }
 
@@ -3978,6 +6613,18 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert(GTEXT_CSV_Table * table,
     return GTEXT_CSV_E_INVALID;
   }
 
+  GTEXT_CSV_Status layout_status;
+  if (csv_columns_dispatch_insert(table, col_idx, header_name, header_name_len,
+          NULL, NULL, &layout_status)) {
+    return layout_status;
+  }
+
+  // Shared rows are copied before they are rewritten
+  GTEXT_CSV_Status share_status = csv_table_unshare(table);
+  if (share_status != GTEXT_CSV_OK) {
+    return share_status;
+  }
+
   // Validate col_idx (must be <= column count, unless irregular rows allowed)
   if (col_idx > table->column_count) {
     if (!table->allow_irregular_rows) {
@@ -3997,7 +6644,8 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert(GTEXT_CSV_Table * table,
       size_t start_row_idx = csv_get_start_row_idx(table);
       for (size_t row_idx = start_row_idx; row_idx < table->row_count;
            row_idx++) {
-        if (table->rows[row_idx].field_count < table->column_count) {
+        if (csv_table_row_at(table, row_idx)->field_count <
+            table->column_count) {
           all_rows_at_column_count = false;
           break;
         }
@@ -4072,7 +6720,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert(GTEXT_CSV_Table * table,
   size_t start_row_idx = csv_get_start_row_idx(table);
   size_t array_idx = 0;
   for (size_t row_idx = start_row_idx; row_idx < table->row_count; row_idx++) {
-    csv_table_row * row = &table->rows[row_idx];
+    csv_table_row * row = csv_table_row_at(table, row_idx);
     size_t old_field_count = old_field_counts[array_idx];
     csv_table_field * new_fields = new_field_arrays[array_idx];
 
@@ -4091,7 +6739,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert(GTEXT_CSV_Table * table,
 
   // 3. Update header row structure (if present)
   if (table->has_header && table->header_map && table->row_count > 0) {
-    csv_table_row * header_row = &table->rows[0];
+    csv_table_row * header_row = csv_table_row_at(table, 0);
     header_row->fields = new_header_fields;
     // When padding occurred (col_idx > old_header_field_count), new field_count
     // is col_idx + 1 Otherwise, it's old_header_field_count + 1
@@ -4117,6 +6765,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_insert(GTEXT_CSV_Table * table,
   csv_column_op_cleanup_individual(
       new_field_arrays, old_field_counts, field_data_array, field_data_lengths);
 
+  csv_table_indexes_column_inserted(table, col_idx);
   return GTEXT_CSV_OK;
 }
 
@@ -4137,6 +6786,15 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_remove(
     return GTEXT_CSV_E_INVALID;
   }
 
+  // Shared rows are copied before they are rewritten
+  GTEXT_CSV_Status share_status = csv_table_unshare(table);
+  if (share_status != GTEXT_CSV_OK) {
+    return share_status;
+  }
+
+  // Nothing below can fail, so indexes are renumbered up front
+  csv_table_indexes_column_removed(table, col_idx);
+
   // Determine start row index (skip header row if present)
   size_t start_row_idx = csv_get_start_row_idx(table);
 
@@ -4160,11 +6818,18 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_remove(
     csv_header_map_reindex_decrement(table, col_idx);
   }
 
+  // Column layout: drop the column's storage (header row included)
+  if (table->columns) {
+    csv_columns_remove_column(table, col_idx);
+    table->column_count--;
+    return GTEXT_CSV_OK;
+  }
+
   // Phase 3: Shift Fields in All Rows
   // For each row, shift fields from col_idx+1 to field_count-1 left by one
   // position
   for (size_t row_idx = start_row_idx; row_idx < table->row_count; row_idx++) {
-    csv_table_row * row = &table->rows[row_idx];
+    csv_table_row * row = csv_table_row_at(table, row_idx);
 
     // Validate col_idx is within bounds for this row
     if (col_idx >= row->field_count) {
@@ -4184,7 +6849,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_remove(
 
   // Phase 4: Shift Header Row Fields (if present)
   if (table->has_header && table->row_count > 0) {
-    csv_table_row * header_row = &table->rows[0];
+    csv_table_row * header_row = csv_table_row_at(table, 0);
 
     // Validate col_idx is within bounds for header row
     if (col_idx < header_row->field_count) {
@@ -4232,6 +6897,12 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_rename(GTEXT_CSV_Table * table,
     return GTEXT_CSV_E_INVALID;
   }
 
+  // The header row is rewritten, so it is copied if shared with a clone
+  GTEXT_CSV_Status own_status = csv_table_own_row(table, 0);
+  if (own_status != GTEXT_CSV_OK) {
+    return own_status;
+  }
+
   // Calculate new_name length if not provided
   size_t name_len = new_name_length;
   if (name_len == 0) {
@@ -4300,17 +6971,25 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_column_rename(GTEXT_CSV_Table * table,
 
   // Phase 5: Update Header Field in Header Row
   // Update the header field at col_idx in the header row
-  csv_table_row * header_row = &table->rows[0];
-  if (col_idx >= header_row->field_count) {
+  if (col_idx >= csv_table_row_width(table, 0)) {
     // This should not happen if table is consistent, but check anyway
     return GTEXT_CSV_E_INVALID;
   }
 
-  csv_table_field * header_field = &header_row->fields[col_idx];
-  if (name_len == 0) {
-    csv_setup_empty_field(header_field);
+  if (table->columns) {
+    GTEXT_CSV_Status status =
+        csv_columns_set_cell(
+            table->ctx, table->columns, 0, col_idx, new_name, name_len);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+  }
+  else if (name_len == 0) {
+    csv_setup_empty_field(&csv_table_row_at(table, 0)->fields[col_idx]);
   }
   else {
+    csv_table_field * header_field =
+        &csv_table_row_at(table, 0)->fields[col_idx];
     header_field->data = new_name_data;
     header_field->length = name_len;
     header_field->is_in_situ = false; // Always in arena after rename
@@ -4445,24 +7124,23 @@ GTEXT_API bool gtext_csv_can_have_unique_headers(
   }
 
   // Get the header row (first row when has_header is true)
-  csv_table_row * header_row = &table->rows[0];
-  if (!header_row || header_row->field_count == 0) {
+  size_t header_width = csv_table_row_width(table, 0);
+  if (header_width == 0) {
     return false;
   }
 
   // Check for duplicate header names by comparing all fields in the header row
   // For each field, check if there's another field with the same name
-  for (size_t i = 0; i < header_row->field_count; i++) {
-    csv_table_field * field = &header_row->fields[i];
-    const char * name = field->data;
-    size_t name_len = field->length;
+  for (size_t i = 0; i < header_width; i++) {
+    size_t name_len;
+    const char * name = csv_table_cell(table, 0, i, &name_len);
 
     // Count occurrences of this name in the header row
     size_t count = 0;
-    for (size_t j = 0; j < header_row->field_count; j++) {
-      csv_table_field * check_field = &header_row->fields[j];
-      if (check_field->length == name_len &&
-          memcmp(check_field->data, name, name_len) == 0) {
+    for (size_t j = 0; j < header_width; j++) {
+      size_t check_len;
+      const char * check_name = csv_table_cell(table, 0, j, &check_len);
+      if (check_len == name_len && memcmp(check_name, name, name_len) == 0) {
         count++;
       }
     }
@@ -4504,6 +7182,21 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_normalize_rows(GTEXT_CSV_Table * table,
     return GTEXT_CSV_E_INVALID;
   }
 
+  // Row operations work on the row layout
+  GTEXT_CSV_Status layout_status = csv_table_require_rows(table);
+  if (layout_status != GTEXT_CSV_OK) {
+    return layout_status;
+  }
+
+  // Shared rows are copied before they are rewritten
+  GTEXT_CSV_Status share_status = csv_table_unshare(table);
+  if (share_status != GTEXT_CSV_OK) {
+    return share_status;
+  }
+
+  // Padding and truncation change which rows have indexed values
+  csv_table_indexes_invalidate(table, SIZE_MAX);
+
   // Handle empty table
   if (table->row_count == 0) {
     // Empty table: set column_count to target if specified, otherwise no-op
@@ -4523,8 +7216,8 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_normalize_rows(GTEXT_CSV_Table * table,
     // Find minimum column count across all rows
     size_t min_count = SIZE_MAX;
     for (size_t i = 0; i < table->row_count; i++) {
-      if (table->rows[i].field_count < min_count) {
-        min_count = table->rows[i].field_count;
+      if (csv_table_row_at(table, i)->field_count < min_count) {
+        min_count = csv_table_row_at(table, i)->field_count;
       }
     }
     if (min_count == SIZE_MAX) {
@@ -4537,7 +7230,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_normalize_rows(GTEXT_CSV_Table * table,
   // Optimization: Check if already normalized (no-op)
   bool already_normalized = true;
   for (size_t i = 0; i < table->row_count; i++) {
-    if (table->rows[i].field_count != actual_target) {
+    if (csv_table_row_at(table, i)->field_count != actual_target) {
       already_normalized = false;
       break;
     }
@@ -4550,7 +7243,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_normalize_rows(GTEXT_CSV_Table * table,
   // Phase 3: Validate all rows (if truncate_long_rows is false)
   if (!truncate_long_rows) {
     for (size_t i = 0; i < table->row_count; i++) {
-      if (table->rows[i].field_count > actual_target) {
+      if (csv_table_row_at(table, i)->field_count > actual_target) {
         return GTEXT_CSV_E_INVALID;
       }
     }
@@ -4582,7 +7275,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_normalize_rows(GTEXT_CSV_Table * table,
 
   // Phase 5: Copy/pad/truncate all rows
   for (size_t i = 0; i < table->row_count; i++) {
-    csv_table_row * row = &table->rows[i];
+    csv_table_row * row = csv_table_row_at(table, i);
     size_t old_field_count = row->field_count;
     csv_table_field * new_fields = new_field_arrays[i];
 
@@ -4603,8 +7296,8 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_normalize_rows(GTEXT_CSV_Table * table,
   // Phase 6: Atomic state update
   // Only after all allocations and copies succeed:
   for (size_t i = 0; i < table->row_count; i++) {
-    table->rows[i].fields = new_field_arrays[i];
-    table->rows[i].field_count = actual_target;
+    csv_table_row_at(table, i)->fields = new_field_arrays[i];
+    csv_table_row_at(table, i)->field_count = actual_target;
   }
   table->column_count = actual_target;
 
@@ -4630,7 +7323,7 @@ GTEXT_API bool gtext_csv_has_irregular_rows(const GTEXT_CSV_Table * table) {
 
   // Check all rows (including header row if present)
   for (size_t i = 0; i < table->row_count; i++) {
-    if (table->rows[i].field_count != table->column_count) {
+    if (csv_table_row_width(table, i) != table->column_count) {
       return true;
     }
   }
@@ -4645,8 +7338,9 @@ GTEXT_API size_t gtext_csv_max_col_count(const GTEXT_CSV_Table * table) {
 
   size_t max_count = 0;
   for (size_t i = 0; i < table->row_count; i++) {
-    if (table->rows[i].field_count > max_count) {
-      max_count = table->rows[i].field_count;
+    size_t width = csv_table_row_width(table, i);
+    if (width > max_count) {
+      max_count = width;
     }
   }
 
@@ -4660,8 +7354,9 @@ GTEXT_API size_t gtext_csv_min_col_count(const GTEXT_CSV_Table * table) {
 
   size_t min_count = SIZE_MAX;
   for (size_t i = 0; i < table->row_count; i++) {
-    if (table->rows[i].field_count < min_count) {
-      min_count = table->rows[i].field_count;
+    size_t width = csv_table_row_width(table, i);
+    if (width < min_count) {
+      min_count = width;
     }
   }
 
@@ -4680,6 +7375,31 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_validate_table(
     return GTEXT_CSV_E_INVALID;
   }
 
+  // Column layout: every stored cell must lie inside the heap
+  if (table->columns) {
+    const csv_table_columns * cols = table->columns;
+    if (table->row_count > cols->row_capacity) {
+      return GTEXT_CSV_E_INVALID;
+    }
+    for (size_t i = 0; i < table->row_count; i++) {
+      if (cols->widths[i] > cols->column_count) {
+        return GTEXT_CSV_E_INVALID;
+      }
+      for (size_t col = 0; col < cols->widths[i]; col++) {
+        const csv_table_column * column = &cols->columns[col];
+        if (column->offsets[i] >= cols->heap_len ||
+            column->lengths[i] > cols->heap_len - column->offsets[i] - 1) {
+          return GTEXT_CSV_E_INVALID;
+        }
+      }
+    }
+    if (table->has_header && table->header_map && table->row_count == 0) {
+      // Headers but no rows is invalid
+      return GTEXT_CSV_E_INVALID;
+    }
+    return GTEXT_CSV_OK;
+  }
+
   // Check row_count <= row_capacity
   if (table->row_count > table->row_capacity) {
     return GTEXT_CSV_E_INVALID;
@@ -4687,7 +7407,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_validate_table(
 
   // Check each row
   for (size_t i = 0; i < table->row_count; i++) {
-    csv_table_row * row = &table->rows[i];
+    csv_table_row * row = csv_table_row_at(table, i);
 
     // Check field_count > 0 implies fields != NULL
     if (row->field_count > 0 && row->fields == NULL) {
@@ -4710,7 +7430,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_validate_table(
       return GTEXT_CSV_E_INVALID;
     }
 
-    csv_table_row * header_row = &table->rows[0];
+    csv_table_row * header_row = csv_table_row_at(table, 0);
     // Header row should have fields if field_count > 0
     if (header_row->field_count > 0 && header_row->fields == NULL) {
       return GTEXT_CSV_E_INVALID;
@@ -4726,6 +7446,21 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_set_header_row(
     return GTEXT_CSV_E_INVALID;
   }
 
+  // Row operations work on the row layout
+  GTEXT_CSV_Status layout_status = csv_table_require_rows(table);
+  if (layout_status != GTEXT_CSV_OK) {
+    return layout_status;
+  }
+
+  // Shared rows are copied before they are rewritten
+  GTEXT_CSV_Status share_status = csv_table_unshare(table);
+  if (share_status != GTEXT_CSV_OK) {
+    return share_status;
+  }
+
+  // Data row numbers shift by one either way
+  csv_table_indexes_invalidate(table, SIZE_MAX);
+
   if (enable) {
     // Enable headers: first row becomes header row
     // Validate: table must not be empty
@@ -4739,7 +7474,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_set_header_row(
     }
 
     // Get first row (will become header row)
-    csv_table_row * first_row = &table->rows[0];
+    csv_table_row * first_row = csv_table_row_at(table, 0);
     size_t first_row_cols = first_row->field_count;
 
     // Handle column count:
@@ -4778,7 +7513,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_set_header_row(
 
     // If require_unique_headers is true, validate uniqueness
     if (table->require_unique_headers) {
-      csv_table_row * header_row = &table->rows[0];
+      csv_table_row * header_row = csv_table_row_at(table, 0);
       for (size_t i = 0; i < header_row->field_count; i++) {
         csv_table_field * field = &header_row->fields[i];
         const char * name = field->data;
@@ -4812,7 +7547,7 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_set_header_row(
       return GTEXT_CSV_E_OOM;
     }
 
-    csv_table_row * header_row = &table->rows[0];
+    csv_table_row * header_row = csv_table_row_at(table, 0);
     for (size_t i = 0; i < header_row->field_count; i++) {
       csv_table_field * field = &header_row->fields[i];
       size_t hash =
@@ -4896,23 +7631,14 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_new_table(void) {
 
   // Initialize table structure
   memset(table, 0, sizeof(GTEXT_CSV_Table));
+  // Row blocks are added by the first row operation
   table->ctx = ctx;
-  table->row_capacity = 16;
   table->row_count = 0;
   table->column_count = 0; // No columns defined until first row
   table->has_header = false;
   table->header_map = NULL;
   table->header_map_size = 0;
 
-  // Allocate initial rows array
-  table->rows = (csv_table_row *)csv_arena_alloc_for_context(
-      ctx, sizeof(csv_table_row) * table->row_capacity, 8);
-  if (!table->rows) {
-    free(table);
-    csv_context_free(ctx);
-    return NULL;
-  }
-
   return table;
 }
 
@@ -4940,32 +7666,27 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_new_table_with_headers(
   // Initialize table structure
   memset(table, 0, sizeof(GTEXT_CSV_Table));
   table->ctx = ctx;
-  table->row_capacity = 16;
   table->row_count = 0;
   table->column_count = header_count;
   table->has_header = false; // Will be set to true after header row is created
   table->header_map = NULL;
   table->header_map_size = 0;
 
-  // Allocate initial rows array
-  table->rows = (csv_table_row *)csv_arena_alloc_for_context(
-      ctx, sizeof(csv_table_row) * table->row_capacity, 8);
-  if (!table->rows) {
-    free(table);
-    csv_context_free(ctx);
+  // Allocate the first row block
+  if (csv_table_reserve_rows(table, 1) != GTEXT_CSV_OK) {
+    gtext_csv_free_table(table);
     return NULL;
   }
 
   // Allocate header row structure
-  csv_table_row * header_row = &table->rows[0];
+  csv_table_row * header_row = csv_table_row_at(table, 0);
 
   // Allocate field array for header row
   csv_table_field * header_fields =
       (csv_table_field *)csv_arena_alloc_for_context(
           ctx, sizeof(csv_table_field) * header_count, 8);
   if (!header_fields) {
-    free(table);
-    csv_context_free(ctx);
+    gtext_csv_free_table(table);
     return NULL;
   }
 
@@ -4988,8 +7709,7 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_new_table_with_headers(
     GTEXT_CSV_Status status =
         csv_allocate_and_copy_field(ctx, header_data, header_len, field);
     if (status != GTEXT_CSV_OK) {
-      free(table);
-      csv_context_free(ctx);
+      gtext_csv_free_table(table);
       return NULL;
     }
   }
@@ -5004,8 +7724,7 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_new_table_with_headers(
   table->header_map = (csv_header_entry **)calloc(
       table->header_map_size, sizeof(csv_header_entry *));
   if (!table->header_map) {
-    free(table);
-    csv_context_free(ctx);
+    gtext_csv_free_table(table);
     return NULL;
   }
 
@@ -5031,8 +7750,7 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_new_table_with_headers(
       // Duplicate header name - free resources and return NULL
       free(table->header_map);
       table->header_map = NULL;
-      free(table);
-      csv_context_free(ctx);
+      gtext_csv_free_table(table);
       return NULL;
     }
 
@@ -5043,8 +7761,7 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_new_table_with_headers(
     if (!new_entry) {
       free(table->header_map);
       table->header_map = NULL;
-      free(table);
-      csv_context_free(ctx);
+      gtext_csv_free_table(table);
       return NULL;
     }
 
@@ -5058,3 +7775,57 @@ GTEXT_API GTEXT_CSV_Table * gtext_csv_new_table_with_headers(
   table->has_header = true;
   return table;
 }
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_table_set_layout(
+    GTEXT_CSV_Table * table, GTEXT_CSV_Layout layout) {
+  if (!table) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  switch (layout) {
+  case GTEXT_CSV_LAYOUT_ROWS:
+    return csv_table_require_rows(table);
+  case GTEXT_CSV_LAYOUT_COLUMNS:
+    if (table->columns) {
+      return GTEXT_CSV_OK;
+    }
+    return csv_table_rows_to_columns(table);
+  }
+
+  return GTEXT_CSV_E_INVALID;
+}
+
+GTEXT_API GTEXT_CSV_Layout gtext_csv_table_layout(
+    const GTEXT_CSV_Table * table) {
+  if (table && table->columns) {
+    return GTEXT_CSV_LAYOUT_COLUMNS;
+  }
+  return GTEXT_CSV_LAYOUT_ROWS;
+}
+
+GTEXT_API GTEXT_CSV_Status gtext_csv_column_view(const GTEXT_CSV_Table * table,
+    size_t col, GTEXT_CSV_Column_View * view) {
+  if (!table || !view || !table->columns) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  if (col >= table->column_count) {
+    return GTEXT_CSV_E_INVALID;
+  }
+
+  const csv_table_columns * cols = table->columns;
+  size_t start_row_idx = csv_get_start_row_idx(table);
+  view->heap = cols->heap;
+  view->count = csv_get_data_row_count(table);
+
+  // Columns added to a table without rows have no storage yet
+  if (col >= cols->column_count || view->count == 0) {
+    view->offsets = NULL;
+    view->lengths = NULL;
+    view->count = 0;
+    return GTEXT_CSV_OK;
+  }
+
+  view->offsets = cols->columns[col].offsets + start_row_idx;
+  view->lengths = cols->columns[col].lengths + start_row_idx;
+  return GTEXT_CSV_OK;
+}
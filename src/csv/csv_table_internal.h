@@ -251,21 +251,19 @@ extern "C" {
 /**
  * @brief Allocate structures for row operations
  *
- * Allocates field array and handles row capacity growth if needed.
+ * Allocates field array and everything inserting a row slot at row_idx
+ * needs (a row block, the block index), so the insert itself cannot fail.
  * This is the common logic shared by gtext_csv_row_append and
  * gtext_csv_row_insert.
  *
  * @fn static GTEXT_CSV_Status csv_row_allocate_structures(GTEXT_CSV_Table *
- * table, size_t field_count, csv_table_field ** new_fields_out, csv_table_row
- * ** new_rows_out, size_t * new_capacity_out)
+ * table, size_t row_idx, size_t field_count, csv_table_field **
+ * new_fields_out)
  *
  * @param table Table (must not be NULL)
+ * @param row_idx Row index the new row will take (header row included)
  * @param field_count Number of fields (must be > 0)
  * @param new_fields_out Output parameter for allocated field array
- * @param new_rows_out Output parameter for row array (may be same as
- * table->rows if no growth)
- * @param new_capacity_out Output parameter for new row capacity (may be same as
- * table->row_capacity)
  * @return GTEXT_CSV_OK on success, error code on failure
  *
  * @note This is a static function defined in csv_table.c
@@ -655,6 +653,83 @@ extern "C" {
  * @note This is a static function defined in csv_table.c
  */
 
+// ============================================================================
+// Column-Major Storage
+// ============================================================================
+
+/**
+ * @brief Switch a column-major table to the row layout
+ *
+ * Copies the column heap into the arena as a single block and builds
+ * exact-size field arrays that point into it. The column storage is freed.
+ *
+ * @fn static GTEXT_CSV_Status csv_table_columns_to_rows(GTEXT_CSV_Table *
+ * table)
+ *
+ * @param table Column-major table (must not be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_OOM on allocation failure
+ * (the table is unchanged)
+ *
+ * @note This is a static function defined in csv_table.c
+ */
+
+/**
+ * @brief Switch a row-major table to the column layout
+ *
+ * Sizes the heap and the per-column offset/length arrays in one pass, then
+ * fills them one column at a time. The old row storage stays in the arena
+ * until the next compaction.
+ *
+ * @fn static GTEXT_CSV_Status csv_table_rows_to_columns(GTEXT_CSV_Table *
+ * table)
+ *
+ * @param table Row-major table (must not be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_OOM on allocation failure
+ * (the table is unchanged)
+ *
+ * @note This is a static function defined in csv_table.c
+ */
+
+/**
+ * @brief Insert a column into a rectangular column-major table
+ *
+ * Same contract as csv_column_operation_internal(): @p values (if not NULL)
+ * holds one value per row including the header, otherwise the new column is
+ * empty and @p header_name names it. All allocations happen before the
+ * column array, row widths, and header map are updated.
+ *
+ * @fn static GTEXT_CSV_Status csv_columns_insert_column(GTEXT_CSV_Table *
+ * table, size_t col_idx, const char * header_name, size_t header_name_len,
+ * const char * const * values, const size_t * value_lengths)
+ *
+ * @param table Column-major table whose rows all have column_count fields
+ * @param col_idx Insertion index (must be <= column_count)
+ * @param header_name Header name for an empty column
+ * @param header_name_len Length of header_name (0 = use strlen)
+ * @param values Column values, or NULL for an empty column
+ * @param value_lengths Value lengths (NULL = use strlen)
+ * @return GTEXT_CSV_OK on success, error code on failure (the table is
+ * unchanged)
+ *
+ * @note This is a static function defined in csv_table.c
+ */
+
+/**
+ * @brief Compact a column-major table
+ *
+ * Rebuilds the heap with only the live cells and replaces the arena with one
+ * that holds just the header map.
+ *
+ * @fn static GTEXT_CSV_Status csv_columns_compact_table(GTEXT_CSV_Table *
+ * table)
+ *
+ * @param table Column-major table (must not be NULL)
+ * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_OOM on allocation failure
+ * (the table is unchanged)
+ *
+ * @note This is a static function defined in csv_table.c
+ */
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "../text_utf8.h"
 #include "csv_internal.h"
 
 #include <ghoti.io/text/csv/csv_core.h>
@@ -148,119 +149,33 @@ csv_utf8_result csv_validate_utf8(const char * input, size_t input_len,
   if (offset > input_len) {
     return CSV_UTF8_INVALID; // Invalid offset
   }
-  // Calculate remaining bytes to process (from offset to end)
-  size_t remaining = input_len - offset;
 
-  while (remaining > 0) {
-    // Bounds check: ensure offset is valid before accessing input
-    if (offset >= input_len) {
-      return CSV_UTF8_INVALID; // Invalid offset
-    }
-
-    unsigned char byte = (unsigned char)input[offset];
-    size_t seq_len = 0;
+  // Validate from offset to end; stop is the length of the valid prefix
+  size_t stop = 0;
+  text_utf8_result result =
+      text_utf8_validate(input + offset, input_len - offset, &stop);
 
-    // Determine sequence length from first byte
-    if ((byte & 0x80) == 0) {
-      // ASCII (0xxxxxxx)
-      seq_len = 1;
-    }
-    else if ((byte & 0xE0) == 0xC0) {
-      // 2-byte sequence (110xxxxx)
-      seq_len = 2;
-    }
-    else if ((byte & 0xF0) == 0xE0) {
-      // 3-byte sequence (1110xxxx)
-      seq_len = 3;
-    }
-    else if ((byte & 0xF8) == 0xF0) {
-      // 4-byte sequence (11110xxx)
-      seq_len = 4;
-    }
-    else {
-      // Invalid first byte
-      return CSV_UTF8_INVALID;
-    }
-
-    // Check if we have enough bytes for the sequence
-    // Check for overflow in offset + seq_len
-    if (offset > SIZE_MAX - seq_len || offset + seq_len > input_len) {
-      return CSV_UTF8_INCOMPLETE;
-    }
-
-    // Validate continuation bytes (must be 10xxxxxx)
-    for (size_t i = 1; i < seq_len; i++) {
-      // Bounds check: ensure offset + i is valid
-      if (offset + i >= input_len) {
-        return CSV_UTF8_INCOMPLETE;
-      }
-      unsigned char cont_byte = (unsigned char)input[offset + i];
-      if ((cont_byte & 0xC0) != 0x80) {
-        return CSV_UTF8_INVALID;
-      }
-    }
-
-    // Check for overlong encodings and invalid code points
-    if (seq_len == 2) {
-      if ((byte & 0x1E) == 0) {
-        return CSV_UTF8_INVALID; // Overlong encoding
-      }
-    }
-    else if (seq_len == 3) {
-      // Bounds check: ensure offset + 1 is valid
-      if (offset + 1 >= input_len) {
-        return CSV_UTF8_INCOMPLETE;
-      }
-      if ((byte & 0x0F) == 0 && (input[offset + 1] & 0x20) == 0) {
-        return CSV_UTF8_INVALID; // Overlong encoding
-      }
-    }
-    else if (seq_len == 4) {
-      // Bounds check: ensure offset + 1 is valid
-      if (offset + 1 >= input_len) {
-        return CSV_UTF8_INCOMPLETE;
-      }
-      if ((byte & 0x07) == 0 && (input[offset + 1] & 0x30) == 0) {
-        return CSV_UTF8_INVALID; // Overlong encoding
-      }
-      // Check for code points > U+10FFFF
-      unsigned char b1 = (unsigned char)input[offset];
-      unsigned char b2 = (unsigned char)input[offset + 1];
-      if (b1 == 0xF4 && (b2 & 0xF0) != 0) {
-        return CSV_UTF8_INVALID; // > U+10FFFF
-      }
-      if (b1 > 0xF4) {
-        return CSV_UTF8_INVALID; // > U+10FFFF
-      }
-    }
-
-    // Check for underflow in remaining (defensive check)
-    if (remaining < seq_len) {
-      return CSV_UTF8_INVALID; // Logic error - remaining < seq_len
-    }
-    // Check all overflow conditions upfront before performing any operations
-    if (offset > SIZE_MAX - seq_len) {
-      return CSV_UTF8_INVALID; // Offset would overflow
-    }
-    if (pos) {
-      if (seq_len > (size_t)INT_MAX || pos->column > INT_MAX - (int)seq_len) {
-        // Column overflow - return error
-        if (error_out) {
-          *error_out = GTEXT_CSV_E_LIMIT;
-        }
-        return CSV_UTF8_INVALID; // Column would overflow
+  // Advance position over the valid prefix
+  if (pos && stop > 0) {
+    if (stop > (size_t)INT_MAX || pos->column > INT_MAX - (int)stop) {
+      // Column overflow - return error
+      if (error_out) {
+        *error_out = GTEXT_CSV_E_LIMIT;
       }
+      return CSV_UTF8_INVALID; // Column would overflow
     }
-    // All checks passed, perform all updates
-    offset += seq_len;
-    remaining -= seq_len;
-    if (pos) {
-      pos->offset = offset;
-      pos->column += (int)seq_len;
-    }
+    pos->offset = offset + stop;
+    pos->column += (int)stop;
   }
 
-  return CSV_UTF8_VALID;
+  switch (result) {
+  case TEXT_UTF8_VALID:
+    return CSV_UTF8_VALID;
+  case TEXT_UTF8_INCOMPLETE:
+    return CSV_UTF8_INCOMPLETE;
+  default:
+    return CSV_UTF8_INVALID;
+  }
 }
 
 // Strip UTF-8 BOM from input (BOM is 0xEF 0xBB 0xBF)
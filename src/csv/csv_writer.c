@@ -10,15 +10,18 @@
  */
 
 #include <limits.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "../text_simd.h"
 #include "csv_internal.h"
 
 #include <ghoti.io/text/csv/csv_core.h>
 #include <ghoti.io/text/csv/csv_writer.h>
+
 // Internal write callback for growable buffer sink
 static GTEXT_CSV_Status buffer_write_fn(
     void * user, const char * bytes, size_t len) {
@@ -257,349 +260,247 @@ GTEXT_API void gtext_csv_sink_fixed_buffer_free(GTEXT_CSV_Sink * sink) {
 // Field Escaping and Quoting Logic
 // ============================================================================
 
-static bool csv_field_needs_quoting(const char * field_data, size_t field_len,
-    const GTEXT_CSV_Write_Options * opts) {
-  if (!opts) {
-    return false;
-  }
+/**
+ * @brief Bytes gathered by gtext_csv_write_table() before each sink call
+ */
+#define CSV_WRITE_BLOCK_SIZE 65536
 
-  // quote_all_fields: always quote
-  if (opts->quote_all_fields) {
-    return true;
-  }
+/**
+ * @brief Bytes gathered by one streaming writer call before the sink sees
+ * them
+ */
+#define CSV_WRITE_SMALL_BLOCK_SIZE 256
 
-  // quote_empty_fields: quote if empty
-  if (opts->quote_empty_fields && field_len == 0) {
-    return true;
+/**
+ * @brief Output gathered into a block and passed to a sink when full
+ *
+ * A block without a sink is a growable buffer: it is enlarged instead of
+ * flushed, and its bytes stay in data until the caller takes them.
+ */
+typedef struct {
+  const GTEXT_CSV_Sink * sink;
+  char * data;
+  size_t size;
+  size_t used;
+} csv_write_buffer;
+
+// Pass the gathered bytes to the sink
+static GTEXT_CSV_Status csv_write_buffer_flush(csv_write_buffer * out) {
+  if (out->used == 0 || !out->sink) {
+    return GTEXT_CSV_OK;
   }
+  size_t used = out->used;
+  out->used = 0;
+  return out->sink->write(out->sink->user, out->data, used);
+}
 
-  // quote_if_needed: check for special characters
-  if (opts->quote_if_needed && field_data && field_len > 0) {
-    const char delimiter = opts->dialect.delimiter;
-    const char quote = opts->dialect.quote;
-
-    for (size_t i = 0; i < field_len; i++) {
-      char c = field_data[i];
-
-      // Check for delimiter
-      if (c == delimiter) {
-        return true;
-      }
-
-      // Check for quote character
-      if (c == quote) {
-        return true;
-      }
-
-      // Check for newline (LF, CR, or CRLF)
-      if (c == '\n' || c == '\r') {
-        return true;
-      }
-
-      // Check for leading/trailing spaces if policy requires
-      // (This is typically handled by the parser, but we check here
-      // for completeness - RFC 4180 says spaces are significant)
+// Enlarge a growable block to hold at least needed bytes
+static GTEXT_CSV_Status csv_write_buffer_grow(
+    csv_write_buffer * out, size_t needed) {
+  size_t size = out->size ? out->size : CSV_WRITE_SMALL_BLOCK_SIZE;
+  while (size < needed) {
+    if (size > SIZE_MAX / 2) {
+      return GTEXT_CSV_E_OOM;
     }
+    size *= 2;
   }
-
-  return false;
-}
-
-static size_t csv_field_escaped_length(const char * field_data,
-    size_t field_len, GTEXT_CSV_Escape_Mode escape_mode, char quote_char) {
-  if (!field_data || field_len == 0) {
-    return field_len;
+  char * grown = (char *)realloc(out->data, size);
+  if (!grown) {
+    return GTEXT_CSV_E_OOM;
   }
+  out->data = grown;
+  out->size = size;
+  return GTEXT_CSV_OK;
+}
 
-  size_t escaped_len = field_len;
-
-  switch (escape_mode) {
-  case GTEXT_CSV_ESCAPE_DOUBLED_QUOTE: {
-    // Each quote character becomes two quotes
-    for (size_t i = 0; i < field_len; i++) {
-      if (field_data[i] == quote_char) {
-        // Check for overflow before incrementing
-        if (escaped_len == SIZE_MAX) {
-          return SIZE_MAX; // Overflow - return max value
-        }
-        escaped_len++; // One extra character per quote
+// Append bytes, flushing when the block fills; a run at least a block long
+// goes to the sink directly
+static GTEXT_CSV_Status csv_write_buffer_put(
+    csv_write_buffer * out, const char * bytes, size_t len) {
+  if (len > out->size - out->used) {
+    if (!out->sink) {
+      if (len > SIZE_MAX - out->used) {
+        return GTEXT_CSV_E_OOM;
+      }
+      GTEXT_CSV_Status status = csv_write_buffer_grow(out, out->used + len);
+      if (status != GTEXT_CSV_OK) {
+        return status;
       }
     }
-    break;
-  }
-
-  case GTEXT_CSV_ESCAPE_BACKSLASH: {
-    // Each quote becomes \" and each backslash becomes double backslash
-    for (size_t i = 0; i < field_len; i++) {
-      if (field_data[i] == quote_char || field_data[i] == '\\') {
-        // Check for overflow before incrementing
-        if (escaped_len == SIZE_MAX) {
-          return SIZE_MAX; // Overflow - return max value
-        }
-        escaped_len++; // One extra character per quote or backslash
+    else {
+      GTEXT_CSV_Status status = csv_write_buffer_flush(out);
+      if (status != GTEXT_CSV_OK) {
+        return status;
+      }
+      if (len >= out->size) {
+        return out->sink->write(out->sink->user, bytes, len);
       }
     }
-    break;
   }
-
-  case GTEXT_CSV_ESCAPE_NONE: {
-    // No escaping - length unchanged
-    break;
+  if (len > 0) {
+    memcpy(out->data + out->used, bytes, len);
+    out->used += len;
   }
-
-  default:
-    // Unknown escape mode - treat as no escaping
-    break;
-  }
-
-  return escaped_len;
+  return GTEXT_CSV_OK;
 }
 
-static GTEXT_CSV_Status csv_field_escape(const char * field_data,
-    size_t field_len, char * output_buffer, size_t output_buffer_size,
-    GTEXT_CSV_Escape_Mode escape_mode, char quote_char, size_t * output_len) {
-  if (!field_data || !output_buffer || !output_len) {
-    return GTEXT_CSV_E_INVALID;
-  }
-
-  if (field_len == 0) {
-    *output_len = 0;
-    return GTEXT_CSV_OK;
+static size_t csv_field_classify(const char * field_data, size_t field_len,
+    const GTEXT_CSV_Write_Options * opts, bool * special_out,
+    bool * has_quote_out) {
+  const char quote = opts->dialect.quote;
+  const char delimiter = opts->dialect.delimiter;
+  const GTEXT_CSV_Escape_Mode escape_mode = opts->dialect.escape;
+  const unsigned char set[5] = {
+      (unsigned char)quote, (unsigned char)delimiter, '\n', '\r', '\\'};
+  size_t set_len = escape_mode == GTEXT_CSV_ESCAPE_BACKSLASH ? 5 : 4;
+
+  const unsigned char * s = (const unsigned char *)field_data;
+  bool special = false;
+  size_t quotes = 0;
+  size_t backslashes = 0;
+  size_t i = 0;
+  while (i < field_len) {
+    i += text_simd_span_excluding(s + i, field_len - i, set, set_len);
+    if (i == field_len) {
+      break;
+    }
+    char c = (char)s[i++];
+    if (c == quote) {
+      quotes++;
+      special = true;
+      continue;
+    }
+    if (c == '\\' && set_len == 5) {
+      backslashes++;
+    }
+    if (c != '\\' || c == delimiter) {
+      special = true;
+    }
   }
 
-  size_t out_idx = 0;
-
+  *special_out = special;
+  *has_quote_out = quotes > 0;
   switch (escape_mode) {
-  case GTEXT_CSV_ESCAPE_DOUBLED_QUOTE: {
-    // Double each quote character
-    for (size_t i = 0; i < field_len; i++) {
-      if (out_idx + 1 > output_buffer_size) {
-        return GTEXT_CSV_E_INVALID;
-      }
-      if (field_data[i] == quote_char) {
-        // Write two quotes
-        output_buffer[out_idx++] = quote_char;
-        if (out_idx + 1 > output_buffer_size) {
-          return GTEXT_CSV_E_INVALID;
-        }
-        output_buffer[out_idx++] = quote_char;
-      }
-      else {
-        output_buffer[out_idx++] = field_data[i];
-      }
-    }
-    break;
+  case GTEXT_CSV_ESCAPE_DOUBLED_QUOTE:
+    return quotes;
+  case GTEXT_CSV_ESCAPE_BACKSLASH:
+    return quotes + backslashes;
+  default:
+    return 0;
   }
+}
 
-  case GTEXT_CSV_ESCAPE_BACKSLASH: {
-    // Escape quotes with backslash and backslashes with double backslash
-    for (size_t i = 0; i < field_len; i++) {
-      if (field_data[i] == quote_char) {
-        // Write backslash followed by quote
-        if (out_idx + 2 > output_buffer_size) {
-          return GTEXT_CSV_E_INVALID;
-        }
-        output_buffer[out_idx++] = '\\';
-        output_buffer[out_idx++] = quote_char;
-      }
-      else if (field_data[i] == '\\') {
-        // Write double backslash
-        if (out_idx + 2 > output_buffer_size) {
-          return GTEXT_CSV_E_INVALID;
-        }
-        output_buffer[out_idx++] = '\\';
-        output_buffer[out_idx++] = '\\';
-      }
-      else {
-        if (out_idx + 1 > output_buffer_size) {
-          return GTEXT_CSV_E_INVALID;
-        }
-        output_buffer[out_idx++] = field_data[i];
-      }
+static GTEXT_CSV_Status csv_field_escape_into(csv_write_buffer * out,
+    const char * field_data, size_t field_len,
+    GTEXT_CSV_Escape_Mode escape_mode, char quote_char) {
+  const bool backslash = escape_mode == GTEXT_CSV_ESCAPE_BACKSLASH;
+  const unsigned char set[2] = {(unsigned char)quote_char, '\\'};
+  const char escape_char = backslash ? '\\' : quote_char;
+
+  size_t i = 0;
+  while (i < field_len) {
+    size_t run = text_simd_span_excluding((const unsigned char *)field_data + i,
+        field_len - i, set, backslash ? 2 : 1);
+    GTEXT_CSV_Status status =
+        csv_write_buffer_put(out, field_data + i, run);
+    if (status != GTEXT_CSV_OK) {
+      return status;
     }
-    break;
-  }
-
-  case GTEXT_CSV_ESCAPE_NONE: {
-    // No escaping - copy as-is
-    if (field_len > output_buffer_size) {
-      return GTEXT_CSV_E_INVALID;
+    i += run;
+    if (i == field_len) {
+      break;
     }
-    memcpy(output_buffer, field_data, field_len);
-    out_idx = field_len;
-    break;
-  }
-
-  default:
-    // Unknown escape mode - copy as-is
-    if (field_len > output_buffer_size) {
-      return GTEXT_CSV_E_INVALID;
+    const char pair[2] = {escape_char, field_data[i++]};
+    status = csv_write_buffer_put(out, pair, 2);
+    if (status != GTEXT_CSV_OK) {
+      return status;
     }
-    memcpy(output_buffer, field_data, field_len);
-    out_idx = field_len;
-    break;
   }
-
-  *output_len = out_idx;
   return GTEXT_CSV_OK;
 }
 
-GTEXT_INTERNAL_API GTEXT_CSV_Status csv_write_field(const GTEXT_CSV_Sink * sink,
+static GTEXT_CSV_Status csv_field_write_buffered(csv_write_buffer * out,
     const char * field_data, size_t field_len,
     const GTEXT_CSV_Write_Options * opts) {
-  if (!sink || !sink->write || !opts) {
+  if (!field_data && field_len > 0) {
     return GTEXT_CSV_E_INVALID;
   }
 
   const char quote_char = opts->dialect.quote;
   const GTEXT_CSV_Escape_Mode escape_mode = opts->dialect.escape;
-  bool needs_quoting = csv_field_needs_quoting(field_data, field_len, opts);
-
-  // If field doesn't need quoting and has no quotes to escape, write directly
-  if (!needs_quoting && field_len > 0 && field_data) {
-    // Check if field contains quotes that need escaping
-    bool has_quotes = false;
-    for (size_t i = 0; i < field_len; i++) {
-      if (field_data[i] == quote_char) {
-        has_quotes = true;
-        break;
-      }
+  bool escaping = escape_mode == GTEXT_CSV_ESCAPE_DOUBLED_QUOTE ||
+      escape_mode == GTEXT_CSV_ESCAPE_BACKSLASH;
+
+  // Skip the scan when its results cannot change the output
+  bool special = false;
+  bool has_quote = false;
+  size_t escapes = 0;
+  if (field_len > 0 && (escaping || opts->quote_if_needed)) {
+    escapes = csv_field_classify(
+        field_data, field_len, opts, &special, &has_quote);
+  }
+
+  bool quoted = opts->quote_all_fields ||
+      (opts->quote_empty_fields && field_len == 0) ||
+      (opts->quote_if_needed && special);
+  // Unquoted fields are only escaped when they contain the quote char
+  if (!quoted && !has_quote) {
+    escapes = 0;
+  }
+
+  if (field_len > SIZE_MAX / 2) {
+    return GTEXT_CSV_E_LIMIT;
+  }
+  size_t total = field_len + escapes + (quoted ? 2 : 0);
+
+  // Keep a field that fits in one block in one sink call, or grow a
+  // growable block once for the whole field
+  if (total > out->size - out->used) {
+    GTEXT_CSV_Status status = GTEXT_CSV_OK;
+    if (!out->sink) {
+      status = total > SIZE_MAX - out->used
+          ? GTEXT_CSV_E_OOM
+          : csv_write_buffer_grow(out, out->used + total);
     }
-
-    // If no quotes and no special chars, write directly
-    if (!has_quotes) {
-      return sink->write(sink->user, field_data, field_len);
+    else if (total <= out->size) {
+      status = csv_write_buffer_flush(out);
     }
-  }
-
-  // Field needs quoting or escaping - handle it
-  if (needs_quoting) {
-    // Write opening quote
-    GTEXT_CSV_Status status = sink->write(sink->user, &quote_char, 1);
     if (status != GTEXT_CSV_OK) {
       return status;
     }
-
-    // Escape and write field content
-    if (field_len > 0 && field_data) {
-      // Calculate escaped length
-      size_t escaped_len = csv_field_escaped_length(
-          field_data, field_len, escape_mode, quote_char);
-
-      // Check for overflow in escaped length calculation
-      if (escaped_len == SIZE_MAX || escaped_len < field_len) {
-        // Overflow detected or invalid calculation - return error
-        return GTEXT_CSV_E_LIMIT;
-      }
-
-      // Allocate temporary buffer for escaped field
-      // For efficiency, use stack buffer for small fields
-      // and heap buffer for large fields
-      const size_t STACK_BUFFER_SIZE = 256;
-      char * escape_buffer = NULL;
-      bool use_stack = (escaped_len < STACK_BUFFER_SIZE);
-      char stack_buffer[STACK_BUFFER_SIZE];
-
-      if (use_stack) {
-        escape_buffer = stack_buffer;
-      }
-      else {
-        // Check for reasonable allocation size (prevent excessive memory
-        // allocation) In practice, escaped_len should be reasonable, but be
-        // defensive
-        if (escaped_len > SIZE_MAX / 2) {
-          // Avoid allocating more than half of addressable space
-          return GTEXT_CSV_E_LIMIT;
-        }
-        escape_buffer = (char *)malloc(escaped_len);
-        if (!escape_buffer) {
-          return GTEXT_CSV_E_OOM;
-        }
-      }
-
-      size_t actual_escaped_len = 0;
-      status = csv_field_escape(field_data, field_len, escape_buffer,
-          escaped_len, escape_mode, quote_char, &actual_escaped_len);
-
-      if (status == GTEXT_CSV_OK) {
-        status = sink->write(sink->user, escape_buffer, actual_escaped_len);
-      }
-
-      if (!use_stack) {
-        free(escape_buffer);
-      }
-
-      if (status != GTEXT_CSV_OK) {
-        return status;
-      }
-    }
-
-    // Write closing quote
-    return sink->write(sink->user, &quote_char, 1);
   }
-  else {
-    // Field doesn't need quoting but may need escaping (for unquoted quotes)
-    // This is an edge case - if allow_unquoted_quotes is true, we might
-    // have quotes in unquoted fields. For now, we'll escape them anyway
-    // if escape mode is not NONE.
-    if (escape_mode != GTEXT_CSV_ESCAPE_NONE && field_len > 0 && field_data) {
-      size_t escaped_len = csv_field_escaped_length(
-          field_data, field_len, escape_mode, quote_char);
 
-      // Check for overflow in escaped length calculation
-      if (escaped_len == SIZE_MAX || escaped_len < field_len) {
-        // Overflow detected or invalid calculation - return error
-        return GTEXT_CSV_E_LIMIT;
-      }
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  if (quoted) {
+    status = csv_write_buffer_put(out, &quote_char, 1);
+  }
+  if (status == GTEXT_CSV_OK) {
+    status = escapes > 0
+        ? csv_field_escape_into(
+              out, field_data, field_len, escape_mode, quote_char)
+        : csv_write_buffer_put(out, field_data, field_len);
+  }
+  if (status == GTEXT_CSV_OK && quoted) {
+    status = csv_write_buffer_put(out, &quote_char, 1);
+  }
+  return status;
+}
 
-      if (escaped_len > field_len) {
-        // Need to escape - use temporary buffer
-        const size_t STACK_BUFFER_SIZE = 256;
-        char * escape_buffer = NULL;
-        bool use_stack = (escaped_len < STACK_BUFFER_SIZE);
-        char stack_buffer[STACK_BUFFER_SIZE];
-
-        if (use_stack) {
-          escape_buffer = stack_buffer;
-        }
-        else {
-          // Check for reasonable allocation size (prevent excessive memory
-          // allocation)
-          if (escaped_len > SIZE_MAX / 2) {
-            // Avoid allocating more than half of addressable space
-            return GTEXT_CSV_E_LIMIT;
-          }
-          escape_buffer = (char *)malloc(escaped_len);
-          if (!escape_buffer) {
-            return GTEXT_CSV_E_OOM;
-          }
-        }
-
-        size_t actual_escaped_len = 0;
-        GTEXT_CSV_Status status =
-            csv_field_escape(field_data, field_len, escape_buffer, escaped_len,
-                escape_mode, quote_char, &actual_escaped_len);
-
-        if (status == GTEXT_CSV_OK) {
-          status = sink->write(sink->user, escape_buffer, actual_escaped_len);
-        }
-
-        if (!use_stack) {
-          free(escape_buffer);
-        }
+GTEXT_INTERNAL_API GTEXT_CSV_Status csv_write_field(const GTEXT_CSV_Sink * sink,
+    const char * field_data, size_t field_len,
+    const GTEXT_CSV_Write_Options * opts) {
+  if (!sink || !sink->write || !opts) {
+    return GTEXT_CSV_E_INVALID;
+  }
 
-        return status;
-      }
-      else {
-        // No escaping needed - write directly
-        return sink->write(sink->user, field_data, field_len);
-      }
-    }
-    else {
-      // No escaping needed - write directly
-      return sink->write(sink->user, field_data, field_len);
-    }
+  char block[CSV_WRITE_SMALL_BLOCK_SIZE];
+  csv_write_buffer out = {sink, block, sizeof(block), 0};
+  GTEXT_CSV_Status status =
+      csv_field_write_buffered(&out, field_data, field_len, opts);
+  if (status != GTEXT_CSV_OK) {
+    return status;
   }
+  return csv_write_buffer_flush(&out);
 }
 
 // ============================================================================
@@ -664,20 +565,25 @@ GTEXT_API GTEXT_CSV_Status gtext_csv_writer_field(
     return GTEXT_CSV_E_INVALID;
   }
 
+  // Gather the delimiter and the quoted, escaped field into one sink call
+  char block[CSV_WRITE_SMALL_BLOCK_SIZE];
+  csv_write_buffer out = {&writer->sink, block, sizeof(block), 0};
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+
   // Insert delimiter before field if this is not the first field in the record
   if (writer->has_fields_in_record) {
     char delimiter = writer->opts.dialect.delimiter;
-    GTEXT_CSV_Status status =
-        writer->sink.write(writer->sink.user, &delimiter, 1);
-    if (status != GTEXT_CSV_OK) {
-      writer->last_error = status;
-      return status;
-    }
+    status = csv_write_buffer_put(&out, &delimiter, 1);
   }
 
   // Write the field with proper quoting and escaping
-  GTEXT_CSV_Status status =
-      csv_write_field(&writer->sink, (const char *)bytes, len, &writer->opts);
+  if (status == GTEXT_CSV_OK) {
+    status = csv_field_write_buffered(
+        &out, (const char *)bytes, len, &writer->opts);
+  }
+  if (status == GTEXT_CSV_OK) {
+    status = csv_write_buffer_flush(&out);
+  }
 
   if (status != GTEXT_CSV_OK) {
     writer->last_error = status;
@@ -780,180 +686,368 @@ static size_t csv_find_last_non_empty_field(const csv_table_row * row) {
   return SIZE_MAX;
 }
 
-GTEXT_API GTEXT_CSV_Status gtext_csv_write_table(const GTEXT_CSV_Sink * sink,
-    const GTEXT_CSV_Write_Options * opts, const GTEXT_CSV_Table * table) {
-  if (!sink || !sink->write || !table) {
+// Write one row: its fields (less trailing empty ones if requested) and a
+// newline
+static GTEXT_CSV_Status csv_write_table_row(csv_write_buffer * out,
+    const GTEXT_CSV_Write_Options * opts, const csv_table_row * table_row) {
+  // Defensive check: verify fields array is allocated
+  if (!table_row->fields && table_row->field_count > 0) {
     return GTEXT_CSV_E_INVALID;
   }
 
-  // Get default options if not provided
-  GTEXT_CSV_Write_Options default_opts = gtext_csv_write_options_default();
-  if (!opts) {
-    opts = &default_opts;
+  // Determine how many fields to write (trim trailing empty if requested)
+  size_t fields_to_write = table_row->field_count;
+  if (opts->trim_trailing_empty_fields) {
+    size_t last_non_empty = csv_find_last_non_empty_field(table_row);
+    if (last_non_empty != SIZE_MAX) {
+      fields_to_write = last_non_empty + 1;
+    } else {
+      fields_to_write = 0; // All fields empty
+    }
   }
 
-  // Cast to internal structure to access fields
-  // The structure definition is in csv_internal.h and matches csv_table.c
-  const struct GTEXT_CSV_Table * table_internal =
-      (const struct GTEXT_CSV_Table *)table;
+  // Write fields in row
+  for (size_t col = 0; col < fields_to_write; col++) {
+    const csv_table_field * field = &table_row->fields[col];
 
-  // Defensive check: verify rows array is allocated
-  if (!table_internal->rows) {
-    return GTEXT_CSV_E_INVALID;
+    // Defensive check: if field has length > 0, data must not be NULL
+    if (field->length > 0 && !field->data) {
+      return GTEXT_CSV_E_INVALID;
+    }
+
+    // Insert delimiter before field if not first field
+    if (col > 0) {
+      char delimiter = opts->dialect.delimiter;
+      GTEXT_CSV_Status status = csv_write_buffer_put(out, &delimiter, 1);
+      if (status != GTEXT_CSV_OK) {
+        return status;
+      }
+    }
+
+    // Write field with proper quoting and escaping
+    GTEXT_CSV_Status status =
+        csv_field_write_buffered(out, field->data, field->length, opts);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
   }
 
+  // Write newline after row. For CSV, we typically write newline after each
+  // row
+  const char * newline = opts->newline ? opts->newline : "\n";
+  size_t newline_len = strlen(newline);
+  return csv_write_buffer_put(out, newline, newline_len);
+}
+
+// Write the rows [first_row, end_row) of a table
+// scratch_fields holds one row of a column-major table (NULL for row-major)
+static GTEXT_CSV_Status csv_write_table_range(csv_write_buffer * out,
+    const GTEXT_CSV_Write_Options * opts,
+    const struct GTEXT_CSV_Table * table_internal, size_t first_row,
+    size_t end_row, csv_table_field * scratch_fields) {
+  csv_table_row scratch_row;
+  for (size_t row = first_row; row < end_row; row++) {
+    const csv_table_row * table_row = csv_table_resolve_row(
+        table_internal, row, &scratch_row, scratch_fields);
+    GTEXT_CSV_Status status = csv_write_table_row(out, opts, table_row);
+    if (status != GTEXT_CSV_OK) {
+      return status;
+    }
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Write the header row (if any) and the data rows before end_row into the
+// output block
+// scratch_fields holds one row of a column-major table (NULL for row-major)
+static GTEXT_CSV_Status csv_write_table_rows(csv_write_buffer * out,
+    const GTEXT_CSV_Write_Options * opts,
+    const struct GTEXT_CSV_Table * table_internal, size_t end_row,
+    csv_table_field * scratch_fields) {
+  bool is_columnar = table_internal->columns != NULL;
+
   // Handle empty table
   if (table_internal->row_count == 0) {
     // Empty table - write nothing (or trailing newline if requested)
     if (opts->trailing_newline) {
       const char * newline = opts->newline ? opts->newline : "\n";
       size_t newline_len = strlen(newline);
-      return sink->write(sink->user, newline, newline_len);
+      return csv_write_buffer_put(out, newline, newline_len);
     }
     return GTEXT_CSV_OK;
   }
 
   // Defensive check: verify row_count doesn't exceed capacity (sanity check)
-  if (table_internal->row_count > table_internal->row_capacity) {
+  size_t row_capacity = is_columnar ? table_internal->columns->row_capacity
+                                    : table_internal->row_capacity;
+  if (table_internal->row_count > row_capacity) {
     return GTEXT_CSV_E_INVALID;
   }
 
-  // Determine start row (skip header if present)
-  size_t start_row = 0;
+  // Data rows start after the header row, if present
+  size_t start_row = table_internal->has_header ? 1 : 0;
+  if (end_row > table_internal->row_count) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  if (end_row < start_row) {
+    end_row = start_row;
+  }
 
-  // Write header row if present
-  if (table_internal->has_header) {
-    // Bounds check: ensure row 0 is within allocated capacity
-    if (table_internal->row_capacity == 0) {
-      return GTEXT_CSV_E_INVALID;
-    }
+  // trailing_newline only matters for empty tables: every written row ends
+  // with a newline, which is standard CSV
+  return csv_write_table_range(
+      out, opts, table_internal, 0, end_row, scratch_fields);
+}
 
-    const csv_table_row * header_row = &table_internal->rows[0];
+/**
+ * @brief Data rows formatted by one parallel write task
+ */
+#define CSV_PARALLEL_WRITE_ROWS 4096
 
-    // Defensive check: verify fields array is allocated
-    if (!header_row->fields && header_row->field_count > 0) {
-      return GTEXT_CSV_E_INVALID;
-    }
+/**
+ * @brief Maximum number of worker threads for a parallel table write
+ */
+#define CSV_PARALLEL_WRITE_MAX_THREADS 64
 
-    // Determine how many fields to write (trim trailing empty if requested)
-    size_t fields_to_write = header_row->field_count;
-    if (opts->trim_trailing_empty_fields) {
-      size_t last_non_empty = csv_find_last_non_empty_field(header_row);
-      if (last_non_empty != SIZE_MAX) {
-        fields_to_write = last_non_empty + 1;
-      } else {
-        fields_to_write = 0; // All fields empty
-      }
-    }
+/**
+ * @brief Buffers in flight per parallel write worker
+ *
+ * A worker may format a task only while fewer than this many tasks per
+ * worker are waiting to reach the sink, which bounds memory however large
+ * the table is.
+ */
+#define CSV_PARALLEL_WRITE_SLOTS_PER_THREAD 2
 
-    // Write fields in header row
-    for (size_t col = 0; col < fields_to_write; col++) {
-      const csv_table_field * field = &header_row->fields[col];
+/**
+ * @brief Output of one parallel write task
+ */
+typedef struct {
+  csv_write_buffer out;   ///< Growable buffer, reused by later tasks
+  bool ready;             ///< Formatted and waiting for the sink
+  GTEXT_CSV_Status status; ///< Result of formatting the task
+} csv_parallel_write_slot;
 
-      // Defensive check: if field has length > 0, data must not be NULL
-      if (field->length > 0 && !field->data) {
-        return GTEXT_CSV_E_INVALID;
-      }
+/**
+ * @brief State shared by the workers and the thread feeding the sink
+ *
+ * Task t covers CSV_PARALLEL_WRITE_ROWS data rows from first_row and is
+ * formatted into slot t % slot_count. A worker claims task t only once task
+ * t - slot_count has been emitted, so slots are never overwritten early.
+ */
+typedef struct {
+  const struct GTEXT_CSV_Table * table;
+  const GTEXT_CSV_Write_Options * opts;
+  size_t first_row;
+  size_t end_row;
+  size_t task_count;
+  csv_parallel_write_slot * slots;
+  size_t slot_count;
+  size_t next_task; ///< Next task a worker will claim
+  size_t emitted;   ///< Tasks passed to the sink
+  bool abort;       ///< Stop claiming tasks
+  GTEXT_CSV_Status status; ///< Failure outside any task
+  pthread_mutex_t lock;
+  pthread_cond_t slot_free;  ///< Signaled when a task is emitted
+  pthread_cond_t slot_ready; ///< Signaled when a task is formatted
+} csv_parallel_write;
+
+// Worker: claim tasks in order and format each into its slot
+static void * csv_parallel_write_worker(void * arg) {
+  csv_parallel_write * pw = (csv_parallel_write *)arg;
+  const struct GTEXT_CSV_Table * table = pw->table;
+  csv_table_field * scratch_fields = NULL;
+  if (table->columns && table->columns->column_count > 0) {
+    scratch_fields = (csv_table_field *)malloc(
+        sizeof(csv_table_field) * table->columns->column_count);
+  }
+
+  pthread_mutex_lock(&pw->lock);
+  if (table->columns && table->columns->column_count > 0 && !scratch_fields) {
+    pw->status = GTEXT_CSV_E_OOM;
+    pw->abort = true;
+    pthread_cond_broadcast(&pw->slot_ready);
+  }
+  for (;;) {
+    while (!pw->abort && pw->next_task < pw->task_count &&
+        pw->next_task >= pw->emitted + pw->slot_count) {
+      pthread_cond_wait(&pw->slot_free, &pw->lock);
+    }
+    if (pw->abort || pw->next_task >= pw->task_count) {
+      break;
+    }
+    size_t task = pw->next_task++;
+    csv_parallel_write_slot * slot = &pw->slots[task % pw->slot_count];
+    pthread_mutex_unlock(&pw->lock);
+
+    size_t first = pw->first_row + task * CSV_PARALLEL_WRITE_ROWS;
+    size_t end = pw->end_row - first > CSV_PARALLEL_WRITE_ROWS
+        ? first + CSV_PARALLEL_WRITE_ROWS
+        : pw->end_row;
+    slot->out.used = 0;
+    GTEXT_CSV_Status status = csv_write_table_range(
+        &slot->out, pw->opts, table, first, end, scratch_fields);
+
+    pthread_mutex_lock(&pw->lock);
+    slot->status = status;
+    slot->ready = true;
+    pthread_cond_broadcast(&pw->slot_ready);
+  }
+  pthread_mutex_unlock(&pw->lock);
+
+  free(scratch_fields);
+  return NULL;
+}
 
-      // Insert delimiter before field if not first field
-      if (col > 0) {
-        char delimiter = opts->dialect.delimiter;
-        GTEXT_CSV_Status status = sink->write(sink->user, &delimiter, 1);
-        if (status != GTEXT_CSV_OK) {
-          return status;
-        }
-      }
+// Pass formatted tasks to the sink in order, as each becomes ready
+static GTEXT_CSV_Status csv_parallel_write_emit(
+    csv_parallel_write * pw, const GTEXT_CSV_Sink * sink) {
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  for (size_t task = 0; task < pw->task_count && status == GTEXT_CSV_OK;
+       task++) {
+    csv_parallel_write_slot * slot = &pw->slots[task % pw->slot_count];
+    pthread_mutex_lock(&pw->lock);
+    while (!slot->ready && !pw->abort) {
+      pthread_cond_wait(&pw->slot_ready, &pw->lock);
+    }
+    status = slot->ready ? slot->status : pw->status;
+    pthread_mutex_unlock(&pw->lock);
 
-      // Write field with proper quoting and escaping
-      GTEXT_CSV_Status status =
-          csv_write_field(sink, field->data, field->length, opts);
-      if (status != GTEXT_CSV_OK) {
-        return status;
-      }
+    if (status == GTEXT_CSV_OK && slot->out.used > 0) {
+      status = sink->write(sink->user, slot->out.data, slot->out.used);
     }
 
-    // Write newline after header row
-    const char * newline = opts->newline ? opts->newline : "\n";
-    size_t newline_len = strlen(newline);
-    GTEXT_CSV_Status status = sink->write(sink->user, newline, newline_len);
+    pthread_mutex_lock(&pw->lock);
+    slot->ready = false;
+    pw->emitted++;
     if (status != GTEXT_CSV_OK) {
-      return status;
+      pw->abort = true;
     }
-
-    // Data rows start at index 1
-    start_row = 1;
+    pthread_cond_broadcast(&pw->slot_free);
+    pthread_mutex_unlock(&pw->lock);
   }
+  return status;
+}
 
-  // Write all data rows
-  // Bounds check: ensure start_row is valid
-  if (start_row > table_internal->row_count) {
-    return GTEXT_CSV_E_INVALID;
+// Format the data rows [first_row, end_row) on worker threads and write them
+// to the sink in row order
+// Sets *ran to false, writing nothing, if no worker could be started
+static GTEXT_CSV_Status csv_parallel_write_rows(const GTEXT_CSV_Sink * sink,
+    const GTEXT_CSV_Write_Options * opts,
+    const struct GTEXT_CSV_Table * table_internal, size_t first_row,
+    size_t end_row, size_t thread_count, bool * ran) {
+  csv_parallel_write pw = {0};
+  pw.table = table_internal;
+  pw.opts = opts;
+  pw.first_row = first_row;
+  pw.end_row = end_row;
+  pw.task_count = (end_row - first_row + CSV_PARALLEL_WRITE_ROWS - 1) /
+      CSV_PARALLEL_WRITE_ROWS;
+  pw.slot_count = thread_count * CSV_PARALLEL_WRITE_SLOTS_PER_THREAD;
+  pw.slots = (csv_parallel_write_slot *)calloc(
+      pw.slot_count, sizeof(csv_parallel_write_slot));
+  if (!pw.slots) {
+    return GTEXT_CSV_E_OOM;
   }
+  pthread_mutex_init(&pw.lock, NULL);
+  pthread_cond_init(&pw.slot_free, NULL);
+  pthread_cond_init(&pw.slot_ready, NULL);
 
-  for (size_t row = start_row; row < table_internal->row_count; row++) {
-    // Bounds check: ensure row index is within allocated array
-    if (row >= table_internal->row_capacity) {
-      return GTEXT_CSV_E_INVALID;
+  pthread_t threads[CSV_PARALLEL_WRITE_MAX_THREADS];
+  size_t started = 0;
+  for (size_t i = 0; i < thread_count; i++) {
+    if (pthread_create(&threads[started], NULL, csv_parallel_write_worker,
+            &pw) == 0) {
+      started++;
     }
+  }
 
-    const csv_table_row * table_row = &table_internal->rows[row];
-
-    // Defensive check: verify fields array is allocated
-    if (!table_row->fields && table_row->field_count > 0) {
-      return GTEXT_CSV_E_INVALID;
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  if (started > 0) {
+    status = csv_parallel_write_emit(&pw, sink);
+    pthread_mutex_lock(&pw.lock);
+    pw.abort = true;
+    pthread_cond_broadcast(&pw.slot_free);
+    pthread_mutex_unlock(&pw.lock);
+    for (size_t i = 0; i < started; i++) {
+      pthread_join(threads[i], NULL);
     }
+  }
+  *ran = started > 0;
 
-    // Determine how many fields to write (trim trailing empty if requested)
-    size_t fields_to_write = table_row->field_count;
-    if (opts->trim_trailing_empty_fields) {
-      size_t last_non_empty = csv_find_last_non_empty_field(table_row);
-      if (last_non_empty != SIZE_MAX) {
-        fields_to_write = last_non_empty + 1;
-      } else {
-        fields_to_write = 0; // All fields empty
-      }
-    }
+  for (size_t i = 0; i < pw.slot_count; i++) {
+    free(pw.slots[i].out.data);
+  }
+  free(pw.slots);
+  pthread_cond_destroy(&pw.slot_ready);
+  pthread_cond_destroy(&pw.slot_free);
+  pthread_mutex_destroy(&pw.lock);
+  return status;
+}
 
-    // Write fields in row
-    for (size_t col = 0; col < fields_to_write; col++) {
-      const csv_table_field * field = &table_row->fields[col];
+GTEXT_API GTEXT_CSV_Status gtext_csv_write_table(const GTEXT_CSV_Sink * sink,
+    const GTEXT_CSV_Write_Options * opts, const GTEXT_CSV_Table * table) {
+  if (!sink || !sink->write || !table) {
+    return GTEXT_CSV_E_INVALID;
+  }
 
-      // Defensive check: if field has length > 0, data must not be NULL
-      if (field->length > 0 && !field->data) {
-        return GTEXT_CSV_E_INVALID;
-      }
+  // Get default options if not provided
+  GTEXT_CSV_Write_Options default_opts = gtext_csv_write_options_default();
+  if (!opts) {
+    opts = &default_opts;
+  }
 
-      // Insert delimiter before field if not first field
-      if (col > 0) {
-        char delimiter = opts->dialect.delimiter;
-        GTEXT_CSV_Status status = sink->write(sink->user, &delimiter, 1);
-        if (status != GTEXT_CSV_OK) {
-          return status;
-        }
-      }
+  // Cast to internal structure to access fields
+  // The structure definition is in csv_internal.h and matches csv_table.c
+  const struct GTEXT_CSV_Table * table_internal =
+      (const struct GTEXT_CSV_Table *)table;
 
-      // Write field with proper quoting and escaping
-      GTEXT_CSV_Status status =
-          csv_write_field(sink, field->data, field->length, opts);
-      if (status != GTEXT_CSV_OK) {
-        return status;
-      }
+  // Data rows go to worker threads when there are enough for two tasks
+  size_t data_start = table_internal->has_header ? 1 : 0;
+  size_t data_rows = table_internal->row_count > data_start
+      ? table_internal->row_count - data_start
+      : 0;
+  size_t thread_count = opts->write_threads;
+  if (thread_count > CSV_PARALLEL_WRITE_MAX_THREADS) {
+    thread_count = CSV_PARALLEL_WRITE_MAX_THREADS;
+  }
+  bool parallel = thread_count > 1 && data_rows > CSV_PARALLEL_WRITE_ROWS;
+
+  // Column-major tables are written through a scratch row
+  csv_table_field * scratch_fields = NULL;
+  if (table_internal->columns && table_internal->columns->column_count > 0) {
+    scratch_fields = (csv_table_field *)malloc(
+        sizeof(csv_table_field) * table_internal->columns->column_count);
+    if (!scratch_fields) {
+      return GTEXT_CSV_E_OOM;
     }
+  }
 
-    // Write newline after row (except possibly last row if trailing_newline is
-    // false) For CSV, we typically write newline after each row
-    const char * newline = opts->newline ? opts->newline : "\n";
-    size_t newline_len = strlen(newline);
-    GTEXT_CSV_Status status = sink->write(sink->user, newline, newline_len);
-    if (status != GTEXT_CSV_OK) {
-      return status;
+  char * block = (char *)malloc(CSV_WRITE_BLOCK_SIZE);
+  if (!block) {
+    free(scratch_fields);
+    return GTEXT_CSV_E_OOM;
+  }
+  csv_write_buffer out = {sink, block, CSV_WRITE_BLOCK_SIZE, 0};
+
+  // In parallel mode this thread writes only the header row
+  GTEXT_CSV_Status status = csv_write_table_rows(&out, opts, table_internal,
+      parallel ? data_start : table_internal->row_count, scratch_fields);
+  if (status == GTEXT_CSV_OK && parallel) {
+    status = csv_write_buffer_flush(&out);
+    bool ran = false;
+    if (status == GTEXT_CSV_OK) {
+      status = csv_parallel_write_rows(sink, opts, table_internal, data_start,
+          table_internal->row_count, thread_count, &ran);
+    }
+    if (status == GTEXT_CSV_OK && !ran) {
+      status = csv_write_table_range(&out, opts, table_internal, data_start,
+          table_internal->row_count, scratch_fields);
     }
   }
-
-  // trailing_newline option is typically handled per-row above,
-  // but if the table is empty and trailing_newline is true, we already handled
-  // it. For non-empty tables, we've written newlines after each row, which is
-  // standard CSV.
-
-  return GTEXT_CSV_OK;
+  if (status == GTEXT_CSV_OK) {
+    status = csv_write_buffer_flush(&out);
+  }
+  free(block);
+  free(scratch_fields);
+  return status;
 }
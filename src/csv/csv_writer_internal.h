@@ -23,62 +23,90 @@ extern "C" {
 // ============================================================================
 
 /**
- * @brief Determine if a field needs to be quoted
+ * @brief Pass the bytes gathered in an output block to its sink
  *
- * Checks the write options to determine if a field should be quoted:
- * - quote_all_fields: always quote
- * - quote_empty_fields: quote if field is empty
- * - quote_if_needed: quote if field contains delimiter, quote char, or newline
+ * @fn static GTEXT_CSV_Status csv_write_buffer_flush(csv_write_buffer * out)
  *
- * @fn static bool csv_field_needs_quoting(const char * field_data, size_t
- * field_len, const GTEXT_CSV_Write_Options * opts)
+ * @param out Output block
+ * @return GTEXT_CSV_OK on success, or the sink's error code
  *
- * @param field_data Field data (may be NULL if field_len is 0)
- * @param field_len Field length in bytes (0 for empty field)
+ * @note This is a static function defined in csv_writer.c
+ */
+
+/**
+ * @brief Append bytes to an output block
+ *
+ * Flushes the block when the bytes do not fit. A run at least as long as the
+ * block is passed to the sink directly instead of being copied.
+ *
+ * @fn static GTEXT_CSV_Status csv_write_buffer_put(csv_write_buffer * out,
+ * const char * bytes, size_t len)
+ *
+ * @param out Output block
+ * @param bytes Bytes to append
+ * @param len Number of bytes
+ * @return GTEXT_CSV_OK on success, or the sink's error code
+ *
+ * @note This is a static function defined in csv_writer.c
+ */
+
+/**
+ * @brief Classify a field for quoting and escaping in one pass
+ *
+ * Jumps between delimiter, quote, newline and (for backslash escapes)
+ * backslash bytes a block at a time, noting whether the field holds any byte
+ * that requires quote_if_needed quoting, whether it holds the quote char,
+ * and how many bytes grow by one when the field is escaped.
+ *
+ * @fn static size_t csv_field_classify(const char * field_data, size_t
+ * field_len, const GTEXT_CSV_Write_Options * opts, bool * special_out, bool *
+ * has_quote_out)
+ *
+ * @param field_data Field data
+ * @param field_len Field length in bytes
  * @param opts Write options
- * @return true if field should be quoted, false otherwise
+ * @param special_out Set if the field holds a delimiter, quote or newline
+ * @param has_quote_out Set if the field holds the quote char
+ * @return Number of bytes escaping adds
  *
  * @note This is a static function defined in csv_writer.c
  */
 
 /**
- * @brief Calculate the escaped length of a field
+ * @brief Escape a field straight into an output block
  *
- * Calculates how many bytes the field will take after escaping quotes
- * according to the escape mode.
+ * Copies runs of plain bytes and writes an escape pair for each quote (and
+ * backslash, for backslash escapes).
  *
- * @fn static size_t csv_field_escaped_length(const char * field_data, size_t
- * field_len, GTEXT_CSV_Escape_Mode escape_mode, char quote_char)
+ * @fn static GTEXT_CSV_Status csv_field_escape_into(csv_write_buffer * out,
+ * const char * field_data, size_t field_len, GTEXT_CSV_Escape_Mode
+ * escape_mode, char quote_char)
  *
+ * @param out Output block
  * @param field_data Field data
  * @param field_len Field length in bytes
- * @param escape_mode Escape mode
+ * @param escape_mode Escape mode (doubled quote or backslash)
  * @param quote_char Quote character
- * @return Escaped length in bytes
+ * @return GTEXT_CSV_OK on success, or the sink's error code
  *
  * @note This is a static function defined in csv_writer.c
  */
 
 /**
- * @brief Escape a field into a buffer
+ * @brief Write a quoted and escaped field into an output block
  *
- * Escapes quotes in a field according to the escape mode and writes
- * the result to the output buffer. The output buffer must be large
- * enough to hold the escaped field (use csv_field_escaped_length to
- * calculate the required size).
+ * Applies the same rules as csv_write_field(). A field that fits in the block
+ * is never split across sink calls.
  *
- * @fn static GTEXT_CSV_Status csv_field_escape(const char * field_data, size_t
- * field_len, char * output_buffer, size_t output_buffer_size,
- * GTEXT_CSV_Escape_Mode escape_mode, char quote_char, size_t * output_len)
+ * @fn static GTEXT_CSV_Status csv_field_write_buffered(csv_write_buffer * out,
+ * const char * field_data, size_t field_len, const GTEXT_CSV_Write_Options *
+ * opts)
  *
- * @param field_data Field data to escape
+ * @param out Output block
+ * @param field_data Field data (may be NULL if field_len is 0)
  * @param field_len Field length in bytes
- * @param output_buffer Output buffer (must be large enough)
- * @param output_buffer_size Size of output buffer
- * @param escape_mode Escape mode
- * @param quote_char Quote character
- * @param output_len Output parameter: number of bytes written
- * @return GTEXT_CSV_OK on success, GTEXT_CSV_E_INVALID if buffer too small
+ * @param opts Write options
+ * @return GTEXT_CSV_OK on success, error code on failure
  *
  * @note This is a static function defined in csv_writer.c
  */
@@ -134,6 +134,7 @@ static void json_arena_free(json_arena * arena) {
 // Allocates a context and arena for a new DOM tree.
 // The context is allocated with malloc (not in the arena) so it can
 // be accessed to free the arena.
+// The new context holds a single reference, owned by the caller.
 // Returns: New context, or NULL on failure
 json_context * json_context_new(void) {
   json_context * ctx = malloc(sizeof(json_context));
@@ -149,6 +150,19 @@ json_context * json_context_new(void) {
 
   ctx->input_buffer = NULL;
   ctx->input_buffer_len = 0;
+  ctx->refcount = 1;
+  ctx->owned = NULL;
+  ctx->owned_count = 0;
+  ctx->owned_capacity = 0;
+  ctx->owner = NULL;
+  ctx->owner_slot = 0;
+  ctx->root = NULL;
+  ctx->borrowed = NULL;
+  ctx->borrowed_count = 0;
+  ctx->borrowed_capacity = 0;
+  ctx->clones = NULL;
+  ctx->clones_count = 0;
+  ctx->clones_capacity = 0;
 
   return ctx;
 }
@@ -168,70 +182,180 @@ void json_context_set_input_buffer(
   ctx->input_buffer_len = input_buffer_len;
 }
 
-// Free a context and its arena
-// ctx: Context to free (can be NULL)
+// Make room for one more entry in a link array
+// Returns: GTEXT_JSON_OK, or GTEXT_JSON_E_OOM
+static GTEXT_JSON_Status json_context_links_reserve(
+    json_context_link ** links, size_t count, size_t * capacity) {
+  if (count < *capacity) {
+    return GTEXT_JSON_OK;
+  }
+  size_t new_capacity = *capacity ? *capacity * 2 : 4;
+  if (new_capacity > SIZE_MAX / sizeof(json_context_link)) {
+    return GTEXT_JSON_E_OOM;
+  }
+  json_context_link * grown =
+      realloc(*links, new_capacity * sizeof(json_context_link));
+  if (!grown) {
+    return GTEXT_JSON_E_OOM;
+  }
+  *links = grown;
+  *capacity = new_capacity;
+  return GTEXT_JSON_OK;
+}
+
+// Remove the clone link at slot from ctx, moving the last link into its place
+static void json_context_remove_clone(json_context * ctx, size_t slot) {
+  json_context_link moved = ctx->clones[--ctx->clones_count];
+  ctx->clones[slot] = moved;
+  moved.ctx->borrowed[moved.slot].slot = slot;
+}
+
+// Remove clone from the clone lists of every context it borrows from
+// The links stay in clone->borrowed, so they can be restored by
+// json_context_relink_borrowed() or released by json_context_drop_borrowed().
+static void json_context_unlink_borrowed(json_context * clone) {
+  for (size_t i = 0; i < clone->borrowed_count; i++) {
+    json_context_remove_clone(clone->borrowed[i].ctx, clone->borrowed[i].slot);
+  }
+}
+
+// Undo json_context_unlink_borrowed()
+// The clone lists only shrank in between, so this cannot fail.
+static void json_context_relink_borrowed(json_context * clone) {
+  for (size_t i = 0; i < clone->borrowed_count; i++) {
+    json_context * src = clone->borrowed[i].ctx;
+    clone->borrowed[i].slot = src->clones_count;
+    src->clones[src->clones_count++] = (json_context_link){clone, i};
+  }
+}
+
+// Release the references an unlinked clone holds on the contexts it borrowed
+// from
+static void json_context_drop_borrowed(json_context * clone) {
+  json_context_link * links = clone->borrowed;
+  size_t count = clone->borrowed_count;
+  clone->borrowed = NULL;
+  clone->borrowed_count = 0;
+  clone->borrowed_capacity = 0;
+  for (size_t i = 0; i < count; i++) {
+    json_context_free(links[i].ctx);
+  }
+  free(links);
+}
+
+// Release a reference to a context, freeing it (and releasing the contexts
+// it keeps alive) when the last reference is dropped
+// ctx: Context to release (can be NULL)
 // Note: The input buffer (if set) is caller-owned and is NOT freed here.
 void json_context_free(json_context * ctx) {
-  if (!ctx) {
+  if (!ctx || --ctx->refcount > 0) {
     return;
   }
 
+  // Every clone holds a reference, so none is left borrowing from ctx
+  json_context_unlink_borrowed(ctx);
+  json_context_drop_borrowed(ctx);
+  free(ctx->clones);
+
+  for (size_t i = 0; i < ctx->owned_count; i++) {
+    if (ctx->owned[i]->owner == ctx) {
+      ctx->owned[i]->owner = NULL;
+    }
+    json_context_free(ctx->owned[i]);
+  }
+  free(ctx->owned);
+
   json_arena_free(ctx->arena);
   free(ctx);
 }
 
-// Recursively free child values that have different contexts
-static void json_free_children_recursive(GTEXT_JSON_Value * v) {
-  if (!v) {
-    return;
+// Record that ctx holds a reference on child, taking over the caller's
+// reference (no retain is performed), and that child is attached to ctx
+// Returns: GTEXT_JSON_OK, or GTEXT_JSON_E_OOM (the caller keeps its reference)
+static GTEXT_JSON_Status json_context_adopt(
+    json_context * ctx, json_context * child) {
+  if (ctx->owned_count == ctx->owned_capacity) {
+    size_t new_capacity =
+        ctx->owned_capacity ? ctx->owned_capacity * 2 : 4;
+    if (new_capacity > SIZE_MAX / sizeof(json_context *)) {
+      return GTEXT_JSON_E_OOM;
+    }
+    json_context ** owned =
+        realloc(ctx->owned, new_capacity * sizeof(json_context *));
+    if (!owned) {
+      return GTEXT_JSON_E_OOM;
+    }
+    ctx->owned = owned;
+    ctx->owned_capacity = new_capacity;
   }
+  child->owner = ctx;
+  child->owner_slot = ctx->owned_count;
+  ctx->owned[ctx->owned_count++] = child;
+  return GTEXT_JSON_OK;
+}
 
-  json_context * parent_ctx = v->ctx;
-
-  if (v->type == GTEXT_JSON_ARRAY && v->as.array.elems) {
-    for (size_t i = 0; i < v->as.array.count; i++) {
-      GTEXT_JSON_Value * child = v->as.array.elems[i];
-      if (child) {
-        if (child->ctx && child->ctx != parent_ctx) {
-          // Child has different context - save context before freeing
-          json_context * child_ctx = child->ctx;
-          // Recursively free child's children first (to find nested values with
-          // different contexts)
-          json_free_children_recursive(child);
-          // Now free the child's context (this frees the child value structure
-          // itself)
-          json_context_free(child_ctx);
-        }
-        else {
-          // Child has same context - still need to recurse to find nested
-          // values with different contexts
-          json_free_children_recursive(child);
-        }
-      }
+// Make clone hold a reference on src, whose nodes it shares
+static GTEXT_JSON_Status json_context_borrow(
+    json_context * clone, json_context * src) {
+  GTEXT_JSON_Status status = json_context_links_reserve(
+      &clone->borrowed, clone->borrowed_count, &clone->borrowed_capacity);
+  if (status == GTEXT_JSON_OK) {
+    status = json_context_links_reserve(
+        &src->clones, src->clones_count, &src->clones_capacity);
+  }
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
+  clone->borrowed[clone->borrowed_count] =
+      (json_context_link){src, src->clones_count};
+  src->clones[src->clones_count] =
+      (json_context_link){clone, clone->borrowed_count};
+  clone->borrowed_count++;
+  src->clones_count++;
+  src->refcount++;
+  return GTEXT_JSON_OK;
+}
+
+// Remove the owned entry at slot, moving the last entry into its place
+static void json_context_remove_owned(json_context * ctx, size_t slot) {
+  json_context * moved = ctx->owned[--ctx->owned_count];
+  ctx->owned[slot] = moved;
+  if (moved->owner == ctx && moved->owner_slot == ctx->owned_count) {
+    moved->owner_slot = slot;
+  }
+}
+
+// Remove one entry for child from ctx's owned list without releasing it
+// A child attached to a single container is found in O(1) through its owner
+// slot; the list is only searched for contexts recorded more than once.
+// Returns: true if an entry was found
+static bool json_context_disown(json_context * ctx, json_context * child) {
+  if (child->owner == ctx && child->owner_slot < ctx->owned_count &&
+      ctx->owned[child->owner_slot] == child) {
+    json_context_remove_owned(ctx, child->owner_slot);
+    child->owner = NULL;
+    return true;
+  }
+  for (size_t i = ctx->owned_count; i > 0; i--) {
+    if (ctx->owned[i - 1] == child) {
+      json_context_remove_owned(ctx, i - 1);
+      return true;
     }
   }
-  else if (v->type == GTEXT_JSON_OBJECT && v->as.object.pairs) {
-    for (size_t i = 0; i < v->as.object.count; i++) {
-      GTEXT_JSON_Value * child = v->as.object.pairs[i].value;
-      if (child) {
-        if (child->ctx && child->ctx != parent_ctx) {
-          // Child has different context - save context before freeing
-          json_context * child_ctx = child->ctx;
-          // Recursively free child's children first (to find nested values with
-          // different contexts)
-          json_free_children_recursive(child);
-          // Now free the child's context (this frees the child value structure
-          // itself)
-          json_context_free(child_ctx);
-        }
-        else {
-          // Child has same context - still need to recurse to find nested
-          // values with different contexts
-          json_free_children_recursive(child);
-        }
-      }
+  return false;
+}
+
+// Check whether ctx is top or is attached (directly or through other
+// attached contexts) under it
+// Costs one step per level of attachment, however many contexts exist.
+static bool json_context_in_tree(
+    const json_context * ctx, const json_context * top) {
+  for (; ctx; ctx = ctx->owner) {
+    if (ctx == top) {
+      return true;
     }
   }
+  return false;
 }
 
 GTEXT_API void gtext_json_free(GTEXT_JSON_Value * v) {
@@ -239,12 +363,9 @@ GTEXT_API void gtext_json_free(GTEXT_JSON_Value * v) {
     return;
   }
 
-  // First, recursively free any children that have different contexts
-  json_free_children_recursive(v);
-
-  // Then free this value's context, which frees the arena and all memory
-  json_context * ctx = v->ctx;
-  json_context_free(ctx);
+  // Releasing the tree's context also releases every context attached to it,
+  // so no traversal of the tree is needed
+  json_context_free(v->ctx);
 }
 
 // Alignment for GTEXT_JSON_Value (align to pointer size, typically 8 bytes)
@@ -264,6 +385,7 @@ static GTEXT_JSON_Value * json_value_new_with_context(
   }
 
   val->type = type;
+  val->cow = 0;
   val->ctx = ctx;
   memset(&val->as, 0, sizeof(val->as));
 
@@ -605,6 +727,10 @@ GTEXT_API GTEXT_JSON_Status gtext_json_get_i64(
   if (v->type != GTEXT_JSON_NUMBER) {
     return GTEXT_JSON_E_INVALID;
   }
+  GTEXT_JSON_Status status = json_number_resolve(v);
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
   if (!v->as.number.has_i64) {
     return GTEXT_JSON_E_INVALID;
   }
@@ -620,6 +746,10 @@ GTEXT_API GTEXT_JSON_Status gtext_json_get_u64(
   if (v->type != GTEXT_JSON_NUMBER) {
     return GTEXT_JSON_E_INVALID;
   }
+  GTEXT_JSON_Status status = json_number_resolve(v);
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
   if (!v->as.number.has_u64) {
     return GTEXT_JSON_E_INVALID;
   }
@@ -635,6 +765,10 @@ GTEXT_API GTEXT_JSON_Status gtext_json_get_double(
   if (v->type != GTEXT_JSON_NUMBER) {
     return GTEXT_JSON_E_INVALID;
   }
+  GTEXT_JSON_Status status = json_number_resolve(v);
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
   if (!v->as.number.has_dbl) {
     return GTEXT_JSON_E_INVALID;
   }
@@ -832,6 +966,316 @@ GTEXT_JSON_Status json_object_add_pair(GTEXT_JSON_Value * object,
   return GTEXT_JSON_OK;
 }
 
+// Copy-on-write support
+
+// Copy a container's borrowed element/pair array into its own arena (sized
+// to the current count; it grows again on demand)
+// Object keys are copied too, so that a node of a clone never refers to the
+// source's arena except through borrowed children and flagged arrays.
+static GTEXT_JSON_Status json_value_copy_storage(GTEXT_JSON_Value * v) {
+  if (!(v->cow & JSON_VALUE_SHARED_STORAGE)) {
+    return GTEXT_JSON_OK;
+  }
+
+  if (v->type == GTEXT_JSON_ARRAY) {
+    size_t count = v->as.array.count;
+    GTEXT_JSON_Value ** elems = NULL;
+    if (count > 0) {
+      if (count > SIZE_MAX / sizeof(GTEXT_JSON_Value *)) {
+        return GTEXT_JSON_E_LIMIT;
+      }
+      elems = (GTEXT_JSON_Value **)json_arena_alloc(v->ctx->arena,
+          count * sizeof(GTEXT_JSON_Value *), sizeof(void *));
+      if (!elems) {
+        return GTEXT_JSON_E_OOM;
+      }
+      memcpy(elems, v->as.array.elems, count * sizeof(GTEXT_JSON_Value *));
+    }
+    v->as.array.elems = elems;
+    v->as.array.capacity = count;
+  }
+  else if (v->type == GTEXT_JSON_OBJECT) {
+    size_t count = v->as.object.count;
+    size_t pair_size = sizeof(*(v->as.object.pairs));
+    void * pairs = NULL;
+    if (count > 0) {
+      if (count > SIZE_MAX / pair_size) {
+        return GTEXT_JSON_E_LIMIT;
+      }
+      pairs =
+          json_arena_alloc(v->ctx->arena, count * pair_size, sizeof(void *));
+      if (!pairs) {
+        return GTEXT_JSON_E_OOM;
+      }
+      memcpy(pairs, v->as.object.pairs, count * pair_size);
+    }
+    v->as.object.pairs = pairs;
+    v->as.object.capacity = count;
+    // On failure the array stays flagged, so the keys are copied again later
+    for (size_t i = 0; i < count; i++) {
+      size_t key_len = v->as.object.pairs[i].key_len;
+      char * key = (char *)json_arena_alloc(v->ctx->arena, key_len + 1, 1);
+      if (!key) {
+        return GTEXT_JSON_E_OOM;
+      }
+      memcpy(key, v->as.object.pairs[i].key, key_len);
+      key[key_len] = '\0';
+      v->as.object.pairs[i].key = key;
+    }
+  }
+
+  v->cow &= (unsigned char)~JSON_VALUE_SHARED_STORAGE;
+  return GTEXT_JSON_OK;
+}
+
+static GTEXT_JSON_Status json_context_release_clones(json_context * ctx);
+
+// Copy the child in slot if it is borrowed, or the borrowed parts of it if
+// it belongs to parent's context
+// Values attached from other contexts borrow nothing through parent; clones
+// among them are released separately.
+static GTEXT_JSON_Status json_value_copy_borrowed(
+    GTEXT_JSON_Value * parent, GTEXT_JSON_Value ** slot);
+
+// Copy everything a node of a clone still borrows into the clone's arena
+static GTEXT_JSON_Status json_value_copy_borrowed_children(
+    GTEXT_JSON_Value * v) {
+  GTEXT_JSON_Status status = json_value_copy_storage(v);
+  if (v->type == GTEXT_JSON_ARRAY) {
+    for (size_t i = 0; status == GTEXT_JSON_OK && i < v->as.array.count; i++) {
+      status = json_value_copy_borrowed(v, &v->as.array.elems[i]);
+    }
+  }
+  else if (v->type == GTEXT_JSON_OBJECT) {
+    for (size_t i = 0; status == GTEXT_JSON_OK && i < v->as.object.count;
+        i++) {
+      status = json_value_copy_borrowed(v, &v->as.object.pairs[i].value);
+    }
+  }
+  return status;
+}
+
+static GTEXT_JSON_Status json_value_copy_borrowed(
+    GTEXT_JSON_Value * parent, GTEXT_JSON_Value ** slot) {
+  GTEXT_JSON_Value * child = *slot;
+  if (child->ctx == parent->ctx) {
+    return json_value_copy_borrowed_children(child);
+  }
+  if (json_context_in_tree(child->ctx, parent->ctx)) {
+    return GTEXT_JSON_OK;
+  }
+  GTEXT_JSON_Value * copy = json_value_clone(child, parent->ctx);
+  if (!copy) {
+    return GTEXT_JSON_E_OOM;
+  }
+  *slot = copy;
+  return GTEXT_JSON_OK;
+}
+
+// Make a clone stop borrowing, by copying the nodes it still shares
+// Clones of this clone (and of the trees it is attached under) are released
+// first, since they can reach the same borrowed nodes through its arrays.
+// The clone is unlinked from its sources while this runs, so the recursion
+// cannot come back to it.
+static GTEXT_JSON_Status json_context_detach_clone(json_context * clone) {
+  // Releasing the clones of this clone may drop the last other reference
+  clone->refcount++;
+  json_context_unlink_borrowed(clone);
+
+  GTEXT_JSON_Status status = json_context_release_clones(clone);
+  if (status == GTEXT_JSON_OK) {
+    status = json_value_copy_borrowed_children(clone->root);
+  }
+  if (status == GTEXT_JSON_OK) {
+    json_context_drop_borrowed(clone);
+  }
+  else {
+    json_context_relink_borrowed(clone);
+  }
+
+  json_context_free(clone);
+  return status;
+}
+
+// Make every clone borrowing from ctx, or from a context ctx is attached
+// under, stop borrowing
+// Nothing is copied unless such a clone exists, so writes to a tree that was
+// never cloned only pay for the walk up its attached contexts.
+static GTEXT_JSON_Status json_context_release_clones(json_context * ctx) {
+  for (json_context * c = ctx; c; c = c->owner) {
+    while (c->clones_count > 0) {
+      GTEXT_JSON_Status status =
+          json_context_detach_clone(c->clones[c->clones_count - 1].ctx);
+      if (status != GTEXT_JSON_OK) {
+        return status;
+      }
+    }
+  }
+  return GTEXT_JSON_OK;
+}
+
+GTEXT_JSON_Status json_value_unshare(GTEXT_JSON_Value * v) {
+  GTEXT_JSON_Status status = json_context_release_clones(v->ctx);
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
+  return json_value_copy_storage(v);
+}
+
+GTEXT_JSON_Value * json_value_writable_child(
+    GTEXT_JSON_Value * parent, GTEXT_JSON_Value ** slot) {
+  GTEXT_JSON_Value * child = *slot;
+  if (!child || json_context_in_tree(child->ctx, parent->ctx)) {
+    return child;
+  }
+
+  // The child is borrowed. Scalars are copied outright; a container copy
+  // refers to the child's array until it is modified itself. The clone's
+  // reference on its source keeps that array alive.
+  GTEXT_JSON_Value * copy;
+  if (child->type == GTEXT_JSON_ARRAY || child->type == GTEXT_JSON_OBJECT) {
+    copy = json_value_new_with_context(child->type, parent->ctx);
+    if (!copy) {
+      return NULL;
+    }
+    copy->as = child->as;
+    copy->cow = JSON_VALUE_SHARED_STORAGE;
+  }
+  else {
+    copy = json_value_clone(child, parent->ctx);
+    if (!copy) {
+      return NULL;
+    }
+  }
+
+  *slot = copy;
+  return copy;
+}
+
+// Copy the nodes of a clone into dst_ctx, reusing the nodes it borrows
+// Nodes of the clone's context are copied one by one, so that only the
+// paths the clone modified are copied again; values attached to the clone
+// are deep-copied.
+// Returns: Node to use in dst_ctx, or NULL on allocation failure
+static GTEXT_JSON_Value * json_value_absorb(
+    GTEXT_JSON_Value * v, json_context * clone_ctx, json_context * dst_ctx) {
+  if (!json_context_in_tree(v->ctx, clone_ctx)) {
+    return v;
+  }
+  if (v->ctx != clone_ctx ||
+      (v->type != GTEXT_JSON_ARRAY && v->type != GTEXT_JSON_OBJECT)) {
+    return json_value_clone(v, dst_ctx);
+  }
+
+  GTEXT_JSON_Value * copy = json_value_new_with_context(v->type, dst_ctx);
+  if (!copy) {
+    return NULL;
+  }
+  copy->as = v->as;
+  copy->cow = v->cow;
+  if (v->cow & JSON_VALUE_SHARED_STORAGE) {
+    // The array belongs to a node the clone borrowed
+    return copy;
+  }
+
+  copy->cow |= JSON_VALUE_SHARED_STORAGE;
+  if (json_value_copy_storage(copy) != GTEXT_JSON_OK) {
+    return NULL;
+  }
+  if (copy->type == GTEXT_JSON_ARRAY) {
+    for (size_t i = 0; i < copy->as.array.count; i++) {
+      copy->as.array.elems[i] =
+          json_value_absorb(copy->as.array.elems[i], clone_ctx, dst_ctx);
+      if (!copy->as.array.elems[i]) {
+        return NULL;
+      }
+    }
+  }
+  else {
+    for (size_t i = 0; i < copy->as.object.count; i++) {
+      copy->as.object.pairs[i].value = json_value_absorb(
+          copy->as.object.pairs[i].value, clone_ctx, dst_ctx);
+      if (!copy->as.object.pairs[i].value) {
+        return NULL;
+      }
+    }
+  }
+  return copy;
+}
+
+GTEXT_JSON_Status json_value_take_content(
+    GTEXT_JSON_Value * dst, GTEXT_JSON_Value * src) {
+  json_context * src_ctx = src->ctx;
+
+  // The clone is consumed, so other clones of dst are released but it is not
+  json_context_unlink_borrowed(src_ctx);
+  GTEXT_JSON_Status status = json_context_release_clones(dst->ctx);
+  GTEXT_JSON_Value * content = NULL;
+  if (status == GTEXT_JSON_OK) {
+    content = json_value_absorb(src, src_ctx, dst->ctx);
+    if (!content) {
+      status = GTEXT_JSON_E_OOM;
+    }
+  }
+  if (status != GTEXT_JSON_OK) {
+    json_context_relink_borrowed(src_ctx);
+    return status;
+  }
+
+  dst->type = content->type;
+  dst->cow = content->cow;
+  dst->as = content->as;
+  json_context_drop_borrowed(src_ctx);
+  json_context_free(src_ctx);
+  return GTEXT_JSON_OK;
+}
+
+// Prepare a child for insertion into parent
+// A child from another context is kept alive by the parent's context. If the
+// parent is inside the child's own tree, the child is deep-copied into the
+// parent's arena instead and stays where it is, since a tree cannot contain
+// itself. (The parent must already have been passed to json_value_unshare(),
+// so no clone is still borrowing from the parent's tree and no other cycle
+// is possible.)
+// Returns: Value to insert (the child or its copy), or NULL on failure
+static GTEXT_JSON_Value * json_value_attach_begin(
+    GTEXT_JSON_Value * parent, GTEXT_JSON_Value * child) {
+  if (!child->ctx || child->ctx == parent->ctx) {
+    return child;
+  }
+  if (json_context_in_tree(parent->ctx, child->ctx)) {
+    return json_value_clone(child, parent->ctx);
+  }
+  if (json_context_adopt(parent->ctx, child->ctx) != GTEXT_JSON_OK) {
+    return NULL;
+  }
+  return child;
+}
+
+// Finish inserting a value prepared by json_value_attach_begin()
+// On failure the ownership record is rolled back so the caller still owns
+// the child.
+static void json_value_attach_end(GTEXT_JSON_Value * parent,
+    GTEXT_JSON_Value * child, GTEXT_JSON_Value * stored,
+    GTEXT_JSON_Status status) {
+  if (stored == child && status != GTEXT_JSON_OK && child->ctx &&
+      child->ctx != parent->ctx) {
+    json_context_disown(parent->ctx, child->ctx);
+  }
+}
+
+// Release a child that was removed from (or replaced in) parent
+// Only a child attached to parent's context (not one borrowed by a clone)
+// owns memory of its own.
+static void json_value_detach(
+    GTEXT_JSON_Value * parent, GTEXT_JSON_Value * child) {
+  if (child && child->ctx && child->ctx != parent->ctx &&
+      child->ctx->owner == parent->ctx &&
+      json_context_disown(parent->ctx, child->ctx)) {
+    json_context_free(child->ctx);
+  }
+}
+
 // Public mutation API functions
 
 GTEXT_API GTEXT_JSON_Status gtext_json_array_push(
@@ -840,8 +1284,19 @@ GTEXT_API GTEXT_JSON_Status gtext_json_array_push(
     return GTEXT_JSON_E_INVALID;
   }
 
+  GTEXT_JSON_Status status = json_value_unshare(arr);
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
+  GTEXT_JSON_Value * stored = json_value_attach_begin(arr, child);
+  if (!stored) {
+    return GTEXT_JSON_E_OOM;
+  }
+
   // Use the internal helper function which handles growing the array
-  return json_array_add_element(arr, child);
+  status = json_array_add_element(arr, stored);
+  json_value_attach_end(arr, child, stored, status);
+  return status;
 }
 
 GTEXT_API GTEXT_JSON_Status gtext_json_array_set(
@@ -855,40 +1310,27 @@ GTEXT_API GTEXT_JSON_Status gtext_json_array_set(
     return GTEXT_JSON_E_INVALID;
   }
 
-  // Get the old value to be replaced
-  GTEXT_JSON_Value * old_value = arr->as.array.elems[idx];
-
-  // If the old value has a different context, free it recursively
-  if (old_value && old_value->ctx && old_value->ctx != arr->ctx) {
-    json_context * child_ctx = old_value->ctx;
-    // Recursively free child's children first
-    json_free_children_recursive(old_value);
-    // Now free the child's context (this frees the child value structure
-    // itself)
-    json_context_free(child_ctx);
+  GTEXT_JSON_Status status = json_value_unshare(arr);
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
+  GTEXT_JSON_Value * stored = json_value_attach_begin(arr, child);
+  if (!stored) {
+    return GTEXT_JSON_E_OOM;
   }
+  json_value_attach_end(arr, child, stored, GTEXT_JSON_OK);
 
-  // Set element at index (replacing existing element)
-  arr->as.array.elems[idx] = child;
+  // Release the old value if it was attached from another context
+  json_value_detach(arr, arr->as.array.elems[idx]);
 
-  // Note: If child has a different context, it will be freed when
-  // gtext_json_free() is called on the root, via
-  // json_free_children_recursive(). We don't free it here because the child
-  // value structure itself is in that context's arena.
+  // Set element at index (replacing existing element)
+  arr->as.array.elems[idx] = stored;
   return GTEXT_JSON_OK;
 }
 
-GTEXT_API GTEXT_JSON_Status gtext_json_array_insert(
+// Insert an element at idx, shifting later elements right
+static GTEXT_JSON_Status json_array_insert_element(
     GTEXT_JSON_Value * arr, size_t idx, GTEXT_JSON_Value * child) {
-  if (!arr || arr->type != GTEXT_JSON_ARRAY || !child) {
-    return GTEXT_JSON_E_INVALID;
-  }
-
-  // Check bounds - allow inserting at count (same as push)
-  if (idx > arr->as.array.count) {
-    return GTEXT_JSON_E_INVALID;
-  }
-
   // If inserting at the end, use push logic
   if (idx == arr->as.array.count) {
     return json_array_add_element(arr, child);
@@ -954,6 +1396,30 @@ GTEXT_API GTEXT_JSON_Status gtext_json_array_insert(
   return GTEXT_JSON_OK;
 }
 
+GTEXT_API GTEXT_JSON_Status gtext_json_array_insert(
+    GTEXT_JSON_Value * arr, size_t idx, GTEXT_JSON_Value * child) {
+  if (!arr || arr->type != GTEXT_JSON_ARRAY || !child) {
+    return GTEXT_JSON_E_INVALID;
+  }
+
+  // Check bounds - allow inserting at count (same as push)
+  if (idx > arr->as.array.count) {
+    return GTEXT_JSON_E_INVALID;
+  }
+
+  GTEXT_JSON_Status status = json_value_unshare(arr);
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
+  GTEXT_JSON_Value * stored = json_value_attach_begin(arr, child);
+  if (!stored) {
+    return GTEXT_JSON_E_OOM;
+  }
+  status = json_array_insert_element(arr, idx, stored);
+  json_value_attach_end(arr, child, stored, status);
+  return status;
+}
+
 GTEXT_API GTEXT_JSON_Status gtext_json_array_remove(
     GTEXT_JSON_Value * arr, size_t idx) {
   if (!arr || arr->type != GTEXT_JSON_ARRAY) {
@@ -965,19 +1431,14 @@ GTEXT_API GTEXT_JSON_Status gtext_json_array_remove(
     return GTEXT_JSON_E_INVALID;
   }
 
-  // Get the value to be removed
-  GTEXT_JSON_Value * removed_value = arr->as.array.elems[idx];
-
-  // If the removed value has a different context, free it recursively
-  if (removed_value && removed_value->ctx && removed_value->ctx != arr->ctx) {
-    json_context * child_ctx = removed_value->ctx;
-    // Recursively free child's children first
-    json_free_children_recursive(removed_value);
-    // Now free the child's context (this frees the child value structure
-    // itself)
-    json_context_free(child_ctx);
+  GTEXT_JSON_Status status = json_value_unshare(arr);
+  if (status != GTEXT_JSON_OK) {
+    return status;
   }
 
+  // Release the removed value if it was attached from another context
+  json_value_detach(arr, arr->as.array.elems[idx]);
+
   // Shift elements to the left to fill the gap
   for (size_t i = idx; i + 1 < arr->as.array.count; ++i) {
     arr->as.array.elems[i] = arr->as.array.elems[i + 1];
@@ -994,32 +1455,34 @@ GTEXT_API GTEXT_JSON_Status gtext_json_object_put(GTEXT_JSON_Value * obj,
     return GTEXT_JSON_E_INVALID;
   }
 
+  GTEXT_JSON_Status status = json_value_unshare(obj);
+  if (status != GTEXT_JSON_OK) {
+    return status;
+  }
+  GTEXT_JSON_Value * stored = json_value_attach_begin(obj, val);
+  if (!stored) {
+    return GTEXT_JSON_E_OOM;
+  }
+
   // Check if key already exists - if so, replace the value
   for (size_t i = 0; i < obj->as.object.count; ++i) {
     if (obj->as.object.pairs[i].key_len == key_len) {
       if (key_len == 0 ||
           memcmp(obj->as.object.pairs[i].key, key, key_len) == 0) {
-        // Key exists - replace value
-        GTEXT_JSON_Value * old_value = obj->as.object.pairs[i].value;
-
-        // If the old value has a different context, free it recursively
-        if (old_value && old_value->ctx && old_value->ctx != obj->ctx) {
-          json_context * child_ctx = old_value->ctx;
-          // Recursively free child's children first
-          json_free_children_recursive(old_value);
-          // Now free the child's context (this frees the child value structure
-          // itself)
-          json_context_free(child_ctx);
-        }
-
-        obj->as.object.pairs[i].value = val;
+        // Key exists - replace value, releasing the old one if it was
+        // attached from another context
+        json_value_attach_end(obj, val, stored, GTEXT_JSON_OK);
+        json_value_detach(obj, obj->as.object.pairs[i].value);
+        obj->as.object.pairs[i].value = stored;
         return GTEXT_JSON_OK;
       }
     }
   }
 
   // Key doesn't exist - add new pair using internal helper
-  return json_object_add_pair(obj, key, key_len, val);
+  status = json_object_add_pair(obj, key, key_len, stored);
+  json_value_attach_end(obj, val, stored, status);
+  return status;
 }
 
 GTEXT_API GTEXT_JSON_Status gtext_json_object_remove(
@@ -1045,19 +1508,14 @@ GTEXT_API GTEXT_JSON_Status gtext_json_object_remove(
     return GTEXT_JSON_E_INVALID;
   }
 
-  // Get the value to be removed
-  GTEXT_JSON_Value * removed_value = obj->as.object.pairs[found_idx].value;
-
-  // If the removed value has a different context, free it recursively
-  if (removed_value && removed_value->ctx && removed_value->ctx != obj->ctx) {
-    json_context * child_ctx = removed_value->ctx;
-    // Recursively free child's children first
-    json_free_children_recursive(removed_value);
-    // Now free the child's context (this frees the child value structure
-    // itself)
-    json_context_free(child_ctx);
+  GTEXT_JSON_Status status = json_value_unshare(obj);
+  if (status != GTEXT_JSON_OK) {
+    return status;
   }
 
+  // Release the removed value if it was attached from another context
+  json_value_detach(obj, obj->as.object.pairs[found_idx].value);
+
   // Shift pairs to the left to fill the gap
   for (size_t i = found_idx; i + 1 < obj->as.object.count; ++i) {
     obj->as.object.pairs[i] = obj->as.object.pairs[i + 1];
@@ -1116,6 +1574,10 @@ static bool json_value_equal_internal(const GTEXT_JSON_Value * a,
     }
     else {
       // Numeric equivalence comparison
+      // Lazily parsed numbers need their representations first; if that
+      // fails, the lexeme comparison below still applies
+      json_number_resolve(a);
+      json_number_resolve(b);
       // First check if both have the same representation available
       if (a->as.number.has_i64 && b->as.number.has_i64) {
         return a->as.number.i64 == b->as.number.i64;
@@ -1221,33 +1683,45 @@ GTEXT_API bool gtext_json_equal(const GTEXT_JSON_Value * a,
   return json_value_equal_internal(a, b, mode);
 }
 
-// Helper function to deep clone a value into a new context
-static GTEXT_JSON_Value * json_value_clone_into_new_context(
-    const GTEXT_JSON_Value * src) {
-  if (!src) {
+// Clone a value in O(1) by sharing its nodes (copy-on-write)
+// A container's clone is a new root, in a new context that borrows the
+// source's context. Nested nodes are copied only when a mutation of the clone
+// reaches them, or all at once if the source is modified first. Scalars are
+// simply copied.
+GTEXT_API GTEXT_JSON_Value * gtext_json_clone(const GTEXT_JSON_Value * src) {
+  if (!src || !src->ctx) {
     return NULL;
   }
 
-  // Create a new context for the clone
   json_context * new_ctx = json_context_new();
   if (!new_ctx) {
     return NULL;
   }
-
-  // Use the existing clone function but with the new context
-  GTEXT_JSON_Value * dst = json_value_clone(src, new_ctx);
+  json_context_set_input_buffer(
+      new_ctx, src->ctx->input_buffer, src->ctx->input_buffer_len);
+
+  GTEXT_JSON_Value * dst;
+  if (src->type == GTEXT_JSON_ARRAY || src->type == GTEXT_JSON_OBJECT) {
+    dst = json_value_new_with_context(src->type, new_ctx);
+    if (dst) {
+      dst->as = src->as;
+      dst->cow = JSON_VALUE_SHARED_STORAGE;
+      new_ctx->root = dst;
+      if (json_context_borrow(new_ctx, src->ctx) != GTEXT_JSON_OK) {
+        dst = NULL;
+      }
+    }
+  }
+  else {
+    dst = json_value_clone(src, new_ctx);
+  }
   if (!dst) {
     json_context_free(new_ctx);
     return NULL;
   }
-
   return dst;
 }
 
-GTEXT_API GTEXT_JSON_Value * gtext_json_clone(const GTEXT_JSON_Value * src) {
-  return json_value_clone_into_new_context(src);
-}
-
 GTEXT_API GTEXT_JSON_Status gtext_json_object_merge(GTEXT_JSON_Value * target,
     const GTEXT_JSON_Value * source, GTEXT_JSON_Merge_Policy policy) {
   if (!target || target->type != GTEXT_JSON_OBJECT) {
@@ -1257,6 +1731,11 @@ GTEXT_API GTEXT_JSON_Status gtext_json_object_merge(GTEXT_JSON_Value * target,
     return GTEXT_JSON_E_INVALID;
   }
 
+  GTEXT_JSON_Status unshare_status = json_value_unshare(target);
+  if (unshare_status != GTEXT_JSON_OK) {
+    return unshare_status;
+  }
+
   // Iterate through all pairs in source
   for (size_t i = 0; i < source->as.object.count; i++) {
     const char * key = source->as.object.pairs[i].key;
@@ -1280,8 +1759,13 @@ GTEXT_API GTEXT_JSON_Status gtext_json_object_merge(GTEXT_JSON_Value * target,
           if (target->as.object.pairs[j].value != NULL &&
               target->as.object.pairs[j].value->type == GTEXT_JSON_OBJECT &&
               source_val != NULL && source_val->type == GTEXT_JSON_OBJECT) {
-            GTEXT_JSON_Status status = gtext_json_object_merge(
-                target->as.object.pairs[j].value, source_val, policy);
+            GTEXT_JSON_Value * nested = json_value_writable_child(
+                target, &target->as.object.pairs[j].value);
+            if (!nested) {
+              return GTEXT_JSON_E_OOM;
+            }
+            GTEXT_JSON_Status status =
+                gtext_json_object_merge(nested, source_val, policy);
             if (status != GTEXT_JSON_OK) {
               return status;
             }
@@ -1295,13 +1779,8 @@ GTEXT_API GTEXT_JSON_Status gtext_json_object_merge(GTEXT_JSON_Value * target,
               if (!cloned_val) {
                 return GTEXT_JSON_E_OOM;
               }
-              // Free old value if it has different context
-              GTEXT_JSON_Value * old_val = target->as.object.pairs[j].value;
-              if (old_val && old_val->ctx && old_val->ctx != target->ctx) {
-                json_context * old_ctx = old_val->ctx;
-                json_free_children_recursive(old_val);
-                json_context_free(old_ctx);
-              }
+              // Release old value if it was attached from another context
+              json_value_detach(target, target->as.object.pairs[j].value);
               target->as.object.pairs[j].value = cloned_val;
             }
             // For FIRST_WINS, do nothing (keep existing value)
@@ -109,22 +109,25 @@ typedef enum {
  * indicating which representations are valid.
  *
  * This is a temporary parsing structure used internally. When the lexeme
- * is preserved (via preserve_number_lexeme option), memory is allocated
- * with malloc() and must be freed using json_number_destroy().
+ * is preserved (via the preserve_number_lexeme or lazy_numbers options), it
+ * points into the input passed to json_parse_number() and is not
+ * NUL-terminated; it is only valid while that input is.
  *
  * Note: This structure is separate from GTEXT_JSON_Value.as.number which
  * uses arena allocation and is automatically cleaned up via gtext_json_free().
- * When converting from json_number to GTEXT_JSON_Value, the data should
- * be copied into the arena and json_number_destroy() should be called
- * to free the temporary structure.
+ * When converting from json_number to GTEXT_JSON_Value, the lexeme should
+ * be copied into the arena (or referenced in-situ) and json_number_destroy()
+ * should be called to reset the temporary structure.
  */
 typedef struct {
-  char * lexeme;      ///< Original number lexeme (allocated with malloc)
-  size_t lexeme_len;  ///< Length of lexeme
-  int64_t i64;        ///< int64 representation
-  uint64_t u64;       ///< uint64 representation
-  double dbl;         ///< double representation
-  unsigned int flags; ///< Flags indicating valid representations
+  const char * lexeme; ///< Original number lexeme (span of the input)
+  size_t lexeme_len;   ///< Length of lexeme
+  int64_t i64;         ///< int64 representation
+  uint64_t u64;        ///< uint64 representation
+  double dbl;          ///< double representation
+  unsigned int flags;  ///< Flags indicating valid representations
+  unsigned int lazy;   ///< Representations deferred until first access
+                       ///< (lazy_numbers option), as json_number_flags bits
 } json_number;
 
 /**
@@ -153,11 +156,11 @@ GTEXT_INTERNAL_API GTEXT_JSON_Status json_parse_number(const char * input,
     const GTEXT_JSON_Parse_Options * opts);
 
 /**
- * @brief Free resources allocated by json_parse_number()
+ * @brief Release a json_number filled in by json_parse_number()
  *
- * This function frees the lexeme string allocated by json_parse_number()
- * when preserve_number_lexeme was enabled. It should be called when a
- * json_number structure is no longer needed to prevent memory leaks.
+ * The lexeme is borrowed from the parsed input, so nothing is freed; this
+ * clears it so the structure no longer refers to the input. It should be
+ * called when a json_number structure is no longer needed.
  *
  * **When to call:**
  * - After using json_parse_number() standalone (not converting to
@@ -180,6 +183,26 @@ GTEXT_INTERNAL_API GTEXT_JSON_Status json_parse_number(const char * input,
  */
 GTEXT_INTERNAL_API void json_number_destroy(json_number * num);
 
+/**
+ * @brief Derive deferred numeric representations of a DOM number
+ *
+ * Numbers parsed with the lazy_numbers option carry only their lexeme; the
+ * representations requested at parse time are recorded in
+ * @c as.number.lazy. This function converts the lexeme, fills in the
+ * i64/u64/dbl fields, and clears the pending set so later calls are free.
+ * Every reader of the numeric fields must call it first.
+ *
+ * The result is cached inside @p v even though it is passed as const, so
+ * the first access to a lazy number must not race with another reader.
+ *
+ * @param v JSON value (may be NULL or a non-number, in which case this is a
+ *   no-op)
+ * @return GTEXT_JSON_OK, or GTEXT_JSON_E_OOM if a temporary conversion
+ *   buffer could not be allocated (the value is left pending)
+ */
+GTEXT_INTERNAL_API GTEXT_JSON_Status json_number_resolve(
+    const GTEXT_JSON_Value * v);
+
 /**
  * @brief JSON token types
  */
@@ -277,8 +300,9 @@ GTEXT_JSON_Status json_lexer_next(json_lexer * lexer, json_token * token);
 /**
  * @brief Clean up resources allocated by a token
  *
- * Frees any memory allocated for token data (string values,
- * number lexemes). Should be called after processing a token.
+ * Frees any memory allocated for token data (string values) and clears
+ * number lexemes, which point into the lexer input. Should be called after
+ * processing a token.
  *
  * @param token Token to clean up
  */
@@ -315,20 +339,71 @@ typedef struct json_arena {
   size_t block_size;          ///< Size of each new block
 } json_arena;
 
+struct json_context;
+
+// Link between a copy-on-write clone's context and the context it borrows
+// nodes from. Each side records the index of the matching link on the other
+// side, so either can be removed in O(1).
+typedef struct {
+  struct json_context * ctx; ///< Context at the other end of the link
+  size_t slot;               ///< Index of the matching link in ctx
+} json_context_link;
+
 // JSON context structure
 // Holds the arena allocator and other context information
 // for a JSON DOM tree.
+//
+// Contexts are reference counted. A context is released by its tree's owner
+// (gtext_json_free()), by the context its value was attached to, and by every
+// clone borrowing its nodes. Attached contexts form a tree through owner, so
+// the contexts a node belongs to are found by walking up from its own.
+//
+// A clone borrows the source's nodes until the source is modified. Before a
+// node is modified, every clone borrowing from its context or from a context
+// it is attached under copies what it still borrows (see
+// json_value_unshare()), so a clone never observes later changes to the
+// source and the source is always modified in place.
 typedef struct json_context {
   json_arena * arena; ///< Arena allocator for this DOM
   const char *
       input_buffer; ///< Original input buffer (for in-situ mode, caller-owned)
   size_t input_buffer_len; ///< Length of input buffer (for in-situ mode)
+  size_t refcount;         ///< References held on this context
+  struct json_context ** owned; ///< Contexts of values attached to this tree
+  size_t owned_count;           ///< Number of entries in owned
+  size_t owned_capacity;        ///< Allocated capacity of owned
+  struct json_context * owner;  ///< Context this one is attached to, or NULL
+  size_t owner_slot;            ///< Index of this context in owner->owned
+  struct GTEXT_JSON_Value * root; ///< Root of a clone (NULL otherwise)
+  json_context_link * borrowed;   ///< Contexts whose nodes the clone shares
+  size_t borrowed_count;          ///< Number of entries in borrowed
+  size_t borrowed_capacity;       ///< Allocated capacity of borrowed
+  json_context_link * clones;     ///< Clones sharing this context's nodes
+  size_t clones_count;            ///< Number of entries in clones
+  size_t clones_capacity;         ///< Allocated capacity of clones
 } json_context;
 
+/**
+ * @brief Copy-on-write flags for GTEXT_JSON_Value
+ *
+ * gtext_json_clone() shares the source's nodes instead of copying them. On
+ * the clone's side, a borrowed node or element array is copied the first
+ * time it would be modified, so a mutation only copies the path from the
+ * root to the modified node. Borrowed nodes themselves are never flagged: a
+ * child belongs to the clone only if its context is the clone's or is
+ * attached under it.
+ */
+typedef enum {
+  JSON_VALUE_SHARED_STORAGE = 1 ///< Element/pair array belongs to another
+                                ///< node and must be copied before it is
+                                ///< modified
+} json_value_cow_flags;
+
 // Internal structure definition for GTEXT_JSON_Value
 // This is needed by the parser to manipulate arrays and objects
 struct GTEXT_JSON_Value {
   GTEXT_JSON_Type type; ///< Type of this value
+  unsigned char cow;    ///< Copy-on-write state (json_value_cow_flags)
   json_context * ctx;   ///< Context (arena) for this value tree
 
   union {
@@ -352,7 +427,10 @@ struct GTEXT_JSON_Value {
       int has_i64;    ///< 1 if i64 is valid
       int has_u64;    ///< 1 if u64 is valid
       int has_dbl;    ///< 1 if dbl is valid
-    } number;         ///< For GTEXT_JSON_NUMBER
+      unsigned int lazy; ///< Representations still to be derived from the
+                         ///< lexeme (json_number_flags bits, see
+                         ///< json_number_resolve())
+    } number;            ///< For GTEXT_JSON_NUMBER
     struct {
       GTEXT_JSON_Value ** elems; ///< Array of value pointers
       size_t count;              ///< Number of elements
@@ -421,16 +499,63 @@ void json_context_set_input_buffer(
     json_context * ctx, const char * input_buffer, size_t input_buffer_len);
 
 /**
- * @brief Free a JSON context and its arena
+ * @brief Release a reference to a JSON context
  *
- * Internal function for freeing a context and its associated arena.
- * Used by patch implementation for cleanup.
+ * Drops one reference. When the last reference is dropped, the contexts it
+ * keeps alive are released in turn and the context and its arena are freed.
+ * A newly created context holds a single reference, so for a context that
+ * was never shared this frees it immediately.
  * Note: The input buffer (if set) is caller-owned and is NOT freed here.
  *
- * @param ctx Context to free (can be NULL)
+ * @param ctx Context to release (can be NULL)
  */
 void json_context_free(json_context * ctx);
 
+/**
+ * @brief Make a container's element/pair array exclusive before writing
+ *
+ * Clones still borrowing nodes from the value's context (or a context it is
+ * attached under) first copy what they borrow, so they are unaffected by the
+ * write. Then, if the array itself is borrowed from another node, it is
+ * copied into the value's own arena. Every function that modifies a
+ * container's elements must call this first.
+ *
+ * @param v Value to prepare (non-containers are left unchanged)
+ * @return GTEXT_JSON_OK, or GTEXT_JSON_E_OOM if the copy failed
+ */
+GTEXT_JSON_Status json_value_unshare(GTEXT_JSON_Value * v);
+
+/**
+ * @brief Get a modifiable child of a container
+ *
+ * If the child in @p slot is borrowed by a copy-on-write clone, a private
+ * copy is made in the parent's arena and stored in @p slot. The parent's
+ * element/pair array must already be exclusive (see json_value_unshare()).
+ *
+ * @param parent Container holding the child
+ * @param slot Pointer to the child pointer inside the parent
+ * @return Modifiable child, or NULL on allocation failure
+ */
+GTEXT_JSON_Value * json_value_writable_child(
+    GTEXT_JSON_Value * parent, GTEXT_JSON_Value ** slot);
+
+/**
+ * @brief Replace a value's content with that of a copy-on-write clone
+ *
+ * Used to commit a staged patch: @p dst takes over the (already modified)
+ * content of a clone of @p dst. Only the nodes the clone copied are copied
+ * again, into @p dst's arena; the nodes it still borrows are reused. On
+ * success the clone is freed, so @p dst's context does not grow a reference
+ * per commit. @p src must be a root returned by gtext_json_clone() and must
+ * not be used afterwards if this succeeds.
+ *
+ * @param dst Value to update
+ * @param src Clone whose content is taken
+ * @return GTEXT_JSON_OK, or GTEXT_JSON_E_OOM
+ */
+GTEXT_JSON_Status json_value_take_content(
+    GTEXT_JSON_Value * dst, GTEXT_JSON_Value * src);
+
 /**
  * @brief Add an element to a JSON array
  *
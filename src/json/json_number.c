@@ -235,6 +235,76 @@ static int json_parse_int64(const char * input, size_t len, int64_t * out_i64) {
   return 1;
 }
 
+// Lexemes up to this length are converted by strtod() from a stack copy
+#define JSON_NUMBER_STACK_LEXEME 64
+
+// Derive the representations selected by reps (json_number_flags bits) from a
+// syntactically valid, finite number lexeme
+static GTEXT_JSON_Status json_number_convert(const char * input,
+    size_t input_len, unsigned int reps, int allow_nonfinite,
+    json_number * num) {
+  // Parse int64 if requested
+  if (reps & JSON_NUMBER_HAS_I64) {
+    int64_t i64_val;
+    if (json_parse_int64(input, input_len, &i64_val)) {
+      num->i64 = i64_val;
+      num->flags |= JSON_NUMBER_HAS_I64;
+    }
+  }
+
+  // Parse uint64 if requested (only for non-negative numbers)
+  if ((reps & JSON_NUMBER_HAS_U64) && input[0] != '-') {
+    uint64_t u64_val;
+    if (json_parse_uint64(input, input_len, &u64_val)) {
+      num->u64 = u64_val;
+      num->flags |= JSON_NUMBER_HAS_U64;
+    }
+  }
+
+  // Parse double using strtod
+  if (reps & JSON_NUMBER_HAS_DOUBLE) {
+    // Create null-terminated string for strtod; typical numbers fit on the
+    // stack, so only very long lexemes need a heap copy
+    char stack_buf[JSON_NUMBER_STACK_LEXEME];
+    char * strtod_input = stack_buf;
+    if (input_len >= sizeof(stack_buf)) {
+      // Check for integer overflow
+      if (input_len > SIZE_MAX - 1) {
+        return GTEXT_JSON_E_LIMIT;
+      }
+      strtod_input = malloc(input_len + 1);
+      if (!strtod_input) {
+        return GTEXT_JSON_E_OOM;
+      }
+    }
+    memcpy(strtod_input, input, input_len);
+    strtod_input[input_len] = '\0';
+
+    char * endptr;
+    errno = 0;
+    double dbl_val = strtod(strtod_input, &endptr);
+
+    // Check if entire string was consumed
+    if (endptr == strtod_input + input_len && errno == 0) {
+      // Check for nonfinite numbers (if not already handled)
+      if (!isnan(dbl_val) && !isinf(dbl_val)) {
+        num->dbl = dbl_val;
+        num->flags |= JSON_NUMBER_HAS_DOUBLE;
+      }
+      else if (allow_nonfinite) {
+        num->dbl = dbl_val;
+        num->flags |= JSON_NUMBER_HAS_DOUBLE | JSON_NUMBER_IS_NONFINITE;
+      }
+    }
+
+    if (strtod_input != stack_buf) {
+      free(strtod_input);
+    }
+  }
+
+  return GTEXT_JSON_OK;
+}
+
 GTEXT_INTERNAL_API GTEXT_JSON_Status json_parse_number(const char * input,
     size_t input_len, json_number * num, json_position * pos,
     const GTEXT_JSON_Parse_Options * opts) {
@@ -257,17 +327,8 @@ GTEXT_INTERNAL_API GTEXT_JSON_Status json_parse_number(const char * input,
       return GTEXT_JSON_E_NONFINITE;
     }
     // Non-finite numbers allowed - preserve lexeme if requested
-    if (opts->preserve_number_lexeme) {
-      // Check for integer overflow
-      if (input_len > SIZE_MAX - 1) {
-        return GTEXT_JSON_E_LIMIT;
-      }
-      num->lexeme = malloc(input_len + 1);
-      if (!num->lexeme) {
-        return GTEXT_JSON_E_OOM;
-      }
-      memcpy(num->lexeme, input, input_len);
-      num->lexeme[input_len] = '\0';
+    if (opts->preserve_number_lexeme || opts->lazy_numbers) {
+      num->lexeme = input;
       num->lexeme_len = input_len;
       num->flags |= JSON_NUMBER_HAS_LEXEME;
     }
@@ -279,82 +340,32 @@ GTEXT_INTERNAL_API GTEXT_JSON_Status json_parse_number(const char * input,
     return GTEXT_JSON_E_BAD_NUMBER;
   }
 
-  // Preserve lexeme if requested
-  if (opts && opts->preserve_number_lexeme) {
-    // Check for integer overflow
-    if (input_len > SIZE_MAX - 1) {
-      return GTEXT_JSON_E_LIMIT;
-    }
-    num->lexeme = malloc(input_len + 1);
-    if (!num->lexeme) {
-      return GTEXT_JSON_E_OOM;
-    }
-    memcpy(num->lexeme, input, input_len);
-    num->lexeme[input_len] = '\0';
+  // Preserve lexeme if requested (lazy numbers are derived from it later).
+  // The lexeme is a span of the input; whoever keeps it copies it.
+  if (opts && (opts->preserve_number_lexeme || opts->lazy_numbers)) {
+    num->lexeme = input;
     num->lexeme_len = input_len;
     num->flags |= JSON_NUMBER_HAS_LEXEME;
   }
 
-  // Parse int64 if requested
-  if (opts && opts->parse_int64) {
-    int64_t i64_val;
-    if (json_parse_int64(input, input_len, &i64_val)) {
-      num->i64 = i64_val;
-      num->flags |= JSON_NUMBER_HAS_I64;
-    }
+  unsigned int reps = 0;
+  if (opts) {
+    reps |= opts->parse_int64 ? JSON_NUMBER_HAS_I64 : 0;
+    reps |= opts->parse_uint64 ? JSON_NUMBER_HAS_U64 : 0;
+    reps |= opts->parse_double ? JSON_NUMBER_HAS_DOUBLE : 0;
   }
 
-  // Parse uint64 if requested (only for non-negative numbers)
-  if (opts && opts->parse_uint64 && input[0] != '-') {
-    uint64_t u64_val;
-    if (json_parse_uint64(input, input_len, &u64_val)) {
-      num->u64 = u64_val;
-      num->flags |= JSON_NUMBER_HAS_U64;
-    }
+  if (opts && opts->lazy_numbers) {
+    // Defer conversion until the value is read (see json_number_resolve())
+    num->lazy = reps;
   }
-
-  // Parse double using strtod
-  if (opts && opts->parse_double) {
-    // Create null-terminated string for strtod
-    // Check for integer overflow
-    if (input_len > SIZE_MAX - 1) {
-      // Clean up lexeme if allocated
-      if (num->lexeme) {
-        free(num->lexeme);
-        num->lexeme = NULL;
-      }
-      return GTEXT_JSON_E_LIMIT;
-    }
-    char * strtod_input = malloc(input_len + 1);
-    if (!strtod_input) {
-      // Clean up lexeme if allocated
-      if (num->lexeme) {
-        free(num->lexeme);
-        num->lexeme = NULL;
-      }
-      return GTEXT_JSON_E_OOM;
-    }
-    memcpy(strtod_input, input, input_len);
-    strtod_input[input_len] = '\0';
-
-    char * endptr;
-    errno = 0;
-    double dbl_val = strtod(strtod_input, &endptr);
-
-    // Check if entire string was consumed
-    if (endptr == strtod_input + input_len && errno == 0) {
-      // Check for nonfinite numbers (if not already handled)
-      if (!isnan(dbl_val) && !isinf(dbl_val)) {
-        num->dbl = dbl_val;
-        num->flags |= JSON_NUMBER_HAS_DOUBLE;
-      }
-      else if (opts && opts->allow_nonfinite_numbers) {
-        num->dbl = dbl_val;
-        num->flags |= JSON_NUMBER_HAS_DOUBLE | JSON_NUMBER_IS_NONFINITE;
-      }
+  else {
+    GTEXT_JSON_Status status = json_number_convert(
+        input, input_len, reps, opts && opts->allow_nonfinite_numbers, num);
+    if (status != GTEXT_JSON_OK) {
+      json_number_destroy(num);
+      return status;
     }
-
-    free(strtod_input);
   }
 
   // Update position if provided
@@ -367,14 +378,48 @@ GTEXT_INTERNAL_API GTEXT_JSON_Status json_parse_number(const char * input,
   return GTEXT_JSON_OK;
 }
 
+GTEXT_INTERNAL_API GTEXT_JSON_Status json_number_resolve(
+    const GTEXT_JSON_Value * v) {
+  if (!v || v->type != GTEXT_JSON_NUMBER || !v->as.number.lazy) {
+    return GTEXT_JSON_OK;
+  }
+
+  // The cached representations are logically part of the value, so filling
+  // them in does not change what a const reader observes
+  GTEXT_JSON_Value * mv = (GTEXT_JSON_Value *)v;
+  json_number num;
+  memset(&num, 0, sizeof(num));
+  if (mv->as.number.lexeme && mv->as.number.lexeme_len > 0) {
+    GTEXT_JSON_Status status = json_number_convert(mv->as.number.lexeme,
+        mv->as.number.lexeme_len, mv->as.number.lazy, 0, &num);
+    if (status != GTEXT_JSON_OK) {
+      return status;
+    }
+  }
+
+  if (num.flags & JSON_NUMBER_HAS_I64) {
+    mv->as.number.i64 = num.i64;
+    mv->as.number.has_i64 = 1;
+  }
+  if (num.flags & JSON_NUMBER_HAS_U64) {
+    mv->as.number.u64 = num.u64;
+    mv->as.number.has_u64 = 1;
+  }
+  if (num.flags & JSON_NUMBER_HAS_DOUBLE) {
+    mv->as.number.dbl = num.dbl;
+    mv->as.number.has_dbl = 1;
+  }
+  mv->as.number.lazy = 0;
+  return GTEXT_JSON_OK;
+}
+
 GTEXT_INTERNAL_API void json_number_destroy(json_number * num) {
   if (!num) {
     return;
   }
 
-  // Free the lexeme if it was allocated
+  // The lexeme is borrowed from the input, so there is nothing to free
   if (num->lexeme) {
-    free(num->lexeme);
     num->lexeme = NULL;
     num->lexeme_len = 0;
     num->flags &= ~JSON_NUMBER_HAS_LEXEME;
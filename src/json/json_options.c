@@ -38,6 +38,7 @@ GTEXT_API GTEXT_JSON_Parse_Options gtext_json_parse_options_default(void) {
   opts.parse_uint64 = true;           // detect uint64
   opts.parse_double = true;           // derive double
   opts.allow_big_decimal = false;     // off by default
+  opts.lazy_numbers = false;          // convert eagerly by default
 
   return opts;
 }
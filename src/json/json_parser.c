@@ -297,6 +297,7 @@ static GTEXT_JSON_Status json_parse_array_element(json_parser * parser,
       element->as.number.dbl = num->dbl;
       element->as.number.has_dbl = 1;
     }
+    element->as.number.lazy = num->lazy;
 
     json_token_cleanup(token);
     break;
@@ -1333,6 +1334,7 @@ static GTEXT_JSON_Status json_parse_value(
     else {
       value->as.number.has_dbl = 0;
     }
+    value->as.number.lazy = num->lazy;
 
     // Clean up temporary number structure
     json_number_destroy(num);
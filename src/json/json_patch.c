@@ -80,6 +80,7 @@ GTEXT_JSON_Value * json_value_clone(
     dst->as.number.has_i64 = src->as.number.has_i64;
     dst->as.number.has_u64 = src->as.number.has_u64;
     dst->as.number.has_dbl = src->as.number.has_dbl;
+    dst->as.number.lazy = src->as.number.lazy;
     break;
   }
 
@@ -205,6 +206,8 @@ int json_value_equal(const GTEXT_JSON_Value * a, const GTEXT_JSON_Value * b) {
 
   case GTEXT_JSON_NUMBER: {
     // For numbers, check if they are numerically equal
+    json_number_resolve(a);
+    json_number_resolve(b);
     // First check if both have the same representation available
     if (a->as.number.has_i64 && b->as.number.has_i64) {
       return a->as.number.i64 == b->as.number.i64;
@@ -1111,206 +1114,6 @@ static GTEXT_JSON_Status json_patch_test(GTEXT_JSON_Value * root,
   return GTEXT_JSON_OK;
 }
 
-// Helper function to deep copy content from source to destination
-// This preserves the destination's context but replaces its content
-// Used for atomic patch application: apply to clone, then copy back to original
-// Note: This function allows type changes because merge patch can change the
-// target's type (e.g., object -> null, string -> object)
-static GTEXT_JSON_Status json_value_copy_content(
-    GTEXT_JSON_Value * dst, const GTEXT_JSON_Value * src) {
-  if (!dst || !src) {
-    return GTEXT_JSON_E_INVALID;
-  }
-
-  // If types differ, we need to change the type first
-  // The old content will remain in memory but won't be accessible
-  // since we're changing the type. It will be freed when the context is freed.
-  if (dst->type != src->type) {
-    dst->type = src->type;
-    // Initialize the union to a safe state based on new type
-    // This prevents accessing old type's data
-    switch (src->type) {
-    case GTEXT_JSON_NULL:
-      // Nothing to initialize
-      break;
-    case GTEXT_JSON_BOOL:
-      dst->as.boolean = 0;
-      break;
-    case GTEXT_JSON_STRING:
-      dst->as.string.data = NULL;
-      dst->as.string.len = 0;
-      break;
-    case GTEXT_JSON_NUMBER:
-      dst->as.number.lexeme = NULL;
-      dst->as.number.lexeme_len = 0;
-      dst->as.number.i64 = 0;
-      dst->as.number.u64 = 0;
-      dst->as.number.dbl = 0.0;
-      dst->as.number.has_i64 = 0;
-      dst->as.number.has_u64 = 0;
-      dst->as.number.has_dbl = 0;
-      break;
-    case GTEXT_JSON_ARRAY:
-      dst->as.array.elems = NULL;
-      dst->as.array.count = 0;
-      dst->as.array.capacity = 0;
-      break;
-    case GTEXT_JSON_OBJECT:
-      dst->as.object.pairs = NULL;
-      dst->as.object.count = 0;
-      dst->as.object.capacity = 0;
-      break;
-    }
-  }
-
-  json_context * dst_ctx = dst->ctx;
-  if (!dst_ctx) {
-    return GTEXT_JSON_E_INVALID;
-  }
-
-  switch (src->type) {
-  case GTEXT_JSON_NULL:
-    // Nothing to copy
-    break;
-
-  case GTEXT_JSON_BOOL:
-    dst->as.boolean = src->as.boolean;
-    break;
-
-  case GTEXT_JSON_STRING: {
-    // Free old string data (if any) - it's in the arena, will be freed with
-    // context Allocate and copy new string data Check for integer overflow in
-    // len + 1
-    if (src->as.string.len > SIZE_MAX - 1) {
-      return GTEXT_JSON_E_OOM; // Overflow
-    }
-    char * str_data = (char *)json_arena_alloc_for_context(
-        dst_ctx, src->as.string.len + 1, 1);
-    if (!str_data) {
-      return GTEXT_JSON_E_OOM;
-    }
-    memcpy(str_data, src->as.string.data, src->as.string.len);
-    str_data[src->as.string.len] = '\0';
-    dst->as.string.data = str_data;
-    dst->as.string.len = src->as.string.len;
-    break;
-  }
-
-  case GTEXT_JSON_NUMBER: {
-    // Allocate and copy lexeme
-    // Check for integer overflow in lexeme_len + 1
-    if (src->as.number.lexeme_len > SIZE_MAX - 1) {
-      return GTEXT_JSON_E_OOM; // Overflow
-    }
-    char * lexeme = (char *)json_arena_alloc_for_context(
-        dst_ctx, src->as.number.lexeme_len + 1, 1);
-    if (!lexeme) {
-      return GTEXT_JSON_E_OOM;
-    }
-    memcpy(lexeme, src->as.number.lexeme, src->as.number.lexeme_len);
-    lexeme[src->as.number.lexeme_len] = '\0';
-    dst->as.number.lexeme = lexeme;
-    dst->as.number.lexeme_len = src->as.number.lexeme_len;
-    dst->as.number.i64 = src->as.number.i64;
-    dst->as.number.u64 = src->as.number.u64;
-    dst->as.number.dbl = src->as.number.dbl;
-    dst->as.number.has_i64 = src->as.number.has_i64;
-    dst->as.number.has_u64 = src->as.number.has_u64;
-    dst->as.number.has_dbl = src->as.number.has_dbl;
-    break;
-  }
-
-  case GTEXT_JSON_ARRAY: {
-    // Free old array elements (they're in the arena, will be freed with
-    // context) Allocate new array
-    dst->as.array.count = 0;
-    dst->as.array.capacity = src->as.array.count;
-    if (dst->as.array.capacity > 0) {
-      // Check for integer overflow in multiplication
-      size_t elem_size = sizeof(GTEXT_JSON_Value *);
-      if (dst->as.array.capacity > SIZE_MAX / elem_size) {
-        return GTEXT_JSON_E_OOM; // Overflow
-      }
-      dst->as.array.elems =
-          (GTEXT_JSON_Value **)json_arena_alloc_for_context(dst_ctx,
-              dst->as.array.capacity * elem_size, sizeof(GTEXT_JSON_Value *));
-      if (!dst->as.array.elems) {
-        return GTEXT_JSON_E_OOM;
-      }
-    }
-    else {
-      dst->as.array.elems = NULL;
-    }
-
-    // Clone each element
-    for (size_t i = 0; i < src->as.array.count; i++) {
-      GTEXT_JSON_Value * cloned_elem =
-          json_value_clone(src->as.array.elems[i], dst_ctx);
-      if (!cloned_elem) {
-        return GTEXT_JSON_E_OOM;
-      }
-      dst->as.array.elems[i] = cloned_elem;
-      dst->as.array.count++;
-    }
-    break;
-  }
-
-  case GTEXT_JSON_OBJECT: {
-    // Free old object pairs (they're in the arena, will be freed with context)
-    // Allocate new pairs array
-    dst->as.object.count = 0;
-    dst->as.object.capacity = src->as.object.count;
-    if (dst->as.object.capacity > 0) {
-      size_t pair_size = sizeof(*(src->as.object.pairs));
-      // Check for integer overflow in multiplication
-      if (dst->as.object.capacity > SIZE_MAX / pair_size) {
-        return GTEXT_JSON_E_OOM; // Overflow
-      }
-      void * new_pairs_ptr = json_arena_alloc_for_context(
-          dst_ctx, dst->as.object.capacity * pair_size, sizeof(void *));
-      if (!new_pairs_ptr) {
-        return GTEXT_JSON_E_OOM;
-      }
-      dst->as.object.pairs = (void *)new_pairs_ptr;
-    }
-    else {
-      dst->as.object.pairs = NULL;
-    }
-
-    // Clone each key-value pair
-    for (size_t i = 0; i < src->as.object.count; i++) {
-      // Allocate and copy key
-      // Check for integer overflow in key_len + 1
-      if (src->as.object.pairs[i].key_len > SIZE_MAX - 1) {
-        return GTEXT_JSON_E_OOM; // Overflow
-      }
-      char * key = (char *)json_arena_alloc_for_context(
-          dst_ctx, src->as.object.pairs[i].key_len + 1, 1);
-      if (!key) {
-        return GTEXT_JSON_E_OOM;
-      }
-      memcpy(key, src->as.object.pairs[i].key, src->as.object.pairs[i].key_len);
-      key[src->as.object.pairs[i].key_len] = '\0';
-
-      // Clone value
-      GTEXT_JSON_Value * cloned_val =
-          json_value_clone(src->as.object.pairs[i].value, dst_ctx);
-      if (!cloned_val) {
-        return GTEXT_JSON_E_OOM;
-      }
-
-      dst->as.object.pairs[i].key = key;
-      dst->as.object.pairs[i].key_len = src->as.object.pairs[i].key_len;
-      dst->as.object.pairs[i].value = cloned_val;
-      dst->as.object.count++;
-    }
-    break;
-  }
-  }
-
-  return GTEXT_JSON_OK;
-}
-
 // Main patch apply function
 // Implements true atomicity: applies all operations to a clone,
 // then replaces the original only if all operations succeed
@@ -1334,19 +1137,11 @@ GTEXT_API GTEXT_JSON_Status gtext_json_patch_apply(GTEXT_JSON_Value * root,
   }
 
   // For atomicity: clone the root, apply operations to the clone,
-  // then copy the clone's content back to the original only if all succeed
-  json_context * clone_ctx = json_context_new();
-  if (!clone_ctx) {
-    if (err) {
-      *err = (GTEXT_JSON_Error){.code = GTEXT_JSON_E_OOM,
-          .message = "Out of memory creating clone for atomic patch"};
-    }
-    return GTEXT_JSON_E_OOM;
-  }
-
-  GTEXT_JSON_Value * clone = json_value_clone(root, clone_ctx);
+  // then move the clone's content into the original only if all succeed.
+  // The clone is copy-on-write, so only the paths the patch touches are
+  // copied.
+  GTEXT_JSON_Value * clone = gtext_json_clone(root);
   if (!clone) {
-    json_context_free(clone_ctx);
     if (err) {
       *err = (GTEXT_JSON_Error){.code = GTEXT_JSON_E_OOM,
           .message = "Out of memory cloning root for atomic patch"};
@@ -1508,11 +1303,12 @@ GTEXT_API GTEXT_JSON_Status gtext_json_patch_apply(GTEXT_JSON_Value * root,
     }
   }
 
-  // All operations succeeded - copy clone's content back to original
-  // This preserves the original's context but replaces its content
-  GTEXT_JSON_Status status = json_value_copy_content(root, clone);
+  // All operations succeeded - move clone's content into original
+  // This preserves the original's context but replaces its content; only
+  // the nodes the operations copied are copied again, and the clone is freed
+  GTEXT_JSON_Status status = json_value_take_content(root, clone);
   if (status != GTEXT_JSON_OK) {
-    // Copy failed - free clone and return error
+    // Move failed - free clone and return error
     gtext_json_free(clone);
     if (err) {
       err->code = status;
@@ -1524,9 +1320,6 @@ GTEXT_API GTEXT_JSON_Status gtext_json_patch_apply(GTEXT_JSON_Value * root,
     return status;
   }
 
-  // Free the clone (all its content has been copied to original)
-  gtext_json_free(clone);
-
   return GTEXT_JSON_OK;
 }
 
@@ -1554,8 +1347,10 @@ static GTEXT_JSON_Status json_merge_patch_recursive(GTEXT_JSON_Value * target,
       return GTEXT_JSON_E_INVALID;
     }
 
-    // Change target's type first
+    // Change target's type first; its old element array (which may be
+    // borrowed from the source of a clone) is no longer referenced
     target->type = patch->type;
+    target->cow = 0;
 
     // Clone content based on type (similar to json_value_clone but into
     // existing target)
@@ -1623,6 +1418,7 @@ static GTEXT_JSON_Status json_merge_patch_recursive(GTEXT_JSON_Value * target,
       target->as.number.has_i64 = patch->as.number.has_i64;
       target->as.number.has_u64 = patch->as.number.has_u64;
       target->as.number.has_dbl = patch->as.number.has_dbl;
+      target->as.number.lazy = patch->as.number.lazy;
       break;
     }
 
@@ -1695,11 +1491,22 @@ static GTEXT_JSON_Status json_merge_patch_recursive(GTEXT_JSON_Value * target,
     // since we're changing the type. It will be freed when the context is
     // freed.
     target->type = GTEXT_JSON_OBJECT;
+    target->cow = 0;
     target->as.object.count = 0;
     target->as.object.capacity = 0;
     target->as.object.pairs = NULL;
   }
 
+  // Copy the pairs array if it is shared with a clone
+  GTEXT_JSON_Status unshare_status = json_value_unshare(target);
+  if (unshare_status != GTEXT_JSON_OK) {
+    if (err) {
+      *err = (GTEXT_JSON_Error){.code = unshare_status,
+          .message = "Out of memory copying shared object"};
+    }
+    return unshare_status;
+  }
+
   // Now target is guaranteed to be an object
   // Verify target is actually an object (defensive check)
   if (target->type != GTEXT_JSON_OBJECT) {
@@ -1761,7 +1568,16 @@ static GTEXT_JSON_Status json_merge_patch_recursive(GTEXT_JSON_Value * target,
           if (key_len == 0 ||
               (target->as.object.pairs[j].key && key &&
                   memcmp(target->as.object.pairs[j].key, key, key_len) == 0)) {
-            target_value_mut = target->as.object.pairs[j].value;
+            // Copy the value first if it is shared with a clone
+            target_value_mut = json_value_writable_child(
+                target, &target->as.object.pairs[j].value);
+            if (!target_value_mut) {
+              if (err) {
+                *err = (GTEXT_JSON_Error){.code = GTEXT_JSON_E_OOM,
+                    .message = "Out of memory copying shared value"};
+              }
+              return GTEXT_JSON_E_OOM;
+            }
             break;
           }
         }
@@ -1796,7 +1612,8 @@ static GTEXT_JSON_Status json_merge_patch_recursive(GTEXT_JSON_Value * target,
       GTEXT_JSON_Status status =
           gtext_json_object_put(target, key, key_len, cloned_value);
       if (status != GTEXT_JSON_OK) {
-        gtext_json_free(cloned_value);
+        // cloned_value lives in target's arena and is reclaimed with it
+        // (freeing it here would release target's whole context)
         if (err) {
           err->code = status;
           err->message = "Failed to add key to target object";
@@ -1826,19 +1643,11 @@ GTEXT_API GTEXT_JSON_Status gtext_json_merge_patch(GTEXT_JSON_Value * target,
   }
 
   // For atomicity: clone the target, apply merge to the clone,
-  // then copy the clone's content back to the original only if all succeed
-  json_context * clone_ctx = json_context_new();
-  if (!clone_ctx) {
-    if (err) {
-      *err = (GTEXT_JSON_Error){.code = GTEXT_JSON_E_OOM,
-          .message = "Out of memory creating clone for atomic merge patch"};
-    }
-    return GTEXT_JSON_E_OOM;
-  }
-
-  GTEXT_JSON_Value * clone = json_value_clone(target, clone_ctx);
+  // then move the clone's content into the original only if all succeed.
+  // The clone is copy-on-write, so only the paths the patch touches are
+  // copied.
+  GTEXT_JSON_Value * clone = gtext_json_clone(target);
   if (!clone) {
-    json_context_free(clone_ctx);
     if (err) {
       *err = (GTEXT_JSON_Error){.code = GTEXT_JSON_E_OOM,
           .message = "Out of memory cloning target for atomic merge patch"};
@@ -1854,11 +1663,12 @@ GTEXT_API GTEXT_JSON_Status gtext_json_merge_patch(GTEXT_JSON_Value * target,
     return status;
   }
 
-  // All operations succeeded - copy clone's content back to original
-  // This preserves the original's context but replaces its content
-  status = json_value_copy_content(target, clone);
+  // All operations succeeded - move clone's content into original
+  // This preserves the original's context but replaces its content; only
+  // the nodes the operations copied are copied again, and the clone is freed
+  status = json_value_take_content(target, clone);
   if (status != GTEXT_JSON_OK) {
-    // Copy failed - free clone and return error
+    // Move failed - free clone and return error
     gtext_json_free(clone);
     if (err) {
       err->code = status;
@@ -1870,8 +1680,5 @@ GTEXT_API GTEXT_JSON_Status gtext_json_merge_patch(GTEXT_JSON_Value * target,
     return status;
   }
 
-  // Free the clone (all its content has been copied to original)
-  gtext_json_free(clone);
-
   return GTEXT_JSON_OK;
 }
@@ -98,9 +98,10 @@ static int json_pointer_parse_index(
 }
 
 // Internal function that performs the actual pointer evaluation
-// Handles both const and non-const versions
+// Handles both const and non-const versions; in writable mode, nodes shared
+// with a copy-on-write clone are copied along the path
 static GTEXT_JSON_Value * json_pointer_evaluate(
-    GTEXT_JSON_Value * root, const char * ptr, size_t len) {
+    GTEXT_JSON_Value * root, const char * ptr, size_t len, bool writable) {
   if (!root || !ptr) {
     return NULL;
   }
@@ -227,7 +228,22 @@ static GTEXT_JSON_Value * json_pointer_evaluate(
         return NULL;
       }
 
-      current = current->as.array.elems[array_idx];
+      if (writable) {
+        // Copy any node shared with a clone so the result can be modified
+        if (json_value_unshare(current) != GTEXT_JSON_OK) {
+          free(decoded);
+          return NULL;
+        }
+        current = json_value_writable_child(
+            current, &current->as.array.elems[array_idx]);
+        if (!current) {
+          free(decoded);
+          return NULL;
+        }
+      }
+      else {
+        current = current->as.array.elems[array_idx];
+      }
     }
     else {
       // Try as object key
@@ -245,9 +261,28 @@ static GTEXT_JSON_Value * json_pointer_evaluate(
         return NULL;
       }
 
-      // Cast away const for mutable access if needed
-      // This is safe because we're traversing a DOM tree that we own
-      current = (GTEXT_JSON_Value *)found;
+      if (writable) {
+        // Locate the slot holding the value and copy it if it is shared
+        // with a clone
+        if (json_value_unshare(current) != GTEXT_JSON_OK) {
+          free(decoded);
+          return NULL;
+        }
+        size_t slot = 0;
+        while (current->as.object.pairs[slot].value != found) {
+          slot++;
+        }
+        current = json_value_writable_child(
+            current, &current->as.object.pairs[slot].value);
+        if (!current) {
+          free(decoded);
+          return NULL;
+        }
+      }
+      else {
+        // Cast away const for read-only access
+        current = (GTEXT_JSON_Value *)found;
+      }
     }
 
     free(decoded);
@@ -270,10 +305,10 @@ GTEXT_API const GTEXT_JSON_Value * gtext_json_pointer_get(
     const GTEXT_JSON_Value * root, const char * ptr, size_t len) {
   // Cast away const for internal evaluation
   // This is safe because we're only reading
-  return json_pointer_evaluate((GTEXT_JSON_Value *)root, ptr, len);
+  return json_pointer_evaluate((GTEXT_JSON_Value *)root, ptr, len, false);
 }
 
 GTEXT_API GTEXT_JSON_Value * gtext_json_pointer_get_mut(
     GTEXT_JSON_Value * root, const char * ptr, size_t len) {
-  return json_pointer_evaluate(root, ptr, len);
+  return json_pointer_evaluate(root, ptr, len, true);
 }
@@ -668,7 +668,22 @@ static GTEXT_JSON_Status json_stream_handle_token(
     return json_stream_handle_value_token(st, token, err);
 
   case JSON_STREAM_STATE_OBJECT_KEY:
-    // Expecting object key
+    // Expecting object key, or '}' closing an empty object (or ending one
+    // after a trailing comma)
+    if (token->type == JSON_TOKEN_RBRACE) {
+      json_stream_stack_entry * object_top = json_stream_top(st);
+      if (object_top && object_top->has_elements &&
+          !st->opts.allow_trailing_commas) {
+        json_position pos = {
+            .offset = st->buffer_start_offset + token->pos.offset,
+            .line = token->pos.line,
+            .col = token->pos.col};
+        return json_stream_set_error(
+            st, GTEXT_JSON_E_BAD_TOKEN, "Trailing comma not allowed", pos, err);
+      }
+      st->state = JSON_STREAM_STATE_EXPECT_VALUE;
+      return json_stream_handle_token(st, token, err);
+    }
     if (token->type != JSON_TOKEN_STRING) {
       json_position pos = {
           .offset = st->buffer_start_offset + token->pos.offset,
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../text_utf8.h"
 #include "json_internal.h"
 
 #include <ghoti.io/text/json/json_core.h>
@@ -115,46 +116,6 @@ static size_t json_encode_utf8(uint32_t codepoint, unsigned char * out) {
   return 0; // Invalid codepoint
 }
 
-static int json_validate_utf8(const unsigned char * bytes, size_t len) {
-  size_t i = 0;
-  while (i < len) {
-    unsigned char byte = bytes[i];
-
-    if (byte < 0x80) {
-      // ASCII
-      i++;
-    }
-    else if ((byte & 0xE0) == 0xC0) {
-      // 2-byte sequence
-      if (i + 1 >= len || (bytes[i + 1] & 0xC0) != 0x80) {
-        return 0;
-      }
-      i += 2;
-    }
-    else if ((byte & 0xF0) == 0xE0) {
-      // 3-byte sequence
-      if (i + 2 >= len || (bytes[i + 1] & 0xC0) != 0x80 ||
-          (bytes[i + 2] & 0xC0) != 0x80) {
-        return 0;
-      }
-      i += 3;
-    }
-    else if ((byte & 0xF8) == 0xF0) {
-      // 4-byte sequence
-      if (i + 3 >= len || (bytes[i + 1] & 0xC0) != 0x80 ||
-          (bytes[i + 2] & 0xC0) != 0x80 || (bytes[i + 3] & 0xC0) != 0x80) {
-        return 0;
-      }
-      i += 4;
-    }
-    else {
-      // Invalid start byte
-      return 0;
-    }
-  }
-  return 1;
-}
-
 GTEXT_INTERNAL_API GTEXT_JSON_Status json_decode_string(const char * input,
     size_t input_len, char * output, size_t output_capacity,
     size_t * output_len, json_position * pos, int validate_utf8,
@@ -285,7 +246,7 @@ GTEXT_INTERNAL_API GTEXT_JSON_Status json_decode_string(const char * input,
 
   // Validate UTF-8 if requested
   if (validate_utf8 && out_idx > 0) {
-    if (!json_validate_utf8((const unsigned char *)output, out_idx)) {
+    if (text_utf8_validate(output, out_idx, NULL) != TEXT_UTF8_VALID) {
       if (utf8_mode == JSON_UTF8_REJECT) {
         return GTEXT_JSON_E_BAD_UNICODE;
       }
@@ -99,9 +99,12 @@ extern "C" {
  */
 
 // ============================================================================
-// UTF-8 Encoding/Validation
+// UTF-8 Encoding
 // ============================================================================
 
+// UTF-8 validation of decoded strings uses the shared text_utf8_validate()
+// (src/text_utf8.h).
+
 /**
  * @brief Encode a UTF-32 codepoint to UTF-8
  *
@@ -114,18 +117,6 @@ extern "C" {
  * @note This is a static function defined in json_string.c
  */
 
-/**
- * @brief Validate UTF-8 sequence
- *
- * @fn static int json_validate_utf8(const unsigned char * bytes, size_t len)
- *
- * @param bytes Pointer to UTF-8 bytes
- * @param len Length in bytes
- * @return 1 if valid, 0 if invalid
- *
- * @note This is a static function defined in json_string.c
- */
-
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../text_simd.h"
 #include "json_internal.h"
 #include <ghoti.io/text/json/json_core.h>
 #include <ghoti.io/text/json/json_dom.h>
@@ -296,12 +297,91 @@ static int write_string(GTEXT_JSON_Sink * sink, const char * s) {
 // Write Unicode escape sequence \uXXXX
 static int write_unicode_escape(
     GTEXT_JSON_Sink * sink, unsigned int codepoint) {
-  char buf[7];
-  int len = snprintf(buf, sizeof(buf), "\\u%04X", codepoint);
-  if (len < 0 || (size_t)len >= sizeof(buf)) {
-    return 1;
+  static const char hex[] = "0123456789ABCDEF";
+  char buf[6] = {'\\', 'u', hex[(codepoint >> 12) & 0xF],
+      hex[(codepoint >> 8) & 0xF], hex[(codepoint >> 4) & 0xF],
+      hex[codepoint & 0xF]};
+  return write_bytes(sink, buf, sizeof(buf));
+}
+
+// Return the length of the leading run of str that can be written verbatim.
+//
+// The scan stops at the first byte that needs escaping: '"', '\\', control
+// characters, and (depending on the options) '/' and bytes >= 0x80. The
+// option flags are compile-time constants in each of the specialized
+// wrappers below, so the block loop reduces to one test per 32 bytes.
+TEXT_SIMD_INLINE size_t json_escape_scan(const unsigned char * s, size_t len,
+    int escape_solidus, int escape_high) {
+  size_t i = 0;
+
+#if TEXT_SIMD_HAVE_SSE2
+  while (len - i >= TEXT_SIMD_BLOCK) {
+    __m128i a = text_simd_load128(s + i);
+    __m128i b = text_simd_load128(s + i + 16);
+    uint32_t mask_a = text_simd_eq128(a, '"') | text_simd_eq128(a, '\\') |
+        text_simd_le128(a, 0x1F);
+    uint32_t mask_b = text_simd_eq128(b, '"') | text_simd_eq128(b, '\\') |
+        text_simd_le128(b, 0x1F);
+    if (escape_solidus) {
+      mask_a |= text_simd_eq128(a, '/');
+      mask_b |= text_simd_eq128(b, '/');
+    }
+    if (escape_high) {
+      mask_a |= text_simd_high128(a);
+      mask_b |= text_simd_high128(b);
+    }
+    uint32_t mask = mask_a | (mask_b << 16);
+    if (mask != 0) {
+      return i + text_simd_ctz32(mask);
+    }
+    i += TEXT_SIMD_BLOCK;
+  }
+#else
+  while (len - i >= TEXT_SIMD_BLOCK) {
+    uint64_t hit = 0;
+    for (size_t w = 0; w < TEXT_SIMD_BLOCK; w += 8) {
+      uint64_t x = text_simd_load64(s + i + w);
+      hit |= TEXT_SWAR_EQ(x, '"') | TEXT_SWAR_EQ(x, '\\') |
+          TEXT_SWAR_LESS(x, 0x20);
+      if (escape_solidus) {
+        hit |= TEXT_SWAR_EQ(x, '/');
+      }
+      if (escape_high) {
+        hit |= TEXT_SWAR_HIGH(x);
+      }
+    }
+    if (hit != 0) {
+      break; // Locate the exact byte with the scalar loop
+    }
+    i += TEXT_SIMD_BLOCK;
+  }
+#endif
+
+  for (; i < len; i++) {
+    unsigned char c = s[i];
+    if (c == '"' || c == '\\' || c < 0x20 || (escape_solidus && c == '/') ||
+        (escape_high && c >= 0x80)) {
+      break;
+    }
   }
-  return write_bytes(sink, buf, (size_t)len);
+  return i;
+}
+
+static size_t json_escape_scan_plain(const unsigned char * s, size_t len) {
+  return json_escape_scan(s, len, 0, 0);
+}
+
+static size_t json_escape_scan_solidus(const unsigned char * s, size_t len) {
+  return json_escape_scan(s, len, 1, 0);
+}
+
+static size_t json_escape_scan_high(const unsigned char * s, size_t len) {
+  return json_escape_scan(s, len, 0, 1);
+}
+
+static size_t json_escape_scan_solidus_high(
+    const unsigned char * s, size_t len) {
+  return json_escape_scan(s, len, 1, 1);
 }
 
 // Escape and write a string value
@@ -313,84 +393,77 @@ static int write_escaped_string(GTEXT_JSON_Sink * sink, const char * str,
 
   const GTEXT_JSON_Write_Options * opts =
       opt ? opt : &(GTEXT_JSON_Write_Options){0};
-  int escape_solidus = opts->escape_solidus;
-  int escape_unicode = opts->escape_unicode;
-  int escape_all_non_ascii = opts->escape_all_non_ascii;
+  // escape_unicode and escape_all_non_ascii both escape every byte >= 0x80
+  int escape_high = opts->escape_unicode || opts->escape_all_non_ascii;
+
+  // Pick the scanner specialized for this option combination once per string
+  size_t (*scan)(const unsigned char *, size_t);
+  if (opts->escape_solidus) {
+    scan = escape_high ? json_escape_scan_solidus_high
+                       : json_escape_scan_solidus;
+  }
+  else {
+    scan = escape_high ? json_escape_scan_high : json_escape_scan_plain;
+  }
+
+  const unsigned char * s = (const unsigned char *)str;
+  size_t i = 0;
+  while (i < len) {
+    // Emit the longest clean run with a single sink call
+    size_t run = scan(s + i, len - i);
+    if (run > 0) {
+      if (write_bytes(sink, str + i, run) != 0) {
+        return 1;
+      }
+      i += run;
+      if (i == len) {
+        break;
+      }
+    }
 
-  for (size_t i = 0; i < len; i++) {
-    unsigned char c = (unsigned char)str[i];
+    unsigned char c = s[i++];
 
     // Standard escape sequences
+    const char * esc = NULL;
     switch (c) {
     case '"':
-      if (write_string(sink, "\\\"") != 0)
-        return 1;
-      continue;
+      esc = "\\\"";
+      break;
     case '\\':
-      if (write_string(sink, "\\\\") != 0)
-        return 1;
-      continue;
+      esc = "\\\\";
+      break;
     case '/':
-      if (escape_solidus) {
-        if (write_string(sink, "\\/") != 0)
-          return 1;
-      }
-      else {
-        if (write_char(sink, '/') != 0)
-          return 1;
-      }
-      continue;
+      esc = "\\/";
+      break;
     case '\b':
-      if (write_string(sink, "\\b") != 0)
-        return 1;
-      continue;
+      esc = "\\b";
+      break;
     case '\f':
-      if (write_string(sink, "\\f") != 0)
-        return 1;
-      continue;
+      esc = "\\f";
+      break;
     case '\n':
-      if (write_string(sink, "\\n") != 0)
-        return 1;
-      continue;
+      esc = "\\n";
+      break;
     case '\r':
-      if (write_string(sink, "\\r") != 0)
-        return 1;
-      continue;
+      esc = "\\r";
+      break;
     case '\t':
-      if (write_string(sink, "\\t") != 0)
-        return 1;
-      continue;
+      esc = "\\t";
+      break;
     }
-
-    // Control characters (0x00-0x1F) must be escaped as \uXXXX
-    if (c < 0x20) {
-      if (write_unicode_escape(sink, c) != 0)
+    if (esc) {
+      if (write_bytes(sink, esc, 2) != 0) {
         return 1;
-      continue;
-    }
-
-    // Non-ASCII characters
-    if (c >= 0x80) {
-      if (escape_all_non_ascii) {
-        // Escape all non-ASCII as \uXXXX
-        if (write_unicode_escape(sink, c) != 0)
-          return 1;
-        continue;
-      }
-      else if (escape_unicode) {
-        // For escape_unicode, we need to handle UTF-8 sequences properly
-        // For now, escape individual bytes if they're >= 0x80
-        // A more sophisticated implementation would decode UTF-8 and escape
-        // codepoints
-        if (write_unicode_escape(sink, c) != 0)
-          return 1;
-        continue;
       }
+      continue;
     }
 
-    // Regular character - write as-is
-    if (write_char(sink, (char)c) != 0)
+    // Remaining control characters (0x00-0x1F) and, when requested, non-ASCII
+    // bytes are escaped as \uXXXX. For escape_unicode a more sophisticated
+    // implementation would decode UTF-8 and escape whole codepoints.
+    if (write_unicode_escape(sink, c) != 0) {
       return 1;
+    }
   }
 
   if (write_char(sink, '"') != 0) {
@@ -576,6 +649,10 @@ static int write_number(GTEXT_JSON_Sink * sink, const GTEXT_JSON_Value * v,
     return write_bytes(sink, v->as.number.lexeme, v->as.number.lexeme_len);
   }
 
+  // Lazily parsed numbers are only converted when they must be reformatted;
+  // if conversion fails the lexeme fallback below still applies
+  json_number_resolve(v);
+
   // Format from available representation
   char num_buf[64];
 
@@ -1080,6 +1157,11 @@ static int writer_write_comma_if_needed(GTEXT_JSON_Writer * w) {
     return 0; // No stack, no comma needed
   }
 
+  // An object value follows its key directly
+  if (top->type == JSON_WRITER_STACK_OBJECT && !top->expecting_key) {
+    return 0;
+  }
+
   if (top->has_elements) {
     if (writer_write_char(w, ',') != 0) {
       return 1;
@@ -0,0 +1,275 @@
+/**
+ * @file
+ *
+ * Internal byte-classification helpers shared across text modules.
+ *
+ * These helpers let hot loops (string escaping, field scanning, validation)
+ * skip over runs of "uninteresting" bytes a block at a time instead of one
+ * byte at a time. On x86 targets with SSE2 the helpers operate on 16-byte
+ * vectors; everywhere else they fall back to portable 64-bit SWAR
+ * (SIMD-within-a-register) arithmetic, so no module needs its own
+ * preprocessor guards.
+ *
+ * This header is internal and must not be included by external code.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#ifndef GHOTI_IO_TEXT_SIMD_H
+#define GHOTI_IO_TEXT_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXT_SIMD_HAVE_SSE2 1
+#else
+#define TEXT_SIMD_HAVE_SSE2 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Force inlining of small helpers so callers can specialize on
+ * compile-time constant arguments.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define TEXT_SIMD_INLINE static inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define TEXT_SIMD_INLINE static __forceinline
+#else
+#define TEXT_SIMD_INLINE static inline
+#endif
+
+/**
+ * @brief Number of bytes examined per iteration by the block scanners.
+ */
+#define TEXT_SIMD_BLOCK 32
+
+/**
+ * @brief Index of the lowest set bit in a non-zero 32-bit mask.
+ */
+TEXT_SIMD_INLINE unsigned text_simd_ctz32(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return (unsigned)index;
+#else
+  unsigned n = 0;
+  while (!(mask & 1u)) {
+    mask >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+/**
+ * @brief Index of the lowest set bit in a non-zero 64-bit mask.
+ */
+TEXT_SIMD_INLINE unsigned text_simd_ctz64(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_ctzll(mask);
+#else
+  uint32_t lo = (uint32_t)mask;
+  return lo ? text_simd_ctz32(lo)
+            : 32u + text_simd_ctz32((uint32_t)(mask >> 32));
+#endif
+}
+
+/**
+ * @brief Unaligned 64-bit load.
+ */
+TEXT_SIMD_INLINE uint64_t text_simd_load64(const unsigned char * p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/**
+ * @name SWAR helpers
+ *
+ * Each macro produces a word whose byte high bits are set for the bytes of
+ * @p x matching the predicate. A zero result means no byte matched. A
+ * non-zero result may carry false positives only in bytes *above* a true
+ * match, so it is suitable for "is this word clean?" tests; callers locate
+ * the exact byte with a scalar loop.
+ * @{
+ */
+#define TEXT_SWAR_ONES UINT64_C(0x0101010101010101)
+#define TEXT_SWAR_HIGHS UINT64_C(0x8080808080808080)
+#define TEXT_SWAR_BROADCAST(c) (TEXT_SWAR_ONES * (uint64_t)(unsigned char)(c))
+/** Bytes equal to zero. */
+#define TEXT_SWAR_ZERO(x) (((x) - TEXT_SWAR_ONES) & ~(x) & TEXT_SWAR_HIGHS)
+/** Bytes equal to @p c. */
+#define TEXT_SWAR_EQ(x, c) TEXT_SWAR_ZERO((x) ^ TEXT_SWAR_BROADCAST(c))
+/** Bytes strictly less than @p n (requires n <= 128). */
+#define TEXT_SWAR_LESS(x, n)                                                   \
+  (((x) - TEXT_SWAR_BROADCAST(n)) & ~(x) & TEXT_SWAR_HIGHS)
+/** Bytes with the high bit set (>= 0x80). */
+#define TEXT_SWAR_HIGH(x) ((x) & TEXT_SWAR_HIGHS)
+/** @} */
+
+#if TEXT_SIMD_HAVE_SSE2
+
+/**
+ * @name SSE2 helpers
+ *
+ * Each helper returns a 16-bit mask with bit i set when byte i of the vector
+ * satisfies the predicate. Unlike the SWAR helpers these are exact.
+ * @{
+ */
+TEXT_SIMD_INLINE __m128i text_simd_load128(const unsigned char * p) {
+  return _mm_loadu_si128((const __m128i *)(const void *)p);
+}
+
+TEXT_SIMD_INLINE uint32_t text_simd_eq128(__m128i v, unsigned char c) {
+  return (uint32_t)_mm_movemask_epi8(
+      _mm_cmpeq_epi8(v, _mm_set1_epi8((char)c)));
+}
+
+/** Bytes (unsigned) less than or equal to @p c. */
+TEXT_SIMD_INLINE uint32_t text_simd_le128(__m128i v, unsigned char c) {
+  __m128i limit = _mm_set1_epi8((char)c);
+  return (uint32_t)_mm_movemask_epi8(
+      _mm_cmpeq_epi8(_mm_min_epu8(v, limit), v));
+}
+
+/** Bytes with the high bit set (>= 0x80). */
+TEXT_SIMD_INLINE uint32_t text_simd_high128(__m128i v) {
+  return (uint32_t)_mm_movemask_epi8(v);
+}
+/** @} */
+
+#endif // TEXT_SIMD_HAVE_SSE2
+
+/**
+ * @brief Maximum number of bytes in a text_simd_span_excluding() set.
+ */
+#define TEXT_SIMD_MAX_SET 8
+
+/**
+ * @brief Length of the leading run of @p s that contains none of the bytes in
+ * @p set.
+ *
+ * Used by tokenizers whose "special" bytes depend on runtime configuration
+ * (e.g. a CSV dialect's delimiter and quote): each block is compared against
+ * every set byte and the resulting masks are combined, so the caller jumps
+ * directly from one special byte to the next.
+ *
+ * @param s Input bytes
+ * @param len Length of input
+ * @param set Bytes that end the run (duplicates are allowed)
+ * @param set_len Number of bytes in @p set (1 to TEXT_SIMD_MAX_SET)
+ * @return Index of the first byte in @p set, or @p len if there is none
+ */
+TEXT_SIMD_INLINE size_t text_simd_span_excluding(const unsigned char * s,
+    size_t len, const unsigned char * set, size_t set_len) {
+  size_t i = 0;
+
+#if TEXT_SIMD_HAVE_SSE2
+  __m128i needles[TEXT_SIMD_MAX_SET];
+  for (size_t k = 0; k < set_len; k++) {
+    needles[k] = _mm_set1_epi8((char)set[k]);
+  }
+  while (len - i >= TEXT_SIMD_BLOCK) {
+    __m128i a = text_simd_load128(s + i);
+    __m128i b = text_simd_load128(s + i + 16);
+    __m128i hit_a = _mm_cmpeq_epi8(a, needles[0]);
+    __m128i hit_b = _mm_cmpeq_epi8(b, needles[0]);
+    for (size_t k = 1; k < set_len; k++) {
+      hit_a = _mm_or_si128(hit_a, _mm_cmpeq_epi8(a, needles[k]));
+      hit_b = _mm_or_si128(hit_b, _mm_cmpeq_epi8(b, needles[k]));
+    }
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(hit_a) |
+        ((uint32_t)_mm_movemask_epi8(hit_b) << 16);
+    if (mask != 0) {
+      return i + text_simd_ctz32(mask);
+    }
+    i += TEXT_SIMD_BLOCK;
+  }
+#else
+  uint64_t needles[TEXT_SIMD_MAX_SET];
+  for (size_t k = 0; k < set_len; k++) {
+    needles[k] = TEXT_SWAR_BROADCAST(set[k]);
+  }
+  while (len - i >= TEXT_SIMD_BLOCK) {
+    uint64_t hit = 0;
+    for (size_t w = 0; w < TEXT_SIMD_BLOCK; w += 8) {
+      uint64_t x = text_simd_load64(s + i + w);
+      for (size_t k = 0; k < set_len; k++) {
+        hit |= TEXT_SWAR_ZERO(x ^ needles[k]);
+      }
+    }
+    if (hit != 0) {
+      break; // Locate the exact byte with the scalar loop
+    }
+    i += TEXT_SIMD_BLOCK;
+  }
+#endif
+
+  for (; i < len; i++) {
+    for (size_t k = 0; k < set_len; k++) {
+      if (s[i] == set[k]) {
+        return i;
+      }
+    }
+  }
+  return len;
+}
+
+/**
+ * @brief Little-endian 64-bit load (first byte in the low bits).
+ */
+TEXT_SIMD_INLINE uint64_t text_simd_load64_le(const unsigned char * p) {
+  uint64_t v = text_simd_load64(p);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap64(v);
+#endif
+  return v;
+}
+
+/**
+ * @brief Whether all 8 bytes at @p p are ASCII digits.
+ */
+TEXT_SIMD_INLINE int text_simd_is_8digits(const unsigned char * p) {
+  uint64_t x = text_simd_load64_le(p);
+  return ((x & UINT64_C(0xF0F0F0F0F0F0F0F0)) |
+             (((x + UINT64_C(0x0606060606060606)) &
+                  UINT64_C(0xF0F0F0F0F0F0F0F0)) >>
+                 4)) == UINT64_C(0x3333333333333333);
+}
+
+/**
+ * @brief Value of the 8 ASCII digits at @p p (first byte most significant).
+ *
+ * Combines digit pairs, then quads, then the two halves with three
+ * multiplications instead of eight multiply-adds. The caller must check the
+ * bytes with text_simd_is_8digits() first.
+ */
+TEXT_SIMD_INLINE uint32_t text_simd_parse_8digits(const unsigned char * p) {
+  const uint64_t mask = UINT64_C(0x000000FF000000FF);
+  const uint64_t mul1 = UINT64_C(0x000F424000000064); // 100 + (1000000 << 32)
+  const uint64_t mul2 = UINT64_C(0x0000271000000001); // 1 + (10000 << 32)
+  uint64_t x = text_simd_load64_le(p) - UINT64_C(0x3030303030303030);
+  x = (x * 10) + (x >> 8);
+  x = (((x & mask) * mul1) + (((x >> 16) & mask) * mul2)) >> 32;
+  return (uint32_t)x;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GHOTI_IO_TEXT_SIMD_H
@@ -0,0 +1,320 @@
+/**
+ * @file
+ *
+ * Shared UTF-8 validator implementation.
+ *
+ * The vector kernel follows Keiser & Lemire, "Validating UTF-8 In Less Than
+ * One Instruction Per Byte" (2021): three 16-entry nibble lookups classify
+ * every byte pair, and a saturating subtraction checks that 3- and 4-byte
+ * leads are followed by the right number of continuation bytes. The kernel
+ * only answers "is this block valid?"; when it is not, the scalar validator
+ * re-scans from the last sequence boundary to find the exact offset.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#include <string.h>
+
+#include "text_simd.h"
+#include "text_utf8.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <tmmintrin.h>
+#define TEXT_UTF8_HAVE_SSSE3 1
+#else
+#define TEXT_UTF8_HAVE_SSSE3 0
+#endif
+
+// Classify a single sequence starting at s[0] with `avail` bytes available.
+// Returns the sequence length on success, 0 if the sequence is invalid, or
+// (size_t)-1 if the available bytes are a valid but truncated prefix.
+static size_t utf8_check_sequence(const unsigned char * s, size_t avail) {
+  unsigned char c = s[0];
+  size_t need;
+  unsigned char lo = 0x80;
+  unsigned char hi = 0xBF;
+
+  if (c < 0x80) {
+    return 1;
+  }
+  if (c >= 0xC2 && c <= 0xDF) {
+    need = 2;
+  }
+  else if (c >= 0xE0 && c <= 0xEF) {
+    need = 3;
+    if (c == 0xE0) {
+      lo = 0xA0; // Overlong
+    }
+    else if (c == 0xED) {
+      hi = 0x9F; // Surrogate halves
+    }
+  }
+  else if (c >= 0xF0 && c <= 0xF4) {
+    need = 4;
+    if (c == 0xF0) {
+      lo = 0x90; // Overlong
+    }
+    else if (c == 0xF4) {
+      hi = 0x8F; // Above U+10FFFF
+    }
+  }
+  else {
+    return 0; // Continuation byte, C0/C1 overlong lead, or F5-FF
+  }
+
+  for (size_t i = 1; i < need; i++) {
+    if (i >= avail) {
+      return (size_t)-1;
+    }
+    unsigned char b = s[i];
+    if (b < lo || b > hi) {
+      return 0;
+    }
+    lo = 0x80;
+    hi = 0xBF;
+  }
+  return need;
+}
+
+// Scalar validation of s[start, len). Skips ASCII runs a word at a time.
+static text_utf8_result utf8_validate_scalar(
+    const unsigned char * s, size_t len, size_t start, size_t * error_offset) {
+  size_t i = start;
+  while (i < len) {
+    if (s[i] < 0x80) {
+      while (len - i >= 8 && TEXT_SWAR_HIGH(text_simd_load64(s + i)) == 0) {
+        i += 8;
+      }
+      while (i < len && s[i] < 0x80) {
+        i++;
+      }
+      continue;
+    }
+    size_t n = utf8_check_sequence(s + i, len - i);
+    if (n == 0 || n == (size_t)-1) {
+      if (error_offset) {
+        *error_offset = i;
+      }
+      return n == 0 ? TEXT_UTF8_INVALID : TEXT_UTF8_INCOMPLETE;
+    }
+    i += n;
+  }
+  if (error_offset) {
+    *error_offset = len;
+  }
+  return TEXT_UTF8_VALID;
+}
+
+#if TEXT_UTF8_HAVE_SSSE3
+
+// Error classes from Keiser & Lemire, one bit each.
+#define UTF8_TOO_SHORT 0x01
+#define UTF8_TOO_LONG 0x02
+#define UTF8_OVERLONG_3 0x04
+#define UTF8_TOO_LARGE 0x08
+#define UTF8_SURROGATE 0x10
+#define UTF8_OVERLONG_2 0x20
+#define UTF8_TOO_LARGE_1000 0x40
+#define UTF8_OVERLONG_4 0x40
+#define UTF8_TWO_CONTS 0x80
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+#define UTF8_B(x) ((char)(unsigned char)(x))
+
+// Validate whole 16-byte blocks of s. Returns the offset of the first block
+// in which an error was detected, or the offset just past the last full block
+// if none was. Bytes before the returned offset that do not belong to a
+// sequence crossing it are known to be valid.
+__attribute__((target("ssse3"))) static size_t utf8_validate_ssse3(
+    const unsigned char * s, size_t len) {
+  // Indexed by the high nibble of the first byte of each pair
+  const __m128i byte_1_high = _mm_setr_epi8(UTF8_TOO_LONG, UTF8_TOO_LONG,
+      UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+      UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_B(UTF8_TWO_CONTS),
+      UTF8_B(UTF8_TWO_CONTS), UTF8_B(UTF8_TWO_CONTS), UTF8_B(UTF8_TWO_CONTS),
+      UTF8_TOO_SHORT | UTF8_OVERLONG_2, UTF8_TOO_SHORT,
+      UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+      UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 |
+          UTF8_OVERLONG_4);
+  // Indexed by the low nibble of the first byte of each pair
+  const __m128i byte_1_low = _mm_setr_epi8(
+      UTF8_B(UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4),
+      UTF8_B(UTF8_CARRY | UTF8_OVERLONG_2), UTF8_B(UTF8_CARRY),
+      UTF8_B(UTF8_CARRY), UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 |
+          UTF8_SURROGATE),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+      UTF8_B(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000));
+  // Indexed by the high nibble of the second byte of each pair
+  const __m128i byte_2_high = _mm_setr_epi8(UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+      UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+      UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+      UTF8_B(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+          UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4),
+      UTF8_B(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+          UTF8_OVERLONG_3 | UTF8_TOO_LARGE),
+      UTF8_B(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+          UTF8_SURROGATE | UTF8_TOO_LARGE),
+      UTF8_B(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+          UTF8_SURROGATE | UTF8_TOO_LARGE),
+      UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+  // A lead byte in the last 1-3 positions needs bytes from the next block
+  const __m128i max_complete = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1,
+      -1, -1, -1, -1, -1, UTF8_B(0xF0 - 1), UTF8_B(0xE0 - 1),
+      UTF8_B(0xC0 - 1));
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  const __m128i zero = _mm_setzero_si128();
+
+  __m128i prev = zero;
+  __m128i prev_incomplete = zero;
+  size_t i = 0;
+
+  for (; len - i >= 16; i += 16) {
+    __m128i input = _mm_loadu_si128((const __m128i *)(const void *)(s + i));
+    __m128i error;
+
+    if (_mm_movemask_epi8(input) == 0) {
+      // ASCII block: only a sequence left open by the previous block can fail
+      error = prev_incomplete;
+    }
+    else {
+      __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+      __m128i special = _mm_and_si128(
+          _mm_and_si128(
+              _mm_shuffle_epi8(byte_1_high,
+                  _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+              _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, nibble))),
+          _mm_shuffle_epi8(
+              byte_2_high, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+
+      __m128i prev2 = _mm_alignr_epi8(input, prev, 14);
+      __m128i prev3 = _mm_alignr_epi8(input, prev, 13);
+      __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(UTF8_B(0xE0 - 0x80)));
+      __m128i fourth =
+          _mm_subs_epu8(prev3, _mm_set1_epi8(UTF8_B(0xF0 - 0x80)));
+      __m128i must_be_cont = _mm_and_si128(
+          _mm_or_si128(third, fourth), _mm_set1_epi8(UTF8_B(0x80)));
+
+      error = _mm_xor_si128(must_be_cont, special);
+      prev_incomplete = _mm_subs_epu8(input, max_complete);
+    }
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, zero)) != 0xFFFF) {
+      return i;
+    }
+    prev = input;
+  }
+  return i;
+}
+
+static int utf8_have_ssse3(void) {
+  return __builtin_cpu_supports("ssse3");
+}
+
+#endif // TEXT_UTF8_HAVE_SSSE3
+
+GTEXT_INTERNAL_API text_utf8_result text_utf8_validate(
+    const char * buf, size_t len, size_t * error_offset) {
+  const unsigned char * s = (const unsigned char *)buf;
+  size_t start = 0;
+
+  if (len == 0 || !buf) {
+    if (error_offset) {
+      *error_offset = 0;
+    }
+    return TEXT_UTF8_VALID;
+  }
+
+#if TEXT_UTF8_HAVE_SSSE3
+  if (len >= 16 && utf8_have_ssse3()) {
+    size_t block = utf8_validate_ssse3(s, len);
+    // Resume at the start of the sequence that crosses `block`, if any. Its
+    // lead byte is at most 3 bytes back; continuation bytes before it belong
+    // to sequences that were already validated.
+    start = block >= 3 ? block - 3 : 0;
+    while (start < block && (s[start] & 0xC0) == 0x80) {
+      start++;
+    }
+  }
+#endif
+
+  return utf8_validate_scalar(s, len, start, error_offset);
+}
+
+GTEXT_INTERNAL_API void text_utf8_stream_init(text_utf8_stream * st) {
+  memset(st, 0, sizeof(*st));
+}
+
+GTEXT_INTERNAL_API text_utf8_result text_utf8_stream_feed(
+    text_utf8_stream * st, const char * buf, size_t len,
+    size_t * error_offset) {
+  const unsigned char * s = (const unsigned char *)buf;
+  size_t base = st->consumed;
+
+  if (len == 0 || !buf) {
+    return TEXT_UTF8_VALID;
+  }
+  st->consumed += len;
+
+  // Complete a sequence left open by the previous chunk
+  if (st->pending_len > 0) {
+    unsigned char seq[4];
+    size_t take = sizeof(seq) - st->pending_len;
+    if (take > len) {
+      take = len;
+    }
+    memcpy(seq, st->pending, st->pending_len);
+    memcpy(seq + st->pending_len, s, take);
+
+    size_t n = utf8_check_sequence(seq, st->pending_len + take);
+    if (n == 0) {
+      if (error_offset) {
+        *error_offset = base - st->pending_len;
+      }
+      return TEXT_UTF8_INVALID;
+    }
+    if (n == (size_t)-1) {
+      // Still not complete: the whole chunk was part of the sequence
+      memcpy(st->pending + st->pending_len, s, len);
+      st->pending_len += len;
+      return TEXT_UTF8_VALID;
+    }
+    size_t used = n - st->pending_len;
+    st->pending_len = 0;
+    s += used;
+    len -= used;
+    base += used;
+  }
+
+  size_t offset = 0;
+  text_utf8_result result = text_utf8_validate((const char *)s, len, &offset);
+  if (result == TEXT_UTF8_INCOMPLETE) {
+    // A truncated sequence is at most 3 bytes; carry it to the next chunk
+    st->pending_len = len - offset;
+    memcpy(st->pending, s + offset, st->pending_len);
+    return TEXT_UTF8_VALID;
+  }
+  if (result == TEXT_UTF8_INVALID && error_offset) {
+    *error_offset = base + offset;
+  }
+  return result;
+}
+
+GTEXT_INTERNAL_API text_utf8_result text_utf8_stream_finish(
+    const text_utf8_stream * st, size_t * error_offset) {
+  if (st->pending_len > 0) {
+    if (error_offset) {
+      *error_offset = st->consumed - st->pending_len;
+    }
+    return TEXT_UTF8_INCOMPLETE;
+  }
+  return TEXT_UTF8_VALID;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file
+ *
+ * Internal UTF-8 validator shared by the JSON, CSV, and YAML modules.
+ *
+ * Validation is strict (RFC 3629): overlong encodings, UTF-16 surrogate
+ * halves, and codepoints above U+10FFFF are rejected. Long inputs are
+ * validated a vector block at a time, using the Keiser-Lemire lookup
+ * algorithm when the running CPU supports SSSE3 (selected at runtime) and an
+ * ASCII fast path otherwise. The exact offset of the first offending sequence
+ * is always reported so callers can produce precise error messages.
+ *
+ * This header is internal and must not be included by external code.
+ *
+ * Copyright 2026 by Corey Pennycuff
+ */
+
+#ifndef GHOTI_IO_TEXT_UTF8_H
+#define GHOTI_IO_TEXT_UTF8_H
+
+#include <ghoti.io/text/macros.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UTF-8 validation result
+ */
+typedef enum {
+  TEXT_UTF8_VALID,     ///< Input is valid UTF-8
+  TEXT_UTF8_INVALID,   ///< Input contains an invalid sequence
+  TEXT_UTF8_INCOMPLETE ///< Input ends in the middle of a valid sequence
+} text_utf8_result;
+
+/**
+ * @brief Incremental validator state for input arriving in chunks
+ *
+ * A sequence split across two chunks is carried over in @c pending and
+ * completed when the next chunk arrives.
+ */
+typedef struct {
+  unsigned char pending[4]; ///< Bytes of an unfinished trailing sequence
+  size_t pending_len;       ///< Number of bytes in @c pending
+  size_t consumed;          ///< Total bytes fed so far
+} text_utf8_stream;
+
+/**
+ * @brief Validate a complete buffer
+ *
+ * @param buf Input bytes (may be NULL when len is 0)
+ * @param len Length of input in bytes
+ * @param error_offset Output: offset of the first byte of the offending (or
+ *   truncated) sequence, or @p len when valid. May be NULL.
+ * @return TEXT_UTF8_VALID, TEXT_UTF8_INVALID, or TEXT_UTF8_INCOMPLETE when the
+ *   only problem is a truncated sequence at the very end
+ */
+GTEXT_INTERNAL_API text_utf8_result text_utf8_validate(
+    const char * buf, size_t len, size_t * error_offset);
+
+/**
+ * @brief Initialize an incremental validator
+ *
+ * @param st Validator state (must not be NULL)
+ */
+GTEXT_INTERNAL_API void text_utf8_stream_init(text_utf8_stream * st);
+
+/**
+ * @brief Validate the next chunk of a stream
+ *
+ * A sequence left unfinished at the end of the chunk is not an error; it is
+ * completed by the next call (or reported by text_utf8_stream_finish()).
+ *
+ * @param st Validator state (must not be NULL)
+ * @param buf Chunk bytes (may be NULL when len is 0)
+ * @param len Length of chunk in bytes
+ * @param error_offset Output: on TEXT_UTF8_INVALID, the offset of the
+ *   offending sequence counted from the start of the stream. May be NULL.
+ * @return TEXT_UTF8_VALID or TEXT_UTF8_INVALID
+ */
+GTEXT_INTERNAL_API text_utf8_result text_utf8_stream_feed(
+    text_utf8_stream * st, const char * buf, size_t len,
+    size_t * error_offset);
+
+/**
+ * @brief Finish an incremental validation
+ *
+ * @param st Validator state (must not be NULL)
+ * @param error_offset Output: on TEXT_UTF8_INCOMPLETE, the stream offset of
+ *   the truncated sequence. May be NULL.
+ * @return TEXT_UTF8_VALID, or TEXT_UTF8_INCOMPLETE if the stream ended in the
+ *   middle of a sequence
+ */
+GTEXT_INTERNAL_API text_utf8_result text_utf8_stream_finish(
+    const text_utf8_stream * st, size_t * error_offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GHOTI_IO_TEXT_UTF8_H
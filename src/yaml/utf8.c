@@ -2,8 +2,9 @@
  * @file utf8.c
  * @brief UTF-8 validation and small dynamic buffer used by YAML scanner.
  *
- * Minimal, well-tested utilities: a fast UTF-8 validator and a tiny
- * growable buffer for assembling scalars that cross feed boundaries.
+ * Minimal, well-tested utilities: a UTF-8 validator (backed by the shared
+ * vectorized validator) and a tiny growable buffer for assembling scalars
+ * that cross feed boundaries.
  *
  * Copyright 2026 by Corey Pennycuff
  */
@@ -12,58 +13,13 @@
 #include <string.h>
 #include <stdint.h>
 
+#include "../text_utf8.h"
 #include "yaml_internal.h"
 
-/* UTF-8 validation: iterate bytes and ensure valid sequences. Returns 1 on valid, 0 on invalid. */
+/* UTF-8 validation delegates to the shared validator. Returns 1 on valid, 0 on invalid. */
 GTEXT_INTERNAL_API int gtext_utf8_validate(const char *buf, size_t len)
 {
-  const unsigned char *s = (const unsigned char *)buf;
-  size_t i = 0;
-
-  while (i < len) {
-    unsigned char c = s[i];
-    if (c < 0x80) {
-      /* ASCII */
-      i++;
-      continue;
-    }
-
-    if ((c >> 5) == 0x6) {
-      /* 2-byte sequence: 110xxxxx 10xxxxxx */
-      if (i + 1 >= len) return 0;
-      if ((s[i+1] & 0xC0) != 0x80) return 0;
-      unsigned int code = ((c & 0x1F) << 6) | (s[i+1] & 0x3F);
-      if (code < 0x80) return 0; /* overlong */
-      i += 2;
-      continue;
-    }
-
-    if ((c >> 4) == 0xE) {
-      /* 3-byte sequence: 1110xxxx 10xxxxxx 10xxxxxx */
-      if (i + 2 >= len) return 0;
-      if (((s[i+1] & 0xC0) != 0x80) || ((s[i+2] & 0xC0) != 0x80)) return 0;
-      unsigned int code = ((c & 0x0F) << 12) | ((s[i+1] & 0x3F) << 6) | (s[i+2] & 0x3F);
-      if (code < 0x800) return 0; /* overlong */
-      /* Surrogate halves are invalid in UTF-8 */
-      if (code >= 0xD800 && code <= 0xDFFF) return 0;
-      i += 3;
-      continue;
-    }
-
-    if ((c >> 3) == 0x1E) {
-      /* 4-byte sequence: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
-      if (i + 3 >= len) return 0;
-      if (((s[i+1] & 0xC0) != 0x80) || ((s[i+2] & 0xC0) != 0x80) || ((s[i+3] & 0xC0) != 0x80)) return 0;
-      unsigned int code = ((c & 0x07) << 18) | ((s[i+1] & 0x3F) << 12) | ((s[i+2] & 0x3F) << 6) | (s[i+3] & 0x3F);
-      if (code < 0x10000 || code > 0x10FFFF) return 0; /* overlong or out of range */
-      i += 4;
-      continue;
-    }
-
-    return 0; /* invalid leading byte */
-  }
-
-  return 1;
+  return text_utf8_validate(buf, len, NULL) == TEXT_UTF8_VALID;
 }
 
 /* Dynamic buffer implementation */
@@ -1,12 +1,15 @@
 #include "../src/csv/csv_internal.h"
 #include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <functional>
 #include <ghoti.io/text/csv.h>
 #include <gtest/gtest.h>
 #include <string.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Core Types and Error Handling
@@ -585,6 +588,101 @@ TEST(CsvUtils, UTF8ValidationTooLarge) {
   EXPECT_EQ(result, CSV_UTF8_INVALID);
 }
 
+TEST(CsvUtils, UTF8ValidationSurrogate) {
+  csv_position pos = {0, 1, 1};
+  // Encoded UTF-16 surrogate half (U+D800) is not valid UTF-8
+  const char * input = "ab\xED\xA0\x80";
+  size_t input_len = 5;
+
+  GTEXT_CSV_Status error = GTEXT_CSV_OK;
+  csv_utf8_result result =
+      csv_validate_utf8(input, input_len, &pos, true, &error);
+
+  EXPECT_EQ(result, CSV_UTF8_INVALID);
+  EXPECT_EQ(pos.offset, 2u); // Stops at the offending sequence
+}
+
+TEST(CsvStream, UTF8ValidationRejectsInvalid) {
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event * event,
+                                    void * user_data) -> GTEXT_CSV_Status {
+    auto * fields_vec = (std::vector<std::string> *)user_data;
+    if (event->type == GTEXT_CSV_EVENT_FIELD) {
+      fields_vec->push_back(std::string(event->data, event->data_len));
+    }
+    return GTEXT_CSV_OK;
+  };
+
+  // Invalid byte on the second line, after enough data to use block scanning
+  std::string input = "name,city\n" + std::string(40, 'x') + ",ab\xFF" "c\n";
+  std::vector<std::string> fields;
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  GTEXT_CSV_Stream * stream = gtext_csv_stream_new(&opts, callback, &fields);
+  ASSERT_NE(stream, nullptr);
+
+  GTEXT_CSV_Error err{};
+  GTEXT_CSV_Status status =
+      gtext_csv_stream_feed(stream, input.data(), input.size(), &err);
+  EXPECT_EQ(status, GTEXT_CSV_E_INVALID_UTF8);
+  EXPECT_EQ(err.byte_offset, input.find('\xFF'));
+  EXPECT_EQ(err.line, 2);
+  EXPECT_EQ(err.column, 44);
+  gtext_csv_error_free(&err);
+  gtext_csv_stream_free(stream);
+
+  // The same input is accepted when validation is disabled
+  fields.clear();
+  opts.validate_utf8 = false;
+  stream = gtext_csv_stream_new(&opts, callback, &fields);
+  ASSERT_NE(stream, nullptr);
+  EXPECT_EQ(gtext_csv_stream_feed(stream, input.data(), input.size(), nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_stream_finish(stream, nullptr), GTEXT_CSV_OK);
+  EXPECT_EQ(fields.size(), 4u);
+  gtext_csv_stream_free(stream);
+}
+
+TEST(CsvStream, UTF8ValidationAcrossChunks) {
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event * event,
+                                    void * user_data) -> GTEXT_CSV_Status {
+    auto * fields_vec = (std::vector<std::string> *)user_data;
+    if (event->type == GTEXT_CSV_EVENT_FIELD) {
+      fields_vec->push_back(std::string(event->data, event->data_len));
+    }
+    return GTEXT_CSV_OK;
+  };
+
+  // A multi-byte sequence split between feeds is valid
+  const std::string input = "caf\xC3\xA9,\xF0\x9F\x98\x80\n";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  for (size_t split = 0; split <= input.size(); split++) {
+    std::vector<std::string> fields;
+    GTEXT_CSV_Stream * stream = gtext_csv_stream_new(&opts, callback, &fields);
+    ASSERT_NE(stream, nullptr);
+    EXPECT_EQ(gtext_csv_stream_feed(stream, input.data(), split, nullptr),
+        GTEXT_CSV_OK);
+    EXPECT_EQ(gtext_csv_stream_feed(
+                  stream, input.data() + split, input.size() - split, nullptr),
+        GTEXT_CSV_OK);
+    EXPECT_EQ(gtext_csv_stream_finish(stream, nullptr), GTEXT_CSV_OK);
+    ASSERT_EQ(fields.size(), 2u) << "split=" << split;
+    EXPECT_EQ(fields[0], "caf\xC3\xA9");
+    EXPECT_EQ(fields[1], "\xF0\x9F\x98\x80");
+    gtext_csv_stream_free(stream);
+  }
+
+  // A sequence cut off by the end of input is reported by finish
+  std::vector<std::string> fields;
+  GTEXT_CSV_Stream * stream = gtext_csv_stream_new(&opts, callback, &fields);
+  ASSERT_NE(stream, nullptr);
+  EXPECT_EQ(gtext_csv_stream_feed(stream, "a,b\xE4\xB8", 5, nullptr),
+      GTEXT_CSV_OK);
+  GTEXT_CSV_Error err{};
+  EXPECT_EQ(gtext_csv_stream_finish(stream, &err), GTEXT_CSV_E_INVALID_UTF8);
+  EXPECT_EQ(err.byte_offset, 3u);
+  gtext_csv_error_free(&err);
+  gtext_csv_stream_free(stream);
+}
+
 // Streaming Parser Tests
 TEST(CsvStream, BasicParsing) {
   const char * input = "a,b,c\n1,2,3\n";
@@ -880,6 +978,104 @@ TEST(CsvStream, LargeFieldSpanningChunks) {
   EXPECT_EQ(fields[1], "small");
 }
 
+// Test long fields whose special bytes fall at every offset within a scan
+// block, fed whole and in several chunk sizes
+TEST(CsvStream, LongFieldsWithSpecialsAtEveryOffset) {
+  std::string input;
+  std::vector<std::string> expected;
+  for (size_t len = 0; len < 80; ++len) {
+    std::string plain;
+    for (size_t i = 0; i < len; ++i) {
+      plain += (char)('a' + (i % 26));
+    }
+    // Unquoted field of this length
+    input += plain + ",";
+    expected.push_back(plain);
+    // Quoted field with a delimiter, newline, and doubled quote at offset len
+    std::string content = plain + ",x\ny";
+    input += "\"" + content + "\"\"z\"\n";
+    expected.push_back(content + "\"z");
+  }
+
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event * event,
+                                    void * user_data) -> GTEXT_CSV_Status {
+    auto * fields_vec = (std::vector<std::string> *)user_data;
+    if (event->type == GTEXT_CSV_EVENT_FIELD) {
+      fields_vec->push_back(std::string(event->data, event->data_len));
+    }
+    return GTEXT_CSV_OK;
+  };
+
+  for (size_t chunk_size : {input.size(), (size_t)1, (size_t)7, (size_t)64}) {
+    std::vector<std::string> fields;
+    GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+    GTEXT_CSV_Stream * stream = gtext_csv_stream_new(&opts, callback, &fields);
+    ASSERT_NE(stream, nullptr);
+
+    for (size_t i = 0; i < input.size(); i += chunk_size) {
+      size_t chunk_len = std::min(chunk_size, input.size() - i);
+      ASSERT_EQ(gtext_csv_stream_feed(
+                    stream, input.c_str() + i, chunk_len, nullptr),
+          GTEXT_CSV_OK)
+          << "Failed at offset " << i << " with chunk size " << chunk_size;
+    }
+    EXPECT_EQ(gtext_csv_stream_finish(stream, nullptr), GTEXT_CSV_OK);
+    gtext_csv_stream_free(stream);
+
+    EXPECT_EQ(fields, expected) << "Chunk size " << chunk_size;
+  }
+}
+
+// Test an unquoted field starting on the last byte of a chunk when the
+// caller reuses its chunk buffer
+TEST(CsvStream, FieldStartingAtChunkEnd) {
+  std::vector<std::string> fields;
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event * event,
+                                    void * user_data) -> GTEXT_CSV_Status {
+    auto * fields_vec = (std::vector<std::string> *)user_data;
+    if (event->type == GTEXT_CSV_EVENT_FIELD) {
+      fields_vec->push_back(std::string(event->data, event->data_len));
+    }
+    return GTEXT_CSV_OK;
+  };
+
+  GTEXT_CSV_Stream * stream = gtext_csv_stream_new(nullptr, callback, &fields);
+  ASSERT_NE(stream, nullptr);
+  char chunk[4];
+  memcpy(chunk, "ab,c", 4);
+  ASSERT_EQ(gtext_csv_stream_feed(stream, chunk, 4, nullptr), GTEXT_CSV_OK);
+  memcpy(chunk, "de\n#", 4);
+  ASSERT_EQ(gtext_csv_stream_feed(stream, chunk, 3, nullptr), GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_stream_finish(stream, nullptr), GTEXT_CSV_OK);
+  gtext_csv_stream_free(stream);
+
+  EXPECT_EQ(fields, (std::vector<std::string>{"ab", "cde"}));
+}
+
+// Test record size limit is enforced inside long fields consumed in bulk
+TEST(CsvStream, RecordLimitInsideLongFields) {
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event *,
+                                    void *) -> GTEXT_CSV_Status {
+    return GTEXT_CSV_OK;
+  };
+
+  for (const char * quote : {"", "\""}) {
+    std::string input = std::string(quote) + std::string(200, 'a') + quote +
+        ",b\n";
+    GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+    opts.max_record_bytes = 100;
+    GTEXT_CSV_Stream * stream = gtext_csv_stream_new(&opts, callback, nullptr);
+    ASSERT_NE(stream, nullptr);
+
+    GTEXT_CSV_Error err{};
+    EXPECT_EQ(gtext_csv_stream_feed(stream, input.c_str(), input.size(), &err),
+        GTEXT_CSV_E_LIMIT)
+        << "Quote: '" << quote << "'";
+    gtext_csv_error_free(&err);
+    gtext_csv_stream_free(stream);
+  }
+}
+
 // Test multiple fields spanning chunks in same record
 TEST(CsvStream, MultipleFieldsSpanningChunks) {
   const char * chunk1 = "\"field1";
@@ -1214,11 +1410,8 @@ TEST(CsvStream, NewlineSplitAcrossChunksAfterQuotedField) {
 // Edge Case Tests - Chunk Boundary Scenarios
 
 // Test 1: CRLF newline split across chunks
-// CR in one chunk, LF in next chunk
-// Note: Current implementation cannot detect CRLF when split across chunks
-// (it requires both characters in the same buffer). When split, CR and LF
-// are treated as separate newlines. This test verifies the parser handles
-// this gracefully without crashing.
+// CR in one chunk, LF in next chunk. The stream holds the CR back until the
+// next chunk shows it starts a CRLF, so it is one newline.
 TEST(CsvStream, CrlfNewlineSplitAcrossChunks) {
   const char * chunk1 = "field1\r";
   const char * chunk2 = "\nfield2\n";
@@ -1265,13 +1458,41 @@ TEST(CsvStream, CrlfNewlineSplitAcrossChunks) {
 
   gtext_csv_stream_free(stream);
 
-  // When CRLF is split, CR ends the first record, LF starts a new record
-  // (empty), then field2 is in the next record So we get: record1: field1,
-  // record2: (empty), record3: field2
-  EXPECT_GE(fields.size(), 1u);
-  EXPECT_EQ(fields[0], "field1");
-  // The exact behavior depends on how CR and LF are handled when split
-  // For now, just verify it doesn't crash and processes the data
+  EXPECT_EQ(fields, (std::vector<std::string>{"field1", "field2"}));
+  EXPECT_EQ(record_boundaries, (std::vector<size_t>{1, 2}));
+}
+
+// Test a CRLF split across chunks ends records after empty and quoted fields
+// in the default dialect, where a lone CR is not a newline
+TEST(CsvStream, CrlfSplitAfterEmptyAndQuotedFields) {
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event * event,
+                                    void * user_data) -> GTEXT_CSV_Status {
+    auto * out = (std::string *)user_data;
+    if (event->type == GTEXT_CSV_EVENT_FIELD) {
+      *out += "[" + std::string(event->data, event->data_len) + "]";
+    }
+    else if (event->type == GTEXT_CSV_EVENT_RECORD_END) {
+      *out += "/";
+    }
+    return GTEXT_CSV_OK;
+  };
+
+  const std::pair<const char *, const char *> cases[] = {{"a,b\r", "b"},
+      {"a,\r", ""}, {"a,\"b\"\r", "b"}, {"a,\"\"\r", ""}};
+  for (const auto & [first, field] : cases) {
+    std::string out;
+    GTEXT_CSV_Stream * stream = gtext_csv_stream_new(nullptr, callback, &out);
+    ASSERT_NE(stream, nullptr);
+    EXPECT_EQ(gtext_csv_stream_feed(stream, first, strlen(first), nullptr),
+        GTEXT_CSV_OK)
+        << first;
+    EXPECT_EQ(
+        gtext_csv_stream_feed(stream, "\nc,d\r", 5, nullptr), GTEXT_CSV_OK);
+    EXPECT_EQ(gtext_csv_stream_feed(stream, "\n", 1, nullptr), GTEXT_CSV_OK);
+    EXPECT_EQ(gtext_csv_stream_finish(stream, nullptr), GTEXT_CSV_OK);
+    gtext_csv_stream_free(stream);
+    EXPECT_EQ(out, std::string("[a][") + field + "]/[c][d]/") << first;
+  }
 }
 
 // Test 2: Newline immediately after unquoted field at chunk boundary
@@ -1985,6 +2206,212 @@ TEST(CsvStream, MultipleRecordsWithVariousEdgeCases) {
   EXPECT_EQ(record_boundaries[1], 4u); // Record 2: field2, "text""
   EXPECT_EQ(record_boundaries[2], 5u); // Record 3: field3
 }
+
+// Test backslash escapes are resolved the same wherever the chunks split
+TEST(CsvStream, BackslashEscapesAcrossChunks) {
+  const std::string input = "a,\"x\\ny\\\"z\\\\\",b\n\"\\t\",c\n";
+  const std::vector<std::string> expected = {
+      "a", "x\ny\"z\\", "b", "\t", "c"};
+
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event * event,
+                                    void * user_data) -> GTEXT_CSV_Status {
+    auto * fields_vec = (std::vector<std::string> *)user_data;
+    if (event->type == GTEXT_CSV_EVENT_FIELD) {
+      fields_vec->push_back(std::string(event->data, event->data_len));
+    }
+    return GTEXT_CSV_OK;
+  };
+
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.escape = GTEXT_CSV_ESCAPE_BACKSLASH;
+  for (size_t split = 0; split <= input.size(); ++split) {
+    std::vector<std::string> fields;
+    GTEXT_CSV_Stream * stream = gtext_csv_stream_new(&opts, callback, &fields);
+    ASSERT_NE(stream, nullptr);
+    // The first chunk is overwritten once fed, as a reused read buffer would be
+    std::string chunk = input.substr(0, split);
+    ASSERT_EQ(gtext_csv_stream_feed(stream, chunk.data(), split, nullptr),
+        GTEXT_CSV_OK);
+    chunk.assign(chunk.size(), '#');
+    ASSERT_EQ(gtext_csv_stream_feed(stream, input.data() + split,
+                  input.size() - split, nullptr),
+        GTEXT_CSV_OK);
+    EXPECT_EQ(gtext_csv_stream_finish(stream, nullptr), GTEXT_CSV_OK);
+    gtext_csv_stream_free(stream);
+    EXPECT_EQ(fields, expected) << "Split at " << split;
+  }
+}
+
+// Fields seen through field views, decoded, and whether each view was a
+// single piece inside the chunk being fed (or empty)
+struct FieldViewCapture {
+  GTEXT_CSV_Dialect dialect;
+  const char * chunk = nullptr;
+  size_t chunk_len = 0;
+  std::vector<std::string> fields;
+  std::vector<bool> in_place;
+  size_t prefixed = 0;
+};
+
+static GTEXT_CSV_Status capture_field_view(
+    const GTEXT_CSV_Event * event, void * user_data) {
+  auto * capture = (FieldViewCapture *)user_data;
+  if (event->type != GTEXT_CSV_EVENT_FIELD) {
+    EXPECT_EQ(event->view, nullptr);
+    return GTEXT_CSV_OK;
+  }
+  const GTEXT_CSV_Field_View * view = event->view;
+  EXPECT_NE(view, nullptr);
+  if (!view) {
+    return GTEXT_CSV_E_INVALID;
+  }
+  std::string value(view->prefix_len + view->data_len, '\0');
+  value.resize(gtext_csv_field_view_decode(view, &capture->dialect,
+      value.empty() ? nullptr : &value[0]));
+  if (event->data) {
+    EXPECT_EQ(std::string(event->data, event->data_len), value);
+  }
+  else {
+    EXPECT_TRUE(view->prefix_len > 0 || view->needs_unescape);
+  }
+  capture->fields.push_back(value);
+  capture->in_place.push_back(view->prefix_len == 0 &&
+      (view->data_len == 0 ||
+          (view->data >= capture->chunk &&
+              view->data + view->data_len <=
+                  capture->chunk + capture->chunk_len)));
+  if (view->prefix_len > 0) {
+    capture->prefixed++;
+  }
+  return GTEXT_CSV_OK;
+}
+
+// Feed `input` in two chunks split at `split`, with or without field views,
+// and return the field values
+static std::vector<std::string> parse_split_fields(const std::string & input,
+    size_t split, const GTEXT_CSV_Parse_Options & opts, bool views,
+    size_t * prefixed = nullptr) {
+  FieldViewCapture capture;
+  capture.dialect = opts.dialect;
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event * event,
+                                    void * user_data) -> GTEXT_CSV_Status {
+    if (event->type == GTEXT_CSV_EVENT_FIELD) {
+      ((FieldViewCapture *)user_data)
+          ->fields.push_back(std::string(event->data, event->data_len));
+    }
+    return GTEXT_CSV_OK;
+  };
+  GTEXT_CSV_Stream * stream = gtext_csv_stream_new(
+      &opts, views ? capture_field_view : callback, &capture);
+  EXPECT_NE(stream, nullptr);
+  if (!stream) {
+    return {};
+  }
+  if (views) {
+    EXPECT_EQ(gtext_csv_stream_set_field_views(stream, true), GTEXT_CSV_OK);
+  }
+
+  // Each chunk is overwritten once fed, as a reused read buffer would be
+  std::string chunk = input.substr(0, split);
+  for (int i = 0; i < 2; ++i) {
+    capture.chunk = chunk.data();
+    capture.chunk_len = chunk.size();
+    EXPECT_EQ(
+        gtext_csv_stream_feed(stream, chunk.data(), chunk.size(), nullptr),
+        GTEXT_CSV_OK);
+    chunk.assign(chunk.size(), '#');
+    chunk = input.substr(split);
+  }
+  EXPECT_EQ(gtext_csv_stream_finish(stream, nullptr), GTEXT_CSV_OK);
+  gtext_csv_stream_free(stream);
+  if (prefixed) {
+    *prefixed = capture.prefixed;
+  }
+  return capture.fields;
+}
+
+// Test field views report fields inside the chunk in place, and leave
+// escape sequences for the consumer
+TEST(CsvStream, FieldViewsInPlace) {
+  const std::string input = "a,\"b,c\",\"d\"\"e\",,f\n\"\",g\n";
+  FieldViewCapture capture;
+  capture.dialect = gtext_csv_parse_options_default().dialect;
+  capture.chunk = input.data();
+  capture.chunk_len = input.size();
+
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event * event,
+                                    void * user_data) -> GTEXT_CSV_Status {
+    if (event->type == GTEXT_CSV_EVENT_FIELD && event->view &&
+        event->view->needs_unescape) {
+      EXPECT_EQ(event->data, nullptr);
+      EXPECT_EQ(std::string(event->view->data, event->view->data_len),
+          "d\"\"e");
+    }
+    return capture_field_view(event, user_data);
+  };
+
+  GTEXT_CSV_Stream * stream = gtext_csv_stream_new(nullptr, callback, &capture);
+  ASSERT_NE(stream, nullptr);
+  ASSERT_EQ(gtext_csv_stream_set_field_views(stream, true), GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_stream_feed(stream, input.data(), input.size(), nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_stream_finish(stream, nullptr), GTEXT_CSV_OK);
+  gtext_csv_stream_free(stream);
+
+  EXPECT_EQ(capture.fields,
+      (std::vector<std::string>{"a", "b,c", "d\"e", "", "f", "", "g"}));
+  for (size_t i = 0; i < capture.in_place.size(); ++i) {
+    EXPECT_TRUE(capture.in_place[i]) << "Field " << i;
+  }
+}
+
+// Test field views decode to the same fields as a stream without them for
+// every split of the input, with the earlier chunk's part as the prefix
+TEST(CsvStream, FieldViewsAcrossChunks) {
+  GTEXT_CSV_Parse_Options doubled = gtext_csv_parse_options_default();
+  GTEXT_CSV_Parse_Options backslash = gtext_csv_parse_options_default();
+  backslash.dialect.escape = GTEXT_CSV_ESCAPE_BACKSLASH;
+  const std::pair<std::string, GTEXT_CSV_Parse_Options> cases[] = {
+      {"alpha,\"be\"\"ta\",\"\",gamma\r\n\"x\"\"\"\"y\",\"\"\"\",z\n"
+       "\"multi\nline\",,\"q\"\"\"\r\nlast",
+          doubled},
+      {"a,\"x\\ny\\\"z\\\\\",b\n\"\\t\\\\\",\"plain\",c", backslash},
+  };
+
+  for (const auto & test_case : cases) {
+    const std::string & input = test_case.first;
+    const GTEXT_CSV_Parse_Options & opts = test_case.second;
+    size_t prefixed_total = 0;
+    for (size_t split = 0; split <= input.size(); ++split) {
+      size_t prefixed = 0;
+      std::vector<std::string> expected =
+          parse_split_fields(input, split, opts, false);
+      EXPECT_EQ(parse_split_fields(input, split, opts, true, &prefixed),
+          expected)
+          << "Split at " << split << " of " << input;
+      prefixed_total += prefixed;
+    }
+    EXPECT_GT(prefixed_total, 0u);
+  }
+}
+
+// Test field views can only be switched on before input is fed
+TEST(CsvStream, FieldViewsSetBeforeInput) {
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event *,
+                                    void *) -> GTEXT_CSV_Status {
+    return GTEXT_CSV_OK;
+  };
+  EXPECT_EQ(gtext_csv_stream_set_field_views(nullptr, true),
+      GTEXT_CSV_E_INVALID);
+
+  GTEXT_CSV_Stream * stream = gtext_csv_stream_new(nullptr, callback, nullptr);
+  ASSERT_NE(stream, nullptr);
+  EXPECT_EQ(gtext_csv_stream_set_field_views(stream, true), GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_stream_feed(stream, "a,b\n", 4, nullptr), GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_stream_set_field_views(stream, false),
+      GTEXT_CSV_E_INVALID);
+  gtext_csv_stream_free(stream);
+}
 TEST(CsvTable, BasicParsing) {
   const char * input = "a,b,c\n1,2,3\n4,5,6\n";
   size_t input_len = strlen(input);
@@ -3612,6 +4039,43 @@ TEST(CsvTableWrite, CustomDialect) {
   gtext_csv_sink_buffer_free(&sink);
 }
 
+// Test table output is gathered into blocks and still round-trips
+TEST(CsvTableWrite, BlockedOutputRoundTrips) {
+  std::string input;
+  for (size_t i = 0; i < 4000; i++) {
+    input += std::to_string(i) + ",\"a, \"\"q\"\" b\",\"x\ny\",plain\n";
+  }
+  // A field longer than an output block, with quotes throughout
+  input += "big,\"";
+  for (size_t i = 0; i < 20000; i++) {
+    input += "ab\"\"c";
+  }
+  input += "\",x,y\n";
+
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input.data(), input.size(), nullptr, nullptr);
+  ASSERT_NE(table, nullptr);
+
+  struct Output {
+    std::string data;
+    size_t calls;
+  } output = {"", 0};
+  GTEXT_CSV_Sink sink;
+  sink.write = [](void * user, const char * bytes,
+                   size_t len) -> GTEXT_CSV_Status {
+    Output * out = static_cast<Output *>(user);
+    out->data.append(bytes, len);
+    out->calls++;
+    return GTEXT_CSV_OK;
+  };
+  sink.user = &output;
+  ASSERT_EQ(gtext_csv_write_table(&sink, nullptr, table), GTEXT_CSV_OK);
+  EXPECT_EQ(output.data, input);
+  EXPECT_LT(output.calls, 20u);
+
+  gtext_csv_free_table(table);
+}
+
 // ============================================================================
 // Write Trimming Tests
 // ============================================================================
@@ -3888,122 +4352,2361 @@ TEST(CsvWriteTrimming, RoundTripLossOfTrailingEmpties) {
   field = gtext_csv_field(table2, 1, 1, &len);
   EXPECT_EQ(std::string(field, len), "d");
 
-  gtext_csv_free_table(table1);
-  gtext_csv_free_table(table2);
-  gtext_csv_sink_buffer_free(&sink);
+  gtext_csv_free_table(table1);
+  gtext_csv_free_table(table2);
+  gtext_csv_sink_buffer_free(&sink);
+}
+
+// In-Situ Mode Tests
+TEST(CsvTableInSitu, BasicInSitu) {
+  // Simple CSV with unquoted fields - should use in-situ mode when possible
+  const char * input = "a,b,c";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.in_situ_mode = true;
+  opts.validate_utf8 = false; // UTF-8 validation disables in-situ mode
+
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+  EXPECT_NE(table, nullptr);
+  EXPECT_EQ(gtext_csv_row_count(table), 1u);
+  EXPECT_EQ(gtext_csv_col_count(table, 0), 3u);
+
+  // Verify content is correct (in-situ mode may or may not be used depending on
+  // implementation)
+  size_t len;
+  const char * field0 = gtext_csv_field(table, 0, 0, &len);
+  EXPECT_NE(field0, nullptr);
+  EXPECT_EQ(len, 1u);
+  EXPECT_EQ(std::string(field0, len), "a");
+
+  const char * field1 = gtext_csv_field(table, 0, 1, &len);
+  EXPECT_NE(field1, nullptr);
+  EXPECT_EQ(len, 1u);
+  EXPECT_EQ(std::string(field1, len), "b");
+
+  gtext_csv_free_table(table);
+}
+
+TEST(CsvTableInSitu, QuotedFieldsFallback) {
+  // Quoted fields with doubled quotes need unescaping - should fall back to
+  // copy
+  const char * input = "a,\"b\"\"c\",d";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.in_situ_mode = true;
+  opts.validate_utf8 = false;
+
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+  EXPECT_NE(table, nullptr);
+  EXPECT_EQ(gtext_csv_row_count(table), 1u);
+  EXPECT_EQ(gtext_csv_col_count(table, 0), 3u);
+
+  // Verify content is correct
+  size_t len;
+  const char * field0 = gtext_csv_field(table, 0, 0, &len);
+  EXPECT_EQ(std::string(field0, len), "a");
+
+  // Middle field (quoted with doubled quotes) needs unescaping - should be
+  // copied
+  const char * field1 = gtext_csv_field(table, 0, 1, &len);
+  EXPECT_NE(field1, nullptr);
+  EXPECT_EQ(len, 3u); // "b"c" -> b"c (unescaped)
+  EXPECT_EQ(std::string(field1, len), "b\"c");
+
+  const char * field2 = gtext_csv_field(table, 0, 2, &len);
+  EXPECT_EQ(std::string(field2, len), "d");
+
+  gtext_csv_free_table(table);
+}
+
+TEST(CsvTableInSitu, Utf8ValidationDisablesInSitu) {
+  // When UTF-8 validation is enabled, in-situ mode is disabled
+  const char * input = "a,b,c";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.in_situ_mode = true;
+  opts.validate_utf8 = true; // This disables in-situ mode
+
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+  EXPECT_NE(table, nullptr);
+  EXPECT_EQ(gtext_csv_row_count(table), 1u);
+  EXPECT_EQ(gtext_csv_col_count(table, 0), 3u);
+
+  // Fields should be copied (not in-situ) when UTF-8 validation is enabled
+  // We verify by checking content is correct
+  size_t len;
+  const char * field0 = gtext_csv_field(table, 0, 0, &len);
+  EXPECT_NE(field0, nullptr);
+  EXPECT_EQ(len, 1u);
+  EXPECT_EQ(std::string(field0, len), "a");
+
+  gtext_csv_free_table(table);
+}
+
+TEST(CsvTableInSitu, MixedMode) {
+  // Mix of fields: some in-situ, some copied (due to unescaping)
+  const char * input = "plain,\"quoted\"\"field\",another";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.in_situ_mode = true;
+  opts.validate_utf8 = false;
+
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+  EXPECT_NE(table, nullptr);
+  EXPECT_EQ(gtext_csv_row_count(table), 1u);
+  EXPECT_EQ(gtext_csv_col_count(table, 0), 3u);
+
+  // Verify content is correct (regardless of in-situ or copied)
+  size_t len;
+  const char * field0 = gtext_csv_field(table, 0, 0, &len);
+  EXPECT_EQ(std::string(field0, len), "plain");
+
+  const char * field1 = gtext_csv_field(table, 0, 1, &len);
+  EXPECT_EQ(std::string(field1, len), "quoted\"field"); // Unescaped
+
+  const char * field2 = gtext_csv_field(table, 0, 2, &len);
+  EXPECT_EQ(std::string(field2, len), "another");
+
+  gtext_csv_free_table(table);
+}
+
+// ============================================================================
+// Parallel Table Parsing Tests
+// ============================================================================
+
+// Build a large input whose quoted fields contain newlines, delimiters, and
+// doubled quotes so that naive newline splitting would cut records apart
+static std::string make_parallel_csv_input(size_t rows) {
+  std::string input = "id,text,note\n";
+  for (size_t i = 0; i < rows; i++) {
+    input += std::to_string(i) + ",";
+    switch (i % 4) {
+    case 0:
+      input += "plain" + std::to_string(i);
+      break;
+    case 1:
+      input += "\"multi\nline, with \"\"quotes\"\" " + std::to_string(i) + "\"";
+      break;
+    case 2:
+      input += "\"\"";
+      break;
+    default:
+      input += "\"" + std::string(i % 97, 'x') + "\"";
+      break;
+    }
+    input += i % 3 == 0 ? ",\r\n" : ",n\n";
+  }
+  return input;
+}
+
+// Test parallel parsing produces the same table as a serial parse
+TEST(CsvTableParallel, MatchesSerial) {
+  std::string input = make_parallel_csv_input(20000);
+  ASSERT_GT(input.size(), 512u * 1024u);
+
+  for (bool in_situ : {false, true}) {
+    GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+    opts.dialect.treat_first_row_as_header = true;
+    opts.in_situ_mode = in_situ;
+    opts.validate_utf8 = !in_situ;
+
+    GTEXT_CSV_Table * serial =
+        gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+    ASSERT_NE(serial, nullptr);
+    opts.parse_threads = 8;
+    GTEXT_CSV_Table * parallel =
+        gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+    ASSERT_NE(parallel, nullptr);
+
+    ASSERT_EQ(gtext_csv_row_count(serial), 20000u);
+    ASSERT_EQ(gtext_csv_row_count(parallel), gtext_csv_row_count(serial));
+    size_t note_idx = 0;
+    EXPECT_EQ(gtext_csv_header_index(parallel, "note", &note_idx), GTEXT_CSV_OK);
+    EXPECT_EQ(note_idx, 2u);
+    for (size_t row = 0; row < gtext_csv_row_count(serial); row++) {
+      ASSERT_EQ(gtext_csv_col_count(parallel, row),
+          gtext_csv_col_count(serial, row))
+          << "Row " << row;
+      for (size_t col = 0; col < gtext_csv_col_count(serial, row); col++) {
+        size_t serial_len = 0;
+        size_t parallel_len = 0;
+        const char * a = gtext_csv_field(serial, row, col, &serial_len);
+        const char * b = gtext_csv_field(parallel, row, col, &parallel_len);
+        ASSERT_EQ(std::string(b, parallel_len), std::string(a, serial_len))
+            << "Row " << row << ", column " << col;
+      }
+    }
+
+    gtext_csv_free_table(serial);
+    gtext_csv_free_table(parallel);
+  }
+}
+
+// Test a parallel parse of malformed input reports the serial error
+TEST(CsvTableParallel, ErrorMatchesSerial) {
+  std::string input = make_parallel_csv_input(20000);
+  // Unquoted quote near the end breaks the quote parity of every later cut
+  input.insert(input.size() * 3 / 4, "bad\"field,");
+
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  GTEXT_CSV_Error serial_err{};
+  EXPECT_EQ(gtext_csv_parse_table(
+                input.data(), input.size(), &opts, &serial_err),
+      nullptr);
+
+  opts.parse_threads = 8;
+  GTEXT_CSV_Error parallel_err{};
+  EXPECT_EQ(gtext_csv_parse_table(
+                input.data(), input.size(), &opts, &parallel_err),
+      nullptr);
+
+  EXPECT_NE(serial_err.code, GTEXT_CSV_OK);
+  EXPECT_EQ(parallel_err.code, serial_err.code);
+  EXPECT_EQ(parallel_err.byte_offset, serial_err.byte_offset);
+  EXPECT_EQ(parallel_err.line, serial_err.line);
+  EXPECT_EQ(parallel_err.column, serial_err.column);
+  gtext_csv_error_free(&serial_err);
+  gtext_csv_error_free(&parallel_err);
+}
+
+// Write a table to a growable buffer sink and return the output
+static std::string write_table_to_string(
+    const GTEXT_CSV_Table * table, const GTEXT_CSV_Write_Options * opts) {
+  GTEXT_CSV_Sink sink;
+  EXPECT_EQ(gtext_csv_sink_buffer(&sink), GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_write_table(&sink, opts, table), GTEXT_CSV_OK);
+  std::string output(
+      gtext_csv_sink_buffer_data(&sink), gtext_csv_sink_buffer_size(&sink));
+  gtext_csv_sink_buffer_free(&sink);
+  return output;
+}
+
+// Test parallel table writes are byte-identical to serial writes
+TEST(CsvTableParallel, WriteMatchesSerial) {
+  std::string input = make_parallel_csv_input(20000);
+
+  for (GTEXT_CSV_Layout layout :
+      {GTEXT_CSV_LAYOUT_ROWS, GTEXT_CSV_LAYOUT_COLUMNS}) {
+    GTEXT_CSV_Parse_Options parse_opts = gtext_csv_parse_options_default();
+    parse_opts.dialect.treat_first_row_as_header = true;
+    parse_opts.layout = layout;
+    GTEXT_CSV_Table * table = gtext_csv_parse_table(
+        input.data(), input.size(), &parse_opts, nullptr);
+    ASSERT_NE(table, nullptr);
+
+    for (bool trim : {false, true}) {
+      GTEXT_CSV_Write_Options opts = gtext_csv_write_options_default();
+      opts.trim_trailing_empty_fields = trim;
+      opts.newline = "\r\n";
+      std::string serial = write_table_to_string(table, &opts);
+      ASSERT_GT(serial.size(), input.size() / 2);
+      for (size_t threads : {2u, 3u, 8u}) {
+        opts.write_threads = threads;
+        EXPECT_EQ(write_table_to_string(table, &opts), serial)
+            << "threads " << threads << " trim " << trim;
+      }
+    }
+    gtext_csv_free_table(table);
+  }
+}
+
+// Test a failing sink stops a parallel write with the sink's error
+TEST(CsvTableParallel, WriteSinkErrorStops) {
+  std::string input = make_parallel_csv_input(40000);
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input.data(), input.size(), nullptr, nullptr);
+  ASSERT_NE(table, nullptr);
+
+  size_t calls = 0;
+  GTEXT_CSV_Sink sink;
+  sink.write = [](void * user, const char *, size_t) -> GTEXT_CSV_Status {
+    size_t * count = static_cast<size_t *>(user);
+    return ++*count == 3 ? GTEXT_CSV_E_WRITE : GTEXT_CSV_OK;
+  };
+  sink.user = &calls;
+  GTEXT_CSV_Write_Options opts = gtext_csv_write_options_default();
+  opts.write_threads = 4;
+  EXPECT_EQ(gtext_csv_write_table(&sink, &opts, table), GTEXT_CSV_E_WRITE);
+  EXPECT_EQ(calls, 3u);
+  gtext_csv_free_table(table);
+}
+
+// ============================================================================
+// Column-Major Layout Tests
+// ============================================================================
+
+// Write a table to a string with default options
+static std::string write_table_to_string(const GTEXT_CSV_Table * table) {
+  GTEXT_CSV_Sink sink;
+  EXPECT_EQ(gtext_csv_sink_buffer(&sink), GTEXT_CSV_OK);
+  GTEXT_CSV_Write_Options write_opts = gtext_csv_write_options_default();
+  EXPECT_EQ(gtext_csv_write_table(&sink, &write_opts, table), GTEXT_CSV_OK);
+  std::string output(
+      gtext_csv_sink_buffer_data(&sink), gtext_csv_sink_buffer_size(&sink));
+  gtext_csv_sink_buffer_free(&sink);
+  return output;
+}
+
+// Test parsing straight into the column layout and reading column views
+TEST(CsvTableColumnar, ParseAndView) {
+  const char * input = "name,age,city\nAlice,30,\"New\nYork\"\nBob,,Paris\n";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  opts.layout = GTEXT_CSV_LAYOUT_COLUMNS;
+
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+  ASSERT_NE(table, nullptr);
+  EXPECT_EQ(gtext_csv_table_layout(table), GTEXT_CSV_LAYOUT_COLUMNS);
+  EXPECT_EQ(gtext_csv_row_count(table), 2u);
+  EXPECT_EQ(gtext_csv_col_count(table, 0), 3u);
+  EXPECT_EQ(gtext_csv_validate_table(table), GTEXT_CSV_OK);
+
+  size_t len = 0;
+  EXPECT_STREQ(gtext_csv_field(table, 0, 2, &len), "New\nYork");
+  EXPECT_EQ(len, 8u);
+  EXPECT_STREQ(gtext_csv_field(table, 1, 1, &len), "");
+  EXPECT_EQ(len, 0u);
+  EXPECT_EQ(gtext_csv_field(table, 1, 3, &len), nullptr);
+
+  size_t city_idx = 0;
+  EXPECT_EQ(gtext_csv_header_index(table, "city", &city_idx), GTEXT_CSV_OK);
+  EXPECT_EQ(city_idx, 2u);
+
+  GTEXT_CSV_Column_View view;
+  ASSERT_EQ(gtext_csv_column_view(table, 0, &view), GTEXT_CSV_OK);
+  ASSERT_EQ(view.count, 2u);
+  EXPECT_EQ(std::string(view.heap + view.offsets[0], view.lengths[0]), "Alice");
+  EXPECT_EQ(std::string(view.heap + view.offsets[1], view.lengths[1]), "Bob");
+  EXPECT_EQ(gtext_csv_column_view(table, 3, &view), GTEXT_CSV_E_INVALID);
+
+  EXPECT_EQ(write_table_to_string(table),
+      "name,age,city\nAlice,30,\"New\nYork\"\nBob,\"\",Paris\n");
+
+  gtext_csv_free_table(table);
+}
+
+// Test column operations run in place in the column layout
+TEST(CsvTableColumnar, ColumnOperations) {
+  const char * input = "a,b\n1,2\n3,4\n";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+  ASSERT_NE(table, nullptr);
+  ASSERT_EQ(gtext_csv_table_layout(table), GTEXT_CSV_LAYOUT_ROWS);
+  ASSERT_EQ(gtext_csv_table_set_layout(table, GTEXT_CSV_LAYOUT_COLUMNS),
+      GTEXT_CSV_OK);
+
+  EXPECT_EQ(gtext_csv_column_append(table, "c", 0), GTEXT_CSV_OK);
+  const char * values[] = {"x", "p", "q", nullptr};
+  EXPECT_EQ(gtext_csv_column_insert_with_values(table, 0, nullptr, 0, values,
+                nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_column_rename(table, 2, "bee", 0), GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_column_remove(table, 1), GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_field_set(table, 1, 2, "z", 1), GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_table_layout(table), GTEXT_CSV_LAYOUT_COLUMNS);
+
+  size_t idx = 0;
+  EXPECT_EQ(gtext_csv_header_index(table, "bee", &idx), GTEXT_CSV_OK);
+  EXPECT_EQ(idx, 1u);
+  EXPECT_EQ(gtext_csv_header_index(table, "c", &idx), GTEXT_CSV_OK);
+  EXPECT_EQ(idx, 2u);
+  EXPECT_EQ(gtext_csv_header_index(table, "a", &idx), GTEXT_CSV_E_INVALID);
+  EXPECT_EQ(write_table_to_string(table), "x,bee,c\np,2,\"\"\nq,4,z\n");
+
+  // Compaction and cloning keep the column layout
+  EXPECT_EQ(gtext_csv_table_compact(table), GTEXT_CSV_OK);
+  GTEXT_CSV_Table * clone = gtext_csv_clone(table);
+  ASSERT_NE(clone, nullptr);
+  EXPECT_EQ(gtext_csv_table_layout(clone), GTEXT_CSV_LAYOUT_COLUMNS);
+  EXPECT_EQ(gtext_csv_header_index(clone, "c", &idx), GTEXT_CSV_OK);
+  EXPECT_EQ(idx, 2u);
+  EXPECT_EQ(write_table_to_string(clone), "x,bee,c\np,2,\"\"\nq,4,z\n");
+  EXPECT_EQ(gtext_csv_header_index(table, "bee", &idx), GTEXT_CSV_OK);
+  EXPECT_EQ(write_table_to_string(table), "x,bee,c\np,2,\"\"\nq,4,z\n");
+
+  gtext_csv_free_table(clone);
+  gtext_csv_free_table(table);
+}
+
+// Test row operations switch the table back to the row layout
+TEST(CsvTableColumnar, RowOperationSwitchesToRows) {
+  const char * input = "a,b\n1,2\n";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  opts.layout = GTEXT_CSV_LAYOUT_COLUMNS;
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+  ASSERT_NE(table, nullptr);
+
+  const char * row[] = {"3", "4"};
+  EXPECT_EQ(gtext_csv_row_append(table, row, nullptr, 2, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_table_layout(table), GTEXT_CSV_LAYOUT_ROWS);
+  EXPECT_EQ(gtext_csv_row_count(table), 2u);
+
+  GTEXT_CSV_Column_View view;
+  EXPECT_EQ(gtext_csv_column_view(table, 0, &view), GTEXT_CSV_E_INVALID);
+
+  // Round trip through the column layout again
+  ASSERT_EQ(gtext_csv_table_set_layout(table, GTEXT_CSV_LAYOUT_COLUMNS),
+      GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_column_view(table, 1, &view), GTEXT_CSV_OK);
+  ASSERT_EQ(view.count, 2u);
+  EXPECT_EQ(std::string(view.heap + view.offsets[1], view.lengths[1]), "4");
+  EXPECT_EQ(gtext_csv_table_set_layout(table, GTEXT_CSV_LAYOUT_ROWS),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(write_table_to_string(table), "a,b\n1,2\n3,4\n");
+
+  gtext_csv_free_table(table);
+}
+
+// Test irregular tables keep their shape across layout switches
+TEST(CsvTableColumnar, IrregularRows) {
+  const char * input = "1,2,3\n4\n5,6\n";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.layout = GTEXT_CSV_LAYOUT_COLUMNS;
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+  ASSERT_NE(table, nullptr);
+  EXPECT_TRUE(gtext_csv_has_irregular_rows(table));
+  EXPECT_EQ(gtext_csv_max_col_count(table), 3u);
+  EXPECT_EQ(gtext_csv_min_col_count(table), 1u);
+
+  GTEXT_CSV_Column_View view;
+  ASSERT_EQ(gtext_csv_column_view(table, 2, &view), GTEXT_CSV_OK);
+  ASSERT_EQ(view.count, 3u);
+  EXPECT_EQ(view.lengths[1], 0u);
+  EXPECT_EQ(view.lengths[2], 0u);
+
+  EXPECT_EQ(gtext_csv_column_remove(table, 1), GTEXT_CSV_OK);
+  EXPECT_EQ(write_table_to_string(table), "1,3\n4\n5\n");
+
+  gtext_csv_free_table(table);
+}
+
+// Test field pointers survive heap growth and layout switches, and replaced
+// cells are counted as dead until a compaction frees them
+TEST(CsvTableColumnar, FieldPointersStayValid) {
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.layout = GTEXT_CSV_LAYOUT_COLUMNS;
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table("first,x\n", 8, &opts, nullptr);
+  ASSERT_NE(table, nullptr);
+
+  size_t len = 0;
+  const char * first = gtext_csv_field(table, 0, 0, &len);
+  ASSERT_NE(first, nullptr);
+  GTEXT_CSV_Memory_Stats before;
+  ASSERT_EQ(gtext_csv_table_memory_stats(table, &before), GTEXT_CSV_OK);
+
+  // Each set appends to the heap, which outgrows its first allocation
+  std::string value(1000, 'v');
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(gtext_csv_field_set(table, 0, 1, value.data(), value.size()),
+        GTEXT_CSV_OK);
+  }
+  EXPECT_EQ(std::string(first, len), "first");
+  const char * set = gtext_csv_field(table, 0, 1, &len);
+  GTEXT_CSV_Memory_Stats stats;
+  ASSERT_EQ(gtext_csv_table_memory_stats(table, &stats), GTEXT_CSV_OK);
+  EXPECT_GE(stats.dead_bytes, before.dead_bytes + 99 * (value.size() + 1));
+  EXPECT_LT(stats.live_bytes, before.live_bytes + 2 * value.size());
+
+  // Row operations switch to the row layout without copying the heap
+  const char * row[] = {"a", "b"};
+  ASSERT_EQ(gtext_csv_row_append(table, row, nullptr, 2, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(std::string(first, 5), "first");
+  EXPECT_EQ(gtext_csv_field(table, 0, 1, &len), set);
+
+  ASSERT_EQ(gtext_csv_table_set_layout(table, GTEXT_CSV_LAYOUT_COLUMNS),
+      GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_table_compact(table), GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_table_memory_stats(table, &stats), GTEXT_CSV_OK);
+  EXPECT_LT(stats.dead_bytes, value.size());
+  EXPECT_EQ(write_table_to_string(table), "first," + value + "\na,b\n");
+  gtext_csv_free_table(table);
+}
+
+// ============================================================================
+// Typed Column Conversion Tests
+// ============================================================================
+
+// Parse a small table with a header row in the given layout
+static GTEXT_CSV_Table * parse_typed_table(
+    const char * input, GTEXT_CSV_Layout layout) {
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  opts.layout = layout;
+  return gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+}
+
+// Test integer conversion, including the eight-digit fast path and nulls
+TEST(CsvColumnConvert, Int64) {
+  const char * input = "n\n42\n-7\n+0012\n\n1234567890123456\n"
+                       "9223372036854775807\n-9223372036854775808\n";
+  for (GTEXT_CSV_Layout layout :
+      {GTEXT_CSV_LAYOUT_ROWS, GTEXT_CSV_LAYOUT_COLUMNS}) {
+    GTEXT_CSV_Table * table = parse_typed_table(input, layout);
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(gtext_csv_row_count(table), 6u);
+
+    int64_t values[6];
+    uint8_t validity[1];
+    ASSERT_EQ(gtext_csv_column_as_i64(table, 0, values, validity, nullptr),
+        GTEXT_CSV_OK);
+    EXPECT_EQ(values[0], 42);
+    EXPECT_EQ(values[1], -7);
+    EXPECT_EQ(values[2], 12);
+    EXPECT_EQ(values[3], 1234567890123456);
+    EXPECT_EQ(values[4], INT64_MAX);
+    EXPECT_EQ(values[5], INT64_MIN);
+    EXPECT_EQ(validity[0], 0x3f);
+    gtext_csv_free_table(table);
+  }
+
+  // Empty cells count as nulls only when a bitmap is given
+  GTEXT_CSV_Table * table =
+      parse_typed_table("a,b\n1,2\n3\n", GTEXT_CSV_LAYOUT_ROWS);
+  ASSERT_NE(table, nullptr);
+  int64_t values[2];
+  uint8_t validity[1];
+  ASSERT_EQ(gtext_csv_column_as_i64(table, 1, values, validity, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(validity[0], 0x01);
+  EXPECT_EQ(values[1], 0);
+  GTEXT_CSV_Error err{};
+  EXPECT_EQ(gtext_csv_column_as_i64(table, 1, values, nullptr, &err),
+      GTEXT_CSV_E_INVALID);
+  EXPECT_EQ(err.row_index, 1u);
+  EXPECT_EQ(err.col_index, 1u);
+  gtext_csv_free_table(table);
+}
+
+// Test the first bad cell is reported
+TEST(CsvColumnConvert, Int64BadCell) {
+  const char * bad_cells[] = {"9223372036854775808", "12a", "-", "1.0",
+      " 1", "123456789012345678901"};
+  for (const char * bad : bad_cells) {
+    std::string input = std::string("n\n1\n") + bad + "\n2\n";
+    GTEXT_CSV_Table * table =
+        parse_typed_table(input.c_str(), GTEXT_CSV_LAYOUT_ROWS);
+    ASSERT_NE(table, nullptr);
+    int64_t values[3];
+    GTEXT_CSV_Error err{};
+    EXPECT_EQ(gtext_csv_column_as_i64(table, 0, values, nullptr, &err),
+        GTEXT_CSV_E_INVALID)
+        << bad;
+    EXPECT_EQ(err.code, GTEXT_CSV_E_INVALID);
+    EXPECT_EQ(err.row_index, 1u) << bad;
+    gtext_csv_free_table(table);
+  }
+}
+
+// Test float conversion matches strtod on both the fast and slow paths
+TEST(CsvColumnConvert, Float64) {
+  const char * cells[] = {"1.5", "-0.25", "1e3", "3.14159", ".5", "5.",
+      "0.000123", "12345678901234567890.5", "2.2250738585072014e-308",
+      "1.7976931348623157e308", "-1E-5", "0.1", "123456789.123456789",
+      "1e-400"};
+  std::string input = "x\n";
+  for (const char * cell : cells) {
+    input += std::string(cell) + "\n";
+  }
+  GTEXT_CSV_Table * table =
+      parse_typed_table(input.c_str(), GTEXT_CSV_LAYOUT_COLUMNS);
+  ASSERT_NE(table, nullptr);
+
+  const size_t count = sizeof(cells) / sizeof(cells[0]);
+  double values[count];
+  ASSERT_EQ(gtext_csv_column_as_f64(table, 0, values, nullptr, nullptr),
+      GTEXT_CSV_OK);
+  for (size_t i = 0; i < count; i++) {
+    EXPECT_EQ(values[i], strtod(cells[i], nullptr)) << cells[i];
+  }
+  gtext_csv_free_table(table);
+
+  for (const char * bad : {"abc", "1e", "inf", "nan", "0x10", "1e999", "."}) {
+    std::string bad_input = std::string("x\n") + bad + "\n";
+    table = parse_typed_table(bad_input.c_str(), GTEXT_CSV_LAYOUT_ROWS);
+    ASSERT_NE(table, nullptr);
+    EXPECT_EQ(gtext_csv_column_as_f64(table, 0, values, nullptr, nullptr),
+        GTEXT_CSV_E_INVALID)
+        << bad;
+    gtext_csv_free_table(table);
+  }
+}
+
+// Test boolean conversion
+TEST(CsvColumnConvert, Bool) {
+  GTEXT_CSV_Table * table = parse_typed_table(
+      "b\ntrue\nFALSE\n1\n0\nTrue\n", GTEXT_CSV_LAYOUT_ROWS);
+  ASSERT_NE(table, nullptr);
+  bool values[5];
+  ASSERT_EQ(gtext_csv_column_as_bool(table, 0, values, nullptr, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_TRUE(values[0]);
+  EXPECT_FALSE(values[1]);
+  EXPECT_TRUE(values[2]);
+  EXPECT_FALSE(values[3]);
+  EXPECT_TRUE(values[4]);
+  gtext_csv_free_table(table);
+
+  table = parse_typed_table("b\nyes\n", GTEXT_CSV_LAYOUT_ROWS);
+  ASSERT_NE(table, nullptr);
+  EXPECT_EQ(gtext_csv_column_as_bool(table, 0, values, nullptr, nullptr),
+      GTEXT_CSV_E_INVALID);
+  gtext_csv_free_table(table);
+}
+
+// Test ISO 8601 timestamp conversion
+TEST(CsvColumnConvert, Timestamp) {
+  GTEXT_CSV_Table * table = parse_typed_table("t\n1970-01-01\n"
+                                              "2024-02-29T12:34:56.789Z\n"
+                                              "2024-02-29 12:34:56+02:00\n"
+                                              "1969-12-31T23:59\n"
+                                              "2024-02-29T12:34:56.7891234-0000\n",
+      GTEXT_CSV_LAYOUT_ROWS);
+  ASSERT_NE(table, nullptr);
+  int64_t values[5];
+  ASSERT_EQ(gtext_csv_column_as_timestamp(table, 0, values, nullptr, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(values[0], 0);
+  EXPECT_EQ(values[1], 1709210096789000);
+  EXPECT_EQ(values[2], 1709202896000000);
+  EXPECT_EQ(values[3], -60000000);
+  EXPECT_EQ(values[4], 1709210096789123);
+  gtext_csv_free_table(table);
+
+  for (const char * bad : {"2023-02-29", "2024-13-01", "2024-01-01T24:00",
+           "2024-01-01T", "2024-1-01", "2024-01-01T10:00:00.", "2024-01-01X"}) {
+    std::string input = std::string("t\n") + bad + "\n";
+    table = parse_typed_table(input.c_str(), GTEXT_CSV_LAYOUT_ROWS);
+    ASSERT_NE(table, nullptr);
+    EXPECT_EQ(gtext_csv_column_as_timestamp(table, 0, values, nullptr, nullptr),
+        GTEXT_CSV_E_INVALID)
+        << bad;
+    gtext_csv_free_table(table);
+  }
+}
+
+// Test schema inference over a sample of rows
+TEST(CsvColumnConvert, InferType) {
+  GTEXT_CSV_Table * table =
+      parse_typed_table("i,f,b,t,s,e,g\n1,1.5,true,2024-01-01,x,,1\n"
+                        ",2,false,2024-01-02T00:00Z,1,,2\n3,3,1,,y,,2.5\n",
+          GTEXT_CSV_LAYOUT_ROWS);
+  ASSERT_NE(table, nullptr);
+
+  const GTEXT_CSV_Value_Type expected[] = {GTEXT_CSV_TYPE_I64,
+      GTEXT_CSV_TYPE_F64, GTEXT_CSV_TYPE_BOOL, GTEXT_CSV_TYPE_TIMESTAMP,
+      GTEXT_CSV_TYPE_STRING, GTEXT_CSV_TYPE_STRING};
+  for (size_t col = 0; col < 6; col++) {
+    GTEXT_CSV_Value_Type type;
+    ASSERT_EQ(gtext_csv_column_infer_type(table, col, 0, &type), GTEXT_CSV_OK);
+    EXPECT_EQ(type, expected[col]) << "Column " << col;
+  }
+
+  // A sample that stops before the first non-integer cell
+  size_t g_idx = 0;
+  ASSERT_EQ(gtext_csv_header_index(table, "g", &g_idx), GTEXT_CSV_OK);
+  GTEXT_CSV_Value_Type type;
+  ASSERT_EQ(gtext_csv_column_infer_type(table, g_idx, 0, &type), GTEXT_CSV_OK);
+  EXPECT_EQ(type, GTEXT_CSV_TYPE_F64);
+  ASSERT_EQ(gtext_csv_column_infer_type(table, g_idx, 2, &type), GTEXT_CSV_OK);
+  EXPECT_EQ(type, GTEXT_CSV_TYPE_I64);
+  EXPECT_EQ(gtext_csv_column_infer_type(table, 7, 0, &type),
+      GTEXT_CSV_E_INVALID);
+
+  gtext_csv_free_table(table);
+}
+
+// ============================================================================
+// Column Projection Tests
+// ============================================================================
+
+// Test selecting columns by index keeps them in input order
+TEST(CsvProjection, SelectByIndex) {
+  const char * input = "a,b,c,d\n1,2,3,4\n\"x,y\",\"q\"\"r\",z,\"w\"\"\"\n";
+  const size_t select[] = {2, 0, 2};
+
+  for (GTEXT_CSV_Layout layout :
+      {GTEXT_CSV_LAYOUT_ROWS, GTEXT_CSV_LAYOUT_COLUMNS}) {
+    GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+    opts.layout = layout;
+    opts.select_columns = select;
+    opts.select_column_count = 3;
+    GTEXT_CSV_Table * table =
+        gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+    ASSERT_NE(table, nullptr);
+
+    const char * expected[3][2] = {{"a", "c"}, {"1", "3"}, {"x,y", "z"}};
+    ASSERT_EQ(gtext_csv_row_count(table), 3u);
+    for (size_t row = 0; row < 3; row++) {
+      ASSERT_EQ(gtext_csv_col_count(table, row), 2u) << "Row " << row;
+      for (size_t col = 0; col < 2; col++) {
+        size_t len = 0;
+        const char * data = gtext_csv_field(table, row, col, &len);
+        EXPECT_EQ(std::string(data, len), expected[row][col])
+            << "Row " << row << ", column " << col;
+      }
+    }
+    gtext_csv_free_table(table);
+  }
+}
+
+// Test selecting columns by header name, alone and with indices
+TEST(CsvProjection, SelectByName) {
+  const char * input =
+      "id,name,score,extra\n1,bob,9,x\n2,\"al, ice\",7,y\n3,eve,5,z,wide\n";
+  const char * names[] = {"score", "id"};
+  const size_t select[] = {4};
+
+  for (GTEXT_CSV_Layout layout :
+      {GTEXT_CSV_LAYOUT_ROWS, GTEXT_CSV_LAYOUT_COLUMNS}) {
+    GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+    opts.layout = layout;
+    opts.dialect.treat_first_row_as_header = true;
+    opts.select_names = names;
+    opts.select_name_count = 2;
+    GTEXT_CSV_Table * table =
+        gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+    ASSERT_NE(table, nullptr);
+
+    ASSERT_EQ(gtext_csv_row_count(table), 3u);
+    EXPECT_EQ(gtext_csv_col_count(table, 0), 2u);
+    size_t idx = 0;
+    ASSERT_EQ(gtext_csv_header_index(table, "score", &idx), GTEXT_CSV_OK);
+    EXPECT_EQ(idx, 1u);
+    ASSERT_EQ(gtext_csv_header_index(table, "id", &idx), GTEXT_CSV_OK);
+    EXPECT_EQ(idx, 0u);
+    EXPECT_NE(gtext_csv_header_index(table, "name", &idx), GTEXT_CSV_OK);
+    size_t len = 0;
+    const char * data = gtext_csv_field(table, 1, 1, &len);
+    EXPECT_EQ(std::string(data, len), "7");
+    EXPECT_EQ(gtext_csv_col_count(table, 2), 2u);
+    gtext_csv_free_table(table);
+
+    // An index past the header width still selects wider data rows
+    opts.select_columns = select;
+    opts.select_column_count = 1;
+    table = gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+    ASSERT_NE(table, nullptr);
+    EXPECT_EQ(gtext_csv_col_count(table, 0), 2u);
+    ASSERT_EQ(gtext_csv_col_count(table, 2), 3u);
+    data = gtext_csv_field(table, 2, 2, &len);
+    EXPECT_EQ(std::string(data, len), "wide");
+    EXPECT_EQ(
+        write_table_to_string(table), "id,score\n1,9\n2,7\n3,5,wide\n");
+    gtext_csv_free_table(table);
+  }
+}
+
+// Test invalid selections and rows that keep none of their fields
+TEST(CsvProjection, MissingColumns) {
+  const char * input = "a,b,c\n1\n2,3,4\n";
+  const char * names[] = {"a", "missing"};
+
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.select_names = names;
+  opts.select_name_count = 2;
+  GTEXT_CSV_Error err{};
+  EXPECT_EQ(gtext_csv_parse_table(input, strlen(input), &opts, &err), nullptr);
+  EXPECT_EQ(err.code, GTEXT_CSV_E_INVALID);
+  gtext_csv_error_free(&err);
+
+  opts.dialect.treat_first_row_as_header = true;
+  err = GTEXT_CSV_Error{};
+  EXPECT_EQ(gtext_csv_parse_table(input, strlen(input), &opts, &err), nullptr);
+  EXPECT_EQ(err.code, GTEXT_CSV_E_INVALID);
+  EXPECT_STREQ(err.message, "Selected column name not found in header");
+  gtext_csv_error_free(&err);
+
+  // The short row keeps no fields but is still a row
+  const size_t select[] = {2};
+  opts = gtext_csv_parse_options_default();
+  opts.select_columns = select;
+  opts.select_column_count = 1;
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+  ASSERT_NE(table, nullptr);
+  ASSERT_EQ(gtext_csv_row_count(table), 3u);
+  EXPECT_EQ(gtext_csv_col_count(table, 0), 1u);
+  EXPECT_EQ(gtext_csv_col_count(table, 1), 0u);
+  size_t len = 0;
+  const char * data = gtext_csv_field(table, 2, 0, &len);
+  EXPECT_EQ(std::string(data, len), "4");
+  gtext_csv_free_table(table);
+}
+
+// Test a projected stream fed one byte at a time only reports kept fields
+TEST(CsvProjection, StreamSkipsFieldsAcrossChunks) {
+  const char * input = "\"a\"\"b\",\"skip\"\"me\",\"x\ny, z\",c,\"d\"\"\"\n"
+                       "1,\"\",3,4,5\n";
+  const size_t select[] = {0, 4};
+
+  struct Collected {
+    std::vector<std::string> fields;
+    std::vector<size_t> cols;
+    size_t records;
+  } collected{{}, {}, 0};
+  GTEXT_CSV_Event_cb callback = [](const GTEXT_CSV_Event * event,
+                                    void * user_data) -> GTEXT_CSV_Status {
+    auto * out = (Collected *)user_data;
+    if (event->type == GTEXT_CSV_EVENT_FIELD) {
+      out->fields.push_back(std::string(event->data, event->data_len));
+      out->cols.push_back(event->col_index);
+    }
+    else if (event->type == GTEXT_CSV_EVENT_RECORD_END) {
+      out->records++;
+    }
+    return GTEXT_CSV_OK;
+  };
+
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.select_columns = select;
+  opts.select_column_count = 2;
+  GTEXT_CSV_Stream * stream =
+      gtext_csv_stream_new(&opts, callback, &collected);
+  ASSERT_NE(stream, nullptr);
+  for (size_t i = 0; input[i]; i++) {
+    ASSERT_EQ(gtext_csv_stream_feed(stream, input + i, 1, nullptr),
+        GTEXT_CSV_OK);
+  }
+  ASSERT_EQ(gtext_csv_stream_finish(stream, nullptr), GTEXT_CSV_OK);
+  gtext_csv_stream_free(stream);
+
+  EXPECT_EQ(collected.records, 2u);
+  ASSERT_EQ(collected.fields.size(), 4u);
+  EXPECT_EQ(collected.fields[0], "a\"b");
+  EXPECT_EQ(collected.fields[1], "d\"");
+  EXPECT_EQ(collected.fields[2], "1");
+  EXPECT_EQ(collected.fields[3], "5");
+  EXPECT_EQ(collected.cols[1], 4u);
+}
+
+// Test a projected parallel parse matches a projected serial parse
+TEST(CsvProjection, ParallelMatchesSerial) {
+  std::string input = make_parallel_csv_input(20000);
+  const size_t select[] = {1};
+
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.select_columns = select;
+  opts.select_column_count = 1;
+  GTEXT_CSV_Table * serial =
+      gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+  ASSERT_NE(serial, nullptr);
+  opts.parse_threads = 8;
+  GTEXT_CSV_Table * parallel =
+      gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+  ASSERT_NE(parallel, nullptr);
+
+  ASSERT_EQ(gtext_csv_row_count(serial), 20001u);
+  ASSERT_EQ(gtext_csv_row_count(parallel), gtext_csv_row_count(serial));
+  for (size_t row = 0; row < gtext_csv_row_count(serial); row++) {
+    ASSERT_EQ(gtext_csv_col_count(serial, row), 1u) << "Row " << row;
+    ASSERT_EQ(gtext_csv_col_count(parallel, row), 1u) << "Row " << row;
+    size_t serial_len = 0;
+    size_t parallel_len = 0;
+    const char * a = gtext_csv_field(serial, row, 0, &serial_len);
+    const char * b = gtext_csv_field(parallel, row, 0, &parallel_len);
+    ASSERT_EQ(std::string(b, parallel_len), std::string(a, serial_len))
+        << "Row " << row;
+  }
+
+  gtext_csv_free_table(serial);
+  gtext_csv_free_table(parallel);
+}
+
+// ============================================================================
+// Row Filter Tests
+// ============================================================================
+
+// Test built-in row conditions on named columns
+TEST(CsvRowFilter, Conditions) {
+  const char * input = "id,region,amount\n"
+                       "1,eu,10\n"
+                       "2,us,20\n"
+                       "3,eu-west,30.5\n"
+                       "4,eu,abc\n"
+                       "5,eu,1e2\n"
+                       "6,eu\n"
+                       "7,\"eu\",7\n";
+
+  GTEXT_CSV_Row_Condition conditions[2] = {};
+  conditions[0].column = "region";
+  conditions[0].op = GTEXT_CSV_FILTER_PREFIX;
+  conditions[0].value = "eu";
+  conditions[1].column = "amount";
+  conditions[1].op = GTEXT_CSV_FILTER_RANGE;
+  conditions[1].min = 5;
+  conditions[1].max = 50;
+
+  for (GTEXT_CSV_Layout layout :
+      {GTEXT_CSV_LAYOUT_ROWS, GTEXT_CSV_LAYOUT_COLUMNS}) {
+    GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+    opts.layout = layout;
+    opts.dialect.treat_first_row_as_header = true;
+    opts.row_conditions = conditions;
+    opts.row_condition_count = 2;
+    GTEXT_CSV_Table * table =
+        gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+    ASSERT_NE(table, nullptr);
+    EXPECT_EQ(write_table_to_string(table),
+        "id,region,amount\n1,eu,10\n3,eu-west,30.5\n7,eu,7\n");
+    gtext_csv_free_table(table);
+
+    // Exact match on a column given by index
+    conditions[0].op = GTEXT_CSV_FILTER_EQUALS;
+    conditions[1].column = nullptr;
+    conditions[1].column_index = 0;
+    conditions[1].min = 4;
+    conditions[1].max = 100;
+    table = gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+    ASSERT_NE(table, nullptr);
+    EXPECT_EQ(write_table_to_string(table),
+        "id,region,amount\n4,eu,abc\n5,eu,1e2\n6,eu\n7,eu,7\n");
+    gtext_csv_free_table(table);
+
+    conditions[0].op = GTEXT_CSV_FILTER_PREFIX;
+    conditions[1].column = "amount";
+    conditions[1].min = 5;
+    conditions[1].max = 50;
+  }
+}
+
+// Test a row filter callback and the rows it sees
+TEST(CsvRowFilter, Callback) {
+  std::string input = "name,keep\n";
+  for (size_t i = 0; i < 5000; i++) {
+    input += "\"row " + std::to_string(i) + "\"," +
+        (i % 100 == 7 ? "yes" : std::string(200, 'n')) + "\n";
+  }
+
+  GTEXT_CSV_Row_Filter_cb filter = [](const char * const * fields,
+                                       const size_t * lengths,
+                                       size_t field_count,
+                                       void * user_data) -> bool {
+    (*(size_t *)user_data)++;
+    return field_count == 2 && std::string(fields[1], lengths[1]) == "yes";
+  };
+
+  for (GTEXT_CSV_Layout layout :
+      {GTEXT_CSV_LAYOUT_ROWS, GTEXT_CSV_LAYOUT_COLUMNS}) {
+    size_t calls = 0;
+    GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+    opts.layout = layout;
+    opts.dialect.treat_first_row_as_header = true;
+    opts.row_filter = filter;
+    opts.row_filter_data = &calls;
+    GTEXT_CSV_Table * table =
+        gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+    ASSERT_NE(table, nullptr);
+    EXPECT_EQ(calls, 5000u);
+    ASSERT_EQ(gtext_csv_row_count(table), 50u);
+    for (size_t row = 0; row < 50; row++) {
+      size_t len = 0;
+      const char * data = gtext_csv_field(table, row, 0, &len);
+      EXPECT_EQ(std::string(data, len), "row " + std::to_string(row * 100 + 7));
+    }
+
+    // Rows appended after parsing land after the kept rows
+    const char * fields[] = {"tail", "yes"};
+    ASSERT_EQ(gtext_csv_row_append(table, fields, nullptr, 2, nullptr),
+        GTEXT_CSV_OK);
+    EXPECT_EQ(gtext_csv_row_count(table), 51u);
+    gtext_csv_free_table(table);
+  }
+}
+
+// Test invalid filter options
+TEST(CsvRowFilter, InvalidOptions) {
+  const char * input = "a,b\n1,2\n";
+  GTEXT_CSV_Row_Condition condition = {};
+  condition.column = "missing";
+  condition.op = GTEXT_CSV_FILTER_EQUALS;
+  condition.value = "1";
+
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.row_conditions = &condition;
+  opts.row_condition_count = 1;
+  GTEXT_CSV_Error err{};
+  EXPECT_EQ(gtext_csv_parse_table(input, strlen(input), &opts, &err), nullptr);
+  EXPECT_EQ(err.code, GTEXT_CSV_E_INVALID);
+  gtext_csv_error_free(&err);
+
+  opts.dialect.treat_first_row_as_header = true;
+  err = GTEXT_CSV_Error{};
+  EXPECT_EQ(gtext_csv_parse_table(input, strlen(input), &opts, &err), nullptr);
+  EXPECT_EQ(err.code, GTEXT_CSV_E_INVALID);
+  EXPECT_STREQ(err.message, "Filter column name not found in header");
+  gtext_csv_error_free(&err);
+}
+
+// Test a filtered parallel parse matches a filtered serial parse
+TEST(CsvRowFilter, ParallelMatchesSerial) {
+  std::string input = make_parallel_csv_input(20000);
+  GTEXT_CSV_Row_Condition condition = {};
+  condition.column_index = 2;
+  condition.op = GTEXT_CSV_FILTER_EQUALS;
+  condition.value = "n";
+
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  opts.row_conditions = &condition;
+  opts.row_condition_count = 1;
+  GTEXT_CSV_Table * serial =
+      gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+  ASSERT_NE(serial, nullptr);
+  opts.parse_threads = 8;
+  GTEXT_CSV_Table * parallel =
+      gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+  ASSERT_NE(parallel, nullptr);
+
+  // Rows whose index is a multiple of 3 end with an empty note
+  EXPECT_EQ(gtext_csv_row_count(serial), 20000u - 6667u);
+  EXPECT_EQ(write_table_to_string(parallel), write_table_to_string(serial));
+
+  gtext_csv_free_table(serial);
+  gtext_csv_free_table(parallel);
+}
+
+// ============================================================================
+// Row Block Storage Tests
+// ============================================================================
+
+// Test parsed rows get exact-size field arrays and a compact row index
+TEST(CsvRowBlocks, ParseStats) {
+  std::string input = "a,b,c\n";
+  size_t fields = 3;
+  for (size_t i = 0; i < 10000; i++) {
+    size_t width = 1 + i % 40;
+    for (size_t col = 0; col < width; col++) {
+      input += col ? ",v" : "v";
+    }
+    input += "\n";
+    fields += width;
+  }
+
+  for (size_t threads : {1u, 8u}) {
+    GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+    opts.dialect.treat_first_row_as_header = true;
+    opts.parse_threads = threads;
+    GTEXT_CSV_Table * table =
+        gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(gtext_csv_row_count(table), 10000u);
+
+    GTEXT_CSV_Memory_Stats stats;
+    ASSERT_EQ(gtext_csv_table_memory_stats(table, &stats), GTEXT_CSV_OK);
+    EXPECT_EQ(stats.field_array_bytes, fields * sizeof(csv_table_field));
+    EXPECT_LT(stats.row_slack_bytes, CSV_ROW_BLOCK_ROWS * sizeof(csv_table_row));
+    EXPECT_LE(stats.row_index_bytes,
+        (10001 + CSV_ROW_BLOCK_ROWS) * sizeof(csv_table_row) + 1024);
+    EXPECT_GE(stats.arena_used_bytes, stats.field_array_bytes);
+    EXPECT_GE(stats.arena_bytes, stats.arena_used_bytes);
+    EXPECT_EQ(stats.column_bytes, 0u);
+
+    size_t len = 0;
+    EXPECT_STREQ(gtext_csv_field(table, 9999, 39, &len), "v");
+    EXPECT_EQ(gtext_csv_col_count(table, 9999), 40u);
+    gtext_csv_free_table(table);
+  }
+
+  EXPECT_EQ(gtext_csv_table_memory_stats(nullptr, nullptr),
+      GTEXT_CSV_E_INVALID);
+}
+
+// Test row inserts and removals that cross row block boundaries
+TEST(CsvRowBlocks, InsertRemoveAcrossBlocks) {
+  GTEXT_CSV_Table * table = gtext_csv_new_table();
+  ASSERT_NE(table, nullptr);
+  std::vector<std::string> model;
+
+  auto add = [&](size_t idx, const std::string & value) {
+    const char * fields[] = {value.c_str()};
+    ASSERT_EQ(gtext_csv_row_insert(table, idx, fields, nullptr, 1, nullptr),
+        GTEXT_CSV_OK);
+    model.insert(model.begin() + idx, value);
+  };
+  for (size_t i = 0; i < 1000; i++) {
+    add(model.size(), "r" + std::to_string(i));
+  }
+  for (size_t idx : {0u, 255u, 256u, 511u, 700u, 1005u}) {
+    add(idx, "x" + std::to_string(idx));
+  }
+  for (size_t idx : {0u, 255u, 256u, 300u, 512u, 1000u}) {
+    ASSERT_EQ(gtext_csv_row_remove(table, idx), GTEXT_CSV_OK);
+    model.erase(model.begin() + idx);
+  }
+
+  auto check = [&](const GTEXT_CSV_Table * t) {
+    ASSERT_EQ(gtext_csv_row_count(t), model.size());
+    for (size_t i = 0; i < model.size(); i++) {
+      size_t len = 0;
+      const char * data = gtext_csv_field(t, i, 0, &len);
+      ASSERT_EQ(std::string(data, len), model[i]) << "row " << i;
+    }
+  };
+  check(table);
+
+  GTEXT_CSV_Table * clone = gtext_csv_clone(table);
+  ASSERT_NE(clone, nullptr);
+  check(clone);
+  gtext_csv_free_table(clone);
+
+  // Compaction frees row blocks emptied by removals
+  while (model.size() > 10) {
+    ASSERT_EQ(gtext_csv_row_remove(table, model.size() - 1), GTEXT_CSV_OK);
+    model.pop_back();
+  }
+  EXPECT_GE(table->row_capacity, 1000u);
+  ASSERT_EQ(gtext_csv_table_compact(table), GTEXT_CSV_OK);
+  EXPECT_EQ(table->row_capacity, CSV_ROW_BLOCK_ROWS);
+  check(table);
+
+  GTEXT_CSV_Memory_Stats stats;
+  ASSERT_EQ(gtext_csv_table_memory_stats(table, &stats), GTEXT_CSV_OK);
+  EXPECT_EQ(stats.field_array_bytes, 10 * sizeof(csv_table_field));
+  EXPECT_EQ(stats.row_slack_bytes,
+      (CSV_ROW_BLOCK_ROWS - 10) * sizeof(csv_table_row));
+
+  // Column-major storage is reported separately
+  ASSERT_EQ(gtext_csv_table_set_layout(table, GTEXT_CSV_LAYOUT_COLUMNS),
+      GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_table_memory_stats(table, &stats), GTEXT_CSV_OK);
+  EXPECT_GT(stats.column_bytes, 0u);
+  EXPECT_EQ(stats.row_index_bytes, 0u);
+  check(table);
+  gtext_csv_free_table(table);
+}
+
+// Test middle inserts and removes switch to indexed row blocks
+TEST(CsvRowBlocks, IndexedRandomEdits) {
+  GTEXT_CSV_Table * table = gtext_csv_new_table();
+  ASSERT_NE(table, nullptr);
+  std::vector<std::string> model;
+  for (size_t i = 0; i < 1500; i++) {
+    std::string value = "r" + std::to_string(i);
+    const char * fields[] = {value.c_str()};
+    ASSERT_EQ(gtext_csv_row_append(table, fields, nullptr, 1, nullptr),
+        GTEXT_CSV_OK);
+    model.push_back(value);
+  }
+  // Appends and removing the last row keep the blocks packed
+  ASSERT_EQ(gtext_csv_row_remove(table, model.size() - 1), GTEXT_CSV_OK);
+  model.pop_back();
+  EXPECT_EQ(table->row_block_tree, nullptr);
+
+  auto check = [&](const GTEXT_CSV_Table * t) {
+    ASSERT_EQ(gtext_csv_row_count(t), model.size());
+    for (size_t i = 0; i < model.size(); i++) {
+      size_t len = 0;
+      const char * data = gtext_csv_field(t, i, 0, &len);
+      ASSERT_EQ(std::string(data, len), model[i]) << "row " << i;
+    }
+  };
+
+  uint32_t seed = 12345;
+  auto next = [&](size_t bound) {
+    seed = seed * 1103515245u + 12345u;
+    return (size_t)((seed >> 8) % bound);
+  };
+  for (size_t step = 0; step < 4000; step++) {
+    if (model.empty() || next(5) < 3) {
+      size_t idx = next(model.size() + 1);
+      std::string value = "s" + std::to_string(step);
+      const char * fields[] = {value.c_str()};
+      ASSERT_EQ(gtext_csv_row_insert(table, idx, fields, nullptr, 1, nullptr),
+          GTEXT_CSV_OK);
+      model.insert(model.begin() + idx, value);
+    }
+    else {
+      size_t idx = next(model.size());
+      ASSERT_EQ(gtext_csv_row_remove(table, idx), GTEXT_CSV_OK);
+      model.erase(model.begin() + idx);
+    }
+  }
+  EXPECT_NE(table->row_block_tree, nullptr);
+  check(table);
+
+  GTEXT_CSV_Table * clone = gtext_csv_clone(table);
+  ASSERT_NE(clone, nullptr);
+  check(clone);
+  gtext_csv_free_table(clone);
+
+  // Compaction packs the blocks again
+  ASSERT_EQ(gtext_csv_table_compact(table), GTEXT_CSV_OK);
+  EXPECT_EQ(table->row_block_tree, nullptr);
+  check(table);
+
+  // Column-major round trip from an indexed table
+  const char * fields[] = {"mid"};
+  ASSERT_EQ(gtext_csv_row_insert(table, 3, fields, nullptr, 1, nullptr),
+      GTEXT_CSV_OK);
+  model.insert(model.begin() + 3, "mid");
+  ASSERT_EQ(gtext_csv_table_set_layout(table, GTEXT_CSV_LAYOUT_COLUMNS),
+      GTEXT_CSV_OK);
+  check(table);
+  ASSERT_EQ(gtext_csv_table_set_layout(table, GTEXT_CSV_LAYOUT_ROWS),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(table->row_block_tree, nullptr);
+  check(table);
+  gtext_csv_free_table(table);
+}
+
+// ============================================================================
+// Batch Reader Tests
+// ============================================================================
+
+// Build input with plain, quoted, escaped and multi-line fields
+static std::string reader_test_input(size_t rows) {
+  std::string input;
+  for (size_t i = 0; i < rows; i++) {
+    input += "r" + std::to_string(i) + ",";
+    switch (i % 4) {
+    case 0:
+      input += "plain";
+      break;
+    case 1:
+      input += "\"quoted, " + std::to_string(i) + "\"";
+      break;
+    case 2:
+      input += "\"say \"\"hi\"\"\"";
+      break;
+    default:
+      input += "\"two\nlines\"";
+      break;
+    }
+    input += "," + std::string(i % 50, 'x') + "\n";
+  }
+  return input;
+}
+
+// Read every batch and compare it against the table parse of the same input
+static void reader_expect_matches_table(GTEXT_CSV_Reader * reader,
+    const std::string & input, size_t max_rows) {
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input.data(), input.size(), nullptr, nullptr);
+  ASSERT_NE(table, nullptr);
+  GTEXT_CSV_Batch * batch = gtext_csv_batch_new();
+  ASSERT_NE(batch, nullptr);
+
+  size_t row = 0;
+  for (;;) {
+    ASSERT_EQ(gtext_csv_reader_next_batch(reader, batch, max_rows, nullptr),
+        GTEXT_CSV_OK);
+    size_t count = gtext_csv_batch_row_count(batch);
+    ASSERT_LE(count, max_rows);
+    if (count == 0) {
+      break;
+    }
+    for (size_t r = 0; r < count; r++, row++) {
+      size_t field_count = 0;
+      const GTEXT_CSV_Field_Span * fields =
+          gtext_csv_batch_row(batch, r, &field_count);
+      ASSERT_NE(fields, nullptr);
+      ASSERT_EQ(field_count, gtext_csv_col_count(table, row));
+      for (size_t c = 0; c < field_count; c++) {
+        size_t len = 0;
+        const char * expected = gtext_csv_field(table, row, c, &len);
+        ASSERT_EQ(std::string(fields[c].data, fields[c].length),
+            std::string(expected, len))
+            << "row " << row << " col " << c;
+      }
+    }
+  }
+  EXPECT_EQ(row, gtext_csv_row_count(table));
+  gtext_csv_batch_free(batch);
+  gtext_csv_free_table(table);
+}
+
+// Test batches from an in-memory reader match the table parse
+TEST(CsvReader, MemoryBatchesMatchTable) {
+  std::string input = reader_test_input(3000);
+  GTEXT_CSV_Reader * reader =
+      gtext_csv_reader_new(nullptr, input.data(), input.size());
+  ASSERT_NE(reader, nullptr);
+  reader_expect_matches_table(reader, input, 100);
+  gtext_csv_reader_free(reader);
+}
+
+// Test unquoted fields point into the input and quoted fields are copied
+TEST(CsvReader, ZeroCopyFields) {
+  const char input[] = "a,\"b\",\"c\"\"d\"\n,e\n";
+  GTEXT_CSV_Reader * reader =
+      gtext_csv_reader_new(nullptr, input, sizeof(input) - 1);
+  ASSERT_NE(reader, nullptr);
+  GTEXT_CSV_Batch * batch = gtext_csv_batch_new();
+  ASSERT_NE(batch, nullptr);
+
+  ASSERT_EQ(gtext_csv_reader_next_batch(reader, batch, 10, nullptr),
+      GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_batch_row_count(batch), 2u);
+  size_t len = 0;
+  EXPECT_EQ(gtext_csv_batch_field(batch, 0, 0, &len), input);
+  EXPECT_EQ(gtext_csv_batch_field(batch, 1, 1, &len), input + 14);
+  const char * escaped = gtext_csv_batch_field(batch, 0, 2, &len);
+  EXPECT_EQ(std::string(escaped, len), "c\"d");
+  EXPECT_FALSE(escaped >= input && escaped < input + sizeof(input));
+  ASSERT_NE(gtext_csv_batch_field(batch, 1, 0, &len), nullptr);
+  EXPECT_EQ(len, 0u);
+  EXPECT_EQ(gtext_csv_batch_field(batch, 1, 2, &len), nullptr);
+  EXPECT_EQ(gtext_csv_batch_row(batch, 2, nullptr), nullptr);
+
+  ASSERT_EQ(gtext_csv_reader_next_batch(reader, batch, 10, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_batch_row_count(batch), 0u);
+  gtext_csv_batch_free(batch);
+  gtext_csv_reader_free(reader);
+}
+
+// Test a callback reader across odd read sizes and small batches
+TEST(CsvReader, SourceBatchesMatchTable) {
+  struct Source {
+    std::string data;
+    size_t pos;
+    size_t step;
+  };
+  auto read = [](void * user, char * buf, size_t cap,
+                  size_t * len_out) -> GTEXT_CSV_Status {
+    Source * source = static_cast<Source *>(user);
+    size_t len = std::min({cap, source->step, source->data.size() - source->pos});
+    memcpy(buf, source->data.data() + source->pos, len);
+    source->pos += len;
+    *len_out = len;
+    return GTEXT_CSV_OK;
+  };
+
+  for (size_t step : {1000u, 70000u}) {
+    Source source = {reader_test_input(5000), 0, step};
+    GTEXT_CSV_Reader * reader =
+        gtext_csv_reader_new_source(nullptr, read, &source);
+    ASSERT_NE(reader, nullptr);
+    reader_expect_matches_table(reader, source.data, 7);
+    gtext_csv_reader_free(reader);
+  }
+}
+
+// Test rows before a parse error are returned before the error
+TEST(CsvReader, ErrorAfterCompleteRows) {
+  const char input[] = "a,b\nc,\"unterminated";
+  GTEXT_CSV_Reader * reader =
+      gtext_csv_reader_new(nullptr, input, sizeof(input) - 1);
+  ASSERT_NE(reader, nullptr);
+  GTEXT_CSV_Batch * batch = gtext_csv_batch_new();
+  ASSERT_NE(batch, nullptr);
+
+  ASSERT_EQ(gtext_csv_reader_next_batch(reader, batch, 10, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_batch_row_count(batch), 1u);
+  for (int i = 0; i < 2; i++) {
+    GTEXT_CSV_Error err = {};
+    EXPECT_EQ(gtext_csv_reader_next_batch(reader, batch, 10, &err),
+        GTEXT_CSV_E_UNTERMINATED_QUOTE);
+    EXPECT_EQ(err.code, GTEXT_CSV_E_UNTERMINATED_QUOTE);
+    EXPECT_EQ(gtext_csv_batch_row_count(batch), 0u);
+    gtext_csv_error_free(&err);
+  }
+  EXPECT_EQ(gtext_csv_reader_next_batch(reader, batch, 0, nullptr),
+      GTEXT_CSV_E_INVALID);
+  gtext_csv_batch_free(batch);
+  gtext_csv_reader_free(reader);
+}
+
+// ============================================================================
+// Row Offset Index Tests
+// ============================================================================
+
+// Write a file into the test temporary directory and return its path
+static std::string index_test_file(
+    const std::string & name, const std::string & contents) {
+  std::string path = ::testing::TempDir() + name;
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << contents;
+  return path;
+}
+
+// Test seeks return the same rows as a full table parse
+TEST(CsvIndex, SeekMatchesTable) {
+  std::string input = "\xEF\xBB\xBF" + reader_test_input(5000);
+  std::string csv_path = index_test_file("csv_index_seek.csv", input);
+  std::string index_path = ::testing::TempDir() + "csv_index_seek.idx";
+  ASSERT_EQ(gtext_csv_index_build(
+                csv_path.c_str(), index_path.c_str(), 64, nullptr, nullptr),
+      GTEXT_CSV_OK);
+
+  GTEXT_CSV_Index * index = gtext_csv_index_open(
+      csv_path.c_str(), index_path.c_str(), nullptr, nullptr);
+  ASSERT_NE(index, nullptr);
+  EXPECT_EQ(gtext_csv_index_row_count(index), 5000u);
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input.data(), input.size(), nullptr, nullptr);
+  ASSERT_NE(table, nullptr);
+  GTEXT_CSV_Batch * batch = gtext_csv_batch_new();
+  ASSERT_NE(batch, nullptr);
+
+  for (size_t row : {0u, 1u, 63u, 64u, 65u, 2503u, 4998u}) {
+    ASSERT_EQ(gtext_csv_seek_row(index, row, 3, batch, nullptr), GTEXT_CSV_OK);
+    size_t count = gtext_csv_batch_row_count(batch);
+    ASSERT_EQ(count, std::min<size_t>(3, 5000 - row));
+    for (size_t r = 0; r < count; r++) {
+      size_t field_count = 0;
+      const GTEXT_CSV_Field_Span * fields =
+          gtext_csv_batch_row(batch, r, &field_count);
+      ASSERT_EQ(field_count, gtext_csv_col_count(table, row + r));
+      for (size_t c = 0; c < field_count; c++) {
+        size_t len = 0;
+        const char * expected = gtext_csv_field(table, row + r, c, &len);
+        EXPECT_EQ(std::string(fields[c].data, fields[c].length),
+            std::string(expected, len))
+            << "row " << row + r << " col " << c;
+      }
+    }
+  }
+
+  GTEXT_CSV_Error err = {};
+  EXPECT_EQ(gtext_csv_seek_row(index, 5000, 1, batch, &err),
+      GTEXT_CSV_E_INVALID);
+  gtext_csv_error_free(&err);
+  gtext_csv_batch_free(batch);
+  gtext_csv_free_table(table);
+  gtext_csv_index_close(index);
+}
+
+// Test an index is rejected once its file changes or when it is not an index
+TEST(CsvIndex, StaleOrCorruptIndexRejected) {
+  std::string csv_path = index_test_file("csv_index_stale.csv", "a,b\nc,d\n");
+  std::string index_path = ::testing::TempDir() + "csv_index_stale.idx";
+  ASSERT_EQ(gtext_csv_index_build(
+                csv_path.c_str(), index_path.c_str(), 1, nullptr, nullptr),
+      GTEXT_CSV_OK);
+  index_test_file("csv_index_stale.csv", "a,b\nc,d\ne,f\n");
+
+  GTEXT_CSV_Error err = {};
+  EXPECT_EQ(gtext_csv_index_open(
+                csv_path.c_str(), index_path.c_str(), nullptr, &err),
+      nullptr);
+  EXPECT_EQ(err.code, GTEXT_CSV_E_STATE);
+  gtext_csv_error_free(&err);
+
+  index_test_file("csv_index_stale.idx", "not an index");
+  err = {};
+  EXPECT_EQ(gtext_csv_index_open(
+                csv_path.c_str(), index_path.c_str(), nullptr, &err),
+      nullptr);
+  EXPECT_EQ(err.code, GTEXT_CSV_E_INVALID);
+  gtext_csv_error_free(&err);
+  EXPECT_EQ(gtext_csv_index_build(
+                csv_path.c_str(), index_path.c_str(), 0, nullptr, nullptr),
+      GTEXT_CSV_E_INVALID);
+}
+
+// Test a same-size rewrite within the same second still invalidates the index
+TEST(CsvIndex, SubsecondRewriteRejected) {
+  std::string csv_path = index_test_file("csv_index_nsec.csv", "a,b\nc,d\n");
+  std::string index_path = ::testing::TempDir() + "csv_index_nsec.idx";
+  auto second = std::chrono::time_point_cast<std::chrono::seconds>(
+      std::filesystem::last_write_time(csv_path));
+  std::filesystem::last_write_time(
+      csv_path, second + std::chrono::milliseconds(100));
+  ASSERT_EQ(gtext_csv_index_build(
+                csv_path.c_str(), index_path.c_str(), 1, nullptr, nullptr),
+      GTEXT_CSV_OK);
+
+  index_test_file("csv_index_nsec.csv", "a,b\nc,e\n");
+  std::filesystem::last_write_time(
+      csv_path, second + std::chrono::milliseconds(600));
+  GTEXT_CSV_Error err = {};
+  EXPECT_EQ(gtext_csv_index_open(
+                csv_path.c_str(), index_path.c_str(), nullptr, &err),
+      nullptr);
+  EXPECT_EQ(err.code, GTEXT_CSV_E_STATE);
+  gtext_csv_error_free(&err);
+}
+
+// ============================================================================
+// Column Hash Index Tests
+// ============================================================================
+
+// Data rows whose column equals a value, found by scanning the table
+static std::vector<size_t> scan_rows(
+    const GTEXT_CSV_Table * table, size_t col, const std::string & value) {
+  std::vector<size_t> rows;
+  for (size_t row = 0; row < gtext_csv_row_count(table); row++) {
+    size_t len;
+    const char * data = gtext_csv_field(table, row, col, &len);
+    if (data && std::string(data, len) == value) {
+      rows.push_back(row);
+    }
+  }
+  return rows;
+}
+
+// Data rows found by gtext_csv_lookup()
+static std::vector<size_t> lookup_rows(
+    GTEXT_CSV_Table * table, size_t col, const std::string & value) {
+  const size_t * rows = nullptr;
+  size_t count = 0;
+  EXPECT_EQ(gtext_csv_lookup(
+                table, col, value.data(), value.size(), &rows, &count),
+      GTEXT_CSV_OK);
+  return std::vector<size_t>(rows, rows + count);
+}
+
+// Test lookups return every matching row in order, in both layouts
+TEST(CsvHashIndex, LookupFindsAllRows) {
+  std::string input = "id,name\n";
+  for (int i = 0; i < 3000; i++) {
+    input += std::to_string(i % 997) + ",n" + std::to_string(i) + "\n";
+  }
+  input += ",empty\nshort\n";
+
+  for (GTEXT_CSV_Layout layout :
+      {GTEXT_CSV_LAYOUT_ROWS, GTEXT_CSV_LAYOUT_COLUMNS}) {
+    GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+    opts.dialect.treat_first_row_as_header = true;
+    opts.layout = layout;
+    GTEXT_CSV_Table * table =
+        gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+    ASSERT_NE(table, nullptr);
+
+    const size_t * rows = nullptr;
+    size_t count = 0;
+    EXPECT_EQ(gtext_csv_lookup(table, 0, "1", 1, &rows, &count),
+        GTEXT_CSV_E_INVALID);
+    ASSERT_EQ(gtext_csv_build_index(table, 0), GTEXT_CSV_OK);
+    ASSERT_EQ(gtext_csv_build_index(table, 1), GTEXT_CSV_OK);
+
+    for (const char * value : {"0", "5", "996", "", "short", "id"}) {
+      EXPECT_EQ(lookup_rows(table, 0, value), scan_rows(table, 0, value))
+          << value;
+    }
+    EXPECT_EQ(lookup_rows(table, 0, "5"),
+        (std::vector<size_t>{5, 1002, 1999, 2996}));
+    EXPECT_EQ(lookup_rows(table, 1, "n2999"), std::vector<size_t>{2999});
+    EXPECT_EQ(gtext_csv_lookup(table, 0, "missing", 7, &rows, &count),
+        GTEXT_CSV_OK);
+    EXPECT_EQ(count, 0u);
+    EXPECT_EQ(rows, nullptr);
+
+    EXPECT_EQ(gtext_csv_drop_index(table, 1), GTEXT_CSV_OK);
+    EXPECT_EQ(gtext_csv_drop_index(table, 1), GTEXT_CSV_E_INVALID);
+    EXPECT_EQ(gtext_csv_lookup(table, 1, "n1", 2, &rows, &count),
+        GTEXT_CSV_E_INVALID);
+    gtext_csv_free_table(table);
+  }
+}
+
+// Test an index follows row and column changes to its table
+TEST(CsvHashIndex, FollowsMutations) {
+  const char * headers[] = {"id", "v"};
+  GTEXT_CSV_Table * table =
+      gtext_csv_new_table_with_headers(headers, nullptr, 2);
+  ASSERT_NE(table, nullptr);
+  ASSERT_EQ(gtext_csv_build_index(table, 0), GTEXT_CSV_OK);
+
+  // Appended rows are added to the index in place
+  for (int i = 0; i < 100; i++) {
+    std::string id = std::to_string(i % 10);
+    std::string v = std::to_string(i);
+    const char * fields[] = {id.c_str(), v.c_str()};
+    ASSERT_EQ(gtext_csv_row_append(table, fields, nullptr, 2, nullptr),
+        GTEXT_CSV_OK);
+  }
+  EXPECT_EQ(lookup_rows(table, 0, "3"), scan_rows(table, 0, "3"));
+  EXPECT_EQ(lookup_rows(table, 0, "3").size(), 10u);
+
+  // Field sets rebuild the index on the next lookup; inserts, removals and
+  // row sets patch it in place
+  ASSERT_EQ(gtext_csv_field_set(table, 3, 0, "x", 1), GTEXT_CSV_OK);
+  EXPECT_EQ(lookup_rows(table, 0, "x"), std::vector<size_t>{3});
+  EXPECT_EQ(lookup_rows(table, 0, "3"), scan_rows(table, 0, "3"));
+  ASSERT_EQ(gtext_csv_row_remove(table, 0), GTEXT_CSV_OK);
+  EXPECT_EQ(lookup_rows(table, 0, "x"), std::vector<size_t>{2});
+  const char * inserted[] = {"x", "new"};
+  ASSERT_EQ(gtext_csv_row_insert(table, 0, inserted, nullptr, 2, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(lookup_rows(table, 0, "x"), (std::vector<size_t>{0, 3}));
+  const char * replaced[] = {"y", "r"};
+  ASSERT_EQ(gtext_csv_row_set(table, 3, replaced, nullptr, 2, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(lookup_rows(table, 0, "x"), std::vector<size_t>{0});
+
+  // Column inserts renumber the index; removing its column drops it
+  ASSERT_EQ(gtext_csv_column_insert(table, 0, "first", 5), GTEXT_CSV_OK);
+  EXPECT_EQ(lookup_rows(table, 1, "y"), std::vector<size_t>{3});
+  const size_t * rows = nullptr;
+  size_t count = 0;
+  EXPECT_EQ(gtext_csv_lookup(table, 0, "y", 1, &rows, &count),
+      GTEXT_CSV_E_INVALID);
+  ASSERT_EQ(gtext_csv_column_remove(table, 0), GTEXT_CSV_OK);
+  EXPECT_EQ(lookup_rows(table, 0, "y"), std::vector<size_t>{3});
+  ASSERT_EQ(gtext_csv_column_remove(table, 0), GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_lookup(table, 0, "y", 1, &rows, &count),
+      GTEXT_CSV_E_INVALID);
+
+  ASSERT_EQ(gtext_csv_table_clear(table), GTEXT_CSV_OK);
+  gtext_csv_free_table(table);
+}
+
+// Test indexes patched by interleaved row edits match a scan after each edit
+TEST(CsvHashIndex, InterleavedEditsMatchScan) {
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  std::string input = "k,v\n";
+  for (int i = 0; i < 500; i++) {
+    input += std::to_string(i % 7) + "," + std::to_string(i % 3) + "\n";
+  }
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+  ASSERT_NE(table, nullptr);
+  ASSERT_EQ(gtext_csv_set_allow_irregular_rows(table, true), GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_build_index(table, 0), GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_build_index(table, 1), GTEXT_CSV_OK);
+
+  unsigned seed = 12345;
+  for (int step = 0; step < 600; step++) {
+    seed = seed * 1103515245u + 12345u;
+    size_t rows = gtext_csv_row_count(table);
+    size_t row = (seed >> 8) % (rows + 1);
+    std::string k = std::to_string((seed >> 4) % 9);
+    std::string v = std::to_string((seed >> 12) % 4);
+    const char * fields[] = {k.c_str(), v.c_str()};
+    switch (step % 3) {
+    case 0:
+      ASSERT_EQ(gtext_csv_row_insert(table, row, fields, nullptr, 2, nullptr),
+          GTEXT_CSV_OK);
+      break;
+    case 1:
+      if (row < rows) {
+        ASSERT_EQ(gtext_csv_row_remove(table, row), GTEXT_CSV_OK);
+      }
+      break;
+    default:
+      // Every fourth set leaves the row too short to hold column 1
+      if (row < rows) {
+        ASSERT_EQ(gtext_csv_row_set(table, row, fields, nullptr,
+                      (seed >> 20) % 4 == 0 ? 1 : 2, nullptr),
+            GTEXT_CSV_OK);
+      }
+      break;
+    }
+    for (int value = 0; value < 9; value++) {
+      std::string key = std::to_string(value);
+      ASSERT_EQ(lookup_rows(table, 0, key), scan_rows(table, 0, key))
+          << "step " << step << " key " << key;
+    }
+    for (int value = 0; value < 4; value++) {
+      std::string key = std::to_string(value);
+      ASSERT_EQ(lookup_rows(table, 1, key), scan_rows(table, 1, key))
+          << "step " << step << " value " << key;
+    }
+  }
+  gtext_csv_free_table(table);
+}
+
+// Test a hash join matches a nested-loop join
+TEST(CsvHashJoin, MatchesNestedLoop) {
+  std::string left_input = "k,a\n";
+  std::string right_input = "b,k2,c\n";
+  for (int i = 0; i < 500; i++) {
+    left_input += std::to_string(i % 37) + ",a" + std::to_string(i) + "\n";
+  }
+  for (int i = 0; i < 300; i++) {
+    right_input += "b" + std::to_string(i) + "," + std::to_string(i % 53) +
+        (i % 7 == 0 ? "\n" : ",c\n");
+  }
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  GTEXT_CSV_Table * left = gtext_csv_parse_table(
+      left_input.data(), left_input.size(), &opts, nullptr);
+  GTEXT_CSV_Table * right = gtext_csv_parse_table(
+      right_input.data(), right_input.size(), &opts, nullptr);
+  ASSERT_NE(left, nullptr);
+  ASSERT_NE(right, nullptr);
+
+  auto cell = [](const GTEXT_CSV_Table * table, size_t row, size_t col) {
+    size_t len = 0;
+    const char * data = gtext_csv_field(table, row, col, &len);
+    return data ? std::string(data, len) : std::string();
+  };
+  std::vector<std::string> expected;
+  for (size_t l = 0; l < gtext_csv_row_count(left); l++) {
+    for (size_t r = 0; r < gtext_csv_row_count(right); r++) {
+      if (cell(left, l, 0) == cell(right, r, 1)) {
+        expected.push_back(cell(left, l, 0) + "|" + cell(left, l, 1) + "|" +
+            cell(right, r, 0) + "|" + cell(right, r, 1) + "|" +
+            cell(right, r, 2));
+      }
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+
+  // With a temporary index, then with the right table's own index
+  for (int pass = 0; pass < 2; pass++) {
+    if (pass == 1) {
+      ASSERT_EQ(gtext_csv_build_index(right, 1), GTEXT_CSV_OK);
+    }
+    GTEXT_CSV_Table * joined = gtext_csv_hash_join(left, 0, right, 1, nullptr);
+    ASSERT_NE(joined, nullptr);
+    ASSERT_EQ(gtext_csv_row_count(joined), expected.size());
+    EXPECT_FALSE(gtext_csv_has_irregular_rows(joined));
+    size_t index = 0;
+    EXPECT_EQ(gtext_csv_header_index(joined, "k2", &index), GTEXT_CSV_OK);
+    EXPECT_EQ(index, 3u);
+    for (size_t row = 0; row < expected.size(); row++) {
+      std::string got = cell(joined, row, 0);
+      for (size_t col = 1; col < 5; col++) {
+        got += "|" + cell(joined, row, col);
+      }
+      EXPECT_EQ(got, expected[row]) << row;
+    }
+    gtext_csv_free_table(joined);
+  }
+
+  gtext_csv_free_table(left);
+  gtext_csv_free_table(right);
+}
+
+// Test a join whose tables share header names, padding columns included
+TEST(CsvHashJoin, SharedHeaderNames) {
+  const char * left_input = "id,x\n1,a,extra\n2,b\n";
+  const char * right_input = "id,y\n1,p\n3,r\n1,q,wide\n";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  GTEXT_CSV_Table * left = gtext_csv_parse_table(
+      left_input, strlen(left_input), &opts, nullptr);
+  GTEXT_CSV_Table * right = gtext_csv_parse_table(
+      right_input, strlen(right_input), &opts, nullptr);
+  ASSERT_NE(left, nullptr);
+  ASSERT_NE(right, nullptr);
+
+  GTEXT_CSV_Error err = {};
+  GTEXT_CSV_Table * joined = gtext_csv_hash_join(left, 0, right, 0, &err);
+  ASSERT_NE(joined, nullptr) << (err.message ? err.message : "");
+  EXPECT_EQ(gtext_csv_col_count(joined, 0), 6u);
+
+  // Names resolve to their first column
+  size_t index = 0;
+  EXPECT_EQ(gtext_csv_header_index(joined, "id", &index), GTEXT_CSV_OK);
+  EXPECT_EQ(index, 0u);
+  EXPECT_EQ(gtext_csv_header_index(joined, "y", &index), GTEXT_CSV_OK);
+  EXPECT_EQ(index, 4u);
+
+  ASSERT_EQ(gtext_csv_row_count(joined), 2u);
+  const char * expected[2][6] = {
+      {"1", "a", "extra", "1", "p", ""}, {"1", "a", "extra", "1", "q", "wide"}};
+  for (size_t row = 0; row < 2; row++) {
+    for (size_t col = 0; col < 6; col++) {
+      size_t len = 0;
+      const char * data = gtext_csv_field(joined, row, col, &len);
+      ASSERT_NE(data, nullptr);
+      EXPECT_EQ(std::string(data, len), expected[row][col]) << row << col;
+    }
+  }
+
+  gtext_csv_free_table(joined);
+  gtext_csv_free_table(left);
+  gtext_csv_free_table(right);
+}
+
+// ============================================================================
+// Table Sort Tests
+// ============================================================================
+
+// Cells of one column of a table, data rows only
+static std::vector<std::string> column_cells(
+    const GTEXT_CSV_Table * table, size_t col) {
+  std::vector<std::string> cells;
+  for (size_t row = 0; row < gtext_csv_row_count(table); row++) {
+    size_t len = 0;
+    const char * data = gtext_csv_field(table, row, col, &len);
+    cells.push_back(data ? std::string(data, len) : std::string());
+  }
+  return cells;
+}
+
+// Test each comparator, direction, and multi-key ordering on a small table
+TEST(CsvTableSort, Comparators) {
+  const char * input = "name,n,id\n"
+                       "a10,3,0\n"
+                       "a2,x,1\n"
+                       "b,-1.5,2\n"
+                       "a02,3,3\n"
+                       "a1,,4\n"
+                       "a2,10,5\n";
+  for (GTEXT_CSV_Layout layout :
+      {GTEXT_CSV_LAYOUT_ROWS, GTEXT_CSV_LAYOUT_COLUMNS}) {
+    GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+    opts.dialect.treat_first_row_as_header = true;
+    opts.layout = layout;
+    GTEXT_CSV_Table * table =
+        gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+    ASSERT_NE(table, nullptr);
+
+    GTEXT_CSV_Sort_Key natural = {0, GTEXT_CSV_COMPARE_NATURAL, false};
+    ASSERT_EQ(gtext_csv_table_sort(table, &natural, 1, 0), GTEXT_CSV_OK);
+    EXPECT_EQ(column_cells(table, 2),
+        (std::vector<std::string>{"4", "3", "1", "5", "0", "2"}));
+
+    GTEXT_CSV_Sort_Key lexicographic = {0, GTEXT_CSV_COMPARE_LEXICOGRAPHIC,
+        true};
+    ASSERT_EQ(gtext_csv_table_sort(table, &lexicographic, 1, 0),
+        GTEXT_CSV_OK);
+    EXPECT_EQ(column_cells(table, 0),
+        (std::vector<std::string>{"b", "a2", "a2", "a10", "a1", "a02"}));
+
+    // Non-numbers stay last when descending; ties keep their order
+    GTEXT_CSV_Sort_Key numeric = {1, GTEXT_CSV_COMPARE_NUMERIC, true};
+    ASSERT_EQ(gtext_csv_table_sort(table, &numeric, 1, 0), GTEXT_CSV_OK);
+    EXPECT_EQ(column_cells(table, 2),
+        (std::vector<std::string>{"5", "0", "3", "2", "1", "4"}));
+
+    GTEXT_CSV_Sort_Key keys[] = {{1, GTEXT_CSV_COMPARE_NUMERIC, false},
+        {0, GTEXT_CSV_COMPARE_LEXICOGRAPHIC, false}};
+    ASSERT_EQ(gtext_csv_table_sort(table, keys, 2, 0), GTEXT_CSV_OK);
+    EXPECT_EQ(column_cells(table, 2),
+        (std::vector<std::string>{"2", "3", "0", "5", "4", "1"}));
+
+    // The header row stays in place
+    size_t index = 0;
+    EXPECT_EQ(gtext_csv_header_index(table, "id", &index), GTEXT_CSV_OK);
+    EXPECT_EQ(index, 2u);
+    EXPECT_EQ(gtext_csv_table_sort(table, keys, 0, 0), GTEXT_CSV_E_INVALID);
+    gtext_csv_free_table(table);
+  }
 }
 
-// In-Situ Mode Tests
-TEST(CsvTableInSitu, BasicInSitu) {
-  // Simple CSV with unquoted fields - should use in-situ mode when possible
-  const char * input = "a,b,c";
-  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
-  opts.in_situ_mode = true;
-  opts.validate_utf8 = false; // UTF-8 validation disables in-situ mode
+// Test parallel sorts of a large table match std::stable_sort
+TEST(CsvTableSort, ParallelMatchesStableSort) {
+  std::string input = "k,n,id\n";
+  uint32_t seed = 12345;
+  std::vector<std::vector<std::string>> rows;
+  for (int i = 0; i < 70000; i++) {
+    seed = seed * 1103515245u + 12345u;
+    std::string k = "key" + std::to_string((seed >> 8) % 50);
+    std::string n = std::to_string((int)((seed >> 4) % 2000) - 1000);
+    rows.push_back({k, n, std::to_string(i)});
+    input += k + "," + n + "," + std::to_string(i) + "\n";
+  }
+  std::vector<std::vector<std::string>> expected = rows;
+  std::stable_sort(expected.begin(), expected.end(),
+      [](const std::vector<std::string> & a,
+          const std::vector<std::string> & b) {
+        if (a[0] != b[0]) {
+          return a[0] < b[0];
+        }
+        return std::stol(a[1]) > std::stol(b[1]);
+      });
+  std::vector<std::string> expected_ids;
+  for (const auto & row : expected) {
+    expected_ids.push_back(row[2]);
+  }
 
-  GTEXT_CSV_Table * table =
-      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
-  EXPECT_NE(table, nullptr);
-  EXPECT_EQ(gtext_csv_row_count(table), 1u);
-  EXPECT_EQ(gtext_csv_col_count(table, 0), 3u);
+  GTEXT_CSV_Sort_Key keys[] = {{0, GTEXT_CSV_COMPARE_LEXICOGRAPHIC, false},
+      {1, GTEXT_CSV_COMPARE_NUMERIC, true}};
+  for (GTEXT_CSV_Layout layout :
+      {GTEXT_CSV_LAYOUT_ROWS, GTEXT_CSV_LAYOUT_COLUMNS}) {
+    for (size_t threads : {1u, 3u, 4u}) {
+      GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+      opts.dialect.treat_first_row_as_header = true;
+      opts.layout = layout;
+      GTEXT_CSV_Table * table =
+          gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+      ASSERT_NE(table, nullptr);
+      ASSERT_EQ(gtext_csv_build_index(table, 0), GTEXT_CSV_OK);
+      ASSERT_EQ(gtext_csv_table_sort(table, keys, 2, threads), GTEXT_CSV_OK);
+      EXPECT_EQ(column_cells(table, 2), expected_ids) << threads;
+
+      // Indexes see the new row order
+      EXPECT_EQ(lookup_rows(table, 0, "key7"), scan_rows(table, 0, "key7"));
+      gtext_csv_free_table(table);
+    }
+  }
+}
 
-  // Verify content is correct (in-situ mode may or may not be used depending on
-  // implementation)
-  size_t len;
-  const char * field0 = gtext_csv_field(table, 0, 0, &len);
-  EXPECT_NE(field0, nullptr);
-  EXPECT_EQ(len, 1u);
-  EXPECT_EQ(std::string(field0, len), "a");
+// ============================================================================
+// External Sort Tests
+// ============================================================================
 
-  const char * field1 = gtext_csv_field(table, 0, 1, &len);
-  EXPECT_NE(field1, nullptr);
-  EXPECT_EQ(len, 1u);
-  EXPECT_EQ(std::string(field1, len), "b");
+// Read a whole file into a string
+static std::string read_test_file(const std::string & path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::string(
+      std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
 
-  gtext_csv_free_table(table);
+// Record the last progress report of an external sort
+static void extsort_progress(
+    const GTEXT_CSV_Extsort_Progress * progress, void * user_data) {
+  *(GTEXT_CSV_Extsort_Progress *)user_data = *progress;
 }
 
-TEST(CsvTableInSitu, QuotedFieldsFallback) {
-  // Quoted fields with doubled quotes need unescaping - should fall back to
-  // copy
-  const char * input = "a,\"b\"\"c\",d";
-  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
-  opts.in_situ_mode = true;
-  opts.validate_utf8 = false;
+// Test spilled and merged runs give the same output as an in-memory sort
+TEST(CsvExtsort, MatchesTableSort) {
+  std::string input = make_parallel_csv_input(20000);
+  std::string input_path = index_test_file("csv_extsort_in.csv", input);
+  std::string output_path = ::testing::TempDir() + "csv_extsort_out.csv";
+  std::filesystem::path run_dir =
+      std::filesystem::path(::testing::TempDir()) / "csv_extsort_runs";
+  std::filesystem::remove_all(run_dir);
+  ASSERT_TRUE(std::filesystem::create_directory(run_dir));
+  std::string run_dir_name = run_dir.string();
 
+  GTEXT_CSV_Parse_Options parse_opts = gtext_csv_parse_options_default();
+  parse_opts.dialect.treat_first_row_as_header = true;
   GTEXT_CSV_Table * table =
-      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
-  EXPECT_NE(table, nullptr);
-  EXPECT_EQ(gtext_csv_row_count(table), 1u);
-  EXPECT_EQ(gtext_csv_col_count(table, 0), 3u);
+      gtext_csv_parse_table(input.data(), input.size(), &parse_opts, nullptr);
+  ASSERT_NE(table, nullptr);
+  GTEXT_CSV_Sort_Key keys[] = {{1, GTEXT_CSV_COMPARE_LEXICOGRAPHIC, false},
+      {0, GTEXT_CSV_COMPARE_NUMERIC, true}};
+  ASSERT_EQ(gtext_csv_table_sort(table, keys, 2, 0), GTEXT_CSV_OK);
+  std::string expected = write_table_to_string(table, nullptr);
+  gtext_csv_free_table(table);
+
+  // Budgets from one run to enough runs for two merge passes
+  for (size_t budget : {0u, 1u << 20, 16u << 10}) {
+    GTEXT_CSV_Extsort_Progress progress = {};
+    GTEXT_CSV_Extsort_Options opts = gtext_csv_extsort_options_default();
+    opts.keys = keys;
+    opts.key_count = 2;
+    opts.memory_limit_bytes = budget;
+    opts.sort_threads = 2;
+    opts.temp_dir = run_dir_name.c_str();
+    opts.progress = extsort_progress;
+    opts.progress_data = &progress;
+    ASSERT_EQ(gtext_csv_extsort(input_path.c_str(), output_path.c_str(), &opts,
+                  &parse_opts, nullptr, nullptr),
+        GTEXT_CSV_OK);
+    EXPECT_EQ(read_test_file(output_path), expected) << budget;
+
+    EXPECT_EQ(progress.phase, GTEXT_CSV_EXTSORT_OUTPUT);
+    EXPECT_EQ(progress.bytes_read, input.size());
+    EXPECT_EQ(progress.bytes_total, input.size());
+    EXPECT_EQ(progress.rows_read, 20001u);
+    EXPECT_EQ(progress.rows_written, 20001u);
+    if (budget == 0) {
+      EXPECT_EQ(progress.runs_written, 0u);
+    }
+    else if (budget < (1u << 20)) {
+      EXPECT_GT(progress.runs_written, 64u);
+    }
+    EXPECT_TRUE(std::filesystem::is_empty(run_dir)) << budget;
+  }
+  std::filesystem::remove_all(run_dir);
+}
+
+// Test unique sorts keep the first record of each key in input order
+TEST(CsvExtsort, UniqueKeepsFirst) {
+  std::string input = "5,a\n1,b\n1.0,c\nx,d\n5,e\n,f\n2,g\nx,h\n1,i\n";
+  std::string input_path = index_test_file("csv_extsort_dup.csv", input);
+  std::string output_path = ::testing::TempDir() + "csv_extsort_dup_out.csv";
+
+  GTEXT_CSV_Sort_Key key = {0, GTEXT_CSV_COMPARE_NUMERIC, false};
+  GTEXT_CSV_Extsort_Options opts = gtext_csv_extsort_options_default();
+  opts.keys = &key;
+  opts.key_count = 1;
+  opts.unique = true;
+  std::string temp_dir = ::testing::TempDir();
+  opts.temp_dir = temp_dir.c_str();
+  GTEXT_CSV_Write_Options write_opts = gtext_csv_write_options_default();
+  write_opts.quote_empty_fields = false;
+  for (size_t budget : {0u, 1u}) {
+    opts.memory_limit_bytes = budget;
+    ASSERT_EQ(gtext_csv_extsort(input_path.c_str(), output_path.c_str(), &opts,
+                  nullptr, &write_opts, nullptr),
+        GTEXT_CSV_OK);
+    EXPECT_EQ(read_test_file(output_path), "1,b\n2,g\n5,a\n,f\nx,d\n")
+        << budget;
+  }
 
-  // Verify content is correct
-  size_t len;
-  const char * field0 = gtext_csv_field(table, 0, 0, &len);
-  EXPECT_EQ(std::string(field0, len), "a");
+  GTEXT_CSV_Error err = {};
+  opts.key_count = 0;
+  EXPECT_EQ(gtext_csv_extsort(input_path.c_str(), output_path.c_str(), &opts,
+                nullptr, nullptr, &err),
+      GTEXT_CSV_E_INVALID);
+  gtext_csv_error_free(&err);
+}
 
-  // Middle field (quoted with doubled quotes) needs unescaping - should be
-  // copied
-  const char * field1 = gtext_csv_field(table, 0, 1, &len);
-  EXPECT_NE(field1, nullptr);
-  EXPECT_EQ(len, 3u); // "b"c" -> b"c (unescaped)
-  EXPECT_EQ(std::string(field1, len), "b\"c");
+// ============================================================================
+// CSV/JSON Conversion Tests
+// ============================================================================
 
-  const char * field2 = gtext_csv_field(table, 0, 2, &len);
-  EXPECT_EQ(std::string(field2, len), "d");
+// Convert CSV to JSON, feeding the input chunk bytes at a time
+static std::string convert_csv_to_json(const std::string & csv,
+    const GTEXT_CSV_To_JSON_Options & opts, size_t chunk,
+    const GTEXT_CSV_Parse_Options * parse_opts = nullptr) {
+  GTEXT_JSON_Sink sink;
+  EXPECT_EQ(gtext_json_sink_buffer(&sink), GTEXT_JSON_OK);
+  GTEXT_CSV_To_JSON * conv =
+      gtext_csv_to_json_new(parse_opts, &opts, sink, nullptr);
+  EXPECT_NE(conv, nullptr);
+  GTEXT_CSV_Status status = GTEXT_CSV_OK;
+  for (size_t pos = 0; status == GTEXT_CSV_OK && pos < csv.size();
+       pos += chunk) {
+    status = gtext_csv_to_json_feed(
+        conv, csv.data() + pos, std::min(chunk, csv.size() - pos), nullptr);
+  }
+  if (status == GTEXT_CSV_OK) {
+    status = gtext_csv_to_json_finish(conv, nullptr);
+  }
+  std::string out = status == GTEXT_CSV_OK
+      ? std::string(gtext_json_sink_buffer_data(&sink),
+            gtext_json_sink_buffer_size(&sink))
+      : "<status " + std::to_string(status) + ">";
+  gtext_csv_to_json_free(conv);
+  gtext_json_sink_buffer_free(&sink);
+  return out;
+}
+
+// Convert JSON to CSV, feeding the input chunk bytes at a time
+static std::string convert_json_to_csv(const std::string & json,
+    const GTEXT_CSV_From_JSON_Options & opts, size_t chunk) {
+  GTEXT_CSV_Sink sink;
+  EXPECT_EQ(gtext_csv_sink_buffer(&sink), GTEXT_CSV_OK);
+  GTEXT_CSV_Write_Options write_opts = gtext_csv_write_options_default();
+  write_opts.quote_empty_fields = false;
+  GTEXT_CSV_From_JSON * conv =
+      gtext_csv_from_json_new(nullptr, &opts, &sink, &write_opts);
+  EXPECT_NE(conv, nullptr);
+  GTEXT_JSON_Error err = {};
+  GTEXT_JSON_Status status = GTEXT_JSON_OK;
+  for (size_t pos = 0; status == GTEXT_JSON_OK && pos < json.size();
+       pos += chunk) {
+    status = gtext_csv_from_json_feed(
+        conv, json.data() + pos, std::min(chunk, json.size() - pos), &err);
+  }
+  if (status == GTEXT_JSON_OK) {
+    status = gtext_csv_from_json_finish(conv, &err);
+  }
+  std::string out = status == GTEXT_JSON_OK
+      ? std::string(gtext_csv_sink_buffer_data(&sink),
+            gtext_csv_sink_buffer_size(&sink))
+      : "<status " + std::to_string(status) + ">";
+  gtext_json_error_free(&err);
+  gtext_csv_from_json_free(conv);
+  gtext_csv_sink_buffer_free(&sink);
+  return out;
+}
+
+// Test CSV records become objects keyed by the header, whatever the chunking
+TEST(CsvJson, CsvToJsonArray) {
+  std::string csv = "id,name,id,score\n"
+                    "1,\"Smith, J\",x,-0.5e3\n"
+                    "012,\"two\nlines\",y,1.\n"
+                    "3,,z,7,extra\n"
+                    "4\n";
+  GTEXT_CSV_To_JSON_Options opts = gtext_csv_to_json_options_default();
+  std::string strings =
+      "[{\"id\":\"1\",\"name\":\"Smith, J\",\"score\":\"-0.5e3\"},"
+      "{\"id\":\"012\",\"name\":\"two\\nlines\",\"score\":\"1.\"},"
+      "{\"id\":\"3\",\"name\":\"\",\"score\":\"7\",\"4\":\"extra\"},"
+      "{\"id\":\"4\"}]";
+  for (size_t chunk : {1u, 5u, 1000u}) {
+    EXPECT_EQ(convert_csv_to_json(csv, opts, chunk), strings) << chunk;
+  }
 
-  gtext_csv_free_table(table);
-}
+  opts.infer_numbers = true;
+  opts.empty_as_null = true;
+  EXPECT_EQ(convert_csv_to_json(csv, opts, 3),
+      "[{\"id\":1,\"name\":\"Smith, J\",\"score\":-0.5e3},"
+      "{\"id\":\"012\",\"name\":\"two\\nlines\",\"score\":\"1.\"},"
+      "{\"id\":3,\"name\":null,\"score\":7,\"4\":\"extra\"},"
+      "{\"id\":4}]");
 
-TEST(CsvTableInSitu, Utf8ValidationDisablesInSitu) {
-  // When UTF-8 validation is enabled, in-situ mode is disabled
-  const char * input = "a,b,c";
-  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
-  opts.in_situ_mode = true;
-  opts.validate_utf8 = true; // This disables in-situ mode
+  // LAST_WINS writes the later "id" column; ERROR rejects the header
+  GTEXT_CSV_Parse_Options parse_opts = gtext_csv_parse_options_default();
+  parse_opts.dialect.header_dup_mode = GTEXT_CSV_DUPCOL_LAST_WINS;
+  opts = gtext_csv_to_json_options_default();
+  EXPECT_EQ(convert_csv_to_json("id,id\n1,x\n", opts, 4, &parse_opts),
+      "[{\"id\":\"x\"}]");
+  parse_opts.dialect.header_dup_mode = GTEXT_CSV_DUPCOL_ERROR;
+  EXPECT_EQ(convert_csv_to_json("id,id\n1,x\n", opts, 4, &parse_opts),
+      "<status " + std::to_string(GTEXT_CSV_E_INVALID) + ">");
+
+  EXPECT_EQ(convert_csv_to_json("", opts, 1), "[]");
+  EXPECT_EQ(convert_csv_to_json("a,b\n", opts, 1), "[]");
+}
+
+// Test NDJSON output and converter errors
+TEST(CsvJson, CsvToJsonLines) {
+  GTEXT_CSV_To_JSON_Options opts = gtext_csv_to_json_options_default();
+  opts.format = GTEXT_CSV_JSON_LINES;
+  opts.infer_numbers = true;
+  EXPECT_EQ(convert_csv_to_json("a,b\r\n1,x\r\n2,y", opts, 2),
+      "{\"a\":1,\"b\":\"x\"}\n{\"a\":2,\"b\":\"y\"}\n");
+  EXPECT_EQ(convert_csv_to_json("a,b\n", opts, 1), "");
+
+  // A parse error stops the converter
+  GTEXT_JSON_Sink sink;
+  ASSERT_EQ(gtext_json_sink_buffer(&sink), GTEXT_JSON_OK);
+  GTEXT_CSV_To_JSON * conv =
+      gtext_csv_to_json_new(nullptr, &opts, sink, nullptr);
+  ASSERT_NE(conv, nullptr);
+  GTEXT_CSV_Error err = {};
+  std::string bad = "a\n\"open\n";
+  EXPECT_EQ(gtext_csv_to_json_feed(conv, bad.data(), bad.size(), &err),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_to_json_finish(conv, &err),
+      GTEXT_CSV_E_UNTERMINATED_QUOTE);
+  gtext_csv_error_free(&err);
+  EXPECT_EQ(gtext_csv_to_json_finish(conv, &err), GTEXT_CSV_E_STATE);
+  gtext_csv_to_json_free(conv);
+  gtext_json_sink_buffer_free(&sink);
+
+  EXPECT_EQ(gtext_csv_to_json_feed(nullptr, "a", 1, &err), GTEXT_CSV_E_INVALID);
+}
+
+// Test columns are discovered from the first records in first-seen order
+TEST(CsvJson, JsonToCsvDiscovery) {
+  std::string json = "[{\"a\":1,\"b\":\"x,y\"},\n"
+                     " {\"b\":\"two\\nlines\",\"c\":true,\"a\":null},\n"
+                     " {\"c\":false,\"b\":\"\",\"b\":\"last\"},\n"
+                     " {\"a\":-2.50e1}, {}]";
+  GTEXT_CSV_From_JSON_Options opts = gtext_csv_from_json_options_default();
+  std::string expected = "a,b,c\n"
+                         "1,\"x,y\",\n"
+                         ",\"two\nlines\",true\n"
+                         ",last,false\n"
+                         "-2.50e1,,\n"
+                         ",,\n";
+  for (size_t chunk : {1u, 7u, 1000u}) {
+    EXPECT_EQ(convert_json_to_csv(json, opts, chunk), expected) << chunk;
+  }
+  for (size_t discovery : {2u, 3u}) {
+    opts.discovery_records = discovery;
+    EXPECT_EQ(convert_json_to_csv(json, opts, 4), expected) << discovery;
+  }
 
-  GTEXT_CSV_Table * table =
-      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
-  EXPECT_NE(table, nullptr);
-  EXPECT_EQ(gtext_csv_row_count(table), 1u);
-  EXPECT_EQ(gtext_csv_col_count(table, 0), 3u);
+  // "c" first appears in the second record
+  opts.discovery_records = 1;
+  EXPECT_EQ(convert_json_to_csv(json, opts, 4),
+      "<status " + std::to_string(GTEXT_JSON_E_INVALID) + ">");
+  opts.ignore_unknown_keys = true;
+  opts.write_header = false;
+  EXPECT_EQ(convert_json_to_csv(json, opts, 4),
+      "1,\"x,y\"\n,\"two\nlines\"\n,last\n-2.50e1,\n,\n");
+
+  opts = gtext_csv_from_json_options_default();
+  EXPECT_EQ(convert_json_to_csv("[]", opts, 1), "");
+  EXPECT_EQ(convert_json_to_csv("[{\"a\":[1]}]", opts, 1),
+      "<status " + std::to_string(GTEXT_JSON_E_INVALID) + ">");
+  EXPECT_EQ(convert_json_to_csv("[1]", opts, 1),
+      "<status " + std::to_string(GTEXT_JSON_E_INVALID) + ">");
+  EXPECT_EQ(convert_json_to_csv("{\"a\":1}", opts, 1),
+      "<status " + std::to_string(GTEXT_JSON_E_INVALID) + ">");
+  EXPECT_NE(convert_json_to_csv("[{\"a\":1}", opts, 1).find("<status"),
+      std::string::npos);
+}
+
+// Test converting CSV to JSON and back reproduces the input
+TEST(CsvJson, RoundTrip) {
+  std::string csv = "k,v,note\n";
+  for (int i = 0; i < 500; i++) {
+    csv += std::to_string(i) + "," + std::to_string(i * 0.25) + ",";
+    csv += (i % 3 == 0) ? "\"q,\"\"uoted\"\"\"\n" : "plain\n";
+  }
+  GTEXT_CSV_To_JSON_Options to_opts = gtext_csv_to_json_options_default();
+  to_opts.infer_numbers = true;
+  std::string json = convert_csv_to_json(csv, to_opts, 4096);
+  GTEXT_CSV_From_JSON_Options from_opts =
+      gtext_csv_from_json_options_default();
+  from_opts.discovery_records = 10;
+  EXPECT_EQ(convert_json_to_csv(json, from_opts, 4096), csv);
+}
 
-  // Fields should be copied (not in-situ) when UTF-8 validation is enabled
-  // We verify by checking content is correct
-  size_t len;
-  const char * field0 = gtext_csv_field(table, 0, 0, &len);
-  EXPECT_NE(field0, nullptr);
-  EXPECT_EQ(len, 1u);
-  EXPECT_EQ(std::string(field0, len), "a");
+// ============================================================================
+// Dialect Sniffing Tests
+// ============================================================================
 
-  gtext_csv_free_table(table);
+// Build a sample with a header row, numbers, and quoted fields that contain
+// the delimiter
+static std::string sniff_sample(char delim, const std::string & newline,
+    size_t rows, char quote = '"') {
+  std::string d(1, delim);
+  std::string q(1, quote);
+  std::string out = "id" + d + "name" + d + "score" + newline;
+  for (size_t i = 0; i < rows; i++) {
+    out += std::to_string(i) + d;
+    out += (i % 4 == 0) ? q + "last" + d + " first" + q
+                        : "name" + std::to_string(i * 7);
+    out += d + std::to_string(i * 1.5) + newline;
+  }
+  return out;
 }
 
-TEST(CsvTableInSitu, MixedMode) {
-  // Mix of fields: some in-situ, some copied (due to unescaping)
-  const char * input = "plain,\"quoted\"\"field\",another";
+// Parse input with a sniffed dialect and return its data row count
+static size_t sniff_parse_rows(
+    const std::string & input, const GTEXT_CSV_Dialect & dialect) {
   GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
-  opts.in_situ_mode = true;
-  opts.validate_utf8 = false;
-
+  opts.dialect = dialect;
   GTEXT_CSV_Table * table =
-      gtext_csv_parse_table(input, strlen(input), &opts, nullptr);
+      gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
   EXPECT_NE(table, nullptr);
-  EXPECT_EQ(gtext_csv_row_count(table), 1u);
-  EXPECT_EQ(gtext_csv_col_count(table, 0), 3u);
+  if (!table) {
+    return 0;
+  }
+  size_t rows = gtext_csv_row_count(table);
+  gtext_csv_free_table(table);
+  return rows;
+}
 
-  // Verify content is correct (regardless of in-situ or copied)
-  size_t len;
-  const char * field0 = gtext_csv_field(table, 0, 0, &len);
-  EXPECT_EQ(std::string(field0, len), "plain");
+// Test sniffing each delimiter and newline convention
+TEST(CsvSniff, DelimitersAndNewlines) {
+  for (char delim : {',', ';', '\t', '|'}) {
+    for (std::string newline : {"\n", "\r\n", "\r"}) {
+      SCOPED_TRACE(std::string("delimiter ") + delim);
+      std::string input = sniff_sample(delim, newline, 40);
+      GTEXT_CSV_Dialect dialect;
+      GTEXT_CSV_Sniff_Info info;
+      ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+          GTEXT_CSV_OK);
+      EXPECT_EQ(dialect.delimiter, delim);
+      EXPECT_EQ(dialect.quote, '"');
+      EXPECT_EQ(dialect.escape, GTEXT_CSV_ESCAPE_DOUBLED_QUOTE);
+      EXPECT_STREQ(info.newline, newline.c_str());
+      EXPECT_EQ(dialect.accept_cr, newline == "\r");
+      EXPECT_TRUE(dialect.treat_first_row_as_header);
+      EXPECT_FALSE(dialect.allow_comments);
+      EXPECT_EQ(info.column_count, 3u);
+      EXPECT_EQ(info.record_count, 41u);
+      EXPECT_GT(info.confidence, 0.9);
+      EXPECT_EQ(sniff_parse_rows(input, dialect), 40u);
+    }
+  }
+}
 
-  const char * field1 = gtext_csv_field(table, 0, 1, &len);
-  EXPECT_EQ(std::string(field1, len), "quoted\"field"); // Unescaped
+// Test sniffing quote characters, escapes, comments, and a BOM
+TEST(CsvSniff, QuotesEscapesAndComments) {
+  GTEXT_CSV_Dialect dialect;
+  GTEXT_CSV_Sniff_Info info;
 
-  const char * field2 = gtext_csv_field(table, 0, 2, &len);
-  EXPECT_EQ(std::string(field2, len), "another");
+  std::string input = sniff_sample(',', "\n", 30, '\'');
+  ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, ',');
+  EXPECT_EQ(dialect.quote, '\'');
+  EXPECT_EQ(sniff_parse_rows(input, dialect), 30u);
+
+  // Apostrophes inside unquoted text do not make ' the quote
+  input = "name,note\n";
+  for (int i = 0; i < 20; i++) {
+    input += "O'Brien " + std::to_string(i) + ",\"it's, fine\"\n";
+  }
+  ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, ',');
+  EXPECT_EQ(dialect.quote, '"');
+  EXPECT_EQ(info.column_count, 2u);
 
-  gtext_csv_free_table(table);
+  input = "name,description\n";
+  for (int i = 0; i < 20; i++) {
+    input += "n" + std::to_string(i) + ",\"said \\\"hi\\\", twice\"\n";
+  }
+  ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.escape, GTEXT_CSV_ESCAPE_BACKSLASH);
+  EXPECT_EQ(info.column_count, 2u);
+  EXPECT_TRUE(dialect.treat_first_row_as_header);
+  EXPECT_EQ(sniff_parse_rows(input, dialect), 20u);
+
+  input = "# exported by tool\n# columns: a;b;c\n" + sniff_sample(';', "\n", 20);
+  ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, ';');
+  EXPECT_TRUE(dialect.allow_comments);
+  EXPECT_STREQ(dialect.comment_prefix, "#");
+  EXPECT_TRUE(dialect.treat_first_row_as_header);
+  EXPECT_EQ(info.record_count, 21u);
+  EXPECT_EQ(sniff_parse_rows(input, dialect), 20u);
+
+  // A '#' that starts ordinary records is data
+  input = "tag|count\n";
+  for (int i = 0; i < 20; i++) {
+    input += "#t" + std::to_string(i) + "|" + std::to_string(i) + "\n";
+  }
+  ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, '|');
+  EXPECT_FALSE(dialect.allow_comments);
+  EXPECT_EQ(info.record_count, 21u);
+
+  input = "\xEF\xBB\xBF" + sniff_sample('\t', "\n", 10);
+  ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, '\t');
+  EXPECT_TRUE(dialect.treat_first_row_as_header);
+}
+
+// Test header detection, confidence, and degenerate input
+TEST(CsvSniff, HeaderAndConfidence) {
+  GTEXT_CSV_Dialect dialect;
+  GTEXT_CSV_Sniff_Info info;
+  EXPECT_EQ(gtext_csv_sniff("a", 1, nullptr, &info), GTEXT_CSV_E_INVALID);
+  EXPECT_EQ(gtext_csv_sniff(nullptr, 1, &dialect, &info), GTEXT_CSV_E_INVALID);
+
+  // Nothing to go on
+  ASSERT_EQ(gtext_csv_sniff(nullptr, 0, &dialect, &info), GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, ',');
+  EXPECT_EQ(info.confidence, 0.0);
+  EXPECT_EQ(info.record_count, 0u);
+  ASSERT_EQ(gtext_csv_sniff("\n\n", 2, &dialect, &info), GTEXT_CSV_OK);
+  EXPECT_EQ(info.confidence, 0.0);
+  ASSERT_EQ(gtext_csv_sniff("\xEF\xBB\xBF", 3, &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(info.confidence, 0.0);
+
+  // Numbers all the way down have no header
+  std::string input;
+  for (int i = 0; i < 20; i++) {
+    input += std::to_string(i) + ";" + std::to_string(i * 3) + "\n";
+  }
+  ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, ';');
+  EXPECT_FALSE(dialect.treat_first_row_as_header);
+
+  // Fixed-width values under names of another width
+  input = "code,label\n";
+  for (int i = 0; i < 20; i++) {
+    input += "AB-" + std::to_string(100 + i) + ",l\n";
+  }
+  ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_TRUE(dialect.treat_first_row_as_header);
+
+  // A few records give less confidence than many
+  std::string few = sniff_sample(',', "\n", 2);
+  ASSERT_EQ(gtext_csv_sniff(few.data(), few.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, ',');
+  EXPECT_LT(info.confidence, 0.5);
+
+  // One column and ragged rows are poor guesses
+  input = "alpha\nbeta\ngamma\ndelta\nepsilon\nzeta\neta\ntheta\niota\nkappa\n";
+  ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(info.column_count, 1u);
+  EXPECT_LT(info.confidence, 0.5);
+  input = "a,b\nc,d,e\nf\ng,h,i,j\nk,l\nm,n,o\n";
+  ASSERT_EQ(gtext_csv_sniff(input.data(), input.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_LT(info.confidence, 0.5);
+
+  // Only the start of a large input is read, and a record cut off at the
+  // end of the sample is ignored
+  std::string large = sniff_sample('|', "\r\n", 20000);
+  ASSERT_GT(large.size(), 65536u);
+  ASSERT_EQ(gtext_csv_sniff(large.data(), large.size(), &dialect, &info),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, '|');
+  EXPECT_STREQ(info.newline, "\r\n");
+  EXPECT_GT(info.confidence, 0.9);
+  EXPECT_LE(info.record_count, 1024u);
 }
 
 // ============================================================================
@@ -4255,6 +6958,30 @@ TEST(TestCorpus, DialectBackslashEscape) {
   gtext_csv_error_free(&err);
 }
 
+TEST(TestCorpus, DialectSniff) {
+  std::string base_dir = get_test_data_dir() + "/dialects";
+  GTEXT_CSV_Dialect dialect;
+  std::string content = read_file(base_dir + "/tsv/basic.tsv");
+  ASSERT_FALSE(content.empty());
+  ASSERT_EQ(gtext_csv_sniff(content.data(), content.size(), &dialect, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, '\t');
+  EXPECT_TRUE(dialect.treat_first_row_as_header);
+
+  content = read_file(base_dir + "/semicolon/basic.csv");
+  ASSERT_FALSE(content.empty());
+  ASSERT_EQ(gtext_csv_sniff(content.data(), content.size(), &dialect, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, ';');
+
+  content = read_file(base_dir + "/backslash-escape/basic.csv");
+  ASSERT_FALSE(content.empty());
+  ASSERT_EQ(gtext_csv_sniff(content.data(), content.size(), &dialect, nullptr),
+      GTEXT_CSV_OK);
+  EXPECT_EQ(dialect.delimiter, ',');
+  EXPECT_EQ(dialect.escape, GTEXT_CSV_ESCAPE_BACKSLASH);
+}
+
 // ============================================================================
 // Test Corpus - Edge Cases
 // ============================================================================
@@ -4740,12 +7467,12 @@ TEST(CsvMutation, NewTableEmpty) {
 
   // Test table structure is properly initialized (internal verification)
   EXPECT_EQ(table->row_count, 0u);
-  EXPECT_EQ(table->row_capacity, 16u);
+  EXPECT_EQ(table->row_capacity, 0u); // Row blocks come with the first row
   EXPECT_EQ(table->column_count, 0u);
   EXPECT_EQ(table->has_header, false);
   EXPECT_EQ(table->header_map, nullptr);
   EXPECT_NE(table->ctx, nullptr);
-  EXPECT_NE(table->rows, nullptr);
+  EXPECT_EQ(table->row_blocks, nullptr);
 
   // Test empty table can be freed without errors
   gtext_csv_free_table(table);
@@ -5714,7 +8441,7 @@ TEST(CsvMutation, RowSetWithHeaderRow) {
   EXPECT_STREQ(field, "Charlie");
 
   // Verify header row unchanged (can access via internal structure)
-  EXPECT_STREQ(table->rows[0].fields[0].data, "name");
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[0].data, "name");
 
   gtext_csv_free_table(table);
 }
@@ -6753,20 +9480,20 @@ TEST(CsvColumnInsertionPadding, ColumnInsertWithHeadersPadsHeaderRow) {
 
   // Verify header row was padded: should have 4 fields
   // Access header row directly (it's at index 0 internally)
-  EXPECT_EQ(table->rows[0].field_count, 4u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->field_count, 4u);
   size_t len;
-  const char * field = table->rows[0].fields[0].data;
-  EXPECT_EQ(table->rows[0].fields[0].length, 4u);
+  const char * field = csv_table_row_at(table, 0)->fields[0].data;
+  EXPECT_EQ(csv_table_row_at(table, 0)->fields[0].length, 4u);
   EXPECT_STREQ(field, "col1");
-  field = table->rows[0].fields[1].data;
-  EXPECT_EQ(table->rows[0].fields[1].length, 4u);
+  field = csv_table_row_at(table, 0)->fields[1].data;
+  EXPECT_EQ(csv_table_row_at(table, 0)->fields[1].length, 4u);
   EXPECT_STREQ(field, "col2");
   // Padding at index 2
-  field = table->rows[0].fields[2].data;
-  EXPECT_EQ(table->rows[0].fields[2].length, 0u);
+  field = csv_table_row_at(table, 0)->fields[2].data;
+  EXPECT_EQ(csv_table_row_at(table, 0)->fields[2].length, 0u);
   // New header at index 3
-  field = table->rows[0].fields[3].data;
-  EXPECT_EQ(table->rows[0].fields[3].length, 6u);
+  field = csv_table_row_at(table, 0)->fields[3].data;
+  EXPECT_EQ(csv_table_row_at(table, 0)->fields[3].length, 6u);
   EXPECT_STREQ(field, "newcol");
 
   // Verify data row was padded: should have 4 fields
@@ -7119,11 +9846,11 @@ TEST(CsvNormalization, NormalizeWithHeaders) {
   EXPECT_EQ(status, GTEXT_CSV_OK);
 
   // Header row should be normalized too (access via internal structure)
-  EXPECT_EQ(table->rows[0].field_count, 3u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->field_count, 3u);
   // Verify header row fields directly
-  EXPECT_STREQ(table->rows[0].fields[0].data, "col1");
-  EXPECT_STREQ(table->rows[0].fields[1].data, "col2");
-  EXPECT_EQ(table->rows[0].fields[2].length, 0u);
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[0].data, "col1");
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[1].data, "col2");
+  EXPECT_EQ(csv_table_row_at(table, 0)->fields[2].length, 0u);
 
   // Data rows should be normalized
   EXPECT_EQ(gtext_csv_col_count(table, 0), 3u);
@@ -7247,8 +9974,8 @@ TEST(CsvMutation, TableClearWithHeaders) {
   EXPECT_NE(table->header_map, nullptr); // Header map preserved
 
   // Verify header row is still accessible
-  EXPECT_STREQ(table->rows[0].fields[0].data, "name");
-  EXPECT_STREQ(table->rows[0].fields[1].data, "age");
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[0].data, "name");
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[1].data, "age");
 
   gtext_csv_free_table(table);
 }
@@ -7413,8 +10140,8 @@ TEST(CsvMutation, TableCompactPreservesHeaders) {
   EXPECT_EQ(table->row_count, 3u); // Internal count includes header
 
   // Verify header row is preserved
-  EXPECT_STREQ(table->rows[0].fields[0].data, "name");
-  EXPECT_STREQ(table->rows[0].fields[1].data, "age");
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[0].data, "name");
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[1].data, "age");
 
   // Verify data rows are preserved
   size_t len;
@@ -7501,7 +10228,7 @@ TEST(CsvMutation, TableCompactPreservesInSituFields) {
   // be
   bool found_in_situ = false;
   for (size_t row = 0; row < table->row_count && !found_in_situ; row++) {
-    csv_table_row * table_row = &table->rows[row];
+    csv_table_row * table_row = csv_table_row_at(table, row);
     for (size_t col = 0; col < table_row->field_count; col++) {
       if (table_row->fields[col].is_in_situ) {
         found_in_situ = true;
@@ -7529,6 +10256,344 @@ TEST(CsvMutation, TableCompactPreservesInSituFields) {
   gtext_csv_free_table(table);
 }
 
+// Test incremental compaction while rows are edited, moved, and sorted
+// between steps
+TEST(CsvMutation, TableCompactStepAcrossEdits) {
+  std::string input = "key,value\n";
+  std::vector<std::pair<std::string, std::string>> model;
+  for (size_t i = 0; i < 1000; i++) {
+    std::string key = "k" + std::to_string((i * 7919) % 1000);
+    model.emplace_back(key, "v" + std::to_string(i));
+    input += key + "," + model.back().second + "\n";
+  }
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(input.data(), input.size(), &opts, nullptr);
+  ASSERT_NE(table, nullptr);
+
+  auto set_value = [&](size_t row, const std::string & value) {
+    ASSERT_EQ(gtext_csv_field_set(table, row, 1, value.c_str(), 0),
+        GTEXT_CSV_OK);
+    model[row].second = value;
+  };
+  auto check = [&]() {
+    ASSERT_EQ(gtext_csv_row_count(table), model.size());
+    for (size_t i = 0; i < model.size(); i++) {
+      size_t len = 0;
+      const char * key = gtext_csv_field(table, i, 0, &len);
+      ASSERT_EQ(std::string(key, len), model[i].first) << "row " << i;
+      const char * value = gtext_csv_field(table, i, 1, &len);
+      ASSERT_EQ(std::string(value, len), model[i].second) << "row " << i;
+    }
+  };
+
+  // Replaced values stay in the arena as dead bytes
+  GTEXT_CSV_Memory_Stats stats;
+  ASSERT_EQ(gtext_csv_table_memory_stats(table, &stats), GTEXT_CSV_OK);
+  size_t dead_after_parse = stats.dead_bytes;
+  for (size_t i = 0; i < model.size(); i++) {
+    set_value(i, std::string(40, 'a' + i % 26));
+  }
+  ASSERT_EQ(gtext_csv_table_memory_stats(table, &stats), GTEXT_CSV_OK);
+  EXPECT_GE(stats.dead_bytes, dead_after_parse + 3 * model.size());
+  EXPECT_EQ(stats.live_bytes + stats.dead_bytes, stats.arena_used_bytes);
+  EXPECT_EQ(stats.compacting_bytes, 0u);
+
+  bool done = false;
+  size_t steps = 0;
+  while (!done) {
+    ASSERT_EQ(gtext_csv_table_compact_step(table, 64, &done), GTEXT_CSV_OK);
+    steps++;
+    if (done) {
+      break;
+    }
+    ASSERT_EQ(gtext_csv_table_memory_stats(table, &stats), GTEXT_CSV_OK);
+    EXPECT_GT(stats.compacting_bytes, 0u);
+
+    // Move rows behind and ahead of the compaction between steps
+    const char * fields[] = {"new", "row"};
+    ASSERT_EQ(gtext_csv_row_insert(table, 0, fields, nullptr, 2, nullptr),
+        GTEXT_CSV_OK);
+    model.insert(model.begin(), {"new", "row"});
+    ASSERT_EQ(gtext_csv_row_remove(table, 3), GTEXT_CSV_OK);
+    model.erase(model.begin() + 3);
+    set_value(steps * 13 % model.size(), "edited");
+    if (steps == 5) {
+      GTEXT_CSV_Sort_Key key = {0, GTEXT_CSV_COMPARE_LEXICOGRAPHIC, false};
+      ASSERT_EQ(gtext_csv_table_sort(table, &key, 1, 0), GTEXT_CSV_OK);
+      std::stable_sort(model.begin(), model.end(),
+          [](const auto & a, const auto & b) { return a.first < b.first; });
+    }
+    check();
+  }
+  EXPECT_GT(steps, 10u);
+  check();
+
+  // Only reachable data is left, and the header map moved with it
+  ASSERT_EQ(gtext_csv_table_memory_stats(table, &stats), GTEXT_CSV_OK);
+  EXPECT_EQ(stats.compacting_bytes, 0u);
+  EXPECT_LT(stats.dead_bytes, stats.live_bytes / 4);
+  size_t idx = 0;
+  EXPECT_EQ(gtext_csv_header_index(table, "value", &idx), GTEXT_CSV_OK);
+  EXPECT_EQ(idx, 1u);
+  EXPECT_EQ(gtext_csv_column_rename(table, 1, "renamed", 0), GTEXT_CSV_OK);
+  EXPECT_EQ(gtext_csv_header_index(table, "renamed", &idx), GTEXT_CSV_OK);
+
+  // A finished compaction can be started again
+  ASSERT_EQ(gtext_csv_table_compact_step(table, SIZE_MAX, &done),
+      GTEXT_CSV_OK);
+  EXPECT_TRUE(done);
+  check();
+  gtext_csv_free_table(table);
+}
+
+// Test incremental compaction arguments, abandonment, and the column layout
+TEST(CsvMutation, TableCompactStepModes) {
+  bool done = true;
+  EXPECT_EQ(gtext_csv_table_compact_step(nullptr, 1, &done),
+      GTEXT_CSV_E_INVALID);
+  EXPECT_FALSE(done);
+
+  const char * csv_data = "name,age\nAlice,30\nBob,25\nCarol,41\n";
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  GTEXT_CSV_Table * table =
+      gtext_csv_parse_table(csv_data, strlen(csv_data), &opts, nullptr);
+  ASSERT_NE(table, nullptr);
+  EXPECT_EQ(gtext_csv_table_compact_step(table, 0, &done),
+      GTEXT_CSV_E_INVALID);
+
+  // A full compaction takes over a running one
+  ASSERT_EQ(gtext_csv_table_compact_step(table, 1, &done), GTEXT_CSV_OK);
+  EXPECT_FALSE(done);
+  ASSERT_EQ(gtext_csv_table_compact(table), GTEXT_CSV_OK);
+  GTEXT_CSV_Memory_Stats stats;
+  ASSERT_EQ(gtext_csv_table_memory_stats(table, &stats), GTEXT_CSV_OK);
+  EXPECT_EQ(stats.compacting_bytes, 0u);
+  size_t len = 0;
+  EXPECT_STREQ(gtext_csv_field(table, 2, 0, &len), "Carol");
+  EXPECT_EQ(gtext_csv_column_rename(table, 0, "who", 0), GTEXT_CSV_OK);
+
+  // So does a switch to the column layout, which then compacts in one call
+  ASSERT_EQ(gtext_csv_table_compact_step(table, 2, nullptr), GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_table_set_layout(table, GTEXT_CSV_LAYOUT_COLUMNS),
+      GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_table_compact_step(table, 1, &done), GTEXT_CSV_OK);
+  EXPECT_TRUE(done);
+  EXPECT_STREQ(gtext_csv_field(table, 1, 1, &len), "25");
+  size_t idx = 0;
+  EXPECT_EQ(gtext_csv_header_index(table, "who", &idx), GTEXT_CSV_OK);
+
+  // A table freed in the middle of a compaction releases both arenas
+  ASSERT_EQ(gtext_csv_table_set_layout(table, GTEXT_CSV_LAYOUT_ROWS),
+      GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_table_compact_step(table, 1, &done), GTEXT_CSV_OK);
+  EXPECT_FALSE(done);
+  gtext_csv_free_table(table);
+}
+
+// Build the id,value table used by the copy-on-write clone tests
+static std::vector<std::vector<std::string>> cow_test_model(size_t rows) {
+  std::vector<std::vector<std::string>> model;
+  for (size_t i = 0; i < rows; i++) {
+    model.push_back({std::to_string(i), "v" + std::to_string(i)});
+  }
+  return model;
+}
+
+// Expect the data rows of a table to match a model
+static void cow_expect_rows(const GTEXT_CSV_Table * table,
+    const std::vector<std::vector<std::string>> & model) {
+  ASSERT_EQ(gtext_csv_row_count(table), model.size());
+  for (size_t row = 0; row < model.size(); row++) {
+    ASSERT_EQ(gtext_csv_col_count(table, row), model[row].size());
+    for (size_t col = 0; col < model[row].size(); col++) {
+      size_t len = 0;
+      const char * data = gtext_csv_field(table, row, col, &len);
+      ASSERT_NE(data, nullptr);
+      ASSERT_EQ(std::string(data, len), model[row][col]) << row << "," << col;
+    }
+  }
+}
+
+static GTEXT_CSV_Table * cow_test_table(size_t rows) {
+  std::string csv = "id,value\n";
+  for (const auto & row : cow_test_model(rows)) {
+    csv += row[0] + "," + row[1] + "\n";
+  }
+  GTEXT_CSV_Parse_Options opts = gtext_csv_parse_options_default();
+  opts.dialect.treat_first_row_as_header = true;
+  return gtext_csv_parse_table(csv.data(), csv.size(), &opts, nullptr);
+}
+
+// Test that a copy-on-write clone shares fields and copies only edited rows
+TEST(CsvMutation, CloneCowIsolatesEdits) {
+  const size_t rows = 3 * CSV_ROW_BLOCK_ROWS + 17;
+  GTEXT_CSV_Table * table = cow_test_table(rows);
+  ASSERT_NE(table, nullptr);
+  EXPECT_EQ(gtext_csv_clone_cow(nullptr), nullptr);
+
+  GTEXT_CSV_Table * clone = gtext_csv_clone_cow(table);
+  ASSERT_NE(clone, nullptr);
+  auto table_model = cow_test_model(rows);
+  auto clone_model = table_model;
+  cow_expect_rows(clone, clone_model);
+  EXPECT_EQ(write_table_to_string(clone), write_table_to_string(table));
+
+  // Field data is shared, not copied
+  size_t len = 0;
+  EXPECT_EQ(gtext_csv_field(table, 5, 1, &len),
+      gtext_csv_field(clone, 5, 1, &len));
+  GTEXT_CSV_Memory_Stats stats;
+  ASSERT_EQ(gtext_csv_table_memory_stats(clone, &stats), GTEXT_CSV_OK);
+  EXPECT_GT(stats.shared_bytes, 0u);
+  EXPECT_LT(stats.arena_used_bytes, stats.shared_bytes / 10);
+
+  // Edits on either side stay on that side
+  ASSERT_EQ(gtext_csv_field_set(clone, 5, 1, "changed", 0), GTEXT_CSV_OK);
+  clone_model[5][1] = "changed";
+  ASSERT_EQ(gtext_csv_field_set(table, 7, 0, "seven", 0), GTEXT_CSV_OK);
+  table_model[7][0] = "seven";
+  EXPECT_EQ(gtext_csv_field(table, 6, 1, &len),
+      gtext_csv_field(clone, 6, 1, &len));
+  const char * row_fields[] = {"a", "b"};
+  ASSERT_EQ(gtext_csv_row_set(table, 2, row_fields, nullptr, 2, nullptr),
+      GTEXT_CSV_OK);
+  table_model[2] = {"a", "b"};
+  cow_expect_rows(table, table_model);
+  cow_expect_rows(clone, clone_model);
+
+  // Row inserts, appends and removals
+  ASSERT_EQ(gtext_csv_row_insert(table, 300, row_fields, nullptr, 2, nullptr),
+      GTEXT_CSV_OK);
+  table_model.insert(table_model.begin() + 300, {"a", "b"});
+  ASSERT_EQ(gtext_csv_row_remove(clone, 0), GTEXT_CSV_OK);
+  clone_model.erase(clone_model.begin());
+  ASSERT_EQ(gtext_csv_row_remove(clone, CSV_ROW_BLOCK_ROWS), GTEXT_CSV_OK);
+  clone_model.erase(clone_model.begin() + CSV_ROW_BLOCK_ROWS);
+  for (size_t i = 0; i < CSV_ROW_BLOCK_ROWS; i++) {
+    ASSERT_EQ(
+        gtext_csv_row_append(clone, row_fields, nullptr, 2, nullptr),
+        GTEXT_CSV_OK);
+    clone_model.push_back({"a", "b"});
+  }
+  ASSERT_EQ(gtext_csv_row_append(table, row_fields, nullptr, 2, nullptr),
+      GTEXT_CSV_OK);
+  table_model.push_back({"a", "b"});
+  cow_expect_rows(table, table_model);
+  cow_expect_rows(clone, clone_model);
+
+  // Whole-table operations copy the shared rows first
+  ASSERT_EQ(gtext_csv_column_append(clone, "extra", 0), GTEXT_CSV_OK);
+  for (auto & row : clone_model) {
+    row.push_back("");
+  }
+  ASSERT_EQ(gtext_csv_column_rename(table, 1, "renamed", 0), GTEXT_CSV_OK);
+  GTEXT_CSV_Sort_Key key = {1, GTEXT_CSV_COMPARE_LEXICOGRAPHIC, true};
+  ASSERT_EQ(gtext_csv_table_sort(table, &key, 1, 1), GTEXT_CSV_OK);
+  std::stable_sort(table_model.begin(), table_model.end(),
+      [](const auto & a, const auto & b) { return a[1] > b[1]; });
+  cow_expect_rows(table, table_model);
+  cow_expect_rows(clone, clone_model);
+  size_t idx = 0;
+  EXPECT_EQ(gtext_csv_header_index(clone, "value", &idx), GTEXT_CSV_OK);
+  EXPECT_NE(gtext_csv_header_index(clone, "renamed", &idx), GTEXT_CSV_OK);
+
+  // The clone outlives its source, and compaction stops the sharing
+  gtext_csv_free_table(table);
+  cow_expect_rows(clone, clone_model);
+  ASSERT_EQ(gtext_csv_table_compact(clone), GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_table_memory_stats(clone, &stats), GTEXT_CSV_OK);
+  EXPECT_EQ(stats.shared_bytes, 0u);
+  cow_expect_rows(clone, clone_model);
+  gtext_csv_free_table(clone);
+}
+
+// Test chained and concurrent copy-on-write clones
+TEST(CsvMutation, CloneCowChainsAndThreads) {
+  const size_t rows = 2 * CSV_ROW_BLOCK_ROWS + 3;
+  GTEXT_CSV_Table * table = cow_test_table(rows);
+  ASSERT_NE(table, nullptr);
+  auto model = cow_test_model(rows);
+
+  // Cloning an unchanged table again reuses its share
+  GTEXT_CSV_Table * first = gtext_csv_clone_cow(table);
+  GTEXT_CSV_Table * second = gtext_csv_clone_cow(table);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_NE(table->share, nullptr);
+  EXPECT_EQ(first->share, table->share);
+  EXPECT_EQ(second->share, table->share);
+
+  // A changed table gets a new share on top of the old one
+  ASSERT_EQ(gtext_csv_field_set(table, 1, 1, "table", 0), GTEXT_CSV_OK);
+  GTEXT_CSV_Table * third = gtext_csv_clone_cow(table);
+  ASSERT_NE(third, nullptr);
+  EXPECT_EQ(third->share, table->share);
+  EXPECT_NE(third->share, first->share);
+  auto table_model = model;
+  table_model[1][1] = "table";
+  cow_expect_rows(third, table_model);
+
+  // A clone of a clone
+  GTEXT_CSV_Table * nested = gtext_csv_clone_cow(first);
+  ASSERT_NE(nested, nullptr);
+  ASSERT_EQ(gtext_csv_field_set(nested, 0, 0, "nested", 0), GTEXT_CSV_OK);
+  ASSERT_EQ(gtext_csv_row_remove(first, rows - 1), GTEXT_CSV_OK);
+  auto nested_model = model;
+  nested_model[0][0] = "nested";
+  auto first_model = model;
+  first_model.pop_back();
+  cow_expect_rows(nested, nested_model);
+  cow_expect_rows(first, first_model);
+  cow_expect_rows(second, model);
+
+  // Clones of an unchanged table can be taken from several threads
+  std::vector<GTEXT_CSV_Table *> clones(32, nullptr);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; t++) {
+    threads.emplace_back([&clones, table, t]() {
+      for (size_t i = t; i < clones.size(); i += 4) {
+        clones[i] = gtext_csv_clone_cow(table);
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  for (GTEXT_CSV_Table * clone : clones) {
+    ASSERT_NE(clone, nullptr);
+    EXPECT_EQ(clone->share, table->share);
+    cow_expect_rows(clone, table_model);
+  }
+
+  // Tables can be freed in any order
+  gtext_csv_free_table(first);
+  gtext_csv_free_table(table);
+  for (GTEXT_CSV_Table * clone : clones) {
+    gtext_csv_free_table(clone);
+  }
+  cow_expect_rows(nested, nested_model);
+  cow_expect_rows(third, table_model);
+  gtext_csv_free_table(third);
+  gtext_csv_free_table(nested);
+  cow_expect_rows(second, model);
+  gtext_csv_free_table(second);
+
+  // A table in the column layout is deep-copied
+  table = cow_test_table(rows);
+  ASSERT_NE(table, nullptr);
+  ASSERT_EQ(gtext_csv_table_set_layout(table, GTEXT_CSV_LAYOUT_COLUMNS),
+      GTEXT_CSV_OK);
+  GTEXT_CSV_Table * columns = gtext_csv_clone_cow(table);
+  ASSERT_NE(columns, nullptr);
+  EXPECT_EQ(columns->share, nullptr);
+  gtext_csv_free_table(table);
+  cow_expect_rows(columns, model);
+  gtext_csv_free_table(columns);
+}
+
 TEST(CsvMutation, CloneEmptyTable) {
   GTEXT_CSV_Table * source = gtext_csv_new_table();
   ASSERT_NE(source, nullptr);
@@ -7615,9 +10680,9 @@ TEST(CsvMutation, CloneTableWithHeaders) {
   EXPECT_EQ(clone->column_count, 3u);
 
   // Verify header row is cloned
-  EXPECT_STREQ(clone->rows[0].fields[0].data, "name");
-  EXPECT_STREQ(clone->rows[0].fields[1].data, "age");
-  EXPECT_STREQ(clone->rows[0].fields[2].data, "city");
+  EXPECT_STREQ(csv_table_row_at(clone, 0)->fields[0].data, "name");
+  EXPECT_STREQ(csv_table_row_at(clone, 0)->fields[1].data, "age");
+  EXPECT_STREQ(csv_table_row_at(clone, 0)->fields[2].data, "city");
 
   // Verify data rows are cloned
   size_t len;
@@ -7712,7 +10777,7 @@ TEST(CsvMutation, CloneCopiesInSituFields) {
   bool found_in_situ = false;
   const char * original_in_situ_ptr = nullptr;
   for (size_t row = 0; row < source->row_count && !found_in_situ; row++) {
-    csv_table_row * table_row = &source->rows[row];
+    csv_table_row * table_row = csv_table_row_at(source, row);
     for (size_t col = 0; col < table_row->field_count; col++) {
       if (table_row->fields[col].is_in_situ) {
         found_in_situ = true;
@@ -7728,7 +10793,7 @@ TEST(CsvMutation, CloneCopiesInSituFields) {
 
   // Verify all fields in clone are NOT in-situ (they were copied)
   for (size_t row = 0; row < clone->row_count; row++) {
-    csv_table_row * table_row = &clone->rows[row];
+    csv_table_row * table_row = csv_table_row_at(clone, row);
     for (size_t col = 0; col < table_row->field_count; col++) {
       EXPECT_FALSE(table_row->fields[col].is_in_situ)
           << "Clone field at row " << row << ", col " << col
@@ -8997,7 +12062,7 @@ TEST(CsvMutation, ColumnAppendToTableWithHeaders) {
   EXPECT_EQ(status, GTEXT_CSV_OK);
 
   // Verify header row has 3 columns
-  EXPECT_EQ(table->rows[0].field_count, 3u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->field_count, 3u);
 
   // Verify header map is updated
   size_t idx;
@@ -9159,7 +12224,7 @@ TEST(CsvMutation, ColumnAppendToEmptyTableWithHeaders) {
   EXPECT_EQ(status, GTEXT_CSV_OK);
 
   // Verify header row has 2 columns
-  EXPECT_EQ(table->rows[0].field_count, 2u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->field_count, 2u);
 
   // Verify header map is updated
   size_t idx;
@@ -9385,7 +12450,7 @@ TEST(CsvMutation, ColumnInsertInTableWithHeaders) {
   EXPECT_EQ(status, GTEXT_CSV_OK);
 
   // Verify header row has 4 columns
-  EXPECT_EQ(table->rows[0].field_count, 4u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->field_count, 4u);
 
   // Verify header map is updated
   size_t idx;
@@ -10414,7 +13479,7 @@ TEST(CsvMutation, ColumnRemoveInTableWithHeaders) {
   EXPECT_EQ(status, GTEXT_CSV_OK);
 
   // Verify header row has 2 columns
-  EXPECT_EQ(table->rows[0].field_count, 2u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->field_count, 2u);
 
   // Verify header map entry is removed
   size_t idx;
@@ -10454,7 +13519,7 @@ TEST(CsvMutation, ColumnRemoveHeaderFieldRemovedFromHeaderRow) {
   EXPECT_EQ(status, GTEXT_CSV_OK);
 
   // Verify header row has 2 columns
-  EXPECT_EQ(table->rows[0].field_count, 2u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->field_count, 2u);
 
   // Verify header map has correct entries
   size_t idx;
@@ -10663,9 +13728,9 @@ TEST(CsvMutation, ColumnRenameInTableWithHeaders) {
   // Verify header field is updated in header row (access via internal
   // structure)
   ASSERT_GE(table->row_count, 1u);
-  ASSERT_GE(table->rows[0].field_count, 2u);
-  EXPECT_EQ(table->rows[0].fields[1].length, 7u);
-  EXPECT_STREQ(table->rows[0].fields[1].data, "newcol2");
+  ASSERT_GE(csv_table_row_at(table, 0)->field_count, 2u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->fields[1].length, 7u);
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[1].data, "newcol2");
 
   // Verify header map is updated correctly
   size_t idx;
@@ -10701,9 +13766,9 @@ TEST(CsvMutation, ColumnRenameHeaderFieldUpdatedInHeaderRow) {
 
   // Verify header field is updated (access via internal structure)
   ASSERT_GE(table->row_count, 1u);
-  ASSERT_GE(table->rows[0].field_count, 1u);
-  EXPECT_EQ(table->rows[0].fields[0].length, 8u);
-  EXPECT_STREQ(table->rows[0].fields[0].data, "firstcol");
+  ASSERT_GE(csv_table_row_at(table, 0)->field_count, 1u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->fields[0].length, 8u);
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[0].data, "firstcol");
 
   gtext_csv_free_table(table);
 }
@@ -10859,9 +13924,9 @@ TEST(CsvMutation, ColumnRenameWithExplicitLength) {
 
   // Verify header field is updated (access via internal structure)
   ASSERT_GE(table->row_count, 1u);
-  ASSERT_GE(table->rows[0].field_count, 2u);
-  EXPECT_EQ(table->rows[0].fields[1].length, 7u);
-  EXPECT_STREQ(table->rows[0].fields[1].data, "newcol2");
+  ASSERT_GE(csv_table_row_at(table, 0)->field_count, 2u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->fields[1].length, 7u);
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[1].data, "newcol2");
 
   gtext_csv_free_table(table);
 }
@@ -10878,9 +13943,9 @@ TEST(CsvMutation, ColumnRenameWithNullTerminatedString) {
 
   // Verify header field is updated (access via internal structure)
   ASSERT_GE(table->row_count, 1u);
-  ASSERT_GE(table->rows[0].field_count, 1u);
-  EXPECT_EQ(table->rows[0].fields[0].length, 7u);
-  EXPECT_STREQ(table->rows[0].fields[0].data, "newcol1");
+  ASSERT_GE(csv_table_row_at(table, 0)->field_count, 1u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->fields[0].length, 7u);
+  EXPECT_STREQ(csv_table_row_at(table, 0)->fields[0].data, "newcol1");
 
   gtext_csv_free_table(table);
 }
@@ -10897,8 +13962,8 @@ TEST(CsvMutation, ColumnRenameEmptyName) {
 
   // Verify header field is empty (access via internal structure)
   ASSERT_GE(table->row_count, 1u);
-  ASSERT_GE(table->rows[0].field_count, 1u);
-  EXPECT_EQ(table->rows[0].fields[0].length, 0u);
+  ASSERT_GE(csv_table_row_at(table, 0)->field_count, 1u);
+  EXPECT_EQ(csv_table_row_at(table, 0)->fields[0].length, 0u);
 
   // Verify header map lookup fails for empty name (or works if empty names are
   // allowed) Note: Empty names might be allowed, but lookup might fail
@@ -49,6 +49,7 @@ TEST(ParseOptions, Default) {
     EXPECT_EQ(opts.parse_uint64, 1);
     EXPECT_EQ(opts.parse_double, 1);
     EXPECT_EQ(opts.allow_big_decimal, 0);
+    EXPECT_EQ(opts.lazy_numbers, 0);
 }
 
 /**
@@ -848,6 +849,145 @@ TEST(NumberParsing, LexemePreservation) {
     }
 }
 
+/**
+ * Test that lazy number parsing keeps the lexeme and defers conversion
+ */
+TEST(NumberParsing, LazyDefersConversion) {
+    json_number num;
+    GTEXT_JSON_Parse_Options opts = gtext_json_parse_options_default();
+    opts.preserve_number_lexeme = false;
+    opts.parse_uint64 = false;
+    opts.lazy_numbers = true;
+
+    GTEXT_JSON_Status status = json_parse_number("-42", 3, &num, NULL, &opts);
+    ASSERT_EQ(status, GTEXT_JSON_OK);
+    // The lexeme is always kept, since it is the only source for conversion
+    EXPECT_TRUE(num.flags & JSON_NUMBER_HAS_LEXEME);
+    EXPECT_STREQ(num.lexeme, "-42");
+    // No representation is derived yet; only the requested ones are pending
+    EXPECT_FALSE(num.flags & (JSON_NUMBER_HAS_I64 | JSON_NUMBER_HAS_U64 |
+                              JSON_NUMBER_HAS_DOUBLE));
+    EXPECT_EQ(num.lazy, (unsigned)(JSON_NUMBER_HAS_I64 | JSON_NUMBER_HAS_DOUBLE));
+    json_number_destroy(&num);
+}
+
+/**
+ * Test DOM numbers parsed lazily: values are derived on first access and
+ * cached, and writing does not need to convert them
+ */
+TEST(DOMParsing, LazyNumbers) {
+    // The last element is longer than the strtod() stack buffer
+    std::string long_num = "0." + std::string(80, '1');
+    std::string input = "[0,-7,18446744073709551615,-9223372036854775808,"
+                        "1.5e3,123.25," + long_num + "]";
+    GTEXT_JSON_Parse_Options eager = gtext_json_parse_options_default();
+    GTEXT_JSON_Parse_Options lazy = eager;
+    lazy.lazy_numbers = true;
+    lazy.in_situ_mode = true;
+    GTEXT_JSON_Error err{};
+
+    GTEXT_JSON_Value * expected =
+        gtext_json_parse(input.data(), input.size(), &eager, &err);
+    ASSERT_NE(expected, nullptr);
+    GTEXT_JSON_Value * val =
+        gtext_json_parse(input.data(), input.size(), &lazy, &err);
+    ASSERT_NE(val, nullptr);
+    ASSERT_EQ(gtext_json_array_size(val), gtext_json_array_size(expected));
+
+    // Nothing has been converted yet and lexemes reference the input
+    for (size_t i = 0; i < gtext_json_array_size(val); ++i) {
+        const GTEXT_JSON_Value * elem = gtext_json_array_get(val, i);
+        EXPECT_NE(elem->as.number.lazy, 0u) << "index " << i;
+        EXPECT_FALSE(elem->as.number.has_i64 || elem->as.number.has_u64 ||
+                     elem->as.number.has_dbl) << "index " << i;
+        EXPECT_EQ(elem->as.number.is_in_situ, 1) << "index " << i;
+    }
+
+    // Writing back uses the lexemes and leaves the numbers unconverted
+    GTEXT_JSON_Write_Options write_opts = gtext_json_write_options_default();
+    GTEXT_JSON_Sink sink;
+    ASSERT_EQ(gtext_json_sink_buffer(&sink), GTEXT_JSON_OK);
+    ASSERT_EQ(gtext_json_write_value(&sink, &write_opts, val, &err),
+              GTEXT_JSON_OK);
+    EXPECT_EQ(std::string(gtext_json_sink_buffer_data(&sink),
+                          gtext_json_sink_buffer_size(&sink)), input);
+    gtext_json_sink_buffer_free(&sink);
+    EXPECT_NE(gtext_json_array_get(val, 0)->as.number.lazy, 0u);
+
+    // Accessors agree with eager parsing, including failures
+    for (size_t i = 0; i < gtext_json_array_size(val); ++i) {
+        const GTEXT_JSON_Value * a = gtext_json_array_get(val, i);
+        const GTEXT_JSON_Value * b = gtext_json_array_get(expected, i);
+        int64_t ai = 0, bi = 0;
+        uint64_t au = 0, bu = 0;
+        double ad = 0, bd = 0;
+        EXPECT_EQ(gtext_json_get_i64(a, &ai), gtext_json_get_i64(b, &bi));
+        EXPECT_EQ(ai, bi) << "index " << i;
+        // The first access cached every pending representation
+        EXPECT_EQ(a->as.number.lazy, 0u) << "index " << i;
+        EXPECT_EQ(gtext_json_get_u64(a, &au), gtext_json_get_u64(b, &bu));
+        EXPECT_EQ(au, bu) << "index " << i;
+        EXPECT_EQ(gtext_json_get_double(a, &ad), gtext_json_get_double(b, &bd));
+        EXPECT_EQ(ad, bd) << "index " << i;
+    }
+
+    gtext_json_free(val);
+    gtext_json_free(expected);
+}
+
+/**
+ * Test that lazily parsed numbers compare and reformat like eager ones
+ */
+TEST(DOMParsing, LazyNumbersEqualityAndCanonicalWrite) {
+    const char * input = "{\"a\":10,\"b\":[2.50,-3]}";
+    GTEXT_JSON_Parse_Options eager = gtext_json_parse_options_default();
+    GTEXT_JSON_Parse_Options lazy = eager;
+    lazy.lazy_numbers = true;
+    GTEXT_JSON_Error err{};
+
+    GTEXT_JSON_Value * a = gtext_json_parse(input, strlen(input), &lazy, &err);
+    ASSERT_NE(a, nullptr);
+    const char * other = "{\"a\":1e1,\"b\":[2.5,-3]}";
+    GTEXT_JSON_Value * b = gtext_json_parse(other, strlen(other), &lazy, &err);
+    ASSERT_NE(b, nullptr);
+    EXPECT_TRUE(gtext_json_equal(a, b, GTEXT_JSON_EQUAL_NUMERIC));
+    EXPECT_FALSE(gtext_json_equal(a, b, GTEXT_JSON_EQUAL_LEXEME));
+
+    // A lazy root number is resolved the same way
+    GTEXT_JSON_Value * root = gtext_json_parse("77", 2, &lazy, &err);
+    ASSERT_NE(root, nullptr);
+    int64_t i64 = 0;
+    EXPECT_EQ(gtext_json_get_i64(root, &i64), GTEXT_JSON_OK);
+    EXPECT_EQ(i64, 77);
+    gtext_json_free(root);
+
+    // Canonical output must convert, and matches eager parsing
+    GTEXT_JSON_Value * c = gtext_json_parse(input, strlen(input), &eager, &err);
+    ASSERT_NE(c, nullptr);
+    GTEXT_JSON_Value * d = gtext_json_parse(input, strlen(input), &lazy, &err);
+    ASSERT_NE(d, nullptr);
+    GTEXT_JSON_Write_Options write_opts = gtext_json_write_options_default();
+    write_opts.canonical_numbers = true;
+    GTEXT_JSON_Sink s1, s2;
+    ASSERT_EQ(gtext_json_sink_buffer(&s1), GTEXT_JSON_OK);
+    ASSERT_EQ(gtext_json_sink_buffer(&s2), GTEXT_JSON_OK);
+    ASSERT_EQ(gtext_json_write_value(&s1, &write_opts, c, &err),
+              GTEXT_JSON_OK);
+    ASSERT_EQ(gtext_json_write_value(&s2, &write_opts, d, &err),
+              GTEXT_JSON_OK);
+    EXPECT_EQ(std::string(gtext_json_sink_buffer_data(&s2),
+                          gtext_json_sink_buffer_size(&s2)),
+              std::string(gtext_json_sink_buffer_data(&s1),
+                          gtext_json_sink_buffer_size(&s1)));
+    gtext_json_sink_buffer_free(&s1);
+    gtext_json_sink_buffer_free(&s2);
+
+    gtext_json_free(a);
+    gtext_json_free(b);
+    gtext_json_free(c);
+    gtext_json_free(d);
+}
+
 /**
  * Test position tracking during number parsing
  */
@@ -2700,6 +2840,76 @@ TEST(DOMWrite, StringEscaping) {
     gtext_json_free(v4);
 }
 
+/**
+ * Test DOM write - escaping in long strings, where clean runs are skipped a
+ * block at a time, for every combination of escape options
+ */
+TEST(DOMWrite, StringEscapingLongRuns) {
+    // Reference escaper: one byte at a time
+    auto reference = [](const std::string & in, bool solidus, bool high) {
+        std::string out = "\"";
+        char buf[8];
+        for (unsigned char c : in) {
+            switch (c) {
+            case '"': out += "\\\""; continue;
+            case '\\': out += "\\\\"; continue;
+            case '\b': out += "\\b"; continue;
+            case '\f': out += "\\f"; continue;
+            case '\n': out += "\\n"; continue;
+            case '\r': out += "\\r"; continue;
+            case '\t': out += "\\t"; continue;
+            }
+            if (c == '/' && solidus) {
+                out += "\\/";
+            }
+            else if (c < 0x20 || (c >= 0x80 && high)) {
+                snprintf(buf, sizeof(buf), "\\u%04X", c);
+                out += buf;
+            }
+            else {
+                out += (char)c;
+            }
+        }
+        return out + "\"";
+    };
+
+    const unsigned char specials[] = {'"', '\\', '/', '\n', 0x01, 0x1F, 0x7F,
+        0x80, 0xC3, 0xFF};
+
+    for (int combo = 0; combo < 4; combo++) {
+        GTEXT_JSON_Write_Options opts = gtext_json_write_options_default();
+        opts.escape_solidus = (combo & 1) != 0;
+        opts.escape_all_non_ascii = (combo & 2) != 0;
+
+        // Place each special byte at every offset across several blocks
+        for (unsigned char special : specials) {
+            for (size_t pos = 0; pos < 80; pos++) {
+                std::string in(100, 'a');
+                in[pos] = (char)special;
+                in[99 - pos / 2] = (char)special;
+
+                GTEXT_JSON_Value * v =
+                    gtext_json_new_string(in.data(), in.size());
+                ASSERT_NE(v, nullptr);
+                GTEXT_JSON_Sink sink;
+                GTEXT_JSON_Error err{};
+                gtext_json_sink_buffer(&sink);
+                ASSERT_EQ(gtext_json_write_value(&sink, &opts, v, &err),
+                    GTEXT_JSON_OK);
+                std::string got(gtext_json_sink_buffer_data(&sink),
+                    gtext_json_sink_buffer_size(&sink));
+                EXPECT_EQ(got,
+                    reference(in, opts.escape_solidus,
+                        opts.escape_all_non_ascii))
+                    << "combo=" << combo << " byte=" << (int)special
+                    << " pos=" << pos;
+                gtext_json_sink_buffer_free(&sink);
+                gtext_json_free(v);
+            }
+        }
+    }
+}
+
 /**
  * Test DOM write - number values
  */
@@ -3177,6 +3387,49 @@ TEST(StreamingParser, Objects) {
     gtext_json_stream_free(st);
 }
 
+/**
+ * Test streaming parser - empty objects and trailing commas in objects
+ */
+TEST(StreamingParser, EmptyObjects) {
+    auto callback = [](void * user, const GTEXT_JSON_Event* evt, GTEXT_JSON_Error* err) -> GTEXT_JSON_Status {
+        (void)err;
+        auto* evts = static_cast<std::vector<GTEXT_JSON_Event_Type>*>(user);
+        evts->push_back(evt->type);
+        return GTEXT_JSON_OK;
+    };
+    auto parse = [&](const char * input, bool trailing_commas,
+                     std::vector<GTEXT_JSON_Event_Type> & events) {
+        GTEXT_JSON_Parse_Options opts = gtext_json_parse_options_default();
+        opts.allow_trailing_commas = trailing_commas;
+        GTEXT_JSON_Stream * st = gtext_json_stream_new(&opts, callback, &events);
+        GTEXT_JSON_Error err{};
+        GTEXT_JSON_Status status = gtext_json_stream_feed(st, input, strlen(input), &err);
+        if (status == GTEXT_JSON_OK) {
+            status = gtext_json_stream_finish(st, &err);
+        }
+        gtext_json_error_free(&err);
+        gtext_json_stream_free(st);
+        return status;
+    };
+
+    // Expected events: ARRAY_BEGIN, OBJECT_BEGIN, OBJECT_END, OBJECT_BEGIN,
+    // KEY, OBJECT_BEGIN, OBJECT_END, OBJECT_END, ARRAY_END
+    std::vector<GTEXT_JSON_Event_Type> events;
+    EXPECT_EQ(parse("[{}, {\"a\": { }}]", false, events), GTEXT_JSON_OK);
+    std::vector<GTEXT_JSON_Event_Type> expected = {GTEXT_JSON_EVT_ARRAY_BEGIN,
+        GTEXT_JSON_EVT_OBJECT_BEGIN, GTEXT_JSON_EVT_OBJECT_END,
+        GTEXT_JSON_EVT_OBJECT_BEGIN, GTEXT_JSON_EVT_KEY,
+        GTEXT_JSON_EVT_OBJECT_BEGIN, GTEXT_JSON_EVT_OBJECT_END,
+        GTEXT_JSON_EVT_OBJECT_END, GTEXT_JSON_EVT_ARRAY_END};
+    EXPECT_EQ(events, expected);
+
+    events.clear();
+    EXPECT_EQ(parse("{\"a\": 1,}", false, events), GTEXT_JSON_E_BAD_TOKEN);
+    events.clear();
+    EXPECT_EQ(parse("{\"a\": 1,}", true, events), GTEXT_JSON_OK);
+    EXPECT_EQ(events.back(), GTEXT_JSON_EVT_OBJECT_END);
+}
+
 /**
  * Test streaming parser - incremental/chunked input
  */
@@ -4625,6 +4878,8 @@ TEST(StreamingWriter, NestedStructures) {
     EXPECT_NE(strstr(output, "\"arr\""), nullptr);
     EXPECT_NE(strstr(output, "\"obj\""), nullptr);
     EXPECT_NE(strstr(output, "\"key\""), nullptr);
+    EXPECT_EQ(std::string(output, gtext_json_sink_buffer_size(&sink)),
+        "{\"arr\":[1,2],\"obj\":{\"key\":\"value\"}}");
 
     gtext_json_writer_free(w);
     gtext_json_sink_buffer_free(&sink);
@@ -7136,6 +7391,336 @@ TEST(DomUtilities, DeepCloneNested) {
     gtext_json_free(clone);
 }
 
+/**
+ * Test clone shares structure with its source (copy-on-write)
+ */
+TEST(DomUtilities, CloneSharesStructure) {
+    GTEXT_JSON_Parse_Options opts = gtext_json_parse_options_default();
+    GTEXT_JSON_Error err{};
+
+    const char * json = "{\"a\":{\"b\":1},\"c\":[1,2]}";
+    GTEXT_JSON_Value * src = gtext_json_parse(json, strlen(json), &opts, &err);
+    ASSERT_NE(src, nullptr);
+
+    GTEXT_JSON_Value * clone = gtext_json_clone(src);
+    ASSERT_NE(clone, nullptr);
+    EXPECT_NE(clone, src);
+
+    // Nested nodes are shared until modified
+    EXPECT_EQ(gtext_json_object_get(clone, "a", 1),
+        gtext_json_object_get(src, "a", 1));
+    EXPECT_EQ(gtext_json_object_get(clone, "c", 1),
+        gtext_json_object_get(src, "c", 1));
+
+    // The clone keeps the shared nodes alive after the source is freed
+    gtext_json_free(src);
+    const GTEXT_JSON_Value * b = gtext_json_pointer_get(clone, "/a/b", 4);
+    ASSERT_NE(b, nullptr);
+    int64_t i64 = 0;
+    EXPECT_EQ(gtext_json_get_i64(b, &i64), GTEXT_JSON_OK);
+    EXPECT_EQ(i64, 1);
+
+    gtext_json_free(clone);
+}
+
+/**
+ * Test mutating a clone copies only the modified path
+ */
+TEST(DomUtilities, CloneCopyOnWrite) {
+    GTEXT_JSON_Parse_Options opts = gtext_json_parse_options_default();
+    GTEXT_JSON_Error err{};
+
+    const char * json = "{\"a\":{\"b\":1,\"d\":{\"e\":true}},\"c\":[1,2]}";
+    GTEXT_JSON_Value * src = gtext_json_parse(json, strlen(json), &opts, &err);
+    ASSERT_NE(src, nullptr);
+    GTEXT_JSON_Value * original =
+        gtext_json_parse(json, strlen(json), &opts, &err);
+    ASSERT_NE(original, nullptr);
+
+    GTEXT_JSON_Value * clone = gtext_json_clone(src);
+    ASSERT_NE(clone, nullptr);
+
+    // Modify a nested object of the clone
+    GTEXT_JSON_Value * a = gtext_json_pointer_get_mut(clone, "/a", 2);
+    ASSERT_NE(a, nullptr);
+    EXPECT_NE(a, gtext_json_object_get(src, "a", 1));
+    EXPECT_EQ(gtext_json_object_put(a, "b", 1, gtext_json_new_string("x", 1)),
+        GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_object_put(clone, "f", 1, gtext_json_new_null()),
+        GTEXT_JSON_OK);
+
+    // The source is unchanged, and untouched subtrees are still shared
+    EXPECT_TRUE(gtext_json_equal(src, original, GTEXT_JSON_EQUAL_LEXEME));
+    EXPECT_EQ(gtext_json_pointer_get(clone, "/a/d", 4),
+        gtext_json_pointer_get(src, "/a/d", 4));
+    EXPECT_EQ(gtext_json_object_get(clone, "c", 1),
+        gtext_json_object_get(src, "c", 1));
+
+    // Modifying the source does not affect the clone either
+    GTEXT_JSON_Value * c = gtext_json_pointer_get_mut(src, "/c", 2);
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ(gtext_json_array_push(c, gtext_json_new_bool(false)),
+        GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_array_size(gtext_json_object_get(src, "c", 1)), 3u);
+    EXPECT_EQ(gtext_json_array_size(gtext_json_object_get(clone, "c", 1)), 2u);
+
+    const char * expected =
+        "{\"a\":{\"b\":\"x\",\"d\":{\"e\":true}},\"c\":[1,2],\"f\":null}";
+    GTEXT_JSON_Value * exp =
+        gtext_json_parse(expected, strlen(expected), &opts, &err);
+    ASSERT_NE(exp, nullptr);
+    EXPECT_TRUE(gtext_json_equal(clone, exp, GTEXT_JSON_EQUAL_LEXEME));
+
+    gtext_json_free(exp);
+    gtext_json_free(original);
+    gtext_json_free(src);
+    gtext_json_free(clone);
+}
+
+/**
+ * Test patches applied to a clone leave the source unchanged
+ */
+TEST(DomUtilities, ClonePatchLeavesSourceUnchanged) {
+    GTEXT_JSON_Parse_Options opts = gtext_json_parse_options_default();
+    GTEXT_JSON_Error err{};
+
+    const char * json = "{\"a\":{\"b\":[1,2,3]},\"c\":\"keep\"}";
+    GTEXT_JSON_Value * src = gtext_json_parse(json, strlen(json), &opts, &err);
+    ASSERT_NE(src, nullptr);
+    GTEXT_JSON_Value * original =
+        gtext_json_parse(json, strlen(json), &opts, &err);
+    ASSERT_NE(original, nullptr);
+
+    GTEXT_JSON_Value * clone = gtext_json_clone(src);
+    ASSERT_NE(clone, nullptr);
+
+    const char * patch_json =
+        "[{\"op\":\"remove\",\"path\":\"/a/b/0\"},"
+        "{\"op\":\"add\",\"path\":\"/a/z\",\"value\":9}]";
+    GTEXT_JSON_Value * patch =
+        gtext_json_parse(patch_json, strlen(patch_json), &opts, &err);
+    ASSERT_NE(patch, nullptr);
+    EXPECT_EQ(gtext_json_patch_apply(clone, patch, &err), GTEXT_JSON_OK);
+
+    const char * merge_json = "{\"a\":{\"y\":{\"n\":1}},\"c\":null}";
+    GTEXT_JSON_Value * merge =
+        gtext_json_parse(merge_json, strlen(merge_json), &opts, &err);
+    ASSERT_NE(merge, nullptr);
+    EXPECT_EQ(gtext_json_merge_patch(clone, merge, &err), GTEXT_JSON_OK);
+
+    EXPECT_TRUE(gtext_json_equal(src, original, GTEXT_JSON_EQUAL_LEXEME));
+
+    const char * expected = "{\"a\":{\"b\":[2,3],\"z\":9,\"y\":{\"n\":1}}}";
+    GTEXT_JSON_Value * exp =
+        gtext_json_parse(expected, strlen(expected), &opts, &err);
+    ASSERT_NE(exp, nullptr);
+    EXPECT_TRUE(gtext_json_equal(clone, exp, GTEXT_JSON_EQUAL_LEXEME));
+
+    // The patched clone can itself be cloned and freed in any order
+    GTEXT_JSON_Value * second = gtext_json_clone(clone);
+    ASSERT_NE(second, nullptr);
+    gtext_json_free(clone);
+    gtext_json_free(src);
+    EXPECT_TRUE(gtext_json_equal(second, exp, GTEXT_JSON_EQUAL_LEXEME));
+
+    gtext_json_free(second);
+    gtext_json_free(exp);
+    gtext_json_free(merge);
+    gtext_json_free(patch);
+    gtext_json_free(original);
+}
+
+/**
+ * Test attaching a clone to the tree it was cloned from
+ */
+TEST(DomUtilities, CloneAttachedToSource) {
+    GTEXT_JSON_Parse_Options opts = gtext_json_parse_options_default();
+    GTEXT_JSON_Error err{};
+
+    const char * json = "{\"a\":{\"b\":[1,2]}}";
+    GTEXT_JSON_Value * src = gtext_json_parse(json, strlen(json), &opts, &err);
+    ASSERT_NE(src, nullptr);
+
+    GTEXT_JSON_Value * copy =
+        gtext_json_clone(gtext_json_object_get(src, "a", 1));
+    ASSERT_NE(copy, nullptr);
+    EXPECT_EQ(gtext_json_object_put(src, "copy", 4, copy), GTEXT_JSON_OK);
+
+    // Replacing an attached value releases it
+    EXPECT_EQ(gtext_json_object_put(src, "n", 1, gtext_json_new_object()),
+        GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_object_put(src, "n", 1, gtext_json_new_null()),
+        GTEXT_JSON_OK);
+
+    const char * expected =
+        "{\"a\":{\"b\":[1,2]},\"copy\":{\"b\":[1,2]},\"n\":null}";
+    GTEXT_JSON_Value * exp =
+        gtext_json_parse(expected, strlen(expected), &opts, &err);
+    ASSERT_NE(exp, nullptr);
+    EXPECT_TRUE(gtext_json_equal(src, exp, GTEXT_JSON_EQUAL_LEXEME));
+
+    gtext_json_free(exp);
+    gtext_json_free(src);
+}
+
+/**
+ * Test writes through handles taken before a clone do not reach the clone
+ */
+TEST(DomUtilities, CloneIndependentOfEarlierHandles) {
+    GTEXT_JSON_Parse_Options opts = gtext_json_parse_options_default();
+    GTEXT_JSON_Error err{};
+
+    const char * json = "{\"a\":{\"b\":[1,2]},\"c\":\"x\"}";
+    GTEXT_JSON_Value * src = gtext_json_parse(json, strlen(json), &opts, &err);
+    ASSERT_NE(src, nullptr);
+    GTEXT_JSON_Value * b = gtext_json_pointer_get_mut(src, "/a/b", 4);
+    ASSERT_NE(b, nullptr);
+
+    // A child built separately and attached keeps its own context
+    GTEXT_JSON_Value * list = gtext_json_new_array();
+    ASSERT_NE(list, nullptr);
+    EXPECT_EQ(gtext_json_object_put(src, "list", 4, list), GTEXT_JSON_OK);
+
+    GTEXT_JSON_Value * clone = gtext_json_clone(src);
+    ASSERT_NE(clone, nullptr);
+    GTEXT_JSON_Value * second = gtext_json_clone(clone);
+    ASSERT_NE(second, nullptr);
+    GTEXT_JSON_Value * expected = gtext_json_clone(src);
+    ASSERT_NE(expected, nullptr);
+
+    // Both handles still modify the source in place
+    EXPECT_EQ(gtext_json_array_push(b, gtext_json_new_number_i64(3)),
+        GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_array_push(list, gtext_json_new_null()),
+        GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_pointer_get(src, "/a/b", 4), b);
+    EXPECT_EQ(gtext_json_array_size(b), 3u);
+    EXPECT_EQ(gtext_json_array_size(gtext_json_object_get(src, "list", 4)),
+        1u);
+
+    // Neither the clone nor a clone of the clone sees the writes
+    EXPECT_EQ(gtext_json_array_size(gtext_json_pointer_get(clone, "/a/b", 4)),
+        2u);
+    EXPECT_EQ(gtext_json_array_size(gtext_json_object_get(clone, "list", 4)),
+        0u);
+    EXPECT_EQ(gtext_json_array_size(gtext_json_pointer_get(second, "/a/b", 4)),
+        2u);
+    EXPECT_EQ(gtext_json_array_size(gtext_json_object_get(second, "list", 4)),
+        0u);
+
+    // The clones stay valid after the source is freed
+    gtext_json_free(src);
+    EXPECT_EQ(gtext_json_object_put(clone, "d", 1, gtext_json_new_bool(true)),
+        GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_object_size(clone), 4u);
+    gtext_json_free(clone);
+    EXPECT_EQ(gtext_json_object_size(expected), 3u);
+    EXPECT_TRUE(gtext_json_equal(second, expected, GTEXT_JSON_EQUAL_LEXEME));
+
+    gtext_json_free(expected);
+    gtext_json_free(second);
+}
+
+/**
+ * Test repeated patches do not keep adding contexts to the document
+ */
+TEST(DomUtilities, RepeatedPatchesStayBounded) {
+    GTEXT_JSON_Parse_Options opts = gtext_json_parse_options_default();
+    GTEXT_JSON_Error err{};
+
+    const char * json = "{\"n\":0,\"list\":[],\"nested\":{\"k\":\"v\"}}";
+    GTEXT_JSON_Value * doc = gtext_json_parse(json, strlen(json), &opts, &err);
+    ASSERT_NE(doc, nullptr);
+
+    const char * patch_json =
+        "[{\"op\":\"replace\",\"path\":\"/n\",\"value\":1},"
+        "{\"op\":\"add\",\"path\":\"/list/-\",\"value\":{\"x\":[1]}},"
+        "{\"op\":\"remove\",\"path\":\"/list/0\"}]";
+    GTEXT_JSON_Value * patch =
+        gtext_json_parse(patch_json, strlen(patch_json), &opts, &err);
+    ASSERT_NE(patch, nullptr);
+    const char * merge_json = "{\"nested\":{\"k\":\"w\",\"m\":null}}";
+    GTEXT_JSON_Value * merge =
+        gtext_json_parse(merge_json, strlen(merge_json), &opts, &err);
+    ASSERT_NE(merge, nullptr);
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(gtext_json_patch_apply(doc, patch, &err), GTEXT_JSON_OK);
+        ASSERT_EQ(gtext_json_merge_patch(doc, merge, &err), GTEXT_JSON_OK);
+    }
+    EXPECT_EQ(doc->ctx->owned_count, 0u);
+    EXPECT_EQ(doc->ctx->borrowed_count, 0u);
+    EXPECT_EQ(doc->ctx->clones_count, 0u);
+
+    const char * expected = "{\"n\":1,\"list\":[],\"nested\":{\"k\":\"w\"}}";
+    GTEXT_JSON_Value * exp =
+        gtext_json_parse(expected, strlen(expected), &opts, &err);
+    ASSERT_NE(exp, nullptr);
+    EXPECT_TRUE(gtext_json_equal(doc, exp, GTEXT_JSON_EQUAL_LEXEME));
+
+    gtext_json_free(exp);
+    gtext_json_free(merge);
+    gtext_json_free(patch);
+    gtext_json_free(doc);
+}
+
+/**
+ * Test attached values are released on removal, replacement and free
+ */
+TEST(DomUtilities, AttachedValuesReleased) {
+    GTEXT_JSON_Parse_Options opts = gtext_json_parse_options_default();
+    GTEXT_JSON_Error err{};
+
+    const char * json = "{\"a\":[1,2,3],\"b\":{\"c\":null}}";
+    GTEXT_JSON_Value * root = gtext_json_parse(json, strlen(json), &opts, &err);
+    ASSERT_NE(root, nullptr);
+
+    GTEXT_JSON_Value * arr = gtext_json_pointer_get_mut(root, "/a", 2);
+    ASSERT_NE(arr, nullptr);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(gtext_json_array_push(arr, gtext_json_new_number_i64(i)),
+            GTEXT_JSON_OK);
+    }
+
+    // Values nested several attachments deep
+    GTEXT_JSON_Value * outer = gtext_json_new_object();
+    GTEXT_JSON_Value * inner = gtext_json_new_array();
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(gtext_json_array_push(inner, gtext_json_new_string("s", 1)),
+        GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_object_put(outer, "in", 2, inner), GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_array_push(arr, outer), GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_array_push(inner, gtext_json_new_bool(true)),
+        GTEXT_JSON_OK);
+
+    // Removing or replacing attached values releases them (checked by the
+    // sanitizer builds)
+    EXPECT_EQ(gtext_json_array_remove(arr, 4), GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_array_remove(arr, 0), GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_array_set(arr, 4, gtext_json_new_bool(true)),
+        GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_object_put(root, "b", 1, gtext_json_new_null()),
+        GTEXT_JSON_OK);
+
+    const char * expected =
+        "{\"a\":[2,3,0,2,true,{\"in\":[\"s\",true]}],\"b\":null}";
+    GTEXT_JSON_Value * exp =
+        gtext_json_parse(expected, strlen(expected), &opts, &err);
+    ASSERT_NE(exp, nullptr);
+    EXPECT_TRUE(gtext_json_equal(root, exp, GTEXT_JSON_EQUAL_LEXEME));
+
+    // Attaching a value to its own subtree stores a copy
+    EXPECT_EQ(gtext_json_array_push(inner, outer), GTEXT_JSON_OK);
+    EXPECT_EQ(gtext_json_array_size(inner), 3u);
+    EXPECT_EQ(gtext_json_array_size(gtext_json_pointer_get(root, "/a/5/in/2/in",
+                  12)),
+        2u);
+
+    gtext_json_free(exp);
+    gtext_json_free(root);
+}
+
 /**
  * Test object merge - first wins policy
  */
@@ -1,10 +1,162 @@
 #include <gtest/gtest.h>
+#include <string>
+
+// Include internal header for testing internal functions
+extern "C" {
+#include "../src/text_utf8.h"
+}
 
 // Basic test to ensure the library can be linked
 TEST(TextLibrary, BasicTest) {
     EXPECT_TRUE(true);
 }
 
+// Reference validator: one codepoint at a time, returning the offset of the
+// first bad sequence (or the length when valid).
+static size_t reference_utf8_error(const std::string & s, bool * truncated) {
+    size_t i = 0;
+    *truncated = false;
+    while (i < s.size()) {
+        unsigned char c = (unsigned char)s[i];
+        size_t n;
+        unsigned int cp;
+        if (c < 0x80) {
+            i++;
+            continue;
+        }
+        else if (c >= 0xC2 && c <= 0xDF) {
+            n = 2;
+            cp = c & 0x1F;
+        }
+        else if (c >= 0xE0 && c <= 0xEF) {
+            n = 3;
+            cp = c & 0x0F;
+        }
+        else if (c >= 0xF0 && c <= 0xF4) {
+            n = 4;
+            cp = c & 0x07;
+        }
+        else {
+            return i;
+        }
+        for (size_t k = 1; k < n; k++) {
+            if (i + k >= s.size()) {
+                *truncated = true;
+                return i;
+            }
+            unsigned char b = (unsigned char)s[i + k];
+            if ((b & 0xC0) != 0x80) {
+                return i;
+            }
+            cp = (cp << 6) | (b & 0x3F);
+            // Reject as soon as the prefix is out of range
+            if (k == 1 && ((n == 3 && cp < 0x20) || (n == 4 && cp < 0x10) ||
+                    (n == 3 && cp >= 0x360 && cp < 0x380) ||
+                    (n == 4 && cp > 0x10F))) {
+                return i;
+            }
+        }
+        i += n;
+    }
+    return s.size();
+}
+
+TEST(TextUtf8, ValidAndInvalidBasics) {
+    size_t off = 99;
+    EXPECT_EQ(text_utf8_validate("", 0, &off), TEXT_UTF8_VALID);
+    EXPECT_EQ(text_utf8_validate("hello", 5, &off), TEXT_UTF8_VALID);
+    EXPECT_EQ(off, 5u);
+    EXPECT_EQ(text_utf8_validate("\xF0\x9F\x98\x80", 4, &off), TEXT_UTF8_VALID);
+
+    EXPECT_EQ(text_utf8_validate("ab\x80", 3, &off), TEXT_UTF8_INVALID);
+    EXPECT_EQ(off, 2u);
+    EXPECT_EQ(text_utf8_validate("a\xC0\x81", 3, &off), TEXT_UTF8_INVALID);
+    EXPECT_EQ(off, 1u);
+    EXPECT_EQ(text_utf8_validate("\xED\xA0\x80", 3, &off), TEXT_UTF8_INVALID);
+    EXPECT_EQ(text_utf8_validate("\xF4\x90\x80\x80", 4, &off),
+        TEXT_UTF8_INVALID);
+    EXPECT_EQ(text_utf8_validate("abc\xE4\xB8", 5, &off),
+        TEXT_UTF8_INCOMPLETE);
+    EXPECT_EQ(off, 3u);
+}
+
+// Exercise the vector kernel: every interesting sequence at every offset of
+// a buffer spanning several blocks, checked against the reference.
+TEST(TextUtf8, MatchesReferenceAtEveryOffset) {
+    const std::string seqs[] = {
+        "\xC3\xA9", "\xE4\xB8\x96", "\xEF\xBF\xBD", "\xF0\x9F\x98\x80",
+        "\xF4\x8F\xBF\xBF",
+        "\x80", "\xBF\x80", "\xC0\xAF", "\xC1\xBF", "\xE0\x80\xAF",
+        "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\x9F\xBF", "\xF0\x80\x80\x80",
+        "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF",
+        "\xC3", "\xE4\xB8", "\xF0\x9F\x98", "\xE4" "a", "\xF0\x9F" "ab",
+    };
+    for (const std::string & seq : seqs) {
+        for (size_t pos = 0; pos < 70; pos++) {
+            std::string s(72, 'x');
+            s.replace(pos, seq.size(), seq);
+            bool truncated = false;
+            size_t expected = reference_utf8_error(s, &truncated);
+
+            size_t off = 0;
+            text_utf8_result r = text_utf8_validate(s.data(), s.size(), &off);
+            EXPECT_EQ(off, expected) << "pos=" << pos;
+            if (expected == s.size()) {
+                EXPECT_EQ(r, TEXT_UTF8_VALID) << "pos=" << pos;
+            }
+            else {
+                EXPECT_EQ(r, truncated ? TEXT_UTF8_INCOMPLETE
+                                       : TEXT_UTF8_INVALID)
+                    << "pos=" << pos;
+            }
+        }
+    }
+}
+
+TEST(TextUtf8, StreamAcrossChunkBoundaries) {
+    std::string valid;
+    for (int i = 0; i < 8; i++) {
+        valid += "ab\xC3\xA9\xE4\xB8\x96\xF0\x9F\x98\x80 ";
+    }
+    // Split at every position into two chunks, and also feed byte by byte
+    for (size_t split = 0; split <= valid.size(); split++) {
+        text_utf8_stream st;
+        text_utf8_stream_init(&st);
+        size_t off = 0;
+        EXPECT_EQ(text_utf8_stream_feed(&st, valid.data(), split, &off),
+            TEXT_UTF8_VALID);
+        EXPECT_EQ(text_utf8_stream_feed(
+                      &st, valid.data() + split, valid.size() - split, &off),
+            TEXT_UTF8_VALID);
+        EXPECT_EQ(text_utf8_stream_finish(&st, &off), TEXT_UTF8_VALID);
+    }
+    text_utf8_stream st;
+    text_utf8_stream_init(&st);
+    for (char c : valid) {
+        ASSERT_EQ(text_utf8_stream_feed(&st, &c, 1, NULL), TEXT_UTF8_VALID);
+    }
+    EXPECT_EQ(text_utf8_stream_finish(&st, NULL), TEXT_UTF8_VALID);
+
+    // An invalid continuation in the second chunk reports a stream offset
+    // pointing at the lead byte in the first chunk
+    std::string bad = std::string(40, 'a') + "\xE4\xB8" "b";
+    text_utf8_stream_init(&st);
+    size_t off = 0;
+    EXPECT_EQ(text_utf8_stream_feed(&st, bad.data(), 41, &off),
+        TEXT_UTF8_VALID);
+    EXPECT_EQ(text_utf8_stream_feed(&st, bad.data() + 41, bad.size() - 41,
+                  &off),
+        TEXT_UTF8_INVALID);
+    EXPECT_EQ(off, 40u);
+
+    // Truncated at end of stream
+    text_utf8_stream_init(&st);
+    EXPECT_EQ(text_utf8_stream_feed(&st, "abc\xF0\x9F", 5, &off),
+        TEXT_UTF8_VALID);
+    EXPECT_EQ(text_utf8_stream_finish(&st, &off), TEXT_UTF8_INCOMPLETE);
+    EXPECT_EQ(off, 3u);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();